@@ -8,27 +8,53 @@
 #ifndef INC_LCD_H_
 #define INC_LCD_H_
 
+#include "LCD_Config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /***************************************
 *        Function Prototypes
 ***************************************/
 
 void LCD_Init(void) ;
+void LCD_InitBegin(void) ;
+uint8_t LCD_InitPoll(void) ;
+void LCD_WriteHandshake(uint8_t nibble) ;
 void LCD_Enable(void) ;
 void LCD_Start(void) ;
 void LCD_Stop(void) ;
 void LCD_WriteControl(uint8_t cByte) ;
 void LCD_WriteData(uint8_t dByte) ;
 void LCD_PrintString(char const string[]) ;
+void LCD_PrintAt(uint8_t row, uint8_t column, char const string[]) ;
+void LCD_PrintStringN(char const string[], size_t length) ;
+void LCD_FillRegion(uint8_t row, uint8_t column, uint8_t width, char character) ;
+void LCD_WriteBuffer(uint8_t const buffer[], size_t length) ;
 void LCD_Position(uint8_t row, uint8_t column) ;
+void LCD_WritePosition(uint8_t row, uint8_t column) ;
+uint8_t LCD_DdramAddress(uint8_t row, uint8_t column) ;
+void LCD_SetEntryDirection(uint8_t increment) ;
 void LCD_PutChar(char character) ;
-void LCD_IsReady(void) ;
+uint8_t LCD_IsReady(void) ;
+uint8_t LCD_IsResponsive(void) ;
+uint8_t LCD_IsPresent(void) ;
+uint8_t LCD_ReadStatus(void) ;
+uint8_t LCD_ReadAddress(void) ;
+uint16_t LCD_ReadData(void) ;
 void LCD_SaveConfig(void) ;
 void LCD_RestoreConfig(void) ;
 void LCD_Sleep(void) ;
 void LCD_Wakeup(void) ;
+void LCD_FlushFrame(void) ;
+void LCD_CursorInvalidate(void) ;
+void LCD_BusInvalidate(void) ;
+uint8_t LCD_CursorGet(void) ;
 
 void LCD_DrawHorizontalBG(uint8_t row, uint8_t column, uint8_t maxCharacters, uint8_t value);
 void LCD_DrawVerticalBG(uint8_t row, uint8_t column, uint8_t maxCharacters, uint8_t value);
+void LCD_BarInvalidate(void) ;
 
 
 /* ASCII Conversion Routines */
@@ -37,11 +63,29 @@ void LCD_PrintInt16(uint16_t value) ;
 void LCD_PrintInt32(uint32_t value) ;
 void LCD_PrintNumber(uint16_t value) ;
 void LCD_PrintU32Number(uint32_t value) ;
+void LCD_PrintU32Fixed(uint32_t value, uint8_t width, char pad) ;
+void LCD_PrintU32Right(uint8_t row, uint8_t column, uint32_t value, uint8_t width) ;
+void LCD_PrintS32(int32_t value) ;
+void LCD_PrintFixed(int32_t value, uint8_t fracBits, uint8_t decimals) ;
+void LCD_PrintFloat(float value, uint8_t decimals) ;
+
 
+#if (LCD_CUSTOM_CHAR_SET != LCD_NONE)
+    /* Custom character set loaded by LCD_Init(), 8 glyphs of 8 rows: defined
+    * by the application for LCD_USER_DEFINED, by LCD_Bar.c for the bargraph sets
+    */
+    extern uint8_t const LCD_customFonts[];
+#endif /* LCD_CUSTOM_CHAR_SET != LCD_NONE */
+
+/* Precomputed BSRR words, index [RS][nibble] (LCD.c) */
+extern const uint32_t LCD_nibbleBsrr[2u][16u];
 
 /* Clear Macro */
 #define LCD_ClearDisplay() LCD_WriteControl(LCD_CLEAR_DISPLAY)
 
+/* Blanks "width" cells from a position, only the ones not blank already */
+#define LCD_ClearRegion(row, column, width) LCD_FillRegion((row), (column), (width), ' ')
+
 /* Off Macro */
 #define LCD_DisplayOff() LCD_WriteControl(LCD_DISPLAY_CURSOR_OFF)
 
@@ -62,6 +106,7 @@ void LCD_PrintU32Number(uint32_t value) ;
 #define LCD_CURSOR_AUTO_INCR_ON      (0x06u)
 #define LCD_DISPLAY_CURSOR_ON        (0x0Eu)
 #define LCD_DISPLAY_2_LINES_5x10     (0x2Cu)
+#define LCD_DISPLAY_8_BIT_2_LINES_5x10 (0x3Cu)
 #define LCD_DISPLAY_ON_CURSOR_OFF    (0x0Cu)
 
 #define LCD_RESET_CURSOR_POSITION    (0x03u)
@@ -84,6 +129,148 @@ void LCD_PrintU32Number(uint32_t value) ;
 #define LCD_STM32_NIBBLE_SHIFT		 (0u)
 #define LCD_STM32_NIBBLE_MASK        (0x000Fu)
 
+/* DB0-DB3 shift and mask (8-bit bus, LCD_DB0_PIN : LCD_DB3_PIN in LCD_Config.h) */
+#define LCD_STM32_LOW_NIBBLE_SHIFT   (4u)
+#define LCD_STM32_LOW_NIBBLE_MASK    (0x00F0u)
+
+#if (LCD_BUS_8BIT != 0u)
+    #define LCD_FUNCTION_SET         (LCD_DISPLAY_8_BIT_2_LINES_5x10)
+#else
+    #define LCD_FUNCTION_SET         (LCD_DISPLAY_2_LINES_5x10)
+#endif /* LCD_BUS_8BIT != 0u */
+
+/* Data pins of the bus: DB0-DB3 of the 8-bit bus and DB4-DB7 of the lockstep
+* display (LCD_USE_LOCKSTEP) use the same port bits
+*/
+#if ((LCD_BUS_8BIT != 0u) || (LCD_USE_LOCKSTEP != 0u))
+    #define LCD_STM32_BUS_MASK       (LCD_STM32_NIBBLE_MASK | LCD_STM32_LOW_NIBBLE_MASK)
+#else
+    #define LCD_STM32_BUS_MASK       (LCD_STM32_NIBBLE_MASK)
+#endif /* (LCD_BUS_8BIT != 0u) || (LCD_USE_LOCKSTEP != 0u) */
+
+/* CRL fields of the data pins, so a direction change is a single store
+* (CNF 01 floating input, CNF 00 push-pull output at MODE 10, 2 MHz)
+*/
+#if ((LCD_STM32_BUS_MASK & 0xFF00u) != 0u)
+    #error "the data pins must be port bits 0 - 7 (CRL)"
+#endif /* LCD_STM32_BUS_MASK & 0xFF00u */
+#define LCD_STM32_CR_FIELDS(shift, cfg) (((uint32_t) (cfg) * 0x1111u) << ((shift) * 4u))
+#if ((LCD_BUS_8BIT != 0u) || (LCD_USE_LOCKSTEP != 0u))
+    #define LCD_STM32_BUS_CR_MASK    (LCD_STM32_CR_FIELDS(LCD_STM32_NIBBLE_SHIFT, 0xFu) | \
+                                      LCD_STM32_CR_FIELDS(LCD_STM32_LOW_NIBBLE_SHIFT, 0xFu))
+    #define LCD_STM32_BUS_CR_INPUT   (LCD_STM32_CR_FIELDS(LCD_STM32_NIBBLE_SHIFT, 0x4u) | \
+                                      LCD_STM32_CR_FIELDS(LCD_STM32_LOW_NIBBLE_SHIFT, 0x4u))
+    #define LCD_STM32_BUS_CR_OUTPUT  (LCD_STM32_CR_FIELDS(LCD_STM32_NIBBLE_SHIFT, 0x2u) | \
+                                      LCD_STM32_CR_FIELDS(LCD_STM32_LOW_NIBBLE_SHIFT, 0x2u))
+#else
+    #define LCD_STM32_BUS_CR_MASK    (LCD_STM32_CR_FIELDS(LCD_STM32_NIBBLE_SHIFT, 0xFu))
+    #define LCD_STM32_BUS_CR_INPUT   (LCD_STM32_CR_FIELDS(LCD_STM32_NIBBLE_SHIFT, 0x4u))
+    #define LCD_STM32_BUS_CR_OUTPUT  (LCD_STM32_CR_FIELDS(LCD_STM32_NIBBLE_SHIFT, 0x2u))
+#endif /* (LCD_BUS_8BIT != 0u) || (LCD_USE_LOCKSTEP != 0u) */
+
+/* Port bit of an LL_GPIO_PIN_x value (LL pins carry CRL/CRH info in upper bits) */
+#define LCD_PIN_BITS(pin)            (((uint32_t) (pin) >> GPIO_PIN_MASK_POS) & 0x0000FFFFu)
+
+/* BSRR set (lower half) and reset (upper half) words for port bits */
+#define LCD_BSRR_SET(bits)           ((uint32_t) (bits))
+#define LCD_BSRR_RESET(bits)         ((uint32_t) (bits) << 16u)
+
+/* BSRR word driving the data pins to "nibble" in a single store */
+#define LCD_NIBBLE_BSRR(nibble)      ((((uint32_t) (nibble) << LCD_STM32_NIBBLE_SHIFT) & LCD_STM32_NIBBLE_MASK) | \
+                                      (((~((uint32_t) (nibble) << LCD_STM32_NIBBLE_SHIFT)) & LCD_STM32_NIBBLE_MASK) << 16u))
+
+/* BSRR word driving DB0-DB3 to "nibble" (8-bit bus), or DB4-DB7 of the
+* lockstep display
+*/
+#define LCD_LOW_NIBBLE_BSRR(nibble)  ((((uint32_t) (nibble) << LCD_STM32_LOW_NIBBLE_SHIFT) & LCD_STM32_LOW_NIBBLE_MASK) | \
+                                      (((~((uint32_t) (nibble) << LCD_STM32_LOW_NIBBLE_SHIFT)) & LCD_STM32_LOW_NIBBLE_MASK) << 16u))
+
+#if (LCD_USE_PIN_MAP != 0u)
+/* Scattered pins (LCD_USE_PIN_MAP): bits, BSRR words and CR fields of each
+* port, folded to constants from the LCD_MAP_ pin list of LCD_Config.h
+*/
+#if (LCD_BUS_8BIT != 0u)
+    #error "LCD_USE_PIN_MAP maps the 4-bit bus only"
+#endif /* LCD_BUS_8BIT != 0u */
+
+#define LCD_MAP_PORT(index)          (((index) == 0u) ? LCD_MAP_PORT0 : LCD_MAP_PORT1)
+
+/* Bit of a pin on port "p", 0 when the pin is on the other port */
+#define LCD_MAP_PIN(p, port, bit)    (((port) == (p)) ? ((uint32_t) 1u << (bit)) : 0u)
+#define LCD_MAP_DATA_BITS(p)         (LCD_MAP_PIN(p, LCD_MAP_DB4_PORT, LCD_MAP_DB4_BIT) | \
+                                      LCD_MAP_PIN(p, LCD_MAP_DB5_PORT, LCD_MAP_DB5_BIT) | \
+                                      LCD_MAP_PIN(p, LCD_MAP_DB6_PORT, LCD_MAP_DB6_BIT) | \
+                                      LCD_MAP_PIN(p, LCD_MAP_DB7_PORT, LCD_MAP_DB7_BIT))
+#define LCD_MAP_USED(p)              ((LCD_MAP_DATA_BITS(p) | LCD_MAP_PIN(p, LCD_MAP_RS_PORT, LCD_MAP_RS_BIT) | \
+                                       LCD_MAP_PIN(p, LCD_MAP_RW_PORT, LCD_MAP_RW_BIT)) != 0u)
+
+/* BSRR word of port "p": its DB4-DB7 pins to "nibble", RS to "rs", R/nW low */
+#define LCD_MAP_LEVEL(p, port, bit, level) (((level) != 0u) ? LCD_BSRR_SET(LCD_MAP_PIN(p, port, bit)) : \
+                                                              LCD_BSRR_RESET(LCD_MAP_PIN(p, port, bit)))
+#define LCD_MAP_BSRR(p, rs, nibble)  (LCD_MAP_LEVEL(p, LCD_MAP_DB4_PORT, LCD_MAP_DB4_BIT, (nibble) & 0x1u) | \
+                                      LCD_MAP_LEVEL(p, LCD_MAP_DB5_PORT, LCD_MAP_DB5_BIT, (nibble) & 0x2u) | \
+                                      LCD_MAP_LEVEL(p, LCD_MAP_DB6_PORT, LCD_MAP_DB6_BIT, (nibble) & 0x4u) | \
+                                      LCD_MAP_LEVEL(p, LCD_MAP_DB7_PORT, LCD_MAP_DB7_BIT, (nibble) & 0x8u) | \
+                                      LCD_MAP_LEVEL(p, LCD_MAP_RS_PORT, LCD_MAP_RS_BIT, (rs)) | \
+                                      LCD_BSRR_RESET(LCD_MAP_PIN(p, LCD_MAP_RW_PORT, LCD_MAP_RW_BIT)))
+
+/* CRL (high 0u) or CRH (high 1u) fields of the data pins on port "p" */
+#define LCD_MAP_CR_PIN(p, high, port, bit, cfg) ((((port) == (p)) && (((bit) >> 3u) == (high))) ? \
+                                                 ((uint32_t) (cfg) << (((bit) & 7u) * 4u)) : 0u)
+#define LCD_MAP_DATA_CR(p, high, cfg) (LCD_MAP_CR_PIN(p, high, LCD_MAP_DB4_PORT, LCD_MAP_DB4_BIT, cfg) | \
+                                       LCD_MAP_CR_PIN(p, high, LCD_MAP_DB5_PORT, LCD_MAP_DB5_BIT, cfg) | \
+                                       LCD_MAP_CR_PIN(p, high, LCD_MAP_DB6_PORT, LCD_MAP_DB6_BIT, cfg) | \
+                                       LCD_MAP_CR_PIN(p, high, LCD_MAP_DB7_PORT, LCD_MAP_DB7_BIT, cfg))
+#define LCD_MAP_CTRL_CR(p, high, cfg) (LCD_MAP_CR_PIN(p, high, LCD_MAP_RS_PORT, LCD_MAP_RS_BIT, cfg) | \
+                                       LCD_MAP_CR_PIN(p, high, LCD_MAP_RW_PORT, LCD_MAP_RW_BIT, cfg))
+
+/* DB7-DB4 (bits 3-0) gathered from the input registers of both ports */
+#define LCD_MAP_IDR_PIN(idr0, idr1, port, bit) ((uint8_t) (((((port) == 0u) ? (idr0) : (idr1)) >> (bit)) & 1u))
+#define LCD_MAP_NIBBLE(idr0, idr1)   ((uint8_t) (LCD_MAP_IDR_PIN(idr0, idr1, LCD_MAP_DB4_PORT, LCD_MAP_DB4_BIT) | \
+                                      (LCD_MAP_IDR_PIN(idr0, idr1, LCD_MAP_DB5_PORT, LCD_MAP_DB5_BIT) << 1u) | \
+                                      (LCD_MAP_IDR_PIN(idr0, idr1, LCD_MAP_DB6_PORT, LCD_MAP_DB6_BIT) << 2u) | \
+                                      (LCD_MAP_IDR_PIN(idr0, idr1, LCD_MAP_DB7_PORT, LCD_MAP_DB7_BIT) << 3u)))
+
+/* LCD_MAP_BSRR() of each [port][rs][nibble], LCD.c */
+extern const uint32_t LCD_mapBsrr[2u][2u][16u];
+
+/* Nibble and RS, R/nW low: one store per port that carries mapped pins */
+#define LCD_MAP_WRITE(rs, nibble)    do { if (LCD_MAP_USED(0u)) { WRITE_REG(LCD_MAP_PORT0->BSRR, LCD_mapBsrr[0u][(rs)][(nibble)]); } \
+                                          if (LCD_MAP_USED(1u)) { WRITE_REG(LCD_MAP_PORT1->BSRR, LCD_mapBsrr[1u][(rs)][(nibble)]); } } while (0)
+
+/* CR fields "mask" of one port register to "fields", no store for an empty mask */
+#define LCD_MAP_CR_SET(p, reg, mask, fields) do { if ((mask) != 0u) \
+                                                  { WRITE_REG(LCD_MAP_PORT(p)->reg, (LCD_MAP_PORT(p)->reg & ~(mask)) | (fields)); } } while (0)
+#define LCD_MAP_CR_STORE(p, reg, high, cfg) LCD_MAP_CR_SET(p, reg, LCD_MAP_DATA_CR(p, high, 0xFu), LCD_MAP_DATA_CR(p, high, cfg))
+
+/* RS and R/nW pins, the data pins low and their direction */
+#define LCD_RS_PORT                  (LCD_MAP_PORT(LCD_MAP_RS_PORT))
+#define LCD_RS_BITS                  ((uint32_t) 1u << LCD_MAP_RS_BIT)
+#define LCD_RW_PORT                  (LCD_MAP_PORT(LCD_MAP_RW_PORT))
+#define LCD_RW_BITS                  ((uint32_t) 1u << LCD_MAP_RW_BIT)
+
+#define LCD_DATA_PINS_LOW()          do { if (LCD_MAP_DATA_BITS(0u) != 0u) { WRITE_REG(LCD_MAP_PORT0->BSRR, LCD_BSRR_RESET(LCD_MAP_DATA_BITS(0u))); } \
+                                          if (LCD_MAP_DATA_BITS(1u) != 0u) { WRITE_REG(LCD_MAP_PORT1->BSRR, LCD_BSRR_RESET(LCD_MAP_DATA_BITS(1u))); } } while (0)
+#define LCD_MAP_DATA_MODE(cfg)       do { LCD_MAP_CR_STORE(0u, CRL, 0u, cfg); LCD_MAP_CR_STORE(0u, CRH, 1u, cfg); \
+                                          LCD_MAP_CR_STORE(1u, CRL, 0u, cfg); LCD_MAP_CR_STORE(1u, CRH, 1u, cfg); } while (0)
+#define LCD_DATA_PINS_INPUT()        LCD_MAP_DATA_MODE(0x4u)
+#define LCD_DATA_PINS_OUTPUT()       LCD_MAP_DATA_MODE(0x2u)
+#else
+/* RS, R/nW and the data pins of the contiguous layout; the data pin
+* direction is a single CRL store
+*/
+#define LCD_RS_PORT                  (RS_GPIO_Port)
+#define LCD_RS_BITS                  LCD_PIN_BITS(RS_Pin)
+#define LCD_RW_PORT                  (RnW_GPIO_Port)
+#define LCD_RW_BITS                  LCD_PIN_BITS(RnW_Pin)
+
+#define LCD_DATA_PINS_LOW()          WRITE_REG(DB4_GPIO_Port->BSRR, LCD_BSRR_RESET(LCD_STM32_BUS_MASK))
+#define LCD_DATA_PINS_INPUT()        WRITE_REG(DB4_GPIO_Port->CRL, (DB4_GPIO_Port->CRL & ~LCD_STM32_BUS_CR_MASK) | \
+                                               LCD_STM32_BUS_CR_INPUT)
+#define LCD_DATA_PINS_OUTPUT()       WRITE_REG(DB4_GPIO_Port->CRL, (DB4_GPIO_Port->CRL & ~LCD_STM32_BUS_CR_MASK) | \
+                                               LCD_STM32_BUS_CR_OUTPUT)
+#endif /* LCD_USE_PIN_MAP != 0u */
+
 /* LCD Module Address Constants */
 #define LCD_ROW_0_START              (0x80u)
 #define LCD_ROW_1_START              (0xC0u)
@@ -96,6 +283,34 @@ void LCD_PrintU32Number(uint32_t value) ;
 /* Point to Display Data Ram 0 */
 #define LCD_DDRAM_0                  (0x80u)
 
+/* Address counter tracking (2-line mode: 0x00-0x27 and 0x40-0x67) */
+#define LCD_DDRAM_ADDRESS_MASK       (0x7Fu)
+#define LCD_DDRAM_LINE_LENGTH        (0x28u)
+#define LCD_DDRAM_LINE_1             (0x40u)
+#define LCD_CURSOR_UNKNOWN           (0xFFu)
+#define LCD_ROOM_UNBOUNDED           (SIZE_MAX)   /* Cursor the geometry does not bound */
+#define LCD_ENTRY_MODE_MASK          (0xFCu)
+#define LCD_ENTRY_MODE_SET           (0x04u)
+#define LCD_ENTRY_INCREMENT          (0x02u)
+#define LCD_SHIFT_MASK               (0xF0u)
+#define LCD_SHIFT_CMD                (0x10u)
+#define LCD_SHIFT_DISPLAY            (0x08u)
+#define LCD_SHIFT_RIGHT              (0x04u)
+#define LCD_CGRAM_MASK               (0xC0u)
+
+/* Command groups mirrored for LCD_RestoreConfig(), and their power-on
+ * values (8-bit, 1 line, increment, display off)
+ */
+#define LCD_FUNCTION_SET_MASK        (0xE0u)
+#define LCD_FUNCTION_SET_CMD         (0x20u)
+#define LCD_DISPLAY_CONTROL_MASK     (0xF8u)
+#define LCD_DISPLAY_CONTROL_CMD      (0x08u)
+#define LCD_DISPLAY_ON_BIT           (0x04u)
+#define LCD_FUNCTION_SET_DL          (0x10u)   /* 8-bit interface */
+#define LCD_FUNCTION_SET_POR         (0x30u)
+#define LCD_ENTRY_MODE_POR           (0x06u)
+#define LCD_DISPLAY_CONTROL_POR      (0x08u)
+
 /* LCD Characteristics */
 #define LCD_CHARACTER_WIDTH          (0x05u)
 #define LCD_CHARACTER_HEIGHT         (0x08u)
@@ -122,10 +337,42 @@ void LCD_PrintU32Number(uint32_t value) ;
 #define LCD_ZERO_CHAR_ASCII          (48u)
 
 #define LCD_LONGEST_CMD_US           (0x651u)
-#define LCD_WAIT_CYCLE               (0x10u)
-#define LCD_READY_DELAY              ((LCD_LONGEST_CMD_US * 4u)/(LCD_WAIT_CYCLE))
+
+/* Busy flag poll gives up after this long (cycles derived from SystemCoreClock) */
+#define LCD_READY_TIMEOUT_US         (LCD_LONGEST_CMD_US * 4u)
 
 #define LCD_READY_BIT				 (0x08u)
 
+/* Command execution times (HD44780 datasheet, fosc = 270 kHz, plus margin) */
+#define LCD_EXEC_SHORT_US            (40u)
+#define LCD_EXEC_LONG_US             (LCD_LONGEST_CMD_US)
+
+/* Initialization sequence steps (LCD_InitPoll) */
+#define LCD_INIT_NIBBLE_STEPS        (4u)
+#define LCD_INIT_COMMAND_STEPS       (7u)
+#define LCD_INIT_SETTLE_MS           (5u)
+#define LCD_INIT_STEP_DONE           (0xFEu)
+#define LCD_INIT_STEP_IDLE           (0xFFu)
+
+/* Link state of a display (LCD_IsReady() timeouts, LCD_RecoverPoll()) */
+#define LCD_LINK_UP                  (0u)      /* answers, writes are sent */
+#define LCD_LINK_LOST                (1u)      /* timed out, writes are dropped */
+#define LCD_LINK_BACK                (2u)      /* answers again, waits for re-initialization */
+#define LCD_LINK_ABSENT              (3u)      /* no controller found (LCD_USE_DETECT), never probed again */
+
+/* Queued bus item encoding (DMA and interrupt-driven transports):
+ * low byte is the value, LCD_ITEM_RS selects the data register
+ */
+#define LCD_ITEM_RS                  (0x0100u)
+#define LCD_ITEM_DATA(dByte)         ((uint16_t) (LCD_ITEM_RS | (uint8_t) (dByte)))
+#define LCD_ITEM_CMD(cByte)          ((uint16_t) (uint8_t) (cByte))
+
+/* Clear display and return home are the only commands taking 1.52 ms */
+#define LCD_IS_LONG_CMD(cByte)       (((cByte) != 0u) && ((cByte) <= LCD_RESET_CURSOR_POSITION))
+
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif /* INC_LCD_H_ */
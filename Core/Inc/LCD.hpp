@@ -0,0 +1,246 @@
+/*
+ * LCD.hpp
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Header-only C++17 binding of the HD44780 4-bit driver.
+ *
+ *  			Hd44780<DataPort, Shift, RsPin, RwPin, EPin, Rows, Cols> binds the
+ *  			display to a GPIO port at compile time. Nibble masks, BSRR words,
+ *  			CRL/CRH images for the busy-flag read, DDRAM row offsets and the
+ *  			bus gaps of LCD_TIMING_PROFILE are constexpr, so every transfer
+ *  			compiles to straight-line stores to BSRR and CRL/CRH (no
+ *  			LL_GPIO_SetPinMode or runtime masking).
+ *
+ *  Usage:      - DataPort is the port base address (e.g. GPIOC_BASE), Shift is
+ *  				the bit of DB4 (DB4-DB7 contiguous, 0 - 12)
+ *  			- RsPin, RwPin and EPin are bit numbers on the same port as the
+ *  				data lines (same requirement as LCD_CTRL_ON_DATA_PORT)
+ *  			- pins must already be configured as push-pull outputs (CubeMX)
+ *  			- delays run on the DWT cycle counter, CoreHz defaults to 72 MHz
+ *
+ *  			using Lcd = Hd44780<GPIOC_BASE, 0u, 8u, 9u, 12u, 2u, 40u>;
+ *  			Lcd::Init();
+ *  			Lcd::Position(0u, 0u);
+ *  			Lcd::PrintString("Hello");
+ *
+ */
+
+#ifndef INC_LCD_HPP_
+#define INC_LCD_HPP_
+
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Timing.h"
+
+template <uint32_t DataPort, uint32_t Shift, uint32_t RsPin, uint32_t RwPin, uint32_t EPin,
+          uint8_t Rows, uint8_t Cols, uint32_t CoreHz = 72000000u>
+class Hd44780
+{
+public:
+
+    /***************************************
+    *        Compile-Time Constants
+    ***************************************/
+
+    static_assert(Shift <= 12u, "DB4-DB7 must fit in the 16-bit port");
+    static_assert((RsPin < 16u) && (RwPin < 16u) && (EPin < 16u), "control pins are port bits 0 - 15");
+    static_assert((Rows >= 1u) && (Rows <= 4u), "HD44780 drives 1 to 4 rows");
+    static_assert((Cols >= 1u) && ((Rows * Cols) <= 80u), "HD44780 DDRAM holds 80 characters");
+
+    static constexpr uint32_t NibbleMask = 0x000Fu << Shift;
+    static constexpr uint32_t RsBit = 1u << RsPin;
+    static constexpr uint32_t RwBit = 1u << RwPin;
+    static constexpr uint32_t EBit = 1u << EPin;
+
+    static_assert((NibbleMask & (RsBit | RwBit | EBit)) == 0u, "control pins overlap DB4-DB7");
+    static_assert((RsBit != RwBit) && (RsBit != EBit) && (RwBit != EBit), "control pins must differ");
+
+    /* BSRR word for the data lines, RS and R/nW low (write) */
+    static constexpr uint32_t NibbleBsrr(uint8_t rs, uint8_t nibble)
+    {
+        uint32_t const bits = ((uint32_t) (nibble & LCD_NIBBLE_MASK)) << Shift;
+
+        return LCD_BSRR_SET(bits) | LCD_BSRR_RESET(NibbleMask & ~bits) |
+               ((rs != 0u) ? LCD_BSRR_SET(RsBit) : LCD_BSRR_RESET(RsBit)) | LCD_BSRR_RESET(RwBit);
+    }
+
+    /* DB4-DB7 live in CRL for Shift 0 - 4 and in CRH for Shift 8 - 12 */
+    static_assert(((Shift + 3u) / 8u) == (Shift / 8u), "DB4-DB7 must not straddle CRL and CRH");
+
+    static constexpr uint32_t CrShift = (Shift & 7u) * 4u;
+    static constexpr uint32_t CrMask = 0xFFFFu << CrShift;
+    static constexpr uint32_t CrInput = 0x4444u << CrShift;    /* CNF 01 floating, MODE 00 input */
+    static constexpr uint32_t CrOutput = 0x2222u << CrShift;   /* CNF 00 push-pull, MODE 10 2 MHz */
+
+    /* Rows 2 and 3 continue DDRAM lines 0 and 1 after the first Cols cells
+     * (0x14/0x54 on 20 column modules, 0x10/0x50 on 16 column ones)
+     */
+    static constexpr uint8_t RowStart[4u] = { LCD_ROW_0_START, LCD_ROW_1_START,
+                                              (uint8_t) (LCD_ROW_0_START + ((Rows > 2u) ? Cols : 0u)),
+                                              (uint8_t) (LCD_ROW_1_START + ((Rows > 2u) ? Cols : 0u)) };
+
+    static constexpr uint32_t CyclesPerUs = CoreHz / 1000000u;
+
+    /* HD44780 bus timing in core cycles (rounded up) */
+    static constexpr uint32_t Cycles(uint32_t ns)
+    {
+        return ((ns * CyclesPerUs) + 999u) / 1000u;
+    }
+
+
+    /***************************************
+    *        Interface
+    ***************************************/
+
+    /* Power-on handshake and command sequence, same as LCD_Init() */
+    static void Init()
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+        HAL_Delay(40u);
+        WriteNibble<0u>(LCD_DISPLAY_8_BIT_INIT);
+        HAL_Delay(5u);
+        WriteNibble<0u>(LCD_DISPLAY_8_BIT_INIT);
+        HAL_Delay(15u);
+        WriteNibble<0u>(LCD_DISPLAY_8_BIT_INIT);
+        HAL_Delay(1u);
+        WriteNibble<0u>(LCD_DISPLAY_4_BIT_INIT);
+        HAL_Delay(5u);
+
+        WriteControl(LCD_CURSOR_AUTO_INCR_ON);
+        WriteControl(LCD_DISPLAY_CURSOR_ON);
+        WriteControl(LCD_DISPLAY_2_LINES_5x10);
+        WriteControl(LCD_DISPLAY_CURSOR_OFF);
+        WriteControl(LCD_CLEAR_DISPLAY);
+        WriteControl(LCD_DISPLAY_ON_CURSOR_OFF);
+        WriteControl(LCD_RESET_CURSOR_POSITION);
+
+        HAL_Delay(5u);
+    }
+
+    static void WriteControl(uint8_t cByte)
+    {
+        IsReady();
+        WriteNibble<0u>((uint8_t) (cByte >> LCD_NIBBLE_SHIFT));
+        WriteNibble<0u>(cByte);
+    }
+
+    static void WriteData(uint8_t dByte)
+    {
+        IsReady();
+        WriteNibble<1u>((uint8_t) (dByte >> LCD_NIBBLE_SHIFT));
+        WriteNibble<1u>(dByte);
+    }
+
+    static void PutChar(char character)
+    {
+        WriteData((uint8_t) character);
+    }
+
+    static void PrintString(char const string[])
+    {
+        for (uint32_t index = 0u; string[index] != '\0'; index++)
+        {
+            WriteData((uint8_t) string[index]);
+        }
+    }
+
+    /* Out of range rows are ignored, columns wrap within the DDRAM line */
+    static void Position(uint8_t row, uint8_t column)
+    {
+        if (row < Rows)
+        {
+            WriteControl((uint8_t) (RowStart[row] + column));
+        }
+    }
+
+    static void ClearDisplay()
+    {
+        WriteControl(LCD_CLEAR_DISPLAY);
+    }
+
+    /* Polls the busy flag, gives up after LCD_READY_TIMEOUT_US */
+    static void IsReady()
+    {
+        uint32_t const start = DWT->CYCCNT;
+        uint32_t value;
+
+        /* Data lines low and to input, RS low, R/nW high to read */
+        Port()->BSRR = LCD_BSRR_RESET(NibbleMask | RsBit) | LCD_BSRR_SET(RwBit);
+        ConfigReg() = (ConfigReg() & ~CrMask) | CrInput;
+
+        do
+        {
+            Delay<Cycles(LCD_T_AS_NS)>();
+            Port()->BSRR = LCD_BSRR_SET(EBit);
+            Delay<Cycles(LCD_T_READ_NS)>();
+            value = Port()->IDR & ((uint32_t) LCD_READY_BIT << Shift);
+            Port()->BSRR = LCD_BSRR_RESET(EBit);
+
+            /* Second E pulse reads the low nibble (address counter), dropped */
+            Delay<Cycles(LCD_T_RECOVER_NS)>();
+            Port()->BSRR = LCD_BSRR_SET(EBit);
+            Delay<Cycles(LCD_T_READ_NS)>();
+            Port()->BSRR = LCD_BSRR_RESET(EBit);
+            Delay<Cycles(LCD_T_RECOVER_NS)>();
+
+            if (value != 0u)
+            {
+                Delay<10u * CyclesPerUs>();
+            }
+
+        } while ((value != 0u) &&
+                 ((uint32_t) (DWT->CYCCNT - start) < (LCD_READY_TIMEOUT_US * CyclesPerUs)));
+
+        /* R/nW low, data lines back to output */
+        Port()->BSRR = LCD_BSRR_RESET(RwBit);
+        ConfigReg() = (ConfigReg() & ~CrMask) | CrOutput;
+    }
+
+private:
+
+    static GPIO_TypeDef *Port()
+    {
+        return reinterpret_cast<GPIO_TypeDef *>(DataPort);
+    }
+
+    static volatile uint32_t &ConfigReg()
+    {
+        return (Shift < 8u) ? Port()->CRL : Port()->CRH;
+    }
+
+    template <uint32_t CycleCount>
+    static void Delay()
+    {
+        uint32_t const start = DWT->CYCCNT;
+
+        while ((uint32_t) (DWT->CYCCNT - start) < CycleCount)
+        {
+        }
+    }
+
+    /* One nibble: data + RS/RW in a single store, then the E pulse */
+    template <uint8_t Rs>
+    static void WriteNibble(uint8_t nibble)
+    {
+        static constexpr uint32_t table[16u] =
+        {
+            NibbleBsrr(Rs, 0u),  NibbleBsrr(Rs, 1u),  NibbleBsrr(Rs, 2u),  NibbleBsrr(Rs, 3u),
+            NibbleBsrr(Rs, 4u),  NibbleBsrr(Rs, 5u),  NibbleBsrr(Rs, 6u),  NibbleBsrr(Rs, 7u),
+            NibbleBsrr(Rs, 8u),  NibbleBsrr(Rs, 9u),  NibbleBsrr(Rs, 10u), NibbleBsrr(Rs, 11u),
+            NibbleBsrr(Rs, 12u), NibbleBsrr(Rs, 13u), NibbleBsrr(Rs, 14u), NibbleBsrr(Rs, 15u)
+        };
+
+        Port()->BSRR = table[nibble & LCD_NIBBLE_MASK];
+        Delay<Cycles(LCD_T_AS_NS)>();
+        Port()->BSRR = LCD_BSRR_SET(EBit);
+        Delay<Cycles(LCD_T_PWEH_NS)>();
+        Port()->BSRR = LCD_BSRR_RESET(EBit);
+        Delay<Cycles(LCD_T_RECOVER_NS)>();
+    }
+};
+
+#endif /* INC_LCD_HPP_ */
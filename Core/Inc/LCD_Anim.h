@@ -0,0 +1,38 @@
+/*
+ * LCD_Anim.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_ANIM_H_
+#define INC_LCD_ANIM_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_ANIMATION != 0u)
+    uint8_t LCD_AnimStart(uint8_t const (*frames)[LCD_GLYPH_ROWS], uint8_t frameCount, uint32_t periodMs) ;
+    void LCD_AnimStop(uint8_t code) ;
+    void LCD_AnimTask(void) ;
+#endif /* LCD_USE_ANIMATION != 0u */
+
+/***************************************
+*        Global Variables
+***************************************/
+
+#if (LCD_USE_ANIMATION != 0u)
+    /* Four-step rotating bar, for LCD_AnimStart(LCD_animSpinner, LCD_ANIM_SPINNER_FRAMES, ...) */
+    extern uint8_t const LCD_animSpinner[][LCD_GLYPH_ROWS];
+#endif /* LCD_USE_ANIMATION != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+#define LCD_ANIM_SPINNER_FRAMES      (4u)
+
+#endif /* INC_LCD_ANIM_H_ */
@@ -0,0 +1,39 @@
+/*
+ * LCD_Arena.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_ARENA_H_
+#define INC_LCD_ARENA_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_ARENA != 0u)
+    void *LCD_ArenaAlloc(uint8_t owner, uint16_t size) ;
+    void LCD_ArenaRelease(uint8_t owner) ;
+    uint16_t LCD_ArenaUsed(uint8_t owner) ;
+    uint16_t LCD_ArenaPeak(uint8_t owner) ;
+#endif /* LCD_USE_ARENA != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Owners of arena memory, each within its LCD_ARENA_xxx_BYTES budget */
+#define LCD_ARENA_LIST               (0u)
+#define LCD_ARENA_APP                (1u)
+#define LCD_ARENA_OWNERS             (2u)
+
+/* Whole arena */
+#define LCD_ARENA_SIZE               (LCD_ARENA_LIST_BYTES + LCD_ARENA_APP_BYTES)
+
+/* Granule of every allocation, keeps uint32_t buffers aligned */
+#define LCD_ARENA_ALIGN              (4u)
+
+#endif /* INC_LCD_ARENA_H_ */
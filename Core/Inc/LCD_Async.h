@@ -0,0 +1,48 @@
+/*
+ * LCD_Async.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_ASYNC_H_
+#define INC_LCD_ASYNC_H_
+
+#include "LCD_Config.h"
+
+/* Called from the TIM4 interrupt when the queue drained and the last
+ * command finished executing
+ */
+typedef void (*LCD_AsyncCallback)(void);
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+void LCD_AsyncStart(void) ;
+uint8_t LCD_WriteAsync(uint16_t item) ;
+uint16_t LCD_WriteAsyncBuffer(uint16_t const items[], uint16_t count) ;
+uint16_t LCD_PrintStringAsync(char const string[]) ;
+uint8_t LCD_PositionAsync(uint8_t row, uint8_t column) ;
+#if (LCD_USE_ASYNC_URGENT != 0u)
+    uint8_t LCD_WriteAsyncUrgent(uint16_t const items[], uint16_t count) ;
+    uint8_t LCD_PrintUrgentAsync(uint8_t row, uint8_t column, char const string[]) ;
+#endif /* LCD_USE_ASYNC_URGENT != 0u */
+uint8_t LCD_IsIdle(void) ;
+void LCD_SetAsyncCallback(LCD_AsyncCallback callback) ;
+void LCD_AsyncIRQHandler(void) ;
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* TIM4 tick, prescaler set by delay_clock_update() for any core clock */
+#define LCD_ASYNC_TICKS_PER_US       (LCD_TIM4_TICK_HZ / 1000000u)
+
+/* Item that sets the address counter itself (clear, home, set CGRAM/DDRAM
+ * address): the urgent queue may go out in front of it
+ */
+#define LCD_ASYNC_IS_RUN_START(item) \
+    ((((item) & LCD_ITEM_RS) == 0u) && ((((item) & 0xC0u) != 0u) || LCD_IS_LONG_CMD((item) & 0xFFu)))
+
+#endif /* INC_LCD_ASYNC_H_ */
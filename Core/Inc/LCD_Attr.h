@@ -0,0 +1,42 @@
+/*
+ * LCD_Attr.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_ATTR_H_
+#define INC_LCD_ATTR_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_ATTRIBUTES != 0u)
+    void LCD_AttrSet(uint8_t row, uint8_t column, uint8_t width, uint8_t flags) ;
+    void LCD_AttrClear(void) ;
+    void LCD_AttrReset(void) ;
+    uint8_t LCD_AttrStore(uint8_t row, uint8_t column, uint8_t character) ;
+    uint8_t LCD_AttrTask(void) ;
+#endif /* LCD_USE_ATTRIBUTES != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* LCD_AttrSet() flags, 0 = plain text */
+#define LCD_ATTR_BLINK               (0x01u)
+#define LCD_ATTR_HIGHLIGHT           (0x02u)
+
+/***************************************
+*        Global Variables
+***************************************/
+
+#if (LCD_USE_ATTRIBUTES != 0u)
+    /* Flags of every framebuffer cell, 0 for plain text */
+    extern uint8_t LCD_attrCell[LCD_ROWS][LCD_COLUMNS];
+#endif /* LCD_USE_ATTRIBUTES != 0u */
+
+#endif /* INC_LCD_ATTR_H_ */
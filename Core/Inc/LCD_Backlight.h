@@ -0,0 +1,35 @@
+/*
+ * LCD_Backlight.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_BACKLIGHT_H_
+#define INC_LCD_BACKLIGHT_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_BACKLIGHT_PWM != 0u)
+    void LCD_BacklightStart(void) ;
+    void LCD_SetBacklight(uint8_t level) ;
+    void LCD_FadeBacklight(uint8_t level, uint16_t ms) ;
+    uint8_t LCD_GetBacklight(void) ;
+    uint8_t LCD_BacklightIsFading(void) ;
+    void LCD_BacklightActivity(void) ;
+    void LCD_BacklightTick(void) ;
+#endif /* LCD_USE_BACKLIGHT_PWM != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Brightness range, 0 = off, LCD_BACKLIGHT_MAX = fully on */
+#define LCD_BACKLIGHT_OFF            (0u)
+#define LCD_BACKLIGHT_MAX            (255u)
+
+#endif /* INC_LCD_BACKLIGHT_H_ */
@@ -0,0 +1,28 @@
+/*
+ * LCD_Bar.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_BAR_H_
+#define INC_LCD_BAR_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Bargraph orientation, part of the key of a remembered bargraph */
+#define LCD_BAR_HORIZONTAL           (0u)
+#define LCD_BAR_VERTICAL             (1u)
+
+/* Cell contents outside the partial glyphs (HD44780 ROM) */
+#define LCD_BAR_EMPTY                (0x20u)
+#define LCD_BAR_FULL                 (0xFFu)
+
+/* Remembered bargraph slot not in use */
+#define LCD_BAR_UNUSED               (0xFFu)
+
+#endif /* INC_LCD_BAR_H_ */
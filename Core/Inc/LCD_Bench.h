@@ -0,0 +1,51 @@
+/*
+ * LCD_Bench.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_BENCH_H_
+#define INC_LCD_BENCH_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#ifdef LCD_BENCHMARK
+    void LCD_BenchRun(void) ;
+#endif /* LCD_BENCHMARK */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Wait modes and transports, one report block each */
+#define LCD_BENCH_POLL               (0u)      /* busy flag before every byte */
+#define LCD_BENCH_FIXED              (1u)      /* datasheet execution times, no read-back */
+#define LCD_BENCH_ELAPSED            (2u)      /* busy flag only while not elapsed */
+#define LCD_BENCH_CALIBRATED         (3u)      /* LCD_Calibrate() execution times */
+#define LCD_BENCH_DMA                (4u)      /* LCD_DmaWrite() */
+#define LCD_BENCH_ASYNC              (5u)      /* LCD_WriteAsyncBuffer() */
+#define LCD_BENCH_MODES              (6u)
+
+/* Test cases */
+#define LCD_BENCH_CHAR               (0u)      /* one data byte */
+#define LCD_BENCH_LINE               (1u)      /* address + one full row */
+#define LCD_BENCH_FRAME              (2u)      /* address + row, every row */
+#define LCD_BENCH_COUNTER            (3u)      /* address + 10-digit counter */
+#define LCD_BENCH_CLEAR              (4u)      /* clear display */
+#define LCD_BENCH_CGRAM              (5u)      /* all 8 CGRAM glyphs */
+#define LCD_BENCH_CASES              (6u)
+
+/* Operations timed per case */
+#define LCD_BENCH_REPEAT             (16u)
+
+/* Item buffer, holds the full frame or the CGRAM case */
+#define LCD_BENCH_CGRAM_BYTES        (8u * LCD_GLYPH_ROWS)
+#define LCD_BENCH_ITEMS_MAX          ((LCD_ROWS * (LCD_COLUMNS + 1u)) + LCD_BENCH_CGRAM_BYTES + 2u)
+#define LCD_BENCH_COUNTER_DIGITS     (10u)
+
+#endif /* INC_LCD_BENCH_H_ */
@@ -0,0 +1,36 @@
+/*
+ * LCD_Big.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_BIG_H_
+#define INC_LCD_BIG_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_BIG_DIGITS != 0u)
+    void LCD_PrintBigNumber(uint8_t row, uint8_t column, uint32_t value, uint8_t digits) ;
+    void LCD_BigInvalidate(void) ;
+#endif /* LCD_USE_BIG_DIGITS != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Cells of one numeral, and the blank column between numerals */
+#define LCD_BIG_WIDTH                (3u)
+#define LCD_BIG_PITCH                (LCD_BIG_WIDTH + 1u)
+
+/* Widest number (uint32_t) */
+#define LCD_BIG_MAX_DIGITS           (10u)
+
+/* Remembered digit of a number not drawn yet */
+#define LCD_BIG_UNKNOWN              (0xFFu)
+
+#endif /* INC_LCD_BIG_H_ */
@@ -0,0 +1,55 @@
+/*
+ * LCD_Blob.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_BLOB_H_
+#define INC_LCD_BLOB_H_
+
+#include "LCD_Config.h"
+#include "LCD.h"
+#include "LCD_Geometry.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* One command byte and the data bytes sent after it */
+typedef struct
+{
+    uint8_t command;                /* Set DDRAM address, clear display, ... */
+    uint8_t length;                 /* Data bytes, 0 for a lone command */
+    char const *text;
+} LCD_BLOB_SEGMENT;
+
+/* Constant screen, normally a const table in flash */
+typedef struct
+{
+    LCD_BLOB_SEGMENT const *segments;
+    uint8_t count;
+} LCD_BLOB;
+
+/* Segment entries, the DDRAM address is resolved for LCD_GEOMETRY by the
+ * compiler and the length is taken from the string literal
+ */
+#define LCD_BLOB_COMMAND(cByte)      { (cByte), 0u, NULL }
+#define LCD_BLOB_TEXT(row, column, string) \
+    { (uint8_t) (LCD_DDRAM_0 | LCD_GEOMETRY_ADDRESS((row), (column))), \
+      (uint8_t) (sizeof(string) - 1u), (string) }
+
+/* Blob of a whole segment table */
+#define LCD_BLOB_INIT(segments) \
+    { (segments), (uint8_t) (sizeof(segments) / sizeof((segments)[0])) }
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_BLOB != 0u)
+    void LCD_PlayBlob(LCD_BLOB const *blob) ;
+    void LCD_BlobMirror(LCD_BLOB const *blob) ;
+#endif /* LCD_USE_BLOB != 0u */
+
+#endif /* INC_LCD_BLOB_H_ */
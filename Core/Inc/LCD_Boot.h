@@ -0,0 +1,71 @@
+/*
+ * LCD_Boot.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_BOOT_H_
+#define INC_LCD_BOOT_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Boot markers, in the order main() normally reaches them */
+#define LCD_BOOT_MAIN                (0u)      /* main() entered, C runtime set up */
+#define LCD_BOOT_HAL_INIT            (1u)      /* HAL_Init() returned */
+#define LCD_BOOT_CLOCK               (2u)      /* SystemClock_Config() returned */
+#define LCD_BOOT_GPIO                (3u)      /* MX_GPIO_Init() returned */
+#define LCD_BOOT_TIM4                (4u)      /* MX_TIM4_Init() returned */
+#define LCD_BOOT_LCD_BEGIN           (5u)      /* LCD_InitBegin() returned */
+#define LCD_BOOT_LCD_READY           (6u)      /* Controller initialized, cold or warm */
+#define LCD_BOOT_LCD_START           (7u)      /* LCD_Start() returned */
+#define LCD_BOOT_FIRST_CHAR          (8u)      /* First character written to DDRAM */
+#define LCD_BOOT_FIRST_FRAME         (9u)      /* First flush with characters finished */
+#define LCD_BOOT_MARKS               (10u)
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Marker timestamps since reset; a marker is kept from its first time only */
+typedef struct
+{
+    uint32_t cycles[LCD_BOOT_MARKS];    /* DWT CYCCNT */
+    uint32_t us[LCD_BOOT_MARKS];        /* Microseconds, across the clock switch */
+    uint32_t recorded;                  /* Bit per marker, 1 = taken */
+} LCD_BOOT;
+
+/* Sends one character of the report (ITM, UART, ...) */
+typedef void (*LCD_BootPutChar)(char character);
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_BOOT_MARKERS != 0u)
+    void LCD_BootReset(void) ;
+    void LCD_BootMark(uint8_t mark) ;
+    void LCD_BootReport(LCD_BootPutChar putChar) ;
+    void LCD_BootItmPutChar(char character) ;
+#endif /* LCD_USE_BOOT_MARKERS != 0u */
+
+/***************************************
+*        Instrumentation Macros
+***************************************/
+
+#if (LCD_USE_BOOT_MARKERS != 0u)
+    /* Kept in RAM for the debugger ("LCD_boot" in the expressions view) */
+    extern LCD_BOOT LCD_boot;
+
+    #define LCD_BOOT_MARK(mark)  \
+        do { if ((LCD_boot.recorded & (1u << (mark))) == 0u) { LCD_BootMark(mark); } } while (0)
+#else
+    /* Markers compile to nothing */
+    #define LCD_BOOT_MARK(mark)  ((void) 0)
+#endif /* LCD_USE_BOOT_MARKERS != 0u */
+
+#endif /* INC_LCD_BOOT_H_ */
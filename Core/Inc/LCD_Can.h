@@ -0,0 +1,73 @@
+/*
+ * LCD_Can.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_CAN_H_
+#define INC_LCD_CAN_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Field formats; integers are read little-endian unless LCD_CAN_MSB_FIRST
+ * is or-ed in
+ */
+#define LCD_CAN_TEXT                 (0u)      /* width payload bytes as characters */
+#define LCD_CAN_U8                   (1u)
+#define LCD_CAN_U16                  (2u)
+#define LCD_CAN_S16                  (3u)
+#define LCD_CAN_U32                  (4u)
+#define LCD_CAN_S32                  (5u)
+#define LCD_CAN_FORMAT_MASK          (0x0Fu)
+#define LCD_CAN_MSB_FIRST            (0x80u)   /* big-endian ("Motorola") signal */
+
+/* Largest standard identifier */
+#define LCD_CAN_ID_MAX               (0x7FFu)
+
+/* Identifiers the acceptance filters hold: 14 banks of four 16-bit list
+ * entries
+ */
+#define LCD_CAN_FILTER_BANKS         (14u)
+#define LCD_CAN_FILTERS              (4u * LCD_CAN_FILTER_BANKS)
+
+/* Shown in every cell of a number wider than its field */
+#define LCD_CAN_OVERFLOW             ('*')
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* One field of a CAN screen: a signal of the frames with identifier id,
+* drawn right-justified (texts: as they are) into width cells at row, column
+*/
+typedef struct
+{
+    uint16_t id;                    /* Standard (11-bit) identifier */
+    uint8_t offset;                 /* First payload byte of the signal */
+    uint8_t format;                 /* LCD_CAN_... */
+    uint8_t decimals;               /* Integers: shown as value / 10^decimals */
+    uint8_t row;
+    uint8_t column;
+    uint8_t width;                  /* Cells, at most LCD_COLUMNS */
+} LCD_CAN_FIELD;
+
+/* Table entries */
+#define LCD_CAN_FIELD_INIT(id, offset, format, decimals, row, column, width) \
+    { (id), (offset), (format), (decimals), (row), (column), (width) }
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_CAN != 0u)
+    uint8_t LCD_CanStart(LCD_CAN_FIELD const table[], uint8_t count) ;
+    void LCD_CanIRQHandler(void) ;
+    uint32_t LCD_CanErrors(void) ;
+#endif /* LCD_USE_CAN != 0u */
+
+#endif /* INC_LCD_CAN_H_ */
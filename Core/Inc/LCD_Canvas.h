@@ -0,0 +1,62 @@
+/*
+ * LCD_Canvas.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_CANVAS_H_
+#define INC_LCD_CANVAS_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* A bitmap over cellsWide x cellsHigh pinned CGRAM slots, cell by cell, row
+* by row. bits holds the 5 pixels of a glyph row in bits 4 (left) - 0, dirty
+* one bit per glyph row not uploaded yet. sweep and lastY belong to
+* LCD_CanvasPush().
+*/
+typedef struct
+{
+    uint8_t bits[LCD_CANVAS_MAX_CELLS][LCD_GLYPH_ROWS];
+    uint8_t dirty[LCD_CANVAS_MAX_CELLS];
+    uint8_t slot[LCD_CANVAS_MAX_CELLS];
+    uint8_t cellsWide;
+    uint8_t cellsHigh;
+    uint8_t sweep;
+    uint8_t lastY;
+} LCD_CANVAS;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_CANVAS != 0u)
+    uint8_t LCD_CanvasOpen(LCD_CANVAS *canvas, uint8_t cellsWide, uint8_t cellsHigh) ;
+    void LCD_CanvasClose(LCD_CANVAS *canvas) ;
+    void LCD_CanvasShow(LCD_CANVAS const *canvas, uint8_t row, uint8_t column) ;
+    void LCD_CanvasClear(LCD_CANVAS *canvas) ;
+    void LCD_CanvasPixel(LCD_CANVAS *canvas, uint8_t x, uint8_t y, uint8_t on) ;
+    void LCD_CanvasLine(LCD_CANVAS *canvas, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) ;
+    void LCD_CanvasColumn(LCD_CANVAS *canvas, uint8_t x, uint8_t y0, uint8_t y1, uint8_t on) ;
+    void LCD_CanvasSparkline(LCD_CANVAS *canvas, int16_t const samples[], uint8_t count,
+                             int16_t min, int16_t max) ;
+    void LCD_CanvasPush(LCD_CANVAS *canvas, int16_t value, int16_t min, int16_t max) ;
+    void LCD_CanvasFlush(LCD_CANVAS *canvas) ;
+#endif /* LCD_USE_CANVAS != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Pixels per cell */
+#define LCD_CANVAS_CELL_WIDTH        (5u)
+#define LCD_CANVAS_CELL_HEIGHT       (LCD_GLYPH_ROWS)
+
+/* lastY before the first LCD_CanvasPush() sample */
+#define LCD_CANVAS_NO_SAMPLE         (0xFFu)
+
+#endif /* INC_LCD_CANVAS_H_ */
@@ -0,0 +1,871 @@
+/*
+ * LCD_Config.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Build-time configuration of the HD44780 LCD driver.
+ *
+ *  			Each feature of the driver is selected here, in the same way
+ *  			stm32f1xx_hal_conf.h selects HAL modules. Values are the
+ *  			equivalent of the PSoC Creator component customizer parameters.
+ */
+
+#ifndef INC_LCD_CONFIG_H_
+#define INC_LCD_CONFIG_H_
+
+/* LCD_CUSTOM_CHAR_SET values */
+#define LCD_NONE                     (0u)
+#define LCD_HORIZONTAL_BG            (1u)
+#define LCD_VERTICAL_BG              (2u)
+#define LCD_USER_DEFINED             (3u)
+
+/* LCD_CHARACTER_ROM values (HD44780U ROM code of the module) */
+#define LCD_ROM_A00                  (0u)      /* Japanese: katakana, Greek, yen sign at 0x5C */
+#define LCD_ROM_A02                  (1u)      /* European: ISO 8859-1 upper half */
+
+/* LCD_GEOMETRY values (LCD_Geometry.c descriptor table) */
+#define LCD_GEOMETRY_16X1            (0u)      /* "Type 1": columns 8-15 at DDRAM 0x40 */
+#define LCD_GEOMETRY_16X1_LINEAR     (1u)      /* Columns 0-15 at DDRAM 0x00 */
+#define LCD_GEOMETRY_16X2            (2u)
+#define LCD_GEOMETRY_16X4            (3u)
+#define LCD_GEOMETRY_20X2            (4u)
+#define LCD_GEOMETRY_20X4            (5u)
+#define LCD_GEOMETRY_40X2            (6u)
+#define LCD_GEOMETRY_COUNT           (7u)
+
+/* Rows of a CGRAM glyph (5x8 font) */
+#define LCD_GLYPH_ROWS               (8u)
+
+/***************************************
+*        Display Geometry
+***************************************/
+
+/* Number of character rows and columns of the attached module, the size of
+ * the framebuffer. Also the largest geometry LCD_SetGeometry() accepts.
+ */
+#define LCD_ROWS                     (2u)
+#define LCD_COLUMNS                  (40u)
+
+/* Layout every display starts with, LCD_GEOMETRY_ value. Positions, the
+ * print paths and the framebuffer flush address DDRAM through it: text
+ * wraps to the next row and is clipped after the last, no write goes to
+ * DDRAM off the glass. A 40x4 module is two 40x2 controllers (two E lines),
+ * one handle each with LCD_USE_MULTI_DISPLAY.
+ */
+#define LCD_GEOMETRY                 (LCD_GEOMETRY_40X2)
+
+/* Rows a descriptor can hold */
+#define LCD_GEOMETRY_MAX_ROWS        (4u)
+
+/***************************************
+*        Pin Assignment
+***************************************/
+
+/* 1 = RS and R/nW are on the data port (DB4_GPIO_Port), so data and control
+ *     lines change in a single BSRR store (LCD_USE_DMA_TRANSPORT needs it and
+ *     follows this setting)
+ */
+#define LCD_CTRL_ON_DATA_PORT        (1u)
+
+/* 1 = DB4-DB7, RS and R/nW on any bits of up to two ports (LCD_MAP_PORT0,
+ *     LCD_MAP_PORT1), each pin given as port index and bit below; LCD.c
+ *     drives them from per-port nibble tables (one BSRR store per port and
+ *     nibble, RS and R/nW included) and gathers status reads from both input
+ *     registers. E stays on the E line of the handle. 4-bit bus only; the
+ *     lockstep, DMA, keypad, detect and trace modules need the contiguous
+ *     DB4_GPIO_Port layout (LCD_USE_DMA_TRANSPORT follows this setting)
+ * 0 = DB4-DB7 on DB4_GPIO_Port bits LCD_STM32_NIBBLE_SHIFT and up
+ */
+#define LCD_USE_PIN_MAP              (0u)
+
+#define LCD_MAP_PORT0                GPIOC
+#define LCD_MAP_PORT1                GPIOB
+
+/* Port index (0u = LCD_MAP_PORT0, 1u = LCD_MAP_PORT1) and bit of each pin */
+#define LCD_MAP_DB4_PORT             (0u)
+#define LCD_MAP_DB4_BIT              (0u)
+#define LCD_MAP_DB5_PORT             (0u)
+#define LCD_MAP_DB5_BIT              (1u)
+#define LCD_MAP_DB6_PORT             (0u)
+#define LCD_MAP_DB6_BIT              (2u)
+#define LCD_MAP_DB7_PORT             (0u)
+#define LCD_MAP_DB7_BIT              (3u)
+#define LCD_MAP_RS_PORT              (0u)
+#define LCD_MAP_RS_BIT               (8u)
+#define LCD_MAP_RW_PORT              (0u)
+#define LCD_MAP_RW_BIT               (9u)
+
+/* 1 = R/nW is tied low on the board (write-only wiring): the busy flag is
+ *     never read, every write waits out the execution time of the previous
+ *     one (LCD_Timing.c, open-loop timed mode) and the data pins are never
+ *     made inputs; LCD_ReadStatus()/LCD_ReadData() return LCD_STATUS_NONE /
+ *     LCD_READ_NONE
+ * 0 = R/nW on RnW_Pin, busy flag polling
+ */
+#define LCD_GPIO_WRITE_ONLY          (0u)
+
+/* 1 = 8-bit bus, one E strobe and one busy read per byte; DB0-DB3 go to
+ *     LCD_DB0_PIN - LCD_DB3_PIN on the data port (contiguous, configured by
+ *     LCD_InitBegin, shift and mask in LCD.h)
+ * 0 = 4-bit bus on DB4-DB7
+ */
+#define LCD_BUS_8BIT                 (0u)
+
+#define LCD_DB0_PIN                  LL_GPIO_PIN_4
+#define LCD_DB1_PIN                  LL_GPIO_PIN_5
+#define LCD_DB2_PIN                  LL_GPIO_PIN_6
+#define LCD_DB3_PIN                  LL_GPIO_PIN_7
+
+/* 1 = several modules share DB4-DB7 (DB0-DB7), RS and R/nW, each one on its own
+ *     E line (LCD_Handle.c); while one controller executes a command the next
+ *     one can already be written
+ * 0 = single module on E_Pin, no per-write indirection
+ */
+#define LCD_USE_MULTI_DISPLAY        (0u)
+
+/* 1 = a second module on the same E, RS and R/nW, its DB4-DB7 on the
+ *     LCD_DB0_PIN - LCD_DB3_PIN port bits (4-bit bus only): every LCD_ write
+ *     reaches both, LCD_Lockstep.c writes a different byte to each in the
+ *     same strobe
+ * 0 = one module per E line
+ */
+#define LCD_USE_LOCKSTEP             (0u)
+
+/***************************************
+*        Bus Timing
+***************************************/
+
+/* Delay backend for the bus timing gaps */
+#define LCD_DELAY_TIM4               (0u)      /* delay_us() in main.c, owns TIM4 */
+#define LCD_DELAY_DWT                (1u)      /* DWT cycle counter, ns resolution */
+#define LCD_DELAY_CUSTOM             (2u)      /* application LCD_UserDelayNs() */
+
+#define LCD_DELAY_BACKEND            (LCD_DELAY_DWT)
+
+/* Bus timing profile, the tAS/PWEH/tDDR/tcycE set of the controller on the
+ * module at its supply voltage (values in LCD_Timing.h)
+ */
+#define LCD_PROFILE_HD44780_5V       (0u)      /* HD44780U, VCC 4.5-5.5 V */
+#define LCD_PROFILE_HD44780_3V       (1u)      /* HD44780U, VCC 2.7-4.5 V */
+#define LCD_PROFILE_KS0066           (2u)      /* Samsung KS0066U, 2.7-5.5 V */
+#define LCD_PROFILE_ST7066U          (3u)      /* Sitronix ST7066U, 4.5-5.5 V */
+#define LCD_PROFILE_CUSTOM           (4u)      /* LCD_CUSTOM_T_..._NS below */
+
+#define LCD_TIMING_PROFILE           (LCD_PROFILE_HD44780_5V)
+
+/* LCD_PROFILE_CUSTOM bus timing (ns), from the data sheet of the controller */
+#define LCD_CUSTOM_T_AS_NS           (60u)     /* RS, R/W setup to E rise */
+#define LCD_CUSTOM_T_PWEH_NS         (450u)    /* E high pulse width */
+#define LCD_CUSTOM_T_DDR_NS          (360u)    /* E rise to read data valid */
+#define LCD_CUSTOM_T_CYCE_NS         (1000u)   /* E cycle time */
+
+/* NVIC preemption priority the atomic phases of the transports mask down to
+ * (BASEPRI, LCD_Transport.h): interrupts at this priority and numerically
+ * above wait out a few register stores, more urgent ones (motor control) are
+ * never held off by the display. The LCD interrupts (LCD_..._IRQ_PRIORITY)
+ * must be at this level or below it. 0 = mask all interrupts (PRIMASK)
+ */
+#define LCD_BUS_MASK_PRIORITY        (5u)
+
+/* TIM4 tick of delay_us(), LCD_Async.c and LCD_Wfi.c. The prescaler is
+ * derived from the APB1 timer clock (delay_clock_update), rounded so the
+ * tick is never faster than this at any core clock. Whole MHz only, the
+ * waits are counted in ticks per microsecond
+ */
+#define LCD_TIM4_TICK_HZ             (4000000u)
+
+#if ((LCD_TIM4_TICK_HZ < 1000000u) || ((LCD_TIM4_TICK_HZ % 1000000u) != 0u))
+    #error "LCD_TIM4_TICK_HZ must be a whole number of MHz"
+#endif /* LCD_TIM4_TICK_HZ */
+
+/* 1 = LCD_IsReady() is skipped when the execution time of the previous
+ *     command (DWT timestamp) has already elapsed
+ */
+#define LCD_USE_ELAPSED_SKIP         (1u)
+
+/* 1 = the bus hot path (strobes, busy poll, DWT waits, DMA buffer fill) runs
+ *     from SRAM: .RamFunc in the linker script, copied with .data by the
+ *     startup code, so the strobe timing has no flash wait states
+ */
+#define LCD_USE_RAM_FUNCTIONS        (0u)
+
+/* LCD_Calibrate(): measurements per command and margin added to the worst one */
+#define LCD_CALIBRATE_SAMPLES        (4u)
+#define LCD_CALIBRATE_MARGIN_PCT     (25u)
+
+/***************************************
+*        Instrumentation
+***************************************/
+
+/* 1 = cycle and event counters on the hot paths (LCD_GetStats, LCD_Stats.c)
+ * 0 = instrumentation compiles to nothing
+ */
+#define LCD_USE_STATS                (0u)
+
+/* 1 = RS/RW/E/data pin transitions of the bus writers and LCD_IsReady() are
+ *     recorded with DWT timestamps (LCD_Trace.c, LCD_TraceDumpVcd)
+ */
+#define LCD_USE_TRACE                (0u)
+
+/* Trace ring entries, must be a power of two (RAM = 8 * LCD_TRACE_SIZE bytes) */
+#define LCD_TRACE_SIZE               (256u)
+
+/* 1 = sampling profiler on TIM2 (LCD_Profile.c): the interrupted address is
+ *     counted for the LCD driver, delay_us() or the rest, LCD_ProfileReport()
+ *     prints the shares (over ITM with LCD_ProfileItmPutChar)
+ * TIM2 also paces the DMA transport, LCD_USE_DMA_TRANSPORT follows this flag
+ */
+#define LCD_USE_PROFILER             (0u)
+
+/* Samples per second, no divisor of the 1 kHz SysTick */
+#define LCD_PROFILE_HZ               (10007u)
+
+/* NVIC preemption priority of the TIM2 interrupt, 0 samples every other one */
+#define LCD_PROFILE_IRQ_PRIORITY     (0u)
+
+/* 1 = boot markers (LCD_Boot.c): DWT timestamps from reset of each init stage
+ *     and of the first character on the glass, in LCD_boot for the debugger
+ *     and printed by LCD_BootReport() (over ITM with LCD_BootItmPutChar)
+ */
+#define LCD_USE_BOOT_MARKERS         (0u)
+
+/* 1 = update latency probes (LCD_Latency.c): the time from a framebuffer cell
+ *     changing to the end of the flush that sent it, as a histogram per
+ *     priority class next to LCD_GetStats (needs LCD_USE_STATS and
+ *     LCD_USE_FRAMEBUFFER, RAM = 5 bytes a cell + 4 * LCD_LATENCY_BUCKETS a class)
+ */
+#define LCD_USE_LATENCY              (0u)
+
+/* Priority classes of LCD_LatencySetClass(), LCD_LATENCY_ROUTINE and up */
+#define LCD_LATENCY_CLASSES          (2u)
+
+/***************************************
+*        Memory Arena
+***************************************/
+
+/* 1 = LCD_ArenaAlloc() (LCD_Arena.c) hands out buffers sized at run time
+ *     (display lists, application screens) from one static arena, each
+ *     owner within its own budget; no malloc, LCD_ArenaPeak() and the
+ *     stats report how close each owner came to its limit
+ */
+#define LCD_USE_ARENA                (0u)
+
+/* Budget of each owner in bytes, multiples of 4 (RAM = their sum) */
+#define LCD_ARENA_LIST_BYTES         (256u)
+#define LCD_ARENA_APP_BYTES          (256u)
+
+/***************************************
+*        Cursor Tracking
+***************************************/
+
+/* 1 = the driver mirrors the module's address counter and drops set-DDRAM-
+ *     address commands that would not move the cursor
+ */
+#define LCD_USE_CURSOR_TRACKING      (1u)
+
+/***************************************
+*        Custom Characters
+***************************************/
+
+/* Custom character set loaded by LCD_Init():
+ * LCD_NONE, or LCD_USER_DEFINED (application provides LCD_customFonts[])
+ */
+#define LCD_CUSTOM_CHAR_SET          (LCD_NONE)
+
+/* 1 = CGRAM glyph manager (LCD_Glyph.c), glyphs printed by ID are mapped
+ *     onto the 8 CGRAM slots with LRU eviction
+ */
+#define LCD_USE_GLYPH_CACHE          (1u)
+
+/* 1 = queued glyph replacement (LCD_GlyphReplace(), LCD_GlyphPoll()): the
+ *     upload waits for a poll with the bus idle and goes into a spare slot
+ *     when one is free, then the framebuffer cells switch over, so a glyph
+ *     on screen is never seen half written (needs LCD_USE_GLYPH_CACHE)
+ */
+#define LCD_USE_GLYPH_QUEUE          (0u)
+
+/* Replacements waiting for LCD_GlyphPoll() */
+#define LCD_GLYPH_QUEUE_SIZE         (4u)
+
+/* 1 = packed glyph packs in flash (LCD_GLYPH_PACK, LCD_GlyphAcquirePacked()):
+ *     8 codes of 1 - 5 bits per glyph into a shared row dictionary, 1 - 5
+ *     bytes a glyph instead of 8, unpacked into the CGRAM upload of the glyph
+ *     manager (needs LCD_USE_GLYPH_CACHE)
+ */
+#define LCD_USE_GLYPH_PACKS          (0u)
+
+/* 1 = LCD_PrintUtf8() (LCD_Utf8.c) maps code points onto LCD_CHARACTER_ROM,
+ *     a few missing ones onto CGRAM glyphs through the glyph manager
+ */
+#define LCD_USE_UTF8                 (0u)
+
+/* Character ROM of the module: LCD_ROM_A00 or LCD_ROM_A02 */
+#define LCD_CHARACTER_ROM            (LCD_ROM_A00)
+
+/* Bargraphs whose last value is remembered for incremental redraws */
+#define LCD_BAR_TRACKED              (4u)
+
+/* 1 = CGRAM animations (LCD_Anim.c): a pinned slot steps through frames by
+ *     rewriting its 8 bitmap bytes, every cell showing it animates at once
+ */
+#define LCD_USE_ANIMATION            (0u)
+
+/* Animations running at the same time (each pins one CGRAM slot) */
+#define LCD_ANIM_MAX                 (4u)
+
+/* 1 = two-row numerals (LCD_Big.c), three CGRAM segment glyphs pinned */
+#define LCD_USE_BIG_DIGITS           (0u)
+
+/* Big numbers whose shown digits are remembered for per-numeral redraws */
+#define LCD_BIG_TRACKED              (2u)
+
+/* 1 = pixel canvases (LCD_Canvas.c): a bitmap over pinned CGRAM slots with
+ *     pixel, line and column primitives and sparklines; a flush uploads only
+ *     the glyph rows that changed (needs LCD_USE_GLYPH_CACHE)
+ */
+#define LCD_USE_CANVAS               (0u)
+
+/* CGRAM cells of one canvas, 8 = 40x8 or 20x16 pixels */
+#define LCD_CANVAS_MAX_CELLS         (8u)
+
+/***************************************
+*        Screen Fields
+***************************************/
+
+/* 1 = field tables of labels and values (LCD_Field.c), a field is only
+ *     written when its formatted text changes
+ */
+#define LCD_USE_FIELDS               (0u)
+
+/* Widest value field (bytes of the per-field cache) */
+#define LCD_FIELD_WIDTH_MAX          (16u)
+
+/* 1 = table-driven menus (LCD_Menu.c): items, submenus and value editors
+ *     painted into the framebuffer, a key press changes only the marker or
+ *     value cells it affects (needs LCD_USE_FRAMEBUFFER)
+ */
+#define LCD_USE_MENU                 (0u)
+
+/* Submenu nesting, including the top level menu */
+#define LCD_MENU_DEPTH               (4u)
+
+/* Value cells at the right edge of a value item */
+#define LCD_MENU_VALUE_WIDTH         (6u)
+
+/* 1 = constant screens (LCD_Blob.c), segment tables in flash with the DDRAM
+ *     addresses resolved for LCD_GEOMETRY at compile time
+ */
+#define LCD_USE_BLOB                 (1u)
+
+/* 1 = display lists (LCD_List.c), screens recorded once as bytecode (or
+ *     kept as const tables in flash) and replayed with their numbers and
+ *     strings taken from a parameter array
+ */
+#define LCD_USE_DISPLAY_LIST         (0u)
+
+/***************************************
+*        Marquee
+***************************************/
+
+/* 1 = hardware display-shift ticker (LCD_Marquee.c) */
+#define LCD_USE_MARQUEE              (1u)
+
+/* Blanks between the end of a long message and its repeat */
+#define LCD_MARQUEE_GAP              (4u)
+
+/***************************************
+*        Framebuffer
+***************************************/
+
+/* 1 = print APIs write into a RAM shadow of DDRAM and LCD_FlushFrame() sends
+ *     only the cells that changed
+ * 0 = print APIs write straight to the display
+ */
+#define LCD_USE_FRAMEBUFFER          (1u)
+
+/* 1 = the last flushed frame is kept with a checksum in .noinit RAM and
+ *     drawn again when the initialization completes after a watchdog or
+ *     brown-out reset (needs LCD_USE_FRAMEBUFFER)
+ */
+#define LCD_USE_FRAME_SNAPSHOT       (0u)
+
+/* 1 = LCD_PageFlip() (LCD_Page.c) flushes into a second screen in the
+ *     hidden half of DDRAM and shows it with display shifts, 16x2 and 20x2
+ *     geometries (needs LCD_USE_FRAMEBUFFER)
+ */
+#define LCD_USE_PAGE_FLIP            (0u)
+
+/* 1 = LCD_RefreshTask() (LCD_Refresh.c) flushes the framebuffer at most
+ *     LCD_REFRESH_HZ times a second, writes in between are coalesced
+ */
+#define LCD_USE_REFRESH              (0u)
+
+/* Flush rate cap; the liquid crystal itself takes tens of ms to respond */
+#define LCD_REFRESH_HZ               (25u)
+
+/* 1 = LCD_Poll(budgetUs) (LCD_Poll.c) sends changed cells from the main loop
+ *     without a timer interrupt, as many as fit in a time budget per call
+ */
+#define LCD_USE_POLL                 (0u)
+
+/* Starting estimate of the bus time of one write; LCD_Poll() raises it to
+ * the longest write it measured
+ */
+#define LCD_POLL_WRITE_US            (4u)
+
+/* 1 = LCD_EstimateCost()/LCD_EstimatePendingFlush() (LCD_Cost.c) predict the
+ *     time and bus transactions of an update from the timing profile, the
+ *     transport and the changed framebuffer cells
+ */
+#define LCD_USE_COST_MODEL           (0u)
+
+/* 1 = LCD_FlushFrame() follows the flush planner (LCD_Plan.c): unchanged
+ *     gaps cheaper to rewrite than an address command are sent again, and
+ *     the rows are walked in DDRAM address order (needs LCD_USE_COST_MODEL)
+ */
+#define LCD_USE_FLUSH_PLANNER        (0u)
+
+/* Time of starting another bulk write on top of its address command (call,
+ * DMA set-up), counted against rewriting a gap
+ */
+#define LCD_PLAN_RUN_US              (3u)
+
+/* 1 = blinking and highlighted (inverse) fields in the framebuffer
+ *     (LCD_Attr.c); blink phases are advanced by LCD_RefreshTask(), the
+ *     inverse glyphs come from the CGRAM glyph cache (needs
+ *     LCD_USE_FRAMEBUFFER and LCD_USE_GLYPH_CACHE)
+ */
+#define LCD_USE_ATTRIBUTES           (0u)
+
+/* Time a blinking field is shown, and then hidden */
+#define LCD_ATTR_BLINK_MS            (500u)
+
+/* 1 = virtual windows (LCD_Window.c): rectangles with their own cursor,
+ *     clipping, z-order and cell buffer, composited into the framebuffer
+ *     (needs LCD_USE_FRAMEBUFFER)
+ */
+#define LCD_USE_WINDOWS              (0u)
+
+/* Windows open at the same time */
+#define LCD_WINDOWS_MAX              (4u)
+
+/***************************************
+*        Standard Output
+***************************************/
+
+/* 1 = _write() in syscalls.c sends stdout/stderr (printf) into the framebuffer
+ *     (LCD_Stdout.c); needs LCD_USE_FRAMEBUFFER
+ */
+#define LCD_USE_STDOUT               (1u)
+
+/* 1 = LCD_FlushFrame() at the end of every _write() call (newlib calls it
+ *     once per line, or per buffer with setvbuf)
+ * 0 = the application flushes
+ */
+#define LCD_STDOUT_AUTO_FLUSH        (1u)
+
+/* 1 = text past the last column continues on the next row */
+#define LCD_STDOUT_WRAP              (1u)
+
+/* 1 = VT100/ANSI escape sequences: cursor position and moves, erase in
+ *     line/display, save/restore cursor (others are skipped)
+ */
+#define LCD_STDOUT_ANSI              (1u)
+
+/***************************************
+*        Log Console
+***************************************/
+
+/* LCD_CONSOLE_POLICY values, what a new line does to a full ring */
+#define LCD_CONSOLE_OVERWRITE        (0u)      /* replaces the oldest line */
+#define LCD_CONSOLE_DROP             (1u)      /* is dropped while every line is undrawn */
+
+/* 1 = rolling event log (LCD_Console.c): producers store lines in a RAM
+ *     ring, LCD_ConsoleUpdate() draws the newest ones through the
+ *     framebuffer; needs LCD_USE_FRAMEBUFFER
+ */
+#define LCD_USE_CONSOLE              (0u)
+
+/* Lines kept for back-scroll, a power of two of at least LCD_ROWS
+ * (RAM = LCD_CONSOLE_LINES * LCD_COLUMNS bytes)
+ */
+#define LCD_CONSOLE_LINES            (16u)
+
+#define LCD_CONSOLE_POLICY           (LCD_CONSOLE_OVERWRITE)
+
+/***************************************
+*        DMA Transport
+***************************************/
+
+/* 1 = LCD_DmaWrite()/LCD_DmaFlushFrame() stream pre-encoded BSRR words to the
+ *     data port through DMA1 Channel 2, paced by TIM2 update events
+ * The stream needs the parallel bus in the contiguous DB4_GPIO_Port layout
+ * with the control lines on the same port, and TIM2 free of LCD_USE_PROFILER:
+ * on by default, off with LCD_USE_PIN_MAP, LCD_CTRL_ON_DATA_PORT 0,
+ * LCD_TRANSPORT_I2C/SPI or LCD_USE_PROFILER
+ */
+#define LCD_USE_DMA_TRANSPORT        (((LCD_USE_PIN_MAP == 0u) && (LCD_CTRL_ON_DATA_PORT != 0u) && \
+                                       (LCD_USE_PROFILER == 0u) && \
+                                       ((LCD_TRANSPORT == LCD_TRANSPORT_GPIO) || \
+                                        (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME))) ? 1u : 0u)
+
+/* Duration of one BSRR word (timer step), must cover PWEH = 230 ns */
+#define LCD_DMA_STEP_NS              (1000u)
+
+/* Words per half of the ping-pong buffer (RAM = 8 * LCD_DMA_HALF_WORDS bytes) */
+#define LCD_DMA_HALF_WORDS           (64u)
+
+/* NVIC preemption priority of the DMA1 Channel 2 interrupt */
+#define LCD_DMA_IRQ_PRIORITY         (5u)
+
+/***************************************
+*        Bus Transport
+***************************************/
+
+/* Wirings LCD.c can drive (LCD_Transport.h) */
+#define LCD_TRANSPORT_GPIO           (0u)      /* parallel bus, GPIOC */
+#define LCD_TRANSPORT_I2C            (1u)      /* PCF8574 backpack, LCD_USE_I2C_TRANSPORT */
+#define LCD_TRANSPORT_SPI            (2u)      /* 74HC595, LCD_USE_SPI_TRANSPORT */
+#define LCD_TRANSPORT_RUNTIME        (3u)      /* per display, LCD_SetTransport() */
+
+/* Transport of the build. With one backend its functions are called
+ * directly; LCD_TRANSPORT_RUNTIME calls through the table of each display
+ * handle (GPIO unless set), so displays on different wirings share one build.
+ * LCD_USE_DMA_TRANSPORT and LCD_USE_ASYNC are off for LCD_TRANSPORT_I2C/SPI
+ */
+#define LCD_TRANSPORT                (LCD_TRANSPORT_GPIO)
+
+/***************************************
+*        I2C Transport
+***************************************/
+
+/* 1 = build the PCF8574 I2C backpack backend (LCD_I2c.c), selected with
+ *     LCD_TRANSPORT: LCD_WriteData()/LCD_WriteControl() encode expander
+ *     states that DMA1 Channel 6 sends to I2C1 (PB6/PB7) in batched
+ *     transactions, instead of driving GPIOC
+ */
+#define LCD_USE_I2C_TRANSPORT        (0u)
+
+/* 7-bit slave address, 0x20-0x27 (PCF8574) or 0x38-0x3F (PCF8574A) */
+#define LCD_I2C_ADDRESS              (0x27u)
+
+/* SCL rate; the PCF8574 is specified for 100 kHz, most backpacks run 400 kHz */
+#define LCD_I2C_CLOCK_HZ             (100000u)
+
+/* Expander states per buffer, two buffers (4 per byte plus execution padding) */
+#define LCD_I2C_BUFFER_SIZE          (256u)
+
+/* NVIC preemption priority of the I2C1 event and error interrupts */
+#define LCD_I2C_IRQ_PRIORITY         (5u)
+
+/***************************************
+*        SPI Shift-Register Transport
+***************************************/
+
+/* 1 = build the 74HC595 backend (LCD_Spi.c), selected with LCD_TRANSPORT:
+ *     LCD_WriteData()/LCD_WriteControl() queue bytes that are streamed as
+ *     shift-register states by DMA1 Channel 5 to SPI1 (PA5 SCK, PA7 MOSI),
+ *     paced by TIM1, with the latch on TIM1 CH1 (PA8)
+ */
+#define LCD_USE_SPI_TRANSPORT        (0u)
+
+/* SPI1 baud rate control, SCK = PCLK2 / 2^(BR + 1): 2 = 9 MHz at 72 MHz */
+#define LCD_SPI_BAUD_BR              (2u)
+
+/* Duration of one latched state (TIM1 step), must cover 8 SCK periods */
+#define LCD_SPI_STEP_NS              (2000u)
+
+/* Queued bytes, must be a power of two */
+#define LCD_SPI_QUEUE_SIZE           (64u)
+
+/* States per half of the ping-pong buffer (RAM = 2 * LCD_SPI_HALF_STATES bytes) */
+#define LCD_SPI_HALF_STATES          (64u)
+
+/* NVIC preemption priority of the DMA1 Channel 5 interrupt */
+#define LCD_SPI_IRQ_PRIORITY         (5u)
+
+/***************************************
+*        UART Remote Display
+***************************************/
+
+/* 1 = a host drives the framebuffer over a UART (LCD_Remote.c): frames are
+ *     received by circular DMA and parsed in place by LCD_RemotePoll()
+ */
+#define LCD_USE_REMOTE               (0u)
+
+/* 2 = USART2, RX on PA3, DMA1 Channel 6
+ * 1 = USART1, RX on PA10, DMA1 Channel 5
+ * 0 = no UART, frames only come through LCD_RemoteFeed() (e.g. USB CDC)
+ */
+#define LCD_REMOTE_USART             (2u)
+
+#define LCD_REMOTE_BAUD              (115200u)
+
+/* Receive ring, a power of two; a frame may use at most half of it (also
+ * the size of the LCD_RemoteFeed() carry buffer), and
+ * LCD_RemotePoll() has to run before the DMA laps it (256 bytes = 22 ms at
+ * 115200 baud)
+ */
+#define LCD_REMOTE_RX_SIZE           (256u)
+
+/* NVIC preemption priority of the USART (idle line) interrupt */
+#define LCD_REMOTE_IRQ_PRIORITY      (7u)
+
+/* 1 = the frames also come over USB (LCD_Usb.c): a CDC ACM virtual COM port
+ *     on the USB full-speed device, D- PA11 / D+ PA12; needs LCD_USE_REMOTE,
+ *     a 72 or 48 MHz PLL system clock and LCD_USE_CAN 0 (shared packet memory)
+ */
+#define LCD_USE_USB_CDC              (0u)
+
+/* GPIO that switches the 1.5 kOhm D+ pull-up, from the board schematic;
+ * 0 = the pull-up is fixed (or external), nothing to switch
+ */
+#define LCD_USB_PULLUP_PORT          GPIOC
+#define LCD_USB_PULLUP_PIN           (0u)
+
+/* 1 = the pull-up connects with the pin low (PNP switch), 0 = with it high */
+#define LCD_USB_PULLUP_ACTIVE_LOW    (1u)
+
+/* NVIC preemption priority of the USB low priority interrupt (USB_LP_CAN1_RX0) */
+#define LCD_USB_IRQ_PRIORITY         (7u)
+
+/***************************************
+*        CAN Display Node
+***************************************/
+
+/* 1 = the display is a CAN node (LCD_Can.c): a table maps standard
+ *     identifiers to framebuffer fields, the bxCAN acceptance filters pass
+ *     only those identifiers and the FIFO 0 interrupt draws the fields
+ */
+#define LCD_USE_CAN                  (0u)
+
+/* 0 = CAN_RX on PA11, CAN_TX on PA12
+ * 1 = CAN_RX on PB8, CAN_TX on PB9 (remapped)
+ */
+#define LCD_CAN_PINS                 (0u)
+
+#define LCD_CAN_BITRATE              (250000u)
+
+/* 1 = listen only: the node never drives the bus (no acknowledge), for a
+ *     bus where other nodes already acknowledge every frame
+ */
+#define LCD_CAN_SILENT               (0u)
+
+/* Longest field table LCD_CanStart() takes */
+#define LCD_CAN_FIELDS_MAX           (32u)
+
+/* NVIC preemption priority of the FIFO 0 interrupt (USB_LP_CAN1_RX0) */
+#define LCD_CAN_IRQ_PRIORITY         (6u)
+
+/***************************************
+*        Interrupt-Driven Write Queue
+***************************************/
+
+/* 1 = LCD_WriteAsync() queue, TIM4 compare channel 1 interrupt runs the bus
+ * The interrupt drives the parallel bus pins: on by default, off with
+ * LCD_TRANSPORT_I2C/SPI
+ */
+#define LCD_USE_ASYNC                (((LCD_TRANSPORT == LCD_TRANSPORT_GPIO) || \
+                                       (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)) ? 1u : 0u)
+
+/* Queue entries, must be a power of two */
+#define LCD_ASYNC_QUEUE_SIZE         (128u)
+
+/* 1 = second, urgent queue (LCD_WriteAsyncUrgent()): its runs go out ahead of
+ *     the items already queued, as soon as the normal queue reaches the start
+ *     of its next run (an address, clear or home command)
+ */
+#define LCD_USE_ASYNC_URGENT         (0u)
+
+/* Urgent queue entries, must be a power of two */
+#define LCD_ASYNC_URGENT_SIZE        (32u)
+
+/* NVIC preemption priority of the TIM4 interrupt */
+#define LCD_ASYNC_IRQ_PRIORITY       (6u)
+
+/***************************************
+*        Power Management
+***************************************/
+
+/* 1 = the application switches the module supply off between LCD_Sleep()
+ *     and LCD_Wakeup(): the bus is driven low while asleep and LCD_Wakeup()
+ *     runs the interface handshake and restores modes, CGRAM and (with
+ *     LCD_USE_FRAMEBUFFER) the characters
+ * 0 = supply stays on, LCD_Sleep() only switches the display off
+ */
+#define LCD_PM_POWER_GATED           (0u)
+
+/* Controller power-on reset after the supply returned (datasheet: 15 ms at
+ * 4.5 V, 40 ms at 2.7 V)
+ */
+#define LCD_PM_POWER_ON_MS           (15u)
+
+/***************************************
+*        Backlight
+***************************************/
+
+/* 1 = Light_LCD (PB0) driven by TIM3 channel 3 PWM (LCD_Backlight.c),
+ *     LCD_SetBacklight()/LCD_FadeBacklight(), fades stepped by the HAL tick
+ * 0 = Light_LCD stays a GPIO output (on/off)
+ */
+#define LCD_USE_BACKLIGHT_PWM        (0u)
+
+/* PWM frequency, above the audible range of the LED driver */
+#define LCD_BACKLIGHT_PWM_HZ         (20000u)
+
+/* Inactivity before auto-dim, 0 = no auto-dim */
+#define LCD_BACKLIGHT_AUTODIM_MS     (30000u)
+
+/* Level and fade time of auto-dim, and of the return on activity */
+#define LCD_BACKLIGHT_DIM_LEVEL      (16u)
+#define LCD_BACKLIGHT_DIM_FADE_MS    (1000u)
+#define LCD_BACKLIGHT_WAKE_MS        (150u)
+
+/* 1 = every write to the display counts as activity
+ * 0 = only LCD_BacklightActivity() (e.g. displays updated continuously)
+ */
+#define LCD_BACKLIGHT_DIM_ON_WRITES  (0u)
+
+/***************************************
+*        Keypad On The Data Lines
+***************************************/
+
+/* 1 = 4x4 keypad with its columns on DB4-DB7 (LCD_Keypad.c), scanned from
+ *     the HAL tick between display strobes, debounced events in a queue
+ */
+#define LCD_USE_KEYPAD               (0u)
+
+/* Row lines, open-drain outputs driven low one at a time */
+#define LCD_KEYPAD_ROW_PORT          GPIOB
+#define LCD_KEYPAD_ROW0_PIN          LL_GPIO_PIN_12
+#define LCD_KEYPAD_ROW1_PIN          LL_GPIO_PIN_13
+#define LCD_KEYPAD_ROW2_PIN          LL_GPIO_PIN_14
+#define LCD_KEYPAD_ROW3_PIN          LL_GPIO_PIN_15
+
+/* Scan period, and scans a new key state has to hold (20 ms debounce) */
+#define LCD_KEYPAD_SCAN_MS           (5u)
+#define LCD_KEYPAD_DEBOUNCE          (4u)
+
+/* Column settling after a row goes low (pull-up, keypad and module pins) */
+#define LCD_KEYPAD_SETTLE_NS         (2000u)
+
+/* Event queue entries, must be a power of two */
+#define LCD_KEYPAD_QUEUE_SIZE        (16u)
+
+/***************************************
+*        Low-Power Waits
+***************************************/
+
+/* 1 = waits of at least LCD_WFI_MIN_US sleep in __WFI() until TIM4 compare
+ *     channel 2 fires (LCD_Wfi.c), 0 = every wait spins
+ */
+#define LCD_USE_WFI                  (0u)
+
+/* Shortest wait worth a sleep; shorter ones are spun */
+#define LCD_WFI_MIN_US               (100u)
+
+/* Wake-up ahead of the deadline (interrupt entry/exit), spun on DWT */
+#define LCD_WFI_WAKE_US              (4u)
+
+/* NVIC preemption priority of the TIM4 interrupt when LCD_Async.c does not set it */
+#define LCD_WFI_IRQ_PRIORITY         (6u)
+
+/***************************************
+*        RTOS Service
+***************************************/
+
+/* 1 = CMSIS-RTOS2 display service (LCD_Rtos.c): one task owns the bus and
+ *     runs the requests client tasks queue without blocking; its waits of
+ *     LCD_WFI_MIN_US or more block on a thread flag from the TIM4 compare
+ *     interrupt of LCD_Wfi.c, so the other tasks get the core (needs
+ *     LCD_USE_WFI and LCD_DELAY_DWT)
+ */
+#define LCD_USE_RTOS                 (0u)
+
+/* Requests the queue holds */
+#define LCD_RTOS_QUEUE_SIZE          (8u)
+
+/* Longest text of one LCD_RtosPrintAt() request, longer text is cut */
+#define LCD_RTOS_TEXT_MAX            (20u)
+
+/* Stack of the service task, bytes */
+#define LCD_RTOS_STACK_BYTES         (512u)
+
+/* osPriority_t of the service task (16 = osPriorityBelowNormal) */
+#define LCD_RTOS_PRIORITY            (16u)
+
+/***************************************
+*        Multi-Producer Command Ring
+***************************************/
+
+/* 1 = lock-free LCD_RingPush()/LCD_RingPrintAt() (LCD_Ring.c), callable from
+ *     any interrupt or task, drained by one consumer
+ */
+#define LCD_USE_RING                 (1u)
+
+/* Ring entries, must be a power of two (RAM = 8 * LCD_RING_SIZE bytes) */
+#define LCD_RING_SIZE                (64u)
+
+/***************************************
+*        Link Recovery
+***************************************/
+
+/* 1 = a display that timed out and answers again is re-initialized and its
+ *     mirrored state replayed by LCD_RecoverPoll() (LCD_Recover.c),
+ * 0 = writes just resume, the cursor and framebuffer are marked unknown
+ */
+#define LCD_USE_LINK_RECOVERY        (0u)
+
+/* Interval of the re-initialization attempts while the display stays silent */
+#define LCD_RECOVER_RETRY_MS         (250u)
+
+/***************************************
+*        Read-Back Scrubber
+***************************************/
+
+/* 1 = LCD_ScrubPoll() reads DDRAM and CGRAM back a few bytes per call
+ *     (LCD_Scrub.c), rewrites the bytes that differ from what was sent and
+ *     re-initializes a module whose repairs do not stick (needs
+ *     LCD_USE_LINK_RECOVERY)
+ */
+#define LCD_USE_SCRUB                (0u)
+
+/* Bytes read back per call, each one data read of one execution time */
+#define LCD_SCRUB_CELLS              (4u)
+
+/* Repairs of one window that may fail before re-initialization */
+#define LCD_SCRUB_RETRIES            (2u)
+
+/***************************************
+*        Presence And Geometry Detection
+***************************************/
+
+/* 1 = LCD_InitPoll() first checks that a controller drives the data lines
+ *     (LCD_Detect.c), skips the init of a unit without one and latches it
+ *     absent, and reads DDRAM back after the init to pick the geometry
+ */
+#define LCD_USE_DETECT               (0u)
+
+/* Time a controller gets after MCU reset to answer the bus probe, ms
+ * (HD44780 internal reset, VCC above 4.5 V)
+ */
+#define LCD_DETECT_POWER_MS          (15u)
+
+/* Geometry of a controller that only keeps DDRAM line 0 */
+#define LCD_DETECT_GEOMETRY_1LINE    (LCD_GEOMETRY_16X1_LINEAR)
+
+/***************************************
+*        Warm Start
+***************************************/
+
+/* 1 = LCD_InitPoll() first reads back a signature left in CGRAM (LCD_Warm.c)
+ *     and, on a module still configured from before an MCU-only reset,
+ *     skips the power-on wait and the 8-bit/4-bit handshake
+ */
+#define LCD_USE_WARM_START           (0u)
+
+/* CGRAM slot whose unshown bits 7-5 hold the signature, its glyph is kept */
+#define LCD_WARM_SLOT                (7u)
+
+#endif /* INC_LCD_CONFIG_H_ */
@@ -0,0 +1,26 @@
+/*
+ * LCD_Console.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_CONSOLE_H_
+#define INC_LCD_CONSOLE_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_CONSOLE != 0u)
+    uint8_t LCD_ConsolePrint(char const text[]) ;
+    uint8_t LCD_ConsoleUpdate(void) ;
+    void LCD_ConsolePageUp(void) ;
+    void LCD_ConsolePageDown(void) ;
+    void LCD_ConsoleClear(void) ;
+    uint32_t LCD_ConsoleDropped(void) ;
+#endif /* LCD_USE_CONSOLE != 0u */
+
+#endif /* INC_LCD_CONSOLE_H_ */
@@ -0,0 +1,49 @@
+/*
+ * LCD_Cost.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_COST_H_
+#define INC_LCD_COST_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Predicted cost of an operation: time until the display accepts the next
+* write, and the command/data bytes sent
+*/
+typedef struct
+{
+    uint32_t us;
+    uint16_t transactions;
+} LCD_COST;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_COST_MODEL != 0u)
+    LCD_COST LCD_EstimateCost(uint8_t op, uint16_t count) ;
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        LCD_COST LCD_EstimatePendingFlush(void) ;
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+#endif /* LCD_USE_COST_MODEL != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* LCD_EstimateCost() operations */
+#define LCD_OP_COMMAND               (0u)      /* count commands (entry mode, display control) */
+#define LCD_OP_LONG_COMMAND          (1u)      /* count clear display / return home */
+#define LCD_OP_POSITION              (2u)      /* count LCD_Position() calls */
+#define LCD_OP_PRINT                 (3u)      /* count characters at the cursor */
+#define LCD_OP_PRINT_AT              (4u)      /* LCD_Position() and count characters */
+#define LCD_OP_FLUSH                 (5u)      /* LCD_EstimatePendingFlush(), count unused */
+
+#endif /* INC_LCD_COST_H_ */
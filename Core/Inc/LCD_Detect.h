@@ -0,0 +1,37 @@
+/*
+ * LCD_Detect.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_DETECT_H_
+#define INC_LCD_DETECT_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_DETECT != 0u)
+    uint8_t LCD_DetectBus(void) ;
+    uint8_t LCD_DetectGeometry(void) ;
+#endif /* LCD_USE_DETECT != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Status reads of one bus probe: two cover the AC6-AC4 nibble in any phase */
+#define LCD_DETECT_STROBES           (2u)
+
+/* Distinct patterns written to each probed DDRAM line, then read back */
+#define LCD_DETECT_PATTERN_A         (0x55u)
+#define LCD_DETECT_PATTERN_B         (0xAAu)
+#define LCD_DETECT_LINE1             (0x40u)
+
+/* LCD_DetectGeometry() result when the transport cannot read the module */
+#define LCD_DETECT_UNREAD            (0xFFu)
+
+#endif /* INC_LCD_DETECT_H_ */
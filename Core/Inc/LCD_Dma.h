@@ -0,0 +1,56 @@
+/*
+ * LCD_Dma.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_DMA_H_
+#define INC_LCD_DMA_H_
+
+#include "LCD_Config.h"
+#include "LCD_Blob.h"
+
+/* Called from the DMA interrupt when the last byte of a stream went out */
+typedef void (*LCD_DmaCallback)(void);
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+uint8_t LCD_DmaStart(void) ;
+uint8_t LCD_DmaWrite(uint16_t const items[], uint16_t count, LCD_DmaCallback callback) ;
+uint8_t LCD_DmaFlushFrame(LCD_DmaCallback callback) ;
+#if (LCD_USE_BLOB != 0u)
+    uint8_t LCD_DmaPlayBlob(LCD_BLOB const *blob, LCD_DmaCallback callback) ;
+#endif /* LCD_USE_BLOB != 0u */
+uint8_t LCD_DmaIsBusy(void) ;
+void LCD_DmaIRQHandler(void) ;
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Stream item encoding, see LCD_ITEM_DATA()/LCD_ITEM_CMD() in LCD.h */
+#define LCD_DMA_RS                   (LCD_ITEM_RS)
+#define LCD_DMA_DATA(dByte)          LCD_ITEM_DATA(dByte)
+#define LCD_DMA_CMD(cByte)           LCD_ITEM_CMD(cByte)
+
+/* BSRR words (timer steps) per byte before the execution-time padding:
+ * high nibble + RS, E high, E low, low nibble, E high, E low
+ * (8-bit bus: byte + RS, E high, E low)
+ */
+#if (LCD_BUS_8BIT != 0u)
+    #define LCD_DMA_WORDS_PER_BYTE   (3u)
+#else
+    #define LCD_DMA_WORDS_PER_BYTE   (6u)
+#endif /* LCD_BUS_8BIT != 0u */
+
+/* Worst case items for a flush: every run costs one address command, and a
+ * row never holds more runs than unchanged cells plus one, plus one more
+ * where a split row (LCD_GEOMETRY_16X1) starts its second DDRAM run
+ */
+#define LCD_DMA_ROW_ITEMS(columns)   ((columns) + 2u)
+#define LCD_DMA_FRAME_ITEMS          (LCD_ROWS * LCD_DMA_ROW_ITEMS(LCD_COLUMNS))
+
+#endif /* INC_LCD_DMA_H_ */
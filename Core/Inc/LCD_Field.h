@@ -0,0 +1,66 @@
+/*
+ * LCD_Field.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_FIELD_H_
+#define INC_LCD_FIELD_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Field formats */
+#define LCD_FIELD_LABEL              (0u)      /* char const[], drawn once */
+#define LCD_FIELD_TEXT               (1u)      /* char const[], left-justified, blank padded */
+#define LCD_FIELD_U32                (2u)      /* uint32_t, right-justified, blank padded */
+#define LCD_FIELD_U32_ZERO           (3u)      /* uint32_t, right-justified, zero padded */
+#define LCD_FIELD_S32                (4u)      /* int32_t, right-justified */
+#define LCD_FIELD_SCALED             (5u)      /* int32_t / 10^decimals, right-justified */
+
+/* Shown in every cell of a number wider than its field */
+#define LCD_FIELD_OVERFLOW           ('*')
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* One field of a screen layout, in an application table (LCD_FieldSetTable) */
+typedef struct
+{
+    void const *source;             /* Value read on each update; NULL = set by LCD_FieldSet() */
+    uint32_t value;                 /* LCD_FieldSet() value */
+    uint8_t row;
+    uint8_t column;
+    uint8_t width;                  /* Cells, at most LCD_FIELD_WIDTH_MAX (labels: unused) */
+    uint8_t format;                 /* LCD_FIELD_... */
+    uint8_t decimals;               /* LCD_FIELD_SCALED fraction digits */
+    uint8_t drawn;                  /* 0 until the cells below are on the display */
+    char shown[LCD_FIELD_WIDTH_MAX];
+} LCD_FIELD;
+
+/* Table entries */
+#define LCD_FIELD_INIT(row, column, width, format, decimals, source) \
+    { (source), 0u, (row), (column), (width), (format), (decimals), 0u, { 0 } }
+
+#define LCD_FIELD_LABEL_AT(row, column, text) \
+    LCD_FIELD_INIT((row), (column), 0u, LCD_FIELD_LABEL, 0u, (text))
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_FIELDS != 0u)
+    void LCD_FieldSetTable(LCD_FIELD table[], uint8_t count) ;
+    void LCD_FieldSet(uint8_t index, uint32_t value) ;
+    void LCD_FieldSetText(uint8_t index, char const text[]) ;
+    uint8_t LCD_FieldUpdate(void) ;
+    uint8_t LCD_UpdateNumber(uint8_t index, uint32_t value) ;
+    void LCD_FieldInvalidate(void) ;
+#endif /* LCD_USE_FIELDS != 0u */
+
+#endif /* INC_LCD_FIELD_H_ */
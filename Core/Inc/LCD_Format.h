@@ -0,0 +1,63 @@
+/*
+ * LCD_Format.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_FORMAT_H_
+#define INC_LCD_FORMAT_H_
+
+#include "LCD_Config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+uint8_t LCD_FormatU32(char digits[], uint32_t value) ;
+uint8_t LCD_FormatScaled(char text[], int32_t value, uint8_t decimals) ;
+uint8_t LCD_FormatFloat(char text[], float value, uint8_t decimals) ;
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Decimal digits of the largest uint32 (4294967295) */
+#define LCD_U32_DIGITS               (10u)
+
+/* Most fraction digits of LCD_PrintFixed()/LCD_PrintFloat() (10^9 < 2^32) */
+#define LCD_DECIMALS_MAX             (9u)
+
+/* Sign, integer digits, point and fraction digits */
+#define LCD_NUMBER_TEXT_MAX          (1u + LCD_U32_DIGITS + 1u + LCD_DECIMALS_MAX)
+
+/* Most fraction bits of a LCD_PrintFixed() value */
+#define LCD_FRAC_BITS_MAX            (31u)
+
+/* Printed by LCD_PrintFloat() for values that do not fit in uint32 */
+#define LCD_FLOAT_NAN_TEXT           "nan"
+#define LCD_FLOAT_OVF_TEXT           "ovf"
+
+/* Widest right-justified field, one display line */
+#define LCD_FORMAT_FIELD_MAX         (LCD_COLUMNS)
+
+/* Reciprocal of 10: (v * 0xCCCCCCCD) >> 35 is exact for every uint32, and
+ * (v * 0xCCCD) >> 19 for v < 81920 without a 64-bit product
+ */
+#define LCD_RECIP10_U32              (0xCCCCCCCDu)
+#define LCD_RECIP10_U32_SHIFT        (35u)
+#define LCD_RECIP10_U16              (0xCCCDu)
+#define LCD_RECIP10_U16_SHIFT        (19u)
+
+#define LCD_DIV10_U32(v)             ((uint32_t) (((uint64_t) (v) * LCD_RECIP10_U32) >> LCD_RECIP10_U32_SHIFT))
+#define LCD_DIV10_U16(v)             ((uint32_t) (((uint32_t) (v) * LCD_RECIP10_U16) >> LCD_RECIP10_U16_SHIFT))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_LCD_FORMAT_H_ */
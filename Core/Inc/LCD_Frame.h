@@ -0,0 +1,69 @@
+/*
+ * LCD_Frame.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_FRAME_H_
+#define INC_LCD_FRAME_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+void LCD_FrameInit(void) ;
+void LCD_FramePosition(uint8_t row, uint8_t column) ;
+void LCD_FrameWriteChar(uint8_t character) ;
+void LCD_FrameClear(void) ;
+void LCD_FrameGlassCleared(void) ;
+void LCD_FrameInvalidate(void) ;
+void LCD_FlushFrame(void) ;
+uint8_t LCD_FrameClearIsCheaper(void) ;
+uint8_t LCD_FrameClearBeats(uint16_t writes) ;
+#if (LCD_USE_FRAME_SNAPSHOT != 0u)
+    void LCD_FrameSave(void) ;
+    uint8_t LCD_FrameRestore(void) ;
+    void LCD_FrameAdopt(void) ;
+#endif /* LCD_USE_FRAME_SNAPSHOT != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Character DDRAM holds after a clear display command */
+#define LCD_FRAME_BLANK              (0x20u)
+
+/* Glass cell value that never matches a frame cell, forces a resend */
+#define LCD_FRAME_UNKNOWN            (0x100u)
+
+/* 1 = producers flush after drawing into the framebuffer, 0 = the refresh
+ * task or LCD_Poll() sends the frame
+ */
+#define LCD_FRAME_AUTO_FLUSH         (((LCD_USE_REFRESH == 0u) && (LCD_USE_POLL == 0u)) ? 1u : 0u)
+
+/* Marks a snapshot written by this layout of the driver ("LCDF") */
+#define LCD_FRAME_SNAPSHOT_MAGIC     (0x4C434446u)
+
+
+/***************************************
+*        Global Variables
+***************************************/
+
+/* What the application wants on the display */
+extern uint8_t LCD_frame[LCD_ROWS][LCD_COLUMNS];
+
+/* What was last sent to the display (LCD_FRAME_UNKNOWN if not known) */
+extern uint16_t LCD_glass[LCD_ROWS][LCD_COLUMNS];
+
+extern uint8_t LCD_frameRow;
+extern uint8_t LCD_frameColumn;
+
+/* Nonzero when the framebuffer or the glass copy changed since the last flush,
+ * also set from LCD_CanIRQHandler() (LCD_USE_CAN)
+ */
+extern volatile uint8_t LCD_frameDirty;
+
+#endif /* INC_LCD_FRAME_H_ */
@@ -0,0 +1,78 @@
+/*
+ * LCD_Geometry.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_GEOMETRY_H_
+#define INC_LCD_GEOMETRY_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Visible layout of a module. Each row is one or two runs of consecutive
+* DDRAM addresses: columns 0 to split - 1 from rowBase, the rest from
+* splitBase (16x1 "type 1" modules, wired as 8x2 internally). split equals
+* columns when the row is a single run.
+*/
+typedef struct
+{
+    uint8_t rows;
+    uint8_t columns;
+    uint8_t split;
+    uint8_t rowBase[LCD_GEOMETRY_MAX_ROWS];
+    uint8_t splitBase[LCD_GEOMETRY_MAX_ROWS];
+} LCD_GEOMETRY_STRUCT;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+uint8_t LCD_GeometryAddress(LCD_GEOMETRY_STRUCT const *geometry, uint8_t row, uint8_t column) ;
+uint8_t LCD_GeometryRun(LCD_GEOMETRY_STRUCT const *geometry, uint8_t run, uint8_t *start, uint8_t *length) ;
+uint8_t LCD_SetGeometry(LCD_GEOMETRY_STRUCT const *geometry) ;
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Runs of a geometry, LCD_GeometryRun() index (row * 2 + half) */
+#define LCD_GEOMETRY_RUNS            (2u * LCD_GEOMETRY_MAX_ROWS)
+
+/* Geometry every handle starts with */
+#define LCD_GEOMETRY_DEFAULT         (&LCD_geometries[LCD_GEOMETRY])
+
+/* LCD_GEOMETRY as constants, for addresses resolved at compile time */
+#if (LCD_GEOMETRY == LCD_GEOMETRY_16X1)
+    #define LCD_GEOMETRY_COLUMNS     (16u)
+    #define LCD_GEOMETRY_SPLIT       (8u)
+#elif ((LCD_GEOMETRY == LCD_GEOMETRY_16X1_LINEAR) || (LCD_GEOMETRY == LCD_GEOMETRY_16X2) || \
+       (LCD_GEOMETRY == LCD_GEOMETRY_16X4))
+    #define LCD_GEOMETRY_COLUMNS     (16u)
+    #define LCD_GEOMETRY_SPLIT       (16u)
+#elif ((LCD_GEOMETRY == LCD_GEOMETRY_20X2) || (LCD_GEOMETRY == LCD_GEOMETRY_20X4))
+    #define LCD_GEOMETRY_COLUMNS     (20u)
+    #define LCD_GEOMETRY_SPLIT       (20u)
+#else
+    #define LCD_GEOMETRY_COLUMNS     (40u)
+    #define LCD_GEOMETRY_SPLIT       (40u)
+#endif /* LCD_GEOMETRY */
+
+/* DDRAM address of a cell of LCD_GEOMETRY (same result as LCD_GeometryAddress) */
+#define LCD_GEOMETRY_ADDRESS(row, column) \
+    ((uint8_t) (((column) < LCD_GEOMETRY_SPLIT) ? \
+                ((((row) & 1u) * 0x40u) + (((row) >> 1u) * LCD_GEOMETRY_COLUMNS) + (column)) : \
+                (0x40u + ((column) - LCD_GEOMETRY_SPLIT))))
+
+/***************************************
+*        Global Variables
+***************************************/
+
+/* Descriptors of the LCD_GEOMETRY_ values, in that order */
+extern LCD_GEOMETRY_STRUCT const LCD_geometries[LCD_GEOMETRY_COUNT];
+
+#endif /* INC_LCD_GEOMETRY_H_ */
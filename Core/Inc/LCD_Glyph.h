@@ -0,0 +1,113 @@
+/*
+ * LCD_Glyph.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_GLYPH_H_
+#define INC_LCD_GLYPH_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Glyphs in flash at "bits" bits per row: glyph g is the 8 row codes in
+* codes[g * bits] onwards (bits bytes, LSB first, row 0 first), each code an
+* index into the shared row dictionary "rows". Without a dictionary (NULL)
+* 5-bit codes are the rows themselves.
+*/
+typedef struct
+{
+    uint8_t const *rows;            /* Distinct 5-bit rows, (1 << bits) at most, or NULL */
+    uint8_t const *codes;           /* count * bits bytes, LCD_GLYPH_PACKEDn() */
+    uint16_t count;                 /* Glyphs in the pack */
+    uint8_t bits;                   /* Bits per row code, 1 - 5 */
+} LCD_GLYPH_PACK;
+
+#define LCD_GLYPH_PACK_INIT(rows, codes, bits) \
+    { (rows), (codes), (uint16_t) (sizeof(codes) / (bits)), (bits) }
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+void LCD_GlyphReset(void) ;
+void LCD_GlyphSetTable(uint8_t const (*table)[LCD_GLYPH_ROWS], uint16_t count) ;
+uint8_t LCD_GlyphAcquire(uint8_t const pattern[]) ;
+uint8_t LCD_GlyphAcquireId(uint16_t glyphId) ;
+void LCD_PutGlyph(uint16_t glyphId) ;
+uint8_t LCD_GlyphPin(uint8_t const pattern[]) ;
+void LCD_GlyphUnpin(uint8_t slot) ;
+void LCD_GlyphRewrite(uint8_t slot, uint8_t const pattern[]) ;
+void LCD_GlyphUpdateRows(uint8_t slot, uint8_t row, uint8_t count) ;
+void LCD_LoadCustomFonts(uint8_t const customData[]) ;
+void LCD_GlyphLoad(uint8_t slot, uint8_t const pattern[]) ;
+void LCD_GlyphRestore(void) ;
+#if (LCD_USE_GLYPH_QUEUE != 0u)
+    uint8_t LCD_GlyphReplace(uint8_t const from[], uint8_t const to[]) ;
+    uint8_t LCD_GlyphPoll(void) ;
+#endif /* LCD_USE_GLYPH_QUEUE != 0u */
+#if (LCD_USE_GLYPH_PACKS != 0u)
+    void LCD_GlyphSetPack(LCD_GLYPH_PACK const *pack) ;
+    uint8_t LCD_GlyphAcquirePacked(LCD_GLYPH_PACK const *pack, uint16_t glyph) ;
+    void LCD_PutPackedGlyph(LCD_GLYPH_PACK const *pack, uint16_t glyph) ;
+    uint8_t LCD_GlyphUnpack(LCD_GLYPH_PACK const *pack, uint16_t glyph, uint8_t pattern[]) ;
+#endif /* LCD_USE_GLYPH_PACKS != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* CGRAM slots (character codes 0 - 7) */
+#define LCD_GLYPH_SLOTS              (8u)
+
+/* Returned by LCD_GlyphAcquire() when every slot is on screen */
+#define LCD_GLYPH_NO_SLOT            (0xFFu)
+
+/* Printed by LCD_PutGlyph() for unknown IDs or without a free slot */
+#define LCD_GLYPH_FALLBACK           ('?')
+
+/* Row codes c0 (top) - c7 of one glyph as the bytes of a pack with 2 - 5
+* bits per code, e.g. 4-bit codes into a dictionary of up to 16 rows
+*/
+#define LCD_GLYPH_CODES(bits, c0, c1, c2, c3, c4, c5, c6, c7) \
+    ((uint64_t) (c0) | ((uint64_t) (c1) << (bits)) | ((uint64_t) (c2) << (2u * (bits))) | \
+     ((uint64_t) (c3) << (3u * (bits))) | ((uint64_t) (c4) << (4u * (bits))) | \
+     ((uint64_t) (c5) << (5u * (bits))) | ((uint64_t) (c6) << (6u * (bits))) | \
+     ((uint64_t) (c7) << (7u * (bits))))
+#define LCD_GLYPH_CODE_BYTE(value, k) ((uint8_t) (((value) >> (8u * (k))) & 0xFFu))
+
+#define LCD_GLYPH_PACKED2(c0, c1, c2, c3, c4, c5, c6, c7) \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(2u, c0, c1, c2, c3, c4, c5, c6, c7), 0u), \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(2u, c0, c1, c2, c3, c4, c5, c6, c7), 1u)
+#define LCD_GLYPH_PACKED3(c0, c1, c2, c3, c4, c5, c6, c7) \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(3u, c0, c1, c2, c3, c4, c5, c6, c7), 0u), \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(3u, c0, c1, c2, c3, c4, c5, c6, c7), 1u), \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(3u, c0, c1, c2, c3, c4, c5, c6, c7), 2u)
+#define LCD_GLYPH_PACKED4(c0, c1, c2, c3, c4, c5, c6, c7) \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(4u, c0, c1, c2, c3, c4, c5, c6, c7), 0u), \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(4u, c0, c1, c2, c3, c4, c5, c6, c7), 1u), \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(4u, c0, c1, c2, c3, c4, c5, c6, c7), 2u), \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(4u, c0, c1, c2, c3, c4, c5, c6, c7), 3u)
+#define LCD_GLYPH_PACKED5(c0, c1, c2, c3, c4, c5, c6, c7) \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(5u, c0, c1, c2, c3, c4, c5, c6, c7), 0u), \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(5u, c0, c1, c2, c3, c4, c5, c6, c7), 1u), \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(5u, c0, c1, c2, c3, c4, c5, c6, c7), 2u), \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(5u, c0, c1, c2, c3, c4, c5, c6, c7), 3u), \
+    LCD_GLYPH_CODE_BYTE(LCD_GLYPH_CODES(5u, c0, c1, c2, c3, c4, c5, c6, c7), 4u)
+
+/* Widest row code of a pack */
+#define LCD_GLYPH_PACK_BITS_MAX      (5u)
+
+/***************************************
+*        Global Variables
+***************************************/
+
+/* CGRAM as last uploaded to the display on E_Pin, and the slots it holds */
+extern uint8_t LCD_cgramShadow[LCD_GLYPH_SLOTS * LCD_GLYPH_ROWS];
+extern uint8_t LCD_cgramWritten;
+
+#endif /* INC_LCD_GLYPH_H_ */
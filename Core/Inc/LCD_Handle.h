@@ -0,0 +1,108 @@
+/*
+ * LCD_Handle.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_HANDLE_H_
+#define INC_LCD_HANDLE_H_
+
+#include "LCD_Config.h"
+#include "LCD_Transport.h"
+#include "LCD_Geometry.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Mode registers and enable state saved by LCD_SaveConfig() */
+typedef struct
+{
+    uint8_t functionSet;
+    uint8_t entryMode;
+    uint8_t displayControl;
+    uint8_t enableState;
+} LCD_BACKUP_STRUCT;
+
+/* Per-controller state. DB4-DB7 (DB0-DB7), RS and R/nW are shared by every
+* display on the bus; each controller only latches the bus on its own E line.
+*/
+typedef struct
+{
+    GPIO_TypeDef *ePort;            /* E line of this controller */
+    uint32_t eBits;                 /* LCD_PIN_BITS() of the E pin */
+
+    uint8_t initVar;                /* 1 once initialized (LCD_Start) */
+    uint8_t enableState;            /* 1 while the display is on */
+    uint8_t initStep;               /* LCD_InitPoll() sequence step */
+    uint32_t initTick;              /* HAL tick of the last init step */
+
+    uint32_t timingStart;           /* DWT timestamp of the last write */
+    uint32_t timingDuration;        /* Execution time of the last write, cycles */
+
+    uint8_t cursorAddress;          /* Address counter mirror (cursor tracking) */
+    uint8_t cursorIncrement;        /* Entry mode, 1 = increment */
+    uint8_t cursorDdram;            /* 1 while the address counter is known to be in DDRAM */
+    uint8_t wrapAddress;            /* End of the visible run a print filled, wraps on the next one */
+
+    uint8_t functionSet;            /* Last function set command */
+    uint8_t entryMode;              /* Last entry mode set command */
+    uint8_t displayControl;         /* Last display on/off control command */
+    uint8_t entryReversed;          /* 1 while LCD_PrintU32Right() left decrement mode on */
+    LCD_BACKUP_STRUCT backup;       /* LCD_SaveConfig() copy */
+
+    uint8_t linkState;              /* LCD_LINK_UP/LOST/BACK (LCD_IsReady timeouts) */
+    uint8_t recoverStep;            /* LCD_RecoverPoll() handshake step */
+    uint32_t linkTick;              /* HAL tick of the last link change or recovery step */
+    LCD_GEOMETRY_STRUCT const *geometry;   /* Visible layout (LCD_SetGeometry) */
+#if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+    LCD_Transport const *transport; /* Wiring of this controller (LCD_SetTransport) */
+#endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+} LCD_Handle;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_MULTI_DISPLAY != 0u)
+    void LCD_HandleInit(LCD_Handle *handle, GPIO_TypeDef *ePort, uint32_t ePin) ;
+    void LCD_HandleStart(LCD_Handle *handle) ;
+    void LCD_HandleInitBegin(LCD_Handle *handle) ;
+    uint8_t LCD_HandleInitPoll(LCD_Handle *handle) ;
+    uint8_t LCD_HandleIsBusy(LCD_Handle *handle) ;
+    void LCD_HandleWriteControl(LCD_Handle *handle, uint8_t cByte) ;
+    void LCD_HandleWriteData(LCD_Handle *handle, uint8_t dByte) ;
+    void LCD_HandleWriteBuffer(LCD_Handle *handle, uint8_t const buffer[], size_t length) ;
+    void LCD_HandlePosition(LCD_Handle *handle, uint8_t row, uint8_t column) ;
+    void LCD_HandlePrintString(LCD_Handle *handle, char const string[]) ;
+    void LCD_HandlePrintInterleaved(LCD_Handle *const handles[], char const *const strings[], uint8_t count) ;
+    void LCD_HandleClearDisplay(LCD_Handle *handle) ;
+#endif /* LCD_USE_MULTI_DISPLAY != 0u */
+
+/***************************************
+*        Global Variables
+***************************************/
+
+/* Display wired to E_Pin, the one the classic LCD_ API, the framebuffer and
+* the DMA/interrupt transports drive
+*/
+extern LCD_Handle LCD_display0;
+
+#if (LCD_USE_MULTI_DISPLAY != 0u)
+    /* Controller addressed by the LCD_ API (LCD_Handle.c switches it) */
+    extern LCD_Handle *LCD_active;
+
+    #define LCD_E_PORT               (LCD_active->ePort)
+    #define LCD_E_BITS               (LCD_active->eBits)
+    #define LCD_IS_PRIMARY()         (LCD_active == &LCD_display0)
+#else
+    /* Single display: the state and E pin resolve at compile time */
+    #define LCD_active               (&LCD_display0)
+
+    #define LCD_E_PORT               (E_GPIO_Port)
+    #define LCD_E_BITS               (LCD_PIN_BITS(E_Pin))
+    #define LCD_IS_PRIMARY()         (1u)
+#endif /* LCD_USE_MULTI_DISPLAY != 0u */
+
+#endif /* INC_LCD_HANDLE_H_ */
@@ -0,0 +1,56 @@
+/*
+ * LCD_I2c.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_I2C_H_
+#define INC_LCD_I2C_H_
+
+#include <stddef.h>
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_I2C_TRANSPORT != 0u)
+    void LCD_I2cStart(void) ;
+    void LCD_I2cWriteByte(uint8_t value, uint8_t rs) ;
+    void LCD_I2cWriteHandshake(uint8_t nibble) ;
+    void LCD_I2cWriteBuffer(uint8_t const buffer[], size_t length) ;
+    void LCD_I2cBatchBegin(void) ;
+    void LCD_I2cBatchEnd(void) ;
+    uint8_t LCD_I2cSync(void) ;
+    uint8_t LCD_I2cIsBusy(void) ;
+    uint32_t LCD_I2cErrors(void) ;
+    void LCD_I2cSetBacklight(uint8_t on) ;
+    void LCD_I2cEventIRQHandler(void) ;
+    void LCD_I2cErrorIRQHandler(void) ;
+#endif /* LCD_USE_I2C_TRANSPORT != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* PCF8574 port bits of the common backpack wiring */
+#define LCD_I2C_RS                   (0x01u)   /* P0 */
+#define LCD_I2C_RW                   (0x02u)   /* P1 */
+#define LCD_I2C_E                    (0x04u)   /* P2 */
+#define LCD_I2C_BACKLIGHT            (0x08u)   /* P3 */
+#define LCD_I2C_DATA_SHIFT           (4u)      /* P4-P7 = DB4-DB7 */
+
+/* Expander states per nibble (E high, E low) and per byte */
+#define LCD_I2C_BYTES_PER_NIBBLE     (2u)
+#define LCD_I2C_BYTES_PER_BYTE       (2u * LCD_I2C_BYTES_PER_NIBBLE)
+
+/* One expander byte on the wire: 8 data bits and the acknowledge */
+#define LCD_I2C_BYTE_NS              (9000000u / (LCD_I2C_CLOCK_HZ / 1000u))
+
+/* Expander states repeated after a byte so the next E strobe comes after the
+ * execution time; one byte time (the next E high state) is always there
+ */
+#define LCD_I2C_PAD(us)              (((((us) * 1000u) + LCD_I2C_BYTE_NS - 1u) / LCD_I2C_BYTE_NS) - 1u)
+
+#endif /* INC_LCD_I2C_H_ */
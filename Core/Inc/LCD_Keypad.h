@@ -0,0 +1,39 @@
+/*
+ * LCD_Keypad.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_KEYPAD_H_
+#define INC_LCD_KEYPAD_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_KEYPAD != 0u)
+    void LCD_KeypadStart(void) ;
+    void LCD_KeypadTick(void) ;
+    uint8_t LCD_KeypadGetEvent(uint8_t *event) ;
+    uint16_t LCD_KeypadState(void) ;
+#endif /* LCD_USE_KEYPAD != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Matrix size: rows on LCD_KEYPAD_ROWn_PIN, columns on DB4-DB7 */
+#define LCD_KEYPAD_ROWS              (4u)
+#define LCD_KEYPAD_COLUMNS           (4u)
+
+/* LCD_KeypadGetEvent() event: key index row * 4 + column, and the release flag */
+#define LCD_KEYPAD_RELEASED          (0x80u)
+#define LCD_KEYPAD_KEY(event)        ((uint8_t) ((event) & 0x0Fu))
+
+/* LCD_KeypadState() bit of a key */
+#define LCD_KEYPAD_BIT(row, column)  ((uint16_t) (1u << (((row) * LCD_KEYPAD_COLUMNS) + (column))))
+
+#endif /* INC_LCD_KEYPAD_H_ */
@@ -0,0 +1,100 @@
+/*
+ * LCD_Latency.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_LATENCY_H_
+#define INC_LCD_LATENCY_H_
+
+#include "LCD_Config.h"
+#include "LCD_Frame.h"
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Priority classes, up to LCD_LATENCY_CLASSES - 1 */
+#define LCD_LATENCY_ROUTINE          (0u)      /* Refresh task, fields, menus */
+#define LCD_LATENCY_ALARM            (1u)      /* Drawn ahead of LCD_RefreshUrgent() */
+
+/* Histogram: latencies below 4 us get a bucket each, above that every power
+ * of two is split into 4 buckets (25 % resolution); the last bucket, from
+ * 1835008 us, also holds everything longer
+ */
+#define LCD_LATENCY_SUBBUCKETS       (4u)
+#define LCD_LATENCY_BUCKETS          (80u)
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Update latencies of one priority class since LCD_ResetStats(), in us from
+ * the cell change to the end of the flush that sent it
+ */
+typedef struct
+{
+    uint32_t samples;                           /* Cells that reached the glass */
+    uint32_t usMin;
+    uint32_t usMax;
+    uint32_t usAverage;                         /* Filled in by LCD_GetLatency() */
+    uint32_t us50;                              /* Percentiles, filled in by LCD_GetLatency(): */
+    uint32_t us90;                              /* upper bound of the bucket, at most usMax */
+    uint32_t us99;
+    uint64_t usTotal;
+    uint32_t buckets[LCD_LATENCY_BUCKETS];      /* Samples from LCD_LatencyBucketUs(bucket) on */
+} LCD_LATENCY;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_LATENCY != 0u)
+    uint8_t LCD_LatencySetClass(uint8_t priority) ;
+    void LCD_LatencyMark(uint8_t row, uint8_t column, uint8_t length) ;
+    void LCD_GetLatency(uint8_t priority, LCD_LATENCY *latency) ;
+    uint32_t LCD_LatencyPercentile(uint8_t priority, uint16_t permille) ;
+    uint32_t LCD_LatencyBucketUs(uint8_t bucket) ;
+    void LCD_LatencyReset(void) ;
+#endif /* LCD_USE_LATENCY != 0u */
+
+/***************************************
+*        Instrumentation Macros
+***************************************/
+
+#if (LCD_USE_LATENCY != 0u)
+    /* Cell states: 0 = nothing pending, else the class + 1, and with
+     * LCD_LATENCY_SENT_FLAG while its flush runs
+     */
+    #define LCD_LATENCY_SENT_FLAG        (0x80u)
+
+    extern uint8_t LCD_latencyCell[LCD_ROWS][LCD_COLUMNS];
+
+    /* Before a framebuffer store: stamps the cell if the store makes it
+     * differ from the glass, drops its stamp if the store puts the glass
+     * value back before a flush picked it up
+     */
+    #define LCD_LATENCY_CHANGE(row, column, character)  \
+        do { if (LCD_glass[(row)][(column)] != (uint16_t) (uint8_t) (character)) { LCD_LatencyChange((row), (column)); } \
+             else if ((LCD_latencyCell[(row)][(column)] & LCD_LATENCY_SENT_FLAG) == 0u) { LCD_latencyCell[(row)][(column)] = 0u; } } while (0)
+    /* A flush takes the cell, LCD_LATENCY_FLUSHED() accounts it */
+    #define LCD_LATENCY_SENT(row, column)  \
+        do { if (LCD_latencyCell[(row)][(column)] != 0u) { LCD_latencyCell[(row)][(column)] |= LCD_LATENCY_SENT_FLAG; } } while (0)
+    #define LCD_LATENCY_FLUSHED()        LCD_LatencyFlushed()
+    /* A single cell written to the glass outside a flush */
+    #define LCD_LATENCY_SHOWN(row, column)  \
+        do { if (LCD_latencyCell[(row)][(column)] != 0u) { LCD_LatencyShown((row), (column)); } } while (0)
+
+    void LCD_LatencyChange(uint8_t row, uint8_t column) ;
+    void LCD_LatencyFlushed(void) ;
+    void LCD_LatencyShown(uint8_t row, uint8_t column) ;
+#else
+    /* Probes compile to nothing */
+    #define LCD_LATENCY_CHANGE(row, column, character)  ((void) 0)
+    #define LCD_LATENCY_SENT(row, column)  ((void) 0)
+    #define LCD_LATENCY_FLUSHED()        ((void) 0)
+    #define LCD_LATENCY_SHOWN(row, column)  ((void) 0)
+#endif /* LCD_USE_LATENCY != 0u */
+
+#endif /* INC_LCD_LATENCY_H_ */
@@ -0,0 +1,78 @@
+/*
+ * LCD_List.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_LIST_H_
+#define INC_LCD_LIST_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Display list opcodes, each followed by its argument bytes */
+#define LCD_LIST_OP_END              (0x00u)   /* - */
+#define LCD_LIST_OP_AT               (0x01u)   /* row, column */
+#define LCD_LIST_OP_TEXT             (0x02u)   /* length, characters */
+#define LCD_LIST_OP_NUMBER           (0x03u)   /* slot, width, decimals: int32, right-justified */
+#define LCD_LIST_OP_STRING           (0x04u)   /* slot, width: char const[], left-justified */
+#define LCD_LIST_OP_GLYPH            (0x05u)   /* glyph ID low, high byte */
+#define LCD_LIST_OP_FILL             (0x06u)   /* character, count */
+
+/* Shown in every cell of a number wider than its width */
+#define LCD_LIST_OVERFLOW            ('*')
+
+/* List entries for const tables in flash, e.g.
+ * { LCD_LIST_AT(0u, 0u), LCD_LIST_TEXT(2u), 'T', '=', LCD_LIST_NUMBER(0u, 5u, 1u), LCD_LIST_END }
+ */
+#define LCD_LIST_AT(row, column)     LCD_LIST_OP_AT, (uint8_t) (row), (uint8_t) (column)
+#define LCD_LIST_TEXT(length)        LCD_LIST_OP_TEXT, (uint8_t) (length)
+#define LCD_LIST_NUMBER(slot, width, decimals) \
+    LCD_LIST_OP_NUMBER, (uint8_t) (slot), (uint8_t) (width), (uint8_t) (decimals)
+#define LCD_LIST_STRING(slot, width) LCD_LIST_OP_STRING, (uint8_t) (slot), (uint8_t) (width)
+#define LCD_LIST_GLYPH(glyphId)      LCD_LIST_OP_GLYPH, (uint8_t) (glyphId), (uint8_t) ((glyphId) >> 8u)
+#define LCD_LIST_FILL(character, count) \
+    LCD_LIST_OP_FILL, (uint8_t) (character), (uint8_t) (count)
+#define LCD_LIST_END                 LCD_LIST_OP_END
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Value of one parameter slot, the list says which member is read */
+typedef union
+{
+    int32_t number;                 /* LCD_LIST_OP_NUMBER, value * 10^decimals */
+    char const *text;               /* LCD_LIST_OP_STRING, terminated */
+} LCD_LIST_PARAM;
+
+/* Recorder state, LCD_ListBegin() to LCD_ListEnd() */
+typedef struct
+{
+    uint8_t *buffer;
+    uint16_t size;
+    uint16_t length;
+    uint8_t overflow;               /* 1 once an entry did not fit */
+} LCD_LIST;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_DISPLAY_LIST != 0u)
+    void LCD_ListBegin(LCD_LIST *list, uint8_t buffer[], uint16_t size) ;
+    void LCD_ListAt(LCD_LIST *list, uint8_t row, uint8_t column) ;
+    void LCD_ListText(LCD_LIST *list, char const text[]) ;
+    void LCD_ListNumber(LCD_LIST *list, uint8_t slot, uint8_t width, uint8_t decimals) ;
+    void LCD_ListString(LCD_LIST *list, uint8_t slot, uint8_t width) ;
+    void LCD_ListGlyph(LCD_LIST *list, uint16_t glyphId) ;
+    void LCD_ListFill(LCD_LIST *list, char character, uint8_t count) ;
+    uint16_t LCD_ListEnd(LCD_LIST *list) ;
+    void LCD_ListPlay(uint8_t const list[], LCD_LIST_PARAM const params[]) ;
+#endif /* LCD_USE_DISPLAY_LIST != 0u */
+
+#endif /* INC_LCD_LIST_H_ */
@@ -0,0 +1,26 @@
+/*
+ * LCD_Lockstep.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_LOCKSTEP_H_
+#define INC_LCD_LOCKSTEP_H_
+
+#include <stddef.h>
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_LOCKSTEP != 0u)
+    void LCD_LockstepWrite(uint8_t const first[], uint8_t const second[], size_t length) ;
+    void LCD_LockstepPrintAt(uint8_t row, uint8_t column, char const first[], char const second[]) ;
+    void LCD_LockstepFlush(uint8_t const first[LCD_ROWS][LCD_COLUMNS],
+                           uint8_t const second[LCD_ROWS][LCD_COLUMNS]) ;
+    void LCD_LockstepInvalidate(void) ;
+#endif /* LCD_USE_LOCKSTEP != 0u */
+
+#endif /* INC_LCD_LOCKSTEP_H_ */
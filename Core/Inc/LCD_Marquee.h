@@ -0,0 +1,22 @@
+/*
+ * LCD_Marquee.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_MARQUEE_H_
+#define INC_LCD_MARQUEE_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+void LCD_MarqueeStart(uint8_t row, char const message[], uint32_t periodMs) ;
+void LCD_MarqueeTask(void) ;
+void LCD_MarqueeStop(void) ;
+uint8_t LCD_MarqueeIsRunning(void) ;
+
+#endif /* INC_LCD_MARQUEE_H_ */
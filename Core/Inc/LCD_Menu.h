@@ -0,0 +1,90 @@
+/*
+ * LCD_Menu.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_MENU_H_
+#define INC_LCD_MENU_H_
+
+#include <stddef.h>
+#include "LCD_Config.h"
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Item kinds */
+#define LCD_MENU_ACTION              (0u)      /* ENTER calls action */
+#define LCD_MENU_SUBMENU             (1u)      /* ENTER opens submenu */
+#define LCD_MENU_VALUE               (2u)      /* ENTER edits *value, UP/DOWN step it */
+#define LCD_MENU_BACK                (3u)      /* ENTER returns to the parent menu */
+
+/* LCD_MenuInput() keys */
+#define LCD_MENU_KEY_UP              (0u)
+#define LCD_MENU_KEY_DOWN            (1u)
+#define LCD_MENU_KEY_ENTER           (2u)
+#define LCD_MENU_KEY_BACK            (3u)
+
+/* Column 0 of the selected row (HD44780 ROM right arrow), and while editing */
+#define LCD_MENU_MARK                (0x7Eu)
+#define LCD_MENU_EDIT_MARK           ('*')
+
+/* Last column of a submenu item */
+#define LCD_MENU_MORE                ('>')
+
+/***************************************
+*        Data Types
+***************************************/
+
+struct LCD_MENU_STRUCT;
+
+/* One row of a menu. Values are shown right-justified in the last
+* LCD_MENU_VALUE_WIDTH columns as value / 10^decimals.
+*/
+typedef struct
+{
+    char const *label;
+    uint8_t kind;                   /* LCD_MENU_... */
+    uint8_t decimals;               /* LCD_MENU_VALUE fraction digits */
+    int32_t *value;                 /* LCD_MENU_VALUE */
+    int32_t min;
+    int32_t max;
+    int32_t step;
+    struct LCD_MENU_STRUCT const *submenu;  /* LCD_MENU_SUBMENU */
+    void (*action)(void);           /* LCD_MENU_ACTION, also after a value edit (may be NULL) */
+} LCD_MENU_ITEM;
+
+/* A menu: its items, usually const tables in flash */
+typedef struct LCD_MENU_STRUCT
+{
+    LCD_MENU_ITEM const *items;
+    uint8_t count;
+} LCD_MENU;
+
+/* Table entries */
+#define LCD_MENU_ACTION_ITEM(label, action) \
+    { (label), LCD_MENU_ACTION, 0u, NULL, 0, 0, 0, NULL, (action) }
+
+#define LCD_MENU_SUBMENU_ITEM(label, submenu) \
+    { (label), LCD_MENU_SUBMENU, 0u, NULL, 0, 0, 0, (submenu), NULL }
+
+#define LCD_MENU_VALUE_ITEM(label, value, min, max, step, decimals, changed) \
+    { (label), LCD_MENU_VALUE, (decimals), (value), (min), (max), (step), NULL, (changed) }
+
+#define LCD_MENU_BACK_ITEM(label) \
+    { (label), LCD_MENU_BACK, 0u, NULL, 0, 0, 0, NULL, NULL }
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_MENU != 0u)
+    void LCD_MenuStart(LCD_MENU const *menu, uint8_t row, uint8_t rows) ;
+    void LCD_MenuInput(uint8_t key) ;
+    void LCD_MenuRefresh(void) ;
+    LCD_MENU_ITEM const *LCD_MenuSelected(void) ;
+#endif /* LCD_USE_MENU != 0u */
+
+#endif /* INC_LCD_MENU_H_ */
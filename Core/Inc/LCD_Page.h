@@ -0,0 +1,31 @@
+/*
+ * LCD_Page.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_PAGE_H_
+#define INC_LCD_PAGE_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_PAGE_FLIP != 0u)
+    uint8_t LCD_PageStart(void) ;
+    void LCD_PageFlip(void) ;
+    void LCD_PageStop(void) ;
+    uint8_t LCD_PageShown(void) ;
+#endif /* LCD_USE_PAGE_FLIP != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* DDRAM pages: page 0 at the row bases, page 1 one window further right */
+#define LCD_PAGE_COUNT               (2u)
+
+#endif /* INC_LCD_PAGE_H_ */
@@ -0,0 +1,51 @@
+/*
+ * LCD_Plan.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_PLAN_H_
+#define INC_LCD_PLAN_H_
+
+#include "LCD_Config.h"
+#include "LCD_Geometry.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* One bulk write of a flush: length framebuffer cells of a row from column
+* start, after a set-DDRAM-address command when addressed is set
+*/
+typedef struct
+{
+    uint8_t row;
+    uint8_t start;
+    uint8_t length;
+    uint8_t addressed;
+} LCD_PLAN_SPAN;
+
+/* Walk of the framebuffer, the DDRAM runs of the geometry in address order */
+typedef struct
+{
+    LCD_GEOMETRY_STRUCT const *geometry;
+    uint8_t order[LCD_GEOMETRY_RUNS];   /* LCD_GeometryRun() indices */
+    uint8_t runs;
+    uint8_t index;                      /* entry of order being walked */
+    uint8_t column;                     /* next column of that run to look at */
+    uint8_t carry;                      /* 1 = the next span starts at column, changed or not */
+    uint8_t cursor;                     /* address counter after the last span */
+    uint8_t gapMax;                     /* longest unchanged gap rewritten instead of skipped */
+} LCD_PLAN;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_FLUSH_PLANNER != 0u)
+    void LCD_PlanStart(LCD_PLAN *plan) ;
+    uint8_t LCD_PlanNext(LCD_PLAN *plan, LCD_PLAN_SPAN *span) ;
+#endif /* LCD_USE_FLUSH_PLANNER != 0u */
+
+#endif /* INC_LCD_PLAN_H_ */
@@ -0,0 +1,21 @@
+/*
+ * LCD_Poll.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_POLL_H_
+#define INC_LCD_POLL_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_POLL != 0u)
+    uint8_t LCD_Poll(uint32_t budgetUs) ;
+#endif /* LCD_USE_POLL != 0u */
+
+#endif /* INC_LCD_POLL_H_ */
@@ -0,0 +1,48 @@
+/*
+ * LCD_Profile.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_PROFILE_H_
+#define INC_LCD_PROFILE_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Samples taken since LCD_ProfileStart(), per LCD_PROFILE_ bucket */
+typedef struct
+{
+    uint32_t samples[3];
+} LCD_PROFILE;
+
+/* Sends one character of the report (ITM, UART, ...) */
+typedef void (*LCD_ProfilePutChar)(char character);
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_PROFILER != 0u)
+    void LCD_ProfileStart(void) ;
+    void LCD_ProfileStop(void) ;
+    void LCD_ProfileGet(LCD_PROFILE *profile) ;
+    void LCD_ProfileReport(LCD_ProfilePutChar putChar) ;
+    void LCD_ProfileItmPutChar(char character) ;
+    void LCD_ProfileIRQHandler(uint32_t const frame[]) ;
+#endif /* LCD_USE_PROFILER != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Buckets of LCD_PROFILE.samples */
+#define LCD_PROFILE_DRIVER           (0u)      /* LCD*.c, flash and .RamFunc */
+#define LCD_PROFILE_DELAY            (1u)      /* delay_us() in main.c */
+#define LCD_PROFILE_OTHER            (2u)      /* application, HAL, idle */
+
+#endif /* INC_LCD_PROFILE_H_ */
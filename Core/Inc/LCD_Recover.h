@@ -0,0 +1,34 @@
+/*
+ * LCD_Recover.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_RECOVER_H_
+#define INC_LCD_RECOVER_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_LINK_RECOVERY != 0u)
+    uint8_t LCD_RecoverPoll(void) ;
+    void LCD_RecoverRequest(void) ;
+#endif /* LCD_USE_LINK_RECOVERY != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Waits before each handshake nibble of a re-initialization and before the
+ * probe after the last one (ms); the first is the power-on reset of a module
+ * that browned out
+ */
+#define LCD_RECOVER_POWER_ON_MS      (40u)
+#define LCD_RECOVER_INIT1_MS         (5u)
+#define LCD_RECOVER_INIT2_MS         (1u)
+
+#endif /* INC_LCD_RECOVER_H_ */
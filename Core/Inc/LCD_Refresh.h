@@ -0,0 +1,29 @@
+/*
+ * LCD_Refresh.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_REFRESH_H_
+#define INC_LCD_REFRESH_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_REFRESH != 0u)
+    uint8_t LCD_RefreshTask(void) ;
+    void LCD_RefreshUrgent(void) ;
+#endif /* LCD_USE_REFRESH != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Shortest time between two scheduled flushes */
+#define LCD_REFRESH_PERIOD_MS        (1000u / LCD_REFRESH_HZ)
+
+#endif /* INC_LCD_REFRESH_H_ */
@@ -0,0 +1,44 @@
+/*
+ * LCD_Remote.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_REMOTE_H_
+#define INC_LCD_REMOTE_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_REMOTE != 0u)
+    #if (LCD_REMOTE_USART != 0u)
+        void LCD_RemoteStart(void) ;
+        uint8_t LCD_RemotePoll(void) ;
+        void LCD_RemoteIRQHandler(void) ;
+    #endif /* LCD_REMOTE_USART != 0u */
+    uint8_t LCD_RemoteFeed(uint8_t const data[], uint16_t length) ;
+    uint32_t LCD_RemoteErrors(void) ;
+#endif /* LCD_USE_REMOTE != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Frame: LCD_REMOTE_SYNC, type, payload length, payload, check (the 8-bit
+ * sum of type, length, payload and check is 0)
+ */
+#define LCD_REMOTE_SYNC              (0xA5u)
+#define LCD_REMOTE_OVERHEAD          (4u)
+
+/* Frame types and their payload */
+#define LCD_REMOTE_CELLS             (0x01u)   /* row, column, characters */
+#define LCD_REMOTE_FRAME             (0x02u)   /* rows * columns characters, row by row */
+#define LCD_REMOTE_CGRAM             (0x03u)   /* slot 0 - 7, 8 pattern rows */
+#define LCD_REMOTE_BACKLIGHT         (0x04u)   /* level 0 - 255 (PWM), or off/on */
+#define LCD_REMOTE_CLEAR             (0x05u)   /* none, blanks the framebuffer */
+
+#endif /* INC_LCD_REMOTE_H_ */
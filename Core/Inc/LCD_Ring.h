@@ -0,0 +1,32 @@
+/*
+ * LCD_Ring.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_RING_H_
+#define INC_LCD_RING_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+uint8_t LCD_RingPush(uint16_t item) ;
+uint8_t LCD_RingPushBuffer(uint16_t const items[], uint16_t count) ;
+uint8_t LCD_RingPrintAt(uint8_t row, uint8_t column, char const string[]) ;
+uint8_t LCD_RingPop(uint16_t *item) ;
+uint16_t LCD_RingDrain(uint16_t maxItems) ;
+uint16_t LCD_RingDrainAsync(void) ;
+uint16_t LCD_RingDropped(void) ;
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Longest message LCD_RingPrintAt() posts (set-DDRAM-address plus text) */
+#define LCD_RING_MESSAGE_MAX         (LCD_RING_SIZE)
+
+#endif /* INC_LCD_RING_H_ */
@@ -0,0 +1,45 @@
+/*
+ * LCD_Rtos.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_RTOS_H_
+#define INC_LCD_RTOS_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Run in the service task by LCD_RtosCall() */
+typedef void (*LCD_RtosFunction)(void *argument);
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_RTOS != 0u)
+    uint8_t LCD_RtosStart(void) ;
+    uint8_t LCD_RtosPrintAt(uint8_t row, uint8_t column, char const string[]) ;
+    uint8_t LCD_RtosCommand(uint8_t command) ;
+    uint8_t LCD_RtosCall(LCD_RtosFunction function, void *argument) ;
+
+    /* Driver hooks (LCD_Wfi.c, LCD.c) */
+    uint8_t LCD_RtosIsService(void) ;
+    void LCD_RtosWaitWake(void) ;
+    void LCD_RtosWake(void) ;
+    void LCD_RtosYield(void) ;
+    void LCD_RtosWaitExec(void) ;
+#endif /* LCD_USE_RTOS != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Thread flag set by the TIM4 compare interrupt at the end of a sleep */
+#define LCD_RTOS_FLAG_WAKE           (0x00000001u)
+
+#endif /* INC_LCD_RTOS_H_ */
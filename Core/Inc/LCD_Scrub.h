@@ -0,0 +1,32 @@
+/*
+ * LCD_Scrub.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_SCRUB_H_
+#define INC_LCD_SCRUB_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_SCRUB != 0u)
+    uint8_t LCD_ScrubPoll(void) ;
+#endif /* LCD_USE_SCRUB != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Display control bits that show the cursor (cursor on, blink) */
+#define LCD_SCRUB_CURSOR_SHOWN       (0x03u)
+
+/* CGRAM bytes compared; the module only shows the five low bits */
+#define LCD_SCRUB_CGRAM_BYTES        (LCD_GLYPH_SLOTS * LCD_GLYPH_ROWS)
+#define LCD_SCRUB_CGRAM_MASK         (0x1Fu)
+
+#endif /* INC_LCD_SCRUB_H_ */
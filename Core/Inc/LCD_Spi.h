@@ -0,0 +1,51 @@
+/*
+ * LCD_Spi.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_SPI_H_
+#define INC_LCD_SPI_H_
+
+#include <stddef.h>
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_SPI_TRANSPORT != 0u)
+    uint8_t LCD_SpiStart(void) ;
+    void LCD_SpiWriteByte(uint8_t value, uint8_t rs) ;
+    void LCD_SpiWriteHandshake(uint8_t nibble) ;
+    void LCD_SpiWriteBuffer(uint8_t const buffer[], size_t length) ;
+    uint8_t LCD_SpiSync(void) ;
+    uint8_t LCD_SpiIsBusy(void) ;
+    void LCD_SpiSetBacklight(uint8_t on) ;
+    void LCD_SpiIRQHandler(void) ;
+#endif /* LCD_USE_SPI_TRANSPORT != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* 74HC595 outputs, same layout as the PCF8574 backpack */
+#define LCD_SPI_RS                   (0x01u)   /* Q0 */
+#define LCD_SPI_RW                   (0x02u)   /* Q1 */
+#define LCD_SPI_E                    (0x04u)   /* Q2 */
+#define LCD_SPI_BACKLIGHT            (0x08u)   /* Q3 */
+#define LCD_SPI_DATA_SHIFT           (4u)      /* Q4-Q7 = DB4-DB7 */
+
+/* Latched states (timer steps) per nibble: data + RS with E low (tAS), E high,
+ * E low
+ */
+#define LCD_SPI_STATES_PER_NIBBLE    (3u)
+#define LCD_SPI_STATES_PER_BYTE      (2u * LCD_SPI_STATES_PER_NIBBLE)
+
+/* Idle steps after a byte for its execution time, rounded up (the E low
+ * state of the byte is the margin)
+ */
+#define LCD_SPI_PAD(us)              (((us) * 1000u + LCD_SPI_STEP_NS - 1u) / LCD_SPI_STEP_NS)
+
+#endif /* INC_LCD_SPI_H_ */
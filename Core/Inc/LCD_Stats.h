@@ -0,0 +1,76 @@
+/*
+ * LCD_Stats.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_STATS_H_
+#define INC_LCD_STATS_H_
+
+#include "LCD_Config.h"
+#include "LCD_Timing.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Driver performance counters (LCD_GetStats), cycles are DWT core cycles */
+typedef struct
+{
+    uint32_t bytesWritten;          /* Data bytes sent (DDRAM and CGRAM) */
+    uint32_t commandsSent;          /* Command bytes sent */
+    uint32_t commandsElided;        /* Set-DDRAM-address commands dropped by cursor tracking */
+    uint32_t cursorResyncs;         /* Cursor mirror corrected from the address counter read */
+    uint32_t positionCalls;         /* LCD_Position()/LCD_WritePosition() calls */
+    uint32_t busyWaits;             /* LCD_IsReady() calls */
+    uint32_t busyPolls;             /* Busy flag reads */
+    uint32_t timeouts;              /* LCD_IsReady() gave up with the flag still set */
+    uint32_t writesDropped;         /* Bytes not sent while the display was unresponsive */
+    uint32_t recoveries;            /* Unresponsive displays re-initialized by LCD_RecoverPoll() */
+    uint32_t busyCyclesMax;         /* Longest LCD_IsReady() */
+    uint32_t busyCyclesAverage;     /* Mean LCD_IsReady(), filled in by LCD_GetStats() */
+    uint32_t busyCyclesTotal;       /* Sum of all LCD_IsReady() (wraps) */
+    uint32_t flushes;               /* LCD_FlushFrame() calls */
+    uint32_t flushCyclesMax;        /* Longest LCD_FlushFrame() */
+    uint32_t flushCyclesLast;       /* Duration of the last LCD_FlushFrame() */
+    uint32_t asyncQueuePeak;        /* Most items waiting in the LCD_WriteAsync() queue */
+    uint32_t ringPeak;              /* Most items waiting in the LCD_RingPush() ring */
+    uint32_t arenaBytes;            /* Arena bytes handed out, filled in by LCD_GetStats() */
+    uint32_t arenaPeak;             /* Sum of the owner peaks, filled in by LCD_GetStats() */
+    uint32_t arenaFailures;         /* LCD_ArenaAlloc() calls refused */
+} LCD_STATS;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_STATS != 0u)
+    void LCD_GetStats(LCD_STATS *stats) ;
+    void LCD_ResetStats(void) ;
+#endif /* LCD_USE_STATS != 0u */
+
+/***************************************
+*        Instrumentation Macros
+***************************************/
+
+#if (LCD_USE_STATS != 0u)
+    extern LCD_STATS LCD_stats;
+
+    #define LCD_STAT_INC(field)          (LCD_stats.field++)
+    #define LCD_STAT_BUSY(start)         LCD_StatBusy((uint32_t) (LCD_CYCLES() - (start)))
+    #define LCD_STAT_FLUSH(start)        LCD_StatFlush((uint32_t) (LCD_CYCLES() - (start)))
+    #define LCD_STAT_PEAK(field, value)  \
+        do { if ((uint32_t) (value) > LCD_stats.field) { LCD_stats.field = (uint32_t) (value); } } while (0)
+
+    void LCD_StatBusy(uint32_t cycles) ;
+    void LCD_StatFlush(uint32_t cycles) ;
+#else
+    /* Instrumentation compiles to nothing */
+    #define LCD_STAT_INC(field)          ((void) 0)
+    #define LCD_STAT_BUSY(start)         ((void) 0)
+    #define LCD_STAT_FLUSH(start)        ((void) 0)
+    #define LCD_STAT_PEAK(field, value)  ((void) 0)
+#endif /* LCD_USE_STATS != 0u */
+
+#endif /* INC_LCD_STATS_H_ */
@@ -0,0 +1,34 @@
+/*
+ * LCD_Stdout.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_STDOUT_H_
+#define INC_LCD_STDOUT_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+int LCD_StdoutWrite(char const buffer[], int length) ;
+void LCD_StdoutPutChar(char character) ;
+void LCD_StdoutScroll(void) ;
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Control characters interpreted by LCD_StdoutPutChar() */
+#define LCD_STDOUT_NEWLINE           ('\n')    /* next row, scrolls on the last row */
+#define LCD_STDOUT_RETURN            ('\r')    /* column 0 */
+#define LCD_STDOUT_FORMFEED          ('\f')    /* blank framebuffer, home */
+#define LCD_STDOUT_ESCAPE            ('\x1B')  /* starts an escape sequence (LCD_STDOUT_ANSI) */
+
+/* Numeric parameters kept of a control sequence, further ones are ignored */
+#define LCD_STDOUT_ANSI_PARAMS       (2u)
+
+#endif /* INC_LCD_STDOUT_H_ */
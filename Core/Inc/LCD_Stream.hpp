@@ -0,0 +1,246 @@
+/*
+ * LCD_Stream.hpp
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Header-only C++17 stream interface of the HD44780 LCD driver.
+ *
+ *  			Lcd::Stream puts operator<< on top of the C print API: text
+ *  			goes to LCD_PrintStringN(), numbers are converted by the
+ *  			digit kernels of LCD_Format.c (reciprocal multiply, no
+ *  			division) into a buffer on the stack and written as one run.
+ *  			With LCD_USE_FRAMEBUFFER everything lands in the framebuffer
+ *  			and LCD_FlushFrame() (or the refresh task) sends it. Nothing
+ *  			is allocated, and neither std::string, iostream nor the
+ *  			newlib printf family is pulled in; a chain inlines to the
+ *  			same calls as the hand-written C.
+ *
+ *  Usage:      - Lcd::Stream lcd;
+ *  				lcd.at(1u, 4u) << "T=" << Lcd::fixed(temp, 1u) << "C";
+ *  			- manipulators: Lcd::width(n) (next item only, like
+ *  				std::setw), Lcd::fill(c), Lcd::hex / Lcd::dec, and
+ *  				Lcd::fixed(value, decimals) for a float, or an integer
+ *  				holding value * 10^decimals
+ *  			- numbers are right-justified in the width, text is
+ *  				left-justified; a wider item is written in full
+ *  			- uint8_t/int8_t print as numbers, char as a character
+ *
+ */
+
+#ifndef INC_LCD_STREAM_HPP_
+#define INC_LCD_STREAM_HPP_
+
+#include <type_traits>
+
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Format.h"
+
+namespace Lcd
+{
+
+/***************************************
+*        Manipulators
+***************************************/
+
+struct Width
+{
+    uint8_t cells;
+};
+
+struct Fill
+{
+    char character;
+};
+
+struct Base
+{
+    uint8_t hex;
+};
+
+template <typename T>
+struct Fixed
+{
+    T value;
+    uint8_t decimals;
+};
+
+constexpr Width width(uint8_t cells)
+{
+    return Width { cells };
+}
+
+constexpr Fill fill(char character)
+{
+    return Fill { character };
+}
+
+constexpr Base hex { 1u };
+constexpr Base dec { 0u };
+
+template <typename T>
+constexpr Fixed<T> fixed(T value, uint8_t decimals)
+{
+    static_assert(std::is_arithmetic<T>::value, "Lcd::fixed takes a float or a scaled integer");
+    return Fixed<T> { value, decimals };
+}
+
+/* Hex digits of a value, right-aligned at the end of "digits" (LCD_FormatU32 layout) */
+constexpr uint8_t FormatHex(char digits[], uint32_t value)
+{
+    uint8_t index = LCD_U32_DIGITS;
+
+    do
+    {
+        index--;
+        digits[index] = "0123456789ABCDEF"[value & LCD_NIBBLE_MASK];
+        value >>= LCD_NIBBLE_SHIFT;
+    } while (value != 0u);
+
+    return (uint8_t) (LCD_U32_DIGITS - index);
+}
+
+
+/***************************************
+*        Stream
+***************************************/
+
+class Stream
+{
+public:
+
+    /* Cursor of the print API (the framebuffer cursor with LCD_USE_FRAMEBUFFER) */
+    Stream &at(uint8_t row, uint8_t column)
+    {
+        LCD_Position(row, column);
+        return *this;
+    }
+
+    Stream &operator<<(char const string[])
+    {
+        uint8_t length = 0u;
+
+        if (width_ != 0u)
+        {
+            while ((length < width_) && (string[length] != '\0'))
+            {
+                length++;
+            }
+        }
+        LCD_PrintString(string);
+        Pad(length);
+
+        return *this;
+    }
+
+    Stream &operator<<(char character)
+    {
+        LCD_PutChar(character);
+        Pad(1u);
+
+        return *this;
+    }
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value &&
+                                                  !std::is_same<T, bool>::value, int>::type = 0>
+    Stream &operator<<(T value)
+    {
+        char text[LCD_NUMBER_TEXT_MAX];
+        uint8_t length;
+
+        if (hex_ != 0u)
+        {
+            length = FormatHex(text, (uint32_t) value);
+            Write(&text[LCD_U32_DIGITS - length], length);
+        }
+        else if constexpr (std::is_unsigned<T>::value)
+        {
+            length = LCD_FormatU32(text, (uint32_t) value);
+            Write(&text[LCD_U32_DIGITS - length], length);
+        }
+        else
+        {
+            Write(text, LCD_FormatScaled(text, (int32_t) value, 0u));
+        }
+
+        return *this;
+    }
+
+    template <typename T>
+    Stream &operator<<(Fixed<T> number)
+    {
+        char text[LCD_NUMBER_TEXT_MAX];
+
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            Write(text, LCD_FormatFloat(text, (float) number.value, number.decimals));
+        }
+        else
+        {
+            Write(text, LCD_FormatScaled(text, (int32_t) number.value, number.decimals));
+        }
+
+        return *this;
+    }
+
+    Stream &operator<<(Width manipulator)
+    {
+        width_ = manipulator.cells;
+        return *this;
+    }
+
+    Stream &operator<<(Fill manipulator)
+    {
+        fill_ = manipulator.character;
+        return *this;
+    }
+
+    Stream &operator<<(Base manipulator)
+    {
+        hex_ = manipulator.hex;
+        return *this;
+    }
+
+private:
+
+    uint8_t width_ = 0u;
+    char fill_ = ' ';
+    uint8_t hex_ = 0u;
+
+    /* Number: fill on the left up to the width, then the text as one run */
+    void Write(char const text[], uint8_t length)
+    {
+        uint8_t const pad = (width_ > length) ? (uint8_t) (width_ - length) : 0u;
+        uint8_t index = 0u;
+
+        /* A zero fill goes after the sign, like std::internal */
+        if ((fill_ == '0') && (pad != 0u) && (text[0u] == '-'))
+        {
+            LCD_PutChar('-');
+            index = 1u;
+        }
+        for (uint8_t cell = 0u; cell < pad; cell++)
+        {
+            LCD_PutChar(fill_);
+        }
+        LCD_PrintStringN(&text[index], (size_t) (length - index));
+
+        width_ = 0u;
+    }
+
+    /* Text: fill on the right up to the width */
+    void Pad(uint8_t length)
+    {
+        for (; length < width_; length++)
+        {
+            LCD_PutChar(fill_);
+        }
+
+        width_ = 0u;
+    }
+};
+
+} /* namespace Lcd */
+
+#endif /* INC_LCD_STREAM_HPP_ */
@@ -0,0 +1,165 @@
+/*
+ * LCD_Timing.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_TIMING_H_
+#define INC_LCD_TIMING_H_
+
+#include "LCD_Config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+void LCD_TimingInit(void) ;
+void LCD_TimingClockUpdate(void) ;
+void LCD_TimingMark(uint8_t isLong) ;
+uint8_t LCD_TimingExpired(void) ;
+uint32_t LCD_TimingRemaining(void) ;
+uint8_t LCD_Calibrate(void) ;
+void LCD_SetTimedMode(uint8_t enable) ;
+void LCD_SetElapsedSkip(uint8_t enable) ;
+void LCD_DwtDelayNs(uint32_t ns) ;
+void LCD_DwtDelayUs(uint32_t us) ;
+void LCD_DwtDelayCycles(uint32_t cycles) ;
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Free running Cortex-M3 cycle counter (enabled by LCD_TimingInit) */
+#define LCD_CYCLES()                 (DWT->CYCCNT)
+
+/* Bus timing of LCD_TIMING_PROFILE (data sheet minimums):
+ * LCD_T_AS_NS   RS, R/W setup to E rise
+ * LCD_T_PWEH_NS E high pulse width
+ * LCD_T_DDR_NS  E rise to read data valid
+ * LCD_T_CYCE_NS E cycle time
+ */
+#if (LCD_TIMING_PROFILE == LCD_PROFILE_HD44780_5V)
+    #define LCD_T_AS_NS              (40u)
+    #define LCD_T_PWEH_NS            (230u)
+    #define LCD_T_DDR_NS             (160u)
+    #define LCD_T_CYCE_NS            (500u)
+#elif (LCD_TIMING_PROFILE == LCD_PROFILE_HD44780_3V)
+    #define LCD_T_AS_NS              (60u)
+    #define LCD_T_PWEH_NS            (450u)
+    #define LCD_T_DDR_NS             (360u)
+    #define LCD_T_CYCE_NS            (1000u)
+#elif (LCD_TIMING_PROFILE == LCD_PROFILE_KS0066)
+    #define LCD_T_AS_NS              (60u)
+    #define LCD_T_PWEH_NS            (450u)
+    #define LCD_T_DDR_NS             (360u)
+    #define LCD_T_CYCE_NS            (1200u)
+#elif (LCD_TIMING_PROFILE == LCD_PROFILE_ST7066U)
+    #define LCD_T_AS_NS              (0u)
+    #define LCD_T_PWEH_NS            (140u)
+    #define LCD_T_DDR_NS             (100u)
+    #define LCD_T_CYCE_NS            (1200u)
+#elif (LCD_TIMING_PROFILE == LCD_PROFILE_CUSTOM)
+    #define LCD_T_AS_NS              (LCD_CUSTOM_T_AS_NS)
+    #define LCD_T_PWEH_NS            (LCD_CUSTOM_T_PWEH_NS)
+    #define LCD_T_DDR_NS             (LCD_CUSTOM_T_DDR_NS)
+    #define LCD_T_CYCE_NS            (LCD_CUSTOM_T_CYCE_NS)
+#else
+    #error "LCD_TIMING_PROFILE is not an LCD_PROFILE_ value"
+#endif /* LCD_TIMING_PROFILE */
+
+/* E stays high for the read data as well as the pulse width */
+#define LCD_T_READ_NS                ((LCD_T_DDR_NS > LCD_T_PWEH_NS) ? LCD_T_DDR_NS : LCD_T_PWEH_NS)
+
+/* E low part of the cycle */
+#define LCD_T_RECOVER_NS             (LCD_T_CYCE_NS - LCD_T_PWEH_NS)
+
+#define LCD_T_ADD_US                 (6u)      /* busy flag clear to address counter update */
+
+/* Nanoseconds to whole core cycles, rounded up */
+#define LCD_NS_TO_CYCLES(ns, cyclesPerUs)   ((((ns) * (cyclesPerUs)) + 999u) / 1000u)
+
+/* Bus gaps of one E cycle, cycle counted by the DWT backend */
+#if (LCD_DELAY_BACKEND == LCD_DELAY_DWT)
+    #define LCD_DelaySetup()         LCD_DwtDelayCycles(LCD_busCycles.setup)
+    #define LCD_DelayPulse()         LCD_DwtDelayCycles(LCD_busCycles.pulse)
+    #define LCD_DelayRead()          LCD_DwtDelayCycles(LCD_busCycles.read)
+    #define LCD_DelayRecover()       LCD_DwtDelayCycles(LCD_busCycles.recover)
+#else
+    #define LCD_DelaySetup()         LCD_DelayNs(LCD_T_AS_NS)
+    #define LCD_DelayPulse()         LCD_DelayNs(LCD_T_PWEH_NS)
+    #define LCD_DelayRead()          LCD_DelayNs(LCD_T_READ_NS)
+    #define LCD_DelayRecover()       LCD_DelayNs(LCD_T_RECOVER_NS)
+#endif /* LCD_DELAY_BACKEND == LCD_DELAY_DWT */
+
+/* Placement of the bus hot path: .RamFunc is part of .data in
+ * STM32F103RBTX_FLASH.ld, long_call reaches SRAM from flash
+ */
+#if (LCD_USE_RAM_FUNCTIONS != 0u)
+    #define LCD_RAMFUNC              __attribute__((section(".RamFunc"), noinline, long_call))
+    #define LCD_RAMDATA              __attribute__((section(".data.LCD_ramData")))
+#else
+    #define LCD_RAMFUNC
+    #define LCD_RAMDATA
+#endif /* LCD_USE_RAM_FUNCTIONS != 0u */
+
+/* Delay backend selected by LCD_DELAY_BACKEND */
+#if (LCD_DELAY_BACKEND == LCD_DELAY_DWT)
+    #define LCD_DelayNs(ns)          LCD_DwtDelayNs(ns)
+    #define LCD_DelayUs(us)          LCD_DwtDelayUs(us)
+#elif (LCD_DELAY_BACKEND == LCD_DELAY_CUSTOM)
+    /* Application provides LCD_UserDelayNs() */
+    extern void LCD_UserDelayNs(uint32_t ns);
+    #define LCD_DelayNs(ns)          LCD_UserDelayNs(ns)
+    #define LCD_DelayUs(us)          LCD_UserDelayNs((uint32_t) (us) * 1000u)
+#else
+    /* TIM4 delay_us() in main.c, rounded up to whole microseconds */
+    #define LCD_DelayNs(ns)          delay_us((uint16_t) (((ns) + 999u) / 1000u))
+    #define LCD_DelayUs(us)          delay_us((uint16_t) (us))
+#endif /* LCD_DELAY_BACKEND */
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Bus timing of the profile in core cycles (LCD_TimingInit) */
+typedef struct
+{
+    uint32_t setup;                 /* LCD_T_AS_NS */
+    uint32_t pulse;                 /* LCD_T_PWEH_NS */
+    uint32_t read;                  /* LCD_T_READ_NS */
+    uint32_t recover;               /* LCD_T_RECOVER_NS */
+} LCD_BUS_CYCLES;
+
+/***************************************
+*        Global Variables
+***************************************/
+
+/* Bus timing gaps at the current core clock */
+extern LCD_BUS_CYCLES LCD_busCycles;
+
+/* Core clock cycles per microsecond, set by LCD_TimingInit */
+extern uint32_t LCD_cyclesPerUs;
+
+/* Execution time of short commands/data and of clear/home, in cycles */
+extern uint32_t LCD_execShortCycles;
+extern uint32_t LCD_execLongCycles;
+
+/* LCD_READY_TIMEOUT_US in cycles, the busy poll gives up after it */
+extern uint32_t LCD_readyTimeoutCycles;
+
+/* 1 = open-loop timed writes (set by LCD_Calibrate) */
+extern uint8_t LCD_timedMode;
+
+/* 1 = elapsed busy polls are skipped (LCD_SetElapsedSkip) */
+extern uint8_t LCD_elapsedSkip;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_LCD_TIMING_H_ */
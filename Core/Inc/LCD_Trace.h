@@ -0,0 +1,71 @@
+/*
+ * LCD_Trace.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_TRACE_H_
+#define INC_LCD_TRACE_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* One recorded bus state: DWT timestamp and LCD_TRACE_ pin bits */
+typedef struct
+{
+    uint32_t cycles;
+    uint16_t pins;
+} LCD_TRACE_ENTRY;
+
+/* Sends one character of the dump (ITM, UART, ...) */
+typedef void (*LCD_TracePutChar)(char character);
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_TRACE != 0u)
+    void LCD_TraceStart(void) ;
+    void LCD_TraceStop(void) ;
+    void LCD_TraceClear(void) ;
+    uint16_t LCD_TraceCount(void) ;
+    LCD_TRACE_ENTRY const *LCD_TraceEntry(uint16_t index) ;
+    void LCD_TraceDumpVcd(LCD_TracePutChar putChar) ;
+    void LCD_TraceItmPutChar(char character) ;
+
+    void LCD_TraceEdge(void) ;
+    void LCD_TraceRead(uint32_t idr) ;
+#endif /* LCD_USE_TRACE != 0u */
+
+/***************************************
+*        Instrumentation Macros
+***************************************/
+
+#if (LCD_USE_TRACE != 0u)
+    /* After every pin store or direction change, and every input read */
+    #define LCD_TRACE_EDGE()             LCD_TraceEdge()
+    #define LCD_TRACE_READ(idr)          LCD_TraceRead((uint32_t) (idr))
+#else
+    /* Tracing compiles to nothing */
+    #define LCD_TRACE_EDGE()             ((void) 0)
+    #define LCD_TRACE_READ(idr)          ((void) 0)
+#endif /* LCD_USE_TRACE != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* LCD_TRACE_ENTRY.pins */
+#define LCD_TRACE_RS                 (0x0001u)
+#define LCD_TRACE_RW                 (0x0002u)
+#define LCD_TRACE_E                  (0x0004u)
+#define LCD_TRACE_INPUT              (0x0008u)  /* Data pins are inputs */
+#define LCD_TRACE_SAMPLE             (0x0010u)  /* Input read, DB is the value read */
+#define LCD_TRACE_DB_SHIFT           (8u)       /* DB7-DB0 (DB3-DB0 0 on a 4-bit bus) */
+#define LCD_TRACE_DB(pins)           ((uint8_t) ((pins) >> LCD_TRACE_DB_SHIFT))
+
+#endif /* INC_LCD_TRACE_H_ */
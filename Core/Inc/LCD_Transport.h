@@ -0,0 +1,204 @@
+/*
+ * LCD_Transport.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Bus transport seam of the HD44780 LCD driver.
+ *
+ *  			Everything LCD.c does on the wire goes through the LCD_BUS_...
+ *  			macros below. With LCD_TRANSPORT set to one backend they name
+ *  			its functions directly, so the backend inlines into the API
+ *  			(the GPIO backend is static in LCD.c). With
+ *  			LCD_TRANSPORT_RUNTIME every display handle points at an
+ *  			LCD_Transport table and the macros call through it, so displays
+ *  			on different wirings can share one build.
+ *
+ *  			Interrupts stay enabled on the wire. Every pin level is one
+ *  			BSRR store and every bus timing of the profiles (tAS, PWEH,
+ *  			tDDR, tcycE) is a minimum, so an interrupt anywhere in a strobe
+ *  			sequence only stretches a gap: a long E high or a late second
+ *  			nibble is harmless, and a nibble cannot tear, its data pins and
+ *  			RS are stored (one store per port of the pin map) before E
+ *  			rises and held until after it falls. Atomic are only the
+ *  			read-modify-writes an interrupt could interleave with: the
+ *  			port configuration stores of the bus turnaround (CRL/CRH hold
+ *  			the other pins of the port too) and the hand-offs to the
+ *  			transport interrupts (I2C, SPI, TIM4 of LCD_Async.c).
+ *  			LCD_BUS_ATOMIC_BEGIN() masks them with BASEPRI at
+ *  			LCD_BUS_MASK_PRIORITY, the interrupts above it keep their
+ *  			latency whatever the display does.
+ */
+
+#ifndef INC_LCD_TRANSPORT_H_
+#define INC_LCD_TRANSPORT_H_
+
+#include <stddef.h>
+#include "LCD_Config.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Operations of one wiring. waitReady, readStatus, batchBegin, batchEnd and
+ * readData may be NULL (the backend paces execution times itself, cannot
+ * read the module or has nothing to group).
+ */
+typedef struct
+{
+    void (*start)(void);                                        /* bring-up, from LCD_InitBegin() */
+    void (*writeByte)(uint8_t value, uint8_t rs);               /* rs: 0 = command, 1 = data */
+    void (*writeNibble)(uint8_t nibble);                        /* handshake function set, RS low */
+    void (*writeBuffer)(uint8_t const buffer[], size_t length); /* run of data bytes */
+    void (*waitReady)(void);                                    /* before the next byte */
+    uint8_t (*isReady)(void);                                   /* until idle, 0 = no answer */
+    uint8_t (*readStatus)(void);                                /* busy flag | address counter */
+    void (*batchBegin)(void);                                   /* group writes, nests */
+    void (*batchEnd)(void);
+    uint16_t (*readData)(void);                                 /* DDRAM/CGRAM byte at the counter */
+} LCD_Transport;
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* readStatus() fields; LCD_STATUS_NONE from a wiring that cannot read */
+#define LCD_STATUS_BUSY              (0x80u)
+#define LCD_STATUS_ADDRESS_MASK      (0x7Fu)
+#define LCD_STATUS_NONE              (0xFFu)
+
+/* readData() result of a wiring that cannot read (a byte is 0x00 - 0xFF) */
+#define LCD_READ_NONE                (0x100u)
+
+/* 1 = the parallel bus backend of LCD.c is built */
+#if ((LCD_TRANSPORT == LCD_TRANSPORT_GPIO) || (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME))
+    #define LCD_TRANSPORT_HAS_GPIO   (1u)
+#else
+    #define LCD_TRANSPORT_HAS_GPIO   (0u)
+#endif /* (LCD_TRANSPORT == LCD_TRANSPORT_GPIO) || (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME) */
+
+#if ((LCD_TRANSPORT == LCD_TRANSPORT_I2C) && (LCD_USE_I2C_TRANSPORT == 0u))
+    #error "LCD_TRANSPORT_I2C needs LCD_USE_I2C_TRANSPORT"
+#endif /* (LCD_TRANSPORT == LCD_TRANSPORT_I2C) && (LCD_USE_I2C_TRANSPORT == 0u) */
+
+#if ((LCD_TRANSPORT == LCD_TRANSPORT_SPI) && (LCD_USE_SPI_TRANSPORT == 0u))
+    #error "LCD_TRANSPORT_SPI needs LCD_USE_SPI_TRANSPORT"
+#endif /* (LCD_TRANSPORT == LCD_TRANSPORT_SPI) && (LCD_USE_SPI_TRANSPORT == 0u) */
+
+#if (LCD_BUS_MASK_PRIORITY > 15u)
+    #error "LCD_BUS_MASK_PRIORITY is an NVIC preemption priority, 0 - 15"
+#endif /* LCD_BUS_MASK_PRIORITY > 15u */
+
+/***************************************
+*        Global Variables
+***************************************/
+
+#if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+    /* Backend tables for LCD_SetTransport() */
+    extern const LCD_Transport LCD_transportGpio;
+    #if (LCD_USE_I2C_TRANSPORT != 0u)
+        extern const LCD_Transport LCD_transportI2c;
+    #endif /* LCD_USE_I2C_TRANSPORT != 0u */
+    #if (LCD_USE_SPI_TRANSPORT != 0u)
+        extern const LCD_Transport LCD_transportSpi;
+    #endif /* LCD_USE_SPI_TRANSPORT != 0u */
+#endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+    void LCD_SetTransport(LCD_Transport const *transport) ;
+#endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+
+/***************************************
+*        Bus Operations
+***************************************/
+
+/* The display addressed is LCD_active (LCD_Handle.h) */
+#if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+    #define LCD_BUS_START()              (LCD_active->transport->start())
+    #define LCD_BUS_WRITE_BYTE(v, rs)    (LCD_active->transport->writeByte((v), (rs)))
+    #define LCD_BUS_WRITE_NIBBLE(n)      (LCD_active->transport->writeNibble(n))
+    #define LCD_BUS_WRITE_BUFFER(b, len) (LCD_active->transport->writeBuffer((b), (len)))
+    #define LCD_BUS_IS_READY()           (LCD_active->transport->isReady())
+    #define LCD_BUS_READ_STATUS()        ((LCD_active->transport->readStatus != NULL) ? \
+                                          LCD_active->transport->readStatus() : LCD_STATUS_NONE)
+    #define LCD_BUS_READ_DATA()          ((LCD_active->transport->readData != NULL) ? \
+                                          LCD_active->transport->readData() : LCD_READ_NONE)
+    #define LCD_BUS_OPTIONAL(op)         do { if (LCD_active->transport->op != NULL) \
+                                              { LCD_active->transport->op(); } } while (0)
+    #define LCD_BUS_WAIT_READY()         LCD_BUS_OPTIONAL(waitReady)
+    #define LCD_BUS_BATCH_BEGIN()        LCD_BUS_OPTIONAL(batchBegin)
+    #define LCD_BUS_BATCH_END()          LCD_BUS_OPTIONAL(batchEnd)
+#elif (LCD_TRANSPORT == LCD_TRANSPORT_I2C)
+    #define LCD_BUS_START()              LCD_I2cStart()
+    #define LCD_BUS_WRITE_BYTE(v, rs)    LCD_I2cWriteByte((v), (rs))
+    #define LCD_BUS_WRITE_NIBBLE(n)      LCD_I2cWriteHandshake(n)
+    #define LCD_BUS_WRITE_BUFFER(b, len) LCD_I2cWriteBuffer((b), (len))
+    #define LCD_BUS_IS_READY()           LCD_I2cSync()
+    #define LCD_BUS_READ_STATUS()        (LCD_STATUS_NONE)
+    #define LCD_BUS_READ_DATA()          (LCD_READ_NONE)
+    #define LCD_BUS_WAIT_READY()         do { } while (0)
+    #define LCD_BUS_BATCH_BEGIN()        LCD_I2cBatchBegin()
+    #define LCD_BUS_BATCH_END()          LCD_I2cBatchEnd()
+#elif (LCD_TRANSPORT == LCD_TRANSPORT_SPI)
+    #define LCD_BUS_START()              ((void) LCD_SpiStart())
+    #define LCD_BUS_WRITE_BYTE(v, rs)    LCD_SpiWriteByte((v), (rs))
+    #define LCD_BUS_WRITE_NIBBLE(n)      LCD_SpiWriteHandshake(n)
+    #define LCD_BUS_WRITE_BUFFER(b, len) LCD_SpiWriteBuffer((b), (len))
+    #define LCD_BUS_IS_READY()           LCD_SpiSync()
+    #define LCD_BUS_READ_STATUS()        (LCD_STATUS_NONE)
+    #define LCD_BUS_READ_DATA()          (LCD_READ_NONE)
+    #define LCD_BUS_WAIT_READY()         do { } while (0)
+    #define LCD_BUS_BATCH_BEGIN()        do { } while (0)
+    #define LCD_BUS_BATCH_END()          do { } while (0)
+#else
+    /* Parallel bus, static functions of LCD.c */
+    #define LCD_BUS_START()              LCD_GpioStart()
+    #define LCD_BUS_WRITE_BYTE(v, rs)    LCD_GpioWriteByte((v), (rs))
+    #define LCD_BUS_WRITE_NIBBLE(n)      LCD_GpioWriteNibble(n)
+    #define LCD_BUS_WRITE_BUFFER(b, len) LCD_GpioWriteBuffer((b), (len))
+    #define LCD_BUS_IS_READY()           LCD_GpioIsReady()
+    #if (LCD_GPIO_WRITE_ONLY != 0u)
+        #define LCD_BUS_READ_STATUS()    (LCD_STATUS_NONE)
+        #define LCD_BUS_READ_DATA()      (LCD_READ_NONE)
+    #else
+        #define LCD_BUS_READ_STATUS()    LCD_GpioReadStatus()
+        #define LCD_BUS_READ_DATA()      LCD_GpioReadData()
+    #endif /* LCD_GPIO_WRITE_ONLY != 0u */
+    #define LCD_BUS_WAIT_READY()         LCD_GpioWaitReady()
+    #define LCD_BUS_BATCH_BEGIN()        do { } while (0)
+    #define LCD_BUS_BATCH_END()          do { } while (0)
+#endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+
+/* 1 when the primary display is on the parallel bus: LCD_Async.c and
+ * LCD_Dma.c store its pins through the BSRR themselves, past the seam
+ */
+#if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+    #define LCD_BUS_PRIMARY_IS_GPIO()    (LCD_display0.transport == &LCD_transportGpio)
+#elif (LCD_TRANSPORT == LCD_TRANSPORT_GPIO)
+    #define LCD_BUS_PRIMARY_IS_GPIO()    (1u)
+#else
+    #define LCD_BUS_PRIMARY_IS_GPIO()    (0u)
+#endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+
+/***************************************
+*        Atomic Phases
+***************************************/
+
+/* Holds off the interrupts at LCD_BUS_MASK_PRIORITY and below for a few
+ * stores; nests, BASEPRI is only ever raised. "saved" is a uint32_t of the
+ * caller
+ */
+#if (LCD_BUS_MASK_PRIORITY != 0u)
+    #define LCD_BUS_ATOMIC_BEGIN(saved)  do { (saved) = __get_BASEPRI(); \
+                                              __set_BASEPRI_MAX(LCD_BUS_MASK_PRIORITY << (8u - __NVIC_PRIO_BITS)); } while (0)
+    #define LCD_BUS_ATOMIC_END(saved)    __set_BASEPRI(saved)
+#else
+    #define LCD_BUS_ATOMIC_BEGIN(saved)  do { (saved) = __get_PRIMASK(); __disable_irq(); } while (0)
+    #define LCD_BUS_ATOMIC_END(saved)    __set_PRIMASK(saved)
+#endif /* LCD_BUS_MASK_PRIORITY != 0u */
+
+#endif /* INC_LCD_TRANSPORT_H_ */
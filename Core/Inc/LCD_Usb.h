@@ -0,0 +1,37 @@
+/*
+ * LCD_Usb.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_USB_H_
+#define INC_LCD_USB_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* USB identity: the ST virtual COM port VID/PID, which hosts bind to their
+ * CDC ACM driver without an .inf
+ */
+#define LCD_USB_VID                  (0x0483u)
+#define LCD_USB_PID                  (0x5740u)
+
+/* Bulk OUT packet, also the largest LCD_RemoteFeed() call of the port */
+#define LCD_USB_PACKET               (64u)
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_USB_CDC != 0u)
+    uint8_t LCD_UsbStart(void) ;
+    uint8_t LCD_UsbPoll(void) ;
+    uint8_t LCD_UsbIsConfigured(void) ;
+    void LCD_UsbIRQHandler(void) ;
+#endif /* LCD_USE_USB_CDC != 0u */
+
+#endif /* INC_LCD_USB_H_ */
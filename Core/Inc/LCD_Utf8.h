@@ -0,0 +1,34 @@
+/*
+ * LCD_Utf8.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_UTF8_H_
+#define INC_LCD_UTF8_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_UTF8 != 0u)
+    void LCD_PrintUtf8(char const text[]) ;
+    char LCD_Utf8Code(uint32_t codePoint) ;
+#endif /* LCD_USE_UTF8 != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Printed for code points neither in the ROM nor in the fallback glyphs,
+ * and for malformed sequences
+ */
+#define LCD_UTF8_UNKNOWN             ('?')
+
+/* Characters sent per LCD_PrintStringN() run */
+#define LCD_UTF8_RUN                 (16u)
+
+#endif /* INC_LCD_UTF8_H_ */
@@ -0,0 +1,36 @@
+/*
+ * LCD_Warm.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_WARM_H_
+#define INC_LCD_WARM_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_WARM_START != 0u)
+    uint8_t LCD_WarmStart(void) ;
+    void LCD_WarmMark(uint8_t const pattern[]) ;
+    uint8_t LCD_WarmBits(uint8_t address) ;
+#endif /* LCD_USE_WARM_START != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* CGRAM bits the 5-dot wide glyphs do not show, general purpose RAM */
+#define LCD_WARM_SIGNATURE_MASK      (0xE0u)
+
+/* Busy flag poll interval while a command from before the reset executes */
+#define LCD_WARM_POLL_US             (10u)
+
+/* First CGRAM address of the signature slot */
+#define LCD_WARM_ADDRESS             (LCD_WARM_SLOT * LCD_GLYPH_ROWS)
+
+#endif /* INC_LCD_WARM_H_ */
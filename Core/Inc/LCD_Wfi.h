@@ -0,0 +1,34 @@
+/*
+ * LCD_Wfi.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_WFI_H_
+#define INC_LCD_WFI_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_WFI != 0u)
+    void LCD_WfiStart(void) ;
+    void LCD_WfiWaitCycles(uint32_t cycles) ;
+    void LCD_WfiWaitPoll(void) ;
+    void LCD_WfiIRQHandler(void) ;
+#endif /* LCD_USE_WFI != 0u */
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* TIM4 tick, prescaler set by delay_clock_update() for any core clock */
+#define LCD_WFI_TICKS_PER_US         (LCD_TIM4_TICK_HZ / 1000000u)
+
+/* Longest sleep per compare, well inside the 16-bit TIM4 period */
+#define LCD_WFI_MAX_TICKS            (0x8000u)
+
+#endif /* INC_LCD_WFI_H_ */
@@ -0,0 +1,49 @@
+/*
+ * LCD_Window.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ */
+
+#ifndef INC_LCD_WINDOW_H_
+#define INC_LCD_WINDOW_H_
+
+#include "LCD_Config.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* A rectangle of the screen owned by one module. cells holds rows x columns
+* characters, row by row, and stays valid while the window is open.
+*/
+typedef struct
+{
+    uint8_t *cells;
+    uint8_t row;
+    uint8_t column;
+    uint8_t rows;
+    uint8_t columns;
+    uint8_t z;
+    uint8_t visible;
+    uint8_t cursorRow;
+    uint8_t cursorColumn;
+} LCD_WINDOW;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+#if (LCD_USE_WINDOWS != 0u)
+    uint8_t LCD_WindowOpen(LCD_WINDOW *window, uint8_t cells[], uint8_t row, uint8_t column,
+                           uint8_t rows, uint8_t columns, uint8_t z) ;
+    void LCD_WindowClose(LCD_WINDOW *window) ;
+    void LCD_WindowShow(LCD_WINDOW *window, uint8_t visible) ;
+    void LCD_WindowSetZ(LCD_WINDOW *window, uint8_t z) ;
+    void LCD_WindowPosition(LCD_WINDOW *window, uint8_t row, uint8_t column) ;
+    void LCD_WindowPutChar(LCD_WINDOW *window, char character) ;
+    void LCD_WindowPrint(LCD_WINDOW *window, char const string[]) ;
+    void LCD_WindowClear(LCD_WINDOW *window) ;
+#endif /* LCD_USE_WINDOWS != 0u */
+
+#endif /* INC_LCD_WINDOW_H_ */
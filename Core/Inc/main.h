@@ -63,6 +63,7 @@ void Error_Handler(void);
 
 /* USER CODE BEGIN EFP */
 extern void delay_us(uint16_t delay);
+extern void delay_clock_update(void);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
@@ -36,6 +36,7 @@
  *  				only offers millisecond delay):
  *  				'-> see "extern void delay_us(uint16_t delay);" declaration in main.h
  *  					and implementation in main.c (TIM4 configured in CubeMX)
+ *  				'-> or select LCD_DELAY_DWT in LCD_Config.h (cycle counter, TIM4 not used)
  *  			- External transistor/FET required to drive LCD backlight (LED requires 50 mA)
  *
  * Update 30-Aug-2024:
@@ -51,16 +52,207 @@
  */
 #include "main.h"
 #include "LCD.h"
-
-static void LCD_WrDatNib(uint8_t nibble) ;
-static void LCD_WrCntrlNib(uint8_t nibble) ;
-
-/* Stores state of component. Indicates whether component is or not
-* in enable state.
+#include "LCD_Frame.h"
+#include "LCD_Timing.h"
+#include "LCD_Format.h"
+#include "LCD_Glyph.h"
+#include "LCD_Big.h"
+#include "LCD_Field.h"
+#include "LCD_Geometry.h"
+#include "LCD_Handle.h"
+#include "LCD_Stats.h"
+#include "LCD_Trace.h"
+#include "LCD_Rtos.h"
+#include "LCD_Wfi.h"
+#include "LCD_I2c.h"
+#include "LCD_Spi.h"
+#include "LCD_Transport.h"
+#include "LCD_Detect.h"
+#include "LCD_Warm.h"
+#include "LCD_Boot.h"
+
+/* Boot marker of the first character: a data write of the primary display
+ * into DDRAM (any data write without cursor tracking, which knows the RAM)
+ */
+#if (LCD_USE_CURSOR_TRACKING != 0u)
+    #define LCD_BOOT_GLASS()  \
+        do { if (LCD_IS_PRIMARY() && (LCD_active->cursorDdram != 0u)) { LCD_BOOT_MARK(LCD_BOOT_FIRST_CHAR); } } while (0)
+#else
+    #define LCD_BOOT_GLASS()  \
+        do { if (LCD_IS_PRIMARY()) { LCD_BOOT_MARK(LCD_BOOT_FIRST_CHAR); } } while (0)
+#endif /* LCD_USE_CURSOR_TRACKING != 0u */
+
+static void LCD_SendData(uint8_t dByte) ;
+static void LCD_InitFinish(uint8_t warm) ;
+static void LCD_ModeTrack(uint8_t cByte) ;
+#if (LCD_USE_CURSOR_TRACKING != 0u)
+    static void LCD_CursorStep(uint8_t increment) ;
+    static void LCD_CursorTrack(uint8_t cByte) ;
+    static void LCD_CursorResync(void) ;
+    static void LCD_CursorAdopt(uint8_t address) ;
+
+    /* Address counter read by the last busy poll, LCD_CURSOR_UNKNOWN once a
+     * write followed it (LCD_CursorResync)
+     */
+    static uint8_t LCD_polledAddress = LCD_CURSOR_UNKNOWN;
+#endif /* LCD_USE_CURSOR_TRACKING != 0u */
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    static void LCD_PrintRun(uint8_t const buffer[], size_t length) ;
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        static size_t LCD_CursorRoom(void) ;
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+
+    /* Prints run left to right again after LCD_PrintU32Right() */
+    #define LCD_ENTRY_FORWARD() \
+        do { if (LCD_active->entryReversed != 0u) { LCD_SetEntryDirection(1u); } } while (0)
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+/* Parallel bus backend (LCD_TRANSPORT_GPIO, or a table for run-time binding) */
+#if (LCD_TRANSPORT_HAS_GPIO != 0u)
+    static void LCD_GpioStart(void) ;
+    static void LCD_GpioWriteByte(uint8_t value, uint8_t rs) ;
+    static void LCD_GpioWriteNibble(uint8_t nibble) ;
+    static void LCD_GpioWriteBuffer(uint8_t const buffer[], size_t length) ;
+    static void LCD_GpioWaitReady(void) ;
+    static uint8_t LCD_GpioIsReady(void) ;
+    #if (LCD_GPIO_WRITE_ONLY == 0u)
+        static uint8_t LCD_GpioReadStatus(void) ;
+        static uint16_t LCD_GpioReadData(void) ;
+        static void LCD_GpioBusRead(void) ;
+        static void LCD_GpioBusWrite(void) ;
+        static uint8_t LCD_GpioStatusStrobe(void) ;
+        #if (LCD_USE_PIN_MAP != 0u)
+            static uint16_t LCD_MapRead(void) ;
+        #endif /* LCD_USE_PIN_MAP != 0u */
+    #endif /* LCD_GPIO_WRITE_ONLY == 0u */
+    #if (LCD_BUS_8BIT != 0u)
+        static void LCD_WrByte(uint32_t bsrr, uint8_t rs) ;
+    #else
+        static void LCD_WrDatNib(uint8_t nibble) ;
+        static void LCD_WrCntrlNib(uint8_t nibble) ;
+    #endif /* LCD_BUS_8BIT != 0u */
+#endif /* LCD_TRANSPORT_HAS_GPIO != 0u */
+
+#if ((LCD_BUS_8BIT != 0u) && (LCD_CTRL_ON_DATA_PORT == 0u))
+    #error "LCD_BUS_8BIT requires LCD_CTRL_ON_DATA_PORT (RS and R/nW set in the byte store)"
+#endif /* (LCD_BUS_8BIT != 0u) && (LCD_CTRL_ON_DATA_PORT == 0u) */
+
+#if ((LCD_BUS_8BIT != 0u) && (LCD_USE_LOCKSTEP != 0u))
+    #error "LCD_USE_LOCKSTEP puts the second display on the DB0-DB3 pins of the 8-bit bus"
+#endif /* (LCD_BUS_8BIT != 0u) && (LCD_USE_LOCKSTEP != 0u) */
+
+#if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+    /* Parallel bus operations for LCD_SetTransport() */
+    const LCD_Transport LCD_transportGpio =
+    {
+        LCD_GpioStart, LCD_GpioWriteByte, LCD_GpioWriteNibble, LCD_GpioWriteBuffer,
+        #if (LCD_GPIO_WRITE_ONLY != 0u)
+        LCD_GpioWaitReady, LCD_GpioIsReady, NULL, NULL, NULL, NULL
+        #else
+        LCD_GpioWaitReady, LCD_GpioIsReady, LCD_GpioReadStatus, NULL, NULL, LCD_GpioReadData
+        #endif /* LCD_GPIO_WRITE_ONLY != 0u */
+    };
+#endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+
+/* State of the display on E_Pin: enable state, init sequence, timing, the
+* mirror of the DDRAM address counter (LCD_CURSOR_UNKNOWN when it cannot be
+* known: init, CGRAM access, transports bypassing LCD.c) and of the mode
+* registers (LCD_PM.c)
 */
-uint8_t LCD_enableState = 0u;
-
-uint8_t LCD_initVar = 0u;
+LCD_Handle LCD_display0 =
+{
+    E_GPIO_Port, LCD_PIN_BITS(E_Pin),
+    0u, 0u, LCD_INIT_STEP_IDLE, 0u,
+    0u, 0u,
+    LCD_CURSOR_UNKNOWN, 1u, 0u, LCD_CURSOR_UNKNOWN,
+    LCD_FUNCTION_SET_POR, LCD_ENTRY_MODE_POR, LCD_DISPLAY_CONTROL_POR, 0u,
+    { LCD_FUNCTION_SET_POR, LCD_ENTRY_MODE_POR, LCD_DISPLAY_CONTROL_POR, 0u },
+    LCD_LINK_UP, 0u, 0u,
+    LCD_GEOMETRY_DEFAULT
+#if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+    , &LCD_transportGpio
+#endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+};
+
+/* BSRR set/reset word for each (RS, nibble) pair, generated at compile time
+* from LCD_STM32_NIBBLE_SHIFT and LCD_STM32_NIBBLE_MASK. With
+* LCD_CTRL_ON_DATA_PORT set the word also drives RS and resets R/nW.
+*/
+#if (LCD_CTRL_ON_DATA_PORT != 0u)
+    #define LCD_BSRR_CTRL(rs)        ((((rs) != 0u) ? LCD_BSRR_SET(LCD_PIN_BITS(RS_Pin)) : \
+                                                      LCD_BSRR_RESET(LCD_PIN_BITS(RS_Pin))) | \
+                                      LCD_BSRR_RESET(LCD_PIN_BITS(RnW_Pin)))
+#else
+    #define LCD_BSRR_CTRL(rs)        (0u)
+#endif /* LCD_CTRL_ON_DATA_PORT != 0u */
+
+#if (LCD_USE_LOCKSTEP != 0u)
+    /* Both displays of the lockstep pair get every command and byte */
+    #define LCD_BSRR_ENTRY(rs, n)    (LCD_NIBBLE_BSRR(n) | LCD_LOW_NIBBLE_BSRR(n) | LCD_BSRR_CTRL(rs))
+#else
+    #define LCD_BSRR_ENTRY(rs, n)    (LCD_NIBBLE_BSRR(n) | LCD_BSRR_CTRL(rs))
+#endif /* LCD_USE_LOCKSTEP != 0u */
+#define LCD_BSRR_ROW(rs)             { LCD_BSRR_ENTRY(rs, 0u),  LCD_BSRR_ENTRY(rs, 1u),  \
+                                       LCD_BSRR_ENTRY(rs, 2u),  LCD_BSRR_ENTRY(rs, 3u),  \
+                                       LCD_BSRR_ENTRY(rs, 4u),  LCD_BSRR_ENTRY(rs, 5u),  \
+                                       LCD_BSRR_ENTRY(rs, 6u),  LCD_BSRR_ENTRY(rs, 7u),  \
+                                       LCD_BSRR_ENTRY(rs, 8u),  LCD_BSRR_ENTRY(rs, 9u),  \
+                                       LCD_BSRR_ENTRY(rs, 10u), LCD_BSRR_ENTRY(rs, 11u), \
+                                       LCD_BSRR_ENTRY(rs, 12u), LCD_BSRR_ENTRY(rs, 13u), \
+                                       LCD_BSRR_ENTRY(rs, 14u), LCD_BSRR_ENTRY(rs, 15u) }
+
+const uint32_t LCD_nibbleBsrr[2u][16u] LCD_RAMDATA = { LCD_BSRR_ROW(0u), LCD_BSRR_ROW(1u) };
+
+#if (LCD_USE_PIN_MAP != 0u)
+    /* The same per port of the scattered pin map: a nibble is one store on
+    * each port with mapped pins, RS and R/nW always included
+    */
+    #define LCD_MAP_ROW(p, rs)       { LCD_MAP_BSRR(p, rs, 0u),  LCD_MAP_BSRR(p, rs, 1u),  \
+                                       LCD_MAP_BSRR(p, rs, 2u),  LCD_MAP_BSRR(p, rs, 3u),  \
+                                       LCD_MAP_BSRR(p, rs, 4u),  LCD_MAP_BSRR(p, rs, 5u),  \
+                                       LCD_MAP_BSRR(p, rs, 6u),  LCD_MAP_BSRR(p, rs, 7u),  \
+                                       LCD_MAP_BSRR(p, rs, 8u),  LCD_MAP_BSRR(p, rs, 9u),  \
+                                       LCD_MAP_BSRR(p, rs, 10u), LCD_MAP_BSRR(p, rs, 11u), \
+                                       LCD_MAP_BSRR(p, rs, 12u), LCD_MAP_BSRR(p, rs, 13u), \
+                                       LCD_MAP_BSRR(p, rs, 14u), LCD_MAP_BSRR(p, rs, 15u) }
+
+    const uint32_t LCD_mapBsrr[2u][2u][16u] LCD_RAMDATA =
+    {
+        { LCD_MAP_ROW(0u, 0u), LCD_MAP_ROW(0u, 1u) },
+        { LCD_MAP_ROW(1u, 0u), LCD_MAP_ROW(1u, 1u) }
+    };
+#endif /* LCD_USE_PIN_MAP != 0u */
+
+#if (LCD_BUS_8BIT != 0u)
+    /* DB0-DB3 BSRR words, OR-ed with LCD_nibbleBsrr for a whole byte */
+    static const uint32_t LCD_lowNibbleBsrr[16u] =
+    {
+        LCD_LOW_NIBBLE_BSRR(0u),  LCD_LOW_NIBBLE_BSRR(1u),  LCD_LOW_NIBBLE_BSRR(2u),  LCD_LOW_NIBBLE_BSRR(3u),
+        LCD_LOW_NIBBLE_BSRR(4u),  LCD_LOW_NIBBLE_BSRR(5u),  LCD_LOW_NIBBLE_BSRR(6u),  LCD_LOW_NIBBLE_BSRR(7u),
+        LCD_LOW_NIBBLE_BSRR(8u),  LCD_LOW_NIBBLE_BSRR(9u),  LCD_LOW_NIBBLE_BSRR(10u), LCD_LOW_NIBBLE_BSRR(11u),
+        LCD_LOW_NIBBLE_BSRR(12u), LCD_LOW_NIBBLE_BSRR(13u), LCD_LOW_NIBBLE_BSRR(14u), LCD_LOW_NIBBLE_BSRR(15u)
+    };
+
+    #define LCD_BYTE_BSRR(rs, byte)  (LCD_nibbleBsrr[(rs)][(uint8_t) (byte) >> LCD_NIBBLE_SHIFT] | \
+                                      LCD_lowNibbleBsrr[(byte) & LCD_NIBBLE_MASK])
+#endif /* LCD_BUS_8BIT != 0u */
+
+#if (LCD_TRANSPORT_HAS_GPIO != 0u)
+    /* RS of the last write strobe, R/nW low since; LCD_BUS_UNKNOWN after a read
+    * or LCD_BusInvalidate(). Writes spend tAS (and the separate RS and R/nW
+    * stores) only when RS or R/nW change.
+    */
+    #define LCD_BUS_UNKNOWN          (0xFFu)
+    static uint8_t LCD_busRs = LCD_BUS_UNKNOWN;
+
+    /* Lockstep pair: busy while either module is, their counters move together */
+    #if (LCD_USE_LOCKSTEP != 0u)
+        #define LCD_LOCKSTEP_FOLD(value) ((value) |= (uint16_t) (((value) & LCD_STM32_LOW_NIBBLE_MASK) >> \
+                                          (LCD_STM32_LOW_NIBBLE_SHIFT - LCD_STM32_NIBBLE_SHIFT)))
+    #else
+        #define LCD_LOCKSTEP_FOLD(value) ((void) 0)
+    #endif /* LCD_USE_LOCKSTEP != 0u */
+#endif /* LCD_TRANSPORT_HAS_GPIO != 0u */
 
 /*******************************************************************************
 * Function Name: LCD_Init
@@ -84,32 +276,306 @@ uint8_t LCD_initVar = 0u;
 * Reentrant:
 *  No.
 *
+* Note:
+*  Blocking wrapper around LCD_InitBegin()/LCD_InitPoll(). If LCD_InitBegin()
+*  was already called the sequence in progress is completed.
+*
 *******************************************************************************/
 void LCD_Init(void)
 {
-    /* INIT CODE */
-    HAL_Delay(40);                             /* Delay 40 ms */
-    LCD_WrCntrlNib(LCD_DISPLAY_8_BIT_INIT);    /* Selects 8-bit mode */
-    HAL_Delay(5u);                             /* Delay 5 ms */
-    LCD_WrCntrlNib(LCD_DISPLAY_8_BIT_INIT);    /* Selects 8-bit mode */
-    HAL_Delay(15u);                            /* Delay 15 ms */
-    LCD_WrCntrlNib(LCD_DISPLAY_8_BIT_INIT);    /* Selects 8-bit mode */
-    HAL_Delay(1u);                             /* Delay 1 ms */
-    LCD_WrCntrlNib(LCD_DISPLAY_4_BIT_INIT);    /* Selects 4-bit mode */
-    HAL_Delay(5u);                             /* Delay 5 ms */
-
-    LCD_WriteControl(LCD_CURSOR_AUTO_INCR_ON);    /* Incr Cursor After Writes */
-    LCD_WriteControl(LCD_DISPLAY_CURSOR_ON);      /* Turn Display, Cursor ON */
-    LCD_WriteControl(LCD_DISPLAY_2_LINES_5x10);   /* 2 Lines by 5x10 Characters */
-    LCD_WriteControl(LCD_DISPLAY_CURSOR_OFF);     /* Turn Display, Cursor OFF */
-    LCD_WriteControl(LCD_CLEAR_DISPLAY);          /* Clear LCD Screen */
-    LCD_WriteControl(LCD_DISPLAY_ON_CURSOR_OFF);  /* Turn Display ON, Cursor OFF */
-    LCD_WriteControl(LCD_RESET_CURSOR_POSITION);  /* Set Cursor to 0,0 */
-    HAL_Delay(5u);
+    if (LCD_active->initStep == LCD_INIT_STEP_IDLE)
+    {
+        LCD_InitBegin();
+    }
+
+    while (LCD_InitPoll() == 0u)
+    {
+        #if (LCD_USE_WFI != 0u)
+            LCD_WfiWaitPoll();
+        #endif /* LCD_USE_WFI != 0u */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_InitBegin
+********************************************************************************
+*
+* Summary:
+*  Starts the non-blocking initialization sequence. The power-on, 8-bit/4-bit
+*  handshake and command steps are then advanced by LCD_InitPoll() against
+*  SysTick deadlines, so the rest of the application bring-up runs during the
+*  waits instead of in HAL_Delay().
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+* Note:
+*  With LCD_USE_WARM_START a module still configured from before an MCU
+*  reset is initialized here already, LCD_InitPoll() then returns 1.
+*
+*******************************************************************************/
+void LCD_InitBegin(void)
+{
+    LCD_TimingInit();
+    LCD_CursorInvalidate();
+    #if (LCD_USE_WFI != 0u)
+        LCD_WfiStart();
+    #endif /* LCD_USE_WFI != 0u */
+    LCD_BUS_START();
+
+    if (LCD_IS_PRIMARY())
+    {
+        /* Glyph cache and bargraphs describe the display on E_Pin */
+        #if (LCD_USE_GLYPH_CACHE != 0u)
+            LCD_GlyphReset();
+        #endif /* LCD_USE_GLYPH_CACHE != 0u */
+        LCD_BarInvalidate();
+        #if (LCD_USE_BIG_DIGITS != 0u)
+            LCD_BigInvalidate();
+        #endif /* LCD_USE_BIG_DIGITS != 0u */
+        #if (LCD_USE_FIELDS != 0u)
+            LCD_FieldInvalidate();
+        #endif /* LCD_USE_FIELDS != 0u */
+
+        #if (LCD_USE_FRAMEBUFFER != 0u)
+            LCD_FrameInit();
+        #endif /* LCD_USE_FRAMEBUFFER != 0u */
+    }
+
+    /* Power-on wait counts from MCU reset (HAL tick 0) */
+    LCD_active->initTick = 0u;
+    LCD_active->initStep = 0u;
+
+    /* A fresh initialization gives an unresponsive display another chance */
+    LCD_active->linkState = LCD_LINK_UP;
+    LCD_active->recoverStep = 0u;
+
+    #if (LCD_USE_WARM_START != 0u)
+        if (LCD_WarmStart() != 0u)
+        {
+            /* Still configured from before the MCU reset: no waits, no handshake */
+            LCD_InitFinish(1u);
+            return;
+        }
+    #endif /* LCD_USE_WARM_START != 0u */
+
+    #if (LCD_USE_DETECT != 0u)
+        /* Until the bus probe of LCD_InitPoll() finds a controller */
+        LCD_active->linkState = LCD_LINK_ABSENT;
+    #endif /* LCD_USE_DETECT != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_InitPoll
+********************************************************************************
+*
+* Summary:
+*  Advances the initialization sequence by at most one step. Never waits for
+*  more than one busy poll.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 when the module is initialized, 0 while steps are pending.
+*
+*******************************************************************************/
+uint8_t LCD_InitPoll(void)
+{
+    static const uint8_t LCD_initNibbles[LCD_INIT_NIBBLE_STEPS] =
+    {
+        LCD_DISPLAY_8_BIT_INIT,     /* Selects 8-bit mode */
+        LCD_DISPLAY_8_BIT_INIT,     /* Selects 8-bit mode */
+        LCD_DISPLAY_8_BIT_INIT,     /* Selects 8-bit mode */
+    #if (LCD_BUS_8BIT != 0u)
+        LCD_DISPLAY_8_BIT_INIT      /* Stays in 8-bit mode */
+    #else
+        LCD_DISPLAY_4_BIT_INIT      /* Selects 4-bit mode */
+    #endif /* LCD_BUS_8BIT != 0u */
+    };
+
+    /* Wait before each nibble step, and after the last one (ms) */
+    static const uint8_t LCD_initWaits[LCD_INIT_NIBBLE_STEPS + 1u] = { 40u, 5u, 15u, 1u, 5u };
+
+    static const uint8_t LCD_initCommands[LCD_INIT_COMMAND_STEPS] =
+    {
+        LCD_CURSOR_AUTO_INCR_ON,    /* Incr Cursor After Writes */
+        LCD_DISPLAY_CURSOR_ON,      /* Turn Display, Cursor ON */
+        LCD_FUNCTION_SET,           /* 2 Lines by 5x10 Characters */
+        LCD_DISPLAY_CURSOR_OFF,     /* Turn Display, Cursor OFF */
+        LCD_CLEAR_DISPLAY,          /* Clear LCD Screen */
+        LCD_DISPLAY_ON_CURSOR_OFF,  /* Turn Display ON, Cursor OFF */
+        LCD_RESET_CURSOR_POSITION   /* Set Cursor to 0,0 */
+    };
+
+    uint8_t step = LCD_active->initStep;
+
+    if (step == LCD_INIT_STEP_DONE)
+    {
+        return 1u;
+    }
+
+    if (step == LCD_INIT_STEP_IDLE)
+    {
+        return 0u;
+    }
+
+    #if (LCD_USE_DETECT != 0u)
+        if (LCD_active->linkState == LCD_LINK_ABSENT)
+        {
+            if (LCD_DetectBus() != 0u)
+            {
+                /* A controller drives the bus, the power-on wait goes on */
+                LCD_active->linkState = LCD_LINK_UP;
+            }
+            else if (HAL_GetTick() > LCD_DETECT_POWER_MS)
+            {
+                /* Nobody answered since reset: no handshake, no commands */
+                LCD_active->initStep = LCD_INIT_STEP_DONE;
+                return 1u;
+            }
+            else
+            {
+                return 0u;
+            }
+        }
+    #endif /* LCD_USE_DETECT != 0u */
+
+    if (step <= LCD_INIT_NIBBLE_STEPS)
+    {
+        /* Handshake nibbles, and the wait after the last one (same as HAL_Delay) */
+        if ((HAL_GetTick() - LCD_active->initTick) <= LCD_initWaits[step])
+        {
+            return 0u;
+        }
+
+        if (step < LCD_INIT_NIBBLE_STEPS)
+        {
+            LCD_WriteHandshake(LCD_initNibbles[step]);
+            LCD_active->initTick = HAL_GetTick();
+        }
+    }
+    else if (step <= (LCD_INIT_NIBBLE_STEPS + LCD_INIT_COMMAND_STEPS))
+    {
+        /* Commands, each one only once the previous one executed */
+        if (LCD_TimingExpired() == 0u)
+        {
+            return 0u;
+        }
+
+        LCD_WriteControl(LCD_initCommands[step - LCD_INIT_NIBBLE_STEPS - 1u]);
+        LCD_active->initTick = HAL_GetTick();
+    }
+    else
+    {
+        /* Final 5 ms settle after the command sequence */
+        if ((HAL_GetTick() - LCD_active->initTick) <= LCD_INIT_SETTLE_MS)
+        {
+            return 0u;
+        }
+
+        #if (LCD_USE_DETECT != 0u)
+            /* DDRAM read-back: a dead controller ends here, before the fonts */
+            if (LCD_DetectGeometry() == 0u)
+            {
+                LCD_active->initStep = LCD_INIT_STEP_DONE;
+                return 1u;
+            }
+        #endif /* LCD_USE_DETECT != 0u */
+
+        LCD_InitFinish(0u);
+        return 1u;
+    }
+
+    LCD_active->initStep = step + 1u;
+    return 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_InitFinish
+********************************************************************************
+*
+* Summary:
+*  Last step of the initialization: custom fonts, the warm start signature
+*  and the screen from before a reset.
+*
+* Parameters:
+*  warm: 1 when LCD_WarmStart() found the module still configured, the
+*        glass then still shows the screen from before the reset
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static void LCD_InitFinish(uint8_t warm)
+{
+    (void) warm;
 
     #if(LCD_CUSTOM_CHAR_SET != LCD_NONE)
         LCD_LoadCustomFonts(LCD_customFonts);
     #endif /* LCD_CUSTOM_CHAR_SET != LCD_NONE */
+
+    #if (LCD_USE_WARM_START != 0u)
+        if (LCD_IS_PRIMARY() && ((LCD_cgramWritten & (1u << LCD_WARM_SLOT)) == 0u))
+        {
+            /* Signature for the next warm start, the slot keeps its glyph */
+            LCD_WriteControl(LCD_CGRAM_0 | LCD_WARM_ADDRESS);
+            LCD_WarmMark(&LCD_cgramShadow[LCD_WARM_ADDRESS]);
+            LCD_WriteControl(LCD_DDRAM_0);
+        }
+    #endif /* LCD_USE_WARM_START != 0u */
+
+    LCD_active->initStep = LCD_INIT_STEP_DONE;
+    LCD_active->initVar = 1u;
+
+    if (LCD_IS_PRIMARY())
+    {
+        LCD_BOOT_MARK(LCD_BOOT_LCD_READY);
+    }
+
+    #if (LCD_USE_FRAME_SNAPSHOT != 0u)
+        /* Screen from before a warm reset, back in one flush */
+        if (LCD_IS_PRIMARY() && (LCD_FrameRestore() != 0u))
+        {
+            if (warm != 0u)
+            {
+                /* DDRAM kept it, nothing to send */
+                LCD_FrameAdopt();
+            }
+            else
+            {
+                LCD_FlushFrame();
+            }
+        }
+    #endif /* LCD_USE_FRAME_SNAPSHOT != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WriteHandshake
+********************************************************************************
+*
+* Summary:
+*  Writes one function set of the interface handshake (upper nibble only,
+*  a single E strobe on either bus width). The busy flag cannot be read yet,
+*  the caller waits the datasheet time after each one.
+*
+* Parameters:
+*  nibble: LCD_DISPLAY_8_BIT_INIT or LCD_DISPLAY_4_BIT_INIT
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WriteHandshake(uint8_t nibble)
+{
+    LCD_BUS_WRITE_NIBBLE(nibble);
 }
 
 
@@ -137,7 +603,7 @@ void LCD_Init(void)
 void LCD_Enable(void)
 {
     LCD_DisplayOn();
-    LCD_enableState = 1u;
+    LCD_active->enableState = 1u;
 }
 
 /*******************************************************************************
@@ -157,421 +623,1952 @@ void LCD_Enable(void)
 *
 *
 * Parameters:
-*  LCD_initVar - global variable.
+*  initVar of the display state (LCD_Handle.h).
 *
 * Return:
-*  LCD_initVar - global variable.
+*  initVar of the display state (LCD_Handle.h).
+*
+* Reentrant:
+*  No.
+*
+*******************************************************************************/
+void LCD_Start(void)
+{
+    /* If not initialized, perform initialization */
+    if(LCD_active->initVar == 0u)
+    {
+        LCD_Init();
+        LCD_active->initVar = 1u;
+    }
+
+    /* Turn on the LCD */
+    LCD_Enable();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_Stop
+********************************************************************************
+*
+* Summary:
+*  Turns off the display of the LCD screen. DDRAM, CGRAM and the modes are
+*  kept by the controller.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_Stop(void)
+{
+    LCD_DisplayOff();
+    LCD_active->enableState = 0u;
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_WriteData
+********************************************************************************
+*
+* Summary:
+*  Writes a data byte to the LCD module's Data Display RAM.
+*
+* Parameters:
+*  dByte: Byte to be written to the LCD module
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WriteData(uint8_t dByte)
+{
+    LCD_BUS_WAIT_READY();
+//    delay_us(100);
+
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        LCD_CursorResync();
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+
+    LCD_SendData(dByte);
+    LCD_BOOT_GLASS();
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_WriteBuffer
+********************************************************************************
+*
+* Summary:
+*  Writes a run of data bytes to DDRAM (or CGRAM) at the current address as
+*  one bulk write of the transport. On the parallel bus the data pins stay
+*  outputs for the whole run: bytes are spaced by the data execution time on
+*  the cycle counter and the busy flag is checked at most once, after the
+*  last byte.
+*
+* Parameters:
+*  buffer: Bytes to be written to the LCD module
+*  length: Number of bytes
+*
+* Return:
+*  None.
+*
+* Note:
+*  Bypasses the framebuffer. The spacing is LCD_EXEC_SHORT_US, or the value
+*  measured by LCD_Calibrate().
+*
+*******************************************************************************/
+void LCD_WriteBuffer(uint8_t const buffer[], size_t length)
+{
+    size_t index;
+    uint8_t up;
+
+    if (length == 0u)
+    {
+        return;
+    }
+
+    up = (LCD_active->linkState == LCD_LINK_UP) ? 1u : 0u;
+    if (up != 0u)
+    {
+        LCD_BUS_WRITE_BUFFER(buffer, length);
+        LCD_BOOT_GLASS();
+    }
+    else
+    {
+        /* Unresponsive: one probe instead of the run */
+        LCD_BUS_WAIT_READY();
+    }
+    LCD_TimingMark(0u);
+
+    for (index = 0u; index < length; index++)
+    {
+        LCD_STAT_INC(bytesWritten);
+        if (up == 0u)
+        {
+            LCD_STAT_INC(writesDropped);
+        }
+        #if (LCD_USE_CURSOR_TRACKING != 0u)
+            LCD_CursorStep(LCD_active->cursorIncrement);
+        #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+    }
+
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        /* The read-back after the last byte, if any, checks the stepped mirror */
+        LCD_CursorResync();
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_SendData
+********************************************************************************
+*
+* Summary:
+*  Puts one data byte on the bus without waiting for the module.
+*
+* Parameters:
+*  dByte: Byte to be written to the LCD module
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static void LCD_SendData(uint8_t dByte)
+{
+    if (LCD_active->linkState == LCD_LINK_UP)
+    {
+        LCD_BUS_WRITE_BYTE(dByte, 1u);
+    }
+    else
+    {
+        LCD_STAT_INC(writesDropped);
+    }
+
+    LCD_TimingMark(0u);
+    LCD_STAT_INC(bytesWritten);
+
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        LCD_CursorStep(LCD_active->cursorIncrement);
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_WriteControl
+********************************************************************************
+*
+* Summary:
+*  Writes a command byte to the LCD module.
+*
+* Parameters:
+*  cByte:  The byte to be written to theLCD module
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WriteControl(uint8_t cByte)
+{
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        /* Set-DDRAM-address to where the cursor already is */
+        if ((LCD_active->cursorAddress != LCD_CURSOR_UNKNOWN) &&
+            (cByte == (LCD_DDRAM_0 | LCD_active->cursorAddress)))
+        {
+            LCD_STAT_INC(commandsElided);
+            return;
+        }
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+
+    LCD_BUS_WAIT_READY();
+//    delay_us(100);
+
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        LCD_CursorResync();
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+
+    /* Unresponsive: the mirrors below still follow, recovery replays them */
+    if (LCD_active->linkState == LCD_LINK_UP)
+    {
+        LCD_BUS_WRITE_BYTE(cByte, 0u);
+    }
+    else
+    {
+        LCD_STAT_INC(writesDropped);
+    }
+
+    LCD_TimingMark(LCD_IS_LONG_CMD(cByte) ? 1u : 0u);
+    LCD_STAT_INC(commandsSent);
+
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        LCD_CursorTrack(cByte);
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+    LCD_ModeTrack(cByte);
+
+    if ((cByte == LCD_CLEAR_DISPLAY) && LCD_IS_PRIMARY())
+    {
+        #if (LCD_USE_FRAMEBUFFER != 0u)
+            /* Keep the framebuffer in step with the blanked DDRAM */
+            LCD_FrameGlassCleared();
+        #endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+        /* Bargraphs are gone, redraw them in full */
+        LCD_BarInvalidate();
+        #if (LCD_USE_BIG_DIGITS != 0u)
+            LCD_BigInvalidate();
+        #endif /* LCD_USE_BIG_DIGITS != 0u */
+        #if (LCD_USE_FIELDS != 0u)
+            LCD_FieldInvalidate();
+        #endif /* LCD_USE_FIELDS != 0u */
+    }
+}
+
+
+
+/*******************************************************************************
+*  Function Name: LCD_ModeTrack
+********************************************************************************
+*
+* Summary:
+*  Mirrors function set, entry mode and display control commands into the
+*  display state, so LCD_SaveConfig()/LCD_Wakeup() know what the controller
+*  holds without reading it back.
+*
+* Parameters:
+*  cByte:  The command byte written to the LCD module
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static void LCD_ModeTrack(uint8_t cByte)
+{
+    if ((cByte & LCD_FUNCTION_SET_MASK) == LCD_FUNCTION_SET_CMD)
+    {
+        LCD_active->functionSet = cByte;
+    }
+    else if ((cByte & LCD_DISPLAY_CONTROL_MASK) == LCD_DISPLAY_CONTROL_CMD)
+    {
+        LCD_active->displayControl = cByte;
+    }
+    else if ((cByte & LCD_ENTRY_MODE_MASK) == LCD_ENTRY_MODE_SET)
+    {
+        LCD_active->entryMode = cByte;
+        LCD_active->entryReversed = 0u;
+    }
+    else if (cByte == LCD_CLEAR_DISPLAY)
+    {
+        /* Clear also selects increment mode */
+        LCD_active->entryMode |= LCD_ENTRY_INCREMENT;
+        LCD_active->entryReversed = 0u;
+    }
+    else
+    {
+        /* Addresses, shifts and return home are not mode registers */
+    }
+}
+
+
+#if (LCD_USE_CURSOR_TRACKING != 0u)
+/*******************************************************************************
+*  Function Name: LCD_CursorTrack
+********************************************************************************
+*
+* Summary:
+*  Updates the address counter mirror for a command just written.
+*
+* Parameters:
+*  cByte:  The command byte written to the LCD module
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static void LCD_CursorTrack(uint8_t cByte)
+{
+    if ((cByte & LCD_DDRAM_0) != 0u)
+    {
+        LCD_active->cursorAddress = cByte & LCD_DDRAM_ADDRESS_MASK;
+        LCD_active->cursorDdram = 1u;
+        LCD_active->wrapAddress = LCD_CURSOR_UNKNOWN;
+    }
+    else if ((cByte & LCD_CGRAM_MASK) == LCD_CGRAM_0)
+    {
+        /* Address counter now points into CGRAM */
+        LCD_active->cursorAddress = LCD_CURSOR_UNKNOWN;
+        LCD_active->cursorDdram = 0u;
+    }
+    else if (cByte == LCD_CLEAR_DISPLAY)
+    {
+        /* Clear also selects increment mode */
+        LCD_active->cursorAddress = 0u;
+        LCD_active->cursorIncrement = 1u;
+        LCD_active->cursorDdram = 1u;
+    }
+    else if (LCD_IS_LONG_CMD(cByte))
+    {
+        /* Return home */
+        LCD_active->cursorAddress = 0u;
+        LCD_active->cursorDdram = 1u;
+    }
+    else if ((cByte & LCD_ENTRY_MODE_MASK) == LCD_ENTRY_MODE_SET)
+    {
+        LCD_active->cursorIncrement = ((cByte & LCD_ENTRY_INCREMENT) != 0u) ? 1u : 0u;
+    }
+    else if (((cByte & LCD_SHIFT_MASK) == LCD_SHIFT_CMD) && ((cByte & LCD_SHIFT_DISPLAY) == 0u))
+    {
+        /* Cursor move, display shifts leave the address counter alone */
+        LCD_CursorStep(((cByte & LCD_SHIFT_RIGHT) != 0u) ? 1u : 0u);
+    }
+    else
+    {
+        /* Display control and function set do not move the cursor */
+    }
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_CursorStep
+********************************************************************************
+*
+* Summary:
+*  Moves the address counter mirror by one, wrapping the way the module does
+*  in 2-line mode (0x27 -> 0x40, 0x67 -> 0x00).
+*
+* Parameters:
+*  increment:  1 to move right, 0 to move left
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static void LCD_CursorStep(uint8_t increment)
+{
+    uint8_t address = LCD_active->cursorAddress;
+
+    if (address == LCD_CURSOR_UNKNOWN)
+    {
+        return;
+    }
+
+    if (increment != 0u)
+    {
+        address++;
+        if (address == LCD_DDRAM_LINE_LENGTH)
+        {
+            address = LCD_DDRAM_LINE_1;
+        }
+        else if (address == (LCD_DDRAM_LINE_1 + LCD_DDRAM_LINE_LENGTH))
+        {
+            address = 0u;
+        }
+        else
+        {
+            /* Same line */
+        }
+    }
+    else
+    {
+        if (address == 0u)
+        {
+            address = LCD_DDRAM_LINE_1 + LCD_DDRAM_LINE_LENGTH - 1u;
+        }
+        else if (address == LCD_DDRAM_LINE_1)
+        {
+            address = LCD_DDRAM_LINE_LENGTH - 1u;
+        }
+        else
+        {
+            address--;
+        }
+    }
+
+    LCD_active->cursorAddress = address;
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_CursorResync
+********************************************************************************
+*
+* Summary:
+*  Checks the address counter mirror against the address the last busy poll
+*  read along with the busy flag (no extra bus cycle). A mismatch is
+*  confirmed with one more status read after tADD, since the poll that saw
+*  the flag clear can precede the counter update, before it is adopted.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static void LCD_CursorResync(void)
+{
+    uint8_t address = LCD_polledAddress;
+    uint8_t status;
+
+    LCD_polledAddress = LCD_CURSOR_UNKNOWN;
+
+    if ((address == LCD_CURSOR_UNKNOWN) || (LCD_active->cursorDdram == 0u) ||
+        (address == LCD_active->cursorAddress))
+    {
+        return;
+    }
+
+    LCD_DelayUs(LCD_T_ADD_US);
+    status = LCD_BUS_READ_STATUS();
+
+    if ((status != LCD_STATUS_NONE) && ((status & LCD_STATUS_BUSY) == 0u))
+    {
+        LCD_CursorAdopt(status & LCD_STATUS_ADDRESS_MASK);
+    }
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_CursorAdopt
+********************************************************************************
+*
+* Summary:
+*  Takes an address counter value read from the module as the mirror, while
+*  it is known to address DDRAM. A known mirror that was wrong means writes
+*  bypassed the driver (or a glitch), so the framebuffer is invalidated too.
+*
+* Parameters:
+*  address: AC6-AC0 read from the module
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static void LCD_CursorAdopt(uint8_t address)
+{
+    if ((LCD_active->cursorDdram == 0u) || (address == LCD_active->cursorAddress))
+    {
+        return;
+    }
+
+    if (LCD_active->cursorAddress != LCD_CURSOR_UNKNOWN)
+    {
+        LCD_STAT_INC(cursorResyncs);
+        #if (LCD_USE_FRAMEBUFFER != 0u)
+            LCD_FrameInvalidate();
+        #endif /* LCD_USE_FRAMEBUFFER != 0u */
+    }
+
+    LCD_active->cursorAddress = address;
+}
+
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+/*******************************************************************************
+*  Function Name: LCD_CursorRoom
+********************************************************************************
+*
+* Summary:
+*  Returns how many characters fit from the cursor to the end of its visible
+*  run of the geometry. A cursor just past a run (or at the address a print
+*  that filled the run left it at) is first moved to the start of the next
+*  run in reading order.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Cells left in the run, 0 past the last row (clip), LCD_ROOM_UNBOUNDED when
+*  the cursor is unknown, moves left or addresses DDRAM off the glass.
+*
+*******************************************************************************/
+static size_t LCD_CursorRoom(void)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_active->geometry;
+    uint8_t const address = LCD_active->cursorAddress;
+    uint8_t run;
+    uint8_t start;
+    uint8_t length;
+    uint8_t end;
+
+    if ((address == LCD_CURSOR_UNKNOWN) || (LCD_active->cursorDdram == 0u) ||
+        (LCD_active->cursorIncrement == 0u))
+    {
+        return LCD_ROOM_UNBOUNDED;
+    }
+
+    /* A cell on the glass, unless a print stopped here at the end of a run */
+    if (address != LCD_active->wrapAddress)
+    {
+        for (run = 0u; run < LCD_GEOMETRY_RUNS; run++)
+        {
+            if ((LCD_GeometryRun(geometry, run, &start, &length) != 0u) &&
+                (address >= start) && (address < (start + length)))
+            {
+                return (size_t) ((start + length) - address);
+            }
+        }
+    }
+
+    for (run = 0u; run < LCD_GEOMETRY_RUNS; run++)
+    {
+        if (LCD_GeometryRun(geometry, run, &start, &length) != 0u)
+        {
+            /* Where the address counter went after the last cell of the run */
+            end = start + length;
+            if (end == LCD_DDRAM_LINE_LENGTH)
+            {
+                end = LCD_DDRAM_LINE_1;
+            }
+            else if (end == (LCD_DDRAM_LINE_1 + LCD_DDRAM_LINE_LENGTH))
+            {
+                end = 0u;
+            }
+            else
+            {
+                /* Same line */
+            }
+
+            if (address == end)
+            {
+                for (run++; run < LCD_GEOMETRY_RUNS; run++)
+                {
+                    if (LCD_GeometryRun(geometry, run, &start, &length) != 0u)
+                    {
+                        LCD_WriteControl(LCD_DDRAM_0 | start);
+                        return (size_t) length;
+                    }
+                }
+
+                return 0u;
+            }
+        }
+    }
+
+    return LCD_ROOM_UNBOUNDED;
+}
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+#endif /* LCD_USE_CURSOR_TRACKING != 0u */
+
+
+/*******************************************************************************
+*  Function Name: LCD_CursorInvalidate
+********************************************************************************
+*
+* Summary:
+*  Forgets the tracked cursor position, so the next set-DDRAM-address command
+*  is always sent. Call after writing to the module behind the driver's back.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_CursorInvalidate(void)
+{
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        LCD_active->cursorAddress = LCD_CURSOR_UNKNOWN;
+        /* The writes may have selected CGRAM, only a DDRAM address says */
+        LCD_active->cursorDdram = 0u;
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_BusInvalidate
+********************************************************************************
+*
+* Summary:
+*  Forgets the tracked RS and R/nW levels, so the next parallel bus write
+*  drives them and waits tAS again. Call after driving RS or R/nW outside
+*  the write strobes of LCD.c.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_BusInvalidate(void)
+{
+    #if (LCD_TRANSPORT_HAS_GPIO != 0u)
+        LCD_busRs = LCD_BUS_UNKNOWN;
+    #endif /* LCD_TRANSPORT_HAS_GPIO != 0u */
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_CursorGet
+********************************************************************************
+*
+* Summary:
+*  Returns the tracked DDRAM address of the cursor.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  DDRAM address, LCD_CURSOR_UNKNOWN if not known or tracking is disabled.
+*
+*******************************************************************************/
+uint8_t LCD_CursorGet(void)
+{
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        return LCD_active->cursorAddress;
+    #else
+        return LCD_CURSOR_UNKNOWN;
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+}
+
+
+#if (LCD_TRANSPORT_HAS_GPIO != 0u)
+/*******************************************************************************
+*  Function Name: LCD_GpioStart
+********************************************************************************
+*
+* Summary:
+*  Brings up the parallel bus pins the CubeMX configuration does not cover
+*  (DB0-DB3 of the 8-bit bus, DB4-DB7 of the lockstep display, the pins of
+*  the scattered pin map).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static void LCD_GpioStart(void)
+{
+    LCD_busRs = LCD_BUS_UNKNOWN;
+
+    #if ((LCD_BUS_8BIT != 0u) || (LCD_USE_LOCKSTEP != 0u))
+        /* DB0-DB3 (DB4-DB7 of the lockstep display) are not part of the CubeMX pin configuration */
+        WRITE_REG(DB4_GPIO_Port->BSRR, LCD_BSRR_RESET(LCD_STM32_LOW_NIBBLE_MASK));
+        LL_GPIO_SetPinMode(DB4_GPIO_Port, LCD_DB0_PIN, LL_GPIO_MODE_OUTPUT);
+        LL_GPIO_SetPinMode(DB4_GPIO_Port, LCD_DB1_PIN, LL_GPIO_MODE_OUTPUT);
+        LL_GPIO_SetPinMode(DB4_GPIO_Port, LCD_DB2_PIN, LL_GPIO_MODE_OUTPUT);
+        LL_GPIO_SetPinMode(DB4_GPIO_Port, LCD_DB3_PIN, LL_GPIO_MODE_OUTPUT);
+        LL_GPIO_SetPinSpeed(DB4_GPIO_Port, LCD_DB0_PIN | LCD_DB1_PIN | LCD_DB2_PIN | LCD_DB3_PIN,
+                            LL_GPIO_SPEED_FREQ_LOW);
+        LL_GPIO_SetPinOutputType(DB4_GPIO_Port, LCD_DB0_PIN | LCD_DB1_PIN | LCD_DB2_PIN | LCD_DB3_PIN,
+                                 LL_GPIO_OUTPUT_PUSHPULL);
+    #endif /* (LCD_BUS_8BIT != 0u) || (LCD_USE_LOCKSTEP != 0u) */
+
+    #if (LCD_USE_PIN_MAP != 0u)
+        /* Mapped pins low, then push-pull outputs whatever the CubeMX setup of their ports */
+        LCD_MAP_WRITE(0u, 0u);
+        LCD_MAP_CR_SET(0u, CRL, LCD_MAP_CTRL_CR(0u, 0u, 0xFu), LCD_MAP_CTRL_CR(0u, 0u, 0x2u));
+        LCD_MAP_CR_SET(0u, CRH, LCD_MAP_CTRL_CR(0u, 1u, 0xFu), LCD_MAP_CTRL_CR(0u, 1u, 0x2u));
+        LCD_MAP_CR_SET(1u, CRL, LCD_MAP_CTRL_CR(1u, 0u, 0xFu), LCD_MAP_CTRL_CR(1u, 0u, 0x2u));
+        LCD_MAP_CR_SET(1u, CRH, LCD_MAP_CTRL_CR(1u, 1u, 0xFu), LCD_MAP_CTRL_CR(1u, 1u, 0x2u));
+        LCD_DATA_PINS_OUTPUT();
+    #endif /* LCD_USE_PIN_MAP != 0u */
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_GpioWriteByte
+********************************************************************************
+*
+* Summary:
+*  Writes a command (rs = 0) or data (rs = 1) byte on the parallel bus, one
+*  strobe on the 8-bit bus, high nibble first on the 4-bit bus.
+*
+* Parameters:
+*  value: Command or data byte
+*  rs:    0 = instruction register, 1 = data register
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static LCD_RAMFUNC void LCD_GpioWriteByte(uint8_t value, uint8_t rs)
+{
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        /* The counter moves, a poll before this write is stale */
+        LCD_polledAddress = LCD_CURSOR_UNKNOWN;
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+
+    #if (LCD_BUS_8BIT != 0u)
+        /* Whole byte and RS in one strobe */
+        LCD_WrByte(LCD_BYTE_BSRR(rs, value), rs);
+    #else
+        if (rs != 0u)
+        {
+            LCD_WrDatNib(value >> LCD_NIBBLE_SHIFT);
+            LCD_WrDatNib(value & LCD_NIBBLE_MASK);
+        }
+        else
+        {
+            LCD_WrCntrlNib(value >> LCD_NIBBLE_SHIFT);
+            LCD_WrCntrlNib(value & LCD_NIBBLE_MASK);
+        }
+    #endif /* LCD_BUS_8BIT != 0u */
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_GpioWriteNibble
+********************************************************************************
+*
+* Summary:
+*  Writes one handshake nibble (RS low) as DB7-DB4; on the 8-bit bus DB3-DB0
+*  are driven low.
+*
+* Parameters:
+*  nibble: Nibble in the four least significant bits
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static LCD_RAMFUNC void LCD_GpioWriteNibble(uint8_t nibble)
+{
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        LCD_polledAddress = LCD_CURSOR_UNKNOWN;
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+
+    #if (LCD_BUS_8BIT != 0u)
+        LCD_WrByte(LCD_BYTE_BSRR(0u, nibble << LCD_NIBBLE_SHIFT), 0u);
+    #else
+        LCD_WrCntrlNib(nibble);
+    #endif /* LCD_BUS_8BIT != 0u */
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_GpioWriteBuffer
+********************************************************************************
+*
+* Summary:
+*  Writes a run of data bytes with the data pins left as outputs: bytes are
+*  spaced by the data execution time on the cycle counter and the busy flag
+*  is checked at most once, after the last byte.
+*
+* Parameters:
+*  buffer: Bytes to write
+*  length: Number of bytes, at least 1
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static LCD_RAMFUNC void LCD_GpioWriteBuffer(uint8_t const buffer[], size_t length)
+{
+    size_t index;
+
+    LCD_GpioWaitReady();
+    LCD_GpioWriteByte(buffer[0u], 1u);
+    LCD_TimingMark(0u);
+
+    for (index = 1u; index < length; index++)
+    {
+        while (LCD_TimingExpired() == 0u)
+        {
+        }
+        LCD_GpioWriteByte(buffer[index], 1u);
+        LCD_TimingMark(0u);
+    }
+
+    #if (LCD_GPIO_WRITE_ONLY == 0u)
+        if (LCD_timedMode == 0u)
+        {
+            /* One read-back confirms the module kept up with the spacing */
+            (void) LCD_IsReady();
+        }
+    #endif /* LCD_GPIO_WRITE_ONLY == 0u */
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_GpioWaitReady
+********************************************************************************
+*
+* Summary:
+*  Waits until the module can accept the next byte. The busy flag is only
+*  polled while the execution time of the previous command has not elapsed;
+*  in timed mode (LCD_Calibrate) it is not polled at all.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static LCD_RAMFUNC void LCD_GpioWaitReady(void)
+{
+    #if (LCD_GPIO_WRITE_ONLY != 0u)
+        /* No busy flag to read: always the execution time of the last write */
+        #if (LCD_USE_WFI != 0u)
+            LCD_WfiWaitCycles(LCD_TimingRemaining());
+        #else
+            while (LCD_TimingExpired() == 0u)
+            {
+            }
+        #endif /* LCD_USE_WFI != 0u */
+        return;
+    #endif /* LCD_GPIO_WRITE_ONLY != 0u */
+
+    if (LCD_active->linkState != LCD_LINK_UP)
+    {
+        /* Probe on every access, so a display that comes back is noticed */
+        (void) LCD_IsReady();
+        return;
+    }
+
+    if (LCD_timedMode != 0u)
+    {
+        /* Open-loop: wait out the calibrated execution time */
+        #if (LCD_USE_WFI != 0u)
+            LCD_WfiWaitCycles(LCD_TimingRemaining());
+        #else
+            while (LCD_TimingExpired() == 0u)
+            {
+            }
+        #endif /* LCD_USE_WFI != 0u */
+        return;
+    }
+
+    #if (LCD_USE_RTOS != 0u)
+        /* Display service task: sleep through a long execution time first */
+        LCD_RtosWaitExec();
+    #endif /* LCD_USE_RTOS != 0u */
+
+    #if (LCD_USE_ELAPSED_SKIP != 0u)
+        if ((LCD_elapsedSkip == 0u) || (LCD_TimingExpired() == 0u))
+        {
+            (void) LCD_IsReady();
+        }
+    #else
+        (void) LCD_IsReady();
+    #endif /* LCD_USE_ELAPSED_SKIP != 0u */
+}
+
+
+#if (LCD_BUS_8BIT != 0u)
+/*******************************************************************************
+*  Function Name: LCD_WrByte
+********************************************************************************
+*
+* Summary:
+*  Writes a whole command or data byte on the 8-bit bus with a single E strobe.
+*
+* Parameters:
+*  bsrr:  LCD_BYTE_BSRR() word, DB0-DB7 and RS/RW in one store
+*  rs:    RS level in the word
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static LCD_RAMFUNC void LCD_WrByte(uint32_t bsrr, uint8_t rs)
+{
+    WRITE_REG(DB4_GPIO_Port->BSRR, bsrr);
+    LCD_TRACE_EDGE();
+
+    /* Guaranteed delay between Setting RS and RW and setting E bits (tAS),
+    * the data lines alone only need tDSW, covered by PWEH
+    */
+    if (LCD_busRs != rs)
+    {
+        LCD_DelaySetup();
+        LCD_busRs = rs;
+    }
+
+    WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_SET(LCD_E_BITS));
+    LCD_TRACE_EDGE();
+
+    /* E pulse width of the timing profile (PWEH) */
+    LCD_DelayPulse();
+
+    WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_RESET(LCD_E_BITS));
+    LCD_TRACE_EDGE();
+
+    /* Rest of the E cycle before the next byte (tcycE) */
+    LCD_DelayRecover();
+}
+
+#else
+/*******************************************************************************
+*  Function Name: LCD_WrDatNib
+********************************************************************************
+*
+* Summary:
+*  Writes a data nibble to the LCD module.
+*
+* Parameters:
+*  nibble:  Byte containing nibble in the least significant nibble to be
+*           written to the LCD module.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static LCD_RAMFUNC void LCD_WrDatNib(uint8_t nibble)
+{
+    #if (LCD_USE_PIN_MAP != 0u)
+        /* Nibble, RS high and RW low: one store per port of the pin map */
+        LCD_MAP_WRITE(1u, nibble & LCD_NIBBLE_MASK);
+    #else
+        #if (LCD_CTRL_ON_DATA_PORT == 0u)
+            if (LCD_busRs != 1u)
+            {
+                /* RS should be high to select data register */
+                LL_GPIO_SetOutputPin(RS_GPIO_Port, RS_Pin);
+                /* Reset RW for write operation */
+                LL_GPIO_ResetOutputPin(RnW_GPIO_Port, RnW_Pin);
+                LCD_TRACE_EDGE();
+            }
+        #endif /* LCD_CTRL_ON_DATA_PORT == 0u */
+
+        /* Write nibble data (and RS high, RW low) in a single store */
+        WRITE_REG(DB4_GPIO_Port->BSRR, LCD_nibbleBsrr[1u][nibble & LCD_NIBBLE_MASK]);
+    #endif /* LCD_USE_PIN_MAP != 0u */
+    LCD_TRACE_EDGE();
+
+    /* Guaranteed delay between Setting RS and RW and setting E bits (tAS),
+    * only after they changed: the second nibble and the next data byte skip it
+    */
+    if (LCD_busRs != 1u)
+    {
+        LCD_DelaySetup();
+        LCD_busRs = 1u;
+    }
+
+    /* , bring E high */
+	WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_SET(LCD_E_BITS));
+	LCD_TRACE_EDGE();
+
+    /* E pulse width of the timing profile (PWEH) */
+	LCD_DelayPulse();
+
+	/* , bring E low */
+	WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_RESET(LCD_E_BITS));
+	LCD_TRACE_EDGE();
+
+	/* Rest of the E cycle before the next nibble (tcycE) */
+	LCD_DelayRecover();
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_WrCntrlNib
+********************************************************************************
+*
+* Summary:
+*  Writes a control nibble to the LCD module.
+*
+* Parameters:
+*  nibble: The byte containing a nibble in the four least significant bits.????
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static LCD_RAMFUNC void LCD_WrCntrlNib(uint8_t nibble)
+{
+    #if (LCD_USE_PIN_MAP != 0u)
+        /* Nibble, RS and RW low: one store per port of the pin map */
+        LCD_MAP_WRITE(0u, nibble & LCD_NIBBLE_MASK);
+    #else
+        #if (LCD_CTRL_ON_DATA_PORT == 0u)
+            if (LCD_busRs != 0u)
+            {
+                /* RS and RW should be low to select instruction register and write operation respectively */
+                LL_GPIO_ResetOutputPin(RS_GPIO_Port, RS_Pin);
+                LL_GPIO_ResetOutputPin(RnW_GPIO_Port, RnW_Pin);
+                LCD_TRACE_EDGE();
+            }
+        #endif /* LCD_CTRL_ON_DATA_PORT == 0u */
+
+        /* Write nibble data (and RS, RW low) in a single store */
+        WRITE_REG(DB4_GPIO_Port->BSRR, LCD_nibbleBsrr[0u][nibble & LCD_NIBBLE_MASK]);
+    #endif /* LCD_USE_PIN_MAP != 0u */
+    LCD_TRACE_EDGE();
+
+    /* tAS of the timing profile after RS or RW changed, no wait where it is 0 */
+    if (LCD_busRs != 0u)
+    {
+        LCD_DelaySetup();
+        LCD_busRs = 0u;
+    }
+
+    /* Write control data and set enable signal */
+	WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_SET(LCD_E_BITS));
+	LCD_TRACE_EDGE();
+
+    /* E pulse width of the timing profile (PWEH) */
+    LCD_DelayPulse();
+
+    WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_RESET(LCD_E_BITS));
+    LCD_TRACE_EDGE();
+
+    /* Rest of the E cycle before the next nibble (tcycE) */
+    LCD_DelayRecover();
+}
+#endif /* LCD_BUS_8BIT != 0u */
+#endif /* LCD_TRANSPORT_HAS_GPIO != 0u */
+
+/*******************************************************************************
+*  Function Name: LCD_Position
+********************************************************************************
+*
+* Summary:
+*  Moves the active cursor location to a point specified by the input arguments
+*
+* Parameters:
+*  row:    Specific row of LCD module to be written
+*  column: Column of LCD module to be written
+*
+* Return:
+*  None.
+*
+* Note:
+*  With LCD_USE_FRAMEBUFFER set only the framebuffer cursor moves, the module
+*  is addressed by LCD_FlushFrame().
+*
+*******************************************************************************/
+void LCD_Position(uint8_t row, uint8_t column)
+{
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        LCD_STAT_INC(positionCalls);
+        LCD_FramePosition(row, column);
+    #else
+        LCD_WritePosition(row, column);
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_WritePosition
+********************************************************************************
+*
+* Summary:
+*  Sends a set-DDRAM-address command for the point specified by the input
+*  arguments, bypassing the framebuffer.
+*
+* Parameters:
+*  row:    Specific row of LCD module to be written
+*  column: Column of LCD module to be written
+*
+* Return:
+*  None.
+*
+* Note:
+*  Rows and columns follow the geometry of the selected display
+*  (LCD_SetGeometry).
+*
+*******************************************************************************/
+void LCD_WritePosition(uint8_t row, uint8_t column)
+{
+    LCD_STAT_INC(positionCalls);
+
+    if (row < LCD_active->geometry->rows)
+    {
+        /* An explicit position, even the one a print wrapped at */
+        LCD_active->wrapAddress = LCD_CURSOR_UNKNOWN;
+        LCD_WriteControl(LCD_DdramAddress(row, column));
+    }
+    /* else invalid row argument was passed */
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_DdramAddress
+********************************************************************************
+*
+* Summary:
+*  Returns the set-DDRAM-address command byte for a row and column.
+*
+* Parameters:
+*  row:    Specific row of LCD module
+*  column: Column of LCD module
+*
+* Return:
+*  Command byte (LCD_DDRAM_0 | address). Row 0 is used for an invalid row.
+*
+* Note:
+*  Looked up in the geometry of the selected display.
+*
+*******************************************************************************/
+uint8_t LCD_DdramAddress(uint8_t row, uint8_t column)
+{
+    return LCD_DDRAM_0 | LCD_GeometryAddress(LCD_active->geometry, row, column);
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_SetEntryDirection
+********************************************************************************
+*
+* Summary:
+*  Selects increment or decrement entry mode, keeping the display shift bit.
+*  The command is only sent when the mode mirror says the controller is in
+*  the other direction.
+*
+* Parameters:
+*  increment: 1 = the cursor moves right after each character, 0 = left
+*
+* Return:
+*  None.
+*
+* Note:
+*  Decrement mode set here is undone by the next print (LCD_PrintString,
+*  LCD_PutChar); one set by an entry mode command of the application is not.
+*
+*******************************************************************************/
+void LCD_SetEntryDirection(uint8_t increment)
+{
+    uint8_t const mode = (increment != 0u) ? (uint8_t) (LCD_active->entryMode | LCD_ENTRY_INCREMENT) :
+                                             (uint8_t) (LCD_active->entryMode & ~LCD_ENTRY_INCREMENT);
+
+    if (mode != LCD_active->entryMode)
+    {
+        LCD_WriteControl(mode);
+    }
+
+    LCD_active->entryReversed = (increment != 0u) ? 0u : 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintString
+********************************************************************************
+*
+* Summary:
+*  Writes a zero terminated string to the LCD.
+*
+* Parameters:
+*  string: Pointer to head of char8 array to be written to the LCD module
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PrintString(char const string[])
+{
+    size_t index = 1u;
+    char current = *string;
+
+    /* The whole string in one transaction where the transport groups writes */
+    LCD_BUS_BATCH_BEGIN();
+
+    /* Until null is reached, print next character */
+    while((char) '\0' != current)
+    {
+        LCD_PutChar(current);
+        current = string[index];
+        index++;
+    }
+
+    LCD_BUS_BATCH_END();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintStringN
+********************************************************************************
+*
+* Summary:
+*  Writes at most "length" characters of a string, stopping early at a zero
+*  terminator.
+*
+* Parameters:
+*  string: Pointer to head of char8 array to be written to the LCD module
+*  length: Maximum number of characters
+*
+* Return:
+*  None.
+*
+* Note:
+*  Without the framebuffer the characters go out as one LCD_WriteBuffer() run
+*  per visible run of the geometry.
+*
+*******************************************************************************/
+void LCD_PrintStringN(char const string[], size_t length)
+{
+    size_t count = 0u;
+
+    while ((count < length) && ((char) '\0' != string[count]))
+    {
+        #if (LCD_USE_FRAMEBUFFER != 0u)
+            LCD_FrameWriteChar((uint8_t) string[count]);
+        #endif /* LCD_USE_FRAMEBUFFER != 0u */
+        count++;
+    }
+
+    #if (LCD_USE_FRAMEBUFFER == 0u)
+        LCD_PrintRun((uint8_t const *) string, count);
+    #endif /* LCD_USE_FRAMEBUFFER == 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintAt
+********************************************************************************
+*
+* Summary:
+*  Moves the cursor and writes a zero terminated string. With cursor tracking
+*  the address command is only sent when the cursor is elsewhere.
+*
+* Parameters:
+*  row:    Specific row of LCD module to be written
+*  column: Column of LCD module to be written
+*  string: Pointer to head of char8 array to be written to the LCD module
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PrintAt(uint8_t row, uint8_t column, char const string[])
+{
+    LCD_Position(row, column);
+    LCD_PrintString(string);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FillRegion
+********************************************************************************
+*
+* Summary:
+*  Writes one character into "width" cells from a position, wrapping like
+*  printed text (LCD_ClearRegion() fills with blanks). With the framebuffer
+*  only the cells that do not hold the character yet are sent. A blank fill
+*  uses LCD_ClearDisplay() instead when that is cheaper: with the
+*  framebuffer when the whole frame ends up blank and the flush would take
+*  longer than the clear, without it when the fill covers the screen and
+*  the writes take longer (LCD_FrameClearBeats()).
+*
+* Parameters:
+*  row:       Row of the first cell
+*  column:    Column of the first cell
+*  width:     Number of cells
+*  character: Character to fill with
+*
+* Return:
+*  None.
+*
+* Note:
+*  The cursor ends after the last cell written, home after a clear without
+*  the framebuffer.
+*
+*******************************************************************************/
+void LCD_FillRegion(uint8_t row, uint8_t column, uint8_t width, char character)
+{
+    uint8_t count = 0u;
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        uint8_t frameRow;
+        uint8_t frameColumn;
+    #else
+        LCD_GEOMETRY_STRUCT const *geometry = LCD_active->geometry;
+        uint16_t const cells = (uint16_t) geometry->rows * geometry->columns;
+        uint16_t const runs = (uint16_t) geometry->rows * ((geometry->split < geometry->columns) ? 2u : 1u);
+
+        if ((character == ' ') && (row == 0u) && (column == 0u) && (width >= cells) &&
+            (LCD_FrameClearBeats((uint16_t) (cells + runs)) != 0u))
+        {
+            LCD_ClearDisplay();
+            return;
+        }
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+    LCD_BUS_BATCH_BEGIN();
+
+    LCD_Position(row, column);
+    while (count < width)
+    {
+        LCD_PutChar(character);
+        count++;
+    }
+
+    LCD_BUS_BATCH_END();
+
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        if ((character == ' ') && LCD_IS_PRIMARY() && (LCD_FrameClearIsCheaper() != 0u))
+        {
+            /* The clear blanks the glass copy and homes the shadow cursor */
+            frameRow = LCD_frameRow;
+            frameColumn = LCD_frameColumn;
+            LCD_ClearDisplay();
+            LCD_FramePosition(frameRow, frameColumn);
+        }
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_PutChar
+********************************************************************************
+*
+* Summary:
+*  Writes a single character to the current cursor position of the LCD module.
+*  Custom character names (_CUSTOM_0 through
+*  _CUSTOM_7) are acceptable as inputs.
+*  With LCD_USE_FRAMEBUFFER set the character goes to the framebuffer and
+*  reaches the module on the next LCD_FlushFrame().
+*  Past the end of a row the character goes to the start of the next one and
+*  past the last row it is dropped (always with the framebuffer, with cursor
+*  tracking without it).
+*
+* Parameters:
+*  character: Character to be written to LCD
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PutChar(char character)
+{
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        LCD_FrameWriteChar((uint8_t)character);
+    #elif (LCD_USE_CURSOR_TRACKING != 0u)
+        size_t room;
+
+        LCD_ENTRY_FORWARD();
+        room = LCD_CursorRoom();
+        if (room != 0u)
+        {
+            LCD_WriteData((uint8_t)character);
+            if (room == 1u)
+            {
+                /* Filled the run, the next character wraps */
+                LCD_active->wrapAddress = LCD_active->cursorAddress;
+            }
+        }
+    #else
+        LCD_ENTRY_FORWARD();
+        LCD_WriteData((uint8_t)character);
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+}
+
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+/*******************************************************************************
+*  Function Name: LCD_PrintRun
+********************************************************************************
+*
+* Summary:
+*  Writes characters at the cursor as bulk writes, one per visible run of
+*  the geometry they cover, and drops what falls past the last row.
+*
+* Parameters:
+*  buffer: Characters
+*  length: Number of characters
+*
+* Return:
+*  None.
+*
+* Note:
+*  Without cursor tracking the cursor is not known: one unclipped write.
+*
+*******************************************************************************/
+static void LCD_PrintRun(uint8_t const buffer[], size_t length)
+{
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        size_t room;
+        size_t chunk;
+
+        LCD_ENTRY_FORWARD();
+
+        while (length != 0u)
+        {
+            room = LCD_CursorRoom();
+            if (room == 0u)
+            {
+                break;
+            }
+
+            chunk = (room < length) ? room : length;
+            LCD_WriteBuffer(buffer, chunk);
+            if (chunk == room)
+            {
+                LCD_active->wrapAddress = LCD_active->cursorAddress;
+            }
+
+            buffer = &buffer[chunk];
+            length -= chunk;
+        }
+    #else
+        LCD_ENTRY_FORWARD();
+        LCD_WriteBuffer(buffer, length);
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+}
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+
+/*******************************************************************************
+*  Function Name: LCD_PrintInt8
+********************************************************************************
+*
+* Summary:
+*  Print a byte as two ASCII characters.
+*
+* Parameters:
+*  value: The byte to be printed out as ASCII characters.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PrintInt8(uint8_t value)
+{
+    static char const LCD_hex[16u] = "0123456789ABCDEF";
+
+    LCD_PutChar((char) LCD_hex[value >> LCD_BYTE_UPPER_NIBBLE_SHIFT]);
+    LCD_PutChar((char) LCD_hex[value & LCD_BYTE_LOWER_NIBBLE_MASK]);
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_PrintInt16
+********************************************************************************
+*
+* Summary:
+*  Print a uint16 as four ASCII characters.
+*
+* Parameters:
+*  value: The uint16 to be printed out as ASCII characters.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PrintInt16(uint16_t value)
+{
+    LCD_PrintInt8((uint8_t)(value >> LCD_U16_UPPER_BYTE_SHIFT));
+    LCD_PrintInt8((uint8_t)(value & LCD_U16_LOWER_BYTE_MASK));
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_PrintInt32
+********************************************************************************
+*
+* Summary:
+*  Print a uint32 hexadecimal number as eight ASCII characters.
+*
+* Parameters:
+*  value: The uint32 to be printed out as ASCII characters.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PrintInt32(uint32_t value)
+{
+    uint8_t shift = LCD_32_BIT_SHIFT;
+
+    while (shift != 0u)
+    {
+        /* "shift" var is to be subtracted by 8 prior shifting. This implements
+        * shifting by 24, 16, 8 and 0u.
+        */
+        shift -= LCD_8_BIT_SHIFT;
+
+        /* Print 8 bits of uint32 hex number */
+        LCD_PrintInt8((uint8_t) ((uint32_t) (value >> shift)));
+    }
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_PrintNumber
+********************************************************************************
+*
+* Summary:
+*  Print an uint16 value as a left-justified decimal value.
+*
+* Parameters:
+*  value: A 16-bit value to be printed in ASCII characters as a decimal number
+*
+* Return:
+*  None.
 *
-* Reentrant:
-*  No.
+* Note:
+*  This function is implemented as a macro.
 *
 *******************************************************************************/
-void LCD_Start(void)
-{
-    /* If not initialized, perform initialization */
-    if(LCD_initVar == 0u)
-    {
-        LCD_Init();
-        LCD_initVar = 1u;
-    }
-
-    /* Turn on the LCD */
-    LCD_Enable();
-}
 
 
 /*******************************************************************************
-*  Function Name: LCD_WriteData
+*  Function Name: LCD_PrintU32Number
 ********************************************************************************
 *
 * Summary:
-*  Writes a data byte to the LCD module's Data Display RAM.
+*  Print an uint32 value as a left-justified decimal value.
 *
 * Parameters:
-*  dByte: Byte to be written to the LCD module
+*  value: A 32-bit value to be printed in ASCII characters as a decimal number
 *
 * Return:
 *  None.
 *
 *******************************************************************************/
-void LCD_WriteData(uint8_t dByte)
+void LCD_PrintU32Number(uint32_t value)
 {
-    uint8_t nibble;
-
-    LCD_IsReady();
-//    delay_us(100);
-
-    nibble = dByte >> LCD_NIBBLE_SHIFT;
+    char number[LCD_U32_DIGITS];
+    uint8_t count;
 
-    /* Write high nibble */
-    LCD_WrDatNib(nibble);
+    /* Digits are filled from end to start without divisions (LCD_Format.c) */
+    count = LCD_FormatU32(number, value);
 
-    nibble = dByte & LCD_NIBBLE_MASK;
-    /* Write low nibble */
-    LCD_WrDatNib(nibble);
+    /* Print out number */
+    LCD_PrintStringN(&number[LCD_U32_DIGITS - count], count);
 }
 
-
 /*******************************************************************************
-*  Function Name: LCD_WriteControl
+* Function Name: LCD_IsReady
 ********************************************************************************
 *
 * Summary:
-*  Writes a command byte to the LCD module.
+*  Polls the LCD until the ready bit is set or a timeout occurs. A timeout
+*  latches the display unresponsive: writes are then dropped and each poll
+*  is a single flag read, until the display answers again (re-initialized by
+*  LCD_RecoverPoll() with LCD_USE_LINK_RECOVERY).
 *
 * Parameters:
-*  cByte:  The byte to be written to theLCD module
+*  None.
 *
 * Return:
-*  None.
+*  1 when the module is ready, 0 on timeout or while unresponsive.
+*
+* Note:
+*  Changes the pins to High-Z. On the I2C and SPI transports R/nW is never
+*  raised, the call waits until the padded stream is on the wire (I2C: 0
+*  when the backpack did not acknowledge).
 *
 *******************************************************************************/
-void LCD_WriteControl(uint8_t cByte)
+LCD_RAMFUNC uint8_t LCD_IsReady(void)
 {
-    uint8_t nibble;
+    LCD_Handle *handle = LCD_active;
+    uint8_t ready;
 
-    LCD_IsReady();
-//    delay_us(100);
+    if (handle->linkState == LCD_LINK_ABSENT)
+    {
+        /* No controller on the bus, nothing to poll */
+        return 0u;
+    }
 
-    nibble = cByte >> LCD_NIBBLE_SHIFT;
+    ready = LCD_BUS_IS_READY();
 
-    /* WrCntrlNib(High Nibble) */
-    LCD_WrCntrlNib(nibble);
-    nibble = cByte & LCD_NIBBLE_MASK;
+    if (ready == 0u)
+    {
+        if (handle->linkState == LCD_LINK_UP)
+        {
+            /* Later writes fail fast instead of each timing out */
+            handle->linkState = LCD_LINK_LOST;
+            handle->linkTick = HAL_GetTick();
+        }
+    }
+    else if (handle->linkState == LCD_LINK_LOST)
+    {
+        #if (LCD_USE_LINK_RECOVERY != 0u)
+            /* LCD_RecoverPoll() re-initializes it before writes resume */
+            handle->linkState = LCD_LINK_BACK;
+            handle->linkTick = HAL_GetTick();
+        #else
+            /* Writes were dropped, what the display shows is not known */
+            handle->linkState = LCD_LINK_UP;
+            LCD_CursorInvalidate();
+            #if (LCD_USE_FRAMEBUFFER != 0u)
+                if (LCD_IS_PRIMARY())
+                {
+                    LCD_FrameInvalidate();
+                }
+            #endif /* LCD_USE_FRAMEBUFFER != 0u */
+        #endif /* LCD_USE_LINK_RECOVERY != 0u */
+    }
+    else
+    {
+        /* Responsive, or already waiting for LCD_RecoverPoll() */
+    }
 
-    /* WrCntrlNib(Low Nibble) */
-    LCD_WrCntrlNib(nibble);
+    return ready;
 }
 
 
-
 /*******************************************************************************
-*  Function Name: LCD_WrDatNib
+* Function Name: LCD_IsResponsive
 ********************************************************************************
 *
 * Summary:
-*  Writes a data nibble to the LCD module.
+*  Reports whether the selected display answers (no busy poll timed out
+*  since it was last initialized or recovered).
 *
 * Parameters:
-*  nibble:  Byte containing nibble in the least significant nibble to be
-*           written to the LCD module.
+*  None.
 *
 * Return:
-*  None.
+*  1 if writes reach the display, 0 while they are dropped.
 *
 *******************************************************************************/
-static void LCD_WrDatNib(uint8_t nibble)
+uint8_t LCD_IsResponsive(void)
 {
-	uint16_t gpioPortData;
-
-    /* RS should be high to select data register */
-	LL_GPIO_SetOutputPin(RS_GPIO_Port, RS_Pin);
-    /* Reset RW for write operation */
-	LL_GPIO_ResetOutputPin(RnW_GPIO_Port, RnW_Pin);
-
-    /* Guaranteed delay between Setting RS and RW and setting E bits */
-    delay_us(2u);
-
-    /* Clear data pins, write nibble data */
-	gpioPortData = (uint16_t) LL_GPIO_ReadOutputPort(DB4_GPIO_Port);
-	gpioPortData &= ~(uint16_t) LCD_STM32_NIBBLE_MASK;
-	gpioPortData |= (((uint16_t) nibble << LCD_STM32_NIBBLE_SHIFT) & LCD_STM32_NIBBLE_MASK);
-	LL_GPIO_WriteOutputPort(DB4_GPIO_Port, (uint32_t) gpioPortData);
-
-    /* , bring E high */
-	LL_GPIO_SetOutputPin(E_GPIO_Port, E_Pin);
-
-    /* Minimum of 230 ns delay */
-	delay_us(1u);
-
-	/* , bring E low */
-	LL_GPIO_ResetOutputPin(E_GPIO_Port, E_Pin);
+    return (LCD_active->linkState == LCD_LINK_UP) ? 1u : 0u;
 }
 
 
 /*******************************************************************************
-*  Function Name: LCD_WrCntrlNib
+* Function Name: LCD_IsPresent
 ********************************************************************************
 *
 * Summary:
-*  Writes a control nibble to the LCD module.
+*  Reports whether the selected display was found at initialization
+*  (LCD_USE_DETECT bus probe and DDRAM read-back). Always 1 without
+*  LCD_USE_DETECT.
 *
 * Parameters:
-*  nibble: The byte containing a nibble in the four least significant bits.????
+*  None.
 *
 * Return:
-*  None.
+*  1 if a controller is fitted, 0 if the unit has none.
 *
 *******************************************************************************/
-static void LCD_WrCntrlNib(uint8_t nibble)
+uint8_t LCD_IsPresent(void)
 {
-	uint16_t gpioPortData;
-
-    /* RS and RW should be low to select instruction register and write operation respectively */
-	LL_GPIO_ResetOutputPin(RS_GPIO_Port, RS_Pin | RnW_Pin);
-
-    /* Two following lines of code will give 40ns delay */
-    /* Clear data pins */
-    gpioPortData = (uint16_t) LL_GPIO_ReadOutputPort(DB4_GPIO_Port);
-	gpioPortData &= ~(uint16_t) LCD_STM32_NIBBLE_MASK;
-	gpioPortData |= (((uint16_t) nibble << LCD_STM32_NIBBLE_SHIFT) & LCD_STM32_NIBBLE_MASK);
-	LL_GPIO_WriteOutputPort(DB4_GPIO_Port, (uint32_t) gpioPortData);
-
-    /* Write control data and set enable signal */
-	LL_GPIO_SetOutputPin(E_GPIO_Port, E_Pin);
-
-    /* Minimum of 230 ns delay */
-    delay_us(1u);
-
-    LL_GPIO_ResetOutputPin(E_GPIO_Port, E_Pin);
+    return (LCD_active->linkState != LCD_LINK_ABSENT) ? 1u : 0u;
 }
 
+
 /*******************************************************************************
-*  Function Name: LCD_Position
+* Function Name: LCD_ReadStatus
 ********************************************************************************
 *
 * Summary:
-*  Moves the active cursor location to a point specified by the input arguments
+*  Reads the busy flag and address counter once, without waiting.
 *
 * Parameters:
-*  row:    Specific row of LCD module to be written
-*  column: Column of LCD module to be written
-*
-* Return:
 *  None.
 *
-* Note:
-*  This only applies for LCD displays that use the 2X40 address mode.
-*  In this case Row 2 starts with a 0x28 offset from Row 1.
-*  When there are more than 2 rows, each row must be fewer than 20 characters.
+* Return:
+*  LCD_STATUS_BUSY | address counter, or LCD_STATUS_NONE when the transport
+*  of the display cannot read the module.
 *
 *******************************************************************************/
-void LCD_Position(uint8_t row, uint8_t column)
+uint8_t LCD_ReadStatus(void)
 {
-    switch (row)
-    {
-        case (uint8_t) 0:
-            LCD_WriteControl(LCD_ROW_0_START + column);
-            break;
-        case (uint8_t) 1:
-            LCD_WriteControl(LCD_ROW_1_START + column);
-            break;
-        case (uint8_t) 2:
-            LCD_WriteControl(LCD_ROW_2_START + column);
-            break;
-        case (uint8_t) 3:
-            LCD_WriteControl(LCD_ROW_3_START + column);
-            break;
-        default:
-            /* if default case is hit, invalid row argument was passed.*/
-            break;
-    }
+    return (LCD_BUS_READ_STATUS());
 }
 
 
 /*******************************************************************************
-* Function Name: LCD_PrintString
+* Function Name: LCD_ReadAddress
 ********************************************************************************
 *
 * Summary:
-*  Writes a zero terminated string to the LCD.
+*  Waits until the module is idle and reads its address counter. With cursor
+*  tracking the mirror is resynchronized to it (while in DDRAM).
 *
 * Parameters:
-*  string: Pointer to head of char8 array to be written to the LCD module
+*  None.
 *
 * Return:
-*  None.
+*  AC6-AC0 (DDRAM or CGRAM address, whichever was set last), or
+*  LCD_CURSOR_UNKNOWN when the transport of the display cannot read.
 *
 *******************************************************************************/
-void LCD_PrintString(char const string[])
+uint8_t LCD_ReadAddress(void)
 {
-    uint8_t indexU8 = 1u;
-    char current = *string;
+    uint8_t status;
 
-    /* Until null is reached, print next character */
-    while((char) '\0' != current)
+    LCD_IsReady();
+
+    /* The counter moves tADD after the busy flag cleared */
+    LCD_DelayUs(LCD_T_ADD_US);
+    status = LCD_BUS_READ_STATUS();
+
+    if (status == LCD_STATUS_NONE)
     {
-        LCD_WriteData((uint8_t)current);
-        current = string[indexU8];
-        indexU8++;
+        return LCD_CURSOR_UNKNOWN;
     }
+
+    status &= LCD_STATUS_ADDRESS_MASK;
+
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        LCD_polledAddress = LCD_CURSOR_UNKNOWN;
+        LCD_CursorAdopt(status);
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+
+    return status;
 }
 
 
 /*******************************************************************************
-*  Function Name: LCD_PutChar
+* Function Name: LCD_ReadData
 ********************************************************************************
 *
 * Summary:
-*  Writes a single character to the current cursor position of the LCD module.
-*  Custom character names (_CUSTOM_0 through
-*  _CUSTOM_7) are acceptable as inputs.
+*  Reads the DDRAM or CGRAM byte at the address counter (RS and R/W high).
+*  The counter then moves like after a data write, and so does the cursor
+*  mirror.
 *
 * Parameters:
-*  character: Character to be written to LCD
+*  None.
 *
 * Return:
-*  None.
+*  The byte, or LCD_READ_NONE when the transport of the display cannot read
+*  or the display does not answer.
+*
+* Note:
+*  The module delivers the right byte only after a set address (or cursor
+*  shift) command; set one before the first read that follows writes.
 *
 *******************************************************************************/
-void LCD_PutChar(char character)
+uint16_t LCD_ReadData(void)
 {
-    LCD_WriteData((uint8_t)character);
+    uint16_t value;
+
+    LCD_BUS_WAIT_READY();
+
+    if (LCD_active->linkState != LCD_LINK_UP)
+    {
+        return LCD_READ_NONE;
+    }
+
+    value = LCD_BUS_READ_DATA();
+    if (value != LCD_READ_NONE)
+    {
+        LCD_TimingMark(0u);
+
+        #if (LCD_USE_CURSOR_TRACKING != 0u)
+            LCD_polledAddress = LCD_CURSOR_UNKNOWN;
+            LCD_CursorStep(LCD_active->cursorIncrement);
+        #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+    }
+
+    return value;
 }
 
 
+#if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
 /*******************************************************************************
-*  Function Name: LCD_PrintInt8
+* Function Name: LCD_SetTransport
 ********************************************************************************
 *
 * Summary:
-*  Print a byte as two ASCII characters.
+*  Binds the selected display to a transport (LCD_transportGpio,
+*  LCD_transportI2c, LCD_transportSpi or an application table). Call before
+*  LCD_Init() of that display.
 *
 * Parameters:
-*  value: The byte to be printed out as ASCII characters.
+*  transport: Operations table, kept by reference
 *
 * Return:
 *  None.
 *
 *******************************************************************************/
-void LCD_PrintInt8(uint8_t value)
+void LCD_SetTransport(LCD_Transport const *transport)
 {
-    static char const LCD_hex[16u] = "0123456789ABCDEF";
-
-    LCD_PutChar((char) LCD_hex[value >> LCD_BYTE_UPPER_NIBBLE_SHIFT]);
-    LCD_PutChar((char) LCD_hex[value & LCD_BYTE_LOWER_NIBBLE_MASK]);
+    LCD_active->transport = transport;
 }
+#endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
 
 
+#if (LCD_TRANSPORT_HAS_GPIO != 0u)
+#if (LCD_GPIO_WRITE_ONLY != 0u)
 /*******************************************************************************
-*  Function Name: LCD_PrintInt16
+* Function Name: LCD_GpioIsReady
 ********************************************************************************
 *
 * Summary:
-*  Print a uint16 as four ASCII characters.
+*  Write-only wiring (LCD_GPIO_WRITE_ONLY): waits out the execution time of
+*  the last write, the data pins stay outputs.
 *
 * Parameters:
-*  value: The uint16 to be printed out as ASCII characters.
+*  None.
 *
 * Return:
-*  None.
+*  1, the module is taken to be idle.
 *
 *******************************************************************************/
-void LCD_PrintInt16(uint16_t value)
+static LCD_RAMFUNC uint8_t LCD_GpioIsReady(void)
 {
-    LCD_PrintInt8((uint8_t)(value >> LCD_U16_UPPER_BYTE_SHIFT));
-    LCD_PrintInt8((uint8_t)(value & LCD_U16_LOWER_BYTE_MASK));
-}
+    LCD_GpioWaitReady();
 
+    return 1u;
+}
 
+#else
 /*******************************************************************************
-*  Function Name: LCD_PrintInt32
+* Function Name: LCD_GpioIsReady
 ********************************************************************************
 *
 * Summary:
-*  Print a uint32 hexadecimal number as eight ASCII characters.
+*  Polls the busy flag on the parallel bus until it clears or a timeout
+*  occurs; while the display is latched unresponsive it reads the flag once.
 *
 * Parameters:
-*  value: The uint32 to be printed out as ASCII characters.
+*  None.
 *
 * Return:
-*  None.
+*  1 when the flag is clear, 0 on timeout.
 *
 *******************************************************************************/
-void LCD_PrintInt32(uint32_t value)
+static LCD_RAMFUNC uint8_t LCD_GpioIsReady(void)
 {
-    uint8_t shift = LCD_32_BIT_SHIFT;
+    uint8_t status;
+    uint32_t const start = LCD_CYCLES();
+    #if (LCD_USE_STATS != 0u)
+        uint32_t const statStart = start;
+    #endif /* LCD_USE_STATS != 0u */
 
-    while (shift != 0u)
+    LCD_GpioBusRead();
+
+    if (LCD_active->linkState != LCD_LINK_UP)
     {
-        /* "shift" var is to be subtracted by 8 prior shifting. This implements
-        * shifting by 24, 16, 8 and 0u.
-        */
-        shift -= LCD_8_BIT_SHIFT;
+        /* Latched unresponsive: one flag read instead of the full timeout */
+        status = LCD_GpioStatusStrobe();
+        LCD_GpioBusWrite();
 
-        /* Print 8 bits of uint32 hex number */
-        LCD_PrintInt8((uint8_t) ((uint32_t) (value >> shift)));
+        return ((status & LCD_STATUS_BUSY) == 0u) ? 1u : 0u;
+    }
+
+    do
+    {
+        status = LCD_GpioStatusStrobe();
+
+        /* If LCD is not ready make a delay (busy flag set) */
+        if ((status & LCD_STATUS_BUSY) != 0u)
+        {
+        	LCD_DelayUs(10u);
+        }
+
+        /* Repeat until the busy flag clears or until timeout, a time at any clock */
+    } while (((status & LCD_STATUS_BUSY) != 0u) &&
+             ((uint32_t) (LCD_CYCLES() - start) < LCD_readyTimeoutCycles));
+
+    if ((status & LCD_STATUS_BUSY) != 0u)
+    {
+        /* Gave up, the module is missing or hung */
+        LCD_STAT_INC(timeouts);
     }
+    #if (LCD_USE_CURSOR_TRACKING != 0u)
+        else
+        {
+            /* The address counter came with the last flag read, for free */
+            LCD_polledAddress = status & LCD_STATUS_ADDRESS_MASK;
+        }
+    #endif /* LCD_USE_CURSOR_TRACKING != 0u */
+
+    LCD_GpioBusWrite();
+
+    LCD_STAT_BUSY(statStart);
+
+    return ((status & LCD_STATUS_BUSY) == 0u) ? 1u : 0u;
 }
 
 
 /*******************************************************************************
-*  Function Name: LCD_PrintNumber
+* Function Name: LCD_GpioReadStatus
 ********************************************************************************
 *
 * Summary:
-*  Print an uint16 value as a left-justified decimal value.
+*  One status read on the parallel bus.
 *
 * Parameters:
-*  value: A 16-bit value to be printed in ASCII characters as a decimal number
-*
-* Return:
 *  None.
 *
-* Note:
-*  This function is implemented as a macro.
+* Return:
+*  Busy flag (bit 7) and address counter.
 *
 *******************************************************************************/
+static uint8_t LCD_GpioReadStatus(void)
+{
+    uint8_t status;
+
+    LCD_GpioBusRead();
+    status = LCD_GpioStatusStrobe();
+    LCD_GpioBusWrite();
+
+    return (status);
+}
 
 
 /*******************************************************************************
-*  Function Name: LCD_PrintU32Number
+* Function Name: LCD_GpioReadData
 ********************************************************************************
 *
 * Summary:
-*  Print an uint32 value as a left-justified decimal value.
+*  One data register read on the parallel bus, the same strobes as a status
+*  read with RS high.
 *
 * Parameters:
-*  value: A 32-bit value to be printed in ASCII characters as a decimal number
+*  None.
 *
 * Return:
-*  None.
+*  DDRAM or CGRAM byte at the address counter.
 *
 *******************************************************************************/
-void LCD_PrintU32Number(uint32_t value)
+static uint16_t LCD_GpioReadData(void)
 {
-    uint8_t tmpDigit;
-    char number[LCD_NUMBER_OF_REMAINDERS_U32 + 1u];
-    uint8_t digIndex = LCD_NUMBER_OF_REMAINDERS_U32;
-
-    /* This API will output a decimal number as a string and that string will be
-    * filled from end to start. Set Null termination character first.
-    */
-    number[digIndex] = (char) '\0';
-    digIndex--;
+    uint8_t value;
 
-    /* Load these in reverse order */
-    while(value >= LCD_TEN)
-    {
-        /* Extract decimal digit, indexed by 'digIndex', from 'value' and
-        * convert it to ASCII character.
-        */
-        tmpDigit = (uint8_t) (((uint8_t) (value % LCD_TEN)) + (uint8_t) LCD_ZERO_CHAR_ASCII);
+    LCD_GpioBusRead();
 
-        /* Temporary variable 'tmpDigit' is used to avoid Violation of MISRA rule
-        * #10.3.
-        */
-        number[digIndex] = (char) tmpDigit;
-        value /= LCD_TEN;
-        digIndex--;
-    }
+    /* Data register; RS settles within the tAS of the first strobe */
+    WRITE_REG(LCD_RS_PORT->BSRR, LCD_BSRR_SET(LCD_RS_BITS));
+    LCD_TRACE_EDGE();
 
-    /* Extract last decimal digit 'digIndex', from the 'value' and convert it
-    * to ASCII character.
-    */
-    tmpDigit = (uint8_t) (((uint8_t)(value % LCD_TEN)) + (uint8_t) LCD_ZERO_CHAR_ASCII);
-    number[digIndex] = (char) tmpDigit;
+    value = LCD_GpioStatusStrobe();
+    LCD_GpioBusWrite();
 
-    /* Print out number */
-    LCD_PrintString(&number[digIndex]);
+    return (uint16_t) value;
 }
 
+
 /*******************************************************************************
-* Function Name: LCD_IsReady
+* Function Name: LCD_GpioBusRead
 ********************************************************************************
 *
 * Summary:
-*  Polls the LCD until the ready bit is set or a timeout occurs.
+*  Turns the data pins to inputs and selects a status read (RS low, R/W
+*  high).
 *
 * Parameters:
 *  None.
@@ -579,91 +2576,187 @@ void LCD_PrintU32Number(uint32_t value)
 * Return:
 *  None.
 *
-* Note:
-*  Changes the pins to High-Z.
-*
 *******************************************************************************/
-void LCD_IsReady(void)
+static LCD_RAMFUNC void LCD_GpioBusRead(void)
 {
-	uint16_t gpioPortData;
-	uint16_t value;
-    uint32_t timeout;
-    timeout = LCD_READY_DELAY;
+    uint32_t mask;
 
     /* Clear LCD port */
-	gpioPortData = (uint16_t) LL_GPIO_ReadOutputPort(DB4_GPIO_Port);
-	gpioPortData &= ~(uint16_t) LCD_STM32_NIBBLE_MASK;
-	LL_GPIO_WriteOutputPort(DB4_GPIO_Port, (uint32_t) gpioPortData);
+	LCD_DATA_PINS_LOW();
+	LCD_TRACE_EDGE();
 
-	/* Change port to input on data pins */
-	LL_GPIO_SetPinMode(DB4_GPIO_Port, DB4_Pin, LL_GPIO_MODE_FLOATING);
-	LL_GPIO_SetPinMode(DB5_GPIO_Port, DB5_Pin, LL_GPIO_MODE_FLOATING);
-	LL_GPIO_SetPinMode(DB6_GPIO_Port, DB6_Pin, LL_GPIO_MODE_FLOATING);
-	LL_GPIO_SetPinMode(DB7_GPIO_Port, DB7_Pin, LL_GPIO_MODE_FLOATING);
+	/* Data pins to floating inputs, one CRL store; the other pins keep their
+	 * fields, so no interrupt below the mask may change them in between
+	 */
+	LCD_BUS_ATOMIC_BEGIN(mask);
+	LCD_DATA_PINS_INPUT();
+	LCD_BUS_ATOMIC_END(mask);
+	LCD_TRACE_EDGE();
 
 	/* Make sure RS is low */
-	LL_GPIO_ResetOutputPin(RS_GPIO_Port, RS_Pin);
+	WRITE_REG(LCD_RS_PORT->BSRR, LCD_BSRR_RESET(LCD_RS_BITS));
+	LCD_TRACE_EDGE();
 
 	/* Set R/W high to read */
-	LL_GPIO_SetOutputPin(RnW_GPIO_Port, RnW_Pin);
+	WRITE_REG(LCD_RW_PORT->BSRR, LCD_BSRR_SET(LCD_RW_BITS));
+	LCD_TRACE_EDGE();
 
-    do
-    {
-        /* 40 ns delay required before rising Enable and 500ns between neighbour Enables */
-        delay_us(0u);
+	/* The next write needs its full tAS after R/W comes down */
+	LCD_busRs = LCD_BUS_UNKNOWN;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GpioStatusStrobe
+********************************************************************************
+*
+* Summary:
+*  Reads the status byte with E strobes (two on the 4-bit bus, high nibble
+*  first). The bus must be set up by LCD_GpioBusRead().
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Busy flag (bit 7) and address counter.
+*
+*******************************************************************************/
+static LCD_RAMFUNC uint8_t LCD_GpioStatusStrobe(void)
+{
+    uint16_t value;
+    uint8_t status;
 
-        /* Set E high */
-        LL_GPIO_SetOutputPin(E_GPIO_Port, E_Pin);
+    /* tAS after R/W went high, every strobe already ends with its tcycE rest */
+    LCD_DelaySetup();
 
-        /* 360 ns delay setup time for data pins */
-        delay_us(1u);
+    /* Set E high */
+    WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_SET(LCD_E_BITS));
+    LCD_TRACE_EDGE();
 
-        /* Get port state */
+    /* tDDR until the data pins are valid, and at least PWEH */
+    LCD_DelayRead();
+
+    /* Get port state; DB7-DB4 of the pin map come from both ports at once */
+    #if (LCD_USE_PIN_MAP != 0u)
+        value = LCD_MapRead();
+    #else
         value = LL_GPIO_ReadInputPort(DB4_GPIO_Port);
+    #endif /* LCD_USE_PIN_MAP != 0u */
+    LCD_TRACE_READ(value);
 
-        /* Set enable low */
-        LL_GPIO_ResetOutputPin(E_GPIO_Port, E_Pin);
+    /* Set enable low */
+    WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_RESET(LCD_E_BITS));
+    LCD_TRACE_EDGE();
 
-        /* This gives true delay between disabling Enable bit and polling Ready bit */
-        delay_us(0u);
+    /* This gives true delay between disabling Enable bit and polling Ready bit */
+    LCD_DelayRecover();
 
-        /* Extract ready bit */
-        value &= ((uint16_t)LCD_READY_BIT << LCD_STM32_NIBBLE_SHIFT);
+    /* DB7-DB4: busy flag and AC6-AC4 */
+    LCD_LOCKSTEP_FOLD(value);
+    status = (uint8_t) (((value & LCD_STM32_NIBBLE_MASK) >> LCD_STM32_NIBBLE_SHIFT) << LCD_NIBBLE_SHIFT);
+    LCD_STAT_INC(busyPolls);
 
+    #if (LCD_BUS_8BIT != 0u)
+        status |= (uint8_t) ((value & LCD_STM32_LOW_NIBBLE_MASK) >> LCD_STM32_LOW_NIBBLE_SHIFT);
+    #else
         /* Set E high, 4-bit interface mode needs extra operation */
-        LL_GPIO_SetOutputPin(E_GPIO_Port, E_Pin);
+        WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_SET(LCD_E_BITS));
+        LCD_TRACE_EDGE();
 
-        /* 360 ns delay setup time for data pins */
-        delay_us(1u);
+        /* tDDR until the data pins are valid, and at least PWEH */
+        LCD_DelayRead();
+
+        /* AC3-AC0 */
+        #if (LCD_USE_PIN_MAP != 0u)
+            value = LCD_MapRead();
+        #else
+            value = LL_GPIO_ReadInputPort(DB4_GPIO_Port);
+        #endif /* LCD_USE_PIN_MAP != 0u */
+        LCD_TRACE_READ(value);
+        LCD_LOCKSTEP_FOLD(value);
 
         /* Set enable low */
-        LL_GPIO_ResetOutputPin(E_GPIO_Port, E_Pin);
+        WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_RESET(LCD_E_BITS));
+        LCD_TRACE_EDGE();
 
-        /* If LCD is not ready make a delay */
-        if (value == 0u)
-        {
-        	delay_us(10u);
-        }
+        /* Rest of the E cycle before the next poll or write */
+        LCD_DelayRecover();
+
+        status |= (uint8_t) ((value & LCD_STM32_NIBBLE_MASK) >> LCD_STM32_NIBBLE_SHIFT);
+    #endif /* LCD_BUS_8BIT != 0u */
+
+    return (status);
+}
 
-        /* Repeat until bit 4 is not zero or until timeout. */
-        timeout--;
 
-    } while ((value != 0u) && (timeout > 0u));
+/*******************************************************************************
+* Function Name: LCD_GpioBusWrite
+********************************************************************************
+*
+* Summary:
+*  Ends a status read: R/W low and the data pins back to outputs.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static LCD_RAMFUNC void LCD_GpioBusWrite(void)
+{
+    uint32_t mask;
 
     /* Set R/W low to write */
-    LL_GPIO_ResetOutputPin(RnW_GPIO_Port, RnW_Pin);
+    WRITE_REG(LCD_RW_PORT->BSRR, LCD_BSRR_RESET(LCD_RW_BITS));
+    LCD_TRACE_EDGE();
 
     /* Clear LCD port*/
-	gpioPortData = (uint16_t) LL_GPIO_ReadOutputPort(DB4_GPIO_Port);
-	gpioPortData &= ~(uint16_t) LCD_STM32_NIBBLE_MASK;
-	LL_GPIO_WriteOutputPort(DB4_GPIO_Port, (uint32_t) gpioPortData);
+	LCD_DATA_PINS_LOW();
+	LCD_TRACE_EDGE();
+
+	/* Data pins back to push-pull outputs, one CRL store */
+	LCD_BUS_ATOMIC_BEGIN(mask);
+	LCD_DATA_PINS_OUTPUT();
+	LCD_BUS_ATOMIC_END(mask);
+	LCD_TRACE_EDGE();
+}
+
+
+#if (LCD_USE_PIN_MAP != 0u)
+/*******************************************************************************
+* Function Name: LCD_MapRead
+********************************************************************************
+*
+* Summary:
+*  Samples the input registers of the pin map ports back to back and returns
+*  DB7-DB4 at LCD_STM32_NIBBLE_SHIFT, where LCD_GpioStatusStrobe() takes the
+*  nibble of the contiguous layout from.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  DB7-DB4 in port bit position.
+*
+*******************************************************************************/
+static LCD_RAMFUNC uint16_t LCD_MapRead(void)
+{
+    uint32_t idr0 = 0u;
+    uint32_t idr1 = 0u;
 
-	/* Change Port to Output (Strong) on data pins */
-	LL_GPIO_SetPinMode(DB4_GPIO_Port, DB4_Pin, LL_GPIO_MODE_OUTPUT);
-	LL_GPIO_SetPinMode(DB5_GPIO_Port, DB5_Pin, LL_GPIO_MODE_OUTPUT);
-	LL_GPIO_SetPinMode(DB6_GPIO_Port, DB6_Pin, LL_GPIO_MODE_OUTPUT);
-	LL_GPIO_SetPinMode(DB7_GPIO_Port, DB7_Pin, LL_GPIO_MODE_OUTPUT);
-	LL_GPIO_SetPinOutputType(DB4_GPIO_Port, DB4_Pin | DB5_Pin | DB6_Pin | DB7_Pin, LL_GPIO_OUTPUT_PUSHPULL);
+    if (LCD_MAP_DATA_BITS(0u) != 0u)
+    {
+        idr0 = LL_GPIO_ReadInputPort(LCD_MAP_PORT0);
+    }
+    if (LCD_MAP_DATA_BITS(1u) != 0u)
+    {
+        idr1 = LL_GPIO_ReadInputPort(LCD_MAP_PORT1);
+    }
 
+    return (uint16_t) ((uint16_t) LCD_MAP_NIBBLE(idr0, idr1) << LCD_STM32_NIBBLE_SHIFT);
 }
+#endif /* LCD_USE_PIN_MAP != 0u */
+#endif /* LCD_GPIO_WRITE_ONLY != 0u */
+#endif /* LCD_TRANSPORT_HAS_GPIO != 0u */
 
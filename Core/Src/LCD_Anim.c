@@ -0,0 +1,212 @@
+/*
+ *  LCD_Anim.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: CGRAM animations for the HD44780 LCD driver.
+ *
+ *  			An animation owns one CGRAM slot, pinned in the glyph manager.
+ *  			The application prints its character code wherever the icon
+ *  			should appear, once; each frame step then rewrites the 8 bitmap
+ *  			bytes of the slot and the controller redraws every cell that
+ *  			shows the code. A step costs one CGRAM address command and 8
+ *  			data bytes (plus the DDRAM address put back), however many
+ *  			cells show the icon, and DDRAM and the framebuffer stay
+ *  			untouched.
+ *
+ *  Usage:      - code = LCD_AnimStart(frames, count, periodMs), then
+ *  				LCD_PutChar((char) code) at each place of the icon
+ *  			- a blinking icon is two frames: the icon and a blank glyph
+ *  			- call LCD_AnimTask() from the main loop; it rewrites at most
+ *  				one slot per call, due animations take turns
+ *  			- the animations run on the display on E_Pin (the one the
+ *  				glyph manager describes); LCD_Init() forgets the slots,
+ *  				start the animations again after it
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Glyph.h"
+#include "LCD_Handle.h"
+#include "LCD_Anim.h"
+
+#if (LCD_USE_ANIMATION != 0u)
+
+#if (LCD_USE_GLYPH_CACHE == 0u)
+    #error "LCD_USE_ANIMATION pins its slots in the glyph manager (LCD_USE_GLYPH_CACHE)"
+#endif /* LCD_USE_GLYPH_CACHE == 0u */
+
+/* One running animation */
+typedef struct
+{
+    uint8_t const (*frames)[LCD_GLYPH_ROWS];
+    uint32_t period;                /* ms per frame */
+    uint32_t tick;                  /* HAL tick the current frame was due */
+    uint8_t frameCount;
+    uint8_t frame;                  /* Frame in the slot */
+    uint8_t code;                   /* CGRAM slot */
+    uint8_t running;
+} LCD_ANIM_STRUCT;
+
+uint8_t const LCD_animSpinner[LCD_ANIM_SPINNER_FRAMES][LCD_GLYPH_ROWS] =
+{
+    { 0x04u, 0x04u, 0x04u, 0x04u, 0x04u, 0x04u, 0x04u, 0x00u },  /* | */
+    { 0x01u, 0x01u, 0x02u, 0x04u, 0x08u, 0x10u, 0x10u, 0x00u },  /* / */
+    { 0x00u, 0x00u, 0x00u, 0x1Fu, 0x00u, 0x00u, 0x00u, 0x00u },  /* - */
+    { 0x10u, 0x10u, 0x08u, 0x04u, 0x02u, 0x01u, 0x01u, 0x00u }   /* \ */
+};
+
+static LCD_ANIM_STRUCT LCD_anim[LCD_ANIM_MAX];
+
+/* Animation checked first by the next LCD_AnimTask() */
+static uint8_t LCD_animNext = 0u;
+
+
+/*******************************************************************************
+* Function Name: LCD_AnimStart
+********************************************************************************
+*
+* Summary:
+*  Pins a CGRAM slot showing the first frame and starts stepping it.
+*
+* Parameters:
+*  frames: frameCount glyphs of LCD_GLYPH_ROWS bytes, must stay valid while
+*          the animation runs (const data)
+*  frameCount: Number of frames, at least 1
+*  periodMs: Time each frame is shown
+*
+* Return:
+*  Character code 0 - 7 to print, or LCD_GLYPH_NO_SLOT if every animation or
+*  every CGRAM slot is in use.
+*
+*******************************************************************************/
+uint8_t LCD_AnimStart(uint8_t const (*frames)[LCD_GLYPH_ROWS], uint8_t frameCount, uint32_t periodMs)
+{
+    uint8_t index;
+    LCD_ANIM_STRUCT *anim;
+
+    if ((frames == NULL) || (frameCount == 0u))
+    {
+        return LCD_GLYPH_NO_SLOT;
+    }
+
+    for (index = 0u; index < LCD_ANIM_MAX; index++)
+    {
+        if (LCD_anim[index].running == 0u)
+        {
+            break;
+        }
+    }
+
+    if (index == LCD_ANIM_MAX)
+    {
+        return LCD_GLYPH_NO_SLOT;
+    }
+
+    anim = &LCD_anim[index];
+    anim->code = LCD_GlyphPin(frames[0]);
+
+    if (anim->code != LCD_GLYPH_NO_SLOT)
+    {
+        anim->running = 1u;
+        anim->frames = frames;
+        anim->frameCount = frameCount;
+        anim->frame = 0u;
+        anim->period = periodMs;
+        anim->tick = HAL_GetTick();
+    }
+
+    return anim->code;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AnimStop
+********************************************************************************
+*
+* Summary:
+*  Stops an animation on its current frame and returns the slot to the glyph
+*  manager (evicted once no cell shows it).
+*
+* Parameters:
+*  code: Character code returned by LCD_AnimStart()
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_AnimStop(uint8_t code)
+{
+    uint8_t index;
+
+    for (index = 0u; index < LCD_ANIM_MAX; index++)
+    {
+        if ((LCD_anim[index].running != 0u) && (LCD_anim[index].code == code))
+        {
+            LCD_GlyphUnpin(code);
+            LCD_anim[index].running = 0u;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AnimTask
+********************************************************************************
+*
+* Summary:
+*  Steps the first due animation (in turn after the one stepped last) to its
+*  next frame. Call from the main loop.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+* Theory:
+*  The frame deadline advances by whole periods, so animations keep their
+*  rate while a step is held back behind another one; one that fell more than
+*  a period behind skips ahead instead of stepping in a burst.
+*
+*******************************************************************************/
+void LCD_AnimTask(void)
+{
+    uint32_t const now = HAL_GetTick();
+    uint8_t count;
+    uint8_t index = LCD_animNext;
+    LCD_ANIM_STRUCT *anim;
+
+    if (!LCD_IS_PRIMARY())
+    {
+        /* CGRAM of the other displays is not managed */
+        return;
+    }
+
+    for (count = 0u; count < LCD_ANIM_MAX; count++)
+    {
+        anim = &LCD_anim[index];
+        index = (uint8_t) ((index + 1u) % LCD_ANIM_MAX);
+
+        if ((anim->running == 0u) || (anim->frameCount < 2u) ||
+            ((uint32_t) (now - anim->tick) < anim->period))
+        {
+            continue;
+        }
+
+        anim->tick += anim->period;
+        if ((uint32_t) (now - anim->tick) >= anim->period)
+        {
+            anim->tick = now;
+        }
+
+        anim->frame = (uint8_t) ((anim->frame + 1u) % anim->frameCount);
+        LCD_GlyphRewrite(anim->code, anim->frames[anim->frame]);
+
+        LCD_animNext = index;
+        return;
+    }
+}
+
+#endif /* LCD_USE_ANIMATION != 0u */
@@ -0,0 +1,159 @@
+/*
+ *  LCD_Arena.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Static memory arena of the HD44780 LCD driver.
+ *
+ *  			The driver state with a size fixed by LCD_Config.h (the
+ *  			framebuffer, the queues, the glyph cache) is in static arrays
+ *  			of its module, so the map file shows it. Buffers whose size is
+ *  			only known at run time (recorded display lists, application
+ *  			screen buffers) come from LCD_ArenaAlloc() instead of malloc:
+ *  			one static array split into a region per owner, sized by the
+ *  			LCD_ARENA_xxx_BYTES budgets. An owner allocates by moving its
+ *  			own high mark up, so one owner running out never starves
+ *  			another, and LCD_ArenaRelease() gives an owner all of its
+ *  			region back (e.g. the lists of the previous screen). The peak
+ *  			of every owner is kept, LCD_GetStats() reports the totals.
+ *
+ *  Usage:      - LCD_ListBegin(&list, LCD_ArenaAlloc(LCD_ARENA_LIST, n), n)
+ *  			- LCD_ArenaPeak(owner) against its budget during bring-up,
+ *  				then trim LCD_ARENA_xxx_BYTES
+ *  			- not reentrant, allocate from the context that owns the
+ *  				display
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Arena.h"
+#include "LCD_Stats.h"
+
+#if (LCD_USE_ARENA != 0u)
+
+#if (((LCD_ARENA_LIST_BYTES % LCD_ARENA_ALIGN) != 0u) || ((LCD_ARENA_APP_BYTES % LCD_ARENA_ALIGN) != 0u))
+    #error "LCD_ARENA_xxx_BYTES must be multiples of LCD_ARENA_ALIGN"
+#endif /* LCD_ARENA_xxx_BYTES % LCD_ARENA_ALIGN */
+
+#if (LCD_ARENA_SIZE > 0xFFFFu)
+    #error "LCD_ARENA_xxx_BYTES must add up to at most 64 KB"
+#endif /* LCD_ARENA_SIZE > 0xFFFFu */
+
+/* The arena, words so every region starts aligned */
+static uint32_t LCD_arena[LCD_ARENA_SIZE / LCD_ARENA_ALIGN];
+
+/* Offset and size of the region of each owner */
+static uint16_t const LCD_arenaBase[LCD_ARENA_OWNERS] = { 0u, LCD_ARENA_LIST_BYTES };
+static uint16_t const LCD_arenaBudget[LCD_ARENA_OWNERS] = { LCD_ARENA_LIST_BYTES, LCD_ARENA_APP_BYTES };
+
+/* Bytes handed out, and the most ever handed out, per owner */
+static uint16_t LCD_arenaUsed[LCD_ARENA_OWNERS];
+static uint16_t LCD_arenaPeak[LCD_ARENA_OWNERS];
+
+
+/*******************************************************************************
+* Function Name: LCD_ArenaAlloc
+********************************************************************************
+*
+* Summary:
+*  Hands out a buffer from the region of an owner.
+*
+* Parameters:
+*  owner: LCD_ARENA_LIST or LCD_ARENA_APP
+*  size:  Bytes, rounded up to LCD_ARENA_ALIGN
+*
+* Return:
+*  Buffer aligned to LCD_ARENA_ALIGN, NULL if the budget of the owner has no
+*  room left (counted in the arenaFailures statistic).
+*
+*******************************************************************************/
+void *LCD_ArenaAlloc(uint8_t owner, uint16_t size)
+{
+    uint32_t const rounded = ((uint32_t) size + (LCD_ARENA_ALIGN - 1u)) & ~(uint32_t) (LCD_ARENA_ALIGN - 1u);
+    void *buffer;
+
+    if ((owner >= LCD_ARENA_OWNERS) || (size == 0u) ||
+        (rounded > (uint32_t) (LCD_arenaBudget[owner] - LCD_arenaUsed[owner])))
+    {
+        LCD_STAT_INC(arenaFailures);
+        return NULL;
+    }
+
+    buffer = &LCD_arena[(LCD_arenaBase[owner] + LCD_arenaUsed[owner]) / LCD_ARENA_ALIGN];
+    LCD_arenaUsed[owner] += (uint16_t) rounded;
+
+    if (LCD_arenaUsed[owner] > LCD_arenaPeak[owner])
+    {
+        LCD_arenaPeak[owner] = LCD_arenaUsed[owner];
+    }
+
+    return buffer;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ArenaRelease
+********************************************************************************
+*
+* Summary:
+*  Gives an owner its whole region back. Every buffer it was handed becomes
+*  invalid; the peak is kept.
+*
+* Parameters:
+*  owner: LCD_ARENA_LIST or LCD_ARENA_APP
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ArenaRelease(uint8_t owner)
+{
+    if (owner < LCD_ARENA_OWNERS)
+    {
+        LCD_arenaUsed[owner] = 0u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ArenaUsed
+********************************************************************************
+*
+* Summary:
+*  Returns the bytes an owner holds.
+*
+* Parameters:
+*  owner: LCD_ARENA_LIST or LCD_ARENA_APP
+*
+* Return:
+*  Bytes, 0 for an unknown owner.
+*
+*******************************************************************************/
+uint16_t LCD_ArenaUsed(uint8_t owner)
+{
+    return (owner < LCD_ARENA_OWNERS) ? LCD_arenaUsed[owner] : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ArenaPeak
+********************************************************************************
+*
+* Summary:
+*  Returns the most bytes an owner held at once since reset (its high-water
+*  mark), to compare against its LCD_ARENA_xxx_BYTES budget.
+*
+* Parameters:
+*  owner: LCD_ARENA_LIST or LCD_ARENA_APP
+*
+* Return:
+*  Bytes, 0 for an unknown owner.
+*
+*******************************************************************************/
+uint16_t LCD_ArenaPeak(uint8_t owner)
+{
+    return (owner < LCD_ARENA_OWNERS) ? LCD_arenaPeak[owner] : 0u;
+}
+
+#endif /* LCD_USE_ARENA != 0u */
@@ -0,0 +1,629 @@
+/*
+ *  LCD_Async.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Interrupt-driven, non-blocking write queue for the HD44780 LCD
+ *  			driver.
+ *
+ *  			LCD_WriteAsync() only puts a command/data item into a ring
+ *  			buffer. TIM4 compare channel 1 runs the bus state machine: each
+ *  			interrupt strobes the two nibbles of one byte (sub-microsecond
+ *  			E-strobe gaps are counted on TIM4 inside the interrupt) and then
+ *  			schedules the next compare after the execution time of that byte
+ *  			(37 us, or 1.52 ms for clear/home). The foreground only pays for
+ *  			the enqueue; the execution times overlap with application work.
+ *
+ *  			With LCD_USE_ASYNC_URGENT a second ring holds urgent runs
+ *  			(alarm text): they go out at the next run start of the normal
+ *  			queue, so an alarm waits at most for the rest of one run (a
+ *  			row, or 64 CGRAM bytes = 2.4 ms) instead of the whole queue.
+ *  			An urgent run is queued whole and sent whole; the normal queue
+ *  			then continues at its own address (sent again if its next
+ *  			item does not set one).
+ *
+ *  Usage:      - call LCD_AsyncIRQHandler() from TIM4_IRQHandler
+ *  			- TIM4 must be free running (delay_us() no longer resets it)
+ *  			- the blocking API must not be used while LCD_IsIdle() is 0
+ *  			- parallel bus only: with LCD_TRANSPORT_RUNTIME the queue
+ *  				refuses items while the primary display is on I2C or SPI
+ *
+ */
+#include "main.h"
+#include "stm32f1xx_ll_tim.h"
+#include "LCD.h"
+#include "LCD_Async.h"
+#include "LCD_Stats.h"
+#include "LCD_Transport.h"
+#include "LCD_Handle.h"
+
+#if (LCD_USE_ASYNC != 0u)
+
+#if ((LCD_TRANSPORT == LCD_TRANSPORT_I2C) || (LCD_TRANSPORT == LCD_TRANSPORT_SPI))
+    #error "LCD_USE_ASYNC drives the parallel bus pins directly, it cannot reach a display on LCD_TRANSPORT_I2C or LCD_TRANSPORT_SPI"
+#endif /* (LCD_TRANSPORT == LCD_TRANSPORT_I2C) || (LCD_TRANSPORT == LCD_TRANSPORT_SPI) */
+
+#if ((LCD_BUS_MASK_PRIORITY != 0u) && (LCD_ASYNC_IRQ_PRIORITY < LCD_BUS_MASK_PRIORITY))
+    #error "LCD_ASYNC_IRQ_PRIORITY above LCD_BUS_MASK_PRIORITY, the TIM4 interrupt would run in the middle of a hand-off"
+#endif /* (LCD_BUS_MASK_PRIORITY != 0u) && (LCD_ASYNC_IRQ_PRIORITY < LCD_BUS_MASK_PRIORITY) */
+
+/* Single producer (foreground), single consumer (TIM4 interrupt) ring */
+static uint16_t LCD_asyncQueue[LCD_ASYNC_QUEUE_SIZE];
+static volatile uint16_t LCD_asyncHead = 0u;
+static volatile uint16_t LCD_asyncTail = 0u;
+
+#if (LCD_USE_ASYNC_URGENT != 0u)
+    #if ((LCD_ASYNC_URGENT_SIZE & (LCD_ASYNC_URGENT_SIZE - 1u)) != 0u)
+        #error "LCD_ASYNC_URGENT_SIZE must be a power of two"
+    #endif /* (LCD_ASYNC_URGENT_SIZE & (LCD_ASYNC_URGENT_SIZE - 1u)) != 0u */
+
+    /* Whole runs, published by moving the head past the last item */
+    static uint16_t LCD_asyncUrgent[LCD_ASYNC_URGENT_SIZE];
+    static volatile uint16_t LCD_asyncUrgentHead = 0u;
+    static volatile uint16_t LCD_asyncUrgentTail = 0u;
+
+    /* 1 from the first item of urgent runs until the urgent queue drained */
+    static uint8_t LCD_asyncUrgentActive = 0u;
+
+    /* Address command the normal queue is at, sent again before a normal item
+     * that continues at the address counter after urgent runs
+     */
+    static uint8_t LCD_asyncAddress = LCD_DDRAM_0;
+    static uint8_t LCD_asyncRestore = 0u;
+
+    static void LCD_AsyncTrack(uint16_t item) ;
+#endif /* LCD_USE_ASYNC_URGENT != 0u */
+
+/* 1 while the state machine owns the bus */
+static volatile uint8_t LCD_asyncRunning = 0u;
+
+static LCD_AsyncCallback LCD_asyncCallback = NULL;
+
+static void LCD_AsyncKick(void) ;
+static void LCD_AsyncStrobe(uint32_t bsrr) ;
+static void LCD_AsyncPulse(void) ;
+static void LCD_AsyncWaitTicks(uint16_t ticks) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_AsyncStart
+********************************************************************************
+*
+* Summary:
+*  Enables the TIM4 compare channel 1 interrupt used by the state machine.
+*  TIM4 must already be configured and running (MX_TIM4_Init and
+*  HAL_TIM_Base_Start in main.c).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_AsyncStart(void)
+{
+    LL_TIM_DisableIT_CC1(TIM4);
+    LL_TIM_ClearFlag_CC1(TIM4);
+    LL_TIM_EnableIT_CC1(TIM4);
+
+    HAL_NVIC_SetPriority(TIM4_IRQn, LCD_ASYNC_IRQ_PRIORITY, 0u);
+    HAL_NVIC_EnableIRQ(TIM4_IRQn);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WriteAsync
+********************************************************************************
+*
+* Summary:
+*  Queues one command or data byte and returns without waiting for the bus.
+*
+* Parameters:
+*  item: LCD_ITEM_CMD(cByte) or LCD_ITEM_DATA(dByte)
+*
+* Return:
+*  1 if queued, 0 if the queue is full or the display is not on the
+*  parallel bus.
+*
+* Reentrant:
+*  No, single producer.
+*
+*******************************************************************************/
+uint8_t LCD_WriteAsync(uint16_t item)
+{
+    uint16_t head = LCD_asyncHead;
+    uint16_t next = (uint16_t) ((head + 1u) & (LCD_ASYNC_QUEUE_SIZE - 1u));
+
+    if ((next == LCD_asyncTail) || (LCD_BUS_PRIMARY_IS_GPIO() == 0u))
+    {
+        return 0u;
+    }
+
+    LCD_asyncQueue[head] = item;
+    LCD_asyncHead = next;
+    LCD_STAT_PEAK(asyncQueuePeak, (uint16_t) ((next - LCD_asyncTail) & (LCD_ASYNC_QUEUE_SIZE - 1u)));
+
+    /* The queue moves the address counter behind LCD.c */
+    LCD_CursorInvalidate();
+
+    LCD_AsyncKick();
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WriteAsyncBuffer
+********************************************************************************
+*
+* Summary:
+*  Queues a run of items.
+*
+* Parameters:
+*  items: LCD_ITEM_CMD()/LCD_ITEM_DATA() entries
+*  count: Number of entries
+*
+* Return:
+*  Number of items queued (less than count if the queue filled up).
+*
+*******************************************************************************/
+uint16_t LCD_WriteAsyncBuffer(uint16_t const items[], uint16_t count)
+{
+    uint16_t index;
+
+    for (index = 0u; index < count; index++)
+    {
+        if (LCD_WriteAsync(items[index]) == 0u)
+        {
+            break;
+        }
+    }
+
+    return index;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintStringAsync
+********************************************************************************
+*
+* Summary:
+*  Queues a zero terminated string as data bytes.
+*
+* Parameters:
+*  string: Pointer to head of char8 array to be written to the LCD module
+*
+* Return:
+*  Number of characters queued.
+*
+*******************************************************************************/
+uint16_t LCD_PrintStringAsync(char const string[])
+{
+    uint16_t index = 0u;
+
+    while ((char) '\0' != string[index])
+    {
+        if (LCD_WriteAsync(LCD_ITEM_DATA(string[index])) == 0u)
+        {
+            break;
+        }
+        index++;
+    }
+
+    return index;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PositionAsync
+********************************************************************************
+*
+* Summary:
+*  Queues a set-DDRAM-address command.
+*
+* Parameters:
+*  row:    Specific row of LCD module to be written
+*  column: Column of LCD module to be written
+*
+* Return:
+*  1 if queued, 0 if the queue is full.
+*
+*******************************************************************************/
+uint8_t LCD_PositionAsync(uint8_t row, uint8_t column)
+{
+    return LCD_WriteAsync(LCD_ITEM_CMD(LCD_DdramAddress(row, column)));
+}
+
+
+#if (LCD_USE_ASYNC_URGENT != 0u)
+/*******************************************************************************
+* Function Name: LCD_WriteAsyncUrgent
+********************************************************************************
+*
+* Summary:
+*  Queues a run of items ahead of the normal queue. The run should begin
+*  with its own address command; it is sent as soon as the normal queue is
+*  idle or about to start a new run.
+*
+* Parameters:
+*  items: LCD_ITEM_CMD()/LCD_ITEM_DATA() entries
+*  count: Number of entries
+*
+* Return:
+*  1 if queued, 0 if the run does not fit (nothing is queued).
+*
+* Reentrant:
+*  No, single producer.
+*
+*******************************************************************************/
+uint8_t LCD_WriteAsyncUrgent(uint16_t const items[], uint16_t count)
+{
+    uint16_t head = LCD_asyncUrgentHead;
+    uint16_t index;
+
+    if ((count > ((LCD_asyncUrgentTail - head - 1u) & (LCD_ASYNC_URGENT_SIZE - 1u))) ||
+        (LCD_BUS_PRIMARY_IS_GPIO() == 0u))
+    {
+        return 0u;
+    }
+
+    for (index = 0u; index < count; index++)
+    {
+        LCD_asyncUrgent[head] = items[index];
+        head = (uint16_t) ((head + 1u) & (LCD_ASYNC_URGENT_SIZE - 1u));
+    }
+    LCD_asyncUrgentHead = head;
+
+    LCD_CursorInvalidate();
+
+    LCD_AsyncKick();
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintUrgentAsync
+********************************************************************************
+*
+* Summary:
+*  Queues a set-DDRAM-address command and a string as one urgent run.
+*
+* Parameters:
+*  row:    Specific row of LCD module to be written
+*  column: Column of LCD module to be written
+*  string: Pointer to head of char8 array, at most LCD_COLUMNS characters
+*          are sent
+*
+* Return:
+*  1 if queued, 0 if the run does not fit (nothing is queued).
+*
+*******************************************************************************/
+uint8_t LCD_PrintUrgentAsync(uint8_t row, uint8_t column, char const string[])
+{
+    uint16_t items[1u + LCD_COLUMNS];
+    uint16_t count = 0u;
+
+    items[count] = LCD_ITEM_CMD(LCD_DdramAddress(row, column));
+    count++;
+
+    while (((char) '\0' != string[count - 1u]) && (count < (1u + LCD_COLUMNS)))
+    {
+        items[count] = LCD_ITEM_DATA(string[count - 1u]);
+        count++;
+    }
+
+    return LCD_WriteAsyncUrgent(items, count);
+}
+#endif /* LCD_USE_ASYNC_URGENT != 0u */
+
+
+/*******************************************************************************
+* Function Name: LCD_IsIdle
+********************************************************************************
+*
+* Summary:
+*  Reports whether every queued item was sent and has finished executing.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 when idle, 0 while items are pending.
+*
+*******************************************************************************/
+uint8_t LCD_IsIdle(void)
+{
+    #if (LCD_USE_ASYNC_URGENT != 0u)
+        if (LCD_asyncUrgentHead != LCD_asyncUrgentTail)
+        {
+            return 0u;
+        }
+    #endif /* LCD_USE_ASYNC_URGENT != 0u */
+
+    return ((LCD_asyncRunning == 0u) && (LCD_asyncHead == LCD_asyncTail)) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SetAsyncCallback
+********************************************************************************
+*
+* Summary:
+*  Registers the function called when the queue becomes idle.
+*
+* Parameters:
+*  callback: Completion callback, NULL to disable
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_SetAsyncCallback(LCD_AsyncCallback callback)
+{
+    LCD_asyncCallback = callback;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AsyncIRQHandler
+********************************************************************************
+*
+* Summary:
+*  TIM4 compare channel 1 interrupt. The execution time of the previous byte
+*  has elapsed: send the next queued byte and schedule the next compare, or go
+*  idle when the queue is empty. Urgent items go first whenever the next
+*  normal item starts a run.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_AsyncIRQHandler(void)
+{
+    uint16_t item;
+    uint16_t tail;
+    uint32_t waitUs;
+
+    if (LL_TIM_IsActiveFlag_CC1(TIM4) == 0u)
+    {
+        return;
+    }
+    LL_TIM_ClearFlag_CC1(TIM4);
+
+    /* Compare matches again on every counter wrap while idle */
+    if (LCD_asyncRunning == 0u)
+    {
+        return;
+    }
+
+    tail = LCD_asyncTail;
+
+    #if (LCD_USE_ASYNC_URGENT != 0u)
+        if ((LCD_asyncUrgentTail != LCD_asyncUrgentHead) &&
+            ((LCD_asyncUrgentActive != 0u) || (tail == LCD_asyncHead) ||
+             LCD_ASYNC_IS_RUN_START(LCD_asyncQueue[tail])))
+        {
+            item = LCD_asyncUrgent[LCD_asyncUrgentTail];
+            LCD_asyncUrgentTail = (uint16_t) ((LCD_asyncUrgentTail + 1u) & (LCD_ASYNC_URGENT_SIZE - 1u));
+            LCD_asyncUrgentActive = 1u;
+            LCD_asyncRestore = 1u;
+        }
+        else
+    #endif /* LCD_USE_ASYNC_URGENT != 0u */
+    if (tail == LCD_asyncHead)
+    {
+        /* Last command finished executing */
+        LCD_asyncRunning = 0u;
+        #if (LCD_USE_ASYNC_URGENT != 0u)
+            LCD_asyncUrgentActive = 0u;
+        #endif /* LCD_USE_ASYNC_URGENT != 0u */
+        if (LCD_asyncCallback != NULL)
+        {
+            LCD_asyncCallback();
+        }
+        return;
+    }
+    else
+    {
+        item = LCD_asyncQueue[tail];
+
+        #if (LCD_USE_ASYNC_URGENT != 0u)
+            LCD_asyncUrgentActive = 0u;
+            if ((LCD_asyncRestore != 0u) && !LCD_ASYNC_IS_RUN_START(item))
+            {
+                /* Put the address counter back first, the item goes next time */
+                item = LCD_ITEM_CMD(LCD_asyncAddress);
+            }
+            else
+            {
+                LCD_AsyncTrack(item);
+                LCD_asyncTail = (uint16_t) ((tail + 1u) & (LCD_ASYNC_QUEUE_SIZE - 1u));
+            }
+            LCD_asyncRestore = 0u;
+        #else
+            LCD_asyncTail = (uint16_t) ((tail + 1u) & (LCD_ASYNC_QUEUE_SIZE - 1u));
+        #endif /* LCD_USE_ASYNC_URGENT != 0u */
+    }
+
+    /* RS selects data or instruction register, R/nW low to write; the pin
+    * map tables carry both in every nibble store
+    */
+    #if (LCD_USE_PIN_MAP == 0u)
+        WRITE_REG(RS_GPIO_Port->BSRR, ((item & LCD_ITEM_RS) != 0u) ? LCD_BSRR_SET(LCD_PIN_BITS(RS_Pin)) :
+                                                                     LCD_BSRR_RESET(LCD_PIN_BITS(RS_Pin)));
+        WRITE_REG(RnW_GPIO_Port->BSRR, LCD_BSRR_RESET(LCD_PIN_BITS(RnW_Pin)));
+    #endif /* LCD_USE_PIN_MAP == 0u */
+    LCD_BusInvalidate();
+
+    #if (LCD_USE_PIN_MAP != 0u)
+        LCD_MAP_WRITE(((item & LCD_ITEM_RS) != 0u) ? 1u : 0u, (item >> LCD_NIBBLE_SHIFT) & LCD_NIBBLE_MASK);
+        LCD_AsyncPulse();
+        LCD_MAP_WRITE(((item & LCD_ITEM_RS) != 0u) ? 1u : 0u, item & LCD_NIBBLE_MASK);
+        LCD_AsyncPulse();
+    #elif (LCD_BUS_8BIT != 0u)
+        LCD_AsyncStrobe(LCD_NIBBLE_BSRR((item >> LCD_NIBBLE_SHIFT) & LCD_NIBBLE_MASK) |
+                        LCD_LOW_NIBBLE_BSRR(item & LCD_NIBBLE_MASK));
+    #elif (LCD_USE_LOCKSTEP != 0u)
+        /* Mirrored to the DB4-DB7 of the lockstep display too */
+        LCD_AsyncStrobe(LCD_NIBBLE_BSRR((item >> LCD_NIBBLE_SHIFT) & LCD_NIBBLE_MASK) |
+                        LCD_LOW_NIBBLE_BSRR((item >> LCD_NIBBLE_SHIFT) & LCD_NIBBLE_MASK));
+        LCD_AsyncStrobe(LCD_NIBBLE_BSRR(item & LCD_NIBBLE_MASK) | LCD_LOW_NIBBLE_BSRR(item & LCD_NIBBLE_MASK));
+    #else
+        LCD_AsyncStrobe(LCD_NIBBLE_BSRR((item >> LCD_NIBBLE_SHIFT) & LCD_NIBBLE_MASK));
+        LCD_AsyncStrobe(LCD_NIBBLE_BSRR(item & LCD_NIBBLE_MASK));
+    #endif /* LCD_BUS_8BIT != 0u */
+
+    waitUs = (((item & LCD_ITEM_RS) == 0u) && LCD_IS_LONG_CMD(item & 0xFFu)) ?
+             LCD_EXEC_LONG_US : LCD_EXEC_SHORT_US;
+
+    /* Next interrupt once the byte has executed */
+    LL_TIM_OC_SetCompareCH1(TIM4, (LL_TIM_GetCounter(TIM4) + (waitUs * LCD_ASYNC_TICKS_PER_US)) & 0xFFFFu);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AsyncKick
+********************************************************************************
+*
+* Summary:
+*  Starts the state machine if it is idle by forcing a compare event.
+*
+*******************************************************************************/
+static void LCD_AsyncKick(void)
+{
+    uint32_t mask;
+
+    /* A compare match between the test and the forced event would start a
+     * second byte before the first one executed
+     */
+    LCD_BUS_ATOMIC_BEGIN(mask);
+    if (LCD_asyncRunning == 0u)
+    {
+        LCD_asyncRunning = 1u;
+        LL_TIM_GenerateEvent_CC1(TIM4);
+    }
+    LCD_BUS_ATOMIC_END(mask);
+}
+
+
+#if (LCD_USE_ASYNC_URGENT != 0u)
+/*******************************************************************************
+* Function Name: LCD_AsyncTrack
+********************************************************************************
+*
+* Summary:
+*  Follows the address counter through the normal queue (increment entry
+*  mode, the DDRAM line wrap of a 2-line display).
+*
+*******************************************************************************/
+static void LCD_AsyncTrack(uint16_t item)
+{
+    uint8_t const value = (uint8_t) item;
+    uint8_t address;
+
+    if ((item & LCD_ITEM_RS) == 0u)
+    {
+        if ((value & 0xC0u) != 0u)
+        {
+            LCD_asyncAddress = value;
+        }
+        else if (LCD_IS_LONG_CMD(value))
+        {
+            LCD_asyncAddress = LCD_DDRAM_0;
+        }
+        else
+        {
+            /* Mode and display commands leave the address counter */
+        }
+    }
+    else if ((LCD_asyncAddress & LCD_DDRAM_0) != 0u)
+    {
+        address = (uint8_t) ((LCD_asyncAddress + 1u) & LCD_DDRAM_ADDRESS_MASK);
+        if (address == LCD_DDRAM_LINE_LENGTH)
+        {
+            address = LCD_DDRAM_LINE_1;
+        }
+        else if (address == (LCD_DDRAM_LINE_1 + LCD_DDRAM_LINE_LENGTH))
+        {
+            address = 0x00u;
+        }
+        else
+        {
+            /* Same line */
+        }
+        LCD_asyncAddress = LCD_DDRAM_0 | address;
+    }
+    else
+    {
+        LCD_asyncAddress = LCD_CGRAM_0 | ((LCD_asyncAddress + 1u) & 0x3Fu);
+    }
+}
+#endif /* LCD_USE_ASYNC_URGENT != 0u */
+
+
+/*******************************************************************************
+* Function Name: LCD_AsyncStrobe
+********************************************************************************
+*
+* Summary:
+*  Drives one nibble (or byte on the 8-bit bus) and pulses E. The gaps (tAS 40 ns, PWEH 230 ns, tH 10 ns)
+*  are below the interrupt latency, so they are counted on TIM4 in place; one
+*  full tick is 250 ns.
+*
+* Parameters:
+*  bsrr: LCD_NIBBLE_BSRR() word of the nibble
+*
+*******************************************************************************/
+static void LCD_AsyncStrobe(uint32_t bsrr)
+{
+    WRITE_REG(DB4_GPIO_Port->BSRR, bsrr);
+    LCD_AsyncPulse();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AsyncPulse
+********************************************************************************
+*
+* Summary:
+*  The E pulse of LCD_AsyncStrobe() for data pins already driven (tAS, PWEH
+*  and tH on TIM4), on its own for the stores of the scattered pin map.
+*
+*******************************************************************************/
+static void LCD_AsyncPulse(void)
+{
+    LCD_AsyncWaitTicks(1u);
+
+    WRITE_REG(E_GPIO_Port->BSRR, LCD_BSRR_SET(LCD_PIN_BITS(E_Pin)));
+    LCD_AsyncWaitTicks(1u);
+
+    WRITE_REG(E_GPIO_Port->BSRR, LCD_BSRR_RESET(LCD_PIN_BITS(E_Pin)));
+    LCD_AsyncWaitTicks(1u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AsyncWaitTicks
+********************************************************************************
+*
+* Summary:
+*  Waits for at least "ticks" complete TIM4 periods without touching the
+*  counter.
+*
+*******************************************************************************/
+static void LCD_AsyncWaitTicks(uint16_t ticks)
+{
+    uint16_t start = (uint16_t) LL_TIM_GetCounter(TIM4);
+
+    while ((uint16_t) ((uint16_t) LL_TIM_GetCounter(TIM4) - start) <= ticks)
+    {
+    }
+}
+
+#endif /* LCD_USE_ASYNC != 0u */
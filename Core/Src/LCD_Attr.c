@@ -0,0 +1,377 @@
+/*
+ *  LCD_Attr.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Blinking and highlighted fields for the HD44780 LCD driver.
+ *
+ *  			The controller only blinks the cell under its cursor and has
+ *  			no inverse video. LCD_AttrSet() gives framebuffer cells flags
+ *  			instead: the character the application wrote is kept in
+ *  			LCD_attrText and LCD_frame holds what the cell shows. A
+ *  			blinking cell alternates between its character and a blank,
+ *  			a highlighted one shows an inverted copy of its glyph from
+ *  			CGRAM (LCD_GlyphAcquire()). LCD_AttrTask() changes the blink
+ *  			phase every LCD_ATTR_BLINK_MS and only rewrites the blinking
+ *  			cells, so a flush after a phase change sends those cells and
+ *  			nothing else; plain cells cost no extra traffic, and neither
+ *  			does a highlighted cell once its glyph is on the glass.
+ *
+ *  			The character generator ROM cannot be read back, so the
+ *  			inverse glyphs come from LCD_attrInverse: digits, capitals,
+ *  			space, '-', '.' and ':' (small letters are highlighted as
+ *  			capitals). Any other character, or one when all 8 CGRAM
+ *  			slots are on screen, is shown plain.
+ *
+ *  Usage:      - LCD_AttrSet(row, column, width, LCD_ATTR_BLINK) on a field,
+ *  				then print into it as usual; flags 0 makes it plain again
+ *  			- LCD_RefreshTask() advances the blink phase; without
+ *  				LCD_USE_REFRESH call LCD_AttrTask() from the main loop and
+ *  				flush when it returns 1
+ *  			- LCD_FrameClear() (and LCD_ClearDisplay()) drops every attribute,
+ *  				a new screen sets its own
+ *  			- text drawn straight into LCD_frame (marquee, console,
+ *  				remote frames) is not tracked, keep fields out of them
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Attr.h"
+#include "LCD_Frame.h"
+#include "LCD_Glyph.h"
+
+#if (LCD_USE_ATTRIBUTES != 0u)
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    #error "LCD_USE_ATTRIBUTES keeps its fields in the framebuffer (LCD_USE_FRAMEBUFFER)"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+#if (LCD_USE_GLYPH_CACHE == 0u)
+    #error "LCD_USE_ATTRIBUTES maps inverse glyphs through the glyph cache (LCD_USE_GLYPH_CACHE)"
+#endif /* LCD_USE_GLYPH_CACHE == 0u */
+
+/* Inverted 5x7 glyph with the cursor row set, from the rows of the ROM glyph */
+#define LCD_ATTR_INVERSE(r0, r1, r2, r3, r4, r5, r6) \
+    { (r0) ^ 0x1Fu, (r1) ^ 0x1Fu, (r2) ^ 0x1Fu, (r3) ^ 0x1Fu, \
+      (r4) ^ 0x1Fu, (r5) ^ 0x1Fu, (r6) ^ 0x1Fu, 0x1Fu }
+
+/* Characters of LCD_attrInverse, in table order */
+static char const LCD_attrCharset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ -.:";
+
+#define LCD_ATTR_INVERSE_COUNT       (sizeof(LCD_attrCharset) - 1u)
+
+/* Inverse of the A00 character ROM glyphs; const, so each glyph has one
+ * address for the glyph cache
+ */
+static uint8_t const LCD_attrInverse[LCD_ATTR_INVERSE_COUNT][LCD_GLYPH_ROWS] =
+{
+    LCD_ATTR_INVERSE(0x0Eu, 0x11u, 0x13u, 0x15u, 0x19u, 0x11u, 0x0Eu),  /* 0 */
+    LCD_ATTR_INVERSE(0x04u, 0x0Cu, 0x04u, 0x04u, 0x04u, 0x04u, 0x0Eu),  /* 1 */
+    LCD_ATTR_INVERSE(0x0Eu, 0x11u, 0x01u, 0x02u, 0x04u, 0x08u, 0x1Fu),  /* 2 */
+    LCD_ATTR_INVERSE(0x1Fu, 0x02u, 0x04u, 0x02u, 0x01u, 0x11u, 0x0Eu),  /* 3 */
+    LCD_ATTR_INVERSE(0x02u, 0x06u, 0x0Au, 0x12u, 0x1Fu, 0x02u, 0x02u),  /* 4 */
+    LCD_ATTR_INVERSE(0x1Fu, 0x10u, 0x1Eu, 0x01u, 0x01u, 0x11u, 0x0Eu),  /* 5 */
+    LCD_ATTR_INVERSE(0x06u, 0x08u, 0x10u, 0x1Eu, 0x11u, 0x11u, 0x0Eu),  /* 6 */
+    LCD_ATTR_INVERSE(0x1Fu, 0x01u, 0x02u, 0x04u, 0x08u, 0x08u, 0x08u),  /* 7 */
+    LCD_ATTR_INVERSE(0x0Eu, 0x11u, 0x11u, 0x0Eu, 0x11u, 0x11u, 0x0Eu),  /* 8 */
+    LCD_ATTR_INVERSE(0x0Eu, 0x11u, 0x11u, 0x0Fu, 0x01u, 0x02u, 0x0Cu),  /* 9 */
+    LCD_ATTR_INVERSE(0x0Eu, 0x11u, 0x11u, 0x11u, 0x1Fu, 0x11u, 0x11u),  /* A */
+    LCD_ATTR_INVERSE(0x1Eu, 0x11u, 0x11u, 0x1Eu, 0x11u, 0x11u, 0x1Eu),  /* B */
+    LCD_ATTR_INVERSE(0x0Eu, 0x11u, 0x10u, 0x10u, 0x10u, 0x11u, 0x0Eu),  /* C */
+    LCD_ATTR_INVERSE(0x1Cu, 0x12u, 0x11u, 0x11u, 0x11u, 0x12u, 0x1Cu),  /* D */
+    LCD_ATTR_INVERSE(0x1Fu, 0x10u, 0x10u, 0x1Eu, 0x10u, 0x10u, 0x1Fu),  /* E */
+    LCD_ATTR_INVERSE(0x1Fu, 0x10u, 0x10u, 0x1Eu, 0x10u, 0x10u, 0x10u),  /* F */
+    LCD_ATTR_INVERSE(0x0Eu, 0x11u, 0x10u, 0x17u, 0x11u, 0x11u, 0x0Fu),  /* G */
+    LCD_ATTR_INVERSE(0x11u, 0x11u, 0x11u, 0x1Fu, 0x11u, 0x11u, 0x11u),  /* H */
+    LCD_ATTR_INVERSE(0x0Eu, 0x04u, 0x04u, 0x04u, 0x04u, 0x04u, 0x0Eu),  /* I */
+    LCD_ATTR_INVERSE(0x07u, 0x02u, 0x02u, 0x02u, 0x02u, 0x12u, 0x0Cu),  /* J */
+    LCD_ATTR_INVERSE(0x11u, 0x12u, 0x14u, 0x18u, 0x14u, 0x12u, 0x11u),  /* K */
+    LCD_ATTR_INVERSE(0x10u, 0x10u, 0x10u, 0x10u, 0x10u, 0x10u, 0x1Fu),  /* L */
+    LCD_ATTR_INVERSE(0x11u, 0x1Bu, 0x15u, 0x15u, 0x11u, 0x11u, 0x11u),  /* M */
+    LCD_ATTR_INVERSE(0x11u, 0x11u, 0x19u, 0x15u, 0x13u, 0x11u, 0x11u),  /* N */
+    LCD_ATTR_INVERSE(0x0Eu, 0x11u, 0x11u, 0x11u, 0x11u, 0x11u, 0x0Eu),  /* O */
+    LCD_ATTR_INVERSE(0x1Eu, 0x11u, 0x11u, 0x1Eu, 0x10u, 0x10u, 0x10u),  /* P */
+    LCD_ATTR_INVERSE(0x0Eu, 0x11u, 0x11u, 0x11u, 0x15u, 0x12u, 0x0Du),  /* Q */
+    LCD_ATTR_INVERSE(0x1Eu, 0x11u, 0x11u, 0x1Eu, 0x14u, 0x12u, 0x11u),  /* R */
+    LCD_ATTR_INVERSE(0x0Fu, 0x10u, 0x10u, 0x0Eu, 0x01u, 0x01u, 0x1Eu),  /* S */
+    LCD_ATTR_INVERSE(0x1Fu, 0x04u, 0x04u, 0x04u, 0x04u, 0x04u, 0x04u),  /* T */
+    LCD_ATTR_INVERSE(0x11u, 0x11u, 0x11u, 0x11u, 0x11u, 0x11u, 0x0Eu),  /* U */
+    LCD_ATTR_INVERSE(0x11u, 0x11u, 0x11u, 0x11u, 0x11u, 0x0Au, 0x04u),  /* V */
+    LCD_ATTR_INVERSE(0x11u, 0x11u, 0x11u, 0x15u, 0x15u, 0x15u, 0x0Au),  /* W */
+    LCD_ATTR_INVERSE(0x11u, 0x11u, 0x0Au, 0x04u, 0x0Au, 0x11u, 0x11u),  /* X */
+    LCD_ATTR_INVERSE(0x11u, 0x11u, 0x11u, 0x0Au, 0x04u, 0x04u, 0x04u),  /* Y */
+    LCD_ATTR_INVERSE(0x1Fu, 0x01u, 0x02u, 0x04u, 0x08u, 0x10u, 0x1Fu),  /* Z */
+    LCD_ATTR_INVERSE(0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u),  /* space */
+    LCD_ATTR_INVERSE(0x00u, 0x00u, 0x00u, 0x1Fu, 0x00u, 0x00u, 0x00u),  /* - */
+    LCD_ATTR_INVERSE(0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x0Cu, 0x0Cu),  /* . */
+    LCD_ATTR_INVERSE(0x00u, 0x0Cu, 0x0Cu, 0x00u, 0x0Cu, 0x0Cu, 0x00u)   /* : */
+};
+
+uint8_t LCD_attrCell[LCD_ROWS][LCD_COLUMNS];
+
+/* Character written into each cell that has flags */
+static uint8_t LCD_attrText[LCD_ROWS][LCD_COLUMNS];
+
+/* Cells with LCD_ATTR_BLINK, LCD_AttrTask() has nothing to do at 0 */
+static uint16_t LCD_attrBlinks = 0u;
+
+/* 1 while blinking cells are hidden */
+static uint8_t LCD_attrHidden = 0u;
+
+/* HAL tick of the last blink phase change */
+static uint32_t LCD_attrTick = 0u;
+
+static uint8_t LCD_AttrRender(uint8_t row, uint8_t column) ;
+static uint8_t LCD_AttrInverseCode(uint8_t character) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_AttrSet
+********************************************************************************
+*
+* Summary:
+*  Gives a field of one row the same flags. The characters already in the
+*  framebuffer become the text of the field.
+*
+* Parameters:
+*  row:    Row of the framebuffer
+*  column: First column of the field
+*  width:  Number of cells, clipped at the end of the row
+*  flags:  LCD_ATTR_BLINK and/or LCD_ATTR_HIGHLIGHT, 0 = plain text again
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_AttrSet(uint8_t row, uint8_t column, uint8_t width, uint8_t flags)
+{
+    if (row >= LCD_ROWS)
+    {
+        return;
+    }
+
+    while ((width > 0u) && (column < LCD_COLUMNS))
+    {
+        if (LCD_attrCell[row][column] == 0u)
+        {
+            LCD_attrText[row][column] = LCD_frame[row][column];
+        }
+        if ((LCD_attrCell[row][column] & LCD_ATTR_BLINK) != 0u)
+        {
+            LCD_attrBlinks--;
+        }
+        if ((flags & LCD_ATTR_BLINK) != 0u)
+        {
+            LCD_attrBlinks++;
+        }
+
+        LCD_attrCell[row][column] = flags;
+        LCD_frame[row][column] = (flags == 0u) ? LCD_attrText[row][column] : LCD_AttrRender(row, column);
+
+        column++;
+        width--;
+    }
+
+    LCD_frameDirty = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AttrClear
+********************************************************************************
+*
+* Summary:
+*  Makes every field plain text again, with the characters written into it.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_AttrClear(void)
+{
+    uint8_t row;
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        LCD_AttrSet(row, 0u, LCD_COLUMNS, 0u);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AttrReset
+********************************************************************************
+*
+* Summary:
+*  Drops every attribute without touching the framebuffer. Called by
+*  LCD_FrameClear().
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_AttrReset(void)
+{
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            LCD_attrCell[row][column] = 0u;
+        }
+    }
+
+    LCD_attrBlinks = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AttrStore
+********************************************************************************
+*
+* Summary:
+*  Takes a character written into a cell that has flags. Called by
+*  LCD_FrameWriteChar() for those cells only.
+*
+* Parameters:
+*  row:       Row of the framebuffer
+*  column:    Column of the framebuffer
+*  character: Character the application wrote
+*
+* Return:
+*  Code the framebuffer cell holds for it.
+*
+*******************************************************************************/
+uint8_t LCD_AttrStore(uint8_t row, uint8_t column, uint8_t character)
+{
+    LCD_attrText[row][column] = character;
+
+    return LCD_AttrRender(row, column);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AttrTask
+********************************************************************************
+*
+* Summary:
+*  Changes the blink phase once LCD_ATTR_BLINK_MS passed since the last
+*  change, and rewrites the blinking cells in the framebuffer.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if blinking cells changed and want a flush, 0 otherwise.
+*
+*******************************************************************************/
+uint8_t LCD_AttrTask(void)
+{
+    uint32_t const now = HAL_GetTick();
+    uint8_t row;
+    uint8_t column;
+
+    if ((uint32_t) (now - LCD_attrTick) < LCD_ATTR_BLINK_MS)
+    {
+        return 0u;
+    }
+
+    LCD_attrTick = now;
+    LCD_attrHidden ^= 1u;
+
+    if (LCD_attrBlinks == 0u)
+    {
+        return 0u;
+    }
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            if ((LCD_attrCell[row][column] & LCD_ATTR_BLINK) != 0u)
+            {
+                LCD_frame[row][column] = LCD_AttrRender(row, column);
+            }
+        }
+    }
+
+    LCD_frameDirty = 1u;
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AttrRender
+********************************************************************************
+*
+* Summary:
+*  Returns the code a cell with flags shows in the current blink phase. A
+*  highlighted field that blinks is plain while hidden.
+*
+*******************************************************************************/
+static uint8_t LCD_AttrRender(uint8_t row, uint8_t column)
+{
+    uint8_t const flags = LCD_attrCell[row][column];
+    uint8_t const character = LCD_attrText[row][column];
+    uint8_t code;
+
+    if (((flags & LCD_ATTR_BLINK) != 0u) && (LCD_attrHidden != 0u))
+    {
+        return ((flags & LCD_ATTR_HIGHLIGHT) != 0u) ? character : LCD_FRAME_BLANK;
+    }
+
+    if ((flags & LCD_ATTR_HIGHLIGHT) != 0u)
+    {
+        code = LCD_AttrInverseCode(character);
+        if (code != LCD_GLYPH_NO_SLOT)
+        {
+            return code;
+        }
+    }
+
+    return character;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_AttrInverseCode
+********************************************************************************
+*
+* Summary:
+*  Returns the CGRAM code of the inverse glyph of a character, or
+*  LCD_GLYPH_NO_SLOT if it has none or no slot is free.
+*
+*******************************************************************************/
+static uint8_t LCD_AttrInverseCode(uint8_t character)
+{
+    uint8_t index = 0u;
+
+    if ((character >= (uint8_t) 'a') && (character <= (uint8_t) 'z'))
+    {
+        character -= (uint8_t) ('a' - 'A');
+    }
+
+    while ((index < LCD_ATTR_INVERSE_COUNT) && ((uint8_t) LCD_attrCharset[index] != character))
+    {
+        index++;
+    }
+
+    if (index == LCD_ATTR_INVERSE_COUNT)
+    {
+        return LCD_GLYPH_NO_SLOT;
+    }
+
+    return LCD_GlyphAcquire(LCD_attrInverse[index]);
+}
+
+#endif /* LCD_USE_ATTRIBUTES != 0u */
@@ -0,0 +1,331 @@
+/*
+ *  LCD_Backlight.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: PWM backlight with fades and inactivity auto-dim.
+ *
+ *  			Light_LCD (PB0) is TIM3 channel 3. TIM3 runs PWM mode 1 with
+ *  			255 counts per period, so the compare value is the brightness
+ *  			(0 = off, 255 = on) and the hardware keeps the duty cycle
+ *  			without any CPU involvement. Fades are stepped once per
+ *  			millisecond from the HAL tick interrupt that already runs, in
+ *  			16.16 fixed point so slow ramps still move smoothly; no extra
+ *  			interrupt source is used.
+ *
+ *  			With LCD_BACKLIGHT_AUTODIM_MS set, the backlight fades to
+ *  			LCD_BACKLIGHT_DIM_LEVEL after that long without activity and
+ *  			back to the set level on the next activity. Activity is
+ *  			LCD_BacklightActivity() and, with LCD_BACKLIGHT_DIM_ON_WRITES,
+ *  			every write to the display on E_Pin (seen from the write
+ *  			timestamp, so the write path is not touched).
+ *
+ *  Usage:      - LCD_BacklightStart() once, replaces the GPIO output
+ *  				configuration of Light_LCD from MX_GPIO_Init()
+ *  			- call LCD_BacklightTick() from SysTick_Handler
+ *  			- TIM3 is owned by this module
+ *
+ */
+#include "main.h"
+#include "stm32f1xx_ll_bus.h"
+#include "stm32f1xx_ll_tim.h"
+#include "LCD.h"
+#include "LCD_Handle.h"
+#include "LCD_Transport.h"
+#include "LCD_Backlight.h"
+
+#if (LCD_USE_BACKLIGHT_PWM != 0u)
+
+/* 256 compare values, ARR = 254: level 255 is above ARR and stays high */
+#define LCD_BACKLIGHT_ARR            (LCD_BACKLIGHT_MAX - 1u)
+#define LCD_BACKLIGHT_FIXED_SHIFT    (16u)
+
+/* Level in 16.16 fixed point and the fade still running (SysTick context) */
+static volatile uint32_t LCD_backlightLevel = 0u;
+static volatile int32_t LCD_backlightStep = 0;
+static volatile uint16_t LCD_backlightFadeMs = 0u;
+static volatile uint8_t LCD_backlightTarget = 0u;
+
+/* Level set by the application, restored after auto-dim */
+static uint8_t LCD_backlightUserLevel = 0u;
+
+#if (LCD_BACKLIGHT_AUTODIM_MS != 0u)
+    static volatile uint32_t LCD_backlightIdleMs = 0u;
+    static volatile uint8_t LCD_backlightDimmed = 0u;
+    #if (LCD_BACKLIGHT_DIM_ON_WRITES != 0u)
+        static uint32_t LCD_backlightLastWrite = 0u;
+    #endif /* LCD_BACKLIGHT_DIM_ON_WRITES != 0u */
+#endif /* LCD_BACKLIGHT_AUTODIM_MS != 0u */
+
+static void LCD_BacklightRamp(uint8_t level, uint16_t ms) ;
+static void LCD_BacklightApply(uint8_t level) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_BacklightStart
+********************************************************************************
+*
+* Summary:
+*  Configures TIM3 channel 3 for PWM at LCD_BACKLIGHT_PWM_HZ, switches PB0 to
+*  the timer output and starts with the backlight off.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_BacklightStart(void)
+{
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM3);
+
+    LL_TIM_SetPrescaler(TIM3, (SystemCoreClock / (LCD_BACKLIGHT_PWM_HZ * (LCD_BACKLIGHT_ARR + 1u))) - 1u);
+    LL_TIM_SetAutoReload(TIM3, LCD_BACKLIGHT_ARR);
+    LL_TIM_EnableARRPreload(TIM3);
+
+    LL_TIM_OC_SetMode(TIM3, LL_TIM_CHANNEL_CH3, LL_TIM_OCMODE_PWM1);
+    LL_TIM_OC_SetPolarity(TIM3, LL_TIM_CHANNEL_CH3, LL_TIM_OCPOLARITY_HIGH);
+    LL_TIM_OC_EnablePreload(TIM3, LL_TIM_CHANNEL_CH3);
+    LL_TIM_OC_SetCompareCH3(TIM3, LCD_BACKLIGHT_OFF);
+    LL_TIM_CC_EnableChannel(TIM3, LL_TIM_CHANNEL_CH3);
+
+    /* Load prescaler and preloaded registers, then run */
+    LL_TIM_GenerateEvent_UPDATE(TIM3);
+    LL_TIM_EnableCounter(TIM3);
+
+    LL_GPIO_SetPinMode(Light_LCD_GPIO_Port, Light_LCD_Pin, LL_GPIO_MODE_ALTERNATE);
+    LL_GPIO_SetPinOutputType(Light_LCD_GPIO_Port, Light_LCD_Pin, LL_GPIO_OUTPUT_PUSHPULL);
+
+    LCD_backlightFadeMs = 0u;
+    LCD_backlightLevel = 0u;
+    LCD_backlightUserLevel = LCD_BACKLIGHT_OFF;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SetBacklight
+********************************************************************************
+*
+* Summary:
+*  Sets the brightness at once, cancelling a fade in progress.
+*
+* Parameters:
+*  level: LCD_BACKLIGHT_OFF to LCD_BACKLIGHT_MAX
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_SetBacklight(uint8_t level)
+{
+    LCD_BacklightActivity();
+    LCD_backlightUserLevel = level;
+    LCD_BacklightRamp(level, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FadeBacklight
+********************************************************************************
+*
+* Summary:
+*  Fades linearly from the current brightness to "level". Returns at once,
+*  the ramp runs in LCD_BacklightTick().
+*
+* Parameters:
+*  level: Final brightness, LCD_BACKLIGHT_OFF to LCD_BACKLIGHT_MAX
+*  ms:    Fade duration in milliseconds (0 = immediate)
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FadeBacklight(uint8_t level, uint16_t ms)
+{
+    LCD_BacklightActivity();
+    LCD_backlightUserLevel = level;
+    LCD_BacklightRamp(level, ms);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GetBacklight
+********************************************************************************
+*
+* Summary:
+*  Returns the brightness driven right now (mid-fade value during a fade).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  LCD_BACKLIGHT_OFF to LCD_BACKLIGHT_MAX.
+*
+*******************************************************************************/
+uint8_t LCD_GetBacklight(void)
+{
+    return (uint8_t) (LCD_backlightLevel >> LCD_BACKLIGHT_FIXED_SHIFT);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BacklightIsFading
+********************************************************************************
+*
+* Summary:
+*  Reports whether a fade (application or auto-dim) is in progress.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 while fading, 0 otherwise.
+*
+*******************************************************************************/
+uint8_t LCD_BacklightIsFading(void)
+{
+    return (LCD_backlightFadeMs != 0u) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BacklightActivity
+********************************************************************************
+*
+* Summary:
+*  Restarts the inactivity timer (key press, touch, ...). A dimmed backlight
+*  returns to the set level over LCD_BACKLIGHT_WAKE_MS.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_BacklightActivity(void)
+{
+    #if (LCD_BACKLIGHT_AUTODIM_MS != 0u)
+        LCD_backlightIdleMs = 0u;
+        if (LCD_backlightDimmed != 0u)
+        {
+            LCD_backlightDimmed = 0u;
+            LCD_BacklightRamp(LCD_backlightUserLevel, LCD_BACKLIGHT_WAKE_MS);
+        }
+    #endif /* LCD_BACKLIGHT_AUTODIM_MS != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BacklightTick
+********************************************************************************
+*
+* Summary:
+*  1 ms step of fades and of the inactivity timer, from SysTick_Handler.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_BacklightTick(void)
+{
+    #if (LCD_BACKLIGHT_AUTODIM_MS != 0u)
+        #if (LCD_BACKLIGHT_DIM_ON_WRITES != 0u)
+            /* Every write to the module moves its timestamp */
+            if (LCD_display0.timingStart != LCD_backlightLastWrite)
+            {
+                LCD_backlightLastWrite = LCD_display0.timingStart;
+                LCD_BacklightActivity();
+            }
+        #endif /* LCD_BACKLIGHT_DIM_ON_WRITES != 0u */
+
+        if (LCD_backlightIdleMs < LCD_BACKLIGHT_AUTODIM_MS)
+        {
+            LCD_backlightIdleMs++;
+        }
+        else if ((LCD_backlightDimmed == 0u) && (LCD_backlightUserLevel > LCD_BACKLIGHT_DIM_LEVEL))
+        {
+            LCD_backlightDimmed = 1u;
+            LCD_BacklightRamp(LCD_BACKLIGHT_DIM_LEVEL, LCD_BACKLIGHT_DIM_FADE_MS);
+        }
+        else
+        {
+            /* Already dimmed, or set below the dim level */
+        }
+    #endif /* LCD_BACKLIGHT_AUTODIM_MS != 0u */
+
+    if (LCD_backlightFadeMs == 0u)
+    {
+        return;
+    }
+
+    LCD_backlightFadeMs--;
+    if (LCD_backlightFadeMs == 0u)
+    {
+        /* Land exactly on the target, no rounding residue */
+        LCD_backlightLevel = (uint32_t) LCD_backlightTarget << LCD_BACKLIGHT_FIXED_SHIFT;
+    }
+    else
+    {
+        LCD_backlightLevel = (uint32_t) ((int32_t) LCD_backlightLevel + LCD_backlightStep);
+    }
+
+    LCD_BacklightApply((uint8_t) (LCD_backlightLevel >> LCD_BACKLIGHT_FIXED_SHIFT));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BacklightRamp
+********************************************************************************
+*
+* Summary:
+*  Starts a fade from the current level to "level" over "ms" ticks (or sets it
+*  at once for 0). The tick interrupt (TICK_INT_PRIORITY, below
+*  LCD_BUS_MASK_PRIORITY) is masked while the fade state changes.
+*
+*******************************************************************************/
+static void LCD_BacklightRamp(uint8_t level, uint16_t ms)
+{
+    uint32_t saved;
+    int32_t distance;
+
+    LCD_BUS_ATOMIC_BEGIN(saved);
+
+    distance = ((int32_t) level << LCD_BACKLIGHT_FIXED_SHIFT) - (int32_t) LCD_backlightLevel;
+    LCD_backlightTarget = level;
+
+    if (ms == 0u)
+    {
+        LCD_backlightFadeMs = 0u;
+        LCD_backlightLevel = (uint32_t) level << LCD_BACKLIGHT_FIXED_SHIFT;
+        LCD_BacklightApply(level);
+    }
+    else
+    {
+        LCD_backlightStep = distance / (int32_t) ms;
+        LCD_backlightFadeMs = ms;
+    }
+
+    LCD_BUS_ATOMIC_END(saved);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BacklightApply
+********************************************************************************
+*
+* Summary:
+*  Loads the compare value, takes effect at the next PWM period (preload).
+*
+*******************************************************************************/
+static void LCD_BacklightApply(uint8_t level)
+{
+    LL_TIM_OC_SetCompareCH3(TIM3, level);
+}
+
+#endif /* LCD_USE_BACKLIGHT_PWM != 0u */
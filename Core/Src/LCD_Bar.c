@@ -0,0 +1,311 @@
+/*
+ *  LCD_Bar.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Horizontal and vertical bargraphs for the HD44780 LCD driver.
+ *
+ *  			Bars have pixel resolution: a horizontal cell holds 0 - 5 lit
+ *  			columns, a vertical cell 0 - 8 lit rows. Empty and full cells
+ *  			use the ROM blank (0x20) and full block (0xFF) characters, the
+ *  			partial cells use CGRAM glyphs (through the glyph manager, or the
+ *  			LCD_HORIZONTAL_BG/LCD_VERTICAL_BG set loaded by LCD_Init()).
+ *
+ *  			The last value of up to LCD_BAR_TRACKED bargraphs is kept, so
+ *  			an update only rewrites the cells between the old and the new
+ *  			boundary (one or two cells for small changes) instead of all
+ *  			maxCharacters cells.
+ *
+ *  Usage:      - without LCD_USE_GLYPH_CACHE, load the matching
+ *  				LCD_CUSTOM_CHAR_SET (partial glyph of k pixels = code k-1)
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Glyph.h"
+#include "LCD_Bar.h"
+
+/* Partial cells, glyph k-1 lights k pixels: columns from the left
+ * (horizontal) or rows from the bottom (vertical)
+ */
+#if (LCD_CUSTOM_CHAR_SET == LCD_HORIZONTAL_BG)
+    /* The horizontal set is the one LCD_Init() loads */
+    #define LCD_BAR_H_FONT           LCD_customFonts
+    #define LCD_BAR_H_STORAGE
+#else
+    #define LCD_BAR_H_FONT           LCD_barHorizontal
+    #define LCD_BAR_H_STORAGE        static
+#endif /* LCD_CUSTOM_CHAR_SET == LCD_HORIZONTAL_BG */
+
+#if (LCD_CUSTOM_CHAR_SET == LCD_VERTICAL_BG)
+    #define LCD_BAR_V_FONT           LCD_customFonts
+    #define LCD_BAR_V_STORAGE
+#else
+    #define LCD_BAR_V_FONT           LCD_barVertical
+    #define LCD_BAR_V_STORAGE        static
+#endif /* LCD_CUSTOM_CHAR_SET == LCD_VERTICAL_BG */
+
+LCD_BAR_H_STORAGE uint8_t const LCD_BAR_H_FONT[LCD_CUSTOM_CHAR_SET_LEN] =
+{
+    0x10u, 0x10u, 0x10u, 0x10u, 0x10u, 0x10u, 0x10u, 0x10u,
+    0x18u, 0x18u, 0x18u, 0x18u, 0x18u, 0x18u, 0x18u, 0x18u,
+    0x1Cu, 0x1Cu, 0x1Cu, 0x1Cu, 0x1Cu, 0x1Cu, 0x1Cu, 0x1Cu,
+    0x1Eu, 0x1Eu, 0x1Eu, 0x1Eu, 0x1Eu, 0x1Eu, 0x1Eu, 0x1Eu,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u
+};
+
+LCD_BAR_V_STORAGE uint8_t const LCD_BAR_V_FONT[LCD_CUSTOM_CHAR_SET_LEN] =
+{
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x1Fu,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x1Fu, 0x1Fu,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x1Fu, 0x1Fu, 0x1Fu,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x1Fu, 0x1Fu, 0x1Fu, 0x1Fu,
+    0x00u, 0x00u, 0x00u, 0x1Fu, 0x1Fu, 0x1Fu, 0x1Fu, 0x1Fu,
+    0x00u, 0x00u, 0x1Fu, 0x1Fu, 0x1Fu, 0x1Fu, 0x1Fu, 0x1Fu,
+    0x00u, 0x1Fu, 0x1Fu, 0x1Fu, 0x1Fu, 0x1Fu, 0x1Fu, 0x1Fu,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u
+};
+
+/* Last drawn state of a bargraph, keyed by origin and orientation */
+typedef struct
+{
+    uint8_t row;
+    uint8_t column;
+    uint8_t orientation;
+    uint8_t maxCharacters;
+    uint8_t value;
+} LCD_BAR_STATE;
+
+static LCD_BAR_STATE LCD_barState[LCD_BAR_TRACKED];
+static uint8_t LCD_barNext = 0u;
+
+static void LCD_DrawBar(uint8_t orientation, uint8_t row, uint8_t column, uint8_t maxCharacters, uint8_t value) ;
+static LCD_BAR_STATE *LCD_BarFind(uint8_t orientation, uint8_t row, uint8_t column, uint8_t maxCharacters) ;
+static char LCD_BarCell(uint8_t orientation, uint8_t value, uint8_t cell) ;
+
+
+/*******************************************************************************
+*  Function Name: LCD_DrawHorizontalBG
+********************************************************************************
+*
+* Summary:
+*  Draws a horizontal bargraph growing to the right from (row, column).
+*
+* Parameters:
+*  row:           The row of the first character of the bargraph
+*  column:        The column of the first character of the bargraph
+*  maxCharacters: Length of the bargraph in characters
+*  value:         Lit pixels, 0 - (5 * maxCharacters)
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_DrawHorizontalBG(uint8_t row, uint8_t column, uint8_t maxCharacters, uint8_t value)
+{
+    LCD_DrawBar(LCD_BAR_HORIZONTAL, row, column, maxCharacters, value);
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_DrawVerticalBG
+********************************************************************************
+*
+* Summary:
+*  Draws a vertical bargraph growing upwards from (row, column).
+*
+* Parameters:
+*  row:           The row of the bottom character of the bargraph
+*  column:        The column of the bargraph
+*  maxCharacters: Height of the bargraph in characters (at most row + 1)
+*  value:         Lit pixels, 0 - (8 * maxCharacters)
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_DrawVerticalBG(uint8_t row, uint8_t column, uint8_t maxCharacters, uint8_t value)
+{
+    if (maxCharacters > (uint8_t) (row + 1u))
+    {
+        maxCharacters = row + 1u;
+    }
+
+    LCD_DrawBar(LCD_BAR_VERTICAL, row, column, maxCharacters, value);
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_BarInvalidate
+********************************************************************************
+*
+* Summary:
+*  Forgets every remembered bargraph, the next draw of each one rewrites all
+*  of its cells. Called on clear display and initialization.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_BarInvalidate(void)
+{
+    uint8_t index;
+
+    for (index = 0u; index < LCD_BAR_TRACKED; index++)
+    {
+        LCD_barState[index].maxCharacters = 0u;
+        LCD_barState[index].value = LCD_BAR_UNUSED;
+    }
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_DrawBar
+********************************************************************************
+*
+* Summary:
+*  Rewrites the cells of a bargraph that differ from its remembered value, or
+*  all cells the first time it is drawn.
+*
+*******************************************************************************/
+static void LCD_DrawBar(uint8_t orientation, uint8_t row, uint8_t column, uint8_t maxCharacters, uint8_t value)
+{
+    uint8_t pixels = (orientation == LCD_BAR_HORIZONTAL) ? LCD_CHARACTER_WIDTH : LCD_CHARACTER_HEIGHT;
+    uint16_t limit = (uint16_t) pixels * maxCharacters;
+    LCD_BAR_STATE *state;
+    uint8_t first = 0u;
+    uint8_t last = maxCharacters;
+    uint8_t cell;
+
+    if (maxCharacters == 0u)
+    {
+        return;
+    }
+
+    if (value > limit)
+    {
+        value = (uint8_t) limit;
+    }
+
+    state = LCD_BarFind(orientation, row, column, maxCharacters);
+
+    if (state->value != LCD_BAR_UNUSED)
+    {
+        /* Only the cells between the old and the new boundary change */
+        first = ((state->value < value) ? state->value : value) / pixels;
+        last = (uint8_t) ((((state->value > value) ? state->value : value) + pixels - 1u) / pixels);
+        last = (last > maxCharacters) ? maxCharacters : last;
+    }
+    state->value = value;
+
+    for (cell = first; cell < last; cell++)
+    {
+        if (orientation == LCD_BAR_HORIZONTAL)
+        {
+            /* Consecutive cells, the address counter auto-increments */
+            if (cell == first)
+            {
+                LCD_Position(row, column + first);
+            }
+        }
+        else
+        {
+            LCD_Position(row - cell, column);
+        }
+
+        LCD_PutChar(LCD_BarCell(orientation, value, cell));
+    }
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_BarCell
+********************************************************************************
+*
+* Summary:
+*  Returns the character of one cell of a bargraph.
+*
+*******************************************************************************/
+static char LCD_BarCell(uint8_t orientation, uint8_t value, uint8_t cell)
+{
+    uint8_t pixels = (orientation == LCD_BAR_HORIZONTAL) ? LCD_CHARACTER_WIDTH : LCD_CHARACTER_HEIGHT;
+    uint16_t start = (uint16_t) cell * pixels;
+    uint8_t lit;
+    uint8_t code;
+
+    if (value <= start)
+    {
+        return (char) LCD_BAR_EMPTY;
+    }
+
+    lit = (uint8_t) (value - start);
+    if (lit >= pixels)
+    {
+        return (char) LCD_BAR_FULL;
+    }
+
+    #if (LCD_USE_GLYPH_CACHE != 0u)
+        code = LCD_GlyphAcquire((orientation == LCD_BAR_HORIZONTAL) ?
+                                &LCD_BAR_H_FONT[(lit - 1u) * LCD_GLYPH_ROWS] :
+                                &LCD_BAR_V_FONT[(lit - 1u) * LCD_GLYPH_ROWS]);
+        if (code == LCD_GLYPH_NO_SLOT)
+        {
+            /* Round to the nearest whole cell */
+            return (char) (((lit * 2u) >= pixels) ? LCD_BAR_FULL : LCD_BAR_EMPTY);
+        }
+    #else
+        code = lit - 1u;
+    #endif /* LCD_USE_GLYPH_CACHE != 0u */
+
+    return (char) code;
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_BarFind
+********************************************************************************
+*
+* Summary:
+*  Returns the remembered state of a bargraph; a new one (value
+*  LCD_BAR_UNUSED, oldest slot reused) if it was not drawn before or its
+*  length changed.
+*
+*******************************************************************************/
+static LCD_BAR_STATE *LCD_BarFind(uint8_t orientation, uint8_t row, uint8_t column, uint8_t maxCharacters)
+{
+    LCD_BAR_STATE *state;
+    uint8_t index;
+
+    for (index = 0u; index < LCD_BAR_TRACKED; index++)
+    {
+        state = &LCD_barState[index];
+        if ((state->row == row) && (state->column == column) && (state->orientation == orientation) &&
+            (state->maxCharacters != 0u))
+        {
+            if (state->maxCharacters != maxCharacters)
+            {
+                state->maxCharacters = maxCharacters;
+                state->value = LCD_BAR_UNUSED;
+            }
+            return state;
+        }
+    }
+
+    state = &LCD_barState[LCD_barNext];
+    LCD_barNext = (uint8_t) ((LCD_barNext + 1u) % LCD_BAR_TRACKED);
+
+    state->row = row;
+    state->column = column;
+    state->orientation = orientation;
+    state->maxCharacters = maxCharacters;
+    state->value = LCD_BAR_UNUSED;
+
+    return state;
+}
@@ -0,0 +1,471 @@
+/*
+ *  LCD_Bench.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: On-target throughput benchmark of the HD44780 LCD driver.
+ *
+ *  			Built only in the "Benchmark" build configuration (LCD_BENCHMARK
+ *  			defined, Release optimization). LCD_BenchRun() times a fixed
+ *  			suite (single char, full line, full frame, numeric counter,
+ *  			clear, CGRAM upload) under every wait mode and transport (busy
+ *  			polling, fixed datasheet delays, elapsed-skip, calibrated timed
+ *  			writes, DMA, interrupt queue) on the DWT cycle counter and prints
+ *  			us/op and chars/s over ITM stimulus port 0 (SWO).
+ *
+ *  			Every case runs LCD_BENCH_REPEAT operations back to back and
+ *  			the timing closes once the module finished the last one, so
+ *  			execution times are included the same way for every mode.
+ *
+ *  Usage:      - "LCD_2-line Benchmark.launch", SWV enabled, core clock
+ *  				72 MHz; open the SWV ITM Data Console on port 0
+ *  			- modes whose transport is not compiled in (LCD_Config.h) or
+ *  				fails to start are reported as "n/a"
+ *  			- the display is cleared and the CGRAM reloaded afterwards
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Timing.h"
+#include "LCD_Format.h"
+#include "LCD_Glyph.h"
+#include "LCD_Frame.h"
+#include "LCD_Dma.h"
+#include "LCD_Async.h"
+#include "LCD_Bench.h"
+
+#ifdef LCD_BENCHMARK
+
+static char const *const LCD_benchModeNames[LCD_BENCH_MODES] =
+{
+    "poll      ", "fixed     ", "elapsed   ", "calibrated", "dma       ", "async     "
+};
+
+static char const *const LCD_benchCaseNames[LCD_BENCH_CASES] =
+{
+    "char    ", "line    ", "frame   ", "counter ", "clear   ", "cgram   "
+};
+
+/* Characters moved by one operation of each case */
+static uint16_t const LCD_benchCaseChars[LCD_BENCH_CASES] =
+{
+    1u, LCD_COLUMNS, LCD_ROWS * LCD_COLUMNS, LCD_BENCH_COUNTER_DIGITS, 0u, LCD_BENCH_CGRAM_BYTES
+};
+
+static uint8_t LCD_benchText[LCD_BENCH_CGRAM_BYTES > LCD_COLUMNS ? LCD_BENCH_CGRAM_BYTES : LCD_COLUMNS];
+static uint16_t LCD_benchItems[LCD_BENCH_ITEMS_MAX];
+
+static uint8_t LCD_BenchSetMode(uint8_t mode) ;
+static void LCD_BenchOp(uint8_t mode, uint8_t test, uint32_t iteration) ;
+static void LCD_BenchBlockingOp(uint8_t test, uint32_t iteration) ;
+static uint16_t LCD_BenchItems(uint8_t test, uint32_t iteration) ;
+static void LCD_BenchSettle(uint8_t mode) ;
+static void LCD_BenchReport(uint8_t mode, uint8_t test, uint32_t cycles) ;
+static void LCD_BenchPrint(char const string[]) ;
+static void LCD_BenchPrintU32(uint32_t value, uint8_t width, char pad) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_BenchRun
+********************************************************************************
+*
+* Summary:
+*  Runs every case under every mode and prints one line per result. Call
+*  once after LCD_Start().
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_BenchRun(void)
+{
+    uint8_t mode;
+    uint8_t test;
+    uint32_t iteration;
+    uint32_t start;
+    uint8_t index;
+
+    for (index = 0u; index < sizeof(LCD_benchText); index++)
+    {
+        LCD_benchText[index] = (uint8_t) ('A' + (index % 26u));
+    }
+
+    LCD_BenchPrint("\nLCD bench ");
+    LCD_BenchPrint((LCD_BUS_8BIT != 0u) ? "8-bit" : "4-bit");
+    LCD_BenchPrint(", core MHz ");
+    LCD_BenchPrintU32(LCD_cyclesPerUs, 0u, ' ');
+    LCD_BenchPrint(", ops/case ");
+    LCD_BenchPrintU32(LCD_BENCH_REPEAT, 0u, ' ');
+    LCD_BenchPrint("\nmode       case          us/op    chars/s\n");
+
+    for (mode = 0u; mode < LCD_BENCH_MODES; mode++)
+    {
+        if (LCD_BenchSetMode(mode) == 0u)
+        {
+            LCD_BenchPrint(LCD_benchModeNames[mode]);
+            LCD_BenchPrint(" n/a\n");
+            continue;
+        }
+
+        for (test = 0u; test < LCD_BENCH_CASES; test++)
+        {
+            /* Start from an idle module */
+            LCD_BenchSettle(mode);
+
+            start = LCD_CYCLES();
+            for (iteration = 0u; iteration < LCD_BENCH_REPEAT; iteration++)
+            {
+                LCD_BenchOp(mode, test, iteration);
+            }
+            LCD_BenchSettle(mode);
+
+            LCD_BenchReport(mode, test, (uint32_t) (LCD_CYCLES() - start));
+        }
+    }
+
+    /* Back to the default driver state */
+    LCD_TimingInit();
+    LCD_SetTimedMode(0u);
+    LCD_SetElapsedSkip(1u);
+    LCD_ClearDisplay();
+    #if (LCD_USE_GLYPH_CACHE != 0u)
+        LCD_GlyphReset();
+    #endif /* LCD_USE_GLYPH_CACHE != 0u */
+    #if (LCD_CUSTOM_CHAR_SET != LCD_NONE)
+        LCD_LoadCustomFonts(LCD_customFonts);
+    #endif /* LCD_CUSTOM_CHAR_SET != LCD_NONE */
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        LCD_FrameInvalidate();
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BenchSetMode
+********************************************************************************
+*
+* Summary:
+*  Selects the wait mode or starts the transport of "mode". Returns 0 when
+*  the mode is not available.
+*
+*******************************************************************************/
+static uint8_t LCD_BenchSetMode(uint8_t mode)
+{
+    uint8_t available = 1u;
+
+    /* Datasheet execution times, busy polling (no calibration) */
+    LCD_TimingInit();
+    LCD_SetTimedMode(0u);
+    LCD_SetElapsedSkip(1u);
+
+    switch (mode)
+    {
+        case LCD_BENCH_POLL:
+            LCD_SetElapsedSkip(0u);
+            break;
+        case LCD_BENCH_FIXED:
+            LCD_SetTimedMode(1u);
+            break;
+        case LCD_BENCH_CALIBRATED:
+            available = LCD_Calibrate();
+            break;
+        case LCD_BENCH_DMA:
+            #if (LCD_USE_DMA_TRANSPORT != 0u)
+                available = LCD_DmaStart();
+            #else
+                available = 0u;
+            #endif /* LCD_USE_DMA_TRANSPORT != 0u */
+            break;
+        case LCD_BENCH_ASYNC:
+            #if (LCD_USE_ASYNC != 0u)
+                LCD_AsyncStart();
+            #else
+                available = 0u;
+            #endif /* LCD_USE_ASYNC != 0u */
+            break;
+        default:
+            /* LCD_BENCH_ELAPSED: driver default */
+            break;
+    }
+
+    return available;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BenchOp
+********************************************************************************
+*
+* Summary:
+*  Performs one operation of "test" through the transport of "mode".
+*
+*******************************************************************************/
+static void LCD_BenchOp(uint8_t mode, uint8_t test, uint32_t iteration)
+{
+    uint16_t count;
+
+    if (mode == LCD_BENCH_DMA)
+    {
+        #if (LCD_USE_DMA_TRANSPORT != 0u)
+            /* The stream reads the item buffer until it completes */
+            while (LCD_DmaIsBusy() != 0u)
+            {
+            }
+            count = LCD_BenchItems(test, iteration);
+            (void) LCD_DmaWrite(LCD_benchItems, count, NULL);
+        #endif /* LCD_USE_DMA_TRANSPORT != 0u */
+    }
+    else if (mode == LCD_BENCH_ASYNC)
+    {
+        #if (LCD_USE_ASYNC != 0u)
+            uint16_t sent = 0u;
+
+            count = LCD_BenchItems(test, iteration);
+            while (sent < count)
+            {
+                sent += LCD_WriteAsyncBuffer(&LCD_benchItems[sent], (uint16_t) (count - sent));
+            }
+        #endif /* LCD_USE_ASYNC != 0u */
+    }
+    else
+    {
+        (void) count;
+        LCD_BenchBlockingOp(test, iteration);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BenchBlockingOp
+********************************************************************************
+*
+* Summary:
+*  One operation of "test" with the CPU-driven API.
+*
+*******************************************************************************/
+static void LCD_BenchBlockingOp(uint8_t test, uint32_t iteration)
+{
+    uint8_t row;
+
+    switch (test)
+    {
+        case LCD_BENCH_CHAR:
+            LCD_WriteData(LCD_benchText[iteration % LCD_COLUMNS]);
+            break;
+        case LCD_BENCH_LINE:
+            LCD_WritePosition(0u, 0u);
+            LCD_WriteBuffer(LCD_benchText, LCD_COLUMNS);
+            break;
+        case LCD_BENCH_FRAME:
+            for (row = 0u; row < LCD_ROWS; row++)
+            {
+                LCD_WritePosition(row, 0u);
+                LCD_WriteBuffer(LCD_benchText, LCD_COLUMNS);
+            }
+            break;
+        case LCD_BENCH_COUNTER:
+            /* Framebuffer path: only the digits that changed are sent */
+            LCD_Position(LCD_ROWS - 1u, 0u);
+            LCD_PrintU32Fixed(iteration * 7919u, LCD_BENCH_COUNTER_DIGITS, ' ');
+            #if (LCD_USE_FRAMEBUFFER != 0u)
+                LCD_FlushFrame();
+            #endif /* LCD_USE_FRAMEBUFFER != 0u */
+            break;
+        case LCD_BENCH_CLEAR:
+            LCD_ClearDisplay();
+            break;
+        default:
+            LCD_WriteControl(LCD_CGRAM_0);
+            LCD_WriteBuffer(LCD_benchText, LCD_BENCH_CGRAM_BYTES);
+            LCD_WriteControl(LCD_DDRAM_0);
+            break;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BenchItems
+********************************************************************************
+*
+* Summary:
+*  Encodes one operation of "test" as LCD_ITEM_ entries for the DMA and
+*  interrupt transports. Returns the item count.
+*
+*******************************************************************************/
+static uint16_t LCD_BenchItems(uint8_t test, uint32_t iteration)
+{
+    char digits[LCD_U32_DIGITS];
+    uint16_t count = 0u;
+    uint8_t row;
+    uint8_t index;
+    uint8_t length;
+
+    switch (test)
+    {
+        case LCD_BENCH_CHAR:
+            LCD_benchItems[count++] = LCD_ITEM_DATA(LCD_benchText[iteration % LCD_COLUMNS]);
+            break;
+        case LCD_BENCH_LINE:
+        case LCD_BENCH_FRAME:
+            for (row = 0u; row < ((test == LCD_BENCH_LINE) ? 1u : LCD_ROWS); row++)
+            {
+                LCD_benchItems[count++] = LCD_ITEM_CMD(LCD_DdramAddress(row, 0u));
+                for (index = 0u; index < LCD_COLUMNS; index++)
+                {
+                    LCD_benchItems[count++] = LCD_ITEM_DATA(LCD_benchText[index]);
+                }
+            }
+            break;
+        case LCD_BENCH_COUNTER:
+            /* No framebuffer diff here, the whole field is sent */
+            length = LCD_FormatU32(digits, iteration * 7919u);
+            LCD_benchItems[count++] = LCD_ITEM_CMD(LCD_DdramAddress(LCD_ROWS - 1u, 0u));
+            for (index = length; index < LCD_BENCH_COUNTER_DIGITS; index++)
+            {
+                LCD_benchItems[count++] = LCD_ITEM_DATA(' ');
+            }
+            for (index = LCD_U32_DIGITS - length; index < LCD_U32_DIGITS; index++)
+            {
+                LCD_benchItems[count++] = LCD_ITEM_DATA(digits[index]);
+            }
+            break;
+        case LCD_BENCH_CLEAR:
+            LCD_benchItems[count++] = LCD_ITEM_CMD(LCD_CLEAR_DISPLAY);
+            break;
+        default:
+            LCD_benchItems[count++] = LCD_ITEM_CMD(LCD_CGRAM_0);
+            for (index = 0u; index < LCD_BENCH_CGRAM_BYTES; index++)
+            {
+                LCD_benchItems[count++] = LCD_ITEM_DATA(LCD_benchText[index]);
+            }
+            LCD_benchItems[count++] = LCD_ITEM_CMD(LCD_DDRAM_0);
+            break;
+    }
+
+    return count;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BenchSettle
+********************************************************************************
+*
+* Summary:
+*  Waits until the transport of "mode" is idle and the module finished the
+*  last byte.
+*
+*******************************************************************************/
+static void LCD_BenchSettle(uint8_t mode)
+{
+    if (mode == LCD_BENCH_DMA)
+    {
+        #if (LCD_USE_DMA_TRANSPORT != 0u)
+            while (LCD_DmaIsBusy() != 0u)
+            {
+            }
+        #endif /* LCD_USE_DMA_TRANSPORT != 0u */
+    }
+    else if (mode == LCD_BENCH_ASYNC)
+    {
+        #if (LCD_USE_ASYNC != 0u)
+            while (LCD_IsIdle() == 0u)
+            {
+            }
+        #endif /* LCD_USE_ASYNC != 0u */
+    }
+    else if (LCD_timedMode != 0u)
+    {
+        while (LCD_TimingExpired() == 0u)
+        {
+        }
+    }
+    else
+    {
+        (void) LCD_IsReady();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BenchReport
+********************************************************************************
+*
+* Summary:
+*  Prints "mode case us/op chars/s" for a case that took "cycles".
+*
+*******************************************************************************/
+static void LCD_BenchReport(uint8_t mode, uint8_t test, uint32_t cycles)
+{
+    uint32_t centiUs;
+    uint32_t charsPerSecond = 0u;
+
+    centiUs = (uint32_t) (((uint64_t) cycles * 100u) / ((uint64_t) LCD_BENCH_REPEAT * LCD_cyclesPerUs));
+
+    if ((cycles != 0u) && (LCD_benchCaseChars[test] != 0u))
+    {
+        charsPerSecond = (uint32_t) (((uint64_t) LCD_benchCaseChars[test] * LCD_BENCH_REPEAT *
+                                      LCD_cyclesPerUs * 1000000u) / cycles);
+    }
+
+    LCD_BenchPrint(LCD_benchModeNames[mode]);
+    LCD_BenchPrint(" ");
+    LCD_BenchPrint(LCD_benchCaseNames[test]);
+    LCD_BenchPrintU32(centiUs / 100u, 8u, ' ');
+    LCD_BenchPrint(".");
+    LCD_BenchPrintU32(centiUs % 100u, 2u, '0');
+    LCD_BenchPrintU32(charsPerSecond, 11u, ' ');
+    LCD_BenchPrint("\n");
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BenchPrint
+********************************************************************************
+*
+* Summary:
+*  Sends a zero terminated string to ITM stimulus port 0 (printf goes to the
+*  display, see LCD_Stdout.c).
+*
+*******************************************************************************/
+static void LCD_BenchPrint(char const string[])
+{
+    while ((char) '\0' != *string)
+    {
+        (void) ITM_SendChar((uint32_t) *string);
+        string++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BenchPrintU32
+********************************************************************************
+*
+* Summary:
+*  Sends a decimal number to ITM, right-justified in "width" with "pad".
+*
+*******************************************************************************/
+static void LCD_BenchPrintU32(uint32_t value, uint8_t width, char pad)
+{
+    char digits[LCD_U32_DIGITS];
+    uint8_t count;
+    uint8_t index;
+
+    count = LCD_FormatU32(digits, value);
+
+    for (index = count; index < width; index++)
+    {
+        (void) ITM_SendChar((uint32_t) pad);
+    }
+
+    for (index = LCD_U32_DIGITS - count; index < LCD_U32_DIGITS; index++)
+    {
+        (void) ITM_SendChar((uint32_t) digits[index]);
+    }
+}
+
+#endif /* LCD_BENCHMARK */
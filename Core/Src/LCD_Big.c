@@ -0,0 +1,307 @@
+/*
+ *  LCD_Big.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Two-row numerals for the HD44780 LCD driver.
+ *
+ *  			Each numeral is 3 x 2 cells built from three CGRAM segment
+ *  			glyphs (upper bar, lower bar, both bars) and the ROM full block
+ *  			and blank. The segments are pinned in the glyph manager on the
+ *  			first draw, so every later update is DDRAM writes only.
+ *
+ *  			The digits shown by up to LCD_BIG_TRACKED numbers are kept:
+ *  			an update rewrites only the numerals that changed and, within
+ *  			one, only the cells that differ from the old numeral. A clock
+ *  			ticking from 12:08 to 12:09 rewrites two cells of one numeral
+ *  			instead of all 2 x 4 x digits cells.
+ *
+ *  Usage:      - LCD_PrintBigNumber(row, column, value, digits) uses rows
+ *  				"row" and "row" + 1, 4 * digits - 1 columns
+ *  			- the number is zero padded to "digits", higher digits of a
+ *  				larger value are dropped
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Glyph.h"
+#include "LCD_Bar.h"
+#include "LCD_Big.h"
+
+#if (LCD_USE_BIG_DIGITS != 0u)
+
+#if (LCD_USE_GLYPH_CACHE == 0u)
+    #error "LCD_USE_BIG_DIGITS pins its segment glyphs in the glyph manager (LCD_USE_GLYPH_CACHE)"
+#endif /* LCD_USE_GLYPH_CACHE == 0u */
+
+/* Cell contents of a numeral: the CGRAM segments, then ROM characters */
+#define LCD_BIG_UPPER                (0u)
+#define LCD_BIG_LOWER                (1u)
+#define LCD_BIG_BOTH                 (2u)
+#define LCD_BIG_SEGMENTS             (3u)
+#define LCD_BIG_FULL                 (3u)
+#define LCD_BIG_BLANK                (4u)
+
+static uint8_t const LCD_bigSegment[LCD_BIG_SEGMENTS][LCD_GLYPH_ROWS] =
+{
+    { 0x1Fu, 0x1Fu, 0x1Fu, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u },  /* upper bar */
+    { 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x1Fu, 0x1Fu, 0x1Fu },  /* lower bar */
+    { 0x1Fu, 0x1Fu, 0x00u, 0x00u, 0x00u, 0x00u, 0x1Fu, 0x1Fu }   /* both bars */
+};
+
+#define U   LCD_BIG_UPPER
+#define L   LCD_BIG_LOWER
+#define B   LCD_BIG_BOTH
+#define F   LCD_BIG_FULL
+#define _   LCD_BIG_BLANK
+
+/* Numerals 0 - 9, [digit][row][cell] */
+static uint8_t const LCD_bigNumeral[10u][2u][LCD_BIG_WIDTH] =
+{
+    { { F, U, F }, { F, L, F } },
+    { { U, F, _ }, { L, F, L } },
+    { { B, B, F }, { F, L, L } },
+    { { B, B, F }, { L, L, F } },
+    { { F, L, F }, { _, _, F } },
+    { { F, B, B }, { L, L, F } },
+    { { F, B, B }, { F, L, F } },
+    { { U, U, F }, { _, _, F } },
+    { { F, B, F }, { F, L, F } },
+    { { F, B, F }, { L, L, F } }
+};
+
+#undef U
+#undef L
+#undef B
+#undef F
+#undef _
+
+/* Digits on screen of a number, keyed by origin and width */
+typedef struct
+{
+    uint8_t row;
+    uint8_t column;
+    uint8_t digits;                 /* 0 = slot unused */
+    uint8_t shown[LCD_BIG_MAX_DIGITS];
+} LCD_BIG_STATE;
+
+static LCD_BIG_STATE LCD_bigState[LCD_BIG_TRACKED];
+static uint8_t LCD_bigNext = 0u;
+
+/* Character codes of the pinned segments, LCD_GLYPH_NO_SLOT until pinned */
+static uint8_t LCD_bigCode[LCD_BIG_SEGMENTS] = { LCD_GLYPH_NO_SLOT, LCD_GLYPH_NO_SLOT, LCD_GLYPH_NO_SLOT };
+
+static LCD_BIG_STATE *LCD_BigFind(uint8_t row, uint8_t column, uint8_t digits) ;
+static void LCD_BigNumeral(uint8_t row, uint8_t column, uint8_t digit, uint8_t old) ;
+static char LCD_BigCell(uint8_t cell) ;
+
+
+/*******************************************************************************
+*  Function Name: LCD_PrintBigNumber
+********************************************************************************
+*
+* Summary:
+*  Shows a two-row number at (row, column), rewriting only the cells of the
+*  numerals that changed since it was last drawn there.
+*
+* Parameters:
+*  row:    Upper row of the numerals
+*  column: Column of the left cell of the first numeral
+*  value:  Number to show, zero padded
+*  digits: Numerals shown, 1 - LCD_BIG_MAX_DIGITS
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PrintBigNumber(uint8_t row, uint8_t column, uint32_t value, uint8_t digits)
+{
+    LCD_BIG_STATE *state;
+    uint8_t index;
+    uint8_t digit;
+
+    if ((digits == 0u) || (digits > LCD_BIG_MAX_DIGITS) || ((row + 1u) >= LCD_ROWS))
+    {
+        return;
+    }
+
+    state = LCD_BigFind(row, column, digits);
+
+    /* Least significant numeral first */
+    index = digits;
+    while (index > 0u)
+    {
+        index--;
+        digit = (uint8_t) (value % 10u);
+        value /= 10u;
+
+        if (state->shown[index] != digit)
+        {
+            LCD_BigNumeral(row, (uint8_t) (column + (index * LCD_BIG_PITCH)), digit, state->shown[index]);
+
+            if ((state->shown[index] == LCD_BIG_UNKNOWN) && ((index + 1u) < digits))
+            {
+                /* First draw: blank the column to the next numeral too */
+                LCD_Position(row, (uint8_t) (column + (index * LCD_BIG_PITCH) + LCD_BIG_WIDTH));
+                LCD_PutChar(' ');
+                LCD_Position(row + 1u, (uint8_t) (column + (index * LCD_BIG_PITCH) + LCD_BIG_WIDTH));
+                LCD_PutChar(' ');
+            }
+
+            state->shown[index] = digit;
+        }
+    }
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_BigInvalidate
+********************************************************************************
+*
+* Summary:
+*  Forgets every remembered number and the segment slots, the next draw of
+*  each number rewrites all of its cells. Called on clear display and
+*  initialization, with LCD_BarInvalidate().
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_BigInvalidate(void)
+{
+    uint8_t index;
+
+    for (index = 0u; index < LCD_BIG_TRACKED; index++)
+    {
+        LCD_bigState[index].digits = 0u;
+    }
+
+    /* LCD_GlyphReset() unpins them on initialization; pinned again on use */
+    for (index = 0u; index < LCD_BIG_SEGMENTS; index++)
+    {
+        LCD_bigCode[index] = LCD_GLYPH_NO_SLOT;
+    }
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_BigNumeral
+********************************************************************************
+*
+* Summary:
+*  Writes the cells of one numeral that differ from the old numeral (all of
+*  them if it is LCD_BIG_UNKNOWN), one run per row.
+*
+*******************************************************************************/
+static void LCD_BigNumeral(uint8_t row, uint8_t column, uint8_t digit, uint8_t old)
+{
+    uint8_t half;
+    uint8_t first;
+    uint8_t last;
+    uint8_t cell;
+
+    for (half = 0u; half < 2u; half++)
+    {
+        first = 0u;
+        last = LCD_BIG_WIDTH;
+
+        if (old != LCD_BIG_UNKNOWN)
+        {
+            while ((first < LCD_BIG_WIDTH) &&
+                   (LCD_bigNumeral[digit][half][first] == LCD_bigNumeral[old][half][first]))
+            {
+                first++;
+            }
+            while ((last > first) &&
+                   (LCD_bigNumeral[digit][half][last - 1u] == LCD_bigNumeral[old][half][last - 1u]))
+            {
+                last--;
+            }
+        }
+
+        for (cell = first; cell < last; cell++)
+        {
+            /* Consecutive cells, the address counter auto-increments */
+            if (cell == first)
+            {
+                LCD_Position(row + half, column + first);
+            }
+            LCD_PutChar(LCD_BigCell(LCD_bigNumeral[digit][half][cell]));
+        }
+    }
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_BigCell
+********************************************************************************
+*
+* Summary:
+*  Returns the character of a numeral cell, pinning its segment glyph on the
+*  first use. Without a free slot a segment shows as the full block.
+*
+*******************************************************************************/
+static char LCD_BigCell(uint8_t cell)
+{
+    if (cell == LCD_BIG_FULL)
+    {
+        return (char) LCD_BAR_FULL;
+    }
+
+    if (cell == LCD_BIG_BLANK)
+    {
+        return (char) LCD_BAR_EMPTY;
+    }
+
+    if (LCD_bigCode[cell] == LCD_GLYPH_NO_SLOT)
+    {
+        LCD_bigCode[cell] = LCD_GlyphPin(LCD_bigSegment[cell]);
+    }
+
+    return (LCD_bigCode[cell] == LCD_GLYPH_NO_SLOT) ? (char) LCD_BAR_FULL : (char) LCD_bigCode[cell];
+}
+
+
+/*******************************************************************************
+*  Function Name: LCD_BigFind
+********************************************************************************
+*
+* Summary:
+*  Returns the remembered state of a number; a new one (all digits
+*  LCD_BIG_UNKNOWN, oldest slot reused) if it was not drawn before or its
+*  width changed.
+*
+*******************************************************************************/
+static LCD_BIG_STATE *LCD_BigFind(uint8_t row, uint8_t column, uint8_t digits)
+{
+    LCD_BIG_STATE *state = NULL;
+    uint8_t index;
+
+    for (index = 0u; index < LCD_BIG_TRACKED; index++)
+    {
+        if ((LCD_bigState[index].row == row) && (LCD_bigState[index].column == column) &&
+            (LCD_bigState[index].digits == digits))
+        {
+            return &LCD_bigState[index];
+        }
+    }
+
+    state = &LCD_bigState[LCD_bigNext];
+    LCD_bigNext = (uint8_t) ((LCD_bigNext + 1u) % LCD_BIG_TRACKED);
+
+    state->row = row;
+    state->column = column;
+    state->digits = digits;
+    for (index = 0u; index < LCD_BIG_MAX_DIGITS; index++)
+    {
+        state->shown[index] = LCD_BIG_UNKNOWN;
+    }
+
+    return state;
+}
+
+#endif /* LCD_USE_BIG_DIGITS != 0u */
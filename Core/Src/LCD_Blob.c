@@ -0,0 +1,180 @@
+/*
+ *  LCD_Blob.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Constant screens for the HD44780 LCD driver.
+ *
+ *  			A blob is a const table of segments, each one command byte
+ *  			and the data bytes that follow it. LCD_BLOB_TEXT() resolves
+ *  			the DDRAM address of a row and column at compile time, so a
+ *  			splash or a fixed page costs no formatting, no geometry lookup
+ *  			and no framebuffer diff at run time: LCD_PlayBlob() sends the
+ *  			bytes as they are, one bulk write per segment, and
+ *  			LCD_DmaPlayBlob() (LCD_Dma.c) streams the same table without
+ *  			copying it. The framebuffer and its glass copy are updated to
+ *  			what the blob drew, so the next flush sends nothing for it.
+ *
+ *  Usage:      - static LCD_BLOB_SEGMENT const splash[] = {
+ *  				LCD_BLOB_COMMAND(LCD_CLEAR_DISPLAY),
+ *  				LCD_BLOB_TEXT(0u, 0u, "HD44780 LCD") };
+ *  				static LCD_BLOB const splashBlob = LCD_BLOB_INIT(splash);
+ *  			- addresses are for LCD_GEOMETRY, not for a geometry set by
+ *  				LCD_SetGeometry(); a text must fit its row (or half row)
+ *  			- a text is sent as is, no UTF-8 mapping and no wrap
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Big.h"
+#include "LCD_Field.h"
+#include "LCD_Handle.h"
+#include "LCD_Latency.h"
+#include "LCD_Blob.h"
+
+#if (LCD_USE_BLOB != 0u)
+
+static void LCD_BlobMirrorText(LCD_BLOB_SEGMENT const *segment) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_PlayBlob
+********************************************************************************
+*
+* Summary:
+*  Sends a constant screen to the selected display from the CPU.
+*
+* Parameters:
+*  blob: Segments to send
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PlayBlob(LCD_BLOB const *blob)
+{
+    LCD_BLOB_SEGMENT const *segment;
+    uint8_t index;
+
+    for (index = 0u; index < blob->count; index++)
+    {
+        segment = &blob->segments[index];
+
+        /* Clear display keeps the framebuffer in step by itself */
+        LCD_WriteControl(segment->command);
+        LCD_WriteBuffer((uint8_t const *) segment->text, segment->length);
+
+        if (LCD_IS_PRIMARY())
+        {
+            LCD_BlobMirrorText(segment);
+        }
+    }
+
+    #if (LCD_USE_FRAME_SNAPSHOT != 0u)
+        if (LCD_IS_PRIMARY())
+        {
+            LCD_FrameSave();
+        }
+    #endif /* LCD_USE_FRAME_SNAPSHOT != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BlobMirror
+********************************************************************************
+*
+* Summary:
+*  Records a blob sent behind the back of LCD_WriteControl() (DMA) in the
+*  framebuffer, the glass copy and the redraw state of the other features.
+*
+* Parameters:
+*  blob: Segments sent to the primary display
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_BlobMirror(LCD_BLOB const *blob)
+{
+    LCD_BLOB_SEGMENT const *segment;
+    uint8_t index;
+
+    for (index = 0u; index < blob->count; index++)
+    {
+        segment = &blob->segments[index];
+
+        if (segment->command == LCD_CLEAR_DISPLAY)
+        {
+            #if (LCD_USE_FRAMEBUFFER != 0u)
+                LCD_FrameGlassCleared();
+            #endif /* LCD_USE_FRAMEBUFFER != 0u */
+            LCD_BarInvalidate();
+            #if (LCD_USE_BIG_DIGITS != 0u)
+                LCD_BigInvalidate();
+            #endif /* LCD_USE_BIG_DIGITS != 0u */
+            #if (LCD_USE_FIELDS != 0u)
+                LCD_FieldInvalidate();
+            #endif /* LCD_USE_FIELDS != 0u */
+        }
+
+        LCD_BlobMirrorText(segment);
+    }
+
+    #if (LCD_USE_FRAME_SNAPSHOT != 0u)
+        LCD_FrameSave();
+    #endif /* LCD_USE_FRAME_SNAPSHOT != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BlobMirrorText
+********************************************************************************
+*
+* Summary:
+*  Copies the text of a set DDRAM address segment into the framebuffer and
+*  the glass copy, at the cell the address belongs to on the primary display.
+*
+*******************************************************************************/
+static void LCD_BlobMirrorText(LCD_BLOB_SEGMENT const *segment)
+{
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+        uint8_t const address = segment->command & LCD_DDRAM_ADDRESS_MASK;
+        uint8_t run;
+        uint8_t start;
+        uint8_t length;
+        uint8_t row;
+        uint8_t column;
+        uint8_t index;
+
+        if (((segment->command & LCD_DDRAM_0) == 0u) || (segment->length == 0u))
+        {
+            return;
+        }
+
+        for (run = 0u; run < LCD_GEOMETRY_RUNS; run++)
+        {
+            if ((LCD_GeometryRun(geometry, run, &start, &length) != 0u) &&
+                (address >= start) && (address < (start + length)))
+            {
+                row = run >> 1u;
+                column = (address - start) + (((run & 1u) != 0u) ? geometry->split : 0u);
+
+                /* Cells past the end of the run are not on the glass */
+                for (index = 0u; (index < segment->length) && ((address + index) < (start + length)); index++)
+                {
+                    LCD_frame[row][column + index] = (uint8_t) segment->text[index];
+                    LCD_glass[row][column + index] = (uint8_t) segment->text[index];
+                    LCD_LATENCY_SHOWN(row, column + index);
+                }
+                return;
+            }
+        }
+    #else
+        (void) segment;
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+}
+
+#endif /* LCD_USE_BLOB != 0u */
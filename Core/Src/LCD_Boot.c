@@ -0,0 +1,257 @@
+/*
+ *  LCD_Boot.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Boot time markers for the HD44780 LCD driver.
+ *
+ *  			SystemInit() starts the DWT cycle counter from zero as the
+ *  			first thing after reset, before the C runtime copies .data and
+ *  			clears .bss. LCD_BOOT_MARK() then timestamps each stage of the
+ *  			bring-up the first time it is reached: main() itself, HAL_Init,
+ *  			the clock, GPIO and TIM4 set-up in main.c, the controller
+ *  			initialization (cold or warm) and LCD_Start() in LCD.c, the
+ *  			first character written to DDRAM and the end of the first
+ *  			flush that carried characters. The counter runs on the core
+ *  			clock, which SystemClock_Config() switches from HSI to the
+ *  			PLL, so every interval is converted to microseconds at the
+ *  			clock in effect when it started. The table stays in RAM
+ *  			(LCD_boot) for the debugger, LCD_BootReport() prints it.
+ *
+ *  Usage:      - LCD_BootReport(LCD_BootItmPutChar) once the first frame is
+ *  				up for lines like "boot LCD ready 41730 us +41190" on SWO,
+ *  				in time order
+ *  			- the rest of SystemClock_Config() after the switch to the PLL
+ *  				is counted at the HSI clock, a few microseconds too long
+ *  			- without the SystemInit() hook the counter is off until
+ *  				LCD_TimingInit() and the early markers read zero
+ *  			- a debugger attach or LCD_TimingInit() do not restart the
+ *  				counter; nothing else may write DWT->CYCCNT during boot
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Format.h"
+#include "LCD_Transport.h"
+#include "LCD_Boot.h"
+
+#if (LCD_USE_BOOT_MARKERS != 0u)
+
+LCD_BOOT LCD_boot;
+
+/* Last marker: counter value of its last whole microsecond, and the clock
+ * the interval after it runs at (0 = the clock out of reset)
+ */
+static uint32_t LCD_bootCycles = 0u;
+static uint32_t LCD_bootUs = 0u;
+static uint32_t LCD_bootMhz = 0u;
+
+static char const *const LCD_bootNames[LCD_BOOT_MARKS] =
+{
+    "main", "HAL_Init", "clock", "GPIO", "TIM4",
+    "LCD begin", "LCD ready", "LCD start", "first char", "first frame"
+};
+
+static void LCD_BootPutText(LCD_BootPutChar putChar, char const text[]) ;
+static void LCD_BootPutU32(LCD_BootPutChar putChar, uint32_t value) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_BootReset
+********************************************************************************
+*
+* Summary:
+*  Enables the DWT cycle counter and starts it from zero.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+* Note:
+*  Called from SystemInit(), before .data and .bss are set up; touches the
+*  debug registers only.
+*
+*******************************************************************************/
+void LCD_BootReset(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BootMark
+********************************************************************************
+*
+* Summary:
+*  Timestamps a boot marker, unless it was taken before. The first frame
+*  only counts once the first character has been written.
+*
+* Parameters:
+*  mark: LCD_BOOT_...
+*
+* Return:
+*  None.
+*
+* Note:
+*  Use LCD_BOOT_MARK(), which skips the call for markers already taken and
+*  compiles to nothing with LCD_USE_BOOT_MARKERS off.
+*
+*******************************************************************************/
+void LCD_BootMark(uint8_t mark)
+{
+    uint32_t const cycles = DWT->CYCCNT;
+    uint32_t saved;
+    uint32_t mhz;
+    uint32_t elapsed;
+
+    if ((mark >= LCD_BOOT_MARKS) || ((LCD_boot.recorded & (1u << mark)) != 0u))
+    {
+        return;
+    }
+
+    if ((mark == LCD_BOOT_FIRST_FRAME) && ((LCD_boot.recorded & (1u << LCD_BOOT_FIRST_CHAR)) == 0u))
+    {
+        /* A flush with nothing to send */
+        return;
+    }
+
+    LCD_BUS_ATOMIC_BEGIN(saved);
+
+    /* The cycles since the last marker ran at its clock; the remainder below
+     * a microsecond is carried into the next interval
+     */
+    mhz = (LCD_bootMhz != 0u) ? LCD_bootMhz : (SystemCoreClock / 1000000u);
+    elapsed = cycles - LCD_bootCycles;
+    LCD_bootUs += elapsed / mhz;
+    LCD_bootCycles = cycles - (elapsed % mhz);
+    LCD_bootMhz = SystemCoreClock / 1000000u;
+
+    LCD_boot.cycles[mark] = cycles;
+    LCD_boot.us[mark] = LCD_bootUs;
+    LCD_boot.recorded |= 1u << mark;
+
+    LCD_BUS_ATOMIC_END(saved);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BootReport
+********************************************************************************
+*
+* Summary:
+*  Writes one line per marker taken, in time order, with the time since
+*  reset and the step from the marker before, e.g.
+*  "boot LCD ready 41730 us +41190\n".
+*
+* Parameters:
+*  putChar: Character output, LCD_BootItmPutChar for SWO
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_BootReport(LCD_BootPutChar putChar)
+{
+    uint32_t reported = 0u;
+    uint32_t previous = 0u;
+    uint8_t mark;
+    uint8_t next;
+
+    do
+    {
+        /* Earliest marker not reported yet */
+        next = LCD_BOOT_MARKS;
+        for (mark = 0u; mark < LCD_BOOT_MARKS; mark++)
+        {
+            if (((LCD_boot.recorded & ~reported & (1u << mark)) != 0u) &&
+                ((next == LCD_BOOT_MARKS) || (LCD_boot.us[mark] < LCD_boot.us[next])))
+            {
+                next = mark;
+            }
+        }
+
+        if (next != LCD_BOOT_MARKS)
+        {
+            LCD_BootPutText(putChar, "boot ");
+            LCD_BootPutText(putChar, LCD_bootNames[next]);
+            putChar(' ');
+            LCD_BootPutU32(putChar, LCD_boot.us[next]);
+            LCD_BootPutText(putChar, " us +");
+            LCD_BootPutU32(putChar, LCD_boot.us[next] - previous);
+            putChar('\n');
+
+            previous = LCD_boot.us[next];
+            reported |= 1u << next;
+        }
+    } while (next != LCD_BOOT_MARKS);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BootItmPutChar
+********************************************************************************
+*
+* Summary:
+*  LCD_BootReport() output on ITM stimulus port 0 (SWO).
+*
+* Parameters:
+*  character: Character to send
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_BootItmPutChar(char character)
+{
+    (void) ITM_SendChar((uint32_t) (uint8_t) character);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BootPutText
+********************************************************************************
+*
+* Summary:
+*  Writes a zero-terminated text.
+*
+*******************************************************************************/
+static void LCD_BootPutText(LCD_BootPutChar putChar, char const text[])
+{
+    uint8_t index = 0u;
+
+    while (text[index] != '\0')
+    {
+        putChar(text[index]);
+        index++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BootPutU32
+********************************************************************************
+*
+* Summary:
+*  Writes an unsigned number in decimal.
+*
+*******************************************************************************/
+static void LCD_BootPutU32(LCD_BootPutChar putChar, uint32_t value)
+{
+    char digits[LCD_U32_DIGITS];
+    uint8_t index;
+
+    /* Right-aligned in the buffer */
+    index = LCD_U32_DIGITS - LCD_FormatU32(digits, value);
+    while (index < LCD_U32_DIGITS)
+    {
+        putChar(digits[index]);
+        index++;
+    }
+}
+
+#endif /* LCD_USE_BOOT_MARKERS != 0u */
@@ -0,0 +1,508 @@
+/*
+ *  LCD_Can.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: CAN display node for the HD44780 LCD driver.
+ *
+ *  			The display reads process data off the machine CAN bus with
+ *  			the bxCAN of the F103, with no gateway MCU. An application
+ *  			table maps standard identifiers to fields: one payload signal
+ *  			each (text bytes or an integer, scaled to a fixed number of
+ *  			decimals) drawn at a row, column and width. LCD_CanStart()
+ *  			puts every identifier of the table into the acceptance filters
+ *  			(16-bit list mode, four per bank), so frames nobody displays
+ *  			are dropped by the controller and never interrupt the core.
+ *  			The FIFO 0 interrupt finds the fields of a frame from its
+ *  			filter match index, without searching the table, and writes
+ *  			the cells that change straight into the framebuffer; the
+ *  			main loop (or LCD_RefreshTask()) flushes them.
+ *
+ *  Usage:      - static LCD_CAN_FIELD const node[] = {
+ *  				LCD_CAN_FIELD_INIT(0x181u, 0u, LCD_CAN_S16, 1u, 0u, 4u, 6u) };
+ *  				shows bytes 0-1 of frame 0x181 as "-123.4" in row 0
+ *  			- LCD_CanStart(node, 1u) after LCD_Start(), then
+ *  				if (LCD_frameDirty != 0u) LCD_FlushFrame(); in the main loop
+ *  			- call LCD_CanIRQHandler() from USB_LP_CAN1_RX0_IRQHandler,
+ *  				it also wakes a __WFI() main loop
+ *  			- the cells of CAN fields belong to them, other producers draw
+ *  				elsewhere; standard identifiers only, the node sends nothing
+ *  			- needs LCD_USE_FRAMEBUFFER
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Latency.h"
+#include "LCD_Format.h"
+#include "LCD_Timing.h"
+#include "LCD_Can.h"
+
+#if (LCD_USE_CAN != 0u)
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    #error "LCD_USE_CAN draws its fields into the framebuffer (LCD_USE_FRAMEBUFFER)"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+#if (LCD_CAN_FIELDS_MAX > 255u)
+    #error "LCD_CAN_FIELDS_MAX must be 255 or less, fields are chained by uint8_t index"
+#endif /* LCD_CAN_FIELDS_MAX > 255u */
+
+/* End of a field chain */
+#define LCD_CAN_NONE                 (0xFFu)
+
+/* Text length wider than any field */
+#define LCD_CAN_TOO_WIDE             (0xFFu)
+
+/* Time the controller gets to enter and leave initialization mode (leaving
+ * takes 11 recessive bits on the bus)
+ */
+#define LCD_CAN_TIMEOUT_US           (10000u)
+#define LCD_CAN_POLL_US              (10u)
+
+/* Time quanta per bit tried, from the most down; the sample point is kept at
+ * about 87.5 % (CiA recommendation)
+ */
+#define LCD_CAN_QUANTA_MAX           (20u)
+#define LCD_CAN_QUANTA_MIN           (8u)
+#define LCD_CAN_PRESCALER_MAX        (1024u)
+
+/* 16-bit filter entry of a standard data frame (STID[10:0], RTR = IDE = 0) */
+#define LCD_CAN_FILTER_ENTRY(id)     ((uint32_t) (id) << 5u)
+
+/* Payload bytes of the integer formats */
+static const uint8_t LCD_canSize[LCD_CAN_S32 + 1u] = { 0u, 1u, 2u, 2u, 4u, 4u };
+
+static LCD_CAN_FIELD const *LCD_canTable = NULL;
+
+/* First field of each filter number, and the next field of the same frame */
+static uint8_t LCD_canFirst[LCD_CAN_FILTERS];
+static uint8_t LCD_canNext[LCD_CAN_FIELDS_MAX];
+
+static volatile uint32_t LCD_canErrors = 0u;
+
+static uint8_t LCD_CanCheck(LCD_CAN_FIELD const *field) ;
+static uint8_t LCD_CanTiming(uint32_t pclk, uint32_t *btr) ;
+static uint8_t LCD_CanWait(uint32_t flag, uint32_t state) ;
+static void LCD_CanDraw(LCD_CAN_FIELD const *field, uint8_t const data[], uint8_t dlc) ;
+static void LCD_CanPut(uint8_t row, uint8_t column, uint8_t character) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_CanStart
+********************************************************************************
+*
+* Summary:
+*  Selects the field table and brings up the bxCAN at LCD_CAN_BITRATE:
+*  pins, bit timing, one acceptance filter entry per identifier of the
+*  table (all to FIFO 0), automatic bus-off recovery and the FIFO 0
+*  interrupt.
+*
+* Parameters:
+*  table: Fields, must stay valid while the node runs
+*  count: Number of fields, at most LCD_CAN_FIELDS_MAX
+*
+* Return:
+*  1 if the node is on the bus. 0 if the table has a bad field or more than
+*  LCD_CAN_FILTERS identifiers, if the bit rate cannot be made from PCLK1,
+*  or if the controller did not join the bus in LCD_CAN_TIMEOUT_US; in the
+*  last case it keeps trying and the fields run once it is on.
+*
+*******************************************************************************/
+uint8_t LCD_CanStart(LCD_CAN_FIELD const table[], uint8_t count)
+{
+    uint16_t ids[LCD_CAN_FILTERS];
+    uint8_t filterOf[LCD_CAN_FIELDS_MAX];
+    uint8_t idCount = 0u;
+    uint8_t field;
+    uint8_t filter;
+    uint8_t banks;
+    uint32_t btr;
+
+    if ((count > LCD_CAN_FIELDS_MAX) || (LCD_CanTiming(HAL_RCC_GetPCLK1Freq(), &btr) == 0u))
+    {
+        return 0u;
+    }
+
+    /* One filter number per identifier */
+    for (field = 0u; field < count; field++)
+    {
+        if (LCD_CanCheck(&table[field]) == 0u)
+        {
+            return 0u;
+        }
+
+        filter = 0u;
+        while ((filter < idCount) && (ids[filter] != table[field].id))
+        {
+            filter++;
+        }
+
+        if (filter == idCount)
+        {
+            if (idCount == LCD_CAN_FILTERS)
+            {
+                return 0u;
+            }
+            ids[filter] = table[field].id;
+            idCount++;
+        }
+        filterOf[field] = filter;
+    }
+
+    HAL_NVIC_DisableIRQ(USB_LP_CAN1_RX0_IRQn);
+
+    /* The fields of each filter number chained behind it */
+    for (filter = 0u; filter < LCD_CAN_FILTERS; filter++)
+    {
+        LCD_canFirst[filter] = LCD_CAN_NONE;
+    }
+    for (field = 0u; field < count; field++)
+    {
+        LCD_canNext[field] = LCD_canFirst[filterOf[field]];
+        LCD_canFirst[filterOf[field]] = field;
+    }
+
+    LCD_canTable = table;
+
+    /* The last bank is filled up with its last identifier */
+    banks = (uint8_t) ((idCount + 3u) / 4u);
+    for (filter = idCount; filter < (4u * banks); filter++)
+    {
+        ids[filter] = ids[idCount - 1u];
+        LCD_canFirst[filter] = LCD_canFirst[idCount - 1u];
+    }
+
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_AFIO);
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_CAN1);
+    #if (LCD_CAN_PINS == 1u)
+        LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_GPIOB);
+        __HAL_AFIO_REMAP_CAN1_2();
+        LL_GPIO_SetPinMode(GPIOB, LL_GPIO_PIN_8, LL_GPIO_MODE_INPUT);
+        LL_GPIO_SetPinPull(GPIOB, LL_GPIO_PIN_8, LL_GPIO_PULL_UP);
+        LL_GPIO_SetPinMode(GPIOB, LL_GPIO_PIN_9, LL_GPIO_MODE_ALTERNATE);
+        LL_GPIO_SetPinOutputType(GPIOB, LL_GPIO_PIN_9, LL_GPIO_OUTPUT_PUSHPULL);
+        LL_GPIO_SetPinSpeed(GPIOB, LL_GPIO_PIN_9, LL_GPIO_SPEED_FREQ_HIGH);
+    #else
+        LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_GPIOA);
+        LL_GPIO_SetPinMode(GPIOA, LL_GPIO_PIN_11, LL_GPIO_MODE_INPUT);
+        LL_GPIO_SetPinPull(GPIOA, LL_GPIO_PIN_11, LL_GPIO_PULL_UP);
+        LL_GPIO_SetPinMode(GPIOA, LL_GPIO_PIN_12, LL_GPIO_MODE_ALTERNATE);
+        LL_GPIO_SetPinOutputType(GPIOA, LL_GPIO_PIN_12, LL_GPIO_OUTPUT_PUSHPULL);
+        LL_GPIO_SetPinSpeed(GPIOA, LL_GPIO_PIN_12, LL_GPIO_SPEED_FREQ_HIGH);
+    #endif /* LCD_CAN_PINS == 1u */
+
+    /* Out of sleep, into initialization mode */
+    CAN1->IER = 0u;
+    CAN1->MCR = CAN_MCR_INRQ | CAN_MCR_ABOM;
+    if (LCD_CanWait(CAN_MSR_INAK, CAN_MSR_INAK) == 0u)
+    {
+        return 0u;
+    }
+
+    #if (LCD_CAN_SILENT != 0u)
+        CAN1->BTR = btr | CAN_BTR_SILM;
+    #else
+        CAN1->BTR = btr;
+    #endif /* LCD_CAN_SILENT != 0u */
+
+    /* 16-bit identifier lists, four entries per bank, all to FIFO 0 */
+    CAN1->FMR |= CAN_FMR_FINIT;
+    CAN1->FA1R = 0u;
+    CAN1->FS1R = 0u;
+    CAN1->FFA1R = 0u;
+    CAN1->FM1R = (1uL << banks) - 1u;
+    for (filter = 0u; filter < (4u * banks); filter += 4u)
+    {
+        CAN1->sFilterRegister[filter / 4u].FR1 = LCD_CAN_FILTER_ENTRY(ids[filter]) |
+                                                 (LCD_CAN_FILTER_ENTRY(ids[filter + 1u]) << 16u);
+        CAN1->sFilterRegister[filter / 4u].FR2 = LCD_CAN_FILTER_ENTRY(ids[filter + 2u]) |
+                                                 (LCD_CAN_FILTER_ENTRY(ids[filter + 3u]) << 16u);
+    }
+    CAN1->FA1R = (1uL << banks) - 1u;
+    CAN1->FMR &= ~CAN_FMR_FINIT;
+
+    CAN1->RF0R = CAN_RF0R_FOVR0;
+    CAN1->IER = CAN_IER_FMPIE0 | CAN_IER_FOVIE0;
+    HAL_NVIC_SetPriority(USB_LP_CAN1_RX0_IRQn, LCD_CAN_IRQ_PRIORITY, 0u);
+    HAL_NVIC_EnableIRQ(USB_LP_CAN1_RX0_IRQn);
+
+    /* Normal (or silent) mode once 11 recessive bits were seen */
+    CAN1->MCR = CAN_MCR_ABOM;
+
+    return LCD_CanWait(CAN_MSR_INAK, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanIRQHandler
+********************************************************************************
+*
+* Summary:
+*  FIFO 0 interrupt: draws the fields of every received frame into the
+*  framebuffer and releases the mailbox. Only frames of table identifiers
+*  pass the filters; the match index selects the fields.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+* Note:
+*  A FIFO overrun (frames arriving while the interrupt was masked for
+*  longer than three frames) is counted in LCD_CanErrors().
+*
+*******************************************************************************/
+void LCD_CanIRQHandler(void)
+{
+    uint8_t data[8];
+    uint32_t dataTime;
+    uint32_t low;
+    uint32_t high;
+    uint8_t index;
+    uint8_t field;
+
+    if ((CAN1->RF0R & CAN_RF0R_FOVR0) != 0u)
+    {
+        CAN1->RF0R = CAN_RF0R_FOVR0;
+        LCD_canErrors++;
+    }
+
+    while ((CAN1->RF0R & CAN_RF0R_FMP0) != 0u)
+    {
+        dataTime = CAN1->sFIFOMailBox[0].RDTR;
+        low = CAN1->sFIFOMailBox[0].RDLR;
+        high = CAN1->sFIFOMailBox[0].RDHR;
+        CAN1->RF0R = CAN_RF0R_RFOM0;
+
+        for (index = 0u; index < 4u; index++)
+        {
+            data[index] = (uint8_t) (low >> (8u * index));
+            data[index + 4u] = (uint8_t) (high >> (8u * index));
+        }
+
+        index = (uint8_t) ((dataTime & CAN_RDT0R_FMI) >> CAN_RDT0R_FMI_Pos);
+        field = (index < LCD_CAN_FILTERS) ? LCD_canFirst[index] : LCD_CAN_NONE;
+        while (field != LCD_CAN_NONE)
+        {
+            LCD_CanDraw(&LCD_canTable[field], data, (uint8_t) (dataTime & CAN_RDT0R_DLC));
+            field = LCD_canNext[field];
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanErrors
+********************************************************************************
+*
+* Summary:
+*  Returns the number of FIFO overruns and of frames too short for a field.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Errors since reset.
+*
+*******************************************************************************/
+uint32_t LCD_CanErrors(void)
+{
+    return LCD_canErrors;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanCheck
+********************************************************************************
+*
+* Summary:
+*  Returns 1 if a field fits the standard identifiers, the payload and the
+*  framebuffer.
+*
+*******************************************************************************/
+static uint8_t LCD_CanCheck(LCD_CAN_FIELD const *field)
+{
+    uint8_t const format = field->format & LCD_CAN_FORMAT_MASK;
+    uint8_t size;
+
+    if ((format > LCD_CAN_S32) || ((field->format & ~(LCD_CAN_FORMAT_MASK | LCD_CAN_MSB_FIRST)) != 0u))
+    {
+        return 0u;
+    }
+    size = (format == LCD_CAN_TEXT) ? field->width : LCD_canSize[format];
+
+    return ((field->id <= LCD_CAN_ID_MAX) && ((field->offset + size) <= 8u) &&
+            (field->decimals <= LCD_DECIMALS_MAX) &&
+            (field->width != 0u) && (field->row < LCD_ROWS) &&
+            ((field->column + field->width) <= LCD_COLUMNS)) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanTiming
+********************************************************************************
+*
+* Summary:
+*  Builds the BTR value of LCD_CAN_BITRATE from the CAN clock: the most time
+*  quanta per bit that divide it evenly, sample point at about 87.5 %, a
+*  resynchronization jump of one quantum.
+*
+*******************************************************************************/
+static uint8_t LCD_CanTiming(uint32_t pclk, uint32_t *btr)
+{
+    uint32_t quanta = LCD_CAN_QUANTA_MAX;
+    uint32_t prescaler;
+    uint32_t seg2;
+
+    while (quanta >= LCD_CAN_QUANTA_MIN)
+    {
+        prescaler = pclk / (LCD_CAN_BITRATE * quanta);
+        if (((prescaler * LCD_CAN_BITRATE * quanta) == pclk) && (prescaler != 0u) &&
+            (prescaler <= LCD_CAN_PRESCALER_MAX))
+        {
+            /* Sync quantum, segment 1 up to the sample point, segment 2 */
+            seg2 = (quanta + 4u) / 8u;
+            *btr = ((prescaler - 1u) << CAN_BTR_BRP_Pos) |
+                   ((quanta - 1u - seg2 - 1u) << CAN_BTR_TS1_Pos) |
+                   ((seg2 - 1u) << CAN_BTR_TS2_Pos);
+            return 1u;
+        }
+        quanta--;
+    }
+
+    return 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanWait
+********************************************************************************
+*
+* Summary:
+*  Waits up to LCD_CAN_TIMEOUT_US for an MSR flag to reach a state.
+*
+*******************************************************************************/
+static uint8_t LCD_CanWait(uint32_t flag, uint32_t state)
+{
+    uint32_t waited = 0u;
+
+    while ((CAN1->MSR & flag) != state)
+    {
+        if (waited >= LCD_CAN_TIMEOUT_US)
+        {
+            return 0u;
+        }
+        LCD_DelayUs(LCD_CAN_POLL_US);
+        waited += LCD_CAN_POLL_US;
+    }
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanDraw
+********************************************************************************
+*
+* Summary:
+*  Formats the signal of a field from a frame payload into its cells: texts
+*  as they are, integers right-justified and blank padded, a number wider
+*  than the field as LCD_CAN_OVERFLOW in every cell.
+*
+*******************************************************************************/
+static void LCD_CanDraw(LCD_CAN_FIELD const *field, uint8_t const data[], uint8_t dlc)
+{
+    char text[LCD_NUMBER_TEXT_MAX];
+    char const *digits = text;
+    uint8_t const format = field->format & LCD_CAN_FORMAT_MASK;
+    uint8_t const size = (format == LCD_CAN_TEXT) ? field->width : LCD_canSize[format];
+    uint32_t raw = 0u;
+    int32_t value;
+    uint8_t length = LCD_CAN_TOO_WIDE;
+    uint8_t index;
+
+    if ((field->offset + size) > dlc)
+    {
+        LCD_canErrors++;
+        return;
+    }
+
+    if (format == LCD_CAN_TEXT)
+    {
+        for (index = 0u; index < field->width; index++)
+        {
+            LCD_CanPut(field->row, field->column + index, data[field->offset + index]);
+        }
+        return;
+    }
+
+    for (index = 0u; index < size; index++)
+    {
+        raw = (raw << 8u) | (((field->format & LCD_CAN_MSB_FIRST) != 0u) ?
+                             data[field->offset + index] : data[field->offset + (size - 1u) - index]);
+    }
+
+    if (format == LCD_CAN_S16)
+    {
+        value = (int32_t) (int16_t) raw;
+        length = LCD_FormatScaled(text, value, field->decimals);
+    }
+    else if ((format == LCD_CAN_S32) || (raw <= 0x7FFFFFFFu))
+    {
+        value = (int32_t) raw;
+        length = LCD_FormatScaled(text, value, field->decimals);
+    }
+    else if (field->decimals == 0u)
+    {
+        length = LCD_FormatU32(text, raw);
+        digits = &text[LCD_U32_DIGITS - length];
+    }
+    else
+    {
+        /* Scaled U32 above 2^31, shown as an overflow */
+    }
+
+    for (index = 0u; index < field->width; index++)
+    {
+        if (length > field->width)
+        {
+            LCD_CanPut(field->row, field->column + index, (uint8_t) LCD_CAN_OVERFLOW);
+        }
+        else if (index < (field->width - length))
+        {
+            LCD_CanPut(field->row, field->column + index, LCD_FRAME_BLANK);
+        }
+        else
+        {
+            LCD_CanPut(field->row, field->column + index,
+                       (uint8_t) digits[index - (field->width - length)]);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanPut
+********************************************************************************
+*
+* Summary:
+*  Stores a cell in the framebuffer, marking it dirty only if it changed.
+*
+*******************************************************************************/
+static void LCD_CanPut(uint8_t row, uint8_t column, uint8_t character)
+{
+    if (LCD_frame[row][column] != character)
+    {
+        LCD_LATENCY_CHANGE(row, column, character);
+        LCD_frame[row][column] = character;
+
+        /* Cell visible before the flag that publishes it */
+        __DMB();
+        LCD_frameDirty = 1u;
+    }
+}
+
+#endif /* LCD_USE_CAN != 0u */
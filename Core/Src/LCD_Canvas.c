@@ -0,0 +1,548 @@
+/*
+ *  LCD_Canvas.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: CGRAM pixel canvases for the HD44780 LCD driver.
+ *
+ *  			A canvas pins up to LCD_CANVAS_MAX_CELLS CGRAM slots in the
+ *  			glyph manager and treats their bitmaps as one picture of
+ *  			cellsWide x 5 by cellsHigh x 8 pixels (40x8 or 20x16 with all
+ *  			eight slots). Drawing only changes the bitmaps in RAM and marks
+ *  			the glyph rows it changed; LCD_CanvasFlush() uploads, per cell,
+ *  			the span of rows between the first and the last changed one.
+ *  			The DDRAM cells showing the canvas are written once by
+ *  			LCD_CanvasShow() and follow every upload.
+ *
+ *  			LCD_CanvasPush() draws a trend in sweep mode: the new sample
+ *  			goes into the column after the last one, joined to it, and the
+ *  			column in front is cleared as a gap, so a sample costs the few
+ *  			glyph rows of two columns instead of a scrolled picture.
+ *
+ *  Usage:      - LCD_CanvasOpen(&trend, 4, 1) after LCD_Init(), then
+ *  				LCD_CanvasShow(&trend, 0, 12) for a 20x8 trend in the
+ *  				top right corner
+ *  			- LCD_CanvasPush(&trend, value, min, max) per sample, or draw
+ *  				with the pixel/line/column primitives, then
+ *  				LCD_CanvasFlush(&trend)
+ *  			- x runs left to right, y top to bottom
+ *  			- LCD_Init() resets the glyph manager, open the canvas again
+ *  				after a re-init
+ *  			- needs LCD_USE_GLYPH_CACHE
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Glyph.h"
+#include "LCD_Canvas.h"
+
+#if (LCD_USE_CANVAS != 0u)
+
+#if (LCD_USE_GLYPH_CACHE == 0u)
+    #error "LCD_USE_CANVAS pins its cells in the glyph manager (LCD_USE_GLYPH_CACHE)"
+#endif /* LCD_USE_GLYPH_CACHE == 0u */
+
+#if ((LCD_CANVAS_MAX_CELLS == 0u) || (LCD_CANVAS_MAX_CELLS > LCD_GLYPH_SLOTS))
+    #error "LCD_CANVAS_MAX_CELLS must be 1 - 8, the CGRAM slots"
+#endif /* LCD_CANVAS_MAX_CELLS */
+
+static uint8_t LCD_CanvasScale(LCD_CANVAS const *canvas, int16_t value, int16_t min, int16_t max) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_CanvasOpen
+********************************************************************************
+*
+* Summary:
+*  Clears a canvas and pins a CGRAM slot for each of its cells.
+*
+* Parameters:
+*  canvas:    Canvas state, stays valid while open
+*  cellsWide: Width in character cells
+*  cellsHigh: Height in character cells
+*
+* Return:
+*  1 if opened, 0 if the size is 0, larger than LCD_CANVAS_MAX_CELLS or
+*  not enough slots are free.
+*
+* Note:
+*  Pinning uploads the blank bitmaps, the canvas needs no flush before it is
+*  shown.
+*
+*******************************************************************************/
+uint8_t LCD_CanvasOpen(LCD_CANVAS *canvas, uint8_t cellsWide, uint8_t cellsHigh)
+{
+    uint8_t cells = (uint8_t) (cellsWide * cellsHigh);
+    uint8_t cell;
+
+    if ((cellsWide == 0u) || (cellsHigh == 0u) || (cells > LCD_CANVAS_MAX_CELLS))
+    {
+        return 0u;
+    }
+
+    canvas->cellsWide = cellsWide;
+    canvas->cellsHigh = cellsHigh;
+    LCD_CanvasClear(canvas);
+
+    for (cell = 0u; cell < cells; cell++)
+    {
+        canvas->slot[cell] = LCD_GlyphPin(&canvas->bits[cell][0]);
+        canvas->dirty[cell] = 0u;
+
+        if (canvas->slot[cell] == LCD_GLYPH_NO_SLOT)
+        {
+            /* Give back the slots pinned so far */
+            while (cell > 0u)
+            {
+                cell--;
+                LCD_GlyphUnpin(canvas->slot[cell]);
+            }
+            canvas->cellsWide = 0u;
+            canvas->cellsHigh = 0u;
+            return 0u;
+        }
+    }
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanvasClose
+********************************************************************************
+*
+* Summary:
+*  Unpins the slots of a canvas. Cells still showing them keep the last
+*  picture until the glyph cache reuses a slot.
+*
+* Parameters:
+*  canvas: Open canvas
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_CanvasClose(LCD_CANVAS *canvas)
+{
+    uint8_t cells = (uint8_t) (canvas->cellsWide * canvas->cellsHigh);
+    uint8_t cell;
+
+    for (cell = 0u; cell < cells; cell++)
+    {
+        LCD_GlyphUnpin(canvas->slot[cell]);
+    }
+
+    canvas->cellsWide = 0u;
+    canvas->cellsHigh = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanvasShow
+********************************************************************************
+*
+* Summary:
+*  Writes the character codes of the canvas cells to the display, its top
+*  left cell at row, column.
+*
+* Parameters:
+*  canvas: Open canvas
+*  row:    Screen row of the top left cell
+*  column: Screen column of the top left cell
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_CanvasShow(LCD_CANVAS const *canvas, uint8_t row, uint8_t column)
+{
+    uint8_t cellRow;
+    uint8_t cellColumn;
+
+    for (cellRow = 0u; cellRow < canvas->cellsHigh; cellRow++)
+    {
+        LCD_Position((uint8_t) (row + cellRow), column);
+
+        for (cellColumn = 0u; cellColumn < canvas->cellsWide; cellColumn++)
+        {
+            LCD_PutChar((char) canvas->slot[(cellRow * canvas->cellsWide) + cellColumn]);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanvasClear
+********************************************************************************
+*
+* Summary:
+*  Clears every pixel and restarts the LCD_CanvasPush() sweep at x = 0.
+*
+* Parameters:
+*  canvas: Canvas
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_CanvasClear(LCD_CANVAS *canvas)
+{
+    uint8_t cells = (uint8_t) (canvas->cellsWide * canvas->cellsHigh);
+    uint8_t cell;
+    uint8_t row;
+
+    for (cell = 0u; cell < cells; cell++)
+    {
+        for (row = 0u; row < LCD_GLYPH_ROWS; row++)
+        {
+            if (canvas->bits[cell][row] != 0u)
+            {
+                canvas->bits[cell][row] = 0u;
+                canvas->dirty[cell] |= (uint8_t) (1u << row);
+            }
+        }
+    }
+
+    canvas->sweep = 0u;
+    canvas->lastY = LCD_CANVAS_NO_SAMPLE;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanvasPixel
+********************************************************************************
+*
+* Summary:
+*  Sets or clears one pixel. Pixels outside the canvas are ignored.
+*
+* Parameters:
+*  canvas: Open canvas
+*  x:      Column, 0 = left
+*  y:      Row, 0 = top
+*  on:     1 = set, 0 = clear
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_CanvasPixel(LCD_CANVAS *canvas, uint8_t x, uint8_t y, uint8_t on)
+{
+    uint8_t cell;
+    uint8_t row;
+    uint8_t mask;
+    uint8_t value;
+
+    if ((x >= (canvas->cellsWide * LCD_CANVAS_CELL_WIDTH)) ||
+        (y >= (canvas->cellsHigh * LCD_CANVAS_CELL_HEIGHT)))
+    {
+        return;
+    }
+
+    cell = (uint8_t) (((y / LCD_CANVAS_CELL_HEIGHT) * canvas->cellsWide) + (x / LCD_CANVAS_CELL_WIDTH));
+    row = (uint8_t) (y % LCD_CANVAS_CELL_HEIGHT);
+    mask = (uint8_t) (0x10u >> (x % LCD_CANVAS_CELL_WIDTH));
+    value = (on != 0u) ? (uint8_t) (canvas->bits[cell][row] | mask) :
+                         (uint8_t) (canvas->bits[cell][row] & ~mask);
+
+    if (value != canvas->bits[cell][row])
+    {
+        canvas->bits[cell][row] = value;
+        canvas->dirty[cell] |= (uint8_t) (1u << row);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanvasLine
+********************************************************************************
+*
+* Summary:
+*  Sets the pixels of a straight line between two points, both included.
+*
+* Parameters:
+*  canvas: Open canvas
+*  x0, y0: Start point
+*  x1, y1: End point
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_CanvasLine(LCD_CANVAS *canvas, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+    int16_t dx = (x1 > x0) ? (int16_t) (x1 - x0) : (int16_t) (x0 - x1);
+    int16_t dy = (y1 > y0) ? (int16_t) (y0 - y1) : (int16_t) (y1 - y0);
+    int8_t stepX = (x1 > x0) ? 1 : -1;
+    int8_t stepY = (y1 > y0) ? 1 : -1;
+    int16_t error = dx + dy;
+
+    /* Bresenham, dy is kept negative */
+    LCD_CanvasPixel(canvas, x0, y0, 1u);
+    while ((x0 != x1) || (y0 != y1))
+    {
+        if ((2 * error) >= dy)
+        {
+            error += dy;
+            x0 = (uint8_t) (x0 + stepX);
+        }
+        if ((2 * error) <= dx)
+        {
+            error += dx;
+            y0 = (uint8_t) (y0 + stepY);
+        }
+        LCD_CanvasPixel(canvas, x0, y0, 1u);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanvasColumn
+********************************************************************************
+*
+* Summary:
+*  Sets or clears the pixels of column x from y0 to y1, both included.
+*
+* Parameters:
+*  canvas: Open canvas
+*  x:      Column
+*  y0, y1: First and last row, in either order
+*  on:     1 = set, 0 = clear
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_CanvasColumn(LCD_CANVAS *canvas, uint8_t x, uint8_t y0, uint8_t y1, uint8_t on)
+{
+    uint8_t y = (y0 < y1) ? y0 : y1;
+    uint8_t last = (y0 < y1) ? y1 : y0;
+
+    while (y <= last)
+    {
+        LCD_CanvasPixel(canvas, x, y, on);
+        if (y == 0xFFu)
+        {
+            break;
+        }
+        y++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanvasSparkline
+********************************************************************************
+*
+* Summary:
+*  Redraws the canvas as a line graph of samples, one per pixel column from
+*  the left, each joined to the one before it.
+*
+* Parameters:
+*  canvas:  Open canvas
+*  samples: Values, oldest first; those past the canvas width are dropped
+*  count:   Number of samples
+*  min:     Value drawn on the bottom row
+*  max:     Value drawn on the top row
+*
+* Return:
+*  None.
+*
+* Note:
+*  Values outside min - max are clipped to the bottom or top row. Only the
+*  glyph rows that end up different are uploaded by the next flush.
+*
+*******************************************************************************/
+void LCD_CanvasSparkline(LCD_CANVAS *canvas, int16_t const samples[], uint8_t count,
+                         int16_t min, int16_t max)
+{
+    uint8_t width = (uint8_t) (canvas->cellsWide * LCD_CANVAS_CELL_WIDTH);
+    uint8_t x;
+    uint8_t y;
+    uint8_t lastY = 0u;
+    uint8_t cells = (uint8_t) (canvas->cellsWide * canvas->cellsHigh);
+    uint8_t picture[LCD_CANVAS_MAX_CELLS][LCD_GLYPH_ROWS];
+    uint8_t cell;
+    uint8_t row;
+
+    /* Keep the old picture to mark only the rows that differ */
+    for (cell = 0u; cell < cells; cell++)
+    {
+        for (row = 0u; row < LCD_GLYPH_ROWS; row++)
+        {
+            picture[cell][row] = canvas->bits[cell][row];
+            canvas->bits[cell][row] = 0u;
+        }
+    }
+
+    for (x = 0u; (x < count) && (x < width); x++)
+    {
+        y = LCD_CanvasScale(canvas, samples[x], min, max);
+        if (x == 0u)
+        {
+            LCD_CanvasPixel(canvas, x, y, 1u);
+        }
+        else
+        {
+            LCD_CanvasLine(canvas, (uint8_t) (x - 1u), lastY, x, y);
+        }
+        lastY = y;
+    }
+
+    for (cell = 0u; cell < cells; cell++)
+    {
+        for (row = 0u; row < LCD_GLYPH_ROWS; row++)
+        {
+            if (picture[cell][row] != canvas->bits[cell][row])
+            {
+                canvas->dirty[cell] |= (uint8_t) (1u << row);
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanvasPush
+********************************************************************************
+*
+* Summary:
+*  Adds one sample to a sweeping trend: the sample is drawn in the next pixel
+*  column, joined to the previous sample, and the column after it is cleared
+*  as the gap that marks the newest sample. At the right edge the sweep
+*  restarts at the left.
+*
+* Parameters:
+*  canvas: Open canvas
+*  value:  Sample
+*  min:    Value drawn on the bottom row
+*  max:    Value drawn on the top row
+*
+* Return:
+*  None.
+*
+* Note:
+*  Only the rows of the two columns that change are marked, a flush after a
+*  slowly moving sample uploads a few CGRAM bytes.
+*
+*******************************************************************************/
+void LCD_CanvasPush(LCD_CANVAS *canvas, int16_t value, int16_t min, int16_t max)
+{
+    uint8_t width = (uint8_t) (canvas->cellsWide * LCD_CANVAS_CELL_WIDTH);
+    uint8_t height = (uint8_t) (canvas->cellsHigh * LCD_CANVAS_CELL_HEIGHT);
+    uint8_t x = canvas->sweep;
+    uint8_t y = LCD_CanvasScale(canvas, value, min, max);
+    uint8_t y0;
+    uint8_t y1;
+    uint8_t row;
+
+    if (width == 0u)
+    {
+        return;
+    }
+
+    /* From the previous sample to this one, or just this one after a wrap */
+    y0 = ((canvas->lastY == LCD_CANVAS_NO_SAMPLE) || (x == 0u)) ? y : canvas->lastY;
+    if (y0 < y)
+    {
+        y0++;
+    }
+    else if (y0 > y)
+    {
+        y0--;
+    }
+    else
+    {
+    }
+    y1 = (y0 < y) ? y : y0;
+    y0 = (y0 < y) ? y0 : y;
+
+    /* The connector replaces the old trace of this column pixel by pixel,
+    * pixels that stay as they were are not marked
+    */
+    for (row = 0u; row < height; row++)
+    {
+        LCD_CanvasPixel(canvas, x, row, ((row >= y0) && (row <= y1)) ? 1u : 0u);
+    }
+    LCD_CanvasColumn(canvas, (uint8_t) ((x + 1u) % width), 0u, (uint8_t) (height - 1u), 0u);
+
+    canvas->lastY = y;
+    canvas->sweep = (uint8_t) ((x + 1u) % width);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanvasFlush
+********************************************************************************
+*
+* Summary:
+*  Uploads the glyph rows changed since the last flush: per cell, one CGRAM
+*  address command and the rows from the first to the last changed one.
+*
+* Parameters:
+*  canvas: Open canvas
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_CanvasFlush(LCD_CANVAS *canvas)
+{
+    uint8_t cells = (uint8_t) (canvas->cellsWide * canvas->cellsHigh);
+    uint8_t cell;
+    uint8_t first;
+    uint8_t last;
+    uint8_t dirty;
+
+    for (cell = 0u; cell < cells; cell++)
+    {
+        dirty = canvas->dirty[cell];
+        if (dirty != 0u)
+        {
+            first = 0u;
+            while ((dirty & (1u << first)) == 0u)
+            {
+                first++;
+            }
+            last = LCD_GLYPH_ROWS - 1u;
+            while ((dirty & (1u << last)) == 0u)
+            {
+                last--;
+            }
+
+            LCD_GlyphUpdateRows(canvas->slot[cell], first, (uint8_t) (last - first + 1u));
+            canvas->dirty[cell] = 0u;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CanvasScale
+********************************************************************************
+*
+* Summary:
+*  Returns the pixel row of a value, max on the top row and min on the
+*  bottom one, clipped to the canvas.
+*
+*******************************************************************************/
+static uint8_t LCD_CanvasScale(LCD_CANVAS const *canvas, int16_t value, int16_t min, int16_t max)
+{
+    uint8_t height = (uint8_t) (canvas->cellsHigh * LCD_CANVAS_CELL_HEIGHT);
+    int32_t span = (int32_t) max - min;
+
+    if ((span <= 0) || (value <= min))
+    {
+        return (uint8_t) (height - 1u);
+    }
+    if (value >= max)
+    {
+        return 0u;
+    }
+
+    /* Rounded to the nearest row */
+    return (uint8_t) ((height - 1u) -
+           (uint8_t) (((((int32_t) value - min) * (int32_t) (height - 1u) * 2) + span) / (span * 2)));
+}
+
+#endif /* LCD_USE_CANVAS != 0u */
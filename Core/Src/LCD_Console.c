@@ -0,0 +1,320 @@
+/*
+ *  LCD_Console.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Rolling log console for the HD44780 LCD driver.
+ *
+ *  			LCD_ConsolePrint() copies one line of text into a ring of
+ *  			LCD_CONSOLE_LINES lines in RAM and returns; it never touches
+ *  			the bus, so events can be logged from interrupts at any rate.
+ *  			LCD_ConsoleUpdate() draws the window of the newest lines (or
+ *  			the page scrolled back to) into the framebuffer and flushes
+ *  			it. A scroll is then a framebuffer diff: only the cells that
+ *  			differ from the line that was there before are sent, and the
+ *  			lines logged between two updates cost nothing on the bus, the
+ *  			glass only shows the latest state.
+ *
+ *  Usage:      - LCD_ConsolePrint("pump 2 on") from any context up to
+ *  				LCD_BUS_MASK_PRIORITY, text past the last column (or after
+ *  				a '\n') is cut off
+ *  			- LCD_CONSOLE_DROP drops a line only while the ring is full of
+ *  				lines no LCD_ConsoleUpdate() has drawn yet
+ *  			- LCD_ConsoleUpdate() from the main loop; with LCD_USE_REFRESH
+ *  				(LCD_USE_POLL) the refresh task (LCD_Poll) does the flush
+ *  			- LCD_ConsolePageUp()/LCD_ConsolePageDown() scroll back by one
+ *  				screen; the window stays put while new lines come in, and
+ *  				follows them again once paged down to the end
+ *  			- the console owns every row of the primary display
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Latency.h"
+#include "LCD_Handle.h"
+#include "LCD_Console.h"
+#include "LCD_Transport.h"
+
+#if (LCD_USE_CONSOLE != 0u)
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    #error "LCD_USE_CONSOLE requires LCD_USE_FRAMEBUFFER"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+#if (((LCD_CONSOLE_LINES & (LCD_CONSOLE_LINES - 1u)) != 0u) || (LCD_CONSOLE_LINES < LCD_ROWS))
+    #error "LCD_CONSOLE_LINES must be a power of two of at least LCD_ROWS"
+#endif /* LCD_CONSOLE_LINES */
+
+#define LCD_CONSOLE_MASK             (LCD_CONSOLE_LINES - 1u)
+
+/* LCD_consoleView while the window follows the newest line */
+#define LCD_CONSOLE_FOLLOW           (0xFFFFFFFFu)
+
+static char LCD_consoleLines[LCD_CONSOLE_LINES][LCD_COLUMNS];
+
+/* Lines logged since the last clear, the newest is LCD_consoleCount - 1 */
+static volatile uint32_t LCD_consoleCount = 0u;
+
+/* LCD_consoleCount at the last update, the lines before it were drawn */
+static volatile uint32_t LCD_consoleDrawn = 0u;
+
+/* Line after the last one of a scrolled back window, or LCD_CONSOLE_FOLLOW */
+static uint32_t LCD_consoleView = LCD_CONSOLE_FOLLOW;
+
+/* Set by every change, the next update draws the window */
+static volatile uint8_t LCD_consoleChanged = 1u;
+static volatile uint32_t LCD_consoleDropped = 0u;
+
+static uint32_t LCD_ConsoleOldest(uint32_t count) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_ConsolePrint
+********************************************************************************
+*
+* Summary:
+*  Logs one line. Only RAM is written, the display follows at the next
+*  LCD_ConsoleUpdate().
+*
+* Parameters:
+*  text: Line, cut off at a '\n' or after LCD_COLUMNS characters
+*
+* Return:
+*  1 if logged, 0 if dropped (LCD_CONSOLE_DROP and the ring is full of
+*  lines no update has drawn yet).
+*
+* Reentrant:
+*  Yes, from any task or interrupt at LCD_BUS_MASK_PRIORITY and below.
+*
+*******************************************************************************/
+uint8_t LCD_ConsolePrint(char const text[])
+{
+    uint32_t saved;
+    char *line;
+    uint8_t column = 0u;
+
+    /* A line from an interrupt must not land in the middle of this one */
+    LCD_BUS_ATOMIC_BEGIN(saved);
+
+    #if (LCD_CONSOLE_POLICY == LCD_CONSOLE_DROP)
+        /* Lines already drawn may be overwritten, the others not */
+        if ((LCD_consoleCount - LCD_consoleDrawn) >= LCD_CONSOLE_LINES)
+        {
+            LCD_consoleDropped++;
+            LCD_BUS_ATOMIC_END(saved);
+            return 0u;
+        }
+    #endif /* LCD_CONSOLE_POLICY == LCD_CONSOLE_DROP */
+
+    line = LCD_consoleLines[LCD_consoleCount & LCD_CONSOLE_MASK];
+    for (; (column < LCD_COLUMNS) && (text[column] != '\0') && (text[column] != '\n'); column++)
+    {
+        line[column] = text[column];
+    }
+    for (; column < LCD_COLUMNS; column++)
+    {
+        line[column] = (char) LCD_FRAME_BLANK;
+    }
+
+    LCD_consoleCount++;
+    LCD_consoleChanged = 1u;
+
+    LCD_BUS_ATOMIC_END(saved);
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ConsoleUpdate
+********************************************************************************
+*
+* Summary:
+*  Draws the console window into the framebuffer if anything changed since
+*  the last call, and flushes the cells that differ.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if the window was drawn, 0 if nothing changed.
+*
+* Reentrant:
+*  No, one caller (main loop).
+*
+*******************************************************************************/
+uint8_t LCD_ConsoleUpdate(void)
+{
+    uint8_t const rows = LCD_display0.geometry->rows;
+    uint8_t const columns = LCD_display0.geometry->columns;
+    uint32_t count;
+    uint32_t oldest;
+    uint32_t end;
+    uint32_t line;
+    uint8_t row;
+    uint8_t column;
+    uint8_t character;
+
+    if (LCD_consoleChanged == 0u)
+    {
+        return 0u;
+    }
+
+    /* Lines logged while drawing set the flag again */
+    LCD_consoleChanged = 0u;
+    count = LCD_consoleCount;
+    LCD_consoleDrawn = count;
+    oldest = LCD_ConsoleOldest(count);
+
+    end = (LCD_consoleView == LCD_CONSOLE_FOLLOW) ? count : LCD_consoleView;
+    if (end < (oldest + rows))
+    {
+        /* The scrolled back page was overwritten, show the oldest one left */
+        end = ((oldest + rows) < count) ? (oldest + rows) : count;
+    }
+
+    for (row = 0u; row < rows; row++)
+    {
+        line = (end - rows) + row;
+        for (column = 0u; column < columns; column++)
+        {
+            /* Rows above the first line logged stay blank */
+            character = ((end >= (uint32_t) (rows - row)) && (line >= oldest)) ?
+                        (uint8_t) LCD_consoleLines[line & LCD_CONSOLE_MASK][column] :
+                        LCD_FRAME_BLANK;
+            LCD_LATENCY_CHANGE(row, column, character);
+            LCD_frame[row][column] = character;
+        }
+    }
+    LCD_frameDirty = 1u;
+
+    #if (LCD_FRAME_AUTO_FLUSH != 0u)
+        LCD_FlushFrame();
+    #endif /* LCD_FRAME_AUTO_FLUSH != 0u */
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ConsolePageUp
+********************************************************************************
+*
+* Summary:
+*  Scrolls the window back by one screen, as far as the oldest line kept.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ConsolePageUp(void)
+{
+    uint8_t const rows = LCD_display0.geometry->rows;
+    uint32_t const count = LCD_consoleCount;
+    uint32_t const oldest = LCD_ConsoleOldest(count);
+    uint32_t end = (LCD_consoleView == LCD_CONSOLE_FOLLOW) ? count : LCD_consoleView;
+
+    end = (end >= (oldest + rows + rows)) ? (end - rows) : (oldest + rows);
+    if (end < count)
+    {
+        LCD_consoleView = end;
+        LCD_consoleChanged = 1u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ConsolePageDown
+********************************************************************************
+*
+* Summary:
+*  Scrolls the window forward by one screen; past the newest line the window
+*  follows new lines again.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ConsolePageDown(void)
+{
+    if (LCD_consoleView != LCD_CONSOLE_FOLLOW)
+    {
+        LCD_consoleView += LCD_display0.geometry->rows;
+        if (LCD_consoleView >= LCD_consoleCount)
+        {
+            LCD_consoleView = LCD_CONSOLE_FOLLOW;
+        }
+        LCD_consoleChanged = 1u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ConsoleClear
+********************************************************************************
+*
+* Summary:
+*  Forgets every line; the next update blanks the display.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ConsoleClear(void)
+{
+    uint32_t saved;
+
+    LCD_BUS_ATOMIC_BEGIN(saved);
+    LCD_consoleCount = 0u;
+    LCD_consoleDrawn = 0u;
+    LCD_consoleView = LCD_CONSOLE_FOLLOW;
+    LCD_consoleChanged = 1u;
+    LCD_BUS_ATOMIC_END(saved);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ConsoleDropped
+********************************************************************************
+*
+* Summary:
+*  Returns the number of lines dropped by the LCD_CONSOLE_DROP policy.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Dropped lines since reset.
+*
+*******************************************************************************/
+uint32_t LCD_ConsoleDropped(void)
+{
+    return LCD_consoleDropped;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ConsoleOldest
+********************************************************************************
+*
+* Summary:
+*  Returns the number of the oldest line still in the ring.
+*
+*******************************************************************************/
+static uint32_t LCD_ConsoleOldest(uint32_t count)
+{
+    return (count > LCD_CONSOLE_LINES) ? (count - LCD_CONSOLE_LINES) : 0u;
+}
+
+#endif /* LCD_USE_CONSOLE != 0u */
@@ -0,0 +1,262 @@
+/*
+ *  LCD_Cost.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Operation cost model for the HD44780 LCD driver.
+ *
+ *  			A scheduler that has a time slot left asks what a print, a
+ *  			position or the pending flush would take before it calls the
+ *  			display. Each write costs the longer of its bus transfer and
+ *  			the execution time the next write has to wait for: the E
+ *  			cycle of the timing profile in LCD_busCycles and the (possibly
+ *  			calibrated) execution times of LCD_Timing.c on the parallel
+ *  			bus, the expander states and execution padding of the stream
+ *  			on I2C and SPI. The flush estimate walks the framebuffer the
+ *  			way LCD_FlushFrame() does and counts one address command per
+ *  			run, none where the tracked cursor already is.
+ *
+ *  Usage:      - if (LCD_EstimatePendingFlush().us < slotUs) LCD_FlushFrame();
+ *  				or LCD_EstimateCost(LCD_OP_PRINT_AT, 8u) for a field
+ *  			- the time includes what is left of the execution time of the
+ *  				last byte sent
+ *  			- estimates are for the selected display (LCD_active)
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Handle.h"
+#include "LCD_Geometry.h"
+#include "LCD_Timing.h"
+#include "LCD_Transport.h"
+#include "LCD_I2c.h"
+#include "LCD_Spi.h"
+#include "LCD_Cost.h"
+#include "LCD_Plan.h"
+
+#if (LCD_USE_COST_MODEL != 0u)
+
+/* Bus strobes per byte on the parallel bus */
+#if (LCD_BUS_8BIT != 0u)
+    #define LCD_COST_NIBBLES         (1u)
+#else
+    #define LCD_COST_NIBBLES         (2u)
+#endif /* LCD_BUS_8BIT != 0u */
+
+static uint32_t LCD_CostWriteCycles(uint8_t isLong) ;
+static LCD_COST LCD_CostMake(uint32_t cycles, uint16_t transactions) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_EstimateCost
+********************************************************************************
+*
+* Summary:
+*  Predicts the time and bus transactions of an operation on the selected
+*  display, without sending anything.
+*
+* Parameters:
+*  op:    LCD_OP_ value (LCD_Cost.h)
+*  count: Repetitions, characters for LCD_OP_PRINT and LCD_OP_PRINT_AT
+*
+* Return:
+*  Predicted cost, us rounded up. Zero for an unknown op.
+*
+* Note:
+*  A position is counted as sent; LCD_WriteControl() drops it at run time
+*  when the cursor is already there.
+*
+*******************************************************************************/
+LCD_COST LCD_EstimateCost(uint8_t op, uint16_t count)
+{
+    uint32_t const shortCycles = LCD_CostWriteCycles(0u);
+    LCD_COST cost = LCD_CostMake(0u, 0u);
+
+    switch (op)
+    {
+        case LCD_OP_COMMAND:
+        case LCD_OP_POSITION:
+        case LCD_OP_PRINT:
+            cost = LCD_CostMake(shortCycles * count, count);
+            break;
+        case LCD_OP_LONG_COMMAND:
+            cost = LCD_CostMake(LCD_CostWriteCycles(1u) * count, count);
+            break;
+        case LCD_OP_PRINT_AT:
+            cost = LCD_CostMake(shortCycles * (count + 1u), (uint16_t) (count + 1u));
+            break;
+        #if (LCD_USE_FRAMEBUFFER != 0u)
+            case LCD_OP_FLUSH:
+                cost = LCD_EstimatePendingFlush();
+                break;
+        #endif /* LCD_USE_FRAMEBUFFER != 0u */
+        default:
+            break;
+    }
+
+    return cost;
+}
+
+
+#if (LCD_USE_FRAMEBUFFER != 0u)
+/*******************************************************************************
+* Function Name: LCD_EstimatePendingFlush
+********************************************************************************
+*
+* Summary:
+*  Predicts what the next LCD_FlushFrame() sends: the cells that differ from
+*  the display, one address command per run of them within a DDRAM run.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Predicted cost, zero when the display already shows the framebuffer.
+*
+* Note:
+*  The address command of a run is not counted when the cursor mirror
+*  (LCD_USE_CURSOR_TRACKING) says the previous run left the cursor on its
+*  first cell. With LCD_USE_FLUSH_PLANNER the estimate walks the same plan
+*  as the flush.
+*
+*******************************************************************************/
+LCD_COST LCD_EstimatePendingFlush(void)
+{
+    uint16_t writes = 0u;
+    #if (LCD_USE_FLUSH_PLANNER != 0u)
+        LCD_PLAN plan;
+        LCD_PLAN_SPAN span;
+    #else
+        LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+        uint8_t cursor = LCD_CursorGet();
+        uint8_t address;
+        uint8_t row;
+        uint8_t column;
+        uint8_t runLimit;
+    #endif /* LCD_USE_FLUSH_PLANNER != 0u */
+
+    if ((LCD_frameDirty == 0u) || (LCD_display0.linkState == LCD_LINK_ABSENT))
+    {
+        return LCD_CostMake(0u, 0u);
+    }
+
+    #if (LCD_USE_FLUSH_PLANNER != 0u)
+        /* The writes LCD_FlushFrame() will make */
+        LCD_PlanStart(&plan);
+        while (LCD_PlanNext(&plan, &span) != 0u)
+        {
+            writes += (uint16_t) span.addressed + span.length;
+        }
+    #else
+        for (row = 0u; row < geometry->rows; row++)
+        {
+            column = 0u;
+            while (column < geometry->columns)
+            {
+                if (LCD_glass[row][column] == (uint16_t) LCD_frame[row][column])
+                {
+                    column++;
+                }
+                else
+                {
+                    address = LCD_GeometryAddress(geometry, row, column);
+                    if (address != cursor)
+                    {
+                        writes++;
+                    }
+
+                    runLimit = (column < geometry->split) ? geometry->split : geometry->columns;
+                    while ((column < runLimit) &&
+                           (LCD_glass[row][column] != (uint16_t) LCD_frame[row][column]))
+                    {
+                        column++;
+                        address++;
+                        writes++;
+                    }
+                    cursor = (LCD_CursorGet() != LCD_CURSOR_UNKNOWN) ? address : LCD_CURSOR_UNKNOWN;
+                }
+            }
+        }
+    #endif /* LCD_USE_FLUSH_PLANNER != 0u */
+
+    return LCD_CostMake(LCD_CostWriteCycles(0u) * writes, writes);
+}
+#endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+
+/*******************************************************************************
+* Function Name: LCD_CostWriteCycles
+********************************************************************************
+*
+* Summary:
+*  Returns the core cycles one command or data byte occupies on the
+*  transport of the selected display, including its execution time.
+*
+*******************************************************************************/
+static uint32_t LCD_CostWriteCycles(uint8_t isLong)
+{
+    uint32_t const execCycles = (isLong != 0u) ? LCD_execLongCycles : LCD_execShortCycles;
+    uint32_t busCycles;
+
+    #if ((LCD_USE_I2C_TRANSPORT != 0u) && \
+         ((LCD_TRANSPORT == LCD_TRANSPORT_I2C) || (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)))
+        #if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+            if (LCD_active->transport == &LCD_transportI2c)
+        #endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+        {
+            /* Expander states of the byte and the padding for its execution */
+            busCycles = LCD_I2C_BYTES_PER_BYTE +
+                        ((isLong != 0u) ? LCD_I2C_PAD(LCD_EXEC_LONG_US) : LCD_I2C_PAD(LCD_EXEC_SHORT_US));
+            return (uint32_t) (((uint64_t) busCycles * LCD_I2C_BYTE_NS * LCD_cyclesPerUs) / 1000u);
+        }
+    #endif /* LCD_USE_I2C_TRANSPORT != 0u */
+
+    #if ((LCD_USE_SPI_TRANSPORT != 0u) && \
+         ((LCD_TRANSPORT == LCD_TRANSPORT_SPI) || (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)))
+        #if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+            if (LCD_active->transport == &LCD_transportSpi)
+        #endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+        {
+            /* Latched steps of the byte and the idle steps of its execution */
+            busCycles = LCD_SPI_STATES_PER_BYTE +
+                        ((isLong != 0u) ? LCD_SPI_PAD(LCD_EXEC_LONG_US) : LCD_SPI_PAD(LCD_EXEC_SHORT_US));
+            return (uint32_t) (((uint64_t) busCycles * LCD_SPI_STEP_NS * LCD_cyclesPerUs) / 1000u);
+        }
+    #endif /* LCD_USE_SPI_TRANSPORT != 0u */
+
+    /* Parallel bus: the E cycles of the byte, overlapped by the execution
+     * time of the byte before
+     */
+    busCycles = LCD_COST_NIBBLES * (LCD_busCycles.setup + LCD_busCycles.pulse + LCD_busCycles.recover);
+
+    return (busCycles > execCycles) ? busCycles : execCycles;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_CostMake
+********************************************************************************
+*
+* Summary:
+*  Builds a cost from write cycles, adding what is left of the execution time
+*  of the last byte sent when anything is to be written.
+*
+*******************************************************************************/
+static LCD_COST LCD_CostMake(uint32_t cycles, uint16_t transactions)
+{
+    LCD_COST cost;
+
+    if (transactions != 0u)
+    {
+        cycles += LCD_TimingRemaining();
+    }
+
+    cost.us = (cycles + LCD_cyclesPerUs - 1u) / LCD_cyclesPerUs;
+    cost.transactions = transactions;
+
+    return cost;
+}
+
+#endif /* LCD_USE_COST_MODEL != 0u */
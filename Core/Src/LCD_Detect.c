@@ -0,0 +1,226 @@
+/*
+ *  LCD_Detect.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Presence and geometry detection of the HD44780 LCD driver.
+ *
+ *  			One firmware image may run on units with and without a
+ *  			display. LCD_DetectBus() pulls the data lines up and makes
+ *  			status reads (RS low, R/W high): a powered controller drives
+ *  			its address counter onto DB6-DB4, and AC6-AC4 never read 111b
+ *  			(DDRAM ends at 0x67, CGRAM at 0x3F), so three high lines on
+ *  			both reads mean nothing drives the bus. LCD_InitPoll() makes
+ *  			this probe before the power-on wait and repeats it until
+ *  			LCD_DETECT_POWER_MS after reset; a unit that never answers
+ *  			skips the handshake and the command sequence and is latched
+ *  			LCD_LINK_ABSENT, so every later write returns without a bus
+ *  			access and without a busy poll.
+ *
+ *  			Once initialized, LCD_DetectGeometry() writes two patterns to
+ *  			DDRAM lines 0 and 1 and reads them back. A controller that
+ *  			does not return them is taken as absent too; one that only
+ *  			keeps line 0 gets LCD_DETECT_GEOMETRY_1LINE. The controller
+ *  			holds its 2 x 40 DDRAM bytes whatever glass is fitted, so
+ *  			the column count and 2 or 4 rows cannot be sensed: a unit
+ *  			with both lines keeps LCD_GEOMETRY. 40x4 modules show up as
+ *  			a second controller answering on its own E line
+ *  			(LCD_USE_MULTI_DISPLAY, one detection per handle).
+ *
+ *  Usage:      - LCD_Init() / LCD_InitPoll() run both probes, then
+ *  				LCD_IsPresent() tells whether the unit has a display
+ *  			- needs a wiring that can read (GPIO transport)
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Timing.h"
+#include "LCD_Geometry.h"
+#include "LCD_Handle.h"
+#include "LCD_Transport.h"
+#include "LCD_Detect.h"
+
+#if (LCD_USE_DETECT != 0u)
+
+#if (LCD_TRANSPORT_HAS_GPIO == 0u)
+    #error "LCD_USE_DETECT reads the data lines (LCD_TRANSPORT_GPIO or _RUNTIME)"
+#endif /* LCD_TRANSPORT_HAS_GPIO == 0u */
+
+#if (LCD_GPIO_WRITE_ONLY != 0u)
+    #error "LCD_USE_DETECT needs R/nW, not the write-only wiring (LCD_GPIO_WRITE_ONLY)"
+#endif /* LCD_GPIO_WRITE_ONLY != 0u */
+
+#if (LCD_USE_PIN_MAP != 0u)
+    #error "LCD_USE_DETECT probes the data pins on DB4_GPIO_Port, not LCD_USE_PIN_MAP"
+#endif /* LCD_USE_PIN_MAP != 0u */
+
+static uint8_t LCD_DetectLine(uint8_t address, uint8_t pattern) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_DetectBus
+********************************************************************************
+*
+* Summary:
+*  Makes LCD_DETECT_STROBES status reads with the data lines pulled up and
+*  reports whether something drove them. Pin modes and output bits of the
+*  data port are put back as found.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if a controller drives the bus, 0 if the lines stayed pulled up.
+*
+* Note:
+*  Valid while the module is idle or in its internal reset; the address
+*  counter reads do not change the module state or the nibble phase.
+*
+*******************************************************************************/
+uint8_t LCD_DetectBus(void)
+{
+    /* DB6-DB4 carry AC6-AC4 on the first read of a status byte */
+    uint32_t const acBits = LCD_STM32_NIBBLE_MASK & ~LCD_PIN_BITS(DB7_Pin);
+    uint32_t const crl = DB4_GPIO_Port->CRL;
+    uint32_t const crh = DB4_GPIO_Port->CRH;
+    uint32_t const odr = DB4_GPIO_Port->ODR & LCD_STM32_BUS_MASK;
+    uint32_t value;
+    uint8_t strobe;
+    uint8_t driven = 0u;
+
+    /* Data lines: inputs, pulled up through the output bits */
+    WRITE_REG(DB4_GPIO_Port->BSRR, LCD_BSRR_SET(LCD_STM32_BUS_MASK));
+    LL_GPIO_SetPinMode(DB4_GPIO_Port, DB4_Pin, LL_GPIO_MODE_INPUT);
+    LL_GPIO_SetPinMode(DB5_GPIO_Port, DB5_Pin, LL_GPIO_MODE_INPUT);
+    LL_GPIO_SetPinMode(DB6_GPIO_Port, DB6_Pin, LL_GPIO_MODE_INPUT);
+    LL_GPIO_SetPinMode(DB7_GPIO_Port, DB7_Pin, LL_GPIO_MODE_INPUT);
+    #if (LCD_BUS_8BIT != 0u)
+        /* The module drives DB0-DB3 too while R/W is high */
+        LL_GPIO_SetPinMode(DB4_GPIO_Port, LCD_DB0_PIN, LL_GPIO_MODE_INPUT);
+        LL_GPIO_SetPinMode(DB4_GPIO_Port, LCD_DB1_PIN, LL_GPIO_MODE_INPUT);
+        LL_GPIO_SetPinMode(DB4_GPIO_Port, LCD_DB2_PIN, LL_GPIO_MODE_INPUT);
+        LL_GPIO_SetPinMode(DB4_GPIO_Port, LCD_DB3_PIN, LL_GPIO_MODE_INPUT);
+    #endif /* LCD_BUS_8BIT != 0u */
+
+    /* Status register read */
+    LL_GPIO_ResetOutputPin(RS_GPIO_Port, RS_Pin);
+    LL_GPIO_SetOutputPin(RnW_GPIO_Port, RnW_Pin);
+    LCD_DelaySetup();
+
+    for (strobe = 0u; strobe < LCD_DETECT_STROBES; strobe++)
+    {
+        WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_SET(LCD_E_BITS));
+        LCD_DelayRead();
+
+        value = LL_GPIO_ReadInputPort(DB4_GPIO_Port);
+
+        WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_RESET(LCD_E_BITS));
+        LCD_DelayRecover();
+
+        if ((value & acBits) != acBits)
+        {
+            driven = 1u;
+        }
+    }
+
+    LL_GPIO_ResetOutputPin(RnW_GPIO_Port, RnW_Pin);
+
+    /* Output bits first, so the pins come back as outputs at their old level */
+    WRITE_REG(DB4_GPIO_Port->BSRR, LCD_BSRR_SET(odr) | LCD_BSRR_RESET(odr ^ LCD_STM32_BUS_MASK));
+    WRITE_REG(DB4_GPIO_Port->CRL, crl);
+    WRITE_REG(DB4_GPIO_Port->CRH, crh);
+    LCD_BusInvalidate();
+
+    return driven;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_DetectGeometry
+********************************************************************************
+*
+* Summary:
+*  Writes LCD_DETECT_PATTERN_A and _B to the first cell of DDRAM lines 0 and
+*  1, then the swapped pair, reading each back. Selects the geometry of the
+*  lines that returned them and latches a display that returned neither
+*  LCD_LINK_ABSENT. Both cells are left blank and the address at 0,0.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Number of DDRAM lines that held data (0-2), or LCD_DETECT_UNREAD when the
+*  transport of the display cannot read.
+*
+* Note:
+*  Called by LCD_InitPoll() right after the clear, as part of LCD_Init().
+*
+*******************************************************************************/
+uint8_t LCD_DetectGeometry(void)
+{
+    uint8_t line0;
+    uint8_t line1;
+
+    line0 = LCD_DetectLine(0x00u, LCD_DETECT_PATTERN_A);
+    if (line0 == LCD_DETECT_UNREAD)
+    {
+        return LCD_DETECT_UNREAD;
+    }
+
+    line1 = LCD_DetectLine(LCD_DETECT_LINE1, LCD_DETECT_PATTERN_B);
+
+    /* Swapped: a line 1 that aliases line 0 returns the other pattern */
+    line0 &= LCD_DetectLine(0x00u, LCD_DETECT_PATTERN_B);
+    line1 &= LCD_DetectLine(LCD_DETECT_LINE1, LCD_DETECT_PATTERN_A);
+
+    /* Back to the cleared screen */
+    LCD_WriteControl(LCD_DDRAM_0 | LCD_DETECT_LINE1);
+    LCD_WriteData((uint8_t) ' ');
+    LCD_WriteControl(LCD_DDRAM_0);
+    LCD_WriteData((uint8_t) ' ');
+    LCD_WriteControl(LCD_DDRAM_0);
+
+    if (line0 == 0u)
+    {
+        /* Drives the bus but keeps nothing: not a working controller */
+        LCD_active->linkState = LCD_LINK_ABSENT;
+        return 0u;
+    }
+
+    if (line1 == 0u)
+    {
+        (void) LCD_SetGeometry(&LCD_geometries[LCD_DETECT_GEOMETRY_1LINE]);
+        return 1u;
+    }
+
+    return 2u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_DetectLine
+********************************************************************************
+*
+* Summary:
+*  Writes one byte to a DDRAM address and reads it back.
+*
+*******************************************************************************/
+static uint8_t LCD_DetectLine(uint8_t address, uint8_t pattern)
+{
+    uint16_t value;
+
+    LCD_WriteControl(LCD_DDRAM_0 | address);
+    LCD_WriteData(pattern);
+    LCD_WriteControl(LCD_DDRAM_0 | address);
+
+    value = LCD_ReadData();
+    if (value == LCD_READ_NONE)
+    {
+        return (LCD_active->linkState == LCD_LINK_UP) ? LCD_DETECT_UNREAD : 0u;
+    }
+
+    return (value == pattern) ? 1u : 0u;
+}
+
+#endif /* LCD_USE_DETECT != 0u */
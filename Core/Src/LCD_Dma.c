@@ -0,0 +1,553 @@
+/*
+ *  LCD_Dma.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Timer-triggered DMA transport for the HD44780 LCD driver.
+ *
+ *  			A stream of command/data bytes is encoded into GPIO BSRR words
+ *  			(data nibble + RS, E high, E low per nibble, then zero words for
+ *  			the execution time of the byte). TIM2 update events request DMA1
+ *  			Channel 2, which stores one word per timer step into the data
+ *  			port BSRR. The words are produced into a small ping-pong buffer
+ *  			from the half/full transfer interrupts, so RAM use does not grow
+ *  			with the stream length and the CPU is free while a frame goes out.
+ *
+ *  Usage:      - DB4-DB7, RS, R/nW and E must all be on the data port
+ *  				(DB4_GPIO_Port), LCD_DmaStart() fails otherwise
+ *  			- call LCD_DmaIRQHandler() from DMA1_Channel2_IRQHandler
+ *  			- the CPU driven API must not be used while LCD_DmaIsBusy()
+ *  			- parallel bus only: with LCD_TRANSPORT_RUNTIME no stream
+ *  				starts while the primary display is on I2C or SPI
+ *
+ */
+#include "main.h"
+#include "stm32f1xx_ll_tim.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Handle.h"
+#include "LCD_Dma.h"
+#include "LCD_Timing.h"
+#include "LCD_Transport.h"
+#include "LCD_Latency.h"
+
+#if (LCD_USE_DMA_TRANSPORT != 0u)
+
+#if ((LCD_TRANSPORT == LCD_TRANSPORT_I2C) || (LCD_TRANSPORT == LCD_TRANSPORT_SPI))
+    #error "LCD_USE_DMA_TRANSPORT drives the parallel bus pins directly, it cannot reach a display on LCD_TRANSPORT_I2C or LCD_TRANSPORT_SPI"
+#endif /* (LCD_TRANSPORT == LCD_TRANSPORT_I2C) || (LCD_TRANSPORT == LCD_TRANSPORT_SPI) */
+
+#if (LCD_CTRL_ON_DATA_PORT == 0u)
+    #error "LCD_USE_DMA_TRANSPORT requires LCD_CTRL_ON_DATA_PORT (RS, R/nW and E on the data port)"
+#endif /* LCD_CTRL_ON_DATA_PORT == 0u */
+
+#if (LCD_USE_PIN_MAP != 0u)
+    #error "LCD_USE_DMA_TRANSPORT plays the BSRR of DB4_GPIO_Port, not LCD_USE_PIN_MAP"
+#endif /* LCD_USE_PIN_MAP != 0u */
+
+#if (LCD_USE_PROFILER != 0u)
+    #error "LCD_USE_DMA_TRANSPORT paces the stream with TIM2, which LCD_USE_PROFILER owns"
+#endif /* LCD_USE_PROFILER != 0u */
+
+/* Ping-pong buffer, the DMA plays one half while the other is refilled */
+static uint32_t LCD_dmaBuffer[2u * LCD_DMA_HALF_WORDS];
+
+/* Stream being sent */
+static uint16_t const *LCD_dmaItems;
+static uint16_t LCD_dmaCount;
+static uint16_t LCD_dmaIndex;
+static LCD_DmaCallback LCD_dmaCallback;
+
+#if (LCD_USE_BLOB != 0u)
+    /* Blob being sent when LCD_dmaItems is NULL: segment and byte in it
+     * (0 = the command, n = text byte n - 1)
+     */
+    static LCD_BLOB_SEGMENT const *LCD_dmaSegment;
+    static uint8_t LCD_dmaOffset;
+#endif /* LCD_USE_BLOB != 0u */
+
+/* Encoder state: word of the current byte and zero words still to send */
+static uint8_t LCD_dmaPhase;
+static uint16_t LCD_dmaPad;
+
+/* Zero words needed for a short (37 us) and long (1.52 ms) execution time */
+static uint16_t LCD_dmaPadShort;
+static uint16_t LCD_dmaPadLong;
+
+/* Halves holding stream words that the DMA has not played yet */
+static uint8_t LCD_dmaPending;
+static volatile uint8_t LCD_dmaBusy = 0u;
+
+/* Items built by LCD_DmaFlushFrame() */
+static uint16_t LCD_dmaFrameItems[LCD_DMA_FRAME_ITEMS];
+
+static uint8_t LCD_DmaBegin(uint16_t count, LCD_DmaCallback callback) ;
+static uint16_t LCD_DmaItem(void) ;
+static uint8_t LCD_DmaFill(uint32_t *dst) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_DmaStart
+********************************************************************************
+*
+* Summary:
+*  Configures TIM2 (one DMA request per LCD_DMA_STEP_NS) and DMA1 Channel 2
+*  (memory to data port BSRR, circular, half/full transfer interrupts).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 on success, 0 if the LCD pins are not all on the data port.
+*
+*******************************************************************************/
+uint8_t LCD_DmaStart(void)
+{
+    uint32_t timerClock;
+    uint32_t stepTicks;
+
+    if ((RS_GPIO_Port != DB4_GPIO_Port) || (RnW_GPIO_Port != DB4_GPIO_Port) ||
+        (E_GPIO_Port != DB4_GPIO_Port))
+    {
+        return 0u;
+    }
+
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM2);
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+
+    /* APB1 timers run at twice PCLK1 whenever the APB1 prescaler is not 1 */
+    timerClock = HAL_RCC_GetPCLK1Freq();
+    if (timerClock != HAL_RCC_GetHCLKFreq())
+    {
+        timerClock *= 2u;
+    }
+    stepTicks = (uint32_t) (((uint64_t) timerClock * LCD_DMA_STEP_NS) / 1000000000u);
+    if (stepTicks == 0u)
+    {
+        stepTicks = 1u;
+    }
+
+    LL_TIM_DisableCounter(TIM2);
+    LL_TIM_SetPrescaler(TIM2, 0u);
+    LL_TIM_SetAutoReload(TIM2, stepTicks - 1u);
+    LL_TIM_GenerateEvent_UPDATE(TIM2);
+    LL_TIM_ClearFlag_UPDATE(TIM2);
+    LL_TIM_EnableDMAReq_UPDATE(TIM2);
+
+    LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_2);
+    LL_DMA_ConfigTransfer(DMA1, LL_DMA_CHANNEL_2,
+                          LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_MODE_CIRCULAR |
+                          LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                          LL_DMA_PDATAALIGN_WORD | LL_DMA_MDATAALIGN_WORD |
+                          LL_DMA_PRIORITY_HIGH);
+    LL_DMA_ConfigAddresses(DMA1, LL_DMA_CHANNEL_2, (uint32_t) LCD_dmaBuffer,
+                           (uint32_t) &DB4_GPIO_Port->BSRR, LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
+    LL_DMA_EnableIT_HT(DMA1, LL_DMA_CHANNEL_2);
+    LL_DMA_EnableIT_TC(DMA1, LL_DMA_CHANNEL_2);
+
+    HAL_NVIC_SetPriority(DMA1_Channel2_IRQn, LCD_DMA_IRQ_PRIORITY, 0u);
+    HAL_NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+
+    /* Rounded up, the E low word of the byte already counts as one step */
+    LCD_dmaPadShort = (uint16_t) (((LCD_EXEC_SHORT_US * 1000u) + LCD_DMA_STEP_NS - 1u) / LCD_DMA_STEP_NS);
+    LCD_dmaPadLong = (uint16_t) (((LCD_EXEC_LONG_US * 1000u) + LCD_DMA_STEP_NS - 1u) / LCD_DMA_STEP_NS);
+
+    /* The stream drives RS and R/nW behind LCD_WrDatNib()/LCD_WrCntrlNib() */
+    LCD_BusInvalidate();
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_DmaWrite
+********************************************************************************
+*
+* Summary:
+*  Starts sending a stream of commands and data through DMA and returns
+*  immediately.
+*
+* Parameters:
+*  items:    LCD_DMA_CMD()/LCD_DMA_DATA() entries, must stay valid until the
+*            callback runs
+*  count:    Number of entries
+*  callback: Called from the DMA interrupt when done, may be NULL
+*
+* Return:
+*  1 if the stream was started, 0 if a stream is already in progress or
+*  the display is not on the parallel bus.
+*
+*******************************************************************************/
+uint8_t LCD_DmaWrite(uint16_t const items[], uint16_t count, LCD_DmaCallback callback)
+{
+    if ((LCD_dmaBusy != 0u) || (LCD_BUS_PRIMARY_IS_GPIO() == 0u))
+    {
+        return 0u;
+    }
+
+    LCD_dmaItems = items;
+
+    return LCD_DmaBegin(count, callback);
+}
+
+
+#if (LCD_USE_BLOB != 0u)
+/*******************************************************************************
+* Function Name: LCD_DmaPlayBlob
+********************************************************************************
+*
+* Summary:
+*  DMA variant of LCD_PlayBlob(). The segments are encoded straight from the
+*  blob, nothing is copied to RAM.
+*
+* Parameters:
+*  blob:     Segments to send, must stay valid until the callback runs
+*  callback: Called from the DMA interrupt when done, may be NULL
+*
+* Return:
+*  1 if the stream was started, 0 if a stream is already in progress or
+*  the display is not on the parallel bus.
+*
+*******************************************************************************/
+uint8_t LCD_DmaPlayBlob(LCD_BLOB const *blob, LCD_DmaCallback callback)
+{
+    uint16_t count = 0u;
+    uint8_t index;
+
+    if ((LCD_dmaBusy != 0u) || (LCD_BUS_PRIMARY_IS_GPIO() == 0u))
+    {
+        return 0u;
+    }
+
+    for (index = 0u; index < blob->count; index++)
+    {
+        count += 1u + blob->segments[index].length;
+    }
+
+    /* The framebuffer holds the blob before it is on the glass, as a flush */
+    LCD_BlobMirror(blob);
+
+    LCD_dmaItems = NULL;
+    LCD_dmaSegment = blob->segments;
+    LCD_dmaOffset = 0u;
+
+    return LCD_DmaBegin(count, callback);
+}
+#endif /* LCD_USE_BLOB != 0u */
+
+
+/*******************************************************************************
+* Function Name: LCD_DmaBegin
+********************************************************************************
+*
+* Summary:
+*  Starts the timer and DMA on the stream selected by the caller.
+*
+* Parameters:
+*  count:    Number of stream items
+*  callback: Called from the DMA interrupt when done, may be NULL
+*
+* Return:
+*  1, the stream was started (or was empty and the callback already ran).
+*
+*******************************************************************************/
+static uint8_t LCD_DmaBegin(uint16_t count, LCD_DmaCallback callback)
+{
+    if (count == 0u)
+    {
+        if (callback != NULL)
+        {
+            callback();
+        }
+        return 1u;
+    }
+
+    LCD_dmaCount = count;
+    LCD_dmaIndex = 0u;
+    LCD_dmaCallback = callback;
+    LCD_dmaPhase = 0u;
+    LCD_dmaPad = 0u;
+    LCD_dmaPending = 0u;
+    LCD_dmaBusy = 1u;
+
+    /* The stream moves the address counter behind LCD.c */
+    LCD_CursorInvalidate();
+
+    /* Make sure the bus is driven and E is idle before the first word */
+    LL_GPIO_ResetOutputPin(E_GPIO_Port, E_Pin);
+
+    LCD_dmaPending += LCD_DmaFill(&LCD_dmaBuffer[0u]);
+    LCD_dmaPending += LCD_DmaFill(&LCD_dmaBuffer[LCD_DMA_HALF_WORDS]);
+
+    LL_DMA_ClearFlag_GI2(DMA1);
+    LL_DMA_SetDataLength(DMA1, LL_DMA_CHANNEL_2, 2u * LCD_DMA_HALF_WORDS);
+    LL_DMA_EnableChannel(DMA1, LL_DMA_CHANNEL_2);
+    LL_TIM_SetCounter(TIM2, 0u);
+    LL_TIM_EnableCounter(TIM2);
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_DmaFlushFrame
+********************************************************************************
+*
+* Summary:
+*  DMA variant of LCD_FlushFrame(). Builds the commands for the changed
+*  framebuffer runs and streams them without CPU involvement.
+*
+* Parameters:
+*  callback: Called from the DMA interrupt when the frame is on the glass
+*
+* Return:
+*  1 if the flush was started, 0 if a stream is already in progress.
+*
+*******************************************************************************/
+uint8_t LCD_DmaFlushFrame(LCD_DmaCallback callback)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+    uint16_t count = 0u;
+    uint8_t row;
+    uint8_t column;
+    uint8_t runLimit;
+
+    if ((LCD_dmaBusy != 0u) || (LCD_BUS_PRIMARY_IS_GPIO() == 0u))
+    {
+        return 0u;
+    }
+
+    for (row = 0u; row < geometry->rows; row++)
+    {
+        column = 0u;
+        while (column < geometry->columns)
+        {
+            if (LCD_glass[row][column] == (uint16_t) LCD_frame[row][column])
+            {
+                column++;
+            }
+            else
+            {
+                LCD_dmaFrameItems[count] = LCD_DMA_CMD(LCD_DdramAddress(row, column));
+                count++;
+                runLimit = (column < geometry->split) ? geometry->split : geometry->columns;
+                while ((column < runLimit) &&
+                       (LCD_glass[row][column] != (uint16_t) LCD_frame[row][column]))
+                {
+                    LCD_dmaFrameItems[count] = LCD_DMA_DATA(LCD_frame[row][column]);
+                    count++;
+                    LCD_glass[row][column] = LCD_frame[row][column];
+                    LCD_LATENCY_SENT(row, column);
+                    column++;
+                }
+            }
+        }
+    }
+
+    #if (LCD_USE_FRAME_SNAPSHOT != 0u)
+        LCD_FrameSave();
+    #endif /* LCD_USE_FRAME_SNAPSHOT != 0u */
+
+    return LCD_DmaWrite(LCD_dmaFrameItems, count, callback);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_DmaIsBusy
+********************************************************************************
+*
+* Summary:
+*  Reports whether a DMA stream is still going out.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 while busy, 0 when idle.
+*
+*******************************************************************************/
+uint8_t LCD_DmaIsBusy(void)
+{
+    return LCD_dmaBusy;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_DmaIRQHandler
+********************************************************************************
+*
+* Summary:
+*  Half/full transfer interrupt. Refills the half the DMA just played, or
+*  stops the timer and DMA once every stream word went out.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+LCD_RAMFUNC void LCD_DmaIRQHandler(void)
+{
+    uint32_t *played;
+
+    if (LL_DMA_IsActiveFlag_HT2(DMA1) != 0u)
+    {
+        LL_DMA_ClearFlag_HT2(DMA1);
+        played = &LCD_dmaBuffer[0u];
+    }
+    else if (LL_DMA_IsActiveFlag_TC2(DMA1) != 0u)
+    {
+        LL_DMA_ClearFlag_TC2(DMA1);
+        played = &LCD_dmaBuffer[LCD_DMA_HALF_WORDS];
+    }
+    else
+    {
+        LL_DMA_ClearFlag_GI2(DMA1);
+        return;
+    }
+
+    if (LCD_dmaPending != 0u)
+    {
+        LCD_dmaPending--;
+    }
+
+    if ((LCD_dmaPending == 0u) && (LCD_dmaIndex >= LCD_dmaCount) && (LCD_dmaPad == 0u))
+    {
+        LL_TIM_DisableCounter(TIM2);
+        LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_2);
+        LCD_dmaBusy = 0u;
+
+        /* Cells of an LCD_DmaFlushFrame() are on the glass now */
+        LCD_LATENCY_FLUSHED();
+
+        if (LCD_dmaCallback != NULL)
+        {
+            LCD_dmaCallback();
+        }
+    }
+    else
+    {
+        LCD_dmaPending += LCD_DmaFill(played);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_DmaItem
+********************************************************************************
+*
+* Summary:
+*  Returns the stream item being encoded, from the items array or the blob.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  LCD_DMA_CMD()/LCD_DMA_DATA() item.
+*
+*******************************************************************************/
+static LCD_RAMFUNC uint16_t LCD_DmaItem(void)
+{
+    #if (LCD_USE_BLOB != 0u)
+        if (LCD_dmaItems == NULL)
+        {
+            return (LCD_dmaOffset == 0u) ? LCD_DMA_CMD(LCD_dmaSegment->command) :
+                   LCD_DMA_DATA((uint8_t) LCD_dmaSegment->text[LCD_dmaOffset - 1u]);
+        }
+    #endif /* LCD_USE_BLOB != 0u */
+
+    return LCD_dmaItems[LCD_dmaIndex];
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_DmaFill
+********************************************************************************
+*
+* Summary:
+*  Encodes the next LCD_DMA_HALF_WORDS timer steps of the stream. Steps past
+*  the end of the stream are zero words (BSRR no-op).
+*
+* Parameters:
+*  dst: Half buffer to fill
+*
+* Return:
+*  1 if the half holds stream words, 0 if it is idle padding only.
+*
+*******************************************************************************/
+static LCD_RAMFUNC uint8_t LCD_DmaFill(uint32_t *dst)
+{
+    uint16_t word;
+    uint16_t item;
+    uint8_t used = 0u;
+
+    for (word = 0u; word < LCD_DMA_HALF_WORDS; word++)
+    {
+        if (LCD_dmaPad != 0u)
+        {
+            /* Waiting for the execution time of the previous byte */
+            dst[word] = 0u;
+            LCD_dmaPad--;
+            used = 1u;
+        }
+        else if (LCD_dmaIndex < LCD_dmaCount)
+        {
+            item = LCD_DmaItem();
+            used = 1u;
+
+            switch (LCD_dmaPhase)
+            {
+                case 0u:
+                case 3u:
+                    /* Data nibble, RS and R/nW settle while E is low (tAS) */
+                    dst[word] = LCD_BSRR_RESET(LCD_PIN_BITS(E_Pin)) |
+                                LCD_nibbleBsrr[((item & LCD_DMA_RS) != 0u) ? 1u : 0u]
+                                              [(LCD_dmaPhase == 0u) ? ((item >> LCD_NIBBLE_SHIFT) & LCD_NIBBLE_MASK) :
+                                                                      (item & LCD_NIBBLE_MASK)];
+                    #if (LCD_BUS_8BIT != 0u)
+                        /* Whole byte in one strobe */
+                        dst[word] |= LCD_LOW_NIBBLE_BSRR(item & LCD_NIBBLE_MASK);
+                    #endif /* LCD_BUS_8BIT != 0u */
+                    break;
+                case 1u:
+                case 4u:
+                    dst[word] = LCD_BSRR_SET(LCD_PIN_BITS(E_Pin));
+                    break;
+                default:
+                    /* Falling edge latches the nibble */
+                    dst[word] = LCD_BSRR_RESET(LCD_PIN_BITS(E_Pin));
+                    break;
+            }
+
+            LCD_dmaPhase++;
+            if (LCD_dmaPhase >= LCD_DMA_WORDS_PER_BYTE)
+            {
+                LCD_dmaPhase = 0u;
+                LCD_dmaIndex++;
+                #if (LCD_USE_BLOB != 0u)
+                    if (LCD_dmaItems == NULL)
+                    {
+                        LCD_dmaOffset++;
+                        if (LCD_dmaOffset > LCD_dmaSegment->length)
+                        {
+                            LCD_dmaOffset = 0u;
+                            LCD_dmaSegment++;
+                        }
+                    }
+                #endif /* LCD_USE_BLOB != 0u */
+                LCD_dmaPad = (((item & LCD_DMA_RS) == 0u) && LCD_IS_LONG_CMD(item & 0xFFu)) ?
+                             LCD_dmaPadLong : LCD_dmaPadShort;
+            }
+        }
+        else
+        {
+            dst[word] = 0u;
+        }
+    }
+
+    return used;
+}
+
+#endif /* LCD_USE_DMA_TRANSPORT != 0u */
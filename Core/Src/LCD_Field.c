@@ -0,0 +1,345 @@
+/*
+ *  LCD_Field.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Screen layouts of labels and values for the HD44780 LCD driver.
+ *
+ *  			A screen is an application table of LCD_FIELD entries: row,
+ *  			column, width, format and either a pointer to the value or a
+ *  			value given by LCD_FieldSet(). LCD_FieldUpdate() formats every
+ *  			field into a scratch buffer and compares it with the bytes the
+ *  			field last put on the display; only a field whose text changed
+ *  			is written, and labels are written once. With
+ *  			LCD_USE_FRAMEBUFFER the writes land in the framebuffer and the
+ *  			next LCD_FlushFrame() sends only the cells that differ.
+ *
+ *  Usage:      - static LCD_FIELD screen[] = { LCD_FIELD_LABEL_AT(0u, 0u, "T="),
+ *  				LCD_FIELD_INIT(0u, 2u, 5u, LCD_FIELD_SCALED, 1u, &temp) };
+ *  			- LCD_FieldSetTable(screen, 2u) once per screen change, then
+ *  				LCD_FieldUpdate() (and LCD_FlushFrame()) from the main loop
+ *  			- LCD_UpdateNumber(index, value) sets and writes one number
+ *  				field at once (LCD_Position() + print, diffed per digit)
+ *  			- sources: uint32_t for U32 formats, int32_t for S32/SCALED,
+ *  				char const[] for texts; text fields compare the text, so a
+ *  				buffer rewritten in place is picked up
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Format.h"
+#include "LCD_Field.h"
+
+#if (LCD_USE_FIELDS != 0u)
+
+static LCD_FIELD *LCD_fieldTable = NULL;
+static uint8_t LCD_fieldCount = 0u;
+
+static uint8_t LCD_FieldDraw(LCD_FIELD *field) ;
+static uint8_t LCD_FieldRender(LCD_FIELD const *field, char cells[]) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_FieldSetTable
+********************************************************************************
+*
+* Summary:
+*  Selects the field table of the screen; every field is drawn by the next
+*  LCD_FieldUpdate().
+*
+* Parameters:
+*  table: Fields, must stay valid while selected
+*  count: Number of fields
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FieldSetTable(LCD_FIELD table[], uint8_t count)
+{
+    LCD_fieldTable = table;
+    LCD_fieldCount = count;
+    LCD_FieldInvalidate();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FieldSet
+********************************************************************************
+*
+* Summary:
+*  Sets the value of a number field without a source pointer. The display
+*  is written by LCD_FieldUpdate(), and only if the text changes.
+*
+* Parameters:
+*  index: Field of the selected table
+*  value: uint32_t, or an int32_t cast for the signed formats
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FieldSet(uint8_t index, uint32_t value)
+{
+    if (index < LCD_fieldCount)
+    {
+        LCD_fieldTable[index].value = value;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FieldSetText
+********************************************************************************
+*
+* Summary:
+*  Points a text or label field at another string.
+*
+* Parameters:
+*  index: Field of the selected table
+*  text:  Terminated string, must stay valid while the table is selected
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FieldSetText(uint8_t index, char const text[])
+{
+    if (index < LCD_fieldCount)
+    {
+        LCD_fieldTable[index].source = text;
+        if (LCD_fieldTable[index].format == LCD_FIELD_LABEL)
+        {
+            LCD_fieldTable[index].drawn = 0u;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FieldUpdate
+********************************************************************************
+*
+* Summary:
+*  Writes every field whose formatted text differs from what it last put on
+*  the display, and labels not drawn yet.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Number of fields written (0: nothing to flush).
+*
+*******************************************************************************/
+uint8_t LCD_FieldUpdate(void)
+{
+    uint8_t written = 0u;
+    uint8_t index;
+
+    for (index = 0u; index < LCD_fieldCount; index++)
+    {
+        written += LCD_FieldDraw(&LCD_fieldTable[index]);
+    }
+
+    return written;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UpdateNumber
+********************************************************************************
+*
+* Summary:
+*  Sets the value of one number field and writes it right away, from the
+*  first cell that differs from what it shows. A counter that ticks by one
+*  mostly costs one or two cells instead of the whole number.
+*
+* Parameters:
+*  index: Field of the selected table (a number format)
+*  value: uint32_t, or int32_t cast for the S32/SCALED formats
+*
+* Return:
+*  1 if the field was written, 0 if it already showed the value.
+*
+*******************************************************************************/
+uint8_t LCD_UpdateNumber(uint8_t index, uint32_t value)
+{
+    if ((index >= LCD_fieldCount) || (LCD_fieldTable[index].format < LCD_FIELD_U32))
+    {
+        return 0u;
+    }
+
+    LCD_fieldTable[index].value = value;
+
+    return LCD_FieldDraw(&LCD_fieldTable[index]);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FieldInvalidate
+********************************************************************************
+*
+* Summary:
+*  Forgets what the fields put on the display, the next LCD_FieldUpdate()
+*  draws every field and label. Called on clear display and initialization.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FieldInvalidate(void)
+{
+    uint8_t index;
+
+    for (index = 0u; index < LCD_fieldCount; index++)
+    {
+        LCD_fieldTable[index].drawn = 0u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FieldDraw
+********************************************************************************
+*
+* Summary:
+*  Writes a label not drawn yet, or the cells of a value field from the
+*  first to the last one that changed. Returns 1 if anything was written.
+*
+*******************************************************************************/
+static uint8_t LCD_FieldDraw(LCD_FIELD *field)
+{
+    char cells[LCD_FIELD_WIDTH_MAX];
+    uint8_t cell;
+    uint8_t width;
+
+    if (field->format == LCD_FIELD_LABEL)
+    {
+        if ((field->drawn != 0u) || (field->source == NULL))
+        {
+            return 0u;
+        }
+        LCD_PrintAt(field->row, field->column, (char const *) field->source);
+        field->drawn = 1u;
+        return 1u;
+    }
+
+    width = LCD_FieldRender(field, cells);
+
+    /* Compare first, most updates of a screen change nothing */
+    cell = 0u;
+    if (field->drawn != 0u)
+    {
+        while ((cell < width) && (cells[cell] == field->shown[cell]))
+        {
+            cell++;
+        }
+        if (cell == width)
+        {
+            return 0u;
+        }
+    }
+
+    /* Only the cells from the first change on, one run */
+    while ((width > cell) && (field->drawn != 0u) && (cells[width - 1u] == field->shown[width - 1u]))
+    {
+        width--;
+    }
+
+    LCD_Position(field->row, (uint8_t) (field->column + cell));
+    LCD_PrintStringN(&cells[cell], (size_t) (width - cell));
+
+    for (; cell < width; cell++)
+    {
+        field->shown[cell] = cells[cell];
+    }
+    field->drawn = 1u;
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FieldRender
+********************************************************************************
+*
+* Summary:
+*  Formats the current value of a field into its cells and returns the
+*  width (clipped to LCD_FIELD_WIDTH_MAX).
+*
+*******************************************************************************/
+static uint8_t LCD_FieldRender(LCD_FIELD const *field, char cells[])
+{
+    char text[LCD_NUMBER_TEXT_MAX];
+    char const *string;
+    uint32_t value = field->value;
+    uint8_t width = (field->width > LCD_FIELD_WIDTH_MAX) ? LCD_FIELD_WIDTH_MAX : field->width;
+    uint8_t length = 0u;
+    uint8_t cell;
+
+    if (field->format == LCD_FIELD_TEXT)
+    {
+        string = (char const *) field->source;
+        for (cell = 0u; cell < width; cell++)
+        {
+            if ((string != NULL) && (string[length] != '\0'))
+            {
+                cells[cell] = string[length];
+                length++;
+            }
+            else
+            {
+                cells[cell] = ' ';
+            }
+        }
+        return width;
+    }
+
+    if (field->source != NULL)
+    {
+        value = *(uint32_t const *) field->source;
+    }
+
+    switch (field->format)
+    {
+        case LCD_FIELD_U32:
+        case LCD_FIELD_U32_ZERO:
+            length = LCD_FormatU32(text, value);
+            string = &text[LCD_U32_DIGITS - length];
+            break;
+
+        case LCD_FIELD_S32:
+            length = LCD_FormatScaled(text, (int32_t) value, 0u);
+            string = text;
+            break;
+
+        default:
+            length = LCD_FormatScaled(text, (int32_t) value, field->decimals);
+            string = text;
+            break;
+    }
+
+    for (cell = 0u; cell < width; cell++)
+    {
+        if (length > width)
+        {
+            cells[cell] = LCD_FIELD_OVERFLOW;
+        }
+        else if (cell < (uint8_t) (width - length))
+        {
+            cells[cell] = (field->format == LCD_FIELD_U32_ZERO) ? '0' : ' ';
+        }
+        else
+        {
+            cells[cell] = string[cell - (width - length)];
+        }
+    }
+
+    return width;
+}
+
+#endif /* LCD_USE_FIELDS != 0u */
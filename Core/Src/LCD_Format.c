@@ -0,0 +1,501 @@
+/*
+ *  LCD_Format.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Division-free decimal formatting for the HD44780 LCD driver.
+ *
+ *  			Digits are produced with a multiply by the reciprocal of 10
+ *  			instead of "% 10" and "/ 10": a single UMULL per digit above
+ *  			16 bits and a 32-bit MUL per digit below, so u8/u16 values take
+ *  			the short path automatically. Run time is bounded by the digit
+ *  			count (at most 10).
+ *
+ *  			LCD_PrintU32Fixed() right-justifies into a fixed-width field, so
+ *  			a numeric field is rewritten in one pass without clearing it
+ *  			first. LCD_PrintU32Right() writes the field from its right
+ *  			edge in decrement entry mode, each digit as the division loop
+ *  			produces it, so no digit buffer is reversed.
+ *
+ *  			LCD_PrintS32(), LCD_PrintFixed() (Q format) and LCD_PrintFloat()
+ *  			cover signed and fractional sensor values without snprintf, so
+ *  			newlib printf and its heap use stay out of the image. None of
+ *  			them allocate and all run in bounded time.
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Format.h"
+#include "LCD_Frame.h"
+#include "LCD_Handle.h"
+
+
+/*******************************************************************************
+* Function Name: LCD_FormatU32
+********************************************************************************
+*
+* Summary:
+*  Converts an unsigned value to decimal ASCII, right-aligned at the end of
+*  "digits".
+*
+* Parameters:
+*  digits: Buffer of LCD_U32_DIGITS characters (not zero terminated)
+*  value:  Value to convert
+*
+* Return:
+*  Number of digits, they start at digits[LCD_U32_DIGITS - count].
+*
+*******************************************************************************/
+uint8_t LCD_FormatU32(char digits[], uint32_t value)
+{
+    uint8_t index = LCD_U32_DIGITS;
+    uint32_t quotient;
+
+    /* Above 16 bits the reciprocal needs the 64-bit product */
+    while (value > 0xFFFFu)
+    {
+        quotient = LCD_DIV10_U32(value);
+        index--;
+        digits[index] = (char) ((value - (quotient * LCD_TEN)) + LCD_ZERO_CHAR_ASCII);
+        value = quotient;
+    }
+
+    while (value >= LCD_TEN)
+    {
+        quotient = LCD_DIV10_U16(value);
+        index--;
+        digits[index] = (char) ((value - (quotient * LCD_TEN)) + LCD_ZERO_CHAR_ASCII);
+        value = quotient;
+    }
+
+    index--;
+    digits[index] = (char) (value + LCD_ZERO_CHAR_ASCII);
+
+    return (uint8_t) (LCD_U32_DIGITS - index);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintU32Fixed
+********************************************************************************
+*
+* Summary:
+*  Prints an uint32 value right-justified in a field of "width" characters,
+*  padded on the left with "pad" (' ' or '0').
+*
+* Parameters:
+*  value: Value to print
+*  width: Field width, 0 prints the digits only
+*  pad:   Padding character
+*
+* Return:
+*  None.
+*
+* Note:
+*  Values wider than the field are printed in full. Width is limited to
+*  LCD_FORMAT_FIELD_MAX.
+*
+*******************************************************************************/
+void LCD_PrintU32Fixed(uint32_t value, uint8_t width, char pad)
+{
+    char field[LCD_FORMAT_FIELD_MAX + LCD_U32_DIGITS];
+    char digits[LCD_U32_DIGITS];
+    uint8_t count;
+    uint8_t length = 0u;
+    uint8_t index;
+
+    if (width > LCD_FORMAT_FIELD_MAX)
+    {
+        width = LCD_FORMAT_FIELD_MAX;
+    }
+
+    count = LCD_FormatU32(digits, value);
+
+    while ((uint8_t) (length + count) < width)
+    {
+        field[length] = pad;
+        length++;
+    }
+
+    for (index = LCD_U32_DIGITS - count; index < LCD_U32_DIGITS; index++)
+    {
+        field[length] = digits[index];
+        length++;
+    }
+
+    LCD_PrintStringN(field, length);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintU32Right
+********************************************************************************
+*
+* Summary:
+*  Prints an uint32 value right-justified, ending at a given column: the
+*  cursor is put on the last cell and the digits are written leftwards,
+*  least significant first, then blanks up to "width". Without the
+*  framebuffer the module runs in decrement entry mode for it (the switch is
+*  skipped when it already is, and undone by the next print).
+*
+* Parameters:
+*  row:    Row of the field
+*  column: Column of the last (rightmost) cell
+*  value:  Value to print
+*  width:  Field width, 0 prints the digits only
+*
+* Return:
+*  None.
+*
+* Note:
+*  Cells left of column 0 are not written, a wider value loses its leading
+*  digits.
+*
+*******************************************************************************/
+void LCD_PrintU32Right(uint8_t row, uint8_t column, uint32_t value, uint8_t width)
+{
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+        uint8_t const cursorRow = LCD_frameRow;
+        uint8_t const cursorColumn = LCD_frameColumn;
+    #else
+        LCD_GEOMETRY_STRUCT const *geometry = LCD_active->geometry;
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+    uint32_t quotient;
+    uint8_t count;
+    char character;
+
+    if ((row >= geometry->rows) || (column >= geometry->columns))
+    {
+        return;
+    }
+
+    #if (LCD_USE_FRAMEBUFFER == 0u)
+        LCD_SetEntryDirection(0u);
+    #endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+    for (count = 0u; count <= column; count++)
+    {
+        if ((count != 0u) && (value == 0u))
+        {
+            if (count >= width)
+            {
+                break;
+            }
+            character = ' ';
+        }
+        else
+        {
+            quotient = (value > 0xFFFFu) ? LCD_DIV10_U32(value) : LCD_DIV10_U16(value);
+            character = (char) ((value - (quotient * LCD_TEN)) + LCD_ZERO_CHAR_ASCII);
+            value = quotient;
+        }
+
+        #if (LCD_USE_FRAMEBUFFER != 0u)
+            /* Through the framebuffer store, for the attributes and probes */
+            LCD_FramePosition(row, (uint8_t) (column - count));
+            LCD_FrameWriteChar((uint8_t) character);
+        #else
+            /* The address counter does not step over the DDRAM gap of a split row */
+            if ((count == 0u) || ((uint8_t) (column - count) == (uint8_t) (geometry->split - 1u)))
+            {
+                LCD_WritePosition(row, (uint8_t) (column - count));
+            }
+            LCD_WriteData((uint8_t) character);
+        #endif /* LCD_USE_FRAMEBUFFER != 0u */
+    }
+
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        /* The shadow cursor stays where the caller left it */
+        LCD_FramePosition(cursorRow, cursorColumn);
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+}
+
+
+/* Powers of ten for the fraction digits */
+static const uint32_t LCD_pow10[LCD_DECIMALS_MAX + 1u] =
+{
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+static void LCD_PrintDecimal(uint8_t negative, uint32_t integer, uint32_t fraction, uint8_t decimals) ;
+static uint8_t LCD_FormatDecimal(char text[], uint8_t negative, uint32_t integer, uint32_t fraction, uint8_t decimals) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_FormatScaled
+********************************************************************************
+*
+* Summary:
+*  Converts a signed value scaled by 10^decimals into text, e.g. (1234, 2u)
+*  gives "12.34" and (-5, 1u) gives "-0.5".
+*
+* Parameters:
+*  text:     LCD_NUMBER_TEXT_MAX characters, not terminated
+*  value:    Value * 10^decimals
+*  decimals: Fraction digits (0 - LCD_DECIMALS_MAX)
+*
+* Return:
+*  Number of characters, from text[0].
+*
+*******************************************************************************/
+uint8_t LCD_FormatScaled(char text[], int32_t value, uint8_t decimals)
+{
+    uint32_t magnitude = (value < 0) ? ((uint32_t) (-(value + 1)) + 1u) : (uint32_t) value;
+
+    if (decimals > LCD_DECIMALS_MAX)
+    {
+        decimals = LCD_DECIMALS_MAX;
+    }
+
+    return LCD_FormatDecimal(text, (value < 0) ? 1u : 0u, magnitude / LCD_pow10[decimals],
+                             magnitude % LCD_pow10[decimals], decimals);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintS32
+********************************************************************************
+*
+* Summary:
+*  Prints an int32 value as a left-justified decimal value with a leading '-'
+*  for negative values.
+*
+* Parameters:
+*  value: Value to print
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PrintS32(int32_t value)
+{
+    /* Magnitude without overflowing on INT32_MIN */
+    uint32_t magnitude = (value < 0) ? ((uint32_t) (-(value + 1)) + 1u) : (uint32_t) value;
+
+    LCD_PrintDecimal((value < 0) ? 1u : 0u, magnitude, 0u, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintFixed
+********************************************************************************
+*
+* Summary:
+*  Prints a signed fixed-point value (Q format) with "decimals" rounded
+*  fraction digits, e.g. LCD_PrintFixed(0x0180, 8u, 2u) prints "1.50".
+*
+* Parameters:
+*  value:    Fixed-point value, value / 2^fracBits
+*  fracBits: Number of fraction bits (0 - LCD_FRAC_BITS_MAX)
+*  decimals: Fraction digits printed (0 - LCD_DECIMALS_MAX)
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PrintFixed(int32_t value, uint8_t fracBits, uint8_t decimals)
+{
+    uint32_t magnitude = (value < 0) ? ((uint32_t) (-(value + 1)) + 1u) : (uint32_t) value;
+    uint32_t integer;
+    uint64_t fraction;
+
+    if (fracBits > LCD_FRAC_BITS_MAX)
+    {
+        fracBits = LCD_FRAC_BITS_MAX;
+    }
+    if (decimals > LCD_DECIMALS_MAX)
+    {
+        decimals = LCD_DECIMALS_MAX;
+    }
+
+    integer = magnitude >> fracBits;
+    fraction = (uint64_t) (magnitude & ((1u << fracBits) - 1u));
+
+    /* Scale the fraction bits to "decimals" digits, rounded to nearest */
+    fraction *= LCD_pow10[decimals];
+    if (fracBits != 0u)
+    {
+        fraction = (fraction + ((uint64_t) 1u << (fracBits - 1u))) >> fracBits;
+    }
+
+    if (fraction >= LCD_pow10[decimals])
+    {
+        /* Rounded up into the integer part */
+        fraction -= LCD_pow10[decimals];
+        integer++;
+    }
+
+    LCD_PrintDecimal((value < 0) ? 1u : 0u, integer, (uint32_t) fraction, decimals);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintFloat
+********************************************************************************
+*
+* Summary:
+*  Prints a float with "decimals" rounded fraction digits, without printf.
+*  The Cortex-M3 has no FPU, so this costs a handful of soft-float
+*  operations, independent of the value.
+*
+* Parameters:
+*  value:    Value to print
+*  decimals: Fraction digits printed (0 - LCD_DECIMALS_MAX)
+*
+* Return:
+*  None.
+*
+* Note:
+*  NaN prints LCD_FLOAT_NAN_TEXT, magnitudes from 2^32 up (and infinity)
+*  print LCD_FLOAT_OVF_TEXT. A float holds about 7 significant digits.
+*
+*******************************************************************************/
+void LCD_PrintFloat(float value, uint8_t decimals)
+{
+    char text[LCD_NUMBER_TEXT_MAX];
+
+    LCD_PrintStringN(text, LCD_FormatFloat(text, value, decimals));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FormatFloat
+********************************************************************************
+*
+* Summary:
+*  Converts a float to [-]integer[.fraction] text, rounded to "decimals"
+*  fraction digits (the text LCD_PrintFloat() prints).
+*
+* Parameters:
+*  text:     LCD_NUMBER_TEXT_MAX characters, not terminated
+*  value:    Value to convert
+*  decimals: Fraction digits (0 - LCD_DECIMALS_MAX)
+*
+* Return:
+*  Number of characters, from text[0].
+*
+*******************************************************************************/
+uint8_t LCD_FormatFloat(char text[], float value, uint8_t decimals)
+{
+    char const *special = LCD_FLOAT_NAN_TEXT;
+    uint8_t negative = 0u;
+    uint8_t length = 0u;
+    uint32_t integer;
+    uint32_t fraction;
+    float scaled;
+
+    if (value == value)
+    {
+        if (value < 0.0f)
+        {
+            negative = 1u;
+            value = -value;
+        }
+
+        if (value < 4294967296.0f)
+        {
+            if (decimals > LCD_DECIMALS_MAX)
+            {
+                decimals = LCD_DECIMALS_MAX;
+            }
+
+            integer = (uint32_t) value;
+            scaled = ((value - (float) integer) * (float) LCD_pow10[decimals]) + 0.5f;
+            fraction = (uint32_t) scaled;
+
+            if (fraction >= LCD_pow10[decimals])
+            {
+                fraction -= LCD_pow10[decimals];
+                integer++;
+            }
+
+            return LCD_FormatDecimal(text, negative, integer, fraction, decimals);
+        }
+
+        if (negative != 0u)
+        {
+            text[length] = '-';
+            length++;
+        }
+        special = LCD_FLOAT_OVF_TEXT;
+    }
+
+    /* NaN, or a magnitude from 2^32 up (and infinity) */
+    for (; *special != '\0'; special++)
+    {
+        text[length] = *special;
+        length++;
+    }
+
+    return length;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintDecimal
+********************************************************************************
+*
+* Summary:
+*  Prints [-]integer[.fraction] with the fraction zero padded to "decimals"
+*  digits, as one run.
+*
+*******************************************************************************/
+static void LCD_PrintDecimal(uint8_t negative, uint32_t integer, uint32_t fraction, uint8_t decimals)
+{
+    char text[LCD_NUMBER_TEXT_MAX];
+
+    LCD_PrintStringN(text, LCD_FormatDecimal(text, negative, integer, fraction, decimals));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FormatDecimal
+********************************************************************************
+*
+* Summary:
+*  Writes [-]integer[.fraction] into text, the fraction zero padded to
+*  "decimals" digits, and returns the length.
+*
+*******************************************************************************/
+static uint8_t LCD_FormatDecimal(char text[], uint8_t negative, uint32_t integer, uint32_t fraction, uint8_t decimals)
+{
+    char digits[LCD_U32_DIGITS];
+    uint8_t length = 0u;
+    uint8_t count;
+    uint8_t index;
+
+    if (negative != 0u)
+    {
+        text[length] = '-';
+        length++;
+    }
+
+    count = LCD_FormatU32(digits, integer);
+    for (index = LCD_U32_DIGITS - count; index < LCD_U32_DIGITS; index++)
+    {
+        text[length] = digits[index];
+        length++;
+    }
+
+    if (decimals != 0u)
+    {
+        text[length] = '.';
+        length++;
+
+        count = LCD_FormatU32(digits, fraction);
+        for (index = count; index < decimals; index++)
+        {
+            text[length] = '0';
+            length++;
+        }
+        for (index = LCD_U32_DIGITS - count; index < LCD_U32_DIGITS; index++)
+        {
+            text[length] = digits[index];
+            length++;
+        }
+    }
+
+    return length;
+}
@@ -0,0 +1,639 @@
+/*
+ *  LCD_Frame.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: RAM shadow framebuffer for the HD44780 LCD driver.
+ *
+ *  			LCD_PutChar/LCD_PrintString/LCD_Position only update LCD_frame
+ *  			when LCD_USE_FRAMEBUFFER is set in LCD_Config.h. LCD_FlushFrame()
+ *  			compares LCD_frame against LCD_glass (the cells already sent to
+ *  			the module) and writes only the cells that differ, with a single
+ *  			set-DDRAM-address command per contiguous run of changed cells.
+ *  			Bus traffic then depends on how much of the screen changed
+ *  			instead of on the screen size.
+ *
+ *  			With LCD_USE_FRAME_SNAPSHOT every flush that changed the frame
+ *  			also copies it, with a checksum, into a .noinit section the
+ *  			startup code leaves alone. After a watchdog or brown-out reset
+ *  			the initialization puts that frame back on the glass, so the
+ *  			last screen stays up while the application starts again.
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Stats.h"
+#include "LCD_Handle.h"
+#include "LCD_I2c.h"
+#include "LCD_Spi.h"
+#include "LCD_Transport.h"
+#include "LCD_Attr.h"
+#include "LCD_Plan.h"
+#include "LCD_Boot.h"
+#include "LCD_Latency.h"
+#include "LCD_Timing.h"
+#include "LCD_Cost.h"
+
+#if ((LCD_USE_FRAME_SNAPSHOT != 0u) && (LCD_USE_FRAMEBUFFER == 0u))
+    #error "LCD_USE_FRAME_SNAPSHOT requires LCD_USE_FRAMEBUFFER"
+#endif /* LCD_USE_FRAME_SNAPSHOT != 0u */
+
+uint8_t LCD_frame[LCD_ROWS][LCD_COLUMNS];
+uint16_t LCD_glass[LCD_ROWS][LCD_COLUMNS];
+
+/* Shadow cursor, the next LCD_FrameWriteChar() lands here */
+uint8_t LCD_frameRow = 0u;
+uint8_t LCD_frameColumn = 0u;
+
+/* Set by every framebuffer change, cleared by LCD_FlushFrame() */
+volatile uint8_t LCD_frameDirty = 1u;
+
+#if (LCD_USE_FRAME_SNAPSHOT != 0u)
+    /* Last flushed frame, survives any reset that keeps RAM powered */
+    typedef struct
+    {
+        uint32_t magic;
+        uint16_t check;
+        uint8_t frame[LCD_ROWS][LCD_COLUMNS];
+    } LCD_FRAME_SNAPSHOT;
+
+    static LCD_FRAME_SNAPSHOT LCD_frameSnapshot __attribute__((section(".noinit")));
+
+    static uint16_t LCD_FrameCheck(uint8_t const frame[LCD_ROWS][LCD_COLUMNS]) ;
+#endif /* LCD_USE_FRAME_SNAPSHOT != 0u */
+
+
+/*******************************************************************************
+* Function Name: LCD_FrameInit
+********************************************************************************
+*
+* Summary:
+*  Blanks the framebuffer and marks every glass cell unknown, so the first
+*  LCD_FlushFrame() writes the whole screen.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FrameInit(void)
+{
+    LCD_FrameClear();
+    LCD_FrameInvalidate();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FramePosition
+********************************************************************************
+*
+* Summary:
+*  Moves the shadow cursor. No bus traffic is generated.
+*
+* Parameters:
+*  row:    Row of the framebuffer
+*  column: Column of the framebuffer
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FramePosition(uint8_t row, uint8_t column)
+{
+    if (row < LCD_ROWS)
+    {
+        LCD_frameRow = row;
+        LCD_frameColumn = column;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FrameWriteChar
+********************************************************************************
+*
+* Summary:
+*  Stores a character at the shadow cursor and advances the cursor, the same
+*  way the HD44780 auto-increments its address counter.
+*
+* Parameters:
+*  character: Character code to store
+*
+* Return:
+*  None.
+*
+* Note:
+*  A character past the last column of the geometry goes to the start of the
+*  next row, past the last row it is dropped. The wrap happens when the next
+*  character arrives, so a row can be filled and followed by a newline.
+*
+*******************************************************************************/
+void LCD_FrameWriteChar(uint8_t character)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+
+    if (LCD_frameColumn >= geometry->columns)
+    {
+        if ((LCD_frameRow + 1u) >= geometry->rows)
+        {
+            return;
+        }
+
+        LCD_frameRow++;
+        LCD_frameColumn = 0u;
+    }
+
+    if (LCD_frameRow < geometry->rows)
+    {
+        #if (LCD_USE_ATTRIBUTES != 0u)
+            if (LCD_attrCell[LCD_frameRow][LCD_frameColumn] != 0u)
+            {
+                /* Blinking or highlighted field, the cell shows a rendering */
+                character = LCD_AttrStore(LCD_frameRow, LCD_frameColumn, character);
+            }
+        #endif /* LCD_USE_ATTRIBUTES != 0u */
+
+        LCD_LATENCY_CHANGE(LCD_frameRow, LCD_frameColumn, character);
+        LCD_frame[LCD_frameRow][LCD_frameColumn] = character;
+        LCD_frameColumn++;
+        LCD_frameDirty = 1u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FrameClear
+********************************************************************************
+*
+* Summary:
+*  Fills the framebuffer with blanks and homes the shadow cursor. Only cells
+*  that are not already blank on the display are written by the next flush.
+*  Blinking and highlighted fields (LCD_USE_ATTRIBUTES) are dropped.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FrameClear(void)
+{
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            LCD_LATENCY_CHANGE(row, column, LCD_FRAME_BLANK);
+            LCD_frame[row][column] = LCD_FRAME_BLANK;
+        }
+    }
+
+    #if (LCD_USE_ATTRIBUTES != 0u)
+        LCD_AttrReset();
+    #endif /* LCD_USE_ATTRIBUTES != 0u */
+
+    LCD_frameRow = 0u;
+    LCD_frameColumn = 0u;
+    LCD_frameDirty = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FrameGlassCleared
+********************************************************************************
+*
+* Summary:
+*  Records that a clear display command blanked DDRAM. Called by
+*  LCD_WriteControl() so the framebuffer, the glass copy and the module stay
+*  consistent.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FrameGlassCleared(void)
+{
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            LCD_glass[row][column] = LCD_FRAME_BLANK;
+        }
+    }
+
+    LCD_FrameClear();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FrameInvalidate
+********************************************************************************
+*
+* Summary:
+*  Forgets what is on the display, so the next flush rewrites every cell
+*  (e.g. after the module lost power or its contents were corrupted).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FrameInvalidate(void)
+{
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            LCD_glass[row][column] = LCD_FRAME_UNKNOWN;
+        }
+    }
+
+    LCD_frameDirty = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FlushFrame
+********************************************************************************
+*
+* Summary:
+*  Sends the framebuffer cells that differ from the display contents. Each
+*  contiguous run of changed cells costs one LCD_WritePosition() plus one
+*  LCD_WriteBuffer() run; unchanged cells are not sent. Only the cells of
+*  the geometry are looked at, and a run ends where the DDRAM addresses of
+*  a split row do.
+*  With LCD_USE_FLUSH_PLANNER the writes follow LCD_PlanNext() instead.
+*
+* Note:
+*  The glass copy of a run is taken before the run is sent, so a cell an
+*  interrupt changes meanwhile (LCD_USE_CAN) is sent again by the next
+*  flush.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+* Reentrant:
+*  No.
+*
+*******************************************************************************/
+void LCD_FlushFrame(void)
+{
+    uint8_t column;
+    #if (LCD_USE_FLUSH_PLANNER != 0u)
+        LCD_PLAN plan;
+        LCD_PLAN_SPAN span;
+    #else
+        LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+        uint8_t row;
+        uint8_t runStart;
+        uint8_t runEnd;
+        uint8_t runLimit;
+    #endif /* LCD_USE_FLUSH_PLANNER != 0u */
+    #if (LCD_USE_STATS != 0u)
+        uint32_t const statStart = LCD_CYCLES();
+    #endif /* LCD_USE_STATS != 0u */
+
+    LCD_frameDirty = 0u;
+
+    /* Flag cleared before the cells are read, a cell an interrupt stores
+     * from here on sets it again
+     */
+    __DMB();
+
+    if (LCD_display0.linkState == LCD_LINK_ABSENT)
+    {
+        /* Unit without a display (LCD_USE_DETECT) */
+        return;
+    }
+
+    /* Every changed run of the frame in one transaction (I2C) */
+    LCD_BUS_BATCH_BEGIN();
+
+    #if (LCD_USE_FLUSH_PLANNER != 0u)
+        LCD_PlanStart(&plan);
+        while (LCD_PlanNext(&plan, &span) != 0u)
+        {
+            /* No address command where the last span left the cursor */
+            if (span.addressed != 0u)
+            {
+                LCD_WritePosition(span.row, span.start);
+            }
+            for (column = span.start; column < (span.start + span.length); column++)
+            {
+                LCD_glass[span.row][column] = LCD_frame[span.row][column];
+                LCD_LATENCY_SENT(span.row, column);
+            }
+            LCD_WriteBuffer(&LCD_frame[span.row][span.start], (size_t) span.length);
+        }
+    #else
+        for (row = 0u; row < geometry->rows; row++)
+        {
+            column = 0u;
+            while (column < geometry->columns)
+            {
+                if (LCD_glass[row][column] == (uint16_t) LCD_frame[row][column])
+                {
+                    column++;
+                }
+                else
+                {
+                    /* Find end of run of changed cells, within the DDRAM run */
+                    runStart = column;
+                    runLimit = (column < geometry->split) ? geometry->split : geometry->columns;
+                    while ((column < runLimit) &&
+                           (LCD_glass[row][column] != (uint16_t) LCD_frame[row][column]))
+                    {
+                        column++;
+                    }
+                    runEnd = column;
+
+                    /* One address command and one bulk write per run, the module
+                     * auto-increments
+                     */
+                    LCD_WritePosition(row, runStart);
+                    for (column = runStart; column < runEnd; column++)
+                    {
+                        LCD_glass[row][column] = LCD_frame[row][column];
+                        LCD_LATENCY_SENT(row, column);
+                    }
+                    LCD_WriteBuffer(&LCD_frame[row][runStart], (size_t) (runEnd - runStart));
+                }
+            }
+        }
+    #endif /* LCD_USE_FLUSH_PLANNER != 0u */
+
+    LCD_BUS_BATCH_END();
+
+    /* Cells sent by this flush are on the glass now */
+    LCD_LATENCY_FLUSHED();
+
+    /* Taken only once characters reached the glass */
+    LCD_BOOT_MARK(LCD_BOOT_FIRST_FRAME);
+
+    #if (LCD_USE_FRAME_SNAPSHOT != 0u)
+        LCD_FrameSave();
+    #endif /* LCD_USE_FRAME_SNAPSHOT != 0u */
+
+    LCD_STAT_FLUSH(statStart);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FrameClearIsCheaper
+********************************************************************************
+*
+* Summary:
+*  Tells whether a clear display command gets the frame onto the glass
+*  faster than the next flush would: the frame has to be blank, and the
+*  flush (one command or data write per changed cell and per run) has to
+*  cost more than the clear (LCD_FrameClearBeats()).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if LCD_ClearDisplay() is cheaper, 0 if the flush is.
+*
+*******************************************************************************/
+uint8_t LCD_FrameClearIsCheaper(void)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+    uint16_t writes = 0u;
+    uint8_t inRun;
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 0u; row < geometry->rows; row++)
+    {
+        inRun = 0u;
+        for (column = 0u; column < geometry->columns; column++)
+        {
+            if (LCD_frame[row][column] != LCD_FRAME_BLANK)
+            {
+                return 0u;
+            }
+            #if (LCD_USE_ATTRIBUTES != 0u)
+                /* A hidden blinking field is blank until its next phase */
+                if (LCD_attrCell[row][column] != 0u)
+                {
+                    return 0u;
+                }
+            #endif /* LCD_USE_ATTRIBUTES != 0u */
+
+            if (LCD_glass[row][column] == (uint16_t) LCD_FRAME_BLANK)
+            {
+                inRun = 0u;
+            }
+            else
+            {
+                /* Address command at the start of a run, then the cell */
+                writes += (inRun == 0u) ? 2u : 1u;
+                inRun = (column != (geometry->split - 1u)) ? 1u : 0u;
+            }
+        }
+    }
+
+    return LCD_FrameClearBeats(writes);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FrameClearBeats
+********************************************************************************
+*
+* Summary:
+*  Tells whether one clear display command takes less time than a number of
+*  short writes: priced by the cost model (LCD_USE_COST_MODEL), from the
+*  execution times of LCD_Timing.c otherwise, calibrated by LCD_Calibrate()
+*  when it ran.
+*
+* Parameters:
+*  writes: Command and data bytes the clear would replace
+*
+* Return:
+*  1 if the clear is cheaper, 0 if the writes are.
+*
+*******************************************************************************/
+uint8_t LCD_FrameClearBeats(uint16_t writes)
+{
+    #if (LCD_USE_COST_MODEL != 0u)
+        return (LCD_EstimateCost(LCD_OP_PRINT, writes).us > LCD_EstimateCost(LCD_OP_LONG_COMMAND, 1u).us) ? 1u : 0u;
+    #else
+        return (((uint32_t) writes * LCD_execShortCycles) > LCD_execLongCycles) ? 1u : 0u;
+    #endif /* LCD_USE_COST_MODEL != 0u */
+}
+
+
+#if (LCD_USE_FRAME_SNAPSHOT != 0u)
+/*******************************************************************************
+* Function Name: LCD_FrameSave
+********************************************************************************
+*
+* Summary:
+*  Copies the framebuffer into the snapshot if it differs from it. Called by
+*  the flushes, once the frame is on the glass.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FrameSave(void)
+{
+    uint8_t row;
+    uint8_t column;
+    uint8_t changed = (LCD_frameSnapshot.magic != LCD_FRAME_SNAPSHOT_MAGIC) ? 1u : 0u;
+
+    for (row = 0u; (row < LCD_ROWS) && (changed == 0u); row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            if (LCD_frameSnapshot.frame[row][column] != LCD_frame[row][column])
+            {
+                changed = 1u;
+                break;
+            }
+        }
+    }
+
+    if (changed == 0u)
+    {
+        return;
+    }
+
+    /* Invalid while it is rewritten, a reset in between finds no snapshot */
+    LCD_frameSnapshot.magic = 0u;
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            LCD_frameSnapshot.frame[row][column] = LCD_frame[row][column];
+        }
+    }
+    LCD_frameSnapshot.check = LCD_FrameCheck(LCD_frameSnapshot.frame);
+    LCD_frameSnapshot.magic = LCD_FRAME_SNAPSHOT_MAGIC;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FrameRestore
+********************************************************************************
+*
+* Summary:
+*  Loads the framebuffer from the snapshot, if one survived the reset. The
+*  next flush then sends it.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if the snapshot was valid and loaded, 0 if not (power-on, or the
+*  checksum does not match).
+*
+*******************************************************************************/
+uint8_t LCD_FrameRestore(void)
+{
+    uint8_t row;
+    uint8_t column;
+
+    if ((LCD_frameSnapshot.magic != LCD_FRAME_SNAPSHOT_MAGIC) ||
+        (LCD_frameSnapshot.check != LCD_FrameCheck(LCD_frameSnapshot.frame)))
+    {
+        LCD_frameSnapshot.magic = 0u;
+        return 0u;
+    }
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            LCD_frame[row][column] = LCD_frameSnapshot.frame[row][column];
+        }
+    }
+    LCD_frameDirty = 1u;
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FrameAdopt
+********************************************************************************
+*
+* Summary:
+*  Takes the framebuffer as what the glass shows, after a warm start over a
+*  module that kept its DDRAM. The next flush only sends later changes.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_FrameAdopt(void)
+{
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            LCD_glass[row][column] = (uint16_t) LCD_frame[row][column];
+        }
+    }
+    LCD_frameDirty = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_FrameCheck
+********************************************************************************
+*
+* Summary:
+*  Fletcher-16 checksum of a frame.
+*
+*******************************************************************************/
+static uint16_t LCD_FrameCheck(uint8_t const frame[LCD_ROWS][LCD_COLUMNS])
+{
+    uint16_t sum1 = 0u;
+    uint16_t sum2 = 0u;
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            sum1 = (uint16_t) ((sum1 + frame[row][column]) % 255u);
+            sum2 = (uint16_t) ((sum2 + sum1) % 255u);
+        }
+    }
+
+    return (uint16_t) ((sum2 << 8u) | sum1);
+}
+#endif /* LCD_USE_FRAME_SNAPSHOT != 0u */
@@ -0,0 +1,177 @@
+/*
+ *  LCD_Geometry.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Display geometry descriptors of the HD44780 LCD driver.
+ *
+ *  			The controller has two 40 character DDRAM lines (0x00-0x27,
+ *  			0x40-0x67); how they map onto the glass depends on the module.
+ *  			LCD_geometries holds one const descriptor per supported size,
+ *  			with the DDRAM address of every row (and of the second half of
+ *  			a "type 1" 16x1 row). Each handle points at one of them:
+ *  			LCD_DdramAddress() is a table lookup, and the print paths and
+ *  			the framebuffer flush use the runs to wrap and clip, so one
+ *  			build drives any of the sizes and never writes DDRAM that is
+ *  			not on the glass.
+ *
+ *  Usage:      - LCD_GEOMETRY in LCD_Config.h selects the layout every
+ *  				display starts with, LCD_SetGeometry() changes the one of
+ *  				the selected display at run time
+ *  			- 40x4 modules are two 40x2 controllers with their own E line,
+ *  				one LCD_Handle each (LCD_USE_MULTI_DISPLAY)
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Geometry.h"
+#include "LCD_Handle.h"
+#include "LCD_Frame.h"
+
+/* Row base addresses from the module data sheets: 20 and 16 column rows 2 and
+* 3 continue DDRAM lines 0 and 1 after the first row
+*/
+LCD_GEOMETRY_STRUCT const LCD_geometries[LCD_GEOMETRY_COUNT] =
+{
+    /* LCD_GEOMETRY_16X1 */
+    { 1u, 16u, 8u, { 0x00u, 0x00u, 0x00u, 0x00u }, { 0x40u, 0x00u, 0x00u, 0x00u } },
+    /* LCD_GEOMETRY_16X1_LINEAR */
+    { 1u, 16u, 16u, { 0x00u, 0x00u, 0x00u, 0x00u }, { 0x00u, 0x00u, 0x00u, 0x00u } },
+    /* LCD_GEOMETRY_16X2 */
+    { 2u, 16u, 16u, { 0x00u, 0x40u, 0x00u, 0x00u }, { 0x00u, 0x00u, 0x00u, 0x00u } },
+    /* LCD_GEOMETRY_16X4 */
+    { 4u, 16u, 16u, { 0x00u, 0x40u, 0x10u, 0x50u }, { 0x00u, 0x00u, 0x00u, 0x00u } },
+    /* LCD_GEOMETRY_20X2 */
+    { 2u, 20u, 20u, { 0x00u, 0x40u, 0x00u, 0x00u }, { 0x00u, 0x00u, 0x00u, 0x00u } },
+    /* LCD_GEOMETRY_20X4 */
+    { 4u, 20u, 20u, { 0x00u, 0x40u, 0x14u, 0x54u }, { 0x00u, 0x00u, 0x00u, 0x00u } },
+    /* LCD_GEOMETRY_40X2 */
+    { 2u, 40u, 40u, { 0x00u, 0x40u, 0x00u, 0x00u }, { 0x00u, 0x00u, 0x00u, 0x00u } }
+};
+
+
+/*******************************************************************************
+* Function Name: LCD_GeometryAddress
+********************************************************************************
+*
+* Summary:
+*  Returns the DDRAM address of a row and column of a geometry.
+*
+* Parameters:
+*  geometry: Layout of the module
+*  row:      Row, row 0 is used for a row the module does not have
+*  column:   Column
+*
+* Return:
+*  DDRAM address, AC6-AC0.
+*
+*******************************************************************************/
+uint8_t LCD_GeometryAddress(LCD_GEOMETRY_STRUCT const *geometry, uint8_t row, uint8_t column)
+{
+    uint8_t address;
+
+    if (row >= geometry->rows)
+    {
+        row = 0u;
+    }
+
+    if (column < geometry->split)
+    {
+        address = geometry->rowBase[row] + column;
+    }
+    else
+    {
+        address = geometry->splitBase[row] + (column - geometry->split);
+    }
+
+    return address & LCD_DDRAM_ADDRESS_MASK;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GeometryRun
+********************************************************************************
+*
+* Summary:
+*  Returns one run of consecutive visible DDRAM addresses. Runs are numbered
+*  in reading order, two per row: the row (or its first half) and the second
+*  half of a split row.
+*
+* Parameters:
+*  geometry: Layout of the module
+*  run:      Run index, row * 2 + half
+*  start:    Receives the DDRAM address of the first cell
+*  length:   Receives the number of cells
+*
+* Return:
+*  1 if the geometry has the run, 0 if not.
+*
+*******************************************************************************/
+uint8_t LCD_GeometryRun(LCD_GEOMETRY_STRUCT const *geometry, uint8_t run, uint8_t *start, uint8_t *length)
+{
+    uint8_t const row = run >> 1u;
+
+    if (row >= geometry->rows)
+    {
+        return 0u;
+    }
+
+    if ((run & 1u) == 0u)
+    {
+        *start = geometry->rowBase[row];
+        *length = geometry->split;
+    }
+    else if (geometry->split < geometry->columns)
+    {
+        *start = geometry->splitBase[row];
+        *length = geometry->columns - geometry->split;
+    }
+    else
+    {
+        return 0u;
+    }
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SetGeometry
+********************************************************************************
+*
+* Summary:
+*  Selects the layout of the selected display, for a module size only known
+*  at run time.
+*
+* Parameters:
+*  geometry: Layout, &LCD_geometries[LCD_GEOMETRY_xxx] or an application
+*            descriptor
+*
+* Return:
+*  1 if taken, 0 if it is larger than LCD_ROWS x LCD_COLUMNS.
+*
+* Note:
+*  The framebuffer is sent again on the next flush, through the new layout.
+*
+*******************************************************************************/
+uint8_t LCD_SetGeometry(LCD_GEOMETRY_STRUCT const *geometry)
+{
+    if ((geometry->rows > LCD_ROWS) || (geometry->columns > LCD_COLUMNS) ||
+        (geometry->split > geometry->columns))
+    {
+        return 0u;
+    }
+
+    LCD_active->geometry = geometry;
+    LCD_active->wrapAddress = LCD_CURSOR_UNKNOWN;
+
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        if (LCD_IS_PRIMARY())
+        {
+            LCD_FrameInvalidate();
+        }
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+    return 1u;
+}
@@ -0,0 +1,1017 @@
+/*
+ *  LCD_Glyph.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: CGRAM custom glyph manager for the HD44780 LCD driver.
+ *
+ *  			The module has 8 CGRAM slots (character codes 0 - 7). Glyphs are
+ *  			identified by their 8-byte pattern (or by an ID into the table
+ *  			given to LCD_GlyphSetTable()), and LCD_GlyphAcquire() maps them
+ *  			onto the slots: a resident glyph costs nothing, a missing one is
+ *  			uploaded into the least recently used slot. Screens can then use
+ *  			more than 8 distinct glyphs, and a screen change only uploads
+ *  			the glyphs that are not already resident.
+ *
+ *  			With LCD_USE_FRAMEBUFFER set, slots whose code is in the
+ *  			framebuffer or on the glass are never evicted, since that would
+ *  			change characters already on screen.
+ *
+ *  Usage:      - LCD_PutGlyph(id) prints glyph "id" at the cursor
+ *  			- LCD_LoadCustomFonts() reserves all 8 slots for a fixed set
+ *  				until LCD_GlyphReset()
+ *  			- LCD_GlyphPin() keeps a slot out of eviction, LCD_GlyphRewrite()
+ *  				changes its bitmap in place (animations, LCD_Anim.c)
+ *  			- LCD_GlyphReplace() queues a new bitmap for a glyph on screen,
+ *  				LCD_GlyphPoll() from the main loop uploads it into a spare
+ *  				slot in idle bus time and moves the framebuffer cells there
+ *  			- glyph packs (LCD_USE_GLYPH_PACKS) keep each glyph as 8 row
+ *  				codes into a shared row dictionary, 4 bytes for a pack of
+ *  				up to 16 distinct rows; LCD_GlyphAcquirePacked() unpacks a
+ *  				missing one straight into its CGRAM upload
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Latency.h"
+#include "LCD_Glyph.h"
+#include "LCD_Handle.h"
+#include "LCD_Warm.h"
+#if (LCD_USE_GLYPH_QUEUE != 0u)
+    #include "LCD_Async.h"
+    #include "LCD_Timing.h"
+#endif /* LCD_USE_GLYPH_QUEUE != 0u */
+
+/* CGRAM as last uploaded to the display on E_Pin, for LCD_RestoreConfig() */
+uint8_t LCD_cgramShadow[LCD_GLYPH_SLOTS * LCD_GLYPH_ROWS];
+
+/* Bit n set once slot n was uploaded */
+uint8_t LCD_cgramWritten = 0u;
+
+#if (LCD_USE_GLYPH_CACHE != 0u)
+
+/* Pattern resident in each slot, NULL if free */
+static uint8_t const *LCD_glyphSlot[LCD_GLYPH_SLOTS];
+
+/* Last use of each slot, the smallest stamp is evicted first */
+static uint32_t LCD_glyphStamp[LCD_GLYPH_SLOTS];
+static uint32_t LCD_glyphClock = 0u;
+
+/* 1 while LCD_LoadCustomFonts() owns the slots */
+static uint8_t LCD_glyphReserved = 0u;
+
+/* Bit n set while slot n is pinned (never evicted) */
+static uint8_t LCD_glyphPinned = 0u;
+
+static uint8_t const (*LCD_glyphTable)[LCD_GLYPH_ROWS] = NULL;
+static uint16_t LCD_glyphCount = 0u;
+
+#if (LCD_USE_GLYPH_PACKS != 0u)
+    /* Pack of the ID API instead of the table, LCD_GlyphSetPack() */
+    static LCD_GLYPH_PACK const *LCD_glyphPack = NULL;
+#endif /* LCD_USE_GLYPH_PACKS != 0u */
+
+static uint8_t LCD_GlyphOnScreen(void) ;
+static uint8_t LCD_GlyphFind(uint8_t const pattern[]) ;
+static uint8_t LCD_GlyphVictim(void) ;
+#if (LCD_USE_GLYPH_PACKS != 0u)
+    static uint8_t LCD_GlyphPackValid(LCD_GLYPH_PACK const *pack, uint16_t glyph) ;
+#endif /* LCD_USE_GLYPH_PACKS != 0u */
+
+#endif /* LCD_USE_GLYPH_CACHE != 0u */
+
+#if (LCD_USE_GLYPH_QUEUE != 0u)
+
+#if (LCD_USE_GLYPH_CACHE == 0u)
+    #error "LCD_USE_GLYPH_QUEUE replaces glyphs of the glyph manager (LCD_USE_GLYPH_CACHE)"
+#endif /* LCD_USE_GLYPH_CACHE == 0u */
+
+/* Replacements waiting for LCD_GlyphPoll(), oldest first */
+static uint8_t const *LCD_glyphFrom[LCD_GLYPH_QUEUE_SIZE];
+static uint8_t const *LCD_glyphTo[LCD_GLYPH_QUEUE_SIZE];
+static uint8_t LCD_glyphQueued = 0u;
+
+#if (LCD_USE_FRAMEBUFFER != 0u)
+    static void LCD_GlyphSwitch(uint8_t from, uint8_t to) ;
+#endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+#endif /* LCD_USE_GLYPH_QUEUE != 0u */
+
+#if ((LCD_USE_GLYPH_PACKS != 0u) && (LCD_USE_GLYPH_CACHE == 0u))
+    #error "LCD_USE_GLYPH_PACKS unpacks into the glyph manager (LCD_USE_GLYPH_CACHE)"
+#endif /* (LCD_USE_GLYPH_PACKS != 0u) && (LCD_USE_GLYPH_CACHE == 0u) */
+
+static void LCD_GlyphUpload(uint8_t slot, uint8_t const pattern[]) ;
+
+#if (LCD_USE_GLYPH_CACHE != 0u)
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphReset
+********************************************************************************
+*
+* Summary:
+*  Forgets every resident glyph (e.g. after LCD_Init() or once a custom font
+*  set is no longer needed). CGRAM is not written.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_GlyphReset(void)
+{
+    uint8_t slot;
+
+    for (slot = 0u; slot < LCD_GLYPH_SLOTS; slot++)
+    {
+        LCD_glyphSlot[slot] = NULL;
+        LCD_glyphStamp[slot] = 0u;
+    }
+
+    LCD_glyphReserved = 0u;
+    LCD_glyphPinned = 0u;
+
+    #if (LCD_USE_GLYPH_QUEUE != 0u)
+        LCD_glyphQueued = 0u;
+    #endif /* LCD_USE_GLYPH_QUEUE != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphSetTable
+********************************************************************************
+*
+* Summary:
+*  Registers the application glyph table used by LCD_PutGlyph() and
+*  LCD_GlyphAcquireId().
+*
+* Parameters:
+*  table: Glyph patterns, LCD_GLYPH_ROWS bytes each (5 low bits per row)
+*  count: Number of glyphs in the table
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_GlyphSetTable(uint8_t const (*table)[LCD_GLYPH_ROWS], uint16_t count)
+{
+    LCD_glyphTable = table;
+    LCD_glyphCount = count;
+
+    #if (LCD_USE_GLYPH_PACKS != 0u)
+        LCD_glyphPack = NULL;
+    #endif /* LCD_USE_GLYPH_PACKS != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphAcquire
+********************************************************************************
+*
+* Summary:
+*  Returns the character code of a glyph, uploading it into the least
+*  recently used slot that is not on screen if it is not resident.
+*
+* Parameters:
+*  pattern: LCD_GLYPH_ROWS bytes, must stay valid while resident (const data)
+*
+* Return:
+*  Character code 0 - 7, or LCD_GLYPH_NO_SLOT if no slot can be evicted.
+*
+* Note:
+*  An upload moves the address counter; the cursor is restored when cursor
+*  tracking knows it, otherwise the next print must set the position.
+*
+*******************************************************************************/
+uint8_t LCD_GlyphAcquire(uint8_t const pattern[])
+{
+    uint8_t slot;
+    uint8_t victim;
+
+    LCD_glyphClock++;
+
+    slot = LCD_GlyphFind(pattern);
+    if (slot != LCD_GLYPH_NO_SLOT)
+    {
+        LCD_glyphStamp[slot] = LCD_glyphClock;
+        return slot;
+    }
+
+    if (LCD_glyphReserved != 0u)
+    {
+        return LCD_GLYPH_NO_SLOT;
+    }
+
+    victim = LCD_GlyphVictim();
+
+    if (victim != LCD_GLYPH_NO_SLOT)
+    {
+        LCD_GlyphUpload(victim, pattern);
+        LCD_glyphSlot[victim] = pattern;
+        LCD_glyphStamp[victim] = LCD_glyphClock;
+    }
+
+    return victim;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphAcquireId
+********************************************************************************
+*
+* Summary:
+*  LCD_GlyphAcquire() for a glyph of the registered table (or pack).
+*
+* Parameters:
+*  glyphId: Index into the LCD_GlyphSetTable() table or LCD_GlyphSetPack()
+*           pack
+*
+* Return:
+*  Character code 0 - 7, or LCD_GLYPH_NO_SLOT.
+*
+*******************************************************************************/
+uint8_t LCD_GlyphAcquireId(uint16_t glyphId)
+{
+    #if (LCD_USE_GLYPH_PACKS != 0u)
+        if (LCD_glyphPack != NULL)
+        {
+            return LCD_GlyphAcquirePacked(LCD_glyphPack, glyphId);
+        }
+    #endif /* LCD_USE_GLYPH_PACKS != 0u */
+
+    if ((LCD_glyphTable == NULL) || (glyphId >= LCD_glyphCount))
+    {
+        return LCD_GLYPH_NO_SLOT;
+    }
+
+    return LCD_GlyphAcquire(LCD_glyphTable[glyphId]);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PutGlyph
+********************************************************************************
+*
+* Summary:
+*  Writes glyph "glyphId" at the current cursor position.
+*
+* Parameters:
+*  glyphId: Index into the LCD_GlyphSetTable() table
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PutGlyph(uint16_t glyphId)
+{
+    uint8_t code = LCD_GlyphAcquireId(glyphId);
+
+    LCD_PutChar((code == LCD_GLYPH_NO_SLOT) ? LCD_GLYPH_FALLBACK : (char) code);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphPin
+********************************************************************************
+*
+* Summary:
+*  LCD_GlyphAcquire() for a slot that stays allocated until LCD_GlyphUnpin(),
+*  whether or not its code is on screen.
+*
+* Parameters:
+*  pattern: LCD_GLYPH_ROWS bytes, the first bitmap of the slot
+*
+* Return:
+*  Character code 0 - 7, or LCD_GLYPH_NO_SLOT.
+*
+*******************************************************************************/
+uint8_t LCD_GlyphPin(uint8_t const pattern[])
+{
+    uint8_t slot = LCD_GlyphAcquire(pattern);
+
+    if (slot != LCD_GLYPH_NO_SLOT)
+    {
+        LCD_glyphPinned |= (uint8_t) (1u << slot);
+    }
+
+    return slot;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphUnpin
+********************************************************************************
+*
+* Summary:
+*  Returns a pinned slot to LRU eviction.
+*
+* Parameters:
+*  slot: Character code returned by LCD_GlyphPin()
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_GlyphUnpin(uint8_t slot)
+{
+    if (slot < LCD_GLYPH_SLOTS)
+    {
+        LCD_glyphPinned &= (uint8_t) ~(1u << slot);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphRewrite
+********************************************************************************
+*
+* Summary:
+*  Replaces the bitmap of a pinned slot: one CGRAM address command and 8 data
+*  bytes, and every cell showing the code changes at once.
+*
+* Parameters:
+*  slot: Character code returned by LCD_GlyphPin()
+*  pattern: LCD_GLYPH_ROWS bytes, must stay valid while resident (const data)
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_GlyphRewrite(uint8_t slot, uint8_t const pattern[])
+{
+    if ((slot < LCD_GLYPH_SLOTS) && ((LCD_glyphPinned & (1u << slot)) != 0u) &&
+        (LCD_glyphSlot[slot] != pattern))
+    {
+        LCD_GlyphUpload(slot, pattern);
+        LCD_glyphSlot[slot] = pattern;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphUpdateRows
+********************************************************************************
+*
+* Summary:
+*  Uploads some rows of a pinned slot again after its owner changed them in
+*  the pattern it was pinned with: one CGRAM address command and "count"
+*  data bytes instead of the whole bitmap.
+*
+* Parameters:
+*  slot:  Character code returned by LCD_GlyphPin()
+*  row:   First changed row, 0 - 7
+*  count: Consecutive rows from "row"
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_GlyphUpdateRows(uint8_t slot, uint8_t row, uint8_t count)
+{
+    uint8_t const *pattern;
+    uint8_t address;
+    uint8_t index;
+
+    if ((slot >= LCD_GLYPH_SLOTS) || ((LCD_glyphPinned & (1u << slot)) == 0u) ||
+        (row >= LCD_GLYPH_ROWS) || (count == 0u))
+    {
+        return;
+    }
+
+    pattern = LCD_glyphSlot[slot];
+    count = ((row + count) > LCD_GLYPH_ROWS) ? (uint8_t) (LCD_GLYPH_ROWS - row) : count;
+
+    #if (LCD_USE_WARM_START != 0u)
+        if (slot == LCD_WARM_SLOT)
+        {
+            /* The warm start signature goes with the whole bitmap */
+            LCD_GlyphUpload(slot, pattern);
+            return;
+        }
+    #endif /* LCD_USE_WARM_START != 0u */
+
+    address = LCD_CursorGet();
+    LCD_WriteControl((uint8_t) (LCD_CGRAM_0 | ((slot * LCD_GLYPH_ROWS) + row)));
+    LCD_WriteBuffer(&pattern[row], count);
+
+    if (LCD_IS_PRIMARY())
+    {
+        for (index = row; index < (row + count); index++)
+        {
+            LCD_cgramShadow[(slot * LCD_GLYPH_ROWS) + index] = pattern[index];
+        }
+    }
+
+    if (address != LCD_CURSOR_UNKNOWN)
+    {
+        LCD_WriteControl((uint8_t) (LCD_DDRAM_0 | address));
+    }
+}
+
+
+#if (LCD_USE_GLYPH_PACKS != 0u)
+/*******************************************************************************
+* Function Name: LCD_GlyphSetPack
+********************************************************************************
+*
+* Summary:
+*  Registers a glyph pack for LCD_PutGlyph() and LCD_GlyphAcquireId(), in
+*  place of the LCD_GlyphSetTable() table.
+*
+* Parameters:
+*  pack: Glyph pack in flash, NULL goes back to the table
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_GlyphSetPack(LCD_GLYPH_PACK const *pack)
+{
+    LCD_glyphPack = pack;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphAcquirePacked
+********************************************************************************
+*
+* Summary:
+*  LCD_GlyphAcquire() for a glyph of a pack. A resident glyph costs nothing;
+*  a missing one is unpacked on the stack and sent as the CGRAM upload of
+*  the least recently used slot that is not on screen.
+*
+* Parameters:
+*  pack:  Glyph pack, must stay valid while its glyphs are resident (const data)
+*  glyph: Index into the pack
+*
+* Return:
+*  Character code 0 - 7, or LCD_GLYPH_NO_SLOT for an invalid glyph or if no
+*  slot can be evicted.
+*
+* Note:
+*  The codes of the glyph are its identity in the cache, so use the
+*  returned code, not LCD_GlyphPin() or LCD_GlyphReplace(), for it.
+*
+*******************************************************************************/
+uint8_t LCD_GlyphAcquirePacked(LCD_GLYPH_PACK const *pack, uint16_t glyph)
+{
+    uint8_t pattern[LCD_GLYPH_ROWS];
+    uint8_t const *key;
+    uint8_t slot;
+    uint8_t victim;
+
+    if (LCD_GlyphPackValid(pack, glyph) == 0u)
+    {
+        return LCD_GLYPH_NO_SLOT;
+    }
+
+    key = &pack->codes[glyph * pack->bits];
+    LCD_glyphClock++;
+
+    slot = LCD_GlyphFind(key);
+    if (slot != LCD_GLYPH_NO_SLOT)
+    {
+        LCD_glyphStamp[slot] = LCD_glyphClock;
+        return slot;
+    }
+
+    if (LCD_glyphReserved != 0u)
+    {
+        return LCD_GLYPH_NO_SLOT;
+    }
+
+    victim = LCD_GlyphVictim();
+
+    if (victim != LCD_GLYPH_NO_SLOT)
+    {
+        (void) LCD_GlyphUnpack(pack, glyph, pattern);
+        LCD_GlyphUpload(victim, pattern);
+        LCD_glyphSlot[victim] = key;
+        LCD_glyphStamp[victim] = LCD_glyphClock;
+    }
+
+    return victim;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PutPackedGlyph
+********************************************************************************
+*
+* Summary:
+*  Writes a glyph of a pack at the current cursor position.
+*
+* Parameters:
+*  pack:  Glyph pack
+*  glyph: Index into the pack
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PutPackedGlyph(LCD_GLYPH_PACK const *pack, uint16_t glyph)
+{
+    uint8_t code = LCD_GlyphAcquirePacked(pack, glyph);
+
+    LCD_PutChar((code == LCD_GLYPH_NO_SLOT) ? LCD_GLYPH_FALLBACK : (char) code);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphUnpack
+********************************************************************************
+*
+* Summary:
+*  Unpacks a glyph of a pack into its LCD_GLYPH_ROWS row bytes: one byte
+*  fetch per 8 code bits and a dictionary lookup per row.
+*
+* Parameters:
+*  pack:    Glyph pack
+*  glyph:   Index into the pack
+*  pattern: Receives LCD_GLYPH_ROWS bytes (5 low bits per row)
+*
+* Return:
+*  1 if unpacked, 0 for an invalid glyph or pack.
+*
+*******************************************************************************/
+uint8_t LCD_GlyphUnpack(LCD_GLYPH_PACK const *pack, uint16_t glyph, uint8_t pattern[])
+{
+    uint8_t const bits = pack->bits;
+    uint8_t const *source;
+    uint32_t window = 0u;
+    uint8_t held = 0u;
+    uint8_t mask;
+    uint8_t code;
+    uint8_t row;
+
+    if (LCD_GlyphPackValid(pack, glyph) == 0u)
+    {
+        return 0u;
+    }
+
+    mask = (uint8_t) ((1u << bits) - 1u);
+    source = &pack->codes[glyph * bits];
+
+    for (row = 0u; row < LCD_GLYPH_ROWS; row++)
+    {
+        if (held < bits)
+        {
+            window |= (uint32_t) *source << held;
+            source++;
+            held += 8u;
+        }
+
+        code = (uint8_t) window & mask;
+        window >>= bits;
+        held -= bits;
+
+        pattern[row] = (pack->rows != NULL) ? pack->rows[code] : code;
+    }
+
+    return 1u;
+}
+#endif /* LCD_USE_GLYPH_PACKS != 0u */
+
+#endif /* LCD_USE_GLYPH_CACHE != 0u */
+
+
+#if (LCD_USE_GLYPH_QUEUE != 0u)
+/*******************************************************************************
+* Function Name: LCD_GlyphReplace
+********************************************************************************
+*
+* Summary:
+*  Queues a new bitmap for the cells showing a resident glyph. Nothing is
+*  sent until LCD_GlyphPoll(); a second replacement of the same glyph (or of
+*  the queued bitmap) before that only changes the queued bitmap.
+*
+* Parameters:
+*  from: Pattern of the glyph on screen, as given to LCD_GlyphAcquire() or
+*        LCD_GlyphPin()
+*  to:   LCD_GLYPH_ROWS bytes, must stay valid while resident (const data)
+*
+* Return:
+*  1 if queued, 0 if "from" is not resident or the queue is full.
+*
+*******************************************************************************/
+uint8_t LCD_GlyphReplace(uint8_t const from[], uint8_t const to[])
+{
+    uint8_t index;
+
+    for (index = 0u; index < LCD_glyphQueued; index++)
+    {
+        if ((LCD_glyphFrom[index] == from) || (LCD_glyphTo[index] == from))
+        {
+            LCD_glyphTo[index] = to;
+            return 1u;
+        }
+    }
+
+    if ((LCD_glyphQueued == LCD_GLYPH_QUEUE_SIZE) || (LCD_GlyphFind(from) == LCD_GLYPH_NO_SLOT))
+    {
+        return 0u;
+    }
+
+    LCD_glyphFrom[LCD_glyphQueued] = from;
+    LCD_glyphTo[LCD_glyphQueued] = to;
+    LCD_glyphQueued++;
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphPoll
+********************************************************************************
+*
+* Summary:
+*  Carries out the oldest queued replacement when the bus is idle (the async
+*  queue is empty and the last write has executed). The bitmap goes into a
+*  slot that is not on screen and the framebuffer cells of the old code are
+*  switched to it, so the flush that follows changes them at once; the old
+*  slot keeps its glyph until evicted. Pinned and reserved slots, and every
+*  slot without a spare or without LCD_USE_FRAMEBUFFER, are rewritten in
+*  place (their code does not change).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Replacements still queued.
+*
+* Note:
+*  The address counter is put back into DDRAM after the upload when cursor
+*  tracking knows it, as for every CGRAM write of this module.
+*
+*******************************************************************************/
+uint8_t LCD_GlyphPoll(void)
+{
+    uint8_t const *from;
+    uint8_t const *to;
+    uint8_t slot;
+    uint8_t target;
+    uint8_t index;
+
+    if (LCD_glyphQueued == 0u)
+    {
+        return 0u;
+    }
+
+    #if (LCD_USE_ASYNC != 0u)
+        if (LCD_IsIdle() == 0u)
+        {
+            return LCD_glyphQueued;
+        }
+    #endif /* LCD_USE_ASYNC != 0u */
+    #if (LCD_USE_ELAPSED_SKIP != 0u)
+        if (LCD_TimingExpired() == 0u)
+        {
+            return LCD_glyphQueued;
+        }
+    #endif /* LCD_USE_ELAPSED_SKIP != 0u */
+
+    from = LCD_glyphFrom[0u];
+    to = LCD_glyphTo[0u];
+    LCD_glyphQueued--;
+    for (index = 0u; index < LCD_glyphQueued; index++)
+    {
+        LCD_glyphFrom[index] = LCD_glyphFrom[index + 1u];
+        LCD_glyphTo[index] = LCD_glyphTo[index + 1u];
+    }
+
+    /* Evicted since: no cell shows it any more */
+    slot = LCD_GlyphFind(from);
+    if (slot == LCD_GLYPH_NO_SLOT)
+    {
+        return LCD_glyphQueued;
+    }
+
+    LCD_glyphClock++;
+    target = slot;
+
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        if ((LCD_glyphReserved == 0u) && ((LCD_glyphPinned & (1u << slot)) == 0u))
+        {
+            target = LCD_GlyphFind(to);
+            if (target == LCD_GLYPH_NO_SLOT)
+            {
+                target = LCD_GlyphVictim();
+            }
+            if (target == LCD_GLYPH_NO_SLOT)
+            {
+                target = slot;
+            }
+        }
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+    if (LCD_glyphSlot[target] != to)
+    {
+        LCD_GlyphUpload(target, to);
+        LCD_glyphSlot[target] = to;
+    }
+    LCD_glyphStamp[target] = LCD_glyphClock;
+
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        if (target != slot)
+        {
+            LCD_GlyphSwitch(slot, target);
+        }
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+    return LCD_glyphQueued;
+}
+#endif /* LCD_USE_GLYPH_QUEUE != 0u */
+
+
+/*******************************************************************************
+* Function Name: LCD_LoadCustomFonts
+********************************************************************************
+*
+* Summary:
+*  Loads a full custom character set into CGRAM and reserves the 8 slots, so
+*  LCD_GlyphAcquire() does not evict them.
+*
+* Parameters:
+*  customData: LCD_CUSTOM_CHAR_SET_LEN bytes, 8 glyphs of 8 rows
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_LoadCustomFonts(uint8_t const customData[])
+{
+    uint8_t slot;
+
+    for (slot = 0u; slot < LCD_GLYPH_SLOTS; slot++)
+    {
+        LCD_GlyphUpload(slot, &customData[slot * LCD_GLYPH_ROWS]);
+        #if (LCD_USE_GLYPH_CACHE != 0u)
+            LCD_glyphSlot[slot] = &customData[slot * LCD_GLYPH_ROWS];
+        #endif /* LCD_USE_GLYPH_CACHE != 0u */
+    }
+
+    #if (LCD_USE_GLYPH_CACHE != 0u)
+        LCD_glyphReserved = 1u;
+    #endif /* LCD_USE_GLYPH_CACHE != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphLoad
+********************************************************************************
+*
+* Summary:
+*  Loads one glyph of an application owned character set into CGRAM. As
+*  with LCD_LoadCustomFonts() the slots are reserved, LCD_GlyphAcquire()
+*  does not evict them.
+*
+* Parameters:
+*  slot:    Character code, 0 - 7
+*  pattern: LCD_GLYPH_ROWS bytes, copied (may be a temporary)
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_GlyphLoad(uint8_t slot, uint8_t const pattern[])
+{
+    if (slot >= LCD_GLYPH_SLOTS)
+    {
+        return;
+    }
+
+    LCD_GlyphUpload(slot, pattern);
+
+    #if (LCD_USE_GLYPH_CACHE != 0u)
+        /* The shadow copy outlives the caller's buffer */
+        LCD_glyphSlot[slot] = &LCD_cgramShadow[slot * LCD_GLYPH_ROWS];
+        LCD_glyphReserved = 1u;
+    #endif /* LCD_USE_GLYPH_CACHE != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphRestore
+********************************************************************************
+*
+* Summary:
+*  Uploads every slot recorded in LCD_cgramShadow again, e.g. after the
+*  controller lost its supply. Slot ownership of the glyph cache is unchanged.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_GlyphRestore(void)
+{
+    uint8_t slot;
+
+    for (slot = 0u; slot < LCD_GLYPH_SLOTS; slot++)
+    {
+        if ((LCD_cgramWritten & (1u << slot)) != 0u)
+        {
+            LCD_GlyphUpload(slot, &LCD_cgramShadow[slot * LCD_GLYPH_ROWS]);
+        }
+    }
+}
+
+
+#if (LCD_USE_GLYPH_CACHE != 0u)
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphOnScreen
+********************************************************************************
+*
+* Summary:
+*  Returns a bit mask of the slots whose character code is in the framebuffer
+*  or on the glass (0 without the framebuffer).
+*
+*******************************************************************************/
+static uint8_t LCD_GlyphOnScreen(void)
+{
+    uint8_t mask = 0u;
+
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        uint8_t row;
+        uint8_t column;
+
+        for (row = 0u; row < LCD_ROWS; row++)
+        {
+            for (column = 0u; column < LCD_COLUMNS; column++)
+            {
+                if (LCD_frame[row][column] < LCD_GLYPH_SLOTS)
+                {
+                    mask |= (uint8_t) (1u << LCD_frame[row][column]);
+                }
+                if (LCD_glass[row][column] < LCD_GLYPH_SLOTS)
+                {
+                    mask |= (uint8_t) (1u << LCD_glass[row][column]);
+                }
+            }
+        }
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+    return mask;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphFind
+********************************************************************************
+*
+* Summary:
+*  Returns the slot holding a pattern, LCD_GLYPH_NO_SLOT if not resident.
+*
+*******************************************************************************/
+static uint8_t LCD_GlyphFind(uint8_t const pattern[])
+{
+    uint8_t slot;
+
+    for (slot = 0u; slot < LCD_GLYPH_SLOTS; slot++)
+    {
+        if (LCD_glyphSlot[slot] == pattern)
+        {
+            return slot;
+        }
+    }
+
+    return LCD_GLYPH_NO_SLOT;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphVictim
+********************************************************************************
+*
+* Summary:
+*  Returns the least recently used slot that is neither on screen nor
+*  pinned, LCD_GLYPH_NO_SLOT if there is none.
+*
+*******************************************************************************/
+static uint8_t LCD_GlyphVictim(void)
+{
+    uint8_t const busy = LCD_GlyphOnScreen() | LCD_glyphPinned;
+    uint8_t victim = LCD_GLYPH_NO_SLOT;
+    uint8_t slot;
+
+    for (slot = 0u; slot < LCD_GLYPH_SLOTS; slot++)
+    {
+        if ((busy & (1u << slot)) != 0u)
+        {
+            continue;
+        }
+
+        /* Free slots have stamp 0 and are taken first */
+        if ((victim == LCD_GLYPH_NO_SLOT) || (LCD_glyphStamp[slot] < LCD_glyphStamp[victim]))
+        {
+            victim = slot;
+        }
+    }
+
+    return victim;
+}
+
+
+#if (LCD_USE_GLYPH_PACKS != 0u)
+/*******************************************************************************
+* Function Name: LCD_GlyphPackValid
+********************************************************************************
+*
+* Summary:
+*  Tells whether "glyph" is in the pack and the pack has a usable code
+*  width (5 bits when it has no dictionary).
+*
+*******************************************************************************/
+static uint8_t LCD_GlyphPackValid(LCD_GLYPH_PACK const *pack, uint16_t glyph)
+{
+    return ((glyph < pack->count) && (pack->bits != 0u) && (pack->bits <= LCD_GLYPH_PACK_BITS_MAX) &&
+            ((pack->rows != NULL) || (pack->bits == LCD_GLYPH_PACK_BITS_MAX))) ? 1u : 0u;
+}
+#endif /* LCD_USE_GLYPH_PACKS != 0u */
+
+#endif /* LCD_USE_GLYPH_CACHE != 0u */
+
+
+#if ((LCD_USE_GLYPH_QUEUE != 0u) && (LCD_USE_FRAMEBUFFER != 0u))
+/*******************************************************************************
+* Function Name: LCD_GlyphSwitch
+********************************************************************************
+*
+* Summary:
+*  Moves the framebuffer cells showing code "from" to code "to"; the next
+*  flush sends just those cells.
+*
+*******************************************************************************/
+static void LCD_GlyphSwitch(uint8_t from, uint8_t to)
+{
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            if (LCD_frame[row][column] == from)
+            {
+                LCD_LATENCY_CHANGE(row, column, to);
+                LCD_frame[row][column] = to;
+                LCD_frameDirty = 1u;
+            }
+        }
+    }
+}
+#endif /* (LCD_USE_GLYPH_QUEUE != 0u) && (LCD_USE_FRAMEBUFFER != 0u) */
+
+
+/*******************************************************************************
+* Function Name: LCD_GlyphUpload
+********************************************************************************
+*
+* Summary:
+*  Writes one glyph into CGRAM (and into LCD_cgramShadow) and puts the address
+*  counter back into DDRAM.
+*
+*******************************************************************************/
+static void LCD_GlyphUpload(uint8_t slot, uint8_t const pattern[])
+{
+    uint8_t address = LCD_CursorGet();
+    uint8_t row;
+
+    LCD_WriteControl((uint8_t) (LCD_CGRAM_0 | (slot * LCD_GLYPH_ROWS)));
+    #if (LCD_USE_WARM_START != 0u)
+        if (slot == LCD_WARM_SLOT)
+        {
+            /* Keeps the warm start signature in the bits the glyph does not show */
+            LCD_WarmMark(pattern);
+        }
+        else
+        {
+            LCD_WriteBuffer(pattern, LCD_GLYPH_ROWS);
+        }
+    #else
+        LCD_WriteBuffer(pattern, LCD_GLYPH_ROWS);
+    #endif /* LCD_USE_WARM_START != 0u */
+
+    if (LCD_IS_PRIMARY())
+    {
+        for (row = 0u; row < LCD_GLYPH_ROWS; row++)
+        {
+            LCD_cgramShadow[(slot * LCD_GLYPH_ROWS) + row] = pattern[row];
+        }
+        LCD_cgramWritten |= (uint8_t) (1u << slot);
+    }
+
+    if (address != LCD_CURSOR_UNKNOWN)
+    {
+        LCD_WriteControl((uint8_t) (LCD_DDRAM_0 | address));
+    }
+}
@@ -0,0 +1,424 @@
+/*
+ *  LCD_Handle.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Several HD44780 controllers on one shared bus.
+ *
+ *  			DB4-DB7 (DB0-DB7 on the 8-bit bus), RS and R/nW are wired to
+ *  			every module; each module has its own E line and ignores the
+ *  			bus while its E stays low. All per-controller state (init
+ *  			sequence, execution timestamp, address counter mirror) lives in
+ *  			an LCD_Handle. The LCD_Handle... functions point LCD_active at a
+ *  			handle and run the normal driver code, so the E strobes and the
+ *  			busy handling apply to that controller only.
+ *
+ *  			Because each handle keeps its own DWT timestamp, a byte for one
+ *  			controller is sent without waiting for a command the other one
+ *  			is still executing. Writing the displays in turn, one byte each
+ *  			(LCD_HandlePrintInterleaved), hides the 37 us execution time of
+ *  			one controller behind the transfer to the other.
+ *
+ *  Usage:      - set LCD_USE_MULTI_DISPLAY in LCD_Config.h
+ *  			- LCD_display0 is the module on E_Pin, the classic LCD_ API, the
+ *  				framebuffer, glyph cache, bargraphs, marquee and the DMA or
+ *  				interrupt transports always address it
+ *  			- further modules: LCD_HandleInit(&handle, GPIOx, LL_GPIO_PIN_y)
+ *  				(port clock enabled by the application), then LCD_HandleStart()
+ *  			- initialization of several modules overlaps with
+ *  				LCD_HandleInitBegin() and LCD_HandleInitPoll()
+ *  			- handle functions write straight to the module (no framebuffer)
+ *  				and are not reentrant; do not call them from interrupts
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Handle.h"
+#include "LCD_Timing.h"
+
+#if (LCD_USE_MULTI_DISPLAY != 0u)
+
+LCD_Handle *LCD_active = &LCD_display0;
+
+static LCD_Handle *LCD_HandleSelect(LCD_Handle *handle) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_HandleInit
+********************************************************************************
+*
+* Summary:
+*  Sets up the state of a further display and drives its E line low as a
+*  push-pull output.
+*
+* Parameters:
+*  handle: Display state to set up
+*  ePort:  GPIO port of the E line
+*  ePin:   E pin, LL_GPIO_PIN_x
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HandleInit(LCD_Handle *handle, GPIO_TypeDef *ePort, uint32_t ePin)
+{
+    handle->ePort = ePort;
+    handle->eBits = LCD_PIN_BITS(ePin);
+    handle->initVar = 0u;
+    handle->enableState = 0u;
+    handle->initStep = LCD_INIT_STEP_IDLE;
+    handle->initTick = 0u;
+    handle->timingStart = 0u;
+    handle->timingDuration = 0u;
+    handle->cursorAddress = LCD_CURSOR_UNKNOWN;
+    handle->cursorIncrement = 1u;
+    handle->cursorDdram = 0u;
+    handle->wrapAddress = LCD_CURSOR_UNKNOWN;
+    handle->functionSet = LCD_FUNCTION_SET_POR;
+    handle->entryMode = LCD_ENTRY_MODE_POR;
+    handle->displayControl = LCD_DISPLAY_CONTROL_POR;
+    handle->entryReversed = 0u;
+    handle->backup.enableState = 0u;
+    handle->linkState = LCD_LINK_UP;
+    handle->recoverStep = 0u;
+    handle->linkTick = 0u;
+    handle->geometry = LCD_GEOMETRY_DEFAULT;
+    #if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+        /* Shares the parallel bus unless LCD_SetTransport() says otherwise */
+        handle->transport = &LCD_transportGpio;
+    #endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+
+    /* E low before the pin becomes an output, the module must not latch */
+    WRITE_REG(ePort->BSRR, LCD_BSRR_RESET(handle->eBits));
+    LL_GPIO_SetPinMode(ePort, ePin, LL_GPIO_MODE_OUTPUT);
+    LL_GPIO_SetPinSpeed(ePort, ePin, LL_GPIO_SPEED_FREQ_LOW);
+    LL_GPIO_SetPinOutputType(ePort, ePin, LL_GPIO_OUTPUT_PUSHPULL);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandleStart
+********************************************************************************
+*
+* Summary:
+*  LCD_Start() for the display of "handle" (blocking initialization on the
+*  first call, then display on).
+*
+* Parameters:
+*  handle: Display to start
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HandleStart(LCD_Handle *handle)
+{
+    LCD_Handle *previous = LCD_HandleSelect(handle);
+
+    LCD_Start();
+    LCD_active = previous;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandleInitBegin
+********************************************************************************
+*
+* Summary:
+*  LCD_InitBegin() for the display of "handle".
+*
+* Parameters:
+*  handle: Display to initialize
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HandleInitBegin(LCD_Handle *handle)
+{
+    LCD_Handle *previous = LCD_HandleSelect(handle);
+
+    LCD_InitBegin();
+    LCD_active = previous;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandleInitPoll
+********************************************************************************
+*
+* Summary:
+*  LCD_InitPoll() for the display of "handle". Polling every handle in turn
+*  runs the power-on waits and command steps of all modules in parallel:
+*
+*  while ((LCD_HandleInitPoll(&LCD_display0) & LCD_HandleInitPoll(&second)) == 0u)
+*
+* Parameters:
+*  handle: Display being initialized
+*
+* Return:
+*  1 when the module is initialized, 0 while steps are pending.
+*
+*******************************************************************************/
+uint8_t LCD_HandleInitPoll(LCD_Handle *handle)
+{
+    LCD_Handle *previous = LCD_HandleSelect(handle);
+    uint8_t done;
+
+    done = LCD_InitPoll();
+    LCD_active = previous;
+
+    return done;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandleIsBusy
+********************************************************************************
+*
+* Summary:
+*  Reports whether the last write to the display may still be executing,
+*  from its timestamp (no bus access).
+*
+* Parameters:
+*  handle: Display to check
+*
+* Return:
+*  1 if the execution time has not elapsed yet, 0 if a write goes out
+*  without waiting.
+*
+*******************************************************************************/
+uint8_t LCD_HandleIsBusy(LCD_Handle *handle)
+{
+    LCD_Handle *previous = LCD_HandleSelect(handle);
+    uint8_t busy;
+
+    busy = (LCD_TimingExpired() == 0u) ? 1u : 0u;
+    LCD_active = previous;
+
+    return busy;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandleWriteControl
+********************************************************************************
+*
+* Summary:
+*  LCD_WriteControl() to the display of "handle".
+*
+* Parameters:
+*  handle: Display to write
+*  cByte:  Command byte
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HandleWriteControl(LCD_Handle *handle, uint8_t cByte)
+{
+    LCD_Handle *previous = LCD_HandleSelect(handle);
+
+    LCD_WriteControl(cByte);
+    LCD_active = previous;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandleWriteData
+********************************************************************************
+*
+* Summary:
+*  LCD_WriteData() to the display of "handle".
+*
+* Parameters:
+*  handle: Display to write
+*  dByte:  Data byte
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HandleWriteData(LCD_Handle *handle, uint8_t dByte)
+{
+    LCD_Handle *previous = LCD_HandleSelect(handle);
+
+    LCD_WriteData(dByte);
+    LCD_active = previous;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandleWriteBuffer
+********************************************************************************
+*
+* Summary:
+*  LCD_WriteBuffer() to the display of "handle".
+*
+* Parameters:
+*  handle: Display to write
+*  buffer: Bytes to be written at the current address
+*  length: Number of bytes
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HandleWriteBuffer(LCD_Handle *handle, uint8_t const buffer[], size_t length)
+{
+    LCD_Handle *previous = LCD_HandleSelect(handle);
+
+    LCD_WriteBuffer(buffer, length);
+    LCD_active = previous;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandlePosition
+********************************************************************************
+*
+* Summary:
+*  Sends a set-DDRAM-address command to the display of "handle".
+*
+* Parameters:
+*  handle: Display to write
+*  row:    Specific row of LCD module to be written
+*  column: Column of LCD module to be written
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HandlePosition(LCD_Handle *handle, uint8_t row, uint8_t column)
+{
+    LCD_Handle *previous = LCD_HandleSelect(handle);
+
+    LCD_WritePosition(row, column);
+    LCD_active = previous;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandlePrintString
+********************************************************************************
+*
+* Summary:
+*  Writes a zero terminated string to the display of "handle" as one
+*  LCD_WriteBuffer() run.
+*
+* Parameters:
+*  handle: Display to write
+*  string: Pointer to head of char8 array to be written to the LCD module
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HandlePrintString(LCD_Handle *handle, char const string[])
+{
+    size_t length = 0u;
+
+    while ((char) '\0' != string[length])
+    {
+        length++;
+    }
+
+    LCD_HandleWriteBuffer(handle, (uint8_t const *) string, length);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandlePrintInterleaved
+********************************************************************************
+*
+* Summary:
+*  Writes one string to each display, one character per display in turn.
+*  While a controller executes its last byte the next controller is written,
+*  so the bus waits only when every display is still busy.
+*
+* Parameters:
+*  handles: Displays to write, each at its current address
+*  strings: Zero terminated string for each display
+*  count:   Number of displays
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HandlePrintInterleaved(LCD_Handle *const handles[], char const *const strings[], uint8_t count)
+{
+    LCD_Handle *previous = LCD_active;
+    uint32_t done[8] = { 0u };
+    size_t index = 0u;
+    uint8_t display;
+    uint8_t pending;
+
+    do
+    {
+        pending = 0u;
+
+        for (display = 0u; display < count; display++)
+        {
+            /* A string is not read past its terminator */
+            if ((done[display >> 5u] & (1uL << (display & 31u))) == 0u)
+            {
+                if ((char) '\0' == strings[display][index])
+                {
+                    done[display >> 5u] |= 1uL << (display & 31u);
+                }
+                else
+                {
+                    LCD_active = handles[display];
+                    LCD_WriteData((uint8_t) strings[display][index]);
+                    pending = 1u;
+                }
+            }
+        }
+
+        index++;
+
+    } while (pending != 0u);
+
+    LCD_active = previous;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandleClearDisplay
+********************************************************************************
+*
+* Summary:
+*  Clears the display of "handle".
+*
+* Parameters:
+*  handle: Display to clear
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HandleClearDisplay(LCD_Handle *handle)
+{
+    LCD_HandleWriteControl(handle, LCD_CLEAR_DISPLAY);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HandleSelect
+********************************************************************************
+*
+* Summary:
+*  Points the driver at "handle" and returns the previously selected display.
+*
+*******************************************************************************/
+static LCD_Handle *LCD_HandleSelect(LCD_Handle *handle)
+{
+    LCD_Handle *previous = LCD_active;
+
+    LCD_active = handle;
+
+    return previous;
+}
+
+#endif /* LCD_USE_MULTI_DISPLAY != 0u */
@@ -0,0 +1,647 @@
+/*
+ *  LCD_I2c.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: PCF8574 I2C backpack transport for the HD44780 LCD driver.
+ *
+ *  			The backpack drives the module in 4-bit mode from the expander
+ *  			port (P0 RS, P1 R/nW, P2 E, P3 backlight, P4-P7 DB4-DB7). Every
+ *  			nibble is two expander states, E high then E low, and each
+ *  			state is one byte on the wire. LCD_WriteData()/LCD_WriteControl()
+ *  			encode their byte into a RAM buffer instead of the GPIO port,
+ *  			and DMA1 Channel 6 feeds the whole buffer to I2C1 as a single
+ *  			write transaction: one address byte for a string, not one
+ *  			transaction per nibble.
+ *
+ *  			A byte on the wire (90 us at 100 kHz) is far longer than the
+ *  			E pulse width, and the execution time of each command is
+ *  			"padded" into the stream as repeated E low states, so the bus
+ *  			rate itself paces the module and nothing polls the busy flag
+ *  			(R/nW stays low). Two buffers alternate: the CPU encodes into
+ *  			one while the other is on the wire, the interrupt continues
+ *  			with a repeated start when more bytes are waiting.
+ *
+ *  Usage:      - PB6 = SCL, PB7 = SDA (I2C1, external pull-ups on the backpack)
+ *  			- call LCD_I2cEventIRQHandler() from I2C1_EV_IRQHandler and
+ *  				LCD_I2cErrorIRQHandler() from I2C1_ER_IRQHandler
+ *  			- LCD_I2cBatchBegin()/LCD_I2cBatchEnd() group several calls into
+ *  				one transaction (LCD_PrintString, LCD_WriteBuffer and
+ *  				LCD_FlushFrame already do)
+ *  			- not callable from interrupts, a full buffer waits for the bus
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_I2c.h"
+#include "LCD_Transport.h"
+
+#if (LCD_USE_I2C_TRANSPORT != 0u)
+
+#if (LCD_BUS_8BIT != 0u)
+    #error "LCD_USE_I2C_TRANSPORT drives a 4-bit bus (DB4-DB7 on P4-P7)"
+#endif /* LCD_BUS_8BIT != 0u */
+
+#if ((LCD_USE_MULTI_DISPLAY != 0u) && (LCD_TRANSPORT != LCD_TRANSPORT_RUNTIME))
+    #error "LCD_TRANSPORT_I2C drives the single module on the backpack, bind it per display with LCD_TRANSPORT_RUNTIME"
+#endif /* (LCD_USE_MULTI_DISPLAY != 0u) && (LCD_TRANSPORT != LCD_TRANSPORT_RUNTIME) */
+
+#if (LCD_I2C_CLOCK_HZ > 400000u)
+    #error "I2C1 of the STM32F103 runs at 400 kHz at most"
+#endif /* LCD_I2C_CLOCK_HZ > 400000u */
+
+#if ((LCD_BUS_MASK_PRIORITY != 0u) && (LCD_I2C_IRQ_PRIORITY < LCD_BUS_MASK_PRIORITY))
+    #error "LCD_I2C_IRQ_PRIORITY above LCD_BUS_MASK_PRIORITY, the I2C interrupt would run in the middle of a hand-off"
+#endif /* (LCD_BUS_MASK_PRIORITY != 0u) && (LCD_I2C_IRQ_PRIORITY < LCD_BUS_MASK_PRIORITY) */
+
+/* The largest single write (one byte plus the clear display padding) has to fit */
+#if (LCD_I2C_BUFFER_SIZE < (LCD_I2C_BYTES_PER_BYTE + LCD_I2C_PAD(LCD_EXEC_LONG_US)))
+    #error "LCD_I2C_BUFFER_SIZE too small for a clear display at LCD_I2C_CLOCK_HZ"
+#endif /* LCD_I2C_BUFFER_SIZE < ... */
+
+/* Transfer states */
+#define LCD_I2C_STATE_IDLE           (0u)      /* STOP sent, fill buffer not on the bus */
+#define LCD_I2C_STATE_ADDRESS        (1u)      /* start and slave address phase */
+#define LCD_I2C_STATE_DATA           (2u)      /* DMA feeding the data register */
+
+/* OAR1 bit 14 must be kept at 1 by software (RM0008) */
+#define LCD_I2C_OAR1_BIT14           (0x4000u)
+
+/* Flags cleared by writing 0 in SR1 */
+#define LCD_I2C_SR1_ERRORS           (I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR)
+
+/* Encoded expander states, [LCD_i2cFillIndex] is filled by the CPU */
+static uint8_t LCD_i2cBuffer[2u][LCD_I2C_BUFFER_SIZE];
+static volatile uint16_t LCD_i2cFill = 0u;
+static volatile uint8_t LCD_i2cFillIndex = 0u;
+
+static volatile uint8_t LCD_i2cState = LCD_I2C_STATE_IDLE;
+static volatile uint8_t LCD_i2cHold = 0u;
+static volatile uint32_t LCD_i2cErrorCount = 0u;
+
+/* Port bits driven in every state besides RS, E and the data (backlight) */
+static uint8_t LCD_i2cPortBits = LCD_I2C_BACKLIGHT;
+
+static void LCD_I2cAppend(uint8_t const states[], uint8_t count, uint16_t pad) ;
+static void LCD_I2cKick(void) ;
+static void LCD_I2cDrain(void) ;
+static void LCD_I2cLaunch(void) ;
+
+#if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+    /* The busy flag is not read, execution times are padded into the stream */
+    const LCD_Transport LCD_transportI2c =
+    {
+        LCD_I2cStart, LCD_I2cWriteByte, LCD_I2cWriteHandshake, LCD_I2cWriteBuffer,
+        NULL, LCD_I2cSync, NULL, LCD_I2cBatchBegin, LCD_I2cBatchEnd, NULL
+    };
+#endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cStart
+********************************************************************************
+*
+* Summary:
+*  Configures PB6/PB7, I2C1 at LCD_I2C_CLOCK_HZ with DMA requests and DMA1
+*  Channel 6 (memory to I2C1 data register), then drives every expander
+*  output low with the backlight on.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+* Note:
+*  Called by LCD_InitBegin().
+*
+*******************************************************************************/
+void LCD_I2cStart(void)
+{
+    uint32_t const pclk1 = HAL_RCC_GetPCLK1Freq();
+    uint32_t const freqMhz = pclk1 / 1000000u;
+    uint32_t ccr;
+    uint8_t state;
+
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_GPIOB);
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_I2C1);
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+
+    HAL_NVIC_DisableIRQ(I2C1_EV_IRQn);
+    HAL_NVIC_DisableIRQ(I2C1_ER_IRQn);
+
+    LL_GPIO_SetPinMode(GPIOB, LL_GPIO_PIN_6 | LL_GPIO_PIN_7, LL_GPIO_MODE_ALTERNATE);
+    LL_GPIO_SetPinOutputType(GPIOB, LL_GPIO_PIN_6 | LL_GPIO_PIN_7, LL_GPIO_OUTPUT_OPENDRAIN);
+    LL_GPIO_SetPinSpeed(GPIOB, LL_GPIO_PIN_6, LL_GPIO_SPEED_FREQ_HIGH);
+    LL_GPIO_SetPinSpeed(GPIOB, LL_GPIO_PIN_7, LL_GPIO_SPEED_FREQ_HIGH);
+
+    /* Software reset releases a bus left busy by a reset in mid-transfer */
+    I2C1->CR1 = I2C_CR1_SWRST;
+    I2C1->CR1 = 0u;
+
+    I2C1->CR2 = freqMhz & I2C_CR2_FREQ;
+    I2C1->OAR1 = LCD_I2C_OAR1_BIT14;
+
+    #if (LCD_I2C_CLOCK_HZ > 100000u)
+        /* Fast mode, Tlow/Thigh = 2, rounded up to stay at or below the rate */
+        ccr = (pclk1 + (3u * LCD_I2C_CLOCK_HZ) - 1u) / (3u * LCD_I2C_CLOCK_HZ);
+        I2C1->CCR = I2C_CCR_FS | ((ccr != 0u) ? ccr : 1u);
+        I2C1->TRISE = ((freqMhz * 300u) / 1000u) + 1u;
+    #else
+        ccr = (pclk1 + (2u * LCD_I2C_CLOCK_HZ) - 1u) / (2u * LCD_I2C_CLOCK_HZ);
+        I2C1->CCR = (ccr > 4u) ? ccr : 4u;
+        I2C1->TRISE = freqMhz + 1u;
+    #endif /* LCD_I2C_CLOCK_HZ > 100000u */
+
+    I2C1->CR2 |= I2C_CR2_DMAEN | I2C_CR2_ITERREN;
+    I2C1->CR1 = I2C_CR1_PE;
+
+    LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_6);
+    LL_DMA_ConfigTransfer(DMA1, LL_DMA_CHANNEL_6,
+                          LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_MODE_NORMAL |
+                          LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                          LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE |
+                          LL_DMA_PRIORITY_MEDIUM);
+    LL_DMA_SetPeriphAddress(DMA1, LL_DMA_CHANNEL_6, (uint32_t) &I2C1->DR);
+
+    LCD_i2cFill = 0u;
+    LCD_i2cFillIndex = 0u;
+    LCD_i2cHold = 0u;
+    LCD_i2cState = LCD_I2C_STATE_IDLE;
+
+    HAL_NVIC_SetPriority(I2C1_EV_IRQn, LCD_I2C_IRQ_PRIORITY, 0u);
+    HAL_NVIC_SetPriority(I2C1_ER_IRQn, LCD_I2C_IRQ_PRIORITY, 0u);
+    HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+    HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+
+    /* The expander comes out of reset with every output high, E included */
+    state = LCD_i2cPortBits;
+    LCD_I2cAppend(&state, 1u, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cWriteByte
+********************************************************************************
+*
+* Summary:
+*  Encodes a command or data byte as four expander states (high nibble E
+*  high/low, low nibble E high/low) plus the padding for its execution time.
+*  The states go out with the transaction in progress, or start one.
+*
+* Parameters:
+*  value: Command or data byte
+*  rs:    0 = instruction register, 1 = data register
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_I2cWriteByte(uint8_t value, uint8_t rs)
+{
+    uint8_t states[LCD_I2C_BYTES_PER_BYTE];
+    uint8_t const port = LCD_i2cPortBits | ((rs != 0u) ? LCD_I2C_RS : 0u);
+    uint8_t const high = (uint8_t) ((value & 0xF0u) | port);
+    uint8_t const low = (uint8_t) ((uint8_t) (value << LCD_I2C_DATA_SHIFT) | port);
+    uint16_t pad = LCD_I2C_PAD(LCD_EXEC_SHORT_US);
+
+    if ((rs == 0u) && LCD_IS_LONG_CMD(value))
+    {
+        pad = LCD_I2C_PAD(LCD_EXEC_LONG_US);
+    }
+
+    states[0u] = high | LCD_I2C_E;
+    states[1u] = high;
+    states[2u] = low | LCD_I2C_E;
+    states[3u] = low;
+
+    LCD_I2cAppend(states, LCD_I2C_BYTES_PER_BYTE, pad);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cWriteHandshake
+********************************************************************************
+*
+* Summary:
+*  Sends one function set nibble of the interface handshake and waits until
+*  it is on the wire, so the caller's datasheet wait starts at the real strobe.
+*
+* Parameters:
+*  nibble: LCD_DISPLAY_8_BIT_INIT or LCD_DISPLAY_4_BIT_INIT
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_I2cWriteHandshake(uint8_t nibble)
+{
+    uint8_t states[LCD_I2C_BYTES_PER_NIBBLE];
+    uint8_t const state = (uint8_t) ((uint8_t) (nibble << LCD_I2C_DATA_SHIFT) | LCD_i2cPortBits);
+
+    states[0u] = state | LCD_I2C_E;
+    states[1u] = state;
+
+    LCD_I2cAppend(states, LCD_I2C_BYTES_PER_NIBBLE, 0u);
+
+    /* Errors are left for the next LCD_I2cSync() */
+    LCD_I2cDrain();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cWriteBuffer
+********************************************************************************
+*
+* Summary:
+*  Encodes a run of data bytes, padded to the data execution time, as one
+*  batch (one I2C transaction).
+*
+* Parameters:
+*  buffer: Bytes to write
+*  length: Number of bytes
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_I2cWriteBuffer(uint8_t const buffer[], size_t length)
+{
+    size_t index;
+
+    LCD_I2cBatchBegin();
+    for (index = 0u; index < length; index++)
+    {
+        LCD_I2cWriteByte(buffer[index], 1u);
+    }
+    LCD_I2cBatchEnd();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cBatchBegin
+********************************************************************************
+*
+* Summary:
+*  Holds back the writes that follow, until the matching LCD_I2cBatchEnd(),
+*  so they leave in one transaction. Nests.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_I2cBatchBegin(void)
+{
+    LCD_i2cHold++;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cBatchEnd
+********************************************************************************
+*
+* Summary:
+*  Ends a batch; the outermost one starts the transaction if the bus is idle
+*  (otherwise the interrupt continues with it after the current one).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_I2cBatchEnd(void)
+{
+    if (LCD_i2cHold != 0u)
+    {
+        LCD_i2cHold--;
+    }
+
+    if (LCD_i2cHold == 0u)
+    {
+        LCD_I2cKick();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cSync
+********************************************************************************
+*
+* Summary:
+*  Sends everything encoded so far, a batch in progress included, and waits
+*  until the last state (and its padding) is on the wire.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if the backpack acknowledged everything since the previous call, 0
+*  after a bus error (missing or unpowered backpack).
+*
+*******************************************************************************/
+uint8_t LCD_I2cSync(void)
+{
+    static uint32_t LCD_i2cErrorsSeen = 0u;
+    uint32_t errors;
+
+    LCD_I2cDrain();
+
+    errors = LCD_i2cErrorCount;
+    if (errors != LCD_i2cErrorsSeen)
+    {
+        LCD_i2cErrorsSeen = errors;
+        return 0u;
+    }
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cIsBusy
+********************************************************************************
+*
+* Summary:
+*  Reports whether encoded states are still waiting or on the wire.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 while busy, 0 when the expander holds the last state.
+*
+*******************************************************************************/
+uint8_t LCD_I2cIsBusy(void)
+{
+    return ((LCD_i2cState != LCD_I2C_STATE_IDLE) || (LCD_i2cFill != 0u)) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cErrors
+********************************************************************************
+*
+* Summary:
+*  Returns the number of transactions aborted by a bus error or a missing
+*  acknowledge (no backpack at LCD_I2C_ADDRESS). The states of an aborted
+*  transaction are dropped.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Error count since LCD_I2cStart().
+*
+*******************************************************************************/
+uint32_t LCD_I2cErrors(void)
+{
+    return LCD_i2cErrorCount;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cSetBacklight
+********************************************************************************
+*
+* Summary:
+*  Switches the backpack backlight (P3), with the next expander state.
+*
+* Parameters:
+*  on: 0 = off, otherwise on
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_I2cSetBacklight(uint8_t on)
+{
+    uint8_t state;
+
+    LCD_i2cPortBits = (on != 0u) ? LCD_I2C_BACKLIGHT : 0u;
+    state = LCD_i2cPortBits;
+    LCD_I2cAppend(&state, 1u, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cEventIRQHandler
+********************************************************************************
+*
+* Summary:
+*  I2C1 event interrupt: writes the slave address after the start, hands the
+*  data phase to the DMA once addressed and, at the byte transfer finished
+*  after the last DMA byte, continues with the other buffer through a
+*  repeated start or ends the transaction with a stop.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_I2cEventIRQHandler(void)
+{
+    uint32_t const sr1 = I2C1->SR1;
+
+    if ((sr1 & I2C_SR1_SB) != 0u)
+    {
+        /* SR1 read then DR write clears SB */
+        I2C1->DR = (uint32_t) LCD_I2C_ADDRESS << 1u;
+    }
+    else if ((sr1 & I2C_SR1_ADDR) != 0u)
+    {
+        /* SR1 then SR2 read clears ADDR, TXE requests start the DMA */
+        (void) I2C1->SR2;
+        LCD_i2cState = LCD_I2C_STATE_DATA;
+    }
+    else if (((sr1 & I2C_SR1_BTF) != 0u) && (LCD_i2cState == LCD_I2C_STATE_DATA) &&
+             (LL_DMA_GetDataLength(DMA1, LL_DMA_CHANNEL_6) == 0u))
+    {
+        LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_6);
+
+        if ((LCD_i2cFill != 0u) && (LCD_i2cHold == 0u))
+        {
+            /* BTF stays set until the repeated start is on the bus, the
+             * state makes the few interrupts in between no-ops
+             */
+            LCD_I2cLaunch();
+        }
+        else
+        {
+            I2C1->CR1 |= I2C_CR1_STOP;
+            I2C1->CR2 &= ~I2C_CR2_ITEVTEN;
+            LCD_i2cState = LCD_I2C_STATE_IDLE;
+        }
+    }
+    else
+    {
+        /* BTF of the previous buffer before the repeated start went out */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cErrorIRQHandler
+********************************************************************************
+*
+* Summary:
+*  I2C1 error interrupt: aborts the transaction and drops the states still
+*  waiting, the application sees it in LCD_I2cErrors().
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_I2cErrorIRQHandler(void)
+{
+    uint32_t const sr1 = I2C1->SR1;
+
+    I2C1->SR1 = ~LCD_I2C_SR1_ERRORS & 0xFFFFu;
+    LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_6);
+
+    if ((sr1 & I2C_SR1_ARLO) == 0u)
+    {
+        /* Still the master of the bus, release it */
+        I2C1->CR1 |= I2C_CR1_STOP;
+    }
+    I2C1->CR2 &= ~I2C_CR2_ITEVTEN;
+
+    LCD_i2cFill = 0u;
+    LCD_i2cState = LCD_I2C_STATE_IDLE;
+    LCD_i2cErrorCount++;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cAppend
+********************************************************************************
+*
+* Summary:
+*  Copies expander states, then "pad" repeats of the last one, into the fill
+*  buffer. A full buffer is sent first (a batch is split there). Outside a
+*  batch the transaction is started at once if the bus is idle.
+*
+*******************************************************************************/
+static void LCD_I2cAppend(uint8_t const states[], uint8_t count, uint16_t pad)
+{
+    uint16_t const total = (uint16_t) count + pad;
+    uint32_t mask;
+    uint8_t *dst;
+    uint16_t index;
+
+    while (((uint32_t) LCD_i2cFill + total) > LCD_I2C_BUFFER_SIZE)
+    {
+        /* The interrupt takes it after the current transaction, or it starts now */
+        LCD_I2cKick();
+    }
+
+    /* The interrupt swaps buffers, it must not see a half written entry */
+    LCD_BUS_ATOMIC_BEGIN(mask);
+
+    dst = &LCD_i2cBuffer[LCD_i2cFillIndex][LCD_i2cFill];
+    for (index = 0u; index < count; index++)
+    {
+        dst[index] = states[index];
+    }
+    for (; index < total; index++)
+    {
+        dst[index] = states[count - 1u];
+    }
+    LCD_i2cFill = LCD_i2cFill + total;
+
+    LCD_BUS_ATOMIC_END(mask);
+
+    if (LCD_i2cHold == 0u)
+    {
+        LCD_I2cKick();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cDrain
+********************************************************************************
+*
+* Summary:
+*  Sends everything encoded so far and waits until it is on the wire.
+*
+*******************************************************************************/
+static void LCD_I2cDrain(void)
+{
+    do
+    {
+        LCD_I2cKick();
+    } while ((LCD_i2cState != LCD_I2C_STATE_IDLE) || (LCD_i2cFill != 0u));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cKick
+********************************************************************************
+*
+* Summary:
+*  Starts a transaction with the fill buffer when the bus is idle. The stop
+*  of the previous transaction has to be on the bus before the next start.
+*
+*******************************************************************************/
+static void LCD_I2cKick(void)
+{
+    uint32_t mask;
+
+    if ((LCD_i2cState != LCD_I2C_STATE_IDLE) || (LCD_i2cFill == 0u))
+    {
+        return;
+    }
+
+    while ((I2C1->CR1 & I2C_CR1_STOP) != 0u)
+    {
+    }
+
+    LCD_BUS_ATOMIC_BEGIN(mask);
+
+    if ((LCD_i2cState == LCD_I2C_STATE_IDLE) && (LCD_i2cFill != 0u))
+    {
+        I2C1->CR2 |= I2C_CR2_ITEVTEN;
+        LCD_I2cLaunch();
+    }
+
+    LCD_BUS_ATOMIC_END(mask);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_I2cLaunch
+********************************************************************************
+*
+* Summary:
+*  Points DMA1 Channel 6 at the fill buffer, makes the other buffer the fill
+*  buffer and requests a (repeated) start. Interrupts masked or called from
+*  the event interrupt.
+*
+*******************************************************************************/
+static void LCD_I2cLaunch(void)
+{
+    uint8_t const index = LCD_i2cFillIndex;
+
+    LL_DMA_SetMemoryAddress(DMA1, LL_DMA_CHANNEL_6, (uint32_t) LCD_i2cBuffer[index]);
+    LL_DMA_SetDataLength(DMA1, LL_DMA_CHANNEL_6, LCD_i2cFill);
+    LL_DMA_EnableChannel(DMA1, LL_DMA_CHANNEL_6);
+
+    LCD_i2cFillIndex = index ^ 1u;
+    LCD_i2cFill = 0u;
+    LCD_i2cState = LCD_I2C_STATE_ADDRESS;
+
+    I2C1->CR1 |= I2C_CR1_START;
+}
+
+#endif /* LCD_USE_I2C_TRANSPORT != 0u */
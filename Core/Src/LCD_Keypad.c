@@ -0,0 +1,340 @@
+/*
+ *  LCD_Keypad.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: 4x4 keypad scanned on the data lines of the HD44780 LCD
+ *  			driver.
+ *
+ *  			The keypad columns share DB4-DB7 with the display, only the
+ *  			four rows need pins of their own. The module ignores the data
+ *  			lines while E is low, so a scan may take them over between
+ *  			any two strobes: LCD_KeypadTick() runs from the HAL tick and,
+ *  			every LCD_KEYPAD_SCAN_MS, scans when E is low and no DMA
+ *  			stream is running, with the bus interrupts masked. The data lines
+ *  			become inputs with pull-up (the same take-over LCD_IsReady()
+ *  			makes), each row is driven low in turn and the columns read,
+ *  			then CRL/CRH and the output bits of the data port are put
+ *  			back exactly as found. A byte in flight (blocking, queued or
+ *  			halfway through a status read) only sees a longer gap, never
+ *  			a shorter one; the scan costs about
+ *  			LCD_KEYPAD_ROWS * LCD_KEYPAD_SETTLE_NS of masked time, held
+ *  			only against the interrupts at LCD_BUS_MASK_PRIORITY and
+ *  			below: they are the ones that strobe the display, and must
+ *  			not find the data lines as inputs halfway through a scan.
+ *
+ *  			A key state that stays the same for LCD_KEYPAD_DEBOUNCE scans
+ *  			is taken, and every key that changed puts a press or release
+ *  			event into a queue read by LCD_KeypadGetEvent().
+ *
+ *  Usage:      - wire the rows to LCD_KEYPAD_ROW0_PIN - LCD_KEYPAD_ROW3_PIN
+ *  				(open-drain, released = floating) and the columns to
+ *  				DB4-DB7; a key then never shorts the data lines while
+ *  				the display is written
+ *  			- LCD_KeypadStart() once after MX_GPIO_Init() (row port clock
+ *  				on), call LCD_KeypadTick() from SysTick_Handler
+ *  			- without diodes three keys on a rectangle ghost a fourth
+ *  			- GPIO transport only, DB4-DB7 must be on MCU pins
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Handle.h"
+#include "LCD_Timing.h"
+#include "LCD_Transport.h"
+#include "LCD_Dma.h"
+#include "LCD_Keypad.h"
+
+#if (LCD_USE_KEYPAD != 0u)
+
+#if (LCD_TRANSPORT_HAS_GPIO == 0u)
+    #error "LCD_USE_KEYPAD shares DB4-DB7 of the parallel bus (LCD_TRANSPORT_GPIO or _RUNTIME)"
+#endif /* LCD_TRANSPORT_HAS_GPIO == 0u */
+
+#if (LCD_USE_PIN_MAP != 0u)
+    #error "LCD_USE_KEYPAD scans DB4-DB7 on DB4_GPIO_Port, not LCD_USE_PIN_MAP"
+#endif /* LCD_USE_PIN_MAP != 0u */
+
+#if ((LCD_KEYPAD_QUEUE_SIZE & (LCD_KEYPAD_QUEUE_SIZE - 1u)) != 0u)
+    #error "LCD_KEYPAD_QUEUE_SIZE must be a power of two"
+#endif /* (LCD_KEYPAD_QUEUE_SIZE & (LCD_KEYPAD_QUEUE_SIZE - 1u)) != 0u */
+
+/* Port bits of the rows, scanned in this order */
+static uint32_t const LCD_keypadRows[LCD_KEYPAD_ROWS] =
+{
+    LCD_PIN_BITS(LCD_KEYPAD_ROW0_PIN), LCD_PIN_BITS(LCD_KEYPAD_ROW1_PIN),
+    LCD_PIN_BITS(LCD_KEYPAD_ROW2_PIN), LCD_PIN_BITS(LCD_KEYPAD_ROW3_PIN)
+};
+
+/* Single producer (HAL tick), single consumer (LCD_KeypadGetEvent) ring */
+static uint8_t LCD_keypadQueue[LCD_KEYPAD_QUEUE_SIZE];
+static volatile uint8_t LCD_keypadHead = 0u;
+static volatile uint8_t LCD_keypadTail = 0u;
+
+/* Debounced key map, and the raw map it is changing to */
+static volatile uint16_t LCD_keypadStable = 0u;
+static uint16_t LCD_keypadRaw = 0u;
+static uint8_t LCD_keypadCount = 0u;
+
+/* Milliseconds since the last scan, 0xFF until LCD_KeypadStart() */
+static uint8_t LCD_keypadMs = 0xFFu;
+
+static uint8_t LCD_KeypadScan(uint16_t *keys) ;
+static void LCD_KeypadDebounce(uint16_t keys) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_KeypadStart
+********************************************************************************
+*
+* Summary:
+*  Configures the row pins as released open-drain outputs and starts the
+*  scans of LCD_KeypadTick().
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_KeypadStart(void)
+{
+    uint32_t const rows[LCD_KEYPAD_ROWS] =
+    {
+        LCD_KEYPAD_ROW0_PIN, LCD_KEYPAD_ROW1_PIN, LCD_KEYPAD_ROW2_PIN, LCD_KEYPAD_ROW3_PIN
+    };
+    uint8_t row;
+
+    for (row = 0u; row < LCD_KEYPAD_ROWS; row++)
+    {
+        WRITE_REG(LCD_KEYPAD_ROW_PORT->BSRR, LCD_BSRR_SET(LCD_keypadRows[row]));
+        LL_GPIO_SetPinMode(LCD_KEYPAD_ROW_PORT, rows[row], LL_GPIO_MODE_OUTPUT);
+        LL_GPIO_SetPinSpeed(LCD_KEYPAD_ROW_PORT, rows[row], LL_GPIO_SPEED_FREQ_LOW);
+        LL_GPIO_SetPinOutputType(LCD_KEYPAD_ROW_PORT, rows[row], LL_GPIO_OUTPUT_OPENDRAIN);
+    }
+
+    LCD_keypadRaw = 0u;
+    LCD_keypadCount = 0u;
+    LCD_keypadStable = 0u;
+    LCD_keypadMs = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_KeypadTick
+********************************************************************************
+*
+* Summary:
+*  Scans the keypad every LCD_KEYPAD_SCAN_MS. A scan that finds the bus in
+*  use is retried on the next tick.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_KeypadTick(void)
+{
+    uint16_t keys;
+
+    if (LCD_keypadMs == 0xFFu)
+    {
+        return;
+    }
+
+    if (LCD_keypadMs < (LCD_KEYPAD_SCAN_MS - 1u))
+    {
+        LCD_keypadMs++;
+        return;
+    }
+
+    if (LCD_KeypadScan(&keys) != 0u)
+    {
+        LCD_keypadMs = 0u;
+        LCD_KeypadDebounce(keys);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_KeypadGetEvent
+********************************************************************************
+*
+* Summary:
+*  Takes the oldest key event from the queue.
+*
+* Parameters:
+*  event: Receives the key index (LCD_KEYPAD_KEY()), with LCD_KEYPAD_RELEASED
+*         set for a release
+*
+* Return:
+*  1 if an event was taken, 0 if the queue is empty.
+*
+*******************************************************************************/
+uint8_t LCD_KeypadGetEvent(uint8_t *event)
+{
+    uint8_t const tail = LCD_keypadTail;
+
+    if (tail == LCD_keypadHead)
+    {
+        return 0u;
+    }
+
+    *event = LCD_keypadQueue[tail];
+    LCD_keypadTail = (uint8_t) ((tail + 1u) & (LCD_KEYPAD_QUEUE_SIZE - 1u));
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_KeypadState
+********************************************************************************
+*
+* Summary:
+*  Returns the debounced state of all keys.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  One bit per key, LCD_KEYPAD_BIT(row, column), 1 = pressed.
+*
+*******************************************************************************/
+uint16_t LCD_KeypadState(void)
+{
+    return LCD_keypadStable;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_KeypadScan
+********************************************************************************
+*
+* Summary:
+*  Reads the key matrix on DB4-DB7 if the display bus is between strobes,
+*  and leaves the data port as it found it. The bus interrupts stay masked
+*  through the settle delays, the data lines are not the display's until
+*  CRL/CRH are back.
+*
+*******************************************************************************/
+static uint8_t LCD_KeypadScan(uint16_t *keys)
+{
+    uint32_t saved;
+    uint32_t crl;
+    uint32_t crh;
+    uint32_t odr;
+    uint32_t columns;
+    uint16_t found = 0u;
+    uint8_t row;
+
+    LCD_BUS_ATOMIC_BEGIN(saved);
+
+    /* E high: a byte is being latched or the module drives the data lines */
+    if ((LCD_E_PORT->ODR & LCD_E_BITS) != 0u)
+    {
+        LCD_BUS_ATOMIC_END(saved);
+        return 0u;
+    }
+
+    #if (LCD_USE_DMA_TRANSPORT != 0u)
+        /* The DMA writes the data port without the CPU */
+        if (LCD_DmaIsBusy() != 0u)
+        {
+            LCD_BUS_ATOMIC_END(saved);
+            return 0u;
+        }
+    #endif /* LCD_USE_DMA_TRANSPORT != 0u */
+
+    crl = DB4_GPIO_Port->CRL;
+    crh = DB4_GPIO_Port->CRH;
+    odr = DB4_GPIO_Port->ODR & LCD_STM32_NIBBLE_MASK;
+
+    /* Columns: inputs, pulled up through the output bits */
+    WRITE_REG(DB4_GPIO_Port->BSRR, LCD_BSRR_SET(LCD_STM32_NIBBLE_MASK));
+    LL_GPIO_SetPinMode(DB4_GPIO_Port, DB4_Pin, LL_GPIO_MODE_INPUT);
+    LL_GPIO_SetPinMode(DB5_GPIO_Port, DB5_Pin, LL_GPIO_MODE_INPUT);
+    LL_GPIO_SetPinMode(DB6_GPIO_Port, DB6_Pin, LL_GPIO_MODE_INPUT);
+    LL_GPIO_SetPinMode(DB7_GPIO_Port, DB7_Pin, LL_GPIO_MODE_INPUT);
+
+    for (row = 0u; row < LCD_KEYPAD_ROWS; row++)
+    {
+        WRITE_REG(LCD_KEYPAD_ROW_PORT->BSRR, LCD_BSRR_RESET(LCD_keypadRows[row]));
+        LCD_DelayNs(LCD_KEYPAD_SETTLE_NS);
+
+        /* A pressed key pulls its column low */
+        columns = (~LL_GPIO_ReadInputPort(DB4_GPIO_Port) & LCD_STM32_NIBBLE_MASK) >> LCD_STM32_NIBBLE_SHIFT;
+        found |= (uint16_t) (columns << (row * LCD_KEYPAD_COLUMNS));
+
+        WRITE_REG(LCD_KEYPAD_ROW_PORT->BSRR, LCD_BSRR_SET(LCD_keypadRows[row]));
+    }
+
+    /* Output bits first, so the pins come back as outputs at their old level */
+    WRITE_REG(DB4_GPIO_Port->BSRR, LCD_BSRR_SET(odr) | LCD_BSRR_RESET(odr ^ LCD_STM32_NIBBLE_MASK));
+    WRITE_REG(DB4_GPIO_Port->CRL, crl);
+    WRITE_REG(DB4_GPIO_Port->CRH, crh);
+
+    LCD_BUS_ATOMIC_END(saved);
+
+    *keys = found;
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_KeypadDebounce
+********************************************************************************
+*
+* Summary:
+*  Takes a key map that held for LCD_KEYPAD_DEBOUNCE scans and queues one
+*  event per key that changed. Events that do not fit are dropped.
+*
+*******************************************************************************/
+static void LCD_KeypadDebounce(uint16_t keys)
+{
+    uint16_t changed;
+    uint8_t key;
+    uint8_t head;
+
+    if (keys != LCD_keypadRaw)
+    {
+        LCD_keypadRaw = keys;
+        LCD_keypadCount = 1u;
+        return;
+    }
+
+    if (LCD_keypadCount < LCD_KEYPAD_DEBOUNCE)
+    {
+        LCD_keypadCount++;
+        if (LCD_keypadCount < LCD_KEYPAD_DEBOUNCE)
+        {
+            return;
+        }
+    }
+
+    changed = keys ^ LCD_keypadStable;
+    if (changed == 0u)
+    {
+        return;
+    }
+    LCD_keypadStable = keys;
+
+    for (key = 0u; key < (LCD_KEYPAD_ROWS * LCD_KEYPAD_COLUMNS); key++)
+    {
+        if ((changed & (1u << key)) != 0u)
+        {
+            head = LCD_keypadHead;
+            if (((head + 1u) & (LCD_KEYPAD_QUEUE_SIZE - 1u)) != LCD_keypadTail)
+            {
+                LCD_keypadQueue[head] = ((keys & (1u << key)) != 0u) ? key : (uint8_t) (key | LCD_KEYPAD_RELEASED);
+                LCD_keypadHead = (uint8_t) ((head + 1u) & (LCD_KEYPAD_QUEUE_SIZE - 1u));
+            }
+        }
+    }
+}
+
+#endif /* LCD_USE_KEYPAD != 0u */
@@ -0,0 +1,430 @@
+/*
+ *  LCD_Latency.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Update latency probes for the HD44780 LCD driver.
+ *
+ *  			How long a value takes to show matters more than how long a
+ *  			call takes. When a writer changes a framebuffer cell (the
+ *  			LCD_Frame API, windows, menu, console, stdout, CAN, remote),
+ *  			or the application calls LCD_LatencyMark() for the cells of a
+ *  			value it is about to change, the DWT cycle counter
+ *  			is stamped into the cell together with the priority class in
+ *  			effect (LCD_LatencySetClass()). LCD_FlushFrame() and
+ *  			LCD_DmaFlushFrame() flag the cells they send, and once the
+ *  			last bus write is out (at the transfer-complete interrupt for
+ *  			the DMA) each flagged cell adds the time since its stamp to
+ *  			the histogram of its class: samples, minimum, maximum, mean
+ *  			and percentiles from buckets 25 % apart. LCD_Poll(), the
+ *  			marquee and blob playback account each cell as they write it.
+ *  			A cell changed again before it was sent keeps its first stamp,
+ *  			so the figure is how stale the glass got, not the age of the
+ *  			last write; one written back to what the glass shows before a
+ *  			flush took it loses its stamp.
+ *
+ *  Usage:      - LCD_GetLatency(LCD_LATENCY_ROUTINE, &latency) next to
+ *  				LCD_GetStats(), LCD_ResetStats() clears both; the routine
+ *  				us99 against LCD_REFRESH_PERIOD_MS sizes the refresh rate
+ *  			- an alarm: previous = LCD_LatencySetClass(LCD_LATENCY_ALARM),
+ *  				draw, LCD_LatencySetClass(previous), LCD_RefreshUrgent();
+ *  				its usMax is the preemption bound the display met
+ *  			- a cell already pending at a lower class is stamped again for
+ *  				the higher one
+ *  			- LCD_LatencyMark() only for cells that really change, a mark
+ *  				stays until a flush sends the cell
+ *  			- one sample per cell; an application that stores into
+ *  				LCD_frame itself calls LCD_LatencyMark() or
+ *  				LCD_LATENCY_CHANGE() before the store
+ *  			- LCD_CanIRQHandler() stamps from its interrupt with the class
+ *  				in effect; a cell it changes while a flush sends that cell
+ *  				goes unsampled, the flush accounts the earlier stamp
+ *  			- with the I2C or SPI transports the end of the flush is the
+ *  				hand-off of its last bytes, not their arrival
+ *  			- stamps run on the cycle counter and wrap after 2^32 cycles
+ *  				(59 s at 72 MHz)
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Timing.h"
+#include "LCD_Latency.h"
+
+#if (LCD_USE_LATENCY != 0u)
+
+#if ((LCD_USE_STATS == 0u) || (LCD_USE_FRAMEBUFFER == 0u))
+    #error "LCD_USE_LATENCY reports with the stats (LCD_USE_STATS) on framebuffer flushes (LCD_USE_FRAMEBUFFER)"
+#endif /* (LCD_USE_STATS == 0u) || (LCD_USE_FRAMEBUFFER == 0u) */
+
+#if ((LCD_LATENCY_CLASSES == 0u) || (LCD_LATENCY_CLASSES >= LCD_LATENCY_SENT_FLAG))
+    #error "LCD_LATENCY_CLASSES must be 1 - 127"
+#endif /* (LCD_LATENCY_CLASSES == 0u) || (LCD_LATENCY_CLASSES >= LCD_LATENCY_SENT_FLAG) */
+
+uint8_t LCD_latencyCell[LCD_ROWS][LCD_COLUMNS];
+
+/* Cycle counter when the pending value of a cell was written */
+static uint32_t LCD_latencyStamp[LCD_ROWS][LCD_COLUMNS];
+
+/* Class of the cells stamped next */
+static uint8_t LCD_latencyClass = LCD_LATENCY_ROUTINE;
+
+static LCD_LATENCY LCD_latency[LCD_LATENCY_CLASSES];
+
+static void LCD_LatencyAccount(uint8_t row, uint8_t column, uint32_t now) ;
+static uint8_t LCD_LatencyBucket(uint32_t us) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_LatencySetClass
+********************************************************************************
+*
+* Summary:
+*  Sets the priority class of the cells changed from now on.
+*
+* Parameters:
+*  priority: LCD_LATENCY_ROUTINE, LCD_LATENCY_ALARM, ... below
+*            LCD_LATENCY_CLASSES
+*
+* Return:
+*  The class in effect before, to put back afterwards.
+*
+*******************************************************************************/
+uint8_t LCD_LatencySetClass(uint8_t priority)
+{
+    uint8_t const previous = LCD_latencyClass;
+
+    if (priority < LCD_LATENCY_CLASSES)
+    {
+        LCD_latencyClass = priority;
+    }
+
+    return previous;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LatencyMark
+********************************************************************************
+*
+* Summary:
+*  Stamps cells of one row as changed now, e.g. a field when its value is
+*  taken, before it is drawn.
+*
+* Parameters:
+*  row:    Row of the framebuffer
+*  column: First cell
+*  length: Cells
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_LatencyMark(uint8_t row, uint8_t column, uint8_t length)
+{
+    uint8_t end;
+
+    if ((row >= LCD_ROWS) || (column >= LCD_COLUMNS))
+    {
+        return;
+    }
+
+    end = (length < (LCD_COLUMNS - column)) ? (uint8_t) (column + length) : LCD_COLUMNS;
+    for (; column < end; column++)
+    {
+        LCD_LatencyChange(row, column);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_GetLatency
+********************************************************************************
+*
+* Summary:
+*  Copies the histogram of a class and computes its mean and its 50th, 90th
+*  and 99th percentile.
+*
+* Parameters:
+*  priority: Class, below LCD_LATENCY_CLASSES
+*  latency:  Receives the histogram, all zero for an unknown class
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_GetLatency(uint8_t priority, LCD_LATENCY *latency)
+{
+    static const LCD_LATENCY LCD_latencyZero = { 0u };
+
+    if (priority >= LCD_LATENCY_CLASSES)
+    {
+        *latency = LCD_latencyZero;
+        return;
+    }
+
+    *latency = LCD_latency[priority];
+
+    latency->usAverage = (latency->samples != 0u) ?
+                         (uint32_t) (latency->usTotal / latency->samples) : 0u;
+    latency->us50 = LCD_LatencyPercentile(priority, 500u);
+    latency->us90 = LCD_LatencyPercentile(priority, 900u);
+    latency->us99 = LCD_LatencyPercentile(priority, 990u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LatencyPercentile
+********************************************************************************
+*
+* Summary:
+*  Returns the latency that a share of the samples of a class did not
+*  exceed: the upper bound of the bucket the share ends in, at most the
+*  longest sample.
+*
+* Parameters:
+*  priority: Class, below LCD_LATENCY_CLASSES
+*  permille: Share of the samples, 1 - 1000 (990 = 99th percentile)
+*
+* Return:
+*  Latency in us, 0 without samples.
+*
+*******************************************************************************/
+uint32_t LCD_LatencyPercentile(uint8_t priority, uint16_t permille)
+{
+    LCD_LATENCY const *latency;
+    uint32_t target;
+    uint32_t count = 0u;
+    uint32_t bound;
+    uint8_t bucket;
+
+    if ((priority >= LCD_LATENCY_CLASSES) || (LCD_latency[priority].samples == 0u))
+    {
+        return 0u;
+    }
+
+    latency = &LCD_latency[priority];
+    if (permille > 1000u)
+    {
+        permille = 1000u;
+    }
+
+    /* Samples at or below the percentile, rounded up */
+    target = (uint32_t) ((((uint64_t) latency->samples * permille) + 999u) / 1000u);
+
+    for (bucket = 0u; bucket < (LCD_LATENCY_BUCKETS - 1u); bucket++)
+    {
+        count += latency->buckets[bucket];
+        if ((count != 0u) && (count >= target))
+        {
+            bound = LCD_LatencyBucketUs(bucket + 1u) - 1u;
+            return (bound < latency->usMax) ? bound : latency->usMax;
+        }
+    }
+
+    return latency->usMax;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LatencyBucketUs
+********************************************************************************
+*
+* Summary:
+*  Returns the shortest latency a histogram bucket holds.
+*
+* Parameters:
+*  bucket: Index into LCD_LATENCY.buckets
+*
+* Return:
+*  Latency in us.
+*
+*******************************************************************************/
+uint32_t LCD_LatencyBucketUs(uint8_t bucket)
+{
+    uint8_t octave;
+
+    if (bucket < LCD_LATENCY_SUBBUCKETS)
+    {
+        return bucket;
+    }
+
+    /* Bucket 4 * (octave - 1) + step starts at (4 + step) * 2^(octave - 2) */
+    octave = (uint8_t) ((bucket / LCD_LATENCY_SUBBUCKETS) + 1u);
+    return (uint32_t) (LCD_LATENCY_SUBBUCKETS + (bucket % LCD_LATENCY_SUBBUCKETS)) << (octave - 2u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LatencyReset
+********************************************************************************
+*
+* Summary:
+*  Clears the histograms of every class; pending cells keep their stamps.
+*  Called by LCD_ResetStats().
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_LatencyReset(void)
+{
+    static const LCD_LATENCY LCD_latencyZero = { 0u };
+    uint8_t priority;
+
+    for (priority = 0u; priority < LCD_LATENCY_CLASSES; priority++)
+    {
+        LCD_latency[priority] = LCD_latencyZero;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LatencyChange
+********************************************************************************
+*
+* Summary:
+*  Stamps a cell that is about to differ from the glass, unless it is already
+*  waiting for a flush at the same or a higher class. Called through
+*  LCD_LATENCY_CHANGE().
+*
+* Parameters:
+*  row:    Row of the framebuffer, below LCD_ROWS
+*  column: Column of the framebuffer, below LCD_COLUMNS
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_LatencyChange(uint8_t row, uint8_t column)
+{
+    uint8_t const state = LCD_latencyCell[row][column];
+
+    if ((state == 0u) || (((state & LCD_LATENCY_SENT_FLAG) == 0u) && (state <= LCD_latencyClass)))
+    {
+        LCD_latencyStamp[row][column] = LCD_CYCLES();
+        LCD_latencyCell[row][column] = (uint8_t) (LCD_latencyClass + 1u);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LatencyFlushed
+********************************************************************************
+*
+* Summary:
+*  Accounts every cell the flush sent, from its stamp to now. Called through
+*  LCD_LATENCY_FLUSHED() after the last bus write of LCD_FlushFrame(), and
+*  from the DMA interrupt once a stream is out.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_LatencyFlushed(void)
+{
+    uint32_t const now = LCD_CYCLES();
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            if ((LCD_latencyCell[row][column] & LCD_LATENCY_SENT_FLAG) != 0u)
+            {
+                LCD_LatencyAccount(row, column, now);
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LatencyShown
+********************************************************************************
+*
+* Summary:
+*  Accounts a pending cell that was just written to the glass on its own.
+*  Called through LCD_LATENCY_SHOWN().
+*
+* Parameters:
+*  row:    Row of the framebuffer, below LCD_ROWS
+*  column: Column of the framebuffer, below LCD_COLUMNS
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_LatencyShown(uint8_t row, uint8_t column)
+{
+    LCD_LatencyAccount(row, column, LCD_CYCLES());
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LatencyAccount
+********************************************************************************
+*
+* Summary:
+*  Adds the time from the stamp of a pending cell to "now" to the histogram
+*  of its class and clears the cell.
+*
+*******************************************************************************/
+static void LCD_LatencyAccount(uint8_t row, uint8_t column, uint32_t now)
+{
+    uint32_t const cyclesPerUs = (LCD_cyclesPerUs != 0u) ? LCD_cyclesPerUs : 1u;
+    LCD_LATENCY *const latency = &LCD_latency[(LCD_latencyCell[row][column] & (uint8_t) ~LCD_LATENCY_SENT_FLAG) - 1u];
+    uint32_t const us = (uint32_t) (now - LCD_latencyStamp[row][column]) / cyclesPerUs;
+
+    LCD_latencyCell[row][column] = 0u;
+
+    if ((latency->samples == 0u) || (us < latency->usMin))
+    {
+        latency->usMin = us;
+    }
+    if (us > latency->usMax)
+    {
+        latency->usMax = us;
+    }
+    latency->samples++;
+    latency->usTotal += us;
+    latency->buckets[LCD_LatencyBucket(us)]++;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LatencyBucket
+********************************************************************************
+*
+* Summary:
+*  Returns the histogram bucket of a latency.
+*
+*******************************************************************************/
+static uint8_t LCD_LatencyBucket(uint32_t us)
+{
+    uint8_t octave = 2u;
+    uint32_t bucket;
+
+    if (us < LCD_LATENCY_SUBBUCKETS)
+    {
+        return (uint8_t) us;
+    }
+
+    /* Highest set bit, then the next two bits pick the step */
+    while ((us >> (octave + 1u)) != 0u)
+    {
+        octave++;
+    }
+    bucket = ((octave - 1u) * LCD_LATENCY_SUBBUCKETS) + ((us >> (octave - 2u)) & (LCD_LATENCY_SUBBUCKETS - 1u));
+
+    return (bucket < LCD_LATENCY_BUCKETS) ? (uint8_t) bucket : (uint8_t) (LCD_LATENCY_BUCKETS - 1u);
+}
+
+#endif /* LCD_USE_LATENCY != 0u */
@@ -0,0 +1,460 @@
+/*
+ *  LCD_List.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Display lists of the HD44780 LCD driver.
+ *
+ *  			Menu pages and status templates draw the same positions,
+ *  			labels and glyphs every time, with only a few values
+ *  			changing. A display list is that sequence recorded once as
+ *  			bytecode: an opcode byte and its arguments per operation,
+ *  			the text of labels inline. LCD_ListPlay() walks the bytes and
+ *  			takes the values of the number and string operations from a
+ *  			parameter array, so one list draws every instance of a page.
+ *  			With LCD_USE_FRAMEBUFFER the characters go straight into the
+ *  			framebuffer (the next flush sends the cells that changed),
+ *  			without it to the display through LCD_Position() and
+ *  			LCD_PrintStringN().
+ *
+ *  Usage:      - record at run time: LCD_ListBegin(&list, buffer, size),
+ *  				LCD_ListAt(), LCD_ListText(), LCD_ListNumber(), ...,
+ *  				then LCD_ListEnd() (0 if the buffer was too small)
+ *  			- or write the list as a const table in flash with the
+ *  				LCD_LIST_AT() ... LCD_LIST_END entries of LCD_List.h
+ *  			- LCD_ListPlay(list, params): params[slot].number for
+ *  				numbers (value * 10^decimals), params[slot].text for
+ *  				strings
+ *  			- glyph operations use LCD_GlyphAcquireId() with
+ *  				LCD_USE_GLYPH_CACHE, the low byte is the character code
+ *  				without it
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Format.h"
+#include "LCD_Frame.h"
+#include "LCD_Glyph.h"
+#include "LCD_List.h"
+
+#if (LCD_USE_DISPLAY_LIST != 0u)
+
+/* Longest inline text of one LCD_LIST_OP_TEXT */
+#define LCD_LIST_TEXT_MAX            (0xFFu)
+
+static void LCD_ListPut(LCD_LIST *list, uint8_t const bytes[], uint16_t count) ;
+static void LCD_ListPosition(uint8_t row, uint8_t column) ;
+static void LCD_ListWrite(char const text[], uint8_t count) ;
+static void LCD_ListRepeat(char character, uint8_t count) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_ListBegin
+********************************************************************************
+*
+* Summary:
+*  Starts recording a display list into a buffer.
+*
+* Parameters:
+*  list:   Recorder state
+*  buffer: Receives the bytecode, NULL (a failed LCD_ArenaAlloc()) records
+*          nothing and LCD_ListEnd() reports the overflow
+*  size:   Bytes of buffer
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ListBegin(LCD_LIST *list, uint8_t buffer[], uint16_t size)
+{
+    list->buffer = buffer;
+    list->size = (buffer != NULL) ? size : 0u;
+    list->length = 0u;
+    list->overflow = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListAt
+********************************************************************************
+*
+* Summary:
+*  Records a cursor position.
+*
+* Parameters:
+*  list:   Recorder state
+*  row:    Row
+*  column: Column
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ListAt(LCD_LIST *list, uint8_t row, uint8_t column)
+{
+    uint8_t const bytes[] = { LCD_LIST_AT(row, column) };
+
+    LCD_ListPut(list, bytes, sizeof(bytes));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListText
+********************************************************************************
+*
+* Summary:
+*  Records a constant text, copied into the list.
+*
+* Parameters:
+*  list: Recorder state
+*  text: Terminated string
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ListText(LCD_LIST *list, char const text[])
+{
+    uint8_t header[2u];
+    uint16_t length;
+
+    while (text[0] != '\0')
+    {
+        length = 0u;
+        while ((length < LCD_LIST_TEXT_MAX) && (text[length] != '\0'))
+        {
+            length++;
+        }
+
+        header[0] = LCD_LIST_OP_TEXT;
+        header[1] = (uint8_t) length;
+        LCD_ListPut(list, header, sizeof(header));
+        LCD_ListPut(list, (uint8_t const *) text, length);
+
+        text = &text[length];
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListNumber
+********************************************************************************
+*
+* Summary:
+*  Records a number taken from a parameter slot when played, right-justified
+*  and blank padded.
+*
+* Parameters:
+*  list:     Recorder state
+*  slot:     Index into the parameters of LCD_ListPlay()
+*  width:    Cells, at most LCD_FORMAT_FIELD_MAX
+*  decimals: Fraction digits of the value (0 - LCD_DECIMALS_MAX)
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ListNumber(LCD_LIST *list, uint8_t slot, uint8_t width, uint8_t decimals)
+{
+    uint8_t const bytes[] = { LCD_LIST_NUMBER(slot, width, decimals) };
+
+    LCD_ListPut(list, bytes, sizeof(bytes));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListString
+********************************************************************************
+*
+* Summary:
+*  Records a string taken from a parameter slot when played, left-justified,
+*  blank padded and clipped to its width.
+*
+* Parameters:
+*  list:  Recorder state
+*  slot:  Index into the parameters of LCD_ListPlay()
+*  width: Cells
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ListString(LCD_LIST *list, uint8_t slot, uint8_t width)
+{
+    uint8_t const bytes[] = { LCD_LIST_STRING(slot, width) };
+
+    LCD_ListPut(list, bytes, sizeof(bytes));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListGlyph
+********************************************************************************
+*
+* Summary:
+*  Records one custom glyph.
+*
+* Parameters:
+*  list:    Recorder state
+*  glyphId: ID in the table of LCD_GlyphSetTable(), or a character code
+*           without LCD_USE_GLYPH_CACHE
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ListGlyph(LCD_LIST *list, uint16_t glyphId)
+{
+    uint8_t const bytes[] = { LCD_LIST_GLYPH(glyphId) };
+
+    LCD_ListPut(list, bytes, sizeof(bytes));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListFill
+********************************************************************************
+*
+* Summary:
+*  Records a run of one character (rules, blanking part of a row).
+*
+* Parameters:
+*  list:      Recorder state
+*  character: Character
+*  count:     Cells
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ListFill(LCD_LIST *list, char character, uint8_t count)
+{
+    uint8_t const bytes[] = { LCD_LIST_FILL(character, count) };
+
+    LCD_ListPut(list, bytes, sizeof(bytes));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListEnd
+********************************************************************************
+*
+* Summary:
+*  Ends the list being recorded.
+*
+* Parameters:
+*  list: Recorder state
+*
+* Return:
+*  Bytes of the list, 0 if it did not fit into the buffer (the buffer then
+*  holds no playable list).
+*
+*******************************************************************************/
+uint16_t LCD_ListEnd(LCD_LIST *list)
+{
+    uint8_t const bytes[] = { LCD_LIST_END };
+
+    LCD_ListPut(list, bytes, sizeof(bytes));
+
+    if (list->overflow != 0u)
+    {
+        if (list->size != 0u)
+        {
+            list->buffer[0] = LCD_LIST_OP_END;
+        }
+        return 0u;
+    }
+
+    return list->length;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListPlay
+********************************************************************************
+*
+* Summary:
+*  Draws a display list, with the values of its number and string
+*  operations taken from a parameter array.
+*
+* Parameters:
+*  list:   Bytecode, recorded or a const table
+*  params: One entry per slot used by the list, NULL if it uses none
+*
+* Return:
+*  None.
+*
+* Note:
+*  An unknown opcode ends the list, like LCD_LIST_OP_END.
+*
+*******************************************************************************/
+void LCD_ListPlay(uint8_t const list[], LCD_LIST_PARAM const params[])
+{
+    char text[LCD_NUMBER_TEXT_MAX];
+    char const *string;
+    uint16_t index = 0u;
+    uint8_t width;
+    uint8_t count;
+    uint8_t code;
+
+    for (;;)
+    {
+        switch (list[index])
+        {
+            case LCD_LIST_OP_AT:
+                LCD_ListPosition(list[index + 1u], list[index + 2u]);
+                index += 3u;
+                break;
+
+            case LCD_LIST_OP_TEXT:
+                count = list[index + 1u];
+                LCD_ListWrite((char const *) &list[index + 2u], count);
+                index += 2u + count;
+                break;
+
+            case LCD_LIST_OP_NUMBER:
+                width = list[index + 2u];
+                count = LCD_FormatScaled(text, params[list[index + 1u]].number, list[index + 3u]);
+                if (count > width)
+                {
+                    LCD_ListRepeat(LCD_LIST_OVERFLOW, width);
+                }
+                else
+                {
+                    LCD_ListRepeat(' ', width - count);
+                    LCD_ListWrite(text, count);
+                }
+                index += 4u;
+                break;
+
+            case LCD_LIST_OP_STRING:
+                width = list[index + 2u];
+                string = params[list[index + 1u]].text;
+                count = 0u;
+                while ((count < width) && (string[count] != '\0'))
+                {
+                    count++;
+                }
+                LCD_ListWrite(string, count);
+                LCD_ListRepeat(' ', width - count);
+                index += 3u;
+                break;
+
+            case LCD_LIST_OP_GLYPH:
+                #if (LCD_USE_GLYPH_CACHE != 0u)
+                    code = LCD_GlyphAcquireId((uint16_t) (list[index + 1u] | ((uint16_t) list[index + 2u] << 8u)));
+                    if (code == LCD_GLYPH_NO_SLOT)
+                    {
+                        code = (uint8_t) LCD_GLYPH_FALLBACK;
+                    }
+                #else
+                    code = list[index + 1u];
+                #endif /* LCD_USE_GLYPH_CACHE != 0u */
+                LCD_ListWrite((char const *) &code, 1u);
+                index += 3u;
+                break;
+
+            case LCD_LIST_OP_FILL:
+                LCD_ListRepeat((char) list[index + 1u], list[index + 2u]);
+                index += 3u;
+                break;
+
+            default:
+                /* LCD_LIST_OP_END */
+                return;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListPut
+********************************************************************************
+*
+* Summary:
+*  Appends bytes to the list being recorded, or marks it overflowed.
+*
+*******************************************************************************/
+static void LCD_ListPut(LCD_LIST *list, uint8_t const bytes[], uint16_t count)
+{
+    uint16_t index;
+
+    if ((list->overflow != 0u) || (count > (uint16_t) (list->size - list->length)))
+    {
+        list->overflow = 1u;
+        return;
+    }
+
+    for (index = 0u; index < count; index++)
+    {
+        list->buffer[list->length + index] = bytes[index];
+    }
+    list->length += count;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListPosition
+********************************************************************************
+*
+* Summary:
+*  Moves the cursor of the framebuffer, or of the display.
+*
+*******************************************************************************/
+static void LCD_ListPosition(uint8_t row, uint8_t column)
+{
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        LCD_FramePosition(row, column);
+    #else
+        LCD_Position(row, column);
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListWrite
+********************************************************************************
+*
+* Summary:
+*  Writes characters at the cursor, into the framebuffer or to the display.
+*
+*******************************************************************************/
+static void LCD_ListWrite(char const text[], uint8_t count)
+{
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        uint8_t index;
+
+        for (index = 0u; index < count; index++)
+        {
+            LCD_FrameWriteChar((uint8_t) text[index]);
+        }
+    #else
+        LCD_PrintStringN(text, count);
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ListRepeat
+********************************************************************************
+*
+* Summary:
+*  Writes one character count times at the cursor.
+*
+*******************************************************************************/
+static void LCD_ListRepeat(char character, uint8_t count)
+{
+    uint8_t index;
+
+    for (index = 0u; index < count; index++)
+    {
+        #if (LCD_USE_FRAMEBUFFER != 0u)
+            LCD_FrameWriteChar((uint8_t) character);
+        #else
+            LCD_PutChar(character);
+        #endif /* LCD_USE_FRAMEBUFFER != 0u */
+    }
+}
+
+#endif /* LCD_USE_DISPLAY_LIST != 0u */
@@ -0,0 +1,365 @@
+/*
+ *  LCD_Lockstep.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Lockstep writes to two HD44780 modules on one GPIO port.
+ *
+ *  			The second display of a dual panel has its DB4-DB7 on the
+ *  			LCD_DB0_PIN - LCD_DB3_PIN port bits and shares E, RS and R/nW
+ *  			with the first. Every command and byte of the LCD_ API reaches
+ *  			both (LCD.c drives both nibbles from LCD_nibbleBsrr), so they
+ *  			are initialized, cleared and positioned together. The functions
+ *  			here put a different data byte on each nibble of the same BSRR
+ *  			store: two texts, or two whole frames, go out in the strobes and
+ *  			execution times of one.
+ *
+ *  Usage:      - LCD_Init() as usual, both modules answer the same sequence
+ *  			- LCD_LockstepPrintAt(0, 0, "Tank 1", "Tank 2"), the shorter
+ *  				text is padded with blanks
+ *  			- LCD_LockstepFlush(frameA, frameB) sends the runs where either
+ *  				frame changed since the last flush, one address command per
+ *  				run; LCD_LockstepInvalidate() after writing through the
+ *  				LCD_ API, which shows the same text on both
+ *  			- 4-bit parallel bus only; the busy flag reads as busy while
+ *  				either module is
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Timing.h"
+#include "LCD_Handle.h"
+#include "LCD_Transport.h"
+#include "LCD_Stats.h"
+#include "LCD_Lockstep.h"
+
+#if (LCD_USE_LOCKSTEP != 0u)
+
+#if (LCD_TRANSPORT_HAS_GPIO == 0u)
+    #error "LCD_USE_LOCKSTEP drives the parallel bus (LCD_TRANSPORT_GPIO or _RUNTIME)"
+#endif /* LCD_TRANSPORT_HAS_GPIO == 0u */
+
+#if (LCD_USE_PIN_MAP != 0u)
+    #error "LCD_USE_LOCKSTEP needs both nibbles on DB4_GPIO_Port, not LCD_USE_PIN_MAP"
+#endif /* LCD_USE_PIN_MAP != 0u */
+
+/* Glass value of a cell whose contents are not known */
+#define LCD_LOCK_UNKNOWN             (0x100u)
+
+/* BSRR words of the data nibble of each display */
+static const uint32_t LCD_lockFirst[16u] =
+{
+    LCD_NIBBLE_BSRR(0u),  LCD_NIBBLE_BSRR(1u),  LCD_NIBBLE_BSRR(2u),  LCD_NIBBLE_BSRR(3u),
+    LCD_NIBBLE_BSRR(4u),  LCD_NIBBLE_BSRR(5u),  LCD_NIBBLE_BSRR(6u),  LCD_NIBBLE_BSRR(7u),
+    LCD_NIBBLE_BSRR(8u),  LCD_NIBBLE_BSRR(9u),  LCD_NIBBLE_BSRR(10u), LCD_NIBBLE_BSRR(11u),
+    LCD_NIBBLE_BSRR(12u), LCD_NIBBLE_BSRR(13u), LCD_NIBBLE_BSRR(14u), LCD_NIBBLE_BSRR(15u)
+};
+
+static const uint32_t LCD_lockSecond[16u] =
+{
+    LCD_LOW_NIBBLE_BSRR(0u),  LCD_LOW_NIBBLE_BSRR(1u),  LCD_LOW_NIBBLE_BSRR(2u),  LCD_LOW_NIBBLE_BSRR(3u),
+    LCD_LOW_NIBBLE_BSRR(4u),  LCD_LOW_NIBBLE_BSRR(5u),  LCD_LOW_NIBBLE_BSRR(6u),  LCD_LOW_NIBBLE_BSRR(7u),
+    LCD_LOW_NIBBLE_BSRR(8u),  LCD_LOW_NIBBLE_BSRR(9u),  LCD_LOW_NIBBLE_BSRR(10u), LCD_LOW_NIBBLE_BSRR(11u),
+    LCD_LOW_NIBBLE_BSRR(12u), LCD_LOW_NIBBLE_BSRR(13u), LCD_LOW_NIBBLE_BSRR(14u), LCD_LOW_NIBBLE_BSRR(15u)
+};
+
+/* What each display shows, as of the last LCD_LockstepFlush() */
+static uint16_t LCD_lockGlass[2u][LCD_ROWS][LCD_COLUMNS];
+static uint8_t LCD_lockGlassValid = 0u;
+
+static void LCD_LockstepBegin(void) ;
+static void LCD_LockstepPair(uint8_t first, uint8_t second) ;
+static void LCD_LockstepEnd(void) ;
+static void LCD_LockstepStrobe(uint32_t bsrr) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_LockstepWrite
+********************************************************************************
+*
+* Summary:
+*  Writes first[] to the first display and second[] to the second one, a
+*  byte of each per strobe, at the address counter both share.
+*
+* Parameters:
+*  first:  Bytes for the display on DB4-DB7
+*  second: Bytes for the display on LCD_DB0_PIN - LCD_DB3_PIN
+*  length: Number of bytes of each
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_LockstepWrite(uint8_t const first[], uint8_t const second[], size_t length)
+{
+    size_t index;
+
+    if (length == 0u)
+    {
+        return;
+    }
+
+    LCD_lockGlassValid = 0u;
+
+    LCD_LockstepBegin();
+    for (index = 0u; index < length; index++)
+    {
+        LCD_LockstepPair(first[index], second[index]);
+    }
+    LCD_LockstepEnd();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LockstepPrintAt
+********************************************************************************
+*
+* Summary:
+*  Prints one text on each display from the same position. The shorter text
+*  is padded with blanks, both are clipped at the end of the row.
+*
+* Parameters:
+*  row:    Row of both displays
+*  column: Column of both displays
+*  first:  Text of the first display
+*  second: Text of the second display
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_LockstepPrintAt(uint8_t row, uint8_t column, char const first[], char const second[])
+{
+    uint8_t const columns = LCD_active->geometry->columns;
+    size_t firstIndex = 0u;
+    size_t secondIndex = 0u;
+    uint8_t a;
+    uint8_t b;
+
+    if ((row >= LCD_active->geometry->rows) || (column >= columns))
+    {
+        return;
+    }
+
+    LCD_lockGlassValid = 0u;
+
+    LCD_WritePosition(row, column);
+    LCD_LockstepBegin();
+
+    while ((column < columns) && ((first[firstIndex] != '\0') || (second[secondIndex] != '\0')))
+    {
+        if (column == LCD_active->geometry->split)
+        {
+            /* Second DDRAM run of a split row */
+            LCD_LockstepEnd();
+            LCD_WritePosition(row, column);
+            LCD_LockstepBegin();
+        }
+
+        a = (uint8_t) ' ';
+        if (first[firstIndex] != '\0')
+        {
+            a = (uint8_t) first[firstIndex];
+            firstIndex++;
+        }
+        b = (uint8_t) ' ';
+        if (second[secondIndex] != '\0')
+        {
+            b = (uint8_t) second[secondIndex];
+            secondIndex++;
+        }
+
+        LCD_LockstepPair(a, b);
+        column++;
+    }
+
+    LCD_LockstepEnd();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LockstepFlush
+********************************************************************************
+*
+* Summary:
+*  Brings both displays up to date with a frame each: the runs of cells where
+*  either frame differs from what its display shows are written, with one
+*  set-DDRAM-address command per run for both.
+*
+* Parameters:
+*  first:  Frame of the first display
+*  second: Frame of the second display
+*
+* Return:
+*  None.
+*
+* Note:
+*  The first flush, and the first one after LCD_LockstepInvalidate(),
+*  writes every cell.
+*
+*******************************************************************************/
+void LCD_LockstepFlush(uint8_t const first[LCD_ROWS][LCD_COLUMNS],
+                       uint8_t const second[LCD_ROWS][LCD_COLUMNS])
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_active->geometry;
+    uint8_t row;
+    uint8_t column;
+    uint8_t runStart;
+    uint8_t runLimit;
+
+    if (LCD_lockGlassValid == 0u)
+    {
+        for (row = 0u; row < LCD_ROWS; row++)
+        {
+            for (column = 0u; column < LCD_COLUMNS; column++)
+            {
+                LCD_lockGlass[0u][row][column] = LCD_LOCK_UNKNOWN;
+                LCD_lockGlass[1u][row][column] = LCD_LOCK_UNKNOWN;
+            }
+        }
+        LCD_lockGlassValid = 1u;
+    }
+
+    for (row = 0u; (row < geometry->rows) && (row < LCD_ROWS); row++)
+    {
+        column = 0u;
+        while ((column < geometry->columns) && (column < LCD_COLUMNS))
+        {
+            if ((LCD_lockGlass[0u][row][column] == (uint16_t) first[row][column]) &&
+                (LCD_lockGlass[1u][row][column] == (uint16_t) second[row][column]))
+            {
+                column++;
+            }
+            else
+            {
+                /* Run of cells changed on either display, within the DDRAM run */
+                runStart = column;
+                runLimit = (column < geometry->split) ? geometry->split : geometry->columns;
+                runLimit = (runLimit < LCD_COLUMNS) ? runLimit : LCD_COLUMNS;
+                while ((column < runLimit) &&
+                       ((LCD_lockGlass[0u][row][column] != (uint16_t) first[row][column]) ||
+                        (LCD_lockGlass[1u][row][column] != (uint16_t) second[row][column])))
+                {
+                    column++;
+                }
+
+                LCD_WritePosition(row, runStart);
+                LCD_LockstepBegin();
+                for (; runStart < column; runStart++)
+                {
+                    LCD_LockstepPair(first[row][runStart], second[row][runStart]);
+                    LCD_lockGlass[0u][row][runStart] = first[row][runStart];
+                    LCD_lockGlass[1u][row][runStart] = second[row][runStart];
+                }
+                LCD_LockstepEnd();
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LockstepInvalidate
+********************************************************************************
+*
+* Summary:
+*  Forgets what the displays show, so the next LCD_LockstepFlush() writes
+*  every cell. Call after LCD_Init() or writes through the LCD_ API.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_LockstepInvalidate(void)
+{
+    LCD_lockGlassValid = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LockstepBegin
+********************************************************************************
+*
+* Summary:
+*  Waits for both modules and selects data writes (RS high, R/nW low) for a
+*  run of byte pairs.
+*
+*******************************************************************************/
+static void LCD_LockstepBegin(void)
+{
+    if (LCD_TimingExpired() == 0u)
+    {
+        (void) LCD_IsReady();
+    }
+
+    WRITE_REG(RS_GPIO_Port->BSRR, LCD_BSRR_SET(LCD_PIN_BITS(RS_Pin)));
+    WRITE_REG(RnW_GPIO_Port->BSRR, LCD_BSRR_RESET(LCD_PIN_BITS(RnW_Pin)));
+
+    /* tAS once, RS and R/nW stay put for the whole run */
+    LCD_DelaySetup();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LockstepPair
+********************************************************************************
+*
+* Summary:
+*  Writes one byte to each display, high nibbles then low nibbles, spaced
+*  from the previous pair by the data execution time.
+*
+*******************************************************************************/
+static void LCD_LockstepPair(uint8_t first, uint8_t second)
+{
+    while (LCD_TimingExpired() == 0u)
+    {
+    }
+
+    LCD_LockstepStrobe(LCD_lockFirst[first >> LCD_NIBBLE_SHIFT] | LCD_lockSecond[second >> LCD_NIBBLE_SHIFT]);
+    LCD_LockstepStrobe(LCD_lockFirst[first & LCD_NIBBLE_MASK] | LCD_lockSecond[second & LCD_NIBBLE_MASK]);
+    LCD_TimingMark(0u);
+
+    LCD_STAT_INC(bytesWritten);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LockstepEnd
+********************************************************************************
+*
+* Summary:
+*  Ends a run: RS was driven and the address counter moved behind LCD.c.
+*
+*******************************************************************************/
+static void LCD_LockstepEnd(void)
+{
+    LCD_BusInvalidate();
+    LCD_CursorInvalidate();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_LockstepStrobe
+********************************************************************************
+*
+* Summary:
+*  Drives both data nibbles in one store and latches them with one E pulse;
+*  the data lines only need tDSW, covered by PWEH.
+*
+*******************************************************************************/
+static void LCD_LockstepStrobe(uint32_t bsrr)
+{
+    WRITE_REG(DB4_GPIO_Port->BSRR, bsrr);
+
+    WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_SET(LCD_E_BITS));
+    LCD_DelayPulse();
+
+    WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_RESET(LCD_E_BITS));
+    LCD_DelayRecover();
+}
+
+#endif /* LCD_USE_LOCKSTEP != 0u */
@@ -0,0 +1,244 @@
+/*
+ *  LCD_Marquee.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Hardware-shift scrolling ticker for the HD44780 LCD driver.
+ *
+ *  			The message is loaded into the 40-character DDRAM line once.
+ *  			Each step is then a single display-shift-left command; DDRAM is
+ *  			circular, so the text wraps by itself. Messages longer than the
+ *  			line are handled by rewriting only the one DDRAM column that just
+ *  			scrolled out of view with the next message character. A step
+ *  			costs 1 - 3 bus transactions instead of rewriting every visible
+ *  			character.
+ *
+ *  Usage:      - call LCD_MarqueeTask() from the main loop, steps are paced on
+ *  				HAL_GetTick()
+ *  			- the display shift moves every row: the other rows scroll with
+ *  				the marquee (or hold text that repeats every 40 columns)
+ *  			- the message must stay valid while the marquee runs
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Latency.h"
+#include "LCD_Marquee.h"
+
+#if (LCD_USE_MARQUEE != 0u)
+
+static char const *LCD_marqueeText = NULL;
+static size_t LCD_marqueeLength = 0u;
+
+/* Message plus gap, or the DDRAM line length for short messages */
+static size_t LCD_marqueeLoop = 0u;
+
+/* Message index at the left edge of the window, and the DDRAM column there */
+static size_t LCD_marqueeIndex = 0u;
+static uint8_t LCD_marqueeColumn = 0u;
+
+static uint8_t LCD_marqueeRow = 0u;
+static uint32_t LCD_marqueePeriod = 0u;
+static uint32_t LCD_marqueeTick = 0u;
+static uint8_t LCD_marqueeRunning = 0u;
+
+static char LCD_MarqueeChar(size_t index) ;
+static void LCD_MarqueeCell(uint8_t column, char character) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_MarqueeStart
+********************************************************************************
+*
+* Summary:
+*  Loads the message into the DDRAM line of "row" and starts scrolling it left
+*  by one column every "periodMs".
+*
+* Parameters:
+*  row:      Row of the ticker, 0 or 1 (the two 40-character DDRAM lines)
+*  message:  Zero terminated text, any length
+*  periodMs: Step period in milliseconds
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_MarqueeStart(uint8_t row, char const message[], uint32_t periodMs)
+{
+    uint8_t column;
+
+    if (row > 1u)
+    {
+        return;
+    }
+
+    LCD_marqueeText = message;
+    LCD_marqueeLength = 0u;
+    while (message[LCD_marqueeLength] != '\0')
+    {
+        LCD_marqueeLength++;
+    }
+
+    LCD_marqueeLoop = LCD_marqueeLength + LCD_MARQUEE_GAP;
+    if (LCD_marqueeLoop < LCD_DDRAM_LINE_LENGTH)
+    {
+        /* Short text rotates with the DDRAM line, no refills */
+        LCD_marqueeLoop = LCD_DDRAM_LINE_LENGTH;
+    }
+
+    LCD_marqueeRow = row;
+    LCD_marqueePeriod = periodMs;
+    LCD_marqueeIndex = 0u;
+    LCD_marqueeColumn = 0u;
+
+    /* Return home also undoes any earlier display shift */
+    LCD_WriteControl(LCD_CURSOR_HOME);
+
+    LCD_WritePosition(row, 0u);
+    for (column = 0u; column < LCD_DDRAM_LINE_LENGTH; column++)
+    {
+        LCD_MarqueeCell(column, LCD_MarqueeChar(column));
+    }
+
+    LCD_marqueeTick = HAL_GetTick();
+    LCD_marqueeRunning = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MarqueeTask
+********************************************************************************
+*
+* Summary:
+*  Advances the ticker by one column when the step period elapsed.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_MarqueeTask(void)
+{
+    size_t refill;
+    uint8_t column;
+
+    if ((LCD_marqueeRunning == 0u) || ((HAL_GetTick() - LCD_marqueeTick) < LCD_marqueePeriod))
+    {
+        return;
+    }
+    LCD_marqueeTick += LCD_marqueePeriod;
+
+    LCD_WriteControl(LCD_DISPLAY_SCRL_LEFT);
+
+    /* The column that left the window comes back 40 characters later */
+    column = LCD_marqueeColumn;
+    refill = LCD_marqueeIndex + LCD_DDRAM_LINE_LENGTH;
+    if (refill >= LCD_marqueeLoop)
+    {
+        refill -= LCD_marqueeLoop;
+    }
+
+    if (LCD_marqueeLoop != LCD_DDRAM_LINE_LENGTH)
+    {
+        LCD_WritePosition(LCD_marqueeRow, column);
+        LCD_MarqueeCell(column, LCD_MarqueeChar(refill));
+    }
+
+    LCD_marqueeIndex++;
+    if (LCD_marqueeIndex >= LCD_marqueeLoop)
+    {
+        LCD_marqueeIndex = 0u;
+    }
+    LCD_marqueeColumn = (uint8_t) ((column + 1u) % LCD_DDRAM_LINE_LENGTH);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MarqueeStop
+********************************************************************************
+*
+* Summary:
+*  Stops the ticker and undoes the display shift (return home).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_MarqueeStop(void)
+{
+    if (LCD_marqueeRunning != 0u)
+    {
+        LCD_marqueeRunning = 0u;
+        LCD_WriteControl(LCD_CURSOR_HOME);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MarqueeIsRunning
+********************************************************************************
+*
+* Summary:
+*  Reports whether the ticker is scrolling.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 while running.
+*
+*******************************************************************************/
+uint8_t LCD_MarqueeIsRunning(void)
+{
+    return LCD_marqueeRunning;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MarqueeChar
+********************************************************************************
+*
+* Summary:
+*  Returns the character at "index" of the loop (message followed by blanks).
+*
+*******************************************************************************/
+static char LCD_MarqueeChar(size_t index)
+{
+    return (index < LCD_marqueeLength) ? LCD_marqueeText[index] : ' ';
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MarqueeCell
+********************************************************************************
+*
+* Summary:
+*  Writes one character at the current DDRAM address. The framebuffer and the
+*  glass copy of the cell are updated too, so LCD_FlushFrame() does not
+*  overwrite the ticker.
+*
+*******************************************************************************/
+static void LCD_MarqueeCell(uint8_t column, char character)
+{
+    LCD_WriteData((uint8_t) character);
+
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        if ((LCD_marqueeRow < LCD_ROWS) && (column < LCD_COLUMNS))
+        {
+            LCD_frame[LCD_marqueeRow][column] = (uint8_t) character;
+            LCD_glass[LCD_marqueeRow][column] = (uint8_t) character;
+            LCD_LATENCY_SHOWN(LCD_marqueeRow, column);
+        }
+    #else
+        (void) column;
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+}
+
+#endif /* LCD_USE_MARQUEE != 0u */
@@ -0,0 +1,501 @@
+/*
+ *  LCD_Menu.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Table-driven operator menus for the HD44780 LCD driver.
+ *
+ *  			A menu is a const table of LCD_MENU_ITEM rows: actions,
+ *  			submenus, value editors and back entries. The engine keeps the
+ *  			menu stack, the selected item and the first item on screen,
+ *  			and paints into the framebuffer only the cells a key changes:
+ *  			a selection move inside the visible rows rewrites the marker
+ *  			cell of the old and of the new row, a value step only the
+ *  			value cells, entering or leaving an edit one marker cell. Only
+ *  			scrolling and opening a menu paint the rows, and even then the
+ *  			framebuffer diff sends just the cells whose text changed, so
+ *  			navigation stays instant on the I2C transport.
+ *
+ *  Usage:      - static LCD_MENU_ITEM const setupItems[] = {
+ *  				LCD_MENU_VALUE_ITEM("Setpoint", &setpoint, 0, 1000, 5, 1u,
+ *  				NULL), LCD_MENU_BACK_ITEM("Back") };
+ *  			- LCD_MenuStart(&mainMenu, 0u, 2u), then LCD_MenuInput() per
+ *  				key (keypad events mapped to LCD_MENU_KEY_) and the usual
+ *  				flush
+ *  			- LCD_MenuRefresh() after values changed behind the menu
+ *  			- column 0 holds the marker, values the last
+ *  				LCD_MENU_VALUE_WIDTH columns; labels are clipped
+ *  			- needs LCD_USE_FRAMEBUFFER
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Latency.h"
+#include "LCD_Format.h"
+#include "LCD_Handle.h"
+#include "LCD_Menu.h"
+
+#if (LCD_USE_MENU != 0u)
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    #error "LCD_USE_MENU paints into the framebuffer (LCD_USE_FRAMEBUFFER)"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+#if (LCD_MENU_VALUE_WIDTH > LCD_NUMBER_TEXT_MAX)
+    #error "LCD_MENU_VALUE_WIDTH is wider than a formatted number (LCD_NUMBER_TEXT_MAX)"
+#endif /* LCD_MENU_VALUE_WIDTH > LCD_NUMBER_TEXT_MAX */
+
+/* Open menus, [0] is the one given to LCD_MenuStart() */
+static LCD_MENU const *LCD_menuStack[LCD_MENU_DEPTH];
+static uint8_t LCD_menuSelectedAt[LCD_MENU_DEPTH];
+static uint8_t LCD_menuDepth = 0u;
+
+/* Screen rows of the menu, item shown on the first one */
+static uint8_t LCD_menuRow;
+static uint8_t LCD_menuRows = 0u;
+static uint8_t LCD_menuTop;
+
+/* Selected item of the open menu, 1 while its value is edited */
+static uint8_t LCD_menuSelected;
+static uint8_t LCD_menuEditing = 0u;
+
+static void LCD_MenuOpen(LCD_MENU const *menu, uint8_t selected) ;
+static void LCD_MenuMove(uint8_t selected) ;
+static void LCD_MenuPaintRows(void) ;
+static void LCD_MenuPaintMarker(uint8_t item) ;
+static void LCD_MenuPaintValue(uint8_t item) ;
+static void LCD_MenuPut(uint8_t item, uint8_t column, uint8_t character) ;
+static void LCD_MenuStep(int32_t direction) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_MenuStart
+********************************************************************************
+*
+* Summary:
+*  Opens a top level menu on some screen rows with its first item selected.
+*
+* Parameters:
+*  menu: Menu, must stay valid while shown
+*  row:  First screen row of the menu
+*  rows: Screen rows it uses, clipped to the geometry
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_MenuStart(LCD_MENU const *menu, uint8_t row, uint8_t rows)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+
+    if ((menu == NULL) || (row >= geometry->rows))
+    {
+        return;
+    }
+
+    LCD_menuRow = row;
+    LCD_menuRows = ((row + rows) > geometry->rows) ? (uint8_t) (geometry->rows - row) : rows;
+    LCD_menuDepth = 0u;
+    LCD_MenuOpen(menu, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MenuInput
+********************************************************************************
+*
+* Summary:
+*  Handles one key: moves the selection, opens and leaves menus, calls
+*  actions and edits values.
+*
+* Parameters:
+*  key: LCD_MENU_KEY_ value
+*
+* Return:
+*  None.
+*
+* Note:
+*  UP and DOWN stop at the first and last item. While a value is edited
+*  they step it, ENTER or BACK end the edit and call the item's action.
+*
+*******************************************************************************/
+void LCD_MenuInput(uint8_t key)
+{
+    LCD_MENU const *menu;
+    LCD_MENU_ITEM const *item;
+
+    if (LCD_menuDepth == 0u)
+    {
+        return;
+    }
+
+    menu = LCD_menuStack[LCD_menuDepth - 1u];
+    item = &menu->items[LCD_menuSelected];
+
+    if (LCD_menuEditing != 0u)
+    {
+        if (key == LCD_MENU_KEY_UP)
+        {
+            LCD_MenuStep(1);
+        }
+        else if (key == LCD_MENU_KEY_DOWN)
+        {
+            LCD_MenuStep(-1);
+        }
+        else
+        {
+            LCD_menuEditing = 0u;
+            LCD_MenuPaintMarker(LCD_menuSelected);
+            if (item->action != NULL)
+            {
+                item->action();
+            }
+        }
+        return;
+    }
+
+    switch (key)
+    {
+        case LCD_MENU_KEY_UP:
+            if (LCD_menuSelected > 0u)
+            {
+                LCD_MenuMove((uint8_t) (LCD_menuSelected - 1u));
+            }
+            break;
+        case LCD_MENU_KEY_DOWN:
+            if ((LCD_menuSelected + 1u) < menu->count)
+            {
+                LCD_MenuMove((uint8_t) (LCD_menuSelected + 1u));
+            }
+            break;
+        case LCD_MENU_KEY_ENTER:
+            if (item->kind == LCD_MENU_ACTION)
+            {
+                if (item->action != NULL)
+                {
+                    item->action();
+                }
+            }
+            else if ((item->kind == LCD_MENU_SUBMENU) && (item->submenu != NULL) &&
+                     (LCD_menuDepth < LCD_MENU_DEPTH))
+            {
+                LCD_menuSelectedAt[LCD_menuDepth - 1u] = LCD_menuSelected;
+                LCD_MenuOpen(item->submenu, 0u);
+            }
+            else if ((item->kind == LCD_MENU_VALUE) && (item->value != NULL))
+            {
+                LCD_menuEditing = 1u;
+                LCD_MenuPaintMarker(LCD_menuSelected);
+            }
+            else if ((item->kind == LCD_MENU_BACK) && (LCD_menuDepth > 1u))
+            {
+                LCD_menuDepth -= 2u;
+                LCD_MenuOpen(LCD_menuStack[LCD_menuDepth], LCD_menuSelectedAt[LCD_menuDepth]);
+            }
+            else
+            {
+            }
+            break;
+        case LCD_MENU_KEY_BACK:
+            if (LCD_menuDepth > 1u)
+            {
+                LCD_menuDepth -= 2u;
+                LCD_MenuOpen(LCD_menuStack[LCD_menuDepth], LCD_menuSelectedAt[LCD_menuDepth]);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MenuRefresh
+********************************************************************************
+*
+* Summary:
+*  Paints the values of the visible items again, after the application
+*  changed them. Only value cells whose text changed are touched.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_MenuRefresh(void)
+{
+    LCD_MENU const *menu;
+    uint8_t item;
+
+    if (LCD_menuDepth == 0u)
+    {
+        return;
+    }
+
+    menu = LCD_menuStack[LCD_menuDepth - 1u];
+    for (item = LCD_menuTop; (item < menu->count) && (item < (LCD_menuTop + LCD_menuRows)); item++)
+    {
+        LCD_MenuPaintValue(item);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MenuSelected
+********************************************************************************
+*
+* Summary:
+*  Returns the selected item of the open menu.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Item, NULL before LCD_MenuStart().
+*
+*******************************************************************************/
+LCD_MENU_ITEM const *LCD_MenuSelected(void)
+{
+    if (LCD_menuDepth == 0u)
+    {
+        return NULL;
+    }
+
+    return &LCD_menuStack[LCD_menuDepth - 1u]->items[LCD_menuSelected];
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MenuOpen
+********************************************************************************
+*
+* Summary:
+*  Pushes a menu with an item selected and paints its rows.
+*
+*******************************************************************************/
+static void LCD_MenuOpen(LCD_MENU const *menu, uint8_t selected)
+{
+    LCD_menuStack[LCD_menuDepth] = menu;
+    LCD_menuDepth++;
+    LCD_menuEditing = 0u;
+    LCD_menuSelected = (selected < menu->count) ? selected : 0u;
+    LCD_menuTop = (LCD_menuSelected >= LCD_menuRows) ? (uint8_t) (LCD_menuSelected + 1u - LCD_menuRows) : 0u;
+    LCD_MenuPaintRows();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MenuMove
+********************************************************************************
+*
+* Summary:
+*  Selects another item: two marker cells while it is on screen, the rows
+*  scrolled to it otherwise.
+*
+*******************************************************************************/
+static void LCD_MenuMove(uint8_t selected)
+{
+    uint8_t const previous = LCD_menuSelected;
+
+    LCD_menuSelected = selected;
+
+    if (selected < LCD_menuTop)
+    {
+        LCD_menuTop = selected;
+        LCD_MenuPaintRows();
+    }
+    else if (selected >= (LCD_menuTop + LCD_menuRows))
+    {
+        LCD_menuTop = (uint8_t) (selected + 1u - LCD_menuRows);
+        LCD_MenuPaintRows();
+    }
+    else
+    {
+        LCD_MenuPaintMarker(previous);
+        LCD_MenuPaintMarker(selected);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MenuPaintRows
+********************************************************************************
+*
+* Summary:
+*  Paints every menu row: marker, label, value or submenu sign, blanks
+*  below the last item.
+*
+*******************************************************************************/
+static void LCD_MenuPaintRows(void)
+{
+    LCD_MENU const *menu = LCD_menuStack[LCD_menuDepth - 1u];
+    uint8_t const columns = LCD_display0.geometry->columns;
+    LCD_MENU_ITEM const *entry;
+    uint8_t labelEnd;
+    uint8_t item;
+    uint8_t column;
+    uint8_t index;
+
+    for (item = LCD_menuTop; item < (LCD_menuTop + LCD_menuRows); item++)
+    {
+        if (item >= menu->count)
+        {
+            for (column = 0u; column < columns; column++)
+            {
+                LCD_MenuPut(item, column, LCD_FRAME_BLANK);
+            }
+            continue;
+        }
+
+        entry = &menu->items[item];
+        LCD_MenuPaintMarker(item);
+
+        labelEnd = columns;
+        if (entry->kind == LCD_MENU_VALUE)
+        {
+            labelEnd = (columns > LCD_MENU_VALUE_WIDTH) ? (uint8_t) (columns - LCD_MENU_VALUE_WIDTH) : 1u;
+        }
+        else if (entry->kind == LCD_MENU_SUBMENU)
+        {
+            labelEnd = (uint8_t) (columns - 1u);
+            LCD_MenuPut(item, labelEnd, LCD_MENU_MORE);
+        }
+        else
+        {
+        }
+
+        index = 0u;
+        for (column = 1u; column < labelEnd; column++)
+        {
+            if ((entry->label != NULL) && (entry->label[index] != '\0'))
+            {
+                LCD_MenuPut(item, column, (uint8_t) entry->label[index]);
+                index++;
+            }
+            else
+            {
+                LCD_MenuPut(item, column, LCD_FRAME_BLANK);
+            }
+        }
+
+        LCD_MenuPaintValue(item);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MenuPaintMarker
+********************************************************************************
+*
+* Summary:
+*  Paints column 0 of an item: the selection or edit mark, or a blank.
+*
+*******************************************************************************/
+static void LCD_MenuPaintMarker(uint8_t item)
+{
+    uint8_t mark = LCD_FRAME_BLANK;
+
+    if (item == LCD_menuSelected)
+    {
+        mark = (LCD_menuEditing != 0u) ? LCD_MENU_EDIT_MARK : LCD_MENU_MARK;
+    }
+
+    LCD_MenuPut(item, 0u, mark);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MenuPaintValue
+********************************************************************************
+*
+* Summary:
+*  Paints the value of a value item right-justified in its cells, '*' in
+*  every cell when it does not fit.
+*
+*******************************************************************************/
+static void LCD_MenuPaintValue(uint8_t item)
+{
+    LCD_MENU_ITEM const *entry = &LCD_menuStack[LCD_menuDepth - 1u]->items[item];
+    uint8_t const columns = LCD_display0.geometry->columns;
+    char text[LCD_NUMBER_TEXT_MAX];
+    uint8_t width = (columns > LCD_MENU_VALUE_WIDTH) ? LCD_MENU_VALUE_WIDTH : (uint8_t) (columns - 1u);
+    uint8_t length;
+    uint8_t cell;
+
+    if ((entry->kind != LCD_MENU_VALUE) || (entry->value == NULL))
+    {
+        return;
+    }
+
+    length = LCD_FormatScaled(text, *entry->value, entry->decimals);
+
+    for (cell = 0u; cell < width; cell++)
+    {
+        if (length > width)
+        {
+            LCD_MenuPut(item, (uint8_t) (columns - width + cell), '*');
+        }
+        else
+        {
+            LCD_MenuPut(item, (uint8_t) (columns - width + cell),
+                        (cell < (width - length)) ? LCD_FRAME_BLANK : (uint8_t) text[cell - (width - length)]);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MenuPut
+********************************************************************************
+*
+* Summary:
+*  Stores a character in the framebuffer row of an item if it differs.
+*
+*******************************************************************************/
+static void LCD_MenuPut(uint8_t item, uint8_t column, uint8_t character)
+{
+    uint8_t const row = (uint8_t) (LCD_menuRow + (item - LCD_menuTop));
+
+    if ((row < LCD_ROWS) && (column < LCD_COLUMNS) && (LCD_frame[row][column] != character))
+    {
+        LCD_LATENCY_CHANGE(row, column, character);
+        LCD_frame[row][column] = character;
+        LCD_frameDirty = 1u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MenuStep
+********************************************************************************
+*
+* Summary:
+*  Steps the edited value up or down, clipped to its range.
+*
+*******************************************************************************/
+static void LCD_MenuStep(int32_t direction)
+{
+    LCD_MENU_ITEM const *entry = &LCD_menuStack[LCD_menuDepth - 1u]->items[LCD_menuSelected];
+    int32_t value = *entry->value;
+
+    if (direction > 0)
+    {
+        value = ((entry->max - value) < entry->step) ? entry->max : (value + entry->step);
+    }
+    else
+    {
+        value = ((value - entry->min) < entry->step) ? entry->min : (value - entry->step);
+    }
+
+    if (value != *entry->value)
+    {
+        *entry->value = value;
+        LCD_MenuPaintValue(LCD_menuSelected);
+    }
+}
+
+#endif /* LCD_USE_MENU != 0u */
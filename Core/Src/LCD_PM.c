@@ -0,0 +1,252 @@
+/*
+ *  LCD_PM.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Power management of the HD44780 LCD driver.
+ *
+ *  			LCD.c mirrors every function set, entry mode and display
+ *  			control command into the display state, LCD_Glyph.c keeps a
+ *  			copy of each CGRAM slot it uploads and the framebuffer holds
+ *  			the characters. LCD_Sleep()/LCD_Wakeup() work from these copies
+ *  			instead of reading the controller back or running LCD_Init()
+ *  			(70 ms of tick waits plus clear display):
+ *
+ *  			- supply kept (LCD_PM_POWER_GATED 0): the controller loses
+ *  				nothing, wakeup is one display control command
+ *  			- supply switched off (LCD_PM_POWER_GATED 1): wakeup waits the
+ *  				power-on reset, runs the interface handshake with datasheet
+ *  				waits and writes back modes, the used CGRAM slots and the
+ *  				frame; no clear display, no settle delays
+ *
+ *  Usage:      - LCD_Sleep() before the module supply is switched off,
+ *  				LCD_Wakeup() right after it is switched on again
+ *  			- DDRAM contents survive gating only with LCD_USE_FRAMEBUFFER,
+ *  				otherwise the application redraws after LCD_Wakeup()
+ *  			- commands sent by the DMA/interrupt transports bypass the
+ *  				mirror; the queues must be idle before LCD_Sleep()
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Timing.h"
+#include "LCD_Frame.h"
+#include "LCD_Glyph.h"
+#include "LCD_Big.h"
+#include "LCD_Field.h"
+#include "LCD_Handle.h"
+
+/* Waits of the interface handshake that the busy flag cannot cover, us */
+#define LCD_PM_INIT1_US              (4100u)
+#define LCD_PM_INIT2_US              (100u)
+
+#if (LCD_PM_POWER_GATED != 0u)
+    static void LCD_PmReleaseBus(void) ;
+    static void LCD_PmHandshake(void) ;
+#endif /* LCD_PM_POWER_GATED != 0u */
+
+
+/*******************************************************************************
+* Function Name: LCD_SaveConfig
+********************************************************************************
+*
+* Summary:
+*  Saves the mode registers and the enable state of the selected display.
+*  CGRAM and the characters are cached all the time and need no saving.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+* Global variables:
+*  LCD_active->backup is modified.
+*
+*******************************************************************************/
+void LCD_SaveConfig(void)
+{
+    LCD_Handle *handle = LCD_active;
+
+    handle->backup.functionSet = handle->functionSet;
+    handle->backup.entryMode = handle->entryMode;
+    handle->backup.displayControl = handle->displayControl;
+    handle->backup.enableState = handle->enableState;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RestoreConfig
+********************************************************************************
+*
+* Summary:
+*  Writes the saved state back into a controller that lost it: function set,
+*  entry mode, the CGRAM slots the glyph manager uploaded and, with
+*  LCD_USE_FRAMEBUFFER, every character; display control comes last so the
+*  restore itself is not visible.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+* Note:
+*  The interface must already be in the bus width of the build (after the
+*  handshake of LCD_Wakeup() or LCD_Init()).
+*
+*******************************************************************************/
+void LCD_RestoreConfig(void)
+{
+    LCD_Handle *handle = LCD_active;
+    uint8_t functionSet = (uint8_t) (handle->backup.functionSet & ~LCD_FUNCTION_SET_DL);
+
+    #if (LCD_BUS_8BIT != 0u)
+        functionSet |= LCD_FUNCTION_SET_DL;
+    #endif /* LCD_BUS_8BIT != 0u */
+
+    LCD_WriteControl(functionSet);
+    LCD_WriteControl(handle->backup.entryMode);
+    LCD_CursorInvalidate();
+
+    if (LCD_IS_PRIMARY())
+    {
+        LCD_GlyphRestore();
+
+        #if (LCD_USE_FRAMEBUFFER != 0u)
+            /* Nothing on the glass is known any more, resend every cell */
+            LCD_FrameInvalidate();
+            LCD_FlushFrame();
+        #endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+        LCD_BarInvalidate();
+        #if (LCD_USE_BIG_DIGITS != 0u)
+            LCD_BigInvalidate();
+        #endif /* LCD_USE_BIG_DIGITS != 0u */
+        #if (LCD_USE_FIELDS != 0u)
+            LCD_FieldInvalidate();
+        #endif /* LCD_USE_FIELDS != 0u */
+    }
+
+    LCD_WriteControl(handle->backup.displayControl);
+    handle->enableState = handle->backup.enableState;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_Sleep
+********************************************************************************
+*
+* Summary:
+*  Prepares the selected display for low power: saves the configuration and
+*  turns the display off. With LCD_PM_POWER_GATED the bus is driven low as
+*  well, so the unpowered module is not supplied through its inputs.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_Sleep(void)
+{
+    LCD_SaveConfig();
+    LCD_Stop();
+
+    #if (LCD_PM_POWER_GATED != 0u)
+        /* Wait for display off to execute before the supply goes */
+        (void) LCD_IsReady();
+        LCD_PmReleaseBus();
+    #endif /* LCD_PM_POWER_GATED != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_Wakeup
+********************************************************************************
+*
+* Summary:
+*  Resumes the display after LCD_Sleep(), restoring only what the controller
+*  lost: the display on/off state when the supply stayed on, the full cached
+*  state after a power-gated sleep.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_Wakeup(void)
+{
+    LCD_Handle *handle = LCD_active;
+
+    if (handle->initVar == 0u)
+    {
+        /* Never initialized, nothing cached to restore */
+        LCD_Start();
+        return;
+    }
+
+    #if (LCD_PM_POWER_GATED != 0u)
+        LCD_PmHandshake();
+        LCD_RestoreConfig();
+    #else
+        /* Modes, CGRAM and DDRAM were retained */
+        if (handle->backup.enableState != 0u)
+        {
+            LCD_WriteControl(handle->backup.displayControl | LCD_DISPLAY_ON_BIT);
+            handle->enableState = 1u;
+        }
+    #endif /* LCD_PM_POWER_GATED != 0u */
+}
+
+
+#if (LCD_PM_POWER_GATED != 0u)
+/*******************************************************************************
+* Function Name: LCD_PmReleaseBus
+********************************************************************************
+*
+* Summary:
+*  Drives E, RS, R/nW and the data pins low.
+*
+*******************************************************************************/
+static void LCD_PmReleaseBus(void)
+{
+    LCD_DATA_PINS_LOW();
+    WRITE_REG(LCD_RS_PORT->BSRR, LCD_BSRR_RESET(LCD_RS_BITS));
+    WRITE_REG(LCD_RW_PORT->BSRR, LCD_BSRR_RESET(LCD_RW_BITS));
+    WRITE_REG(LCD_E_PORT->BSRR, LCD_BSRR_RESET(LCD_E_BITS));
+    LCD_BusInvalidate();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PmHandshake
+********************************************************************************
+*
+* Summary:
+*  Initialization by instruction after the supply returned, with the minimum
+*  datasheet waits; the busy flag is valid once the bus width is selected.
+*
+*******************************************************************************/
+static void LCD_PmHandshake(void)
+{
+    LCD_DwtDelayUs(LCD_PM_POWER_ON_MS * 1000u);
+
+    LCD_WriteHandshake(LCD_DISPLAY_8_BIT_INIT);
+    LCD_DwtDelayUs(LCD_PM_INIT1_US);
+    LCD_WriteHandshake(LCD_DISPLAY_8_BIT_INIT);
+    LCD_DwtDelayUs(LCD_PM_INIT2_US);
+    LCD_WriteHandshake(LCD_DISPLAY_8_BIT_INIT);
+    LCD_DwtDelayUs(LCD_EXEC_SHORT_US);
+    #if (LCD_BUS_8BIT == 0u)
+        LCD_WriteHandshake(LCD_DISPLAY_4_BIT_INIT);
+    #endif /* LCD_BUS_8BIT == 0u */
+
+    /* Timed writes wait for the last handshake step too */
+    LCD_TimingMark(0u);
+}
+#endif /* LCD_PM_POWER_GATED != 0u */
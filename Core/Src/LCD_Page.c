@@ -0,0 +1,261 @@
+/*
+ *  LCD_Page.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Page flipping in hidden DDRAM for the HD44780 LCD driver.
+ *
+ *  			Each DDRAM line holds 40 characters and a 16x2 or 20x2 module
+ *  			shows at most 20 of them, so a second screen fits next to the
+ *  			visible one. After LCD_PageStart() the framebuffer is flushed
+ *  			into the hidden page (a copy of the geometry with every row
+ *  			base one window further right), and LCD_PageFlip() makes it
+ *  			visible with display shifts: one window of
+ *  			LCD_DISPLAY_SCRL_LEFT commands to show page 1, a single
+ *  			LCD_CURSOR_HOME to go back to page 0. The shifts of a window
+ *  			take well under a millisecond, far below the response time of
+ *  			the liquid crystal, so the page changes as a whole and a
+ *  			half-drawn screen is never shown. Every page keeps its own
+ *  			copy of what it holds: a flush after a flip only writes the
+ *  			cells that differ from what that page showed two flips ago.
+ *
+ *  Usage:      - LCD_PageStart() once, then per screen: draw into the
+ *  				framebuffer and call LCD_PageFlip() (it flushes first)
+ *  			- geometries of at most two rows whose rows fit twice into a
+ *  				DDRAM line (16x1, 16x2, 20x2); the rows 2 and 3 of 4-line
+ *  				modules use the other half of DDRAM
+ *  			- LCD_PageStop() before LCD_SetGeometry(), the marquee or
+ *  				anything else that shifts the display
+ *  			- needs LCD_USE_FRAMEBUFFER, primary display only
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Geometry.h"
+#include "LCD_Handle.h"
+#include "LCD_Page.h"
+
+#if (LCD_USE_PAGE_FLIP != 0u)
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    #error "LCD_USE_PAGE_FLIP flushes the framebuffer into the hidden page (LCD_USE_FRAMEBUFFER)"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+/* Geometry of each page, built from the one LCD_PageStart() found */
+static LCD_GEOMETRY_STRUCT LCD_pageGeometry[LCD_PAGE_COUNT];
+
+/* Geometry the display had before LCD_PageStart() */
+static LCD_GEOMETRY_STRUCT const *LCD_pageOrigin = NULL;
+
+/* Glass copy of the page the framebuffer is not flushed into */
+static uint16_t LCD_pageGlass[LCD_ROWS][LCD_COLUMNS];
+
+/* Display shifts between the pages, 0 while page flipping is off */
+static uint8_t LCD_pageShift = 0u;
+
+/* Page the flushes go to */
+static uint8_t LCD_pageBack = 0u;
+
+static void LCD_PageSelect(uint8_t page) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_PageStart
+********************************************************************************
+*
+* Summary:
+*  Turns page flipping on for the geometry of the display on E_Pin. Page 0
+*  stays on the glass, the framebuffer is flushed into page 1 from now on.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if started, 0 if the geometry leaves no room for a second page.
+*
+*******************************************************************************/
+uint8_t LCD_PageStart(void)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+    uint8_t width = geometry->split;
+    uint8_t row;
+    uint8_t column;
+
+    if (LCD_pageShift != 0u)
+    {
+        return 1u;
+    }
+
+    if ((geometry->columns - geometry->split) > width)
+    {
+        width = geometry->columns - geometry->split;
+    }
+
+    if ((geometry->rows > 2u) || ((2u * width) > LCD_DDRAM_LINE_LENGTH))
+    {
+        return 0u;
+    }
+
+    LCD_pageOrigin = geometry;
+    LCD_pageGeometry[0] = *geometry;
+    LCD_pageGeometry[1] = *geometry;
+    for (row = 0u; row < geometry->rows; row++)
+    {
+        LCD_pageGeometry[1].rowBase[row] = geometry->rowBase[row] + width;
+        LCD_pageGeometry[1].splitBase[row] = geometry->splitBase[row] + width;
+    }
+
+    /* Nothing known about the hidden page */
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            LCD_pageGlass[row][column] = LCD_FRAME_UNKNOWN;
+        }
+    }
+
+    LCD_pageShift = width;
+    LCD_pageBack = 0u;
+    LCD_PageSelect(1u);
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PageFlip
+********************************************************************************
+*
+* Summary:
+*  Flushes the framebuffer into the hidden page and shows it. The page that
+*  was shown becomes the hidden one, the framebuffer keeps the new screen.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+* Note:
+*  Showing page 1 costs one LCD_DISPLAY_SCRL_LEFT per column of a window,
+*  page 0 one LCD_CURSOR_HOME.
+*
+*******************************************************************************/
+void LCD_PageFlip(void)
+{
+    uint8_t shift;
+
+    if (LCD_pageShift == 0u)
+    {
+        LCD_FlushFrame();
+        return;
+    }
+
+    LCD_FlushFrame();
+
+    if (LCD_pageBack == 1u)
+    {
+        for (shift = 0u; shift < LCD_pageShift; shift++)
+        {
+            LCD_WriteControl(LCD_DISPLAY_SCRL_LEFT);
+        }
+        LCD_PageSelect(0u);
+    }
+    else
+    {
+        LCD_WriteControl(LCD_CURSOR_HOME);
+        LCD_PageSelect(1u);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PageStop
+********************************************************************************
+*
+* Summary:
+*  Turns page flipping off: page 0 is shown, with the framebuffer flushed
+*  into it, and the geometry LCD_PageStart() found is selected again.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PageStop(void)
+{
+    if (LCD_pageShift == 0u)
+    {
+        return;
+    }
+
+    if (LCD_pageBack == 0u)
+    {
+        /* Page 1 is on the glass: page 0 brought up to date and shown */
+        LCD_PageFlip();
+    }
+
+    LCD_PageSelect(0u);
+    LCD_display0.geometry = LCD_pageOrigin;
+    LCD_pageShift = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PageShown
+********************************************************************************
+*
+* Summary:
+*  Returns the page on the glass.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  0 or 1; 0 while page flipping is off.
+*
+*******************************************************************************/
+uint8_t LCD_PageShown(void)
+{
+    return (LCD_pageShift != 0u) ? (uint8_t) (1u - LCD_pageBack) : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PageSelect
+********************************************************************************
+*
+* Summary:
+*  Points the flushes at a page: swaps the glass copies and the geometry.
+*
+*******************************************************************************/
+static void LCD_PageSelect(uint8_t page)
+{
+    uint16_t cell;
+    uint8_t row;
+    uint8_t column;
+
+    if (page != LCD_pageBack)
+    {
+        for (row = 0u; row < LCD_ROWS; row++)
+        {
+            for (column = 0u; column < LCD_COLUMNS; column++)
+            {
+                cell = LCD_glass[row][column];
+                LCD_glass[row][column] = LCD_pageGlass[row][column];
+                LCD_pageGlass[row][column] = cell;
+            }
+        }
+        LCD_pageBack = page;
+    }
+
+    LCD_display0.geometry = &LCD_pageGeometry[page];
+    LCD_display0.wrapAddress = LCD_CURSOR_UNKNOWN;
+    LCD_frameDirty = 1u;
+}
+
+#endif /* LCD_USE_PAGE_FLIP != 0u */
@@ -0,0 +1,286 @@
+/*
+ *  LCD_Plan.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Flush planner for the HD44780 LCD driver.
+ *
+ *  			LCD_FlushFrame() sends one set-DDRAM-address command per run
+ *  			of changed cells. When two runs are only a few unchanged
+ *  			cells apart, writing those cells again costs less than the
+ *  			address command and the start of another bulk write. The
+ *  			planner prices both with the cost model once per flush and
+ *  			bridges every gap up to the break-even length. It walks the
+ *  			DDRAM runs of the geometry in address order rather than in
+ *  			row order (0, 2, 1, 3 on a 20x4 module, where row 2 continues
+ *  			the addresses of row 0), so a change that goes on past the
+ *  			end of one row into the next run needs no address command,
+ *  			and neither does a span that starts where the tracked cursor
+ *  			already is.
+ *
+ *  Usage:      - set LCD_USE_FLUSH_PLANNER (with LCD_USE_COST_MODEL), the
+ *  				flushes and LCD_EstimatePendingFlush() then follow the
+ *  				plan
+ *  			- LCD_PLAN_RUN_US is the time of starting a bulk write on top
+ *  				of its address command (call, DMA set-up); raise it for a
+ *  				slow transport start to bridge longer gaps
+ *  			- the flush assumes the increment entry mode, as before
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Handle.h"
+#include "LCD_Geometry.h"
+#include "LCD_Cost.h"
+#include "LCD_Plan.h"
+
+#if (LCD_USE_FLUSH_PLANNER != 0u)
+
+#if ((LCD_USE_FRAMEBUFFER == 0u) || (LCD_USE_COST_MODEL == 0u))
+    #error "LCD_USE_FLUSH_PLANNER plans framebuffer flushes (LCD_USE_FRAMEBUFFER) with the cost model (LCD_USE_COST_MODEL)"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+/* A framebuffer cell the display does not show yet */
+#define LCD_PLAN_CHANGED(row, column) \
+    (LCD_glass[(row)][(column)] != (uint16_t) LCD_frame[(row)][(column)])
+
+static uint8_t LCD_PlanFirst(LCD_GEOMETRY_STRUCT const *geometry, uint8_t run) ;
+static uint8_t LCD_PlanEnd(LCD_GEOMETRY_STRUCT const *geometry, uint8_t run) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_PlanStart
+********************************************************************************
+*
+* Summary:
+*  Starts a walk of the framebuffer: sorts the DDRAM runs of the geometry by
+*  address and works out the longest unchanged gap that is cheaper to write
+*  again than to skip with an address command.
+*
+* Parameters:
+*  plan: Walk state
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PlanStart(LCD_PLAN *plan)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+    uint8_t address[LCD_GEOMETRY_RUNS];
+    uint8_t start;
+    uint8_t length;
+    uint8_t run;
+    uint8_t slot;
+    uint32_t write;
+    uint32_t position;
+    uint32_t gap;
+
+    plan->geometry = geometry;
+    plan->runs = 0u;
+
+    for (run = 0u; run < LCD_GEOMETRY_RUNS; run++)
+    {
+        if (LCD_GeometryRun(geometry, run, &start, &length) != 0u)
+        {
+            /* Insertion sort by DDRAM address */
+            slot = plan->runs;
+            while ((slot != 0u) && (address[slot - 1u] > start))
+            {
+                address[slot] = address[slot - 1u];
+                plan->order[slot] = plan->order[slot - 1u];
+                slot--;
+            }
+            address[slot] = start;
+            plan->order[slot] = run;
+            plan->runs++;
+        }
+    }
+
+    plan->index = 0u;
+    plan->column = (plan->runs != 0u) ? LCD_PlanFirst(geometry, plan->order[0]) : 0u;
+    plan->carry = 0u;
+    plan->cursor = LCD_CursorGet();
+
+    /* Marginal costs of a data write and of an address command; what is left
+     * of the last execution time cancels out
+     */
+    write = LCD_EstimateCost(LCD_OP_PRINT, 2u).us - LCD_EstimateCost(LCD_OP_PRINT, 1u).us;
+    position = LCD_EstimateCost(LCD_OP_PRINT_AT, 1u).us - LCD_EstimateCost(LCD_OP_PRINT, 1u).us;
+    gap = (write != 0u) ? ((position + LCD_PLAN_RUN_US) / write) : geometry->columns;
+    plan->gapMax = (gap < geometry->columns) ? (uint8_t) gap : geometry->columns;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PlanNext
+********************************************************************************
+*
+* Summary:
+*  Returns the next bulk write of the walk: from a changed cell through the
+*  changed cells and the gaps up to the break-even length that follow it,
+*  within one DDRAM run, and to the end of the run when the next run in
+*  address order continues it after such a gap.
+*
+* Parameters:
+*  plan: Walk state, from LCD_PlanStart()
+*  span: Receives the write
+*
+* Return:
+*  1 if a write was returned, 0 when the display shows all of the frame.
+*
+* Note:
+*  The walk only looks at cells past the last span, the caller may update
+*  LCD_glass for a span before asking for the next.
+*
+*******************************************************************************/
+uint8_t LCD_PlanNext(LCD_PLAN *plan, LCD_PLAN_SPAN *span)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = plan->geometry;
+    uint8_t run = 0u;
+    uint8_t row = 0u;
+    uint8_t end = 0u;
+    uint8_t column;
+    uint8_t scan;
+    uint8_t next;
+    uint8_t first = 0u;
+    uint8_t lead;
+    uint8_t more = 1u;
+    uint8_t bridged = 0u;
+
+    /* The next changed cell, or the first cell of a bridged run */
+    while (plan->index < plan->runs)
+    {
+        run = plan->order[plan->index];
+        row = run >> 1u;
+        end = LCD_PlanEnd(geometry, run);
+
+        if (plan->carry == 0u)
+        {
+            while ((plan->column < end) && (!LCD_PLAN_CHANGED(row, plan->column)))
+            {
+                plan->column++;
+            }
+        }
+
+        if (plan->column < end)
+        {
+            break;
+        }
+
+        plan->index++;
+        if (plan->index < plan->runs)
+        {
+            plan->column = LCD_PlanFirst(geometry, plan->order[plan->index]);
+        }
+    }
+
+    if (plan->index >= plan->runs)
+    {
+        return 0u;
+    }
+
+    span->row = row;
+    span->start = plan->column;
+    span->addressed = (LCD_GeometryAddress(geometry, row, plan->column) != plan->cursor) ? 1u : 0u;
+    plan->carry = 0u;
+
+    /* Changed cells, and the unchanged gaps cheaper to write than to skip */
+    column = plan->column;
+    scan = column;
+    while (more != 0u)
+    {
+        while ((column < end) && (LCD_PLAN_CHANGED(row, column)))
+        {
+            column++;
+        }
+
+        scan = column;
+        while ((scan < end) && (!LCD_PLAN_CHANGED(row, scan)))
+        {
+            scan++;
+        }
+
+        if ((scan < end) && ((scan - column) <= plan->gapMax))
+        {
+            column = scan;
+        }
+        else
+        {
+            more = 0u;
+        }
+    }
+
+    /* Rest of the run unchanged: go on into the next run when it continues
+     * the addresses and its first change is close enough
+     */
+    if ((scan == end) && ((plan->index + 1u) < plan->runs))
+    {
+        next = plan->order[plan->index + 1u];
+        first = LCD_PlanFirst(geometry, next);
+        if (LCD_GeometryAddress(geometry, next >> 1u, first) ==
+            ((LCD_GeometryAddress(geometry, row, end - 1u) + 1u) & LCD_DDRAM_ADDRESS_MASK))
+        {
+            lead = first;
+            while ((lead < LCD_PlanEnd(geometry, next)) && (!LCD_PLAN_CHANGED(next >> 1u, lead)))
+            {
+                lead++;
+            }
+
+            if ((lead < LCD_PlanEnd(geometry, next)) && (((end - column) + (lead - first)) <= plan->gapMax))
+            {
+                column = end;
+                bridged = 1u;
+            }
+        }
+    }
+
+    span->length = column - span->start;
+    plan->cursor = (LCD_GeometryAddress(geometry, row, span->start) + span->length) & LCD_DDRAM_ADDRESS_MASK;
+
+    if (bridged != 0u)
+    {
+        /* The next span starts where this one leaves the address counter */
+        plan->index++;
+        plan->column = first;
+        plan->carry = 1u;
+    }
+    else
+    {
+        plan->column = column;
+    }
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PlanFirst
+********************************************************************************
+*
+* Summary:
+*  Returns the first framebuffer column of a DDRAM run.
+*
+*******************************************************************************/
+static uint8_t LCD_PlanFirst(LCD_GEOMETRY_STRUCT const *geometry, uint8_t run)
+{
+    return ((run & 1u) != 0u) ? geometry->split : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PlanEnd
+********************************************************************************
+*
+* Summary:
+*  Returns the framebuffer column after the last one of a DDRAM run.
+*
+*******************************************************************************/
+static uint8_t LCD_PlanEnd(LCD_GEOMETRY_STRUCT const *geometry, uint8_t run)
+{
+    return ((run & 1u) != 0u) ? geometry->columns : geometry->split;
+}
+
+#endif /* LCD_USE_FLUSH_PLANNER != 0u */
@@ -0,0 +1,213 @@
+/*
+ *  LCD_Poll.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Time-budgeted, cooperative framebuffer flush for the HD44780
+ *  			LCD driver.
+ *
+ *  			LCD_Poll() walks the framebuffer like LCD_FlushFrame(), but
+ *  			sends a changed cell only when its write ends inside the time
+ *  			budget of the call. Whether the module is ready comes from the
+ *  			elapsed execution time of the previous byte (LCD_Timing.c):
+ *  			a write is made once that time has passed, a wait is only
+ *  			spent when it fits in the budget, and LCD_IsReady() is never
+ *  			polled. The next call continues at the cell after the last
+ *  			one sent, so a superloop gets display output at a fixed cost
+ *  			per iteration and no timer interrupt.
+ *
+ *  Usage:      - print into the framebuffer as usual, then LCD_Poll(50u) once
+ *  				per main loop iteration instead of LCD_FlushFrame()
+ *  			- with LCD_USE_CURSOR_TRACKING the address command of a run
+ *  				is only sent for its first cell
+ *  			- needs LCD_USE_FRAMEBUFFER and LCD_USE_ELAPSED_SKIP; after
+ *  				LCD_SetElapsedSkip(0) every write polls the busy flag
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Handle.h"
+#include "LCD_Timing.h"
+#include "LCD_Latency.h"
+#include "LCD_Poll.h"
+
+#if (LCD_USE_POLL != 0u)
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    #error "LCD_USE_POLL sends the framebuffer (LCD_USE_FRAMEBUFFER)"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+#if (LCD_USE_ELAPSED_SKIP == 0u)
+    #error "LCD_USE_POLL paces writes by the elapsed execution time (LCD_USE_ELAPSED_SKIP)"
+#endif /* LCD_USE_ELAPSED_SKIP == 0u */
+
+/* 1 while a pass over the framebuffer is under way */
+static uint8_t LCD_pollActive = 0u;
+
+/* Next cell of the pass to look at */
+static uint8_t LCD_pollRow;
+static uint8_t LCD_pollColumn;
+
+/* Longest write measured, cycles (0 = LCD_POLL_WRITE_US not converted yet) */
+static uint32_t LCD_pollWriteCycles = 0u;
+
+static uint8_t LCD_PollNext(void) ;
+static uint8_t LCD_PollRoom(uint32_t start, uint32_t budget) ;
+static void LCD_PollMeasure(uint32_t start) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_Poll
+********************************************************************************
+*
+* Summary:
+*  Sends changed framebuffer cells until the next write would not end within
+*  the budget, then returns. A frame changed since the last pass starts a new
+*  pass.
+*
+* Parameters:
+*  budgetUs: Time the call may take, us
+*
+* Return:
+*  1 if the display shows the whole framebuffer, 0 if cells are pending.
+*
+* Reentrant:
+*  No, one caller (main loop). Do not mix with LCD_FlushFrame() in one pass.
+*
+*******************************************************************************/
+uint8_t LCD_Poll(uint32_t budgetUs)
+{
+    uint32_t const start = LCD_CYCLES();
+    uint32_t const budget = budgetUs * LCD_cyclesPerUs;
+    uint32_t writeStart;
+
+    if (LCD_pollWriteCycles == 0u)
+    {
+        LCD_pollWriteCycles = LCD_POLL_WRITE_US * LCD_cyclesPerUs;
+    }
+
+    for (;;)
+    {
+        if (LCD_pollActive == 0u)
+        {
+            if (LCD_frameDirty == 0u)
+            {
+                return 1u;
+            }
+
+            /* Cells changed behind the pass set it again */
+            LCD_frameDirty = 0u;
+            LCD_pollActive = 1u;
+            LCD_pollRow = 0u;
+            LCD_pollColumn = 0u;
+        }
+
+        if (LCD_PollNext() == 0u)
+        {
+            LCD_pollActive = 0u;
+            #if (LCD_USE_FRAME_SNAPSHOT != 0u)
+                LCD_FrameSave();
+            #endif /* LCD_USE_FRAME_SNAPSHOT != 0u */
+            continue;
+        }
+
+        /* Address command, elided while the cursor is already there */
+        if (LCD_PollRoom(start, budget) == 0u)
+        {
+            return 0u;
+        }
+        writeStart = LCD_CYCLES();
+        LCD_WritePosition(LCD_pollRow, LCD_pollColumn);
+        LCD_PollMeasure(writeStart);
+
+        /* The cell; the next call sends the position again if need be */
+        if (LCD_PollRoom(start, budget) == 0u)
+        {
+            return 0u;
+        }
+        writeStart = LCD_CYCLES();
+        LCD_WriteData(LCD_frame[LCD_pollRow][LCD_pollColumn]);
+        LCD_PollMeasure(writeStart);
+
+        LCD_glass[LCD_pollRow][LCD_pollColumn] = LCD_frame[LCD_pollRow][LCD_pollColumn];
+        LCD_LATENCY_SHOWN(LCD_pollRow, LCD_pollColumn);
+        LCD_pollColumn++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PollNext
+********************************************************************************
+*
+* Summary:
+*  Moves the pass to the next cell that differs from the display.
+*
+*******************************************************************************/
+static uint8_t LCD_PollNext(void)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+
+    for (; LCD_pollRow < geometry->rows; LCD_pollRow++)
+    {
+        for (; LCD_pollColumn < geometry->columns; LCD_pollColumn++)
+        {
+            if (LCD_glass[LCD_pollRow][LCD_pollColumn] != (uint16_t) LCD_frame[LCD_pollRow][LCD_pollColumn])
+            {
+                return 1u;
+            }
+        }
+        LCD_pollColumn = 0u;
+    }
+
+    return 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PollRoom
+********************************************************************************
+*
+* Summary:
+*  Waits out the execution time of the previous byte if that and one write
+*  still fit in the budget. Returns 0 (without waiting) if not.
+*
+*******************************************************************************/
+static uint8_t LCD_PollRoom(uint32_t start, uint32_t budget)
+{
+    uint32_t const remaining = LCD_TimingRemaining();
+
+    if (((uint32_t) (LCD_CYCLES() - start) + remaining + LCD_pollWriteCycles) > budget)
+    {
+        return 0u;
+    }
+
+    while (LCD_TimingExpired() == 0u)
+    {
+    }
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_PollMeasure
+********************************************************************************
+*
+* Summary:
+*  Keeps the longest write seen as the cost of the next one.
+*
+*******************************************************************************/
+static void LCD_PollMeasure(uint32_t start)
+{
+    uint32_t const cycles = (uint32_t) (LCD_CYCLES() - start);
+
+    if (cycles > LCD_pollWriteCycles)
+    {
+        LCD_pollWriteCycles = cycles;
+    }
+}
+
+#endif /* LCD_USE_POLL != 0u */
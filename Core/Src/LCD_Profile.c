@@ -0,0 +1,281 @@
+/*
+ *  LCD_Profile.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Sampling CPU profiler for the HD44780 LCD driver.
+ *
+ *  			TIM2 interrupts LCD_PROFILE_HZ times a second at the highest
+ *  			priority and TIM2_IRQHandler (stm32f1xx_it.c) hands the
+ *  			exception frame the core stacked to LCD_ProfileIRQHandler().
+ *  			The return address in that frame is the instruction that was
+ *  			interrupted; it is counted for the driver when it lies in the
+ *  			LCD code the linker script groups between _slcd_text and
+ *  			_elcd_text (or in .RamFunc), for delay_us() between
+ *  			_sdelay_text and _edelay_text, and for the rest otherwise.
+ *  			Over a few seconds the counts give the share of the CPU the
+ *  			display takes in the field, busy waits and delays included.
+ *
+ *  Usage:      - LCD_ProfileStart() once, LCD_ProfileReport(
+ *  				LCD_ProfileItmPutChar) now and then for a line like
+ *  				"LCD 12.5% delay_us 3.1% other 84.4% of 50035" on SWO
+ *  			- the rate is no divisor of 1 kHz, so samples do not lock
+ *  				onto the SysTick work
+ *  			- code of interrupts at priority 0 is never sampled; delay_us
+ *  				needs -ffunction-sections (.text.delay_us), without it its
+ *  				time counts as other
+ *  			- TIM2 is owned by this module, so LCD_USE_DMA_TRANSPORT
+ *  				(paced by TIM2) is off with it
+ *
+ */
+#include "main.h"
+#include "stm32f1xx_ll_tim.h"
+#include "LCD.h"
+#include "LCD_Format.h"
+#include "LCD_Profile.h"
+
+#if (LCD_USE_PROFILER != 0u)
+
+/* Code ranges of the buckets, from STM32F103RBTX_FLASH.ld */
+extern uint8_t _slcd_text[];
+extern uint8_t _elcd_text[];
+extern uint8_t _sdelay_text[];
+extern uint8_t _edelay_text[];
+extern uint8_t _sramfunc[];
+extern uint8_t _eramfunc[];
+
+/* Stacked registers of an exception frame: r0-r3, r12, lr, pc, xpsr */
+#define LCD_PROFILE_FRAME_PC         (6u)
+
+static volatile uint32_t LCD_profileSamples[3];
+
+static void LCD_ProfilePutPercent(LCD_ProfilePutChar putChar, char const label[],
+                                  uint32_t count, uint32_t total) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_ProfileStart
+********************************************************************************
+*
+* Summary:
+*  Clears the counts and starts sampling on TIM2 at LCD_PROFILE_HZ.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ProfileStart(void)
+{
+    LCD_profileSamples[LCD_PROFILE_DRIVER] = 0u;
+    LCD_profileSamples[LCD_PROFILE_DELAY] = 0u;
+    LCD_profileSamples[LCD_PROFILE_OTHER] = 0u;
+
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM2);
+
+    LL_TIM_SetPrescaler(TIM2, 0u);
+    LL_TIM_SetAutoReload(TIM2, (SystemCoreClock / LCD_PROFILE_HZ) - 1u);
+    LL_TIM_GenerateEvent_UPDATE(TIM2);
+    LL_TIM_ClearFlag_UPDATE(TIM2);
+    LL_TIM_EnableIT_UPDATE(TIM2);
+
+    HAL_NVIC_SetPriority(TIM2_IRQn, LCD_PROFILE_IRQ_PRIORITY, 0u);
+    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+
+    LL_TIM_EnableCounter(TIM2);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ProfileStop
+********************************************************************************
+*
+* Summary:
+*  Stops sampling. The counts are kept for LCD_ProfileGet()/Report().
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ProfileStop(void)
+{
+    LL_TIM_DisableCounter(TIM2);
+    LL_TIM_DisableIT_UPDATE(TIM2);
+    HAL_NVIC_DisableIRQ(TIM2_IRQn);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ProfileGet
+********************************************************************************
+*
+* Summary:
+*  Copies the counts of all buckets, taken at one instant.
+*
+* Parameters:
+*  profile: Receives the counts
+*
+* Return:
+*  None.
+*
+* Note:
+*  TIM2 samples at LCD_PROFILE_IRQ_PRIORITY, 0 by default, where no BASEPRI
+*  mask reaches it, so nothing is masked: the counts only grow, and a copy
+*  that reads back unchanged held at one instant. A sample comes every
+*  1 / LCD_PROFILE_HZ, the loop rarely runs twice.
+*
+*******************************************************************************/
+void LCD_ProfileGet(LCD_PROFILE *profile)
+{
+    do
+    {
+        profile->samples[LCD_PROFILE_DRIVER] = LCD_profileSamples[LCD_PROFILE_DRIVER];
+        profile->samples[LCD_PROFILE_DELAY] = LCD_profileSamples[LCD_PROFILE_DELAY];
+        profile->samples[LCD_PROFILE_OTHER] = LCD_profileSamples[LCD_PROFILE_OTHER];
+    } while ((profile->samples[LCD_PROFILE_DRIVER] != LCD_profileSamples[LCD_PROFILE_DRIVER]) ||
+             (profile->samples[LCD_PROFILE_DELAY] != LCD_profileSamples[LCD_PROFILE_DELAY]) ||
+             (profile->samples[LCD_PROFILE_OTHER] != LCD_profileSamples[LCD_PROFILE_OTHER]));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ProfileReport
+********************************************************************************
+*
+* Summary:
+*  Writes the share of every bucket as one text line, e.g.
+*  "LCD 12.5% delay_us 3.1% other 84.4% of 50035\n".
+*
+* Parameters:
+*  putChar: Character output, LCD_ProfileItmPutChar for SWO
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ProfileReport(LCD_ProfilePutChar putChar)
+{
+    LCD_PROFILE profile;
+    char digits[LCD_NUMBER_TEXT_MAX];
+    uint32_t total;
+    uint8_t length;
+    uint8_t index;
+
+    LCD_ProfileGet(&profile);
+    total = profile.samples[LCD_PROFILE_DRIVER] + profile.samples[LCD_PROFILE_DELAY] +
+            profile.samples[LCD_PROFILE_OTHER];
+
+    LCD_ProfilePutPercent(putChar, "LCD ", profile.samples[LCD_PROFILE_DRIVER], total);
+    LCD_ProfilePutPercent(putChar, " delay_us ", profile.samples[LCD_PROFILE_DELAY], total);
+    LCD_ProfilePutPercent(putChar, " other ", profile.samples[LCD_PROFILE_OTHER], total);
+
+    putChar(' ');
+    putChar('o');
+    putChar('f');
+    putChar(' ');
+    length = LCD_FormatU32(digits, total);
+    for (index = 0u; index < length; index++)
+    {
+        putChar(digits[index]);
+    }
+    putChar('\n');
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ProfileItmPutChar
+********************************************************************************
+*
+* Summary:
+*  LCD_ProfileReport() output on ITM stimulus port 0 (SWO).
+*
+* Parameters:
+*  character: Character to send
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ProfileItmPutChar(char character)
+{
+    (void) ITM_SendChar((uint32_t) (uint8_t) character);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ProfileIRQHandler
+********************************************************************************
+*
+* Summary:
+*  Counts one sample for the bucket of the interrupted instruction.
+*
+* Parameters:
+*  frame: Exception frame of the interrupted code (MSP or PSP at entry)
+*
+* Return:
+*  None.
+*
+* Note:
+*  Reached from TIM2_IRQHandler with the frame pointer in r0 and the
+*  EXC_RETURN value still in lr.
+*
+*******************************************************************************/
+void LCD_ProfileIRQHandler(uint32_t const frame[])
+{
+    uint8_t const *pc = (uint8_t const *) frame[LCD_PROFILE_FRAME_PC];
+
+    LL_TIM_ClearFlag_UPDATE(TIM2);
+
+    if (((pc >= _slcd_text) && (pc < _elcd_text)) ||
+        ((pc >= _sramfunc) && (pc < _eramfunc)))
+    {
+        LCD_profileSamples[LCD_PROFILE_DRIVER]++;
+    }
+    else if ((pc >= _sdelay_text) && (pc < _edelay_text))
+    {
+        LCD_profileSamples[LCD_PROFILE_DELAY]++;
+    }
+    else
+    {
+        LCD_profileSamples[LCD_PROFILE_OTHER]++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ProfilePutPercent
+********************************************************************************
+*
+* Summary:
+*  Writes a label and count / total as a percentage with one decimal.
+*
+*******************************************************************************/
+static void LCD_ProfilePutPercent(LCD_ProfilePutChar putChar, char const label[],
+                                  uint32_t count, uint32_t total)
+{
+    char text[LCD_NUMBER_TEXT_MAX];
+    uint32_t permille = (total != 0u) ? (uint32_t) ((((uint64_t) count * 1000u) + (total / 2u)) / total) : 0u;
+    uint8_t length;
+    uint8_t index = 0u;
+
+    while (label[index] != '\0')
+    {
+        putChar(label[index]);
+        index++;
+    }
+
+    length = LCD_FormatScaled(text, (int32_t) permille, 1u);
+    for (index = 0u; index < length; index++)
+    {
+        putChar(text[index]);
+    }
+    putChar('%');
+}
+
+#endif /* LCD_USE_PROFILER != 0u */
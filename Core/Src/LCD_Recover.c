@@ -0,0 +1,163 @@
+/*
+ *  LCD_Recover.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Background recovery of a display that stopped answering.
+ *
+ *  			A busy poll that times out (LCD_IsReady()) latches the display
+ *  			unresponsive: LCD.c drops the bus writes but keeps updating the
+ *  			mode mirrors, the cursor and the framebuffer, and every later
+ *  			poll is one flag read instead of a full timeout. Once a read
+ *  			answers again, or every LCD_RECOVER_RETRY_MS while it does not,
+ *  			LCD_RecoverPoll() runs the interface handshake one step per call
+ *  			and probes the module. When it answers, the mirrored state is
+ *  			replayed by LCD_RestoreConfig(): modes, the uploaded CGRAM slots,
+ *  			the frame and display control. A module that browned out or lost
+ *  			nibble sync shows what the application last wrote, no re-init of
+ *  			the application and no blocking waits.
+ *
+ *  Usage:      - call LCD_RecoverPoll() from the main loop, it works on the
+ *  				selected display and steps on HAL_GetTick()
+ *  			- LCD_IsResponsive() tells whether writes reach the display
+ *  			- loss is seen by the busy poll only: timed mode
+ *  				(LCD_SetTimedMode()) does not poll, the I2C transport
+ *  				reports a backpack that does not acknowledge, the SPI
+ *  				transport cannot read and never latches
+ *  			- the replay goes through LCD_SaveConfig(), the copy taken
+ *  				by LCD_Sleep() is overwritten
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Handle.h"
+#include "LCD_Stats.h"
+#include "LCD_Recover.h"
+
+#if (LCD_USE_LINK_RECOVERY != 0u)
+
+
+/*******************************************************************************
+* Function Name: LCD_RecoverPoll
+********************************************************************************
+*
+* Summary:
+*  Advances the re-initialization of an unresponsive display by at most one
+*  step. Never waits for more than one busy flag read.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 when the display is responsive, 0 while it is being recovered.
+*
+* Global variables:
+*  LCD_active link state and backup are modified.
+*
+*******************************************************************************/
+uint8_t LCD_RecoverPoll(void)
+{
+    static const uint8_t LCD_recoverNibbles[LCD_INIT_NIBBLE_STEPS] =
+    {
+        LCD_DISPLAY_8_BIT_INIT,     /* Selects 8-bit mode, from any nibble phase */
+        LCD_DISPLAY_8_BIT_INIT,
+        LCD_DISPLAY_8_BIT_INIT,
+    #if (LCD_BUS_8BIT != 0u)
+        LCD_DISPLAY_8_BIT_INIT      /* Stays in 8-bit mode */
+    #else
+        LCD_DISPLAY_4_BIT_INIT      /* Selects 4-bit mode */
+    #endif /* LCD_BUS_8BIT != 0u */
+    };
+
+    /* Wait before each nibble step, and before the probe after the last one (ms) */
+    static const uint8_t LCD_recoverWaits[LCD_INIT_NIBBLE_STEPS + 1u] =
+    {
+        LCD_RECOVER_POWER_ON_MS, LCD_RECOVER_INIT1_MS, LCD_RECOVER_INIT2_MS,
+        LCD_RECOVER_INIT2_MS, LCD_RECOVER_INIT2_MS
+    };
+
+    LCD_Handle *handle = LCD_active;
+    uint8_t const step = handle->recoverStep;
+    uint32_t wait;
+
+    if (handle->linkState == LCD_LINK_UP)
+    {
+        return 1u;
+    }
+
+    if (handle->initVar == 0u)
+    {
+        /* Still in LCD_InitPoll(), which sets the modes itself */
+        return 0u;
+    }
+
+    /* Still silent: the next attempt comes after the retry interval */
+    wait = ((step == 0u) && (handle->linkState == LCD_LINK_LOST)) ?
+           LCD_RECOVER_RETRY_MS : LCD_recoverWaits[step];
+
+    if ((HAL_GetTick() - handle->linkTick) <= wait)
+    {
+        return 0u;
+    }
+
+    handle->linkTick = HAL_GetTick();
+
+    if (step < LCD_INIT_NIBBLE_STEPS)
+    {
+        if (step == 0u)
+        {
+            /* The mirrors followed every dropped write, replay them */
+            LCD_SaveConfig();
+        }
+
+        LCD_WriteHandshake(LCD_recoverNibbles[step]);
+        handle->recoverStep = step + 1u;
+        return 0u;
+    }
+
+    handle->recoverStep = 0u;
+
+    if (LCD_IsReady() == 0u)
+    {
+        handle->linkState = LCD_LINK_LOST;
+        return 0u;
+    }
+
+    handle->linkState = LCD_LINK_UP;
+    LCD_RestoreConfig();
+    LCD_STAT_INC(recoveries);
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RecoverRequest
+********************************************************************************
+*
+* Summary:
+*  Has LCD_RecoverPoll() re-initialize the selected display although it
+*  answers, for a controller whose state is known to be bad (LCD_Scrub.c).
+*  Writes are dropped until the replay.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_RecoverRequest(void)
+{
+    LCD_Handle *handle = LCD_active;
+
+    if (handle->linkState == LCD_LINK_UP)
+    {
+        handle->linkState = LCD_LINK_BACK;
+        handle->recoverStep = 0u;
+        handle->linkTick = HAL_GetTick();
+    }
+}
+
+#endif /* LCD_USE_LINK_RECOVERY != 0u */
@@ -0,0 +1,100 @@
+/*
+ *  LCD_Refresh.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Rate-capped framebuffer refresh for the HD44780 LCD driver.
+ *
+ *  			Producers print into the framebuffer whenever they like and
+ *  			never flush. LCD_RefreshTask() flushes at most once every
+ *  			LCD_REFRESH_PERIOD_MS, and only if something changed since the
+ *  			last flush: any number of writes to a cell in between costs
+ *  			one transfer of its final value, and the bus load is bounded
+ *  			by LCD_REFRESH_HZ times the cells that differ, however chatty
+ *  			the producers are.
+ *
+ *  Usage:      - call LCD_RefreshTask() from the main loop
+ *  			- LCD_RefreshUrgent() flushes at once (alarms, the first
+ *  				screen), the rate cap restarts from it
+ *  			- with LCD_USE_ATTRIBUTES the task also advances the blink
+ *  				phase of the blinking fields
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Refresh.h"
+#include "LCD_Attr.h"
+
+#if (LCD_USE_REFRESH != 0u)
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    #error "LCD_USE_REFRESH coalesces writes in the framebuffer (LCD_USE_FRAMEBUFFER)"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+#if ((LCD_REFRESH_HZ == 0u) || (LCD_REFRESH_HZ > 1000u))
+    #error "LCD_REFRESH_HZ must be 1 - 1000 (HAL tick)"
+#endif /* (LCD_REFRESH_HZ == 0u) || (LCD_REFRESH_HZ > 1000u) */
+
+/* HAL tick of the last flush */
+static uint32_t LCD_refreshTick = 0u;
+
+
+/*******************************************************************************
+* Function Name: LCD_RefreshTask
+********************************************************************************
+*
+* Summary:
+*  Flushes the framebuffer if it changed and the last flush is at least
+*  LCD_REFRESH_PERIOD_MS ago.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if a flush ran, 0 otherwise.
+*
+*******************************************************************************/
+uint8_t LCD_RefreshTask(void)
+{
+    uint32_t const now = HAL_GetTick();
+
+    #if (LCD_USE_ATTRIBUTES != 0u)
+        /* Blink phase changes dirty only the blinking cells */
+        (void) LCD_AttrTask();
+    #endif /* LCD_USE_ATTRIBUTES != 0u */
+
+    if ((LCD_frameDirty == 0u) || ((uint32_t) (now - LCD_refreshTick) < LCD_REFRESH_PERIOD_MS))
+    {
+        return 0u;
+    }
+
+    LCD_refreshTick = now;
+    LCD_FlushFrame();
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RefreshUrgent
+********************************************************************************
+*
+* Summary:
+*  Flushes the framebuffer now, outside the rate cap.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_RefreshUrgent(void)
+{
+    LCD_refreshTick = HAL_GetTick();
+    LCD_FlushFrame();
+}
+
+#endif /* LCD_USE_REFRESH != 0u */
@@ -0,0 +1,535 @@
+/*
+ *  LCD_Remote.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: UART remote display protocol for the HD44780 LCD driver.
+ *
+ *  			A host sends small binary frames (cell range, full frame,
+ *  			CGRAM glyph, backlight, clear) over USART1 or USART2. The
+ *  			receiver is a DMA channel in circular mode writing into a ring,
+ *  			so no interrupt runs per byte; the idle line interrupt only
+ *  			marks the end of a burst. LCD_RemotePoll() finds the frames in
+ *  			the ring, checks them and applies them where they are: the
+ *  			characters go from the ring straight into the framebuffer, and
+ *  			one flush sends only the cells that changed. A continuous
+ *  			stream at 115200 baud costs a parse per burst and the flush.
+ *
+ *  			LCD_RemoteFeed() takes the same frames from any other link,
+ *  			e.g. the receive buffer of a USB CDC class: frames are parsed
+ *  			where the link put them, and only a frame cut by the end of a
+ *  			packet is put together in a small carry buffer.
+ *
+ *  Usage:      - LCD_RemoteStart() after LCD_Start(), then LCD_RemotePoll()
+ *  				from the main loop (it flushes, unless LCD_USE_REFRESH or LCD_USE_POLL)
+ *  			- call LCD_RemoteIRQHandler() from USART2_IRQHandler (or
+ *  				USART1_IRQHandler), it also wakes a __WFI() main loop
+ *  			- a frame with a bad check is skipped up to the next sync
+ *  				byte and counted, LCD_RemoteErrors()
+ *  			- USB CDC: LCD_USE_USB_CDC (LCD_Usb.c) feeds the packets of
+ *  				its virtual COM port through LCD_UsbPoll()
+ *  			- needs LCD_USE_FRAMEBUFFER; CGRAM frames own the glyph slots,
+ *  				like LCD_LoadCustomFonts()
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Latency.h"
+#include "LCD_Glyph.h"
+#include "LCD_Handle.h"
+#include "LCD_Backlight.h"
+#include "LCD_Remote.h"
+
+#if (LCD_USE_REMOTE != 0u)
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    #error "LCD_USE_REMOTE requires LCD_USE_FRAMEBUFFER"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+#if ((LCD_REMOTE_RX_SIZE & (LCD_REMOTE_RX_SIZE - 1u)) != 0u)
+    #error "LCD_REMOTE_RX_SIZE must be a power of two"
+#endif /* (LCD_REMOTE_RX_SIZE & (LCD_REMOTE_RX_SIZE - 1u)) != 0u */
+
+#if (LCD_REMOTE_USART == 0u)
+    /* No UART receiver, frames only come through LCD_RemoteFeed() */
+#elif (LCD_REMOTE_USART == 1u)
+    #if (LCD_USE_SPI_TRANSPORT != 0u)
+        #error "LCD_REMOTE_USART 1 needs DMA1 Channel 5, used by the SPI transport"
+    #endif /* LCD_USE_SPI_TRANSPORT != 0u */
+    #define LCD_REMOTE_UART          (USART1)
+    #define LCD_REMOTE_IRQN          (USART1_IRQn)
+    #define LCD_REMOTE_DMA_CHANNEL   (LL_DMA_CHANNEL_5)
+    #define LCD_REMOTE_RX_PIN        (LL_GPIO_PIN_10)
+#else
+    #if (LCD_USE_I2C_TRANSPORT != 0u)
+        #error "LCD_REMOTE_USART 2 needs DMA1 Channel 6, used by the I2C transport"
+    #endif /* LCD_USE_I2C_TRANSPORT != 0u */
+    #define LCD_REMOTE_UART          (USART2)
+    #define LCD_REMOTE_IRQN          (USART2_IRQn)
+    #define LCD_REMOTE_DMA_CHANNEL   (LL_DMA_CHANNEL_6)
+    #define LCD_REMOTE_RX_PIN        (LL_GPIO_PIN_3)
+#endif /* LCD_REMOTE_USART == 1u */
+
+#define LCD_REMOTE_MASK              (LCD_REMOTE_RX_SIZE - 1u)
+
+/* Longest frame taken, half of the ring */
+#define LCD_REMOTE_FRAME_MAX         (LCD_REMOTE_RX_SIZE / 2u)
+
+/* Mask of a linear buffer, positions never wrap */
+#define LCD_REMOTE_LINEAR            (0xFFFFu)
+
+/* Byte of the buffer being parsed at a position */
+#define LCD_REMOTE_AT(position)      (LCD_remoteData[(uint16_t) (position) & LCD_remoteMask])
+
+/* Buffer being parsed: the receive ring, a fed buffer or the carry buffer */
+static uint8_t const *LCD_remoteData;
+static uint16_t LCD_remoteMask;
+
+#if (LCD_REMOTE_USART != 0u)
+    static uint8_t LCD_remoteRx[LCD_REMOTE_RX_SIZE];
+
+    /* First byte not parsed yet */
+    static uint16_t LCD_remoteTail = 0u;
+
+    /* Set by the idle line interrupt, a burst ended */
+    static volatile uint8_t LCD_remoteIdle = 0u;
+#endif /* LCD_REMOTE_USART != 0u */
+
+/* Start of a frame cut by the end of a fed buffer */
+static uint8_t LCD_remoteCarry[LCD_REMOTE_FRAME_MAX];
+static uint16_t LCD_remoteCarryLength = 0u;
+
+static uint32_t LCD_remoteErrors = 0u;
+
+static uint16_t LCD_RemoteParse(uint16_t start, uint16_t available, uint8_t *applied) ;
+static void LCD_RemoteApply(uint8_t type, uint16_t payload, uint8_t length) ;
+
+
+#if (LCD_REMOTE_USART != 0u)
+/*******************************************************************************
+* Function Name: LCD_RemoteStart
+********************************************************************************
+*
+* Summary:
+*  Configures the RX pin, the USART at LCD_REMOTE_BAUD (receiver only, DMA
+*  requests, idle line interrupt) and its DMA channel in circular mode.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_RemoteStart(void)
+{
+    uint32_t pclk;
+
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_GPIOA);
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+    #if (LCD_REMOTE_USART == 1u)
+        LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_USART1);
+        pclk = HAL_RCC_GetPCLK2Freq();
+    #else
+        LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_USART2);
+        pclk = HAL_RCC_GetPCLK1Freq();
+    #endif /* LCD_REMOTE_USART == 1u */
+
+    HAL_NVIC_DisableIRQ(LCD_REMOTE_IRQN);
+    LCD_REMOTE_UART->CR1 = 0u;
+
+    LL_GPIO_SetPinMode(GPIOA, LCD_REMOTE_RX_PIN, LL_GPIO_MODE_FLOATING);
+
+    LL_DMA_DisableChannel(DMA1, LCD_REMOTE_DMA_CHANNEL);
+    LL_DMA_ConfigTransfer(DMA1, LCD_REMOTE_DMA_CHANNEL,
+                          LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_MODE_CIRCULAR |
+                          LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                          LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE |
+                          LL_DMA_PRIORITY_LOW);
+    LL_DMA_ConfigAddresses(DMA1, LCD_REMOTE_DMA_CHANNEL, (uint32_t) &LCD_REMOTE_UART->DR,
+                           (uint32_t) LCD_remoteRx, LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+    LL_DMA_SetDataLength(DMA1, LCD_REMOTE_DMA_CHANNEL, LCD_REMOTE_RX_SIZE);
+    LL_DMA_EnableChannel(DMA1, LCD_REMOTE_DMA_CHANNEL);
+
+    LCD_remoteTail = 0u;
+    LCD_remoteIdle = 0u;
+
+    /* 16x oversampling, BRR = fraction of 16, rounded */
+    LCD_REMOTE_UART->BRR = (pclk + (LCD_REMOTE_BAUD / 2u)) / LCD_REMOTE_BAUD;
+    LCD_REMOTE_UART->CR2 = 0u;
+    LCD_REMOTE_UART->CR3 = USART_CR3_DMAR;
+    LCD_REMOTE_UART->CR1 = USART_CR1_UE | USART_CR1_RE | USART_CR1_IDLEIE;
+
+    HAL_NVIC_SetPriority(LCD_REMOTE_IRQN, LCD_REMOTE_IRQ_PRIORITY, 0u);
+    HAL_NVIC_EnableIRQ(LCD_REMOTE_IRQN);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RemotePoll
+********************************************************************************
+*
+* Summary:
+*  Applies every complete frame received since the last call, then flushes
+*  the framebuffer once. Does nothing until a burst ended (idle line) or
+*  half of the ring filled up.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Number of frames applied.
+*
+* Reentrant:
+*  No, one caller (main loop).
+*
+*******************************************************************************/
+uint8_t LCD_RemotePoll(void)
+{
+    uint16_t head;
+    uint8_t applied = 0u;
+
+    head = (uint16_t) (LCD_REMOTE_RX_SIZE - LL_DMA_GetDataLength(DMA1, LCD_REMOTE_DMA_CHANNEL));
+
+    /* Cleared first, a burst ending in the middle of the parse sets it again */
+    if (LCD_remoteIdle != 0u)
+    {
+        LCD_remoteIdle = 0u;
+    }
+    else if (((head - LCD_remoteTail) & LCD_REMOTE_MASK) < (LCD_REMOTE_RX_SIZE / 2u))
+    {
+        return 0u;
+    }
+    else
+    {
+        /* Continuous stream, keep ahead of the DMA */
+    }
+
+    LCD_remoteData = LCD_remoteRx;
+    LCD_remoteMask = LCD_REMOTE_MASK;
+    LCD_remoteTail = (LCD_remoteTail +
+                      LCD_RemoteParse(LCD_remoteTail, (head - LCD_remoteTail) & LCD_REMOTE_MASK, &applied)) &
+                     LCD_REMOTE_MASK;
+
+    #if (LCD_FRAME_AUTO_FLUSH != 0u)
+        if (applied != 0u)
+        {
+            LCD_FlushFrame();
+        }
+    #endif /* LCD_FRAME_AUTO_FLUSH != 0u */
+
+    return applied;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RemoteIRQHandler
+********************************************************************************
+*
+* Summary:
+*  USART interrupt: the line went idle after a burst. Reading SR then DR
+*  clears the flag; DR holds no data, the DMA already took the last byte.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_RemoteIRQHandler(void)
+{
+    uint32_t const status = LCD_REMOTE_UART->SR;
+
+    if ((status & USART_SR_IDLE) != 0u)
+    {
+        (void) LCD_REMOTE_UART->DR;
+        LCD_remoteIdle = 1u;
+    }
+}
+#endif /* LCD_REMOTE_USART != 0u */
+
+
+/*******************************************************************************
+* Function Name: LCD_RemoteFeed
+********************************************************************************
+*
+* Summary:
+*  Applies the frames in a buffer received over another link (USB CDC, ...),
+*  then flushes the framebuffer once. The frames are read where they are; a
+*  frame that continues in the next buffer is kept in the carry buffer.
+*
+* Parameters:
+*  data:   Received bytes, only read during the call
+*  length: Number of bytes
+*
+* Return:
+*  Number of frames applied.
+*
+* Reentrant:
+*  No, one caller (main loop), not interleaved with LCD_RemotePoll().
+*
+*******************************************************************************/
+uint8_t LCD_RemoteFeed(uint8_t const data[], uint16_t length)
+{
+    uint16_t used = 0u;
+    uint16_t need;
+    uint16_t consumed;
+    uint16_t index;
+    uint8_t applied = 0u;
+
+    /* Finish the frame the previous buffer ended in */
+    while ((LCD_remoteCarryLength != 0u) && (used < length))
+    {
+        /* Sync, type and length first, then the rest of the frame */
+        need = (LCD_remoteCarryLength < 3u) ? 3u : (LCD_remoteCarry[2u] + LCD_REMOTE_OVERHEAD);
+        if (need > LCD_REMOTE_FRAME_MAX)
+        {
+            /* Rejected by the parse */
+            need = LCD_remoteCarryLength;
+        }
+
+        for (; (LCD_remoteCarryLength < need) && (used < length); used++)
+        {
+            LCD_remoteCarry[LCD_remoteCarryLength] = data[used];
+            LCD_remoteCarryLength++;
+        }
+
+        if ((LCD_remoteCarryLength >= 3u) && (LCD_remoteCarryLength >= need))
+        {
+            LCD_remoteData = LCD_remoteCarry;
+            LCD_remoteMask = LCD_REMOTE_LINEAR;
+            consumed = LCD_RemoteParse(0u, LCD_remoteCarryLength, &applied);
+
+            /* After a bad frame the rest may hold the start of the next one */
+            for (index = consumed; index < LCD_remoteCarryLength; index++)
+            {
+                LCD_remoteCarry[index - consumed] = LCD_remoteCarry[index];
+            }
+            LCD_remoteCarryLength -= consumed;
+        }
+    }
+
+    LCD_remoteData = data;
+    LCD_remoteMask = LCD_REMOTE_LINEAR;
+    used += LCD_RemoteParse(used, length - used, &applied);
+
+    /* An unfinished frame (at most LCD_REMOTE_FRAME_MAX bytes) waits for the rest */
+    for (; used < length; used++)
+    {
+        LCD_remoteCarry[LCD_remoteCarryLength] = data[used];
+        LCD_remoteCarryLength++;
+    }
+
+    #if (LCD_FRAME_AUTO_FLUSH != 0u)
+        if (applied != 0u)
+        {
+            LCD_FlushFrame();
+        }
+    #endif /* LCD_FRAME_AUTO_FLUSH != 0u */
+
+    return applied;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RemoteErrors
+********************************************************************************
+*
+* Summary:
+*  Returns the number of frames dropped for a bad check or a bad payload.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Dropped frames since reset.
+*
+*******************************************************************************/
+uint32_t LCD_RemoteErrors(void)
+{
+    return LCD_remoteErrors;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RemoteParse
+********************************************************************************
+*
+* Summary:
+*  Applies the complete frames of LCD_remoteData from a position on. Stops
+*  at a frame whose rest has not arrived yet, and returns the number of
+*  bytes done with (applied frames, skipped noise and bad frames).
+*
+*******************************************************************************/
+static uint16_t LCD_RemoteParse(uint16_t start, uint16_t available, uint8_t *applied)
+{
+    uint16_t used = 0u;
+    uint16_t position;
+    uint16_t left;
+    uint16_t index;
+    uint8_t length;
+    uint8_t sum;
+
+    while (used < available)
+    {
+        position = start + used;
+        left = available - used;
+
+        if (LCD_REMOTE_AT(position) != LCD_REMOTE_SYNC)
+        {
+            /* Noise or the rest of a broken frame */
+            used++;
+            continue;
+        }
+
+        if (left < 3u)
+        {
+            /* Length not received yet */
+            break;
+        }
+
+        length = LCD_REMOTE_AT(position + 2u);
+        if ((length + LCD_REMOTE_OVERHEAD) > LCD_REMOTE_FRAME_MAX)
+        {
+            /* Longer than the ring can hold behind the DMA */
+            LCD_remoteErrors++;
+            used++;
+            continue;
+        }
+
+        if (left < (length + LCD_REMOTE_OVERHEAD))
+        {
+            /* Rest of the frame still on the wire */
+            break;
+        }
+
+        sum = 0u;
+        for (index = 1u; index < (length + LCD_REMOTE_OVERHEAD); index++)
+        {
+            sum += LCD_REMOTE_AT(position + index);
+        }
+
+        if (sum != 0u)
+        {
+            /* Not a frame start after all, look for the next sync byte */
+            LCD_remoteErrors++;
+            used++;
+            continue;
+        }
+
+        LCD_RemoteApply(LCD_REMOTE_AT(position + 1u), position + 3u, length);
+        used += length + LCD_REMOTE_OVERHEAD;
+        (*applied)++;
+    }
+
+    return used;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RemoteApply
+********************************************************************************
+*
+* Summary:
+*  Applies one checked frame, reading the payload from LCD_remoteData.
+*
+*******************************************************************************/
+static void LCD_RemoteApply(uint8_t type, uint16_t payload, uint8_t length)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+    uint8_t pattern[LCD_GLYPH_ROWS];
+    uint8_t row;
+    uint8_t column;
+    uint8_t character;
+    uint16_t index;
+
+    switch (type)
+    {
+        case LCD_REMOTE_CELLS:
+            row = LCD_REMOTE_AT(payload);
+            column = LCD_REMOTE_AT(payload + 1u);
+            if ((length < 2u) || (row >= geometry->rows))
+            {
+                LCD_remoteErrors++;
+                break;
+            }
+            /* Cells past the last column are cut off */
+            for (index = 2u; (index < length) && (column < geometry->columns); index++)
+            {
+                character = LCD_REMOTE_AT(payload + index);
+                LCD_LATENCY_CHANGE(row, column, character);
+                LCD_frame[row][column] = character;
+                column++;
+            }
+            LCD_frameDirty = 1u;
+            break;
+
+        case LCD_REMOTE_FRAME:
+            if (length != (geometry->rows * geometry->columns))
+            {
+                LCD_remoteErrors++;
+                break;
+            }
+            index = 0u;
+            for (row = 0u; row < geometry->rows; row++)
+            {
+                for (column = 0u; column < geometry->columns; column++)
+                {
+                    character = LCD_REMOTE_AT(payload + index);
+                    LCD_LATENCY_CHANGE(row, column, character);
+                    LCD_frame[row][column] = character;
+                    index++;
+                }
+            }
+            LCD_frameDirty = 1u;
+            break;
+
+        case LCD_REMOTE_CGRAM:
+            if ((length != (LCD_GLYPH_ROWS + 1u)) || (LCD_REMOTE_AT(payload) >= LCD_GLYPH_SLOTS))
+            {
+                LCD_remoteErrors++;
+                break;
+            }
+            /* The pattern may wrap around the end of the ring */
+            for (index = 0u; index < LCD_GLYPH_ROWS; index++)
+            {
+                pattern[index] = LCD_REMOTE_AT(payload + 1u + index);
+            }
+            LCD_GlyphLoad(LCD_REMOTE_AT(payload), pattern);
+            break;
+
+        case LCD_REMOTE_BACKLIGHT:
+            if (length != 1u)
+            {
+                LCD_remoteErrors++;
+                break;
+            }
+            #if (LCD_USE_BACKLIGHT_PWM != 0u)
+                LCD_SetBacklight(LCD_REMOTE_AT(payload));
+            #else
+                if (LCD_REMOTE_AT(payload) != 0u)
+                {
+                    LL_GPIO_SetOutputPin(Light_LCD_GPIO_Port, Light_LCD_Pin);
+                }
+                else
+                {
+                    LL_GPIO_ResetOutputPin(Light_LCD_GPIO_Port, Light_LCD_Pin);
+                }
+            #endif /* LCD_USE_BACKLIGHT_PWM != 0u */
+            break;
+
+        case LCD_REMOTE_CLEAR:
+            LCD_FrameClear();
+            break;
+
+        default:
+            /* Unknown type, sent by a newer host */
+            LCD_remoteErrors++;
+            break;
+    }
+}
+
+#endif /* LCD_USE_REMOTE != 0u */
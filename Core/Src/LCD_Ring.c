@@ -0,0 +1,442 @@
+/*
+ *  LCD_Ring.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Lock-free multi-producer, single-consumer command ring for the
+ *  			HD44780 LCD driver.
+ *
+ *  			The blocking driver is not reentrant: an interrupt writing to
+ *  			the display in the middle of a foreground transfer would mix the
+ *  			nibbles of two bytes. Interrupts and tasks therefore only post
+ *  			LCD_ITEM_CMD()/LCD_ITEM_DATA() entries here; one consumer (main
+ *  			loop or the TIM4 write queue) owns the bus and drains them.
+ *
+ *  			Producers claim slots by advancing the enqueue position with
+ *  			LDREX/STREX and never disable interrupts or wait for the display.
+ *  			A message (LCD_RingPushBuffer, LCD_RingPrintAt) claims all of its
+ *  			slots in one step, so text from different producers is never
+ *  			interleaved. Every slot carries a lap stamp: even = free for that
+ *  			lap, odd = filled. The consumer only takes a slot whose producer
+ *  			has finished writing it, and hands the slot to the next lap.
+ *
+ *  Usage:      - LCD_RingPush()/LCD_RingPrintAt() from any context, they
+ *  				return 0 when the ring is full (the message is dropped and
+ *  				counted, LCD_RingDropped())
+ *  			- exactly one consumer: LCD_RingDrain() from the main loop, or
+ *  				LCD_RingDrainAsync() to move entries into the TIM4 queue
+ *  			- drained entries go straight to the module, like LCD_WriteData()
+ *  				and LCD_WriteControl() (framebuffer cells are not updated)
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Ring.h"
+#include "LCD_Async.h"
+#include "LCD_Stats.h"
+
+#if (LCD_USE_RING != 0u)
+
+#if ((LCD_RING_SIZE & (LCD_RING_SIZE - 1u)) != 0u)
+    #error "LCD_RING_SIZE must be a power of two"
+#endif /* (LCD_RING_SIZE & (LCD_RING_SIZE - 1u)) != 0u */
+
+/* Laps of the 32-bit positions, stamps count modulo 2 * LCD_RING_LAPS */
+#define LCD_RING_MASK                (LCD_RING_SIZE - 1u)
+#define LCD_RING_LAPS                ((0xFFFFFFFFu / LCD_RING_SIZE) + 1u)
+#define LCD_RING_LAP(position)       ((uint32_t) (position) / LCD_RING_SIZE)
+#define LCD_RING_FREE(lap)           ((uint32_t) ((lap) & (LCD_RING_LAPS - 1u)) * 2u)
+#define LCD_RING_FILLED(lap)         (LCD_RING_FREE(lap) + 1u)
+
+typedef struct
+{
+    volatile uint32_t stamp;
+    uint16_t item;
+} LCD_RING_SLOT;
+
+/* Zero-initialized: every slot is free for lap 0 */
+static LCD_RING_SLOT LCD_ring[LCD_RING_SIZE];
+static volatile uint32_t LCD_ringEnqueue = 0u;
+static uint32_t LCD_ringDequeue = 0u;
+static volatile uint32_t LCD_ringDropped = 0u;
+
+static uint8_t LCD_RingReserve(uint32_t count, uint32_t *first) ;
+static void LCD_RingFill(uint32_t position, uint16_t item) ;
+static uint8_t LCD_RingPeek(uint16_t *item) ;
+static void LCD_RingRelease(void) ;
+static void LCD_RingCountDrop(void) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_RingPush
+********************************************************************************
+*
+* Summary:
+*  Posts one command or data item.
+*
+* Parameters:
+*  item: LCD_ITEM_CMD(cByte) or LCD_ITEM_DATA(dByte)
+*
+* Return:
+*  1 if posted, 0 if the ring is full.
+*
+* Reentrant:
+*  Yes, from any interrupt or task.
+*
+*******************************************************************************/
+uint8_t LCD_RingPush(uint16_t item)
+{
+    return LCD_RingPushBuffer(&item, 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RingPushBuffer
+********************************************************************************
+*
+* Summary:
+*  Posts a run of items as one message: either all of them are posted,
+*  contiguous, or none.
+*
+* Parameters:
+*  items: LCD_ITEM_CMD()/LCD_ITEM_DATA() entries
+*  count: Number of entries, at most LCD_RING_SIZE
+*
+* Return:
+*  1 if posted, 0 if the ring has no room for the whole message.
+*
+* Reentrant:
+*  Yes, from any interrupt or task.
+*
+*******************************************************************************/
+uint8_t LCD_RingPushBuffer(uint16_t const items[], uint16_t count)
+{
+    uint32_t position;
+    uint16_t index;
+
+    if (count == 0u)
+    {
+        return 1u;
+    }
+
+    if (LCD_RingReserve(count, &position) == 0u)
+    {
+        LCD_RingCountDrop();
+        return 0u;
+    }
+
+    LCD_STAT_PEAK(ringPeak, (uint32_t) ((position + count) - LCD_ringDequeue));
+
+    for (index = 0u; index < count; index++)
+    {
+        LCD_RingFill(position + index, items[index]);
+    }
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RingPrintAt
+********************************************************************************
+*
+* Summary:
+*  Posts a set-DDRAM-address command and a zero terminated string as one
+*  message.
+*
+* Parameters:
+*  row:    Specific row of LCD module to be written
+*  column: Column of LCD module to be written
+*  string: Pointer to head of char8 array, at most LCD_RING_MESSAGE_MAX - 1
+*          characters are posted
+*
+* Return:
+*  1 if posted, 0 if the ring has no room for the whole message.
+*
+* Reentrant:
+*  Yes, from any interrupt or task.
+*
+*******************************************************************************/
+uint8_t LCD_RingPrintAt(uint8_t row, uint8_t column, char const string[])
+{
+    uint32_t position;
+    uint32_t length = 0u;
+    uint32_t index;
+
+    while ((length < (LCD_RING_MESSAGE_MAX - 1u)) && ((char) '\0' != string[length]))
+    {
+        length++;
+    }
+
+    if (LCD_RingReserve(length + 1u, &position) == 0u)
+    {
+        LCD_RingCountDrop();
+        return 0u;
+    }
+
+    LCD_RingFill(position, LCD_ITEM_CMD(LCD_DdramAddress(row, column)));
+    for (index = 0u; index < length; index++)
+    {
+        LCD_RingFill(position + 1u + index, LCD_ITEM_DATA(string[index]));
+    }
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RingPop
+********************************************************************************
+*
+* Summary:
+*  Takes the oldest posted item.
+*
+* Parameters:
+*  item: Receives the LCD_ITEM_CMD()/LCD_ITEM_DATA() entry
+*
+* Return:
+*  1 if an item was taken, 0 if the ring is empty (or the oldest slot is still
+*  being written by its producer).
+*
+* Reentrant:
+*  No, single consumer.
+*
+*******************************************************************************/
+uint8_t LCD_RingPop(uint16_t *item)
+{
+    if (LCD_RingPeek(item) == 0u)
+    {
+        return 0u;
+    }
+
+    LCD_RingRelease();
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RingDrain
+********************************************************************************
+*
+* Summary:
+*  Sends up to "maxItems" posted items with the blocking driver.
+*
+* Parameters:
+*  maxItems: Upper bound of items sent by this call (bounds the time spent)
+*
+* Return:
+*  Number of items sent.
+*
+* Reentrant:
+*  No, single consumer; call from the context that owns the display.
+*
+*******************************************************************************/
+uint16_t LCD_RingDrain(uint16_t maxItems)
+{
+    uint16_t item;
+    uint16_t sent = 0u;
+
+    while ((sent < maxItems) && (LCD_RingPop(&item) != 0u))
+    {
+        if ((item & LCD_ITEM_RS) != 0u)
+        {
+            LCD_WriteData((uint8_t) item);
+        }
+        else
+        {
+            LCD_WriteControl((uint8_t) item);
+        }
+        sent++;
+    }
+
+    return sent;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RingDrainAsync
+********************************************************************************
+*
+* Summary:
+*  Moves posted items into the interrupt-driven write queue until either the
+*  ring is empty or the queue is full.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Number of items moved (0 without LCD_USE_ASYNC).
+*
+* Reentrant:
+*  No, single consumer and single LCD_WriteAsync() producer.
+*
+*******************************************************************************/
+uint16_t LCD_RingDrainAsync(void)
+{
+    uint16_t moved = 0u;
+
+    #if (LCD_USE_ASYNC != 0u)
+        uint16_t item;
+
+        while (LCD_RingPeek(&item) != 0u)
+        {
+            if (LCD_WriteAsync(item) == 0u)
+            {
+                break;
+            }
+            LCD_RingRelease();
+            moved++;
+        }
+    #endif /* LCD_USE_ASYNC != 0u */
+
+    return moved;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RingDropped
+********************************************************************************
+*
+* Summary:
+*  Returns the number of messages rejected because the ring was full.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Dropped message count, saturated at 0xFFFF.
+*
+*******************************************************************************/
+uint16_t LCD_RingDropped(void)
+{
+    uint32_t dropped = LCD_ringDropped;
+
+    return (dropped > 0xFFFFu) ? 0xFFFFu : (uint16_t) dropped;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RingReserve
+********************************************************************************
+*
+* Summary:
+*  Claims "count" consecutive slots. Slots are freed in order, so the whole
+*  run is free when its last slot is free for this lap. The exclusive store
+*  fails if another producer (or an interrupt) claimed slots since the load,
+*  the check is then repeated.
+*
+*******************************************************************************/
+static uint8_t LCD_RingReserve(uint32_t count, uint32_t *first)
+{
+    uint32_t position;
+    uint32_t last;
+
+    if ((count == 0u) || (count > LCD_RING_SIZE))
+    {
+        return 0u;
+    }
+
+    do
+    {
+        position = __LDREXW(&LCD_ringEnqueue);
+        last = position + count - 1u;
+
+        if (LCD_ring[last & LCD_RING_MASK].stamp != LCD_RING_FREE(LCD_RING_LAP(last)))
+        {
+            __CLREX();
+            return 0u;
+        }
+
+    } while (__STREXW(position + count, &LCD_ringEnqueue) != 0u);
+
+    *first = position;
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RingFill
+********************************************************************************
+*
+* Summary:
+*  Stores the item of a claimed slot, then marks the slot filled.
+*
+*******************************************************************************/
+static void LCD_RingFill(uint32_t position, uint16_t item)
+{
+    LCD_RING_SLOT *slot = &LCD_ring[position & LCD_RING_MASK];
+
+    slot->item = item;
+
+    /* Item visible before the stamp that publishes it */
+    __DMB();
+    slot->stamp = LCD_RING_FILLED(LCD_RING_LAP(position));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RingPeek
+********************************************************************************
+*
+* Summary:
+*  Reads the oldest item if its producer has published it.
+*
+*******************************************************************************/
+static uint8_t LCD_RingPeek(uint16_t *item)
+{
+    uint32_t position = LCD_ringDequeue;
+    LCD_RING_SLOT *slot = &LCD_ring[position & LCD_RING_MASK];
+
+    if (slot->stamp != LCD_RING_FILLED(LCD_RING_LAP(position)))
+    {
+        return 0u;
+    }
+
+    __DMB();
+    *item = slot->item;
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RingRelease
+********************************************************************************
+*
+* Summary:
+*  Frees the oldest slot for the next lap and advances the dequeue position.
+*
+*******************************************************************************/
+static void LCD_RingRelease(void)
+{
+    uint32_t position = LCD_ringDequeue;
+
+    /* Item read before the slot is handed back to producers */
+    __DMB();
+    LCD_ring[position & LCD_RING_MASK].stamp = LCD_RING_FREE(LCD_RING_LAP(position) + 1u);
+    LCD_ringDequeue = position + 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RingCountDrop
+********************************************************************************
+*
+* Summary:
+*  Counts a rejected message (exclusive increment, producers may nest).
+*
+*******************************************************************************/
+static void LCD_RingCountDrop(void)
+{
+    uint32_t dropped;
+
+    do
+    {
+        dropped = __LDREXW(&LCD_ringDropped);
+    } while (__STREXW(dropped + 1u, &LCD_ringDropped) != 0u);
+}
+
+#endif /* LCD_USE_RING != 0u */
@@ -0,0 +1,393 @@
+/*
+ *  LCD_Rtos.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: CMSIS-RTOS2 display service for the HD44780 LCD driver.
+ *
+ *  			One service task owns the bus. Client tasks (and interrupts)
+ *  			queue requests - text at a position, a command byte, or a
+ *  			function to run with the bus - and return at once; the
+ *  			request is copied into the queue whole, so requests of
+ *  			different tasks never interleave on the display. The service
+ *  			task runs them through the blocking API, and the waits that
+ *  			would spin - the power-on and handshake steps of LCD_Init()
+ *  			and clear/home execution times - block it instead: LCD_Wfi.c
+ *  			arms TIM4 compare channel 2 and the task waits for the thread
+ *  			flag its interrupt sets. Waits below LCD_WFI_MIN_US and the
+ *  			E-strobe gaps are still spun.
+ *
+ *  Usage:      - LCD_RtosStart() after osKernelInitialize(), before
+ *  				osKernelStart(); the service task calls LCD_Init(), so
+ *  				main() must not
+ *  			- with LCD_USE_FRAMEBUFFER the task flushes once the queue is
+ *  				empty, a burst of requests costs one flush
+ *  			- only the service task may use the blocking API; other
+ *  				tasks go through LCD_RtosCall()
+ *  			- the TIM4 interrupt priority (LCD_WFI_IRQ_PRIORITY) must
+ *  				allow RTOS calls (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+ *  				or numerically higher)
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Rtos.h"
+#include "LCD_Timing.h"
+#include "LCD_Wfi.h"
+
+#if (LCD_USE_RTOS != 0u)
+
+#include "cmsis_os2.h"
+
+#if (LCD_USE_WFI == 0u)
+    #error "LCD_USE_RTOS blocks the service task on the TIM4 compare of LCD_Wfi.c (LCD_USE_WFI)"
+#endif /* LCD_USE_WFI == 0u */
+
+#if (LCD_DELAY_BACKEND != LCD_DELAY_DWT)
+    #error "LCD_USE_RTOS needs the DWT delay backend, the other backends spin in delay_us()"
+#endif /* LCD_DELAY_BACKEND != LCD_DELAY_DWT */
+
+/* Request kinds */
+#define LCD_RTOS_PRINT_AT            (0u)
+#define LCD_RTOS_COMMAND             (1u)
+#define LCD_RTOS_CALL                (2u)
+
+/* One queued request, copied into the queue */
+typedef struct
+{
+    uint8_t kind;
+    uint8_t row;
+    uint8_t column;
+    uint8_t length;
+    char text[LCD_RTOS_TEXT_MAX];
+    LCD_RtosFunction function;
+    void *argument;
+} LCD_RTOS_REQUEST;
+
+static osMessageQueueId_t LCD_rtosQueue = NULL;
+static osThreadId_t LCD_rtosThread = NULL;
+
+static const osThreadAttr_t LCD_rtosAttributes =
+{
+    .name = "LCD",
+    .stack_size = LCD_RTOS_STACK_BYTES,
+    .priority = (osPriority_t) LCD_RTOS_PRIORITY,
+};
+
+static void LCD_RtosTask(void *argument) ;
+static uint8_t LCD_RtosPut(LCD_RTOS_REQUEST const *request) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_RtosStart
+********************************************************************************
+*
+* Summary:
+*  Creates the request queue and the service task.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if both were created, 0 if the RTOS is out of memory.
+*
+*******************************************************************************/
+uint8_t LCD_RtosStart(void)
+{
+    LCD_rtosQueue = osMessageQueueNew(LCD_RTOS_QUEUE_SIZE, sizeof(LCD_RTOS_REQUEST), NULL);
+    if (LCD_rtosQueue == NULL)
+    {
+        return 0u;
+    }
+
+    LCD_rtosThread = osThreadNew(LCD_RtosTask, NULL, &LCD_rtosAttributes);
+
+    return (LCD_rtosThread != NULL) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RtosPrintAt
+********************************************************************************
+*
+* Summary:
+*  Queues text for a position without waiting.
+*
+* Parameters:
+*  row:    Row
+*  column: Column
+*  string: Text, copied; cut after LCD_RTOS_TEXT_MAX characters
+*
+* Return:
+*  1 if queued, 0 if the queue is full.
+*
+* Note:
+*  Can be called from interrupts.
+*
+*******************************************************************************/
+uint8_t LCD_RtosPrintAt(uint8_t row, uint8_t column, char const string[])
+{
+    LCD_RTOS_REQUEST request;
+    uint8_t length = 0u;
+
+    while ((length < LCD_RTOS_TEXT_MAX) && (string[length] != '\0'))
+    {
+        request.text[length] = string[length];
+        length++;
+    }
+
+    request.kind = LCD_RTOS_PRINT_AT;
+    request.row = row;
+    request.column = column;
+    request.length = length;
+
+    return LCD_RtosPut(&request);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RtosCommand
+********************************************************************************
+*
+* Summary:
+*  Queues a command byte (LCD_WriteControl() in the service task) without
+*  waiting.
+*
+* Parameters:
+*  command: Instruction byte
+*
+* Return:
+*  1 if queued, 0 if the queue is full.
+*
+*******************************************************************************/
+uint8_t LCD_RtosCommand(uint8_t command)
+{
+    LCD_RTOS_REQUEST request;
+
+    request.kind = LCD_RTOS_COMMAND;
+    request.row = command;      /* the command byte travels in "row" */
+    request.length = 0u;
+
+    return LCD_RtosPut(&request);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RtosCall
+********************************************************************************
+*
+* Summary:
+*  Queues a function that the service task runs with the bus, for anything
+*  the other requests do not cover (framebuffer screens, glyph uploads,
+*  LCD_Calibrate()). Returns without waiting.
+*
+* Parameters:
+*  function: Run in the service task, may use the blocking API
+*  argument: Passed to "function"
+*
+* Return:
+*  1 if queued, 0 if the queue is full.
+*
+*******************************************************************************/
+uint8_t LCD_RtosCall(LCD_RtosFunction function, void *argument)
+{
+    LCD_RTOS_REQUEST request;
+
+    request.kind = LCD_RTOS_CALL;
+    request.length = 0u;
+    request.function = function;
+    request.argument = argument;
+
+    return LCD_RtosPut(&request);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RtosIsService
+********************************************************************************
+*
+* Summary:
+*  Returns 1 when called from the service task with the kernel running, so
+*  a wait may block it.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 in the service task, 0 elsewhere.
+*
+*******************************************************************************/
+uint8_t LCD_RtosIsService(void)
+{
+    return ((__get_IPSR() == 0u) && (LCD_rtosThread != NULL) &&
+            (osKernelGetState() == osKernelRunning) && (osThreadGetId() == LCD_rtosThread)) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RtosWaitWake
+********************************************************************************
+*
+* Summary:
+*  Blocks the service task until the next LCD_RtosWake().
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+* Note:
+*  LCD_Wfi.c loops on its own wake flag around this, so a thread flag left
+*  over from an earlier sleep only costs one extra pass.
+*
+*******************************************************************************/
+void LCD_RtosWaitWake(void)
+{
+    (void) osThreadFlagsWait(LCD_RTOS_FLAG_WAKE, osFlagsWaitAny, osWaitForever);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RtosWake
+********************************************************************************
+*
+* Summary:
+*  Wakes the service task, from the TIM4 compare interrupt.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_RtosWake(void)
+{
+    if (LCD_rtosThread != NULL)
+    {
+        (void) osThreadFlagsSet(LCD_rtosThread, LCD_RTOS_FLAG_WAKE);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RtosYield
+********************************************************************************
+*
+* Summary:
+*  Gives the core away for one kernel tick, between the millisecond steps of
+*  LCD_InitPoll().
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_RtosYield(void)
+{
+    (void) osDelay(1u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RtosWaitExec
+********************************************************************************
+*
+* Summary:
+*  In the service task, sleeps through an execution time of at least
+*  LCD_WFI_MIN_US (clear, home) before the busy flag is polled; the poll
+*  then only confirms it.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_RtosWaitExec(void)
+{
+    uint32_t const remaining = LCD_TimingRemaining();
+
+    if ((remaining >= (LCD_WFI_MIN_US * LCD_cyclesPerUs)) && (LCD_RtosIsService() != 0u))
+    {
+        LCD_WfiWaitCycles(remaining);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RtosTask
+********************************************************************************
+*
+* Summary:
+*  Service task: initializes the display, then runs the queued requests.
+*  With the framebuffer it flushes once the queue has run empty.
+*
+*******************************************************************************/
+static void LCD_RtosTask(void *argument)
+{
+    LCD_RTOS_REQUEST request;
+
+    (void) argument;
+
+    LCD_Init();
+
+    while (1)
+    {
+        if (osMessageQueueGet(LCD_rtosQueue, &request, NULL, osWaitForever) != osOK)
+        {
+            continue;
+        }
+
+        if (request.kind == LCD_RTOS_PRINT_AT)
+        {
+            LCD_Position(request.row, request.column);
+            LCD_PrintStringN(request.text, request.length);
+        }
+        else if (request.kind == LCD_RTOS_COMMAND)
+        {
+            LCD_WriteControl(request.row);
+        }
+        else if ((request.kind == LCD_RTOS_CALL) && (request.function != NULL))
+        {
+            request.function(request.argument);
+        }
+        else
+        {
+        }
+
+        #if (LCD_USE_FRAMEBUFFER != 0u)
+            if ((LCD_frameDirty != 0u) && (osMessageQueueGetCount(LCD_rtosQueue) == 0u))
+            {
+                LCD_FlushFrame();
+            }
+        #endif /* LCD_USE_FRAMEBUFFER != 0u */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_RtosPut
+********************************************************************************
+*
+* Summary:
+*  Copies a request into the queue, never waiting for space.
+*
+*******************************************************************************/
+static uint8_t LCD_RtosPut(LCD_RTOS_REQUEST const *request)
+{
+    if (LCD_rtosQueue == NULL)
+    {
+        return 0u;
+    }
+
+    return (osMessageQueuePut(LCD_rtosQueue, request, 0u, 0u) == osOK) ? 1u : 0u;
+}
+
+#endif /* LCD_USE_RTOS != 0u */
@@ -0,0 +1,269 @@
+/*
+ *  LCD_Scrub.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Background read-back scrubber of the HD44780 LCD driver.
+ *
+ *  			ESD and EMI can flip DDRAM or CGRAM bytes, or the controller
+ *  			state, without the driver noticing. Each LCD_ScrubPoll()
+ *  			reads LCD_SCRUB_CELLS bytes back from the module
+ *  			(LCD_ReadData(), RS and R/W high) and compares them with what
+ *  			was last sent: LCD_glass for the visible cells, then
+ *  			LCD_cgramShadow for the uploaded CGRAM slots. A byte that
+ *  			differs is written again on its own, so a repair costs the
+ *  			bytes that went bad and nothing is redrawn periodically. The
+ *  			same window is read again on the next call; when it is still
+ *  			wrong after LCD_SCRUB_RETRIES repairs the writes do not stick,
+ *  			and LCD_RecoverRequest() has LCD_RecoverPoll() run the
+ *  			function set handshake and replay the mirrored state.
+ *
+ *  Usage:      - call LCD_ScrubPoll() from the main loop when the bus is
+ *  				free (not while LCD_IsIdle() is 0 or a DMA stream runs),
+ *  				with LCD_RecoverPoll()
+ *  			- works on the primary display; cells whose glass copy is
+ *  				unknown (not flushed yet) are skipped
+ *  			- a shown cursor is put back after the reads while cursor
+ *  				tracking knows where it was
+ *  			- needs a wiring that can read (GPIO transport)
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Glyph.h"
+#include "LCD_Geometry.h"
+#include "LCD_Handle.h"
+#include "LCD_Transport.h"
+#include "LCD_Recover.h"
+#include "LCD_Scrub.h"
+#include "LCD_Warm.h"
+
+#if (LCD_USE_SCRUB != 0u)
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    #error "LCD_USE_SCRUB compares against the glass copy of the framebuffer (LCD_USE_FRAMEBUFFER)"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+#if (LCD_USE_LINK_RECOVERY == 0u)
+    #error "LCD_USE_SCRUB re-initializes through LCD_RecoverPoll() (LCD_USE_LINK_RECOVERY)"
+#endif /* LCD_USE_LINK_RECOVERY == 0u */
+
+#if (LCD_TRANSPORT_HAS_GPIO == 0u)
+    #error "LCD_USE_SCRUB reads the module back (LCD_TRANSPORT_GPIO or _RUNTIME)"
+#endif /* LCD_TRANSPORT_HAS_GPIO == 0u */
+
+/* Next byte to read: visible cells in reading order, then CGRAM */
+static uint16_t LCD_scrubIndex = 0u;
+
+/* Repairs of the current window that did not stick */
+static uint8_t LCD_scrubRetries = 0u;
+
+static uint8_t LCD_ScrubDdram(uint8_t row, uint8_t column, uint8_t count) ;
+static uint8_t LCD_ScrubCgram(uint8_t address, uint8_t count) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_ScrubPoll
+********************************************************************************
+*
+* Summary:
+*  Reads the next LCD_SCRUB_CELLS bytes back, rewrites the ones that differ
+*  and requests a re-initialization when a window stays wrong.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Number of bytes rewritten.
+*
+*******************************************************************************/
+uint8_t LCD_ScrubPoll(void)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_active->geometry;
+    uint16_t const cells = (uint16_t) geometry->rows * geometry->columns;
+    uint8_t const cursor = LCD_active->cursorAddress;
+    uint8_t cgram;
+    uint8_t repaired;
+    uint8_t count = LCD_SCRUB_CELLS;
+    uint8_t column;
+
+    if (LCD_scrubIndex >= (cells + LCD_SCRUB_CGRAM_BYTES))
+    {
+        /* Pass done, or the geometry changed */
+        LCD_scrubIndex = 0u;
+    }
+    cgram = (LCD_scrubIndex >= cells) ? 1u : 0u;
+
+    if ((LCD_IS_PRIMARY() == 0u) || (LCD_active->initVar == 0u) || (LCD_active->linkState != LCD_LINK_UP))
+    {
+        return 0u;
+    }
+
+    /* The reads have to walk the counter upwards */
+    LCD_SetEntryDirection(1u);
+
+    if (cgram == 0u)
+    {
+        /* A window ends with its row */
+        column = (uint8_t) (LCD_scrubIndex % geometry->columns);
+        if (count > (geometry->columns - column))
+        {
+            count = geometry->columns - column;
+        }
+        repaired = LCD_ScrubDdram((uint8_t) (LCD_scrubIndex / geometry->columns), column, count);
+    }
+    else
+    {
+        if (count > ((cells + LCD_SCRUB_CGRAM_BYTES) - LCD_scrubIndex))
+        {
+            count = (uint8_t) ((cells + LCD_SCRUB_CGRAM_BYTES) - LCD_scrubIndex);
+        }
+        repaired = LCD_ScrubCgram((uint8_t) (LCD_scrubIndex - cells), count);
+    }
+
+    if (repaired == 0u)
+    {
+        LCD_scrubIndex += count;
+        LCD_scrubRetries = 0u;
+    }
+    else if (LCD_scrubRetries < LCD_SCRUB_RETRIES)
+    {
+        /* Read the window again next time, to see the repair stuck */
+        LCD_scrubRetries++;
+    }
+    else
+    {
+        /* Rewrites do not stick: the controller state itself is bad */
+        LCD_scrubRetries = 0u;
+        LCD_RecoverRequest();
+        return repaired;
+    }
+
+    if (cgram != 0u)
+    {
+        /* Back out of CGRAM, to the cursor if it is known */
+        LCD_WriteControl(LCD_DDRAM_0 | ((cursor != LCD_CURSOR_UNKNOWN) ? cursor : 0u));
+    }
+    else if (((LCD_active->displayControl & LCD_SCRUB_CURSOR_SHOWN) != 0u) && (cursor != LCD_CURSOR_UNKNOWN) &&
+             (LCD_active->cursorAddress != cursor))
+    {
+        LCD_WriteControl(LCD_DDRAM_0 | cursor);
+    }
+    else
+    {
+        /* The flush sets its own addresses */
+    }
+
+    return repaired;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ScrubDdram
+********************************************************************************
+*
+* Summary:
+*  Compares cells of one row with the glass copy and rewrites the ones that
+*  differ.
+*
+*******************************************************************************/
+static uint8_t LCD_ScrubDdram(uint8_t row, uint8_t column, uint8_t count)
+{
+    uint8_t repaired = 0u;
+    uint8_t next = LCD_CURSOR_UNKNOWN;
+    uint8_t command;
+    uint16_t glass;
+    uint16_t value;
+
+    for (; count > 0u; count--)
+    {
+        glass = LCD_glass[row][column];
+        command = LCD_DdramAddress(row, column);
+        column++;
+
+        if (glass == LCD_FRAME_UNKNOWN)
+        {
+            /* Sent again by the next flush anyway */
+            next = LCD_CURSOR_UNKNOWN;
+            continue;
+        }
+
+        if (command != next)
+        {
+            LCD_WriteControl(command);
+        }
+        value = LCD_ReadData();
+        if (value == LCD_READ_NONE)
+        {
+            break;
+        }
+        next = command + 1u;
+
+        if (value != glass)
+        {
+            LCD_WriteControl(command);
+            LCD_WriteData((uint8_t) glass);
+            repaired++;
+
+            /* A read right after a write needs its address set again */
+            next = LCD_CURSOR_UNKNOWN;
+        }
+    }
+
+    return repaired;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ScrubCgram
+********************************************************************************
+*
+* Summary:
+*  Compares CGRAM bytes of the uploaded slots with the shadow and rewrites
+*  the ones that differ. Slots never uploaded are skipped.
+*
+*******************************************************************************/
+static uint8_t LCD_ScrubCgram(uint8_t address, uint8_t count)
+{
+    uint8_t repaired = 0u;
+    uint8_t next = LCD_CURSOR_UNKNOWN;
+    uint16_t value;
+
+    for (; count > 0u; count--, address++)
+    {
+        if ((LCD_cgramWritten & (1u << (address / LCD_GLYPH_ROWS))) == 0u)
+        {
+            next = LCD_CURSOR_UNKNOWN;
+            continue;
+        }
+
+        if (address != next)
+        {
+            LCD_WriteControl(LCD_CGRAM_0 | address);
+        }
+        value = LCD_ReadData();
+        if (value == LCD_READ_NONE)
+        {
+            break;
+        }
+        next = address + 1u;
+
+        if (((value ^ LCD_cgramShadow[address]) & LCD_SCRUB_CGRAM_MASK) != 0u)
+        {
+            LCD_WriteControl(LCD_CGRAM_0 | address);
+            #if (LCD_USE_WARM_START != 0u)
+                LCD_WriteData(LCD_cgramShadow[address] | LCD_WarmBits(address));
+            #else
+                LCD_WriteData(LCD_cgramShadow[address]);
+            #endif /* LCD_USE_WARM_START != 0u */
+            repaired++;
+            next = LCD_CURSOR_UNKNOWN;
+        }
+    }
+
+    return repaired;
+}
+
+#endif /* LCD_USE_SCRUB != 0u */
@@ -0,0 +1,545 @@
+/*
+ *  LCD_Spi.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: 74HC595 shift-register transport for the HD44780 LCD driver.
+ *
+ *  			The module hangs off a 74HC595 (Q0 RS, Q1 R/nW, Q2 E, Q3
+ *  			backlight, Q4-Q7 DB4-DB7) on three pins: SPI1 SCK (PA5) to
+ *  			SRCLK, SPI1 MOSI (PA7) to SER and TIM1 CH1 (PA8) to RCLK.
+ *
+ *  			LCD_WriteData()/LCD_WriteControl() queue their byte; the queue
+ *  			is encoded into shift-register states (data + RS with E low, E
+ *  			high, E low per nibble, then idle steps for the execution time)
+ *  			in a small ping-pong buffer, like LCD_Dma.c. TIM1 paces the
+ *  			stream: each update event requests DMA1 Channel 5, which writes
+ *  			one state into the SPI1 data register, and CH1 in PWM mode 2
+ *  			raises RCLK later in the same step, once the 8 bits are shifted
+ *  			in. The outputs change together on that edge, E strobes stay
+ *  			one step wide, and the CPU only refills a half buffer from the
+ *  			half/full transfer interrupts.
+ *
+ *  			The hardware NSS of the STM32F1 SPI stays low for as long as
+ *  			the SPI is enabled (no pulse between frames), so it cannot latch
+ *  			the 595 per byte; the latch edge comes from the pacing timer.
+ *
+ *  Usage:      - call LCD_SpiIRQHandler() from DMA1_Channel5_IRQHandler
+ *  			- TIM1, SPI1 and DMA1 Channel 5 are owned by this module
+ *  			- not callable from interrupts, a full queue waits for the stream
+ *
+ */
+#include "main.h"
+#include "stm32f1xx_ll_tim.h"
+#include "LCD.h"
+#include "LCD_Spi.h"
+#include "LCD_Transport.h"
+
+#if (LCD_USE_SPI_TRANSPORT != 0u)
+
+#if (LCD_BUS_8BIT != 0u)
+    #error "LCD_USE_SPI_TRANSPORT drives a 4-bit bus (DB4-DB7 on Q4-Q7)"
+#endif /* LCD_BUS_8BIT != 0u */
+
+#if ((LCD_USE_MULTI_DISPLAY != 0u) && (LCD_TRANSPORT != LCD_TRANSPORT_RUNTIME))
+    #error "LCD_TRANSPORT_SPI drives the single module on the 74HC595, bind it per display with LCD_TRANSPORT_RUNTIME"
+#endif /* (LCD_USE_MULTI_DISPLAY != 0u) && (LCD_TRANSPORT != LCD_TRANSPORT_RUNTIME) */
+
+#if ((LCD_BUS_MASK_PRIORITY != 0u) && (LCD_SPI_IRQ_PRIORITY < LCD_BUS_MASK_PRIORITY))
+    #error "LCD_SPI_IRQ_PRIORITY above LCD_BUS_MASK_PRIORITY, the DMA interrupt would run in the middle of a hand-off"
+#endif /* (LCD_BUS_MASK_PRIORITY != 0u) && (LCD_SPI_IRQ_PRIORITY < LCD_BUS_MASK_PRIORITY) */
+
+/* Queue item flags on top of the LCD_ITEM_DATA()/LCD_ITEM_CMD() encoding */
+#define LCD_SPI_ITEM_NIBBLE          (0x0200u) /* high nibble only (handshake) */
+#define LCD_SPI_ITEM_IDLE            (0x0400u) /* one idle state (backlight change) */
+
+/* DMA request to the DR write and the RCLK edge after the last bit, ns */
+#define LCD_SPI_DMA_LATENCY_NS       (250u)
+
+/* Queued items, filled by the CPU and drained by the DMA interrupt */
+static uint16_t LCD_spiQueue[LCD_SPI_QUEUE_SIZE];
+static volatile uint16_t LCD_spiHead = 0u;
+static volatile uint16_t LCD_spiTail = 0u;
+
+/* Ping-pong buffer of shift-register states */
+static uint8_t LCD_spiBuffer[2u * LCD_SPI_HALF_STATES];
+
+/* Encoder state: item in progress, its step and idle steps still to send */
+static uint16_t LCD_spiItem;
+static uint8_t LCD_spiPhase = 0u;
+static uint16_t LCD_spiPad = 0u;
+static uint8_t LCD_spiIdle = LCD_SPI_BACKLIGHT;
+
+/* Backlight (and any other static output) of every state */
+static volatile uint8_t LCD_spiPortBits = LCD_SPI_BACKLIGHT;
+
+/* Halves holding stream states that the DMA has not played yet */
+static uint8_t LCD_spiPending;
+static volatile uint8_t LCD_spiBusy = 0u;
+
+static void LCD_SpiPush(uint16_t item) ;
+static void LCD_SpiRun(void) ;
+static uint8_t LCD_SpiFill(uint8_t *dst) ;
+
+#if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+    static void LCD_SpiBusStart(void) ;
+
+    /* The busy flag is not read, execution times are padded into the stream */
+    const LCD_Transport LCD_transportSpi =
+    {
+        LCD_SpiBusStart, LCD_SpiWriteByte, LCD_SpiWriteHandshake, LCD_SpiWriteBuffer,
+        NULL, LCD_SpiSync, NULL, NULL, NULL, NULL
+    };
+#endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+
+
+/*******************************************************************************
+* Function Name: LCD_SpiStart
+********************************************************************************
+*
+* Summary:
+*  Configures SPI1 (master, transmit only, no DMA request of its own), TIM1
+*  (one step per LCD_SPI_STEP_NS, CH1 PWM mode 2 as the latch) and DMA1
+*  Channel 5 (memory to SPI1 data register on TIM1 update, circular).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 on success, 0 if a state cannot be shifted in within one step at the
+*  SPI clock of LCD_SPI_BAUD_BR.
+*
+* Note:
+*  Called by LCD_InitBegin().
+*
+*******************************************************************************/
+uint8_t LCD_SpiStart(void)
+{
+    uint32_t timerClock;
+    uint32_t stepTicks;
+    uint32_t latchTicks;
+    uint32_t shiftNs;
+
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_GPIOA);
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_SPI1);
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_TIM1);
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+
+    /* APB2 timers run at twice PCLK2 whenever the APB2 prescaler is not 1 */
+    timerClock = HAL_RCC_GetPCLK2Freq();
+    shiftNs = (uint32_t) ((8000000000ull << (LCD_SPI_BAUD_BR + 1u)) / timerClock) + LCD_SPI_DMA_LATENCY_NS;
+    if (timerClock != HAL_RCC_GetHCLKFreq())
+    {
+        timerClock *= 2u;
+    }
+    stepTicks = (uint32_t) (((uint64_t) timerClock * LCD_SPI_STEP_NS) / 1000000000u);
+    latchTicks = (uint32_t) (((uint64_t) timerClock * shiftNs) / 1000000000u) + 1u;
+    if ((latchTicks + 1u) >= stepTicks)
+    {
+        return 0u;
+    }
+
+    /* PA5 = SCK, PA7 = MOSI, PA8 = TIM1 CH1 (RCLK) */
+    LL_GPIO_SetPinMode(GPIOA, LL_GPIO_PIN_5 | LL_GPIO_PIN_7 | LL_GPIO_PIN_8, LL_GPIO_MODE_ALTERNATE);
+    LL_GPIO_SetPinOutputType(GPIOA, LL_GPIO_PIN_5 | LL_GPIO_PIN_7 | LL_GPIO_PIN_8, LL_GPIO_OUTPUT_PUSHPULL);
+    LL_GPIO_SetPinSpeed(GPIOA, LL_GPIO_PIN_5, LL_GPIO_SPEED_FREQ_HIGH);
+    LL_GPIO_SetPinSpeed(GPIOA, LL_GPIO_PIN_7, LL_GPIO_SPEED_FREQ_HIGH);
+    LL_GPIO_SetPinSpeed(GPIOA, LL_GPIO_PIN_8, LL_GPIO_SPEED_FREQ_HIGH);
+
+    /* Mode 0, MSB first: the first bit shifted ends up on Q7 (DB7) */
+    SPI1->CR1 = 0u;
+    SPI1->CR1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI |
+                (((uint32_t) LCD_SPI_BAUD_BR << SPI_CR1_BR_Pos) & SPI_CR1_BR);
+    SPI1->CR2 = 0u;
+    SPI1->CR1 |= SPI_CR1_SPE;
+
+    LL_TIM_DisableCounter(TIM1);
+    LL_TIM_SetPrescaler(TIM1, 0u);
+    LL_TIM_SetAutoReload(TIM1, stepTicks - 1u);
+    LL_TIM_SetRepetitionCounter(TIM1, 0u);
+    LL_TIM_OC_SetMode(TIM1, LL_TIM_CHANNEL_CH1, LL_TIM_OCMODE_PWM2);
+    LL_TIM_OC_SetPolarity(TIM1, LL_TIM_CHANNEL_CH1, LL_TIM_OCPOLARITY_HIGH);
+    LL_TIM_OC_SetCompareCH1(TIM1, latchTicks);
+    LL_TIM_CC_EnableChannel(TIM1, LL_TIM_CHANNEL_CH1);
+    LL_TIM_EnableAllOutputs(TIM1);
+    LL_TIM_GenerateEvent_UPDATE(TIM1);
+    LL_TIM_ClearFlag_UPDATE(TIM1);
+    LL_TIM_EnableDMAReq_UPDATE(TIM1);
+
+    LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_5);
+    LL_DMA_ConfigTransfer(DMA1, LL_DMA_CHANNEL_5,
+                          LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_MODE_CIRCULAR |
+                          LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                          LL_DMA_PDATAALIGN_HALFWORD | LL_DMA_MDATAALIGN_BYTE |
+                          LL_DMA_PRIORITY_HIGH);
+    LL_DMA_ConfigAddresses(DMA1, LL_DMA_CHANNEL_5, (uint32_t) LCD_spiBuffer,
+                           (uint32_t) &SPI1->DR, LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
+    LL_DMA_EnableIT_HT(DMA1, LL_DMA_CHANNEL_5);
+    LL_DMA_EnableIT_TC(DMA1, LL_DMA_CHANNEL_5);
+
+    HAL_NVIC_SetPriority(DMA1_Channel5_IRQn, LCD_SPI_IRQ_PRIORITY, 0u);
+    HAL_NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+
+    LCD_spiHead = 0u;
+    LCD_spiTail = 0u;
+    LCD_spiPhase = 0u;
+    LCD_spiPad = 0u;
+    LCD_spiBusy = 0u;
+
+    /* The 595 powers up with random outputs, latch an idle state first */
+    LCD_SpiPush(LCD_SPI_ITEM_IDLE | LCD_spiPortBits);
+
+    return 1u;
+}
+
+
+#if (LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME)
+/*******************************************************************************
+* Function Name: LCD_SpiBusStart
+********************************************************************************
+*
+* Summary:
+*  LCD_SpiStart() for the transport table; a step too short for the SPI
+*  clock shows up as a blank display, as with LCD_TRANSPORT_SPI.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static void LCD_SpiBusStart(void)
+{
+    (void) LCD_SpiStart();
+}
+#endif /* LCD_TRANSPORT == LCD_TRANSPORT_RUNTIME */
+
+
+/*******************************************************************************
+* Function Name: LCD_SpiWriteByte
+********************************************************************************
+*
+* Summary:
+*  Queues a command or data byte; the stream is started if it is not running.
+*
+* Parameters:
+*  value: Command or data byte
+*  rs:    0 = instruction register, 1 = data register
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_SpiWriteByte(uint8_t value, uint8_t rs)
+{
+    LCD_SpiPush((rs != 0u) ? LCD_ITEM_DATA(value) : LCD_ITEM_CMD(value));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SpiWriteHandshake
+********************************************************************************
+*
+* Summary:
+*  Sends one function set nibble of the interface handshake and waits until
+*  the stream ended, so the caller's datasheet wait starts after the strobe.
+*
+* Parameters:
+*  nibble: LCD_DISPLAY_8_BIT_INIT or LCD_DISPLAY_4_BIT_INIT
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_SpiWriteHandshake(uint8_t nibble)
+{
+    LCD_SpiPush(LCD_SPI_ITEM_NIBBLE | (uint16_t) ((uint8_t) (nibble << LCD_NIBBLE_SHIFT)));
+    (void) LCD_SpiSync();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SpiWriteBuffer
+********************************************************************************
+*
+* Summary:
+*  Queues a run of data bytes, each padded to the data execution time.
+*
+* Parameters:
+*  buffer: Bytes to write
+*  length: Number of bytes
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_SpiWriteBuffer(uint8_t const buffer[], size_t length)
+{
+    size_t index;
+
+    for (index = 0u; index < length; index++)
+    {
+        LCD_SpiWriteByte(buffer[index], 1u);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SpiSync
+********************************************************************************
+*
+* Summary:
+*  Waits until every queued item, and its execution time, went out.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1, the shift register gives no feedback.
+*
+*******************************************************************************/
+uint8_t LCD_SpiSync(void)
+{
+    while (LCD_spiBusy != 0u)
+    {
+    }
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SpiIsBusy
+********************************************************************************
+*
+* Summary:
+*  Reports whether the stream is still running.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 while busy, 0 when idle.
+*
+*******************************************************************************/
+uint8_t LCD_SpiIsBusy(void)
+{
+    return LCD_spiBusy;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SpiSetBacklight
+********************************************************************************
+*
+* Summary:
+*  Switches the backlight output (Q3), in order with the queued writes.
+*
+* Parameters:
+*  on: 0 = off, otherwise on
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_SpiSetBacklight(uint8_t on)
+{
+    LCD_SpiPush((on != 0u) ? (LCD_SPI_ITEM_IDLE | LCD_SPI_BACKLIGHT) : LCD_SPI_ITEM_IDLE);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SpiIRQHandler
+********************************************************************************
+*
+* Summary:
+*  Half/full transfer interrupt. Refills the half the DMA just played, or
+*  stops the timer and DMA once the queue is empty and the last execution
+*  time went out.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_SpiIRQHandler(void)
+{
+    uint8_t *played;
+
+    if (LL_DMA_IsActiveFlag_HT5(DMA1) != 0u)
+    {
+        LL_DMA_ClearFlag_HT5(DMA1);
+        played = &LCD_spiBuffer[0u];
+    }
+    else if (LL_DMA_IsActiveFlag_TC5(DMA1) != 0u)
+    {
+        LL_DMA_ClearFlag_TC5(DMA1);
+        played = &LCD_spiBuffer[LCD_SPI_HALF_STATES];
+    }
+    else
+    {
+        LL_DMA_ClearFlag_GI5(DMA1);
+        return;
+    }
+
+    if (LCD_spiPending != 0u)
+    {
+        LCD_spiPending--;
+    }
+
+    if ((LCD_spiPending == 0u) && (LCD_spiHead == LCD_spiTail) &&
+        (LCD_spiPhase == 0u) && (LCD_spiPad == 0u))
+    {
+        /* The shift register holds an idle state, a stray latch edge is harmless */
+        LL_TIM_DisableCounter(TIM1);
+        LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_5);
+        LCD_spiBusy = 0u;
+    }
+    else
+    {
+        LCD_spiPending += LCD_SpiFill(played);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SpiPush
+********************************************************************************
+*
+* Summary:
+*  Appends an item, waiting for room, and starts the stream when it is idle.
+*  The interrupt stops the stream only with the queue seen empty, so the
+*  idle test is done with interrupts masked.
+*
+*******************************************************************************/
+static void LCD_SpiPush(uint16_t item)
+{
+    uint32_t mask;
+
+    while ((uint16_t) (LCD_spiHead - LCD_spiTail) >= LCD_SPI_QUEUE_SIZE)
+    {
+        /* The running stream frees entries */
+    }
+
+    LCD_spiQueue[LCD_spiHead & (LCD_SPI_QUEUE_SIZE - 1u)] = item;
+    LCD_spiHead = LCD_spiHead + 1u;
+
+    LCD_BUS_ATOMIC_BEGIN(mask);
+    if (LCD_spiBusy == 0u)
+    {
+        LCD_SpiRun();
+    }
+    LCD_BUS_ATOMIC_END(mask);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SpiRun
+********************************************************************************
+*
+* Summary:
+*  Fills both halves and starts TIM1; the update event generated here sends
+*  the first state at once.
+*
+*******************************************************************************/
+static void LCD_SpiRun(void)
+{
+    LCD_spiBusy = 1u;
+    LCD_spiPending = 0u;
+    LCD_spiPending += LCD_SpiFill(&LCD_spiBuffer[0u]);
+    LCD_spiPending += LCD_SpiFill(&LCD_spiBuffer[LCD_SPI_HALF_STATES]);
+
+    LL_DMA_ClearFlag_GI5(DMA1);
+    LL_DMA_SetDataLength(DMA1, LL_DMA_CHANNEL_5, 2u * LCD_SPI_HALF_STATES);
+    LL_DMA_EnableChannel(DMA1, LL_DMA_CHANNEL_5);
+    LL_TIM_SetCounter(TIM1, 0u);
+    LL_TIM_GenerateEvent_UPDATE(TIM1);
+    LL_TIM_EnableCounter(TIM1);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SpiFill
+********************************************************************************
+*
+* Summary:
+*  Encodes the next LCD_SPI_HALF_STATES steps of the queue. Steps past the
+*  end of the queue repeat the idle state (E low).
+*
+* Parameters:
+*  dst: Half buffer to fill
+*
+* Return:
+*  1 if the half holds stream states, 0 if it is idle padding only.
+*
+*******************************************************************************/
+static uint8_t LCD_SpiFill(uint8_t *dst)
+{
+    uint16_t step;
+    uint8_t used = 0u;
+    uint8_t port;
+    uint8_t nibble;
+    uint8_t last;
+
+    for (step = 0u; step < LCD_SPI_HALF_STATES; step++)
+    {
+        if (LCD_spiPad != 0u)
+        {
+            /* Waiting for the execution time of the previous byte */
+            dst[step] = LCD_spiIdle;
+            LCD_spiPad--;
+            used = 1u;
+            continue;
+        }
+
+        if (LCD_spiPhase == 0u)
+        {
+            if (LCD_spiHead == LCD_spiTail)
+            {
+                dst[step] = LCD_spiIdle;
+                continue;
+            }
+            LCD_spiItem = LCD_spiQueue[LCD_spiTail & (LCD_SPI_QUEUE_SIZE - 1u)];
+            LCD_spiTail = LCD_spiTail + 1u;
+        }
+        used = 1u;
+
+        if ((LCD_spiItem & LCD_SPI_ITEM_IDLE) != 0u)
+        {
+            LCD_spiPortBits = (uint8_t) (LCD_spiItem & LCD_SPI_BACKLIGHT);
+            LCD_spiIdle = (uint8_t) ((LCD_spiIdle & ~LCD_SPI_BACKLIGHT) | LCD_spiPortBits);
+            dst[step] = LCD_spiIdle;
+            continue;
+        }
+
+        port = LCD_spiPortBits | (((LCD_spiItem & LCD_ITEM_RS) != 0u) ? LCD_SPI_RS : 0u);
+        nibble = (LCD_spiPhase < LCD_SPI_STATES_PER_NIBBLE) ?
+                 (uint8_t) ((LCD_spiItem >> LCD_NIBBLE_SHIFT) & LCD_NIBBLE_MASK) :
+                 (uint8_t) (LCD_spiItem & LCD_NIBBLE_MASK);
+        dst[step] = (uint8_t) ((uint8_t) (nibble << LCD_SPI_DATA_SHIFT) | port);
+
+        if ((LCD_spiPhase % LCD_SPI_STATES_PER_NIBBLE) == 1u)
+        {
+            /* E high for one step, the next step's falling edge latches */
+            dst[step] |= LCD_SPI_E;
+        }
+
+        LCD_spiPhase++;
+        last = ((LCD_spiItem & LCD_SPI_ITEM_NIBBLE) != 0u) ? LCD_SPI_STATES_PER_NIBBLE : LCD_SPI_STATES_PER_BYTE;
+        if (LCD_spiPhase >= last)
+        {
+            LCD_spiPhase = 0u;
+            LCD_spiIdle = dst[step];
+            LCD_spiPad = (((LCD_spiItem & LCD_ITEM_RS) == 0u) && LCD_IS_LONG_CMD(LCD_spiItem & 0xFFu)) ?
+                         LCD_SPI_PAD(LCD_EXEC_LONG_US) : LCD_SPI_PAD(LCD_EXEC_SHORT_US);
+        }
+    }
+
+    return used;
+}
+
+#endif /* LCD_USE_SPI_TRANSPORT != 0u */
@@ -0,0 +1,144 @@
+/*
+ *  LCD_Stats.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Performance counters for the HD44780 LCD driver.
+ *
+ *  			With LCD_USE_STATS set the hot paths of LCD.c and LCD_Frame.c
+ *  			count bytes, commands, busy polls and timeouts, and time
+ *  			LCD_IsReady() and LCD_FlushFrame() on the DWT cycle counter.
+ *  			With LCD_USE_STATS clear the LCD_STAT_ macros expand to nothing.
+ *  			The update latency histograms of LCD_Latency.c are read with
+ *  			LCD_GetLatency() and cleared with the counters.
+ *
+ *  Usage:      - LCD_GetStats(&stats) from the main loop or a debugger
+ *  				script, divide cycles by LCD_cyclesPerUs for us
+ *  			- counters are not updated atomically, read them from the
+ *  				context that owns the display
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Stats.h"
+#include "LCD_Arena.h"
+#include "LCD_Latency.h"
+
+#if (LCD_USE_STATS != 0u)
+
+LCD_STATS LCD_stats;
+
+
+/*******************************************************************************
+* Function Name: LCD_GetStats
+********************************************************************************
+*
+* Summary:
+*  Copies the counters, computes the average busy wait and adds up the arena
+*  use of the owners.
+*
+* Parameters:
+*  stats: Receives the counters
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_GetStats(LCD_STATS *stats)
+{
+    #if (LCD_USE_ARENA != 0u)
+        uint8_t owner;
+    #endif /* LCD_USE_ARENA != 0u */
+
+    *stats = LCD_stats;
+
+    stats->busyCyclesAverage = (LCD_stats.busyWaits != 0u) ?
+                               (LCD_stats.busyCyclesTotal / LCD_stats.busyWaits) : 0u;
+
+    #if (LCD_USE_ARENA != 0u)
+        for (owner = 0u; owner < LCD_ARENA_OWNERS; owner++)
+        {
+            stats->arenaBytes += LCD_ArenaUsed(owner);
+            stats->arenaPeak += LCD_ArenaPeak(owner);
+        }
+    #endif /* LCD_USE_ARENA != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ResetStats
+********************************************************************************
+*
+* Summary:
+*  Zeroes every counter, and the latency histograms (LCD_USE_LATENCY).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_ResetStats(void)
+{
+    static const LCD_STATS LCD_statsZero = { 0u };
+
+    LCD_stats = LCD_statsZero;
+
+    #if (LCD_USE_LATENCY != 0u)
+        LCD_LatencyReset();
+    #endif /* LCD_USE_LATENCY != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_StatBusy
+********************************************************************************
+*
+* Summary:
+*  Accounts the duration of one LCD_IsReady() call.
+*
+* Parameters:
+*  cycles: Duration in core cycles
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_StatBusy(uint32_t cycles)
+{
+    LCD_stats.busyWaits++;
+    LCD_stats.busyCyclesTotal += cycles;
+    if (cycles > LCD_stats.busyCyclesMax)
+    {
+        LCD_stats.busyCyclesMax = cycles;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_StatFlush
+********************************************************************************
+*
+* Summary:
+*  Accounts the duration of one LCD_FlushFrame() call.
+*
+* Parameters:
+*  cycles: Duration in core cycles
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_StatFlush(uint32_t cycles)
+{
+    LCD_stats.flushes++;
+    LCD_stats.flushCyclesLast = cycles;
+    if (cycles > LCD_stats.flushCyclesMax)
+    {
+        LCD_stats.flushCyclesMax = cycles;
+    }
+}
+
+#endif /* LCD_USE_STATS != 0u */
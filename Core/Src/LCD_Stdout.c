@@ -0,0 +1,402 @@
+/*
+ *  LCD_Stdout.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: printf/stdout retargeting for the HD44780 LCD driver.
+ *
+ *  			_write() in syscalls.c hands stdout and stderr to
+ *  			LCD_StdoutWrite(). Characters are collected in the framebuffer
+ *  			at the shadow cursor, '\n' moves to the next row (scrolling the
+ *  			framebuffer up on the last row), '\r' returns to column 0 and
+ *  			'\f' blanks the framebuffer. The module is only written by
+ *  			LCD_FlushFrame(), once per _write() call, so a printf costs one
+ *  			diff flush instead of one bus transaction per character, and a
+ *  			scroll only rewrites the cells that differ from the row below.
+ *
+ *  			With LCD_STDOUT_ANSI the same path is a small VT100 terminal:
+ *  			an incremental parser takes ESC[r;cH (and f), cursor moves
+ *  			ESC[nA/B/C/D, erase in display ESC[nJ and in line ESC[nK, and
+ *  			save/restore cursor (ESC[s/ESC[u, ESC 7/ESC 8). Erasing fills
+ *  			framebuffer cells with blanks instead of sending the 1.52 ms
+ *  			clear display command, and the flush sends only the cells that
+ *  			were not blank already. Sequences may be split across writes.
+ *
+ *  Usage:      - set LCD_USE_STDOUT (and LCD_USE_FRAMEBUFFER) in LCD_Config.h
+ *  			- newlib line-buffers stdout, setvbuf(stdout, NULL, _IOFBF, n)
+ *  				batches several lines into one flush
+ *  			- printf shares the shadow cursor with LCD_Position() and
+ *  				LCD_PrintString()
+ *  			- bytes from a UART can be fed to LCD_StdoutWrite() as they
+ *  				come, the escape parser keeps its state between calls
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Latency.h"
+#include "LCD_Handle.h"
+#include "LCD_Stdout.h"
+
+#if (LCD_USE_STDOUT != 0u)
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    #error "LCD_USE_STDOUT requires LCD_USE_FRAMEBUFFER"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+#if (LCD_STDOUT_ANSI != 0u)
+    /* Escape parser states */
+    #define LCD_ANSI_GROUND          (0u)      /* plain characters */
+    #define LCD_ANSI_ESCAPE          (1u)      /* after ESC */
+    #define LCD_ANSI_CSI             (2u)      /* after ESC [, parameters */
+
+    static uint8_t LCD_ansiState = LCD_ANSI_GROUND;
+    static uint8_t LCD_ansiParams[LCD_STDOUT_ANSI_PARAMS];
+    static uint8_t LCD_ansiCount;
+
+    /* Cursor stored by save cursor */
+    static uint8_t LCD_ansiSavedRow = 0u;
+    static uint8_t LCD_ansiSavedColumn = 0u;
+
+    static uint8_t LCD_StdoutEscape(char character) ;
+    static void LCD_StdoutControl(char final) ;
+    static void LCD_StdoutErase(uint8_t row, uint8_t first, uint8_t end) ;
+#endif /* LCD_STDOUT_ANSI != 0u */
+
+
+/*******************************************************************************
+* Function Name: LCD_StdoutWrite
+********************************************************************************
+*
+* Summary:
+*  Puts a block of stdout characters into the framebuffer, then flushes the
+*  changed cells once (LCD_STDOUT_AUTO_FLUSH).
+*
+* Parameters:
+*  buffer: Characters from _write()
+*  length: Number of characters
+*
+* Return:
+*  Number of characters consumed (always "length").
+*
+* Reentrant:
+*  No.
+*
+*******************************************************************************/
+int LCD_StdoutWrite(char const buffer[], int length)
+{
+    int index;
+
+    for (index = 0; index < length; index++)
+    {
+        LCD_StdoutPutChar(buffer[index]);
+    }
+
+    #if (LCD_STDOUT_AUTO_FLUSH != 0u)
+        LCD_FlushFrame();
+    #endif /* LCD_STDOUT_AUTO_FLUSH != 0u */
+
+    return length;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_StdoutPutChar
+********************************************************************************
+*
+* Summary:
+*  Interprets one stdout character at the shadow cursor. No bus traffic is
+*  generated.
+*
+* Parameters:
+*  character: Printable character, '\n', '\r', '\f' or a byte of an escape
+*             sequence
+*
+* Return:
+*  None.
+*
+* Note:
+*  Other control characters are ignored.
+*
+*******************************************************************************/
+void LCD_StdoutPutChar(char character)
+{
+    #if (LCD_STDOUT_ANSI != 0u)
+        if (LCD_StdoutEscape(character) != 0u)
+        {
+            return;
+        }
+    #endif /* LCD_STDOUT_ANSI != 0u */
+
+    if (character == LCD_STDOUT_NEWLINE)
+    {
+        LCD_frameColumn = 0u;
+        if ((LCD_frameRow + 1u) < LCD_display0.geometry->rows)
+        {
+            LCD_frameRow++;
+        }
+        else
+        {
+            LCD_StdoutScroll();
+        }
+    }
+    else if (character == LCD_STDOUT_RETURN)
+    {
+        LCD_frameColumn = 0u;
+    }
+    else if (character == LCD_STDOUT_FORMFEED)
+    {
+        /* Framebuffer fill, the flush only blanks the cells in use */
+        LCD_FrameClear();
+    }
+    else if ((uint8_t) character >= (uint8_t) ' ')
+    {
+        if (LCD_frameColumn >= LCD_display0.geometry->columns)
+        {
+            #if (LCD_STDOUT_WRAP != 0u)
+                LCD_StdoutPutChar(LCD_STDOUT_NEWLINE);
+            #else
+                /* Truncated, the framebuffer itself would wrap */
+                return;
+            #endif /* LCD_STDOUT_WRAP != 0u */
+        }
+
+        LCD_FrameWriteChar((uint8_t) character);
+    }
+    else
+    {
+        /* Unsupported control character */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_StdoutScroll
+********************************************************************************
+*
+* Summary:
+*  Moves every framebuffer row up by one and blanks the last row. Only cells
+*  that differ from the row below are rewritten by the next flush.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_StdoutScroll(void)
+{
+    uint8_t const rows = LCD_display0.geometry->rows;
+    uint8_t const columns = LCD_display0.geometry->columns;
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 1u; row < rows; row++)
+    {
+        for (column = 0u; column < columns; column++)
+        {
+            LCD_LATENCY_CHANGE(row - 1u, column, LCD_frame[row][column]);
+            LCD_frame[row - 1u][column] = LCD_frame[row][column];
+        }
+    }
+
+    for (column = 0u; column < columns; column++)
+    {
+        LCD_LATENCY_CHANGE(rows - 1u, column, LCD_FRAME_BLANK);
+        LCD_frame[rows - 1u][column] = LCD_FRAME_BLANK;
+    }
+
+    /* LCD_RefreshTask() and LCD_Poll() skip a frame that is not dirty */
+    LCD_frameDirty = 1u;
+}
+
+
+#if (LCD_STDOUT_ANSI != 0u)
+/*******************************************************************************
+* Function Name: LCD_StdoutEscape
+********************************************************************************
+*
+* Summary:
+*  Runs one character through the escape parser. Returns 1 if it was part of
+*  a sequence, 0 if it is to be printed (a control character also ends an
+*  unfinished sequence).
+*
+*******************************************************************************/
+static uint8_t LCD_StdoutEscape(char character)
+{
+    uint8_t consumed = 1u;
+    uint8_t *param;
+
+    switch (LCD_ansiState)
+    {
+        case LCD_ANSI_ESCAPE:
+            LCD_ansiState = LCD_ANSI_GROUND;
+            if (character == '[')
+            {
+                LCD_ansiParams[0u] = 0u;
+                LCD_ansiParams[1u] = 0u;
+                LCD_ansiCount = 0u;
+                LCD_ansiState = LCD_ANSI_CSI;
+            }
+            else if (character == '7')
+            {
+                LCD_StdoutControl('s');
+            }
+            else if (character == '8')
+            {
+                LCD_StdoutControl('u');
+            }
+            else if ((uint8_t) character < (uint8_t) ' ')
+            {
+                consumed = 0u;
+            }
+            else
+            {
+                /* Other escape sequences are skipped */
+            }
+            break;
+
+        case LCD_ANSI_CSI:
+            if ((character >= '0') && (character <= '9'))
+            {
+                if (LCD_ansiCount < LCD_STDOUT_ANSI_PARAMS)
+                {
+                    param = &LCD_ansiParams[LCD_ansiCount];
+                    *param = (*param < 25u) ? (uint8_t) ((*param * 10u) + (uint8_t) (character - '0')) : 255u;
+                }
+            }
+            else if (character == ';')
+            {
+                if (LCD_ansiCount < LCD_STDOUT_ANSI_PARAMS)
+                {
+                    LCD_ansiCount++;
+                }
+            }
+            else if (((uint8_t) character >= 0x40u) && ((uint8_t) character <= 0x7Eu))
+            {
+                LCD_ansiState = LCD_ANSI_GROUND;
+                LCD_StdoutControl(character);
+            }
+            else if ((uint8_t) character < (uint8_t) ' ')
+            {
+                LCD_ansiState = LCD_ANSI_GROUND;
+                consumed = 0u;
+            }
+            else
+            {
+                /* Private markers and intermediates ('?', ' ', ...) */
+            }
+            break;
+
+        default:
+            if (character == LCD_STDOUT_ESCAPE)
+            {
+                LCD_ansiState = LCD_ANSI_ESCAPE;
+            }
+            else
+            {
+                consumed = 0u;
+            }
+            break;
+    }
+
+    return consumed;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_StdoutControl
+********************************************************************************
+*
+* Summary:
+*  Executes a control sequence on the framebuffer (parameters are 1-based
+*  positions or counts, 0 = the default).
+*
+*******************************************************************************/
+static void LCD_StdoutControl(char final)
+{
+    uint8_t const rows = LCD_display0.geometry->rows;
+    uint8_t const columns = LCD_display0.geometry->columns;
+    uint8_t const first = LCD_ansiParams[0u];
+    uint8_t const count = (first != 0u) ? first : 1u;
+    uint8_t const column = (LCD_frameColumn < columns) ? LCD_frameColumn : (columns - 1u);
+    uint8_t row;
+
+    switch (final)
+    {
+        case 'H':
+        case 'f':
+            LCD_frameRow = (first > rows) ? (rows - 1u) : ((first != 0u) ? (first - 1u) : 0u);
+            LCD_frameColumn = (LCD_ansiParams[1u] > columns) ? (columns - 1u) :
+                              ((LCD_ansiParams[1u] != 0u) ? (LCD_ansiParams[1u] - 1u) : 0u);
+            break;
+        case 'A':
+            LCD_frameRow = (LCD_frameRow > count) ? (uint8_t) (LCD_frameRow - count) : 0u;
+            break;
+        case 'B':
+            LCD_frameRow = ((LCD_frameRow + count) < rows) ? (LCD_frameRow + count) : (rows - 1u);
+            break;
+        case 'C':
+            LCD_frameColumn = ((column + count) < columns) ? (column + count) : (columns - 1u);
+            break;
+        case 'D':
+            LCD_frameColumn = (column > count) ? (uint8_t) (column - count) : 0u;
+            break;
+        case 'J':
+            /* 0 = cursor to end, 1 = start to cursor, 2 = everything */
+            for (row = 0u; row < rows; row++)
+            {
+                if ((first >= 2u) || ((first == 0u) && (row > LCD_frameRow)) ||
+                    ((first == 1u) && (row < LCD_frameRow)))
+                {
+                    LCD_StdoutErase(row, 0u, columns);
+                }
+            }
+            if (first < 2u)
+            {
+                LCD_StdoutErase(LCD_frameRow, (first == 0u) ? column : 0u,
+                                (first == 0u) ? columns : (column + 1u));
+            }
+            break;
+        case 'K':
+            LCD_StdoutErase(LCD_frameRow, (first == 0u) ? column : 0u,
+                            (first == 1u) ? (column + 1u) : columns);
+            break;
+        case 's':
+            LCD_ansiSavedRow = LCD_frameRow;
+            LCD_ansiSavedColumn = LCD_frameColumn;
+            break;
+        case 'u':
+            LCD_frameRow = (LCD_ansiSavedRow < rows) ? LCD_ansiSavedRow : (rows - 1u);
+            LCD_frameColumn = LCD_ansiSavedColumn;
+            break;
+        default:
+            /* Attributes (m) and the rest have no HD44780 equivalent */
+            break;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_StdoutErase
+********************************************************************************
+*
+* Summary:
+*  Blanks the framebuffer cells first to end - 1 of a row.
+*
+*******************************************************************************/
+static void LCD_StdoutErase(uint8_t row, uint8_t first, uint8_t end)
+{
+    for (; first < end; first++)
+    {
+        LCD_LATENCY_CHANGE(row, first, LCD_FRAME_BLANK);
+        LCD_frame[row][first] = LCD_FRAME_BLANK;
+    }
+
+    LCD_frameDirty = 1u;
+}
+#endif /* LCD_STDOUT_ANSI != 0u */
+
+#endif /* LCD_USE_STDOUT != 0u */
@@ -0,0 +1,466 @@
+/*
+ *  LCD_Timing.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Elapsed-time tracking for the HD44780 LCD driver.
+ *
+ *  			The DWT cycle counter timestamps the end of every command or
+ *  			data write together with its known execution time (37 us, or
+ *  			1.52 ms for clear/home). LCD_WriteData/LCD_WriteControl only poll
+ *  			the busy flag when that time has not elapsed yet, which removes
+ *  			the pin reconfiguration and two E strobes of LCD_IsReady() from
+ *  			writes made after the previous command already finished.
+ *
+ *  			LCD_Calibrate() measures the real busy time of clear, home and
+ *  			data writes on the attached module (HD44780, KS0066 and ST7066U
+ *  			differ a lot) and switches the driver to open-loop timed writes
+ *  			with LCD_CALIBRATE_MARGIN_PCT safety margin, so no read-back is
+ *  			needed per byte.
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Timing.h"
+#include "LCD_Handle.h"
+#include "LCD_Wfi.h"
+
+uint32_t LCD_cyclesPerUs = 72u;
+uint32_t LCD_execShortCycles = LCD_EXEC_SHORT_US * 72u;
+uint32_t LCD_execLongCycles = LCD_EXEC_LONG_US * 72u;
+uint32_t LCD_readyTimeoutCycles = LCD_READY_TIMEOUT_US * 72u;
+
+/* E cycle gaps of LCD_TIMING_PROFILE, in cycles so the waits do no arithmetic */
+LCD_BUS_CYCLES LCD_busCycles =
+{
+    LCD_NS_TO_CYCLES(LCD_T_AS_NS, 72u), LCD_NS_TO_CYCLES(LCD_T_PWEH_NS, 72u),
+    LCD_NS_TO_CYCLES(LCD_T_READ_NS, 72u), LCD_NS_TO_CYCLES(LCD_T_RECOVER_NS, 72u)
+};
+
+/* 1 = writes wait for the (calibrated) execution time instead of polling,
+ * always with the write-only wiring (LCD_GPIO_WRITE_ONLY)
+ */
+uint8_t LCD_timedMode = (LCD_GPIO_WRITE_ONLY != 0u) ? 1u : 0u;
+
+/* 1 = the busy poll is skipped once the execution time elapsed
+ * (LCD_USE_ELAPSED_SKIP), 0 = every write polls
+ */
+uint8_t LCD_elapsedSkip = 1u;
+
+static uint32_t LCD_MeasureBusy(void) ;
+static uint32_t LCD_ScaleCycles(uint32_t cycles, uint32_t previous) ;
+static void LCD_BusCyclesUpdate(void) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_TimingInit
+********************************************************************************
+*
+* Summary:
+*  Enables the DWT cycle counter and derives the execution times and the busy
+*  poll timeout in cycles from SystemCoreClock.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_TimingInit(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* Rounded up, a core clock off a whole MHz only lengthens the waits */
+    LCD_cyclesPerUs = (SystemCoreClock + 999999u) / 1000000u;
+    LCD_execShortCycles = LCD_EXEC_SHORT_US * LCD_cyclesPerUs;
+    LCD_execLongCycles = LCD_EXEC_LONG_US * LCD_cyclesPerUs;
+    LCD_readyTimeoutCycles = LCD_READY_TIMEOUT_US * LCD_cyclesPerUs;
+    LCD_BusCyclesUpdate();
+
+    /* Unknown state, the first write to this display polls */
+    LCD_active->timingStart = LCD_CYCLES();
+    LCD_active->timingDuration = LCD_execLongCycles;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TimingClockUpdate
+********************************************************************************
+*
+* Summary:
+*  Re-derives every driver delay and timeout after the core clock changed
+*  (SystemClock_Config/HAL_RCC_ClockConfig updated SystemCoreClock): the DWT
+*  cycles per microsecond, the bus timing gaps, the execution times (calibrated ones are scaled,
+*  so timed mode keeps its measured margin) and the TIM4 prescaler of
+*  delay_us(), LCD_Async.c and LCD_Wfi.c.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+* Note:
+*  Call with the bus idle (LCD_IsIdle with the write queue); the TIM4 counter
+*  restarts. The DMA, I2C, SPI and backlight timers derive their clocks in
+*  their start functions, run those again.
+*
+*******************************************************************************/
+void LCD_TimingClockUpdate(void)
+{
+    uint32_t const previous = LCD_cyclesPerUs;
+
+    LCD_cyclesPerUs = (SystemCoreClock + 999999u) / 1000000u;
+    LCD_readyTimeoutCycles = LCD_READY_TIMEOUT_US * LCD_cyclesPerUs;
+    LCD_BusCyclesUpdate();
+
+    if (LCD_timedMode != 0u)
+    {
+        LCD_execShortCycles = LCD_ScaleCycles(LCD_execShortCycles, previous);
+        LCD_execLongCycles = LCD_ScaleCycles(LCD_execLongCycles, previous);
+    }
+    else
+    {
+        LCD_execShortCycles = LCD_EXEC_SHORT_US * LCD_cyclesPerUs;
+        LCD_execLongCycles = LCD_EXEC_LONG_US * LCD_cyclesPerUs;
+    }
+
+    #if ((LCD_DELAY_BACKEND == LCD_DELAY_TIM4) || (LCD_USE_ASYNC != 0u) || (LCD_USE_WFI != 0u))
+        delay_clock_update();
+    #endif /* (LCD_DELAY_BACKEND == LCD_DELAY_TIM4) || (LCD_USE_ASYNC != 0u) || (LCD_USE_WFI != 0u) */
+
+    /* Timestamps of the old clock are meaningless, the next write polls */
+    LCD_active->timingStart = LCD_CYCLES();
+    LCD_active->timingDuration = LCD_execLongCycles;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TimingMark
+********************************************************************************
+*
+* Summary:
+*  Records that a command or data byte was just written to the selected
+*  display. Each display keeps its own timestamp, so a write to one does not
+*  make the driver wait for a command still executing on another.
+*
+* Parameters:
+*  isLong: Non-zero for clear display / return home
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+LCD_RAMFUNC void LCD_TimingMark(uint8_t isLong)
+{
+    LCD_active->timingStart = LCD_CYCLES();
+    LCD_active->timingDuration = (isLong != 0u) ? LCD_execLongCycles : LCD_execShortCycles;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TimingExpired
+********************************************************************************
+*
+* Summary:
+*  Reports whether the last command has certainly finished executing.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if the execution time elapsed, 0 if the module may still be busy.
+*
+* Note:
+*  The counter wraps after 2^32 cycles (~60 s at 72 MHz); a stale timestamp
+*  can only cause one unnecessary busy poll.
+*
+*******************************************************************************/
+LCD_RAMFUNC uint8_t LCD_TimingExpired(void)
+{
+    LCD_Handle *handle = LCD_active;
+
+    return ((uint32_t) (LCD_CYCLES() - handle->timingStart) >= handle->timingDuration) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TimingRemaining
+********************************************************************************
+*
+* Summary:
+*  Returns the cycles left until the last command finished executing.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Remaining cycles, 0 if expired.
+*
+*******************************************************************************/
+LCD_RAMFUNC uint32_t LCD_TimingRemaining(void)
+{
+    uint32_t elapsed = (uint32_t) (LCD_CYCLES() - LCD_active->timingStart);
+
+    return (elapsed >= LCD_active->timingDuration) ? 0u : (LCD_active->timingDuration - elapsed);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_Calibrate
+********************************************************************************
+*
+* Summary:
+*  Measures the busy time of clear display, return home and data writes with
+*  LCD_IsReady() and the cycle counter (worst of LCD_CALIBRATE_SAMPLES runs),
+*  adds LCD_CALIBRATE_MARGIN_PCT and enables timed writes.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if calibrated, 0 if the module did not respond (busy polling is kept)
+*  or R/nW is tied low (LCD_GPIO_WRITE_ONLY, the table times are kept).
+*
+* Note:
+*  Clears the display, call it right after LCD_Start() before printing.
+*
+*******************************************************************************/
+uint8_t LCD_Calibrate(void)
+{
+    uint32_t longBusy = 0u;
+    uint32_t dataBusy = 0u;
+    uint32_t busy;
+    uint32_t limit;
+    uint8_t sample;
+
+    #if (LCD_GPIO_WRITE_ONLY != 0u)
+        /* R/nW tied low: there is no busy flag to measure against */
+        return 0u;
+    #endif /* LCD_GPIO_WRITE_ONLY != 0u */
+
+    /* Reaching the busy poll timeout means the flag never cleared */
+    limit = LCD_readyTimeoutCycles;
+
+    LCD_timedMode = 0u;
+    (void) LCD_IsReady();
+
+    for (sample = 0u; sample < LCD_CALIBRATE_SAMPLES; sample++)
+    {
+        LCD_WriteControl(LCD_CLEAR_DISPLAY);
+        busy = LCD_MeasureBusy();
+        longBusy = (busy > longBusy) ? busy : longBusy;
+
+        LCD_WriteControl(LCD_CURSOR_HOME);
+        busy = LCD_MeasureBusy();
+        longBusy = (busy > longBusy) ? busy : longBusy;
+
+        /* DDRAM is blank after the clear, rewriting a blank changes nothing */
+        LCD_WriteData((uint8_t) ' ');
+        busy = LCD_MeasureBusy();
+        dataBusy = (busy > dataBusy) ? busy : dataBusy;
+    }
+
+    LCD_WriteControl(LCD_CURSOR_HOME);
+
+    if ((longBusy >= limit) || (dataBusy >= limit) || (dataBusy == 0u))
+    {
+        return 0u;
+    }
+
+    LCD_execLongCycles = longBusy + ((longBusy * LCD_CALIBRATE_MARGIN_PCT) / 100u);
+    LCD_execShortCycles = dataBusy + ((dataBusy * LCD_CALIBRATE_MARGIN_PCT) / 100u);
+    LCD_timedMode = 1u;
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SetTimedMode
+********************************************************************************
+*
+* Summary:
+*  Selects open-loop timed writes (1) or busy flag polling (0).
+*
+* Parameters:
+*  enable: 1 for timed writes
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_SetTimedMode(uint8_t enable)
+{
+    LCD_timedMode = ((enable != 0u) || (LCD_GPIO_WRITE_ONLY != 0u)) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_SetElapsedSkip
+********************************************************************************
+*
+* Summary:
+*  Selects whether the busy poll is skipped after the execution time of the
+*  previous command elapsed (1), or done before every write (0). No effect
+*  without LCD_USE_ELAPSED_SKIP.
+*
+* Parameters:
+*  enable: 1 to skip elapsed polls
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_SetElapsedSkip(uint8_t enable)
+{
+    LCD_elapsedSkip = (enable != 0u) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_MeasureBusy
+********************************************************************************
+*
+* Summary:
+*  Returns the cycles from the end of the last write until the busy flag
+*  cleared.
+*
+*******************************************************************************/
+static uint32_t LCD_MeasureBusy(void)
+{
+    uint32_t start = LCD_active->timingStart;
+
+    (void) LCD_IsReady();
+
+    return (uint32_t) (LCD_CYCLES() - start);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_ScaleCycles
+********************************************************************************
+*
+* Summary:
+*  Rescales a cycle count measured at "previous" cycles per microsecond to
+*  LCD_cyclesPerUs, rounded up.
+*
+*******************************************************************************/
+static uint32_t LCD_ScaleCycles(uint32_t cycles, uint32_t previous)
+{
+    return (uint32_t) ((((uint64_t) cycles * LCD_cyclesPerUs) + previous - 1u) / previous);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_DwtDelayNs
+********************************************************************************
+*
+* Summary:
+*  Busy-waits for at least "ns" nanoseconds on the DWT cycle counter. The
+*  counter is only read, never reset, so the wait is safe from interrupts and
+*  does not disturb other users of the counter.
+*
+* Parameters:
+*  ns: Delay in nanoseconds
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+LCD_RAMFUNC void LCD_DwtDelayNs(uint32_t ns)
+{
+    uint32_t start = LCD_CYCLES();
+    uint32_t cycles = ((ns * LCD_cyclesPerUs) + 999u) / 1000u;
+
+    while ((uint32_t) (LCD_CYCLES() - start) < cycles)
+    {
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_DwtDelayCycles
+********************************************************************************
+*
+* Summary:
+*  Busy-waits for at least "cycles" core clock cycles on the DWT cycle
+*  counter. The bus timing gaps use it with the counts of LCD_busCycles, so
+*  the shortest waits are not stretched by a conversion.
+*
+* Parameters:
+*  cycles: Delay in core clock cycles
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+LCD_RAMFUNC void LCD_DwtDelayCycles(uint32_t cycles)
+{
+    uint32_t const start = LCD_CYCLES();
+
+    while ((uint32_t) (LCD_CYCLES() - start) < cycles)
+    {
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_BusCyclesUpdate
+********************************************************************************
+*
+* Summary:
+*  Converts the bus timing of LCD_TIMING_PROFILE to cycles of the current
+*  core clock.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static void LCD_BusCyclesUpdate(void)
+{
+    LCD_busCycles.setup = LCD_NS_TO_CYCLES(LCD_T_AS_NS, LCD_cyclesPerUs);
+    LCD_busCycles.pulse = LCD_NS_TO_CYCLES(LCD_T_PWEH_NS, LCD_cyclesPerUs);
+    LCD_busCycles.read = LCD_NS_TO_CYCLES(LCD_T_READ_NS, LCD_cyclesPerUs);
+    LCD_busCycles.recover = LCD_NS_TO_CYCLES(LCD_T_RECOVER_NS, LCD_cyclesPerUs);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_DwtDelayUs
+********************************************************************************
+*
+* Summary:
+*  Busy-waits for at least "us" microseconds on the DWT cycle counter (sleeps
+*  through waits of LCD_WFI_MIN_US or more with LCD_USE_WFI).
+*
+* Parameters:
+*  us: Delay in microseconds
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_DwtDelayUs(uint32_t us)
+{
+    uint32_t start = LCD_CYCLES();
+    uint32_t cycles = us * LCD_cyclesPerUs;
+
+    #if (LCD_USE_WFI != 0u)
+        if (us >= LCD_WFI_MIN_US)
+        {
+            LCD_WfiWaitCycles(cycles);
+            return;
+        }
+    #endif /* LCD_USE_WFI != 0u */
+
+    while ((uint32_t) (LCD_CYCLES() - start) < cycles)
+    {
+    }
+}
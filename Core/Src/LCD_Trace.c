@@ -0,0 +1,501 @@
+/*
+ *  LCD_Trace.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: In-RAM bus trace recorder for the HD44780 LCD driver.
+ *
+ *  			With LCD_USE_TRACE set, LCD_WrDatNib(), LCD_WrCntrlNib(),
+ *  			LCD_WrByte() and LCD_IsReady() record the state of RS, R/W, E,
+ *  			the data pins and their direction after every pin store,
+ *  			stamped with the DWT cycle counter, plus every value read back
+ *  			from the module. Entries go to a ring of LCD_TRACE_SIZE, the
+ *  			oldest are overwritten. LCD_TraceDumpVcd() writes the ring as a
+ *  			Value Change Dump (1 ns timescale) for GTKWave, PulseView or the
+ *  			host model (LCD_HostReplay in Host/).
+ *
+ *  Usage:      - LCD_TraceStop() right after the operation of interest,
+ *  				the ring then holds the last LCD_TRACE_SIZE transitions
+ *  			- LCD_TraceDumpVcd(LCD_TraceItmPutChar) over SWO (ITM port 0),
+ *  				or any character output (UART)
+ *  			- each recorded edge costs about 30 cycles; timestamps are
+ *  				taken right after the store, so measured widths include
+ *  				the recorder (widths only get longer, violations are not
+ *  				hidden)
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Timing.h"
+#include "LCD_Format.h"
+#include "LCD_Handle.h"
+#include "LCD_Trace.h"
+
+#if (LCD_USE_TRACE != 0u)
+
+#if ((LCD_TRACE_SIZE & (LCD_TRACE_SIZE - 1u)) != 0u)
+    #error "LCD_TRACE_SIZE must be a power of two"
+#endif /* (LCD_TRACE_SIZE & (LCD_TRACE_SIZE - 1u)) != 0u */
+
+#if (LCD_USE_PIN_MAP != 0u)
+    #error "LCD_USE_TRACE samples DB4_GPIO_Port, not LCD_USE_PIN_MAP"
+#endif /* LCD_USE_PIN_MAP != 0u */
+
+#define LCD_TRACE_MASK               (LCD_TRACE_SIZE - 1u)
+
+/* Port configuration register holding DB4, and its MODE bits position */
+#if (LCD_STM32_NIBBLE_SHIFT < 8u)
+    #define LCD_TRACE_DB4_CR         (DB4_GPIO_Port->CRL)
+#else
+    #define LCD_TRACE_DB4_CR         (DB4_GPIO_Port->CRH)
+#endif /* LCD_STM32_NIBBLE_SHIFT < 8u */
+#define LCD_TRACE_DB4_MODE_POS       ((LCD_STM32_NIBBLE_SHIFT & 7u) * 4u)
+
+/* VCD width of the data bus */
+#if (LCD_BUS_8BIT != 0u)
+    #define LCD_TRACE_BUS_WIDTH      (8u)
+#else
+    #define LCD_TRACE_BUS_WIDTH      (4u)
+#endif /* LCD_BUS_8BIT != 0u */
+
+static LCD_TRACE_ENTRY LCD_trace[LCD_TRACE_SIZE];
+static uint32_t LCD_traceWritten = 0u;
+static uint8_t LCD_traceRunning = 1u;
+
+static uint16_t LCD_TracePins(uint32_t data) ;
+static void LCD_TraceStore(uint16_t pins) ;
+static void LCD_TracePuts(LCD_TracePutChar putChar, char const string[]) ;
+static void LCD_TracePutU64(LCD_TracePutChar putChar, uint64_t value) ;
+static void LCD_TracePutBus(LCD_TracePutChar putChar, uint16_t pins, char id) ;
+static void LCD_TracePutBit(LCD_TracePutChar putChar, uint16_t pins, uint16_t state, uint16_t mask, char id) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_TraceStart
+********************************************************************************
+*
+* Summary:
+*  Resumes recording (the default after reset).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_TraceStart(void)
+{
+    LCD_traceRunning = 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TraceStop
+********************************************************************************
+*
+* Summary:
+*  Freezes the ring, e.g. right after the transfer to be examined.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_TraceStop(void)
+{
+    LCD_traceRunning = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TraceClear
+********************************************************************************
+*
+* Summary:
+*  Discards every recorded entry.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_TraceClear(void)
+{
+    LCD_traceWritten = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TraceCount
+********************************************************************************
+*
+* Summary:
+*  Returns the number of entries held by the ring.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  0 to LCD_TRACE_SIZE.
+*
+*******************************************************************************/
+uint16_t LCD_TraceCount(void)
+{
+    return (LCD_traceWritten > LCD_TRACE_SIZE) ? (uint16_t) LCD_TRACE_SIZE : (uint16_t) LCD_traceWritten;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TraceEntry
+********************************************************************************
+*
+* Summary:
+*  Returns one recorded entry, oldest first.
+*
+* Parameters:
+*  index: 0 to LCD_TraceCount() - 1
+*
+* Return:
+*  Pointer to the entry.
+*
+*******************************************************************************/
+LCD_TRACE_ENTRY const *LCD_TraceEntry(uint16_t index)
+{
+    uint32_t first = LCD_traceWritten - LCD_TraceCount();
+
+    return &LCD_trace[(first + index) & LCD_TRACE_MASK];
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TraceDumpVcd
+********************************************************************************
+*
+* Summary:
+*  Writes the ring as a Value Change Dump: RS, RW, E, DIR (1 = data pins
+*  input), DB (driven by the MCU, z while input) and RD (value the MCU read).
+*  Times are ns since the oldest entry.
+*
+* Parameters:
+*  putChar: Character output
+*
+* Return:
+*  None.
+*
+* Note:
+*  Stops the recorder, call LCD_TraceStart() to record again.
+*
+*******************************************************************************/
+void LCD_TraceDumpVcd(LCD_TracePutChar putChar)
+{
+    LCD_TRACE_ENTRY const *entry;
+    uint16_t count;
+    uint16_t index;
+    uint16_t state = 0u;
+    uint32_t previousCycles;
+    uint64_t cycles = 0u;
+
+    LCD_traceRunning = 0u;
+    count = LCD_TraceCount();
+
+    LCD_TracePuts(putChar, "$timescale 1ns $end\n$scope module lcd $end\n");
+    LCD_TracePuts(putChar, "$var wire 1 ! RS $end\n$var wire 1 \" RW $end\n$var wire 1 # E $end\n");
+    LCD_TracePuts(putChar, "$var wire 1 $ DIR $end\n");
+    LCD_TracePuts(putChar, (LCD_TRACE_BUS_WIDTH == 8u) ? "$var wire 8 % DB $end\n$var wire 8 & RD $end\n" :
+                                                         "$var wire 4 % DB $end\n$var wire 4 & RD $end\n");
+    LCD_TracePuts(putChar, "$upscope $end\n$enddefinitions $end\n");
+
+    if (count == 0u)
+    {
+        return;
+    }
+
+    entry = LCD_TraceEntry(0u);
+    previousCycles = entry->cycles;
+
+    for (index = 0u; index < count; index++)
+    {
+        entry = LCD_TraceEntry(index);
+
+        /* Deltas are modulo 2^32, the trace may span counter wraps */
+        cycles += (uint32_t) (entry->cycles - previousCycles);
+        previousCycles = entry->cycles;
+
+        putChar('#');
+        LCD_TracePutU64(putChar, (cycles * 1000u) / LCD_cyclesPerUs);
+        putChar('\n');
+
+        if (index == 0u)
+        {
+            /* Initial values of every variable */
+            state = (uint16_t) ~entry->pins;
+            LCD_TracePuts(putChar, "$dumpvars\n");
+        }
+
+        if ((entry->pins & LCD_TRACE_SAMPLE) != 0u)
+        {
+            LCD_TracePutBus(putChar, entry->pins, '&');
+            if (index == 0u)
+            {
+                LCD_TracePuts(putChar, "$end\n");
+            }
+            continue;
+        }
+
+        LCD_TracePutBit(putChar, entry->pins, state, LCD_TRACE_RS, '!');
+        LCD_TracePutBit(putChar, entry->pins, state, LCD_TRACE_RW, '"');
+        LCD_TracePutBit(putChar, entry->pins, state, LCD_TRACE_E, '#');
+        LCD_TracePutBit(putChar, entry->pins, state, LCD_TRACE_INPUT, '$');
+        if (((entry->pins ^ state) & (0xFF00u | LCD_TRACE_INPUT)) != 0u)
+        {
+            LCD_TracePutBus(putChar, entry->pins, '%');
+        }
+
+        state = entry->pins;
+        if (index == 0u)
+        {
+            LCD_TracePuts(putChar, "$end\n");
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TraceItmPutChar
+********************************************************************************
+*
+* Summary:
+*  LCD_TraceDumpVcd() output on ITM stimulus port 0 (SWO).
+*
+* Parameters:
+*  character: Character to send
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_TraceItmPutChar(char character)
+{
+    (void) ITM_SendChar((uint32_t) (uint8_t) character);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TraceEdge
+********************************************************************************
+*
+* Summary:
+*  Records the pin state after a store (LCD_TRACE_EDGE).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_TraceEdge(void)
+{
+    LCD_TraceStore(LCD_TracePins(DB4_GPIO_Port->ODR));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TraceRead
+********************************************************************************
+*
+* Summary:
+*  Records a value read back from the module (LCD_TRACE_READ).
+*
+* Parameters:
+*  idr: Input data register of the data port
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_TraceRead(uint32_t idr)
+{
+    LCD_TraceStore(LCD_TracePins(idr) | LCD_TRACE_SAMPLE);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TracePins
+********************************************************************************
+*
+* Summary:
+*  Packs RS, R/W, E (of the selected display), the data pin direction and
+*  DB7-DB0 taken from "data" (ODR or IDR of the data port).
+*
+*******************************************************************************/
+static uint16_t LCD_TracePins(uint32_t data)
+{
+    uint16_t pins;
+    uint8_t bus;
+
+    bus = (uint8_t) (((data >> LCD_STM32_NIBBLE_SHIFT) & LCD_NIBBLE_MASK) << LCD_NIBBLE_SHIFT);
+    #if (LCD_BUS_8BIT != 0u)
+        bus |= (uint8_t) ((data >> LCD_STM32_LOW_NIBBLE_SHIFT) & LCD_NIBBLE_MASK);
+    #endif /* LCD_BUS_8BIT != 0u */
+
+    pins = (uint16_t) ((uint16_t) bus << LCD_TRACE_DB_SHIFT);
+
+    if ((RS_GPIO_Port->ODR & LCD_PIN_BITS(RS_Pin)) != 0u)
+    {
+        pins |= LCD_TRACE_RS;
+    }
+    if ((RnW_GPIO_Port->ODR & LCD_PIN_BITS(RnW_Pin)) != 0u)
+    {
+        pins |= LCD_TRACE_RW;
+    }
+    if ((LCD_E_PORT->ODR & LCD_E_BITS) != 0u)
+    {
+        pins |= LCD_TRACE_E;
+    }
+    if (((LCD_TRACE_DB4_CR >> LCD_TRACE_DB4_MODE_POS) & 0x3u) == 0u)
+    {
+        /* MODE = 00: input */
+        pins |= LCD_TRACE_INPUT;
+    }
+
+    return pins;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TraceStore
+********************************************************************************
+*
+* Summary:
+*  Appends one entry, overwriting the oldest when the ring is full.
+*
+*******************************************************************************/
+static void LCD_TraceStore(uint16_t pins)
+{
+    LCD_TRACE_ENTRY *entry;
+
+    if (LCD_traceRunning == 0u)
+    {
+        return;
+    }
+
+    entry = &LCD_trace[LCD_traceWritten & LCD_TRACE_MASK];
+    entry->cycles = LCD_CYCLES();
+    entry->pins = pins;
+    LCD_traceWritten++;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TracePuts
+********************************************************************************
+*
+* Summary:
+*  Sends a zero terminated string.
+*
+*******************************************************************************/
+static void LCD_TracePuts(LCD_TracePutChar putChar, char const string[])
+{
+    while ((char) '\0' != *string)
+    {
+        putChar(*string);
+        string++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TracePutU64
+********************************************************************************
+*
+* Summary:
+*  Sends a decimal number; LCD_FormatU32() digit groups below 10^9.
+*
+*******************************************************************************/
+static void LCD_TracePutU64(LCD_TracePutChar putChar, uint64_t value)
+{
+    char digits[LCD_U32_DIGITS];
+    uint8_t count;
+    uint8_t index;
+
+    if (value >= 1000000000u)
+    {
+        /* Upper digits first, then the lower nine zero padded */
+        LCD_TracePutU64(putChar, value / 1000000000u);
+        value %= 1000000000u;
+        count = LCD_FormatU32(digits, (uint32_t) value);
+        for (index = count; index < 9u; index++)
+        {
+            putChar('0');
+        }
+    }
+    else
+    {
+        count = LCD_FormatU32(digits, (uint32_t) value);
+    }
+
+    for (index = LCD_U32_DIGITS - count; index < LCD_U32_DIGITS; index++)
+    {
+        putChar(digits[index]);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TracePutBus
+********************************************************************************
+*
+* Summary:
+*  Sends the data bus of an entry as a binary vector ("z" while the data pins
+*  are inputs, except for a sampled read).
+*
+*******************************************************************************/
+static void LCD_TracePutBus(LCD_TracePutChar putChar, uint16_t pins, char id)
+{
+    uint8_t bus = LCD_TRACE_DB(pins);
+    uint8_t bit;
+
+    putChar('b');
+    if (((pins & LCD_TRACE_INPUT) != 0u) && ((pins & LCD_TRACE_SAMPLE) == 0u))
+    {
+        putChar('z');
+    }
+    else
+    {
+        for (bit = 0u; bit < LCD_TRACE_BUS_WIDTH; bit++)
+        {
+            putChar(((bus & (0x80u >> bit)) != 0u) ? '1' : '0');
+        }
+    }
+    putChar(' ');
+    putChar(id);
+    putChar('\n');
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_TracePutBit
+********************************************************************************
+*
+* Summary:
+*  Sends a scalar value change if "mask" differs from the previous state.
+*
+*******************************************************************************/
+static void LCD_TracePutBit(LCD_TracePutChar putChar, uint16_t pins, uint16_t state, uint16_t mask, char id)
+{
+    if (((pins ^ state) & mask) != 0u)
+    {
+        putChar(((pins & mask) != 0u) ? '1' : '0');
+        putChar(id);
+        putChar('\n');
+    }
+}
+
+#endif /* LCD_USE_TRACE != 0u */
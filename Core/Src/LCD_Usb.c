@@ -0,0 +1,919 @@
+/*
+ *  LCD_Usb.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: USB CDC (virtual COM port) link of the remote display
+ *  			protocol, on the USB full-speed device of the F103.
+ *
+ *  			The device enumerates as a CDC ACM port (the ST VCP identity,
+ *  			so hosts bind their own driver): the communication interface
+ *  			with its notification endpoint, never armed, and a data
+ *  			interface with a bulk OUT endpoint for the frames of
+ *  			LCD_Remote.c. The registers are driven directly, no USB
+ *  			middleware. The interrupt answers the control requests on
+ *  			endpoint 0 and copies each bulk packet out of the packet
+ *  			memory (16-bit words at a 32-bit stride, the core cannot
+ *  			read it as bytes) into LCD_usbPacket, then leaves the
+ *  			endpoint NAKing: the host holds the next packet back until
+ *  			LCD_UsbPoll() has fed this one to LCD_RemoteFeed(), where the
+ *  			frames are parsed in the packet buffer itself.
+ *
+ *  Usage:      - LCD_UsbStart() after LCD_Start(), then LCD_UsbPoll() from
+ *  				the main loop (it flushes, unless LCD_USE_REFRESH or LCD_USE_POLL)
+ *  			- call LCD_UsbIRQHandler() from USB_LP_CAN1_RX0_IRQHandler
+ *  			- D- PA11, D+ PA12; the pins are the USB's once it is on
+ *  			- needs the 48 MHz USB clock from the PLL: a 72 MHz system
+ *  				clock (USB prescaler 1.5) or 48 MHz (prescaler 1)
+ *  			- the USB and the bxCAN share the packet memory and the
+ *  				interrupt, only one of them runs (LCD_USE_CAN 0)
+ *  			- LCD_USB_PULLUP_PIN switches the D+ pull-up, so the host
+ *  				sees the device only once it answers; without a switch
+ *  				the host may time out its first reset and retry
+ *  			- the host may send at any baud rate, line coding and
+ *  				control lines are accepted and ignored
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Timing.h"
+#include "LCD_Remote.h"
+#include "LCD_Usb.h"
+
+#if (LCD_USE_USB_CDC != 0u)
+
+#if (LCD_USE_REMOTE == 0u)
+    #error "LCD_USE_USB_CDC carries the frames of the remote display (LCD_USE_REMOTE)"
+#endif /* LCD_USE_REMOTE == 0u */
+
+#if (LCD_USE_CAN != 0u)
+    #error "LCD_USE_USB_CDC and LCD_USE_CAN share the packet memory of the F103, only one can run"
+#endif /* LCD_USE_CAN != 0u */
+
+/* Endpoints: 0 control, 1 bulk data (OUT used), 2 notification (IN) */
+#define LCD_USB_EP_CONTROL           (0u)
+#define LCD_USB_EP_DATA              (1u)
+#define LCD_USB_EP_NOTIFY            (2u)
+#define LCD_USB_EP0_SIZE             (64u)
+#define LCD_USB_NOTIFY_SIZE          (8u)
+
+/* Packet memory: buffer table at 0, then the buffers (USB local addresses) */
+#define LCD_USB_EP0_TX_BUFFER        (0x040u)
+#define LCD_USB_EP0_RX_BUFFER        (0x080u)
+#define LCD_USB_DATA_RX_BUFFER       (0x0C0u)
+#define LCD_USB_DATA_TX_BUFFER       (0x100u)
+#define LCD_USB_NOTIFY_TX_BUFFER     (0x140u)
+
+/* COUNTn_RX of a 64-byte buffer: two 32-byte blocks */
+#define LCD_USB_RX_64                (0x8400u)
+#define LCD_USB_COUNT_MASK           (0x03FFu)
+
+/* Endpoint register, and a 16-bit word of the packet memory */
+#define LCD_USB_EPR(ep)              (*(__IO uint16_t *) (USB_BASE + ((uint32_t) (ep) * 4u)))
+#define LCD_USB_PMA(address)         ((__IO uint16_t *) (USB_PMAADDR + ((uint32_t) (address) * 2u)))
+
+/* Buffer table entry of an endpoint */
+#define LCD_USB_ADDR_TX(ep)          (*LCD_USB_PMA(((ep) * 8u) + 0u))
+#define LCD_USB_COUNT_TX(ep)         (*LCD_USB_PMA(((ep) * 8u) + 2u))
+#define LCD_USB_ADDR_RX(ep)          (*LCD_USB_PMA(((ep) * 8u) + 4u))
+#define LCD_USB_COUNT_RX(ep)         (*LCD_USB_PMA(((ep) * 8u) + 6u))
+
+/* bmRequestType: type field, and the bRequest codes answered */
+#define LCD_USB_TYPE_MASK            (0x60u)
+#define LCD_USB_TYPE_STANDARD        (0x00u)
+#define LCD_USB_TYPE_CLASS           (0x20u)
+
+#define LCD_USB_GET_STATUS           (0x00u)
+#define LCD_USB_CLEAR_FEATURE        (0x01u)
+#define LCD_USB_SET_FEATURE          (0x03u)
+#define LCD_USB_SET_ADDRESS          (0x05u)
+#define LCD_USB_GET_DESCRIPTOR       (0x06u)
+#define LCD_USB_GET_CONFIGURATION    (0x08u)
+#define LCD_USB_SET_CONFIGURATION    (0x09u)
+#define LCD_USB_GET_INTERFACE        (0x0Au)
+#define LCD_USB_SET_INTERFACE        (0x0Bu)
+
+#define LCD_USB_SET_LINE_CODING      (0x20u)
+#define LCD_USB_GET_LINE_CODING      (0x21u)
+#define LCD_USB_SET_CONTROL_LINE     (0x22u)
+#define LCD_USB_SEND_BREAK           (0x23u)
+
+/* Descriptor types */
+#define LCD_USB_DEVICE               (0x01u)
+#define LCD_USB_CONFIGURATION        (0x02u)
+#define LCD_USB_STRING               (0x03u)
+
+/* SET_ADDRESS taken, applied once its status stage is out */
+#define LCD_USB_ADDRESS_PENDING      (0x80u)
+
+#define LCD_USB_LINE_CODING_SIZE     (7u)
+#define LCD_USB_STRING_MAX           (32u)
+
+/* Device transceiver startup time (tSTARTUP, data sheet) */
+#define LCD_USB_STARTUP_US           (1u)
+
+static uint8_t const LCD_usbDevice[] =
+{
+    18u, LCD_USB_DEVICE,
+    0x00u, 0x02u,                           /* USB 2.0 */
+    0x02u, 0x00u, 0x00u,                    /* Class CDC */
+    LCD_USB_EP0_SIZE,
+    (uint8_t) LCD_USB_VID, (uint8_t) (LCD_USB_VID >> 8u),
+    (uint8_t) LCD_USB_PID, (uint8_t) (LCD_USB_PID >> 8u),
+    0x00u, 0x02u,                           /* Device release 2.00 */
+    1u, 2u, 0u,                             /* Manufacturer, product, no serial number */
+    1u                                      /* Configurations */
+};
+
+static uint8_t const LCD_usbConfigurationSet[] =
+{
+    9u, LCD_USB_CONFIGURATION, 67u, 0u,
+    2u, 1u, 0u,                             /* Interfaces, its value, no string */
+    0x80u, 50u,                             /* Bus powered, 100 mA */
+
+    /* Communication interface: ACM, with header, call management, ACM and union descriptors */
+    9u, 0x04u, 0u, 0u, 1u, 0x02u, 0x02u, 0x01u, 0u,
+    5u, 0x24u, 0x00u, 0x10u, 0x01u,
+    5u, 0x24u, 0x01u, 0x00u, 1u,
+    4u, 0x24u, 0x02u, 0x02u,
+    5u, 0x24u, 0x06u, 0u, 1u,
+    7u, 0x05u, 0x80u | LCD_USB_EP_NOTIFY, 0x03u, LCD_USB_NOTIFY_SIZE, 0u, 255u,
+
+    /* Data interface, bulk OUT and IN */
+    9u, 0x04u, 1u, 0u, 2u, 0x0Au, 0x00u, 0x00u, 0u,
+    7u, 0x05u, LCD_USB_EP_DATA, 0x02u, LCD_USB_PACKET, 0u, 0u,
+    7u, 0x05u, 0x80u | LCD_USB_EP_DATA, 0x02u, LCD_USB_PACKET, 0u, 0u
+};
+
+/* String 0: US English */
+static uint8_t const LCD_usbLanguage[] = { 4u, LCD_USB_STRING, 0x09u, 0x04u };
+
+/* Strings 1 and 2, sent as UTF-16 */
+static char const *const LCD_usbText[] =
+{
+    "HD44780 LCD driver",
+    "HD44780 remote display"
+};
+
+/* 115200 baud, 1 stop bit, no parity, 8 data bits; only echoed back */
+static uint8_t LCD_usbLineCoding[LCD_USB_LINE_CODING_SIZE] = { 0x00u, 0xC2u, 0x01u, 0x00u, 0u, 0u, 8u };
+
+static uint8_t LCD_usbString[2u + (2u * LCD_USB_STRING_MAX)];
+static uint8_t const LCD_usbZero[2] = { 0u, 0u };
+
+static volatile uint8_t LCD_usbConfiguration = 0u;
+static uint8_t LCD_usbAddress = 0u;
+
+/* Control IN stage still to send, and the class request whose data stage
+ * comes in next
+ */
+static uint8_t const *LCD_usbEp0Data = NULL;
+static uint16_t LCD_usbEp0Left = 0u;
+static uint8_t LCD_usbEp0Zlp = 0u;
+static uint8_t LCD_usbEp0Out = 0u;
+
+/* Bulk packet held for LCD_UsbPoll(), 0 = none (endpoint VALID) */
+static uint8_t LCD_usbPacket[LCD_USB_PACKET];
+static volatile uint16_t LCD_usbLength = 0u;
+
+static void LCD_UsbReset(void) ;
+static void LCD_UsbControl(void) ;
+static void LCD_UsbData(void) ;
+static uint8_t LCD_UsbSetup(uint8_t const setup[]) ;
+static uint8_t LCD_UsbDescriptor(uint16_t value, uint16_t requested) ;
+static void LCD_UsbConfigure(uint8_t configuration) ;
+static void LCD_UsbReply(uint8_t const data[], uint16_t length, uint16_t requested) ;
+static void LCD_UsbReplyNext(void) ;
+static void LCD_UsbOpen(uint8_t ep, uint16_t type) ;
+static void LCD_UsbSetRx(uint8_t ep, uint16_t status) ;
+static void LCD_UsbSetTx(uint8_t ep, uint16_t status) ;
+static void LCD_UsbClearRx(uint8_t ep) ;
+static void LCD_UsbClearTx(uint8_t ep) ;
+static void LCD_UsbWrite(uint16_t buffer, uint8_t const data[], uint16_t length) ;
+static void LCD_UsbRead(uint16_t buffer, uint8_t data[], uint16_t length) ;
+static void LCD_UsbPullUp(uint8_t on) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbStart
+********************************************************************************
+*
+* Summary:
+*  Brings up the USB device: 48 MHz USB clock, transceiver out of power
+*  down, reset and transfer interrupts, then the D+ pull-up, so the host
+*  enumerates the port.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if the device is on the bus, 0 if the system clock is not the PLL at
+*  72 or 48 MHz.
+*
+*******************************************************************************/
+uint8_t LCD_UsbStart(void)
+{
+    if (LL_RCC_GetSysClkSource() != LL_RCC_SYS_CLKSOURCE_STATUS_PLL)
+    {
+        return 0u;
+    }
+
+    LCD_UsbPullUp(0u);
+    HAL_NVIC_DisableIRQ(USB_LP_CAN1_RX0_IRQn);
+
+    /* The prescaler may only change while the USB clock is off */
+    LL_APB1_GRP1_DisableClock(LL_APB1_GRP1_PERIPH_USB);
+    if (SystemCoreClock == 72000000u)
+    {
+        LL_RCC_SetUSBClockSource(LL_RCC_USB_CLKSOURCE_PLL_DIV_1_5);
+    }
+    else if (SystemCoreClock == 48000000u)
+    {
+        LL_RCC_SetUSBClockSource(LL_RCC_USB_CLKSOURCE_PLL);
+    }
+    else
+    {
+        return 0u;
+    }
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_USB);
+
+    /* Transceiver on, the logic held in reset while it starts */
+    USB->CNTR = (uint16_t) USB_CNTR_FRES;
+    LCD_DelayUs(LCD_USB_STARTUP_US);
+    USB->CNTR = 0u;
+    USB->ISTR = 0u;
+
+    LCD_usbConfiguration = 0u;
+    LCD_usbLength = 0u;
+    USB->CNTR = (uint16_t) (USB_CNTR_CTRM | USB_CNTR_RESETM);
+    HAL_NVIC_SetPriority(USB_LP_CAN1_RX0_IRQn, LCD_USB_IRQ_PRIORITY, 0u);
+    HAL_NVIC_EnableIRQ(USB_LP_CAN1_RX0_IRQn);
+
+    /* Attach: the host resets the bus and enumerates */
+    LCD_UsbPullUp(1u);
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbPoll
+********************************************************************************
+*
+* Summary:
+*  Feeds the bulk packet the interrupt took to LCD_RemoteFeed(), then lets
+*  the host send the next one.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Number of frames applied.
+*
+* Reentrant:
+*  No, one caller (main loop), not interleaved with LCD_RemoteFeed().
+*
+*******************************************************************************/
+uint8_t LCD_UsbPoll(void)
+{
+    uint16_t const length = LCD_usbLength;
+    uint8_t applied;
+
+    if (length == 0u)
+    {
+        return 0u;
+    }
+
+    applied = LCD_RemoteFeed(LCD_usbPacket, length);
+
+    /* The interrupt writes the same endpoint register (reset, configuration) */
+    HAL_NVIC_DisableIRQ(USB_LP_CAN1_RX0_IRQn);
+    LCD_usbLength = 0u;
+    if (LCD_usbConfiguration != 0u)
+    {
+        LCD_UsbSetRx(LCD_USB_EP_DATA, (uint16_t) USB_EP_RX_VALID);
+    }
+    HAL_NVIC_EnableIRQ(USB_LP_CAN1_RX0_IRQn);
+
+    return applied;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbIsConfigured
+********************************************************************************
+*
+* Summary:
+*  Reports whether a host has enumerated and configured the port.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 once configured, 0 while detached, reset or unconfigured.
+*
+*******************************************************************************/
+uint8_t LCD_UsbIsConfigured(void)
+{
+    return (LCD_usbConfiguration != 0u) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbIRQHandler
+********************************************************************************
+*
+* Summary:
+*  USB low priority interrupt: bus reset, then every completed transfer,
+*  endpoint by endpoint.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_UsbIRQHandler(void)
+{
+    uint16_t istr;
+
+    if ((USB->ISTR & USB_ISTR_RESET) != 0u)
+    {
+        USB->ISTR = (uint16_t) ~USB_ISTR_RESET;
+        LCD_UsbReset();
+    }
+
+    for (istr = USB->ISTR; (istr & USB_ISTR_CTR) != 0u; istr = USB->ISTR)
+    {
+        switch (istr & USB_ISTR_EP_ID)
+        {
+            case LCD_USB_EP_CONTROL:
+                LCD_UsbControl();
+                break;
+
+            case LCD_USB_EP_DATA:
+                LCD_UsbData();
+                break;
+
+            default:
+                /* Notification endpoint, never armed */
+                LCD_UsbClearRx((uint8_t) (istr & USB_ISTR_EP_ID));
+                LCD_UsbClearTx((uint8_t) (istr & USB_ISTR_EP_ID));
+                break;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbReset
+********************************************************************************
+*
+* Summary:
+*  Bus reset: buffer table, endpoint 0 open at address 0, unconfigured.
+*
+*******************************************************************************/
+static void LCD_UsbReset(void)
+{
+    USB->BTABLE = 0u;
+
+    LCD_USB_ADDR_TX(LCD_USB_EP_CONTROL) = LCD_USB_EP0_TX_BUFFER;
+    LCD_USB_COUNT_TX(LCD_USB_EP_CONTROL) = 0u;
+    LCD_USB_ADDR_RX(LCD_USB_EP_CONTROL) = LCD_USB_EP0_RX_BUFFER;
+    LCD_USB_COUNT_RX(LCD_USB_EP_CONTROL) = LCD_USB_RX_64;
+    LCD_USB_ADDR_TX(LCD_USB_EP_DATA) = LCD_USB_DATA_TX_BUFFER;
+    LCD_USB_COUNT_TX(LCD_USB_EP_DATA) = 0u;
+    LCD_USB_ADDR_RX(LCD_USB_EP_DATA) = LCD_USB_DATA_RX_BUFFER;
+    LCD_USB_COUNT_RX(LCD_USB_EP_DATA) = LCD_USB_RX_64;
+    LCD_USB_ADDR_TX(LCD_USB_EP_NOTIFY) = LCD_USB_NOTIFY_TX_BUFFER;
+    LCD_USB_COUNT_TX(LCD_USB_EP_NOTIFY) = 0u;
+
+    LCD_usbConfiguration = 0u;
+    LCD_usbAddress = 0u;
+    LCD_usbEp0Left = 0u;
+    LCD_usbEp0Zlp = 0u;
+    LCD_usbEp0Out = 0u;
+
+    LCD_UsbOpen(LCD_USB_EP_CONTROL, (uint16_t) USB_EP_CONTROL);
+    LCD_UsbSetRx(LCD_USB_EP_CONTROL, (uint16_t) USB_EP_RX_VALID);
+    LCD_UsbSetTx(LCD_USB_EP_CONTROL, (uint16_t) USB_EP_TX_NAK);
+
+    USB->DADDR = (uint16_t) USB_DADDR_EF;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbControl
+********************************************************************************
+*
+* Summary:
+*  Endpoint 0: sends the rest of an IN stage, answers a SETUP, takes the
+*  data stage of SET_LINE_CODING, and stalls requests it does not know.
+*
+*******************************************************************************/
+static void LCD_UsbControl(void)
+{
+    uint16_t const epr = LCD_USB_EPR(LCD_USB_EP_CONTROL);
+    uint8_t setup[8];
+    uint16_t count;
+
+    if ((epr & USB_EP_CTR_TX) != 0u)
+    {
+        LCD_UsbClearTx(LCD_USB_EP_CONTROL);
+
+        /* The status stage of SET_ADDRESS went out at address 0 */
+        if ((LCD_usbAddress & LCD_USB_ADDRESS_PENDING) != 0u)
+        {
+            USB->DADDR = (uint16_t) (USB_DADDR_EF | (LCD_usbAddress & (uint8_t) ~LCD_USB_ADDRESS_PENDING));
+            LCD_usbAddress = 0u;
+        }
+        LCD_UsbReplyNext();
+    }
+
+    if ((epr & USB_EP_CTR_RX) != 0u)
+    {
+        count = LCD_USB_COUNT_RX(LCD_USB_EP_CONTROL) & LCD_USB_COUNT_MASK;
+
+        if ((epr & USB_EP_SETUP) != 0u)
+        {
+            LCD_UsbRead(LCD_USB_EP0_RX_BUFFER, setup, sizeof(setup));
+            LCD_UsbClearRx(LCD_USB_EP_CONTROL);
+
+            if ((count != sizeof(setup)) || (LCD_UsbSetup(setup) == 0u))
+            {
+                LCD_UsbSetTx(LCD_USB_EP_CONTROL, (uint16_t) USB_EP_TX_STALL);
+                LCD_UsbSetRx(LCD_USB_EP_CONTROL, (uint16_t) USB_EP_RX_STALL);
+                return;
+            }
+        }
+        else
+        {
+            LCD_UsbClearRx(LCD_USB_EP_CONTROL);
+
+            /* Data stage of SET_LINE_CODING, otherwise the status of an IN stage */
+            if (LCD_usbEp0Out == LCD_USB_SET_LINE_CODING)
+            {
+                LCD_UsbRead(LCD_USB_EP0_RX_BUFFER, LCD_usbLineCoding,
+                            (count < LCD_USB_LINE_CODING_SIZE) ? count : LCD_USB_LINE_CODING_SIZE);
+                LCD_usbEp0Out = 0u;
+                LCD_UsbReply(NULL, 0u, 0u);
+            }
+        }
+
+        LCD_UsbSetRx(LCD_USB_EP_CONTROL, (uint16_t) USB_EP_RX_VALID);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbData
+********************************************************************************
+*
+* Summary:
+*  Bulk endpoint: copies a received packet out for LCD_UsbPoll(); the
+*  endpoint NAKs until the poll re-arms it. An empty packet re-arms at once.
+*
+*******************************************************************************/
+static void LCD_UsbData(void)
+{
+    uint16_t const epr = LCD_USB_EPR(LCD_USB_EP_DATA);
+    uint16_t length;
+
+    if ((epr & USB_EP_CTR_RX) != 0u)
+    {
+        length = LCD_USB_COUNT_RX(LCD_USB_EP_DATA) & LCD_USB_COUNT_MASK;
+        if (length > LCD_USB_PACKET)
+        {
+            length = LCD_USB_PACKET;
+        }
+
+        LCD_UsbRead(LCD_USB_DATA_RX_BUFFER, LCD_usbPacket, length);
+        LCD_UsbClearRx(LCD_USB_EP_DATA);
+
+        if (length == 0u)
+        {
+            LCD_UsbSetRx(LCD_USB_EP_DATA, (uint16_t) USB_EP_RX_VALID);
+        }
+        else
+        {
+            LCD_usbLength = length;
+        }
+    }
+
+    if ((epr & USB_EP_CTR_TX) != 0u)
+    {
+        /* Nothing is sent to the host */
+        LCD_UsbClearTx(LCD_USB_EP_DATA);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbSetup
+********************************************************************************
+*
+* Summary:
+*  Answers a SETUP packet: the standard requests of a device with one
+*  configuration, and the CDC ACM line requests. Returns 0 to stall.
+*
+*******************************************************************************/
+static uint8_t LCD_UsbSetup(uint8_t const setup[])
+{
+    uint8_t const type = setup[0] & LCD_USB_TYPE_MASK;
+    uint8_t const request = setup[1];
+    uint16_t const value = (uint16_t) (setup[2] | ((uint16_t) setup[3] << 8u));
+    uint16_t const requested = (uint16_t) (setup[6] | ((uint16_t) setup[7] << 8u));
+    uint8_t handled = 1u;
+
+    LCD_usbEp0Out = 0u;
+    LCD_usbEp0Left = 0u;
+    LCD_usbEp0Zlp = 0u;
+
+    if (type == LCD_USB_TYPE_CLASS)
+    {
+        switch (request)
+        {
+            case LCD_USB_SET_LINE_CODING:
+                /* The status goes out after the data stage */
+                LCD_usbEp0Out = LCD_USB_SET_LINE_CODING;
+                break;
+
+            case LCD_USB_GET_LINE_CODING:
+                LCD_UsbReply(LCD_usbLineCoding, LCD_USB_LINE_CODING_SIZE, requested);
+                break;
+
+            case LCD_USB_SET_CONTROL_LINE:
+            case LCD_USB_SEND_BREAK:
+                LCD_UsbReply(NULL, 0u, 0u);
+                break;
+
+            default:
+                handled = 0u;
+                break;
+        }
+    }
+    else if (type == LCD_USB_TYPE_STANDARD)
+    {
+        switch (request)
+        {
+            case LCD_USB_GET_STATUS:
+                LCD_UsbReply(LCD_usbZero, 2u, requested);
+                break;
+
+            case LCD_USB_CLEAR_FEATURE:
+            case LCD_USB_SET_FEATURE:
+            case LCD_USB_SET_INTERFACE:
+                /* No remote wakeup and no alternate settings to change */
+                LCD_UsbReply(NULL, 0u, 0u);
+                break;
+
+            case LCD_USB_SET_ADDRESS:
+                LCD_usbAddress = (uint8_t) (LCD_USB_ADDRESS_PENDING | (value & 0x7Fu));
+                LCD_UsbReply(NULL, 0u, 0u);
+                break;
+
+            case LCD_USB_GET_DESCRIPTOR:
+                handled = LCD_UsbDescriptor(value, requested);
+                break;
+
+            case LCD_USB_GET_CONFIGURATION:
+                LCD_UsbReply((uint8_t const *) &LCD_usbConfiguration, 1u, requested);
+                break;
+
+            case LCD_USB_SET_CONFIGURATION:
+                if (value > 1u)
+                {
+                    handled = 0u;
+                    break;
+                }
+                LCD_UsbConfigure((uint8_t) value);
+                LCD_UsbReply(NULL, 0u, 0u);
+                break;
+
+            case LCD_USB_GET_INTERFACE:
+                LCD_UsbReply(LCD_usbZero, 1u, requested);
+                break;
+
+            default:
+                handled = 0u;
+                break;
+        }
+    }
+    else
+    {
+        handled = 0u;
+    }
+
+    return handled;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbDescriptor
+********************************************************************************
+*
+* Summary:
+*  Sends the device, configuration or string descriptor of a GET_DESCRIPTOR.
+*  Returns 0 for the others (a full-speed only device has no qualifier).
+*
+*******************************************************************************/
+static uint8_t LCD_UsbDescriptor(uint16_t value, uint16_t requested)
+{
+    uint8_t const index = (uint8_t) value;
+    char const *text;
+    uint8_t length = 0u;
+
+    switch (value >> 8u)
+    {
+        case LCD_USB_DEVICE:
+            LCD_UsbReply(LCD_usbDevice, sizeof(LCD_usbDevice), requested);
+            break;
+
+        case LCD_USB_CONFIGURATION:
+            LCD_UsbReply(LCD_usbConfigurationSet, sizeof(LCD_usbConfigurationSet), requested);
+            break;
+
+        case LCD_USB_STRING:
+            if (index == 0u)
+            {
+                LCD_UsbReply(LCD_usbLanguage, sizeof(LCD_usbLanguage), requested);
+                break;
+            }
+            if (index > (sizeof(LCD_usbText) / sizeof(LCD_usbText[0])))
+            {
+                return 0u;
+            }
+
+            text = LCD_usbText[index - 1u];
+            while ((text[length] != '\0') && (length < LCD_USB_STRING_MAX))
+            {
+                LCD_usbString[2u + (2u * length)] = (uint8_t) text[length];
+                LCD_usbString[3u + (2u * length)] = 0u;
+                length++;
+            }
+            LCD_usbString[0] = (uint8_t) (2u + (2u * length));
+            LCD_usbString[1] = LCD_USB_STRING;
+            LCD_UsbReply(LCD_usbString, LCD_usbString[0], requested);
+            break;
+
+        default:
+            return 0u;
+    }
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbConfigure
+********************************************************************************
+*
+* Summary:
+*  SET_CONFIGURATION: opens the data and notification endpoints at DATA0
+*  for configuration 1, closes them for 0. A packet still held for
+*  LCD_UsbPoll() keeps the bulk endpoint NAKing.
+*
+*******************************************************************************/
+static void LCD_UsbConfigure(uint8_t configuration)
+{
+    LCD_usbConfiguration = configuration;
+
+    if (configuration == 0u)
+    {
+        LCD_UsbSetRx(LCD_USB_EP_DATA, 0u);
+        LCD_UsbSetTx(LCD_USB_EP_DATA, 0u);
+        LCD_UsbSetTx(LCD_USB_EP_NOTIFY, 0u);
+        return;
+    }
+
+    LCD_UsbOpen(LCD_USB_EP_DATA, (uint16_t) USB_EP_BULK);
+    LCD_UsbSetTx(LCD_USB_EP_DATA, (uint16_t) USB_EP_TX_NAK);
+    LCD_UsbSetRx(LCD_USB_EP_DATA, (LCD_usbLength == 0u) ? (uint16_t) USB_EP_RX_VALID : (uint16_t) USB_EP_RX_NAK);
+
+    LCD_UsbOpen(LCD_USB_EP_NOTIFY, (uint16_t) USB_EP_INTERRUPT);
+    LCD_UsbSetTx(LCD_USB_EP_NOTIFY, (uint16_t) USB_EP_TX_NAK);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbReply
+********************************************************************************
+*
+* Summary:
+*  Starts the IN stage of a control request, cut to the length the host
+*  asked for; length 0 sends the status stage of a request without data.
+*
+*******************************************************************************/
+static void LCD_UsbReply(uint8_t const data[], uint16_t length, uint16_t requested)
+{
+    if (length > requested)
+    {
+        length = requested;
+    }
+
+    LCD_usbEp0Data = data;
+    LCD_usbEp0Left = length;
+
+    /* A shorter reply that fills its last packet ends with an empty one */
+    LCD_usbEp0Zlp = ((length == 0u) || ((length < requested) && ((length % LCD_USB_EP0_SIZE) == 0u))) ? 1u : 0u;
+
+    LCD_UsbReplyNext();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbReplyNext
+********************************************************************************
+*
+* Summary:
+*  Arms endpoint 0 with the next packet of the IN stage, if any is left.
+*
+*******************************************************************************/
+static void LCD_UsbReplyNext(void)
+{
+    uint16_t const chunk = (LCD_usbEp0Left < LCD_USB_EP0_SIZE) ? LCD_usbEp0Left : LCD_USB_EP0_SIZE;
+
+    if (chunk == 0u)
+    {
+        if (LCD_usbEp0Zlp == 0u)
+        {
+            /* Stage complete, the host sends the status */
+            return;
+        }
+        LCD_usbEp0Zlp = 0u;
+    }
+    else
+    {
+        LCD_UsbWrite(LCD_USB_EP0_TX_BUFFER, LCD_usbEp0Data, chunk);
+        LCD_usbEp0Data += chunk;
+        LCD_usbEp0Left -= chunk;
+    }
+
+    LCD_USB_COUNT_TX(LCD_USB_EP_CONTROL) = chunk;
+    LCD_UsbSetTx(LCD_USB_EP_CONTROL, (uint16_t) USB_EP_TX_VALID);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbOpen
+********************************************************************************
+*
+* Summary:
+*  Sets type and address of an endpoint and puts both data toggles back to
+*  DATA0 (a toggle bit written as 1 flips, so the set ones are written back).
+*
+*******************************************************************************/
+static void LCD_UsbOpen(uint8_t ep, uint16_t type)
+{
+    LCD_USB_EPR(ep) = (uint16_t) (type | ep | (LCD_USB_EPR(ep) & (USB_EP_DTOG_RX | USB_EP_DTOG_TX)));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbSetRx
+********************************************************************************
+*
+* Summary:
+*  Sets STAT_RX of an endpoint. The status bits toggle on a written 1, the
+*  transfer flags are only cleared by a written 0, so both flags are written
+*  as 1 and the status as its difference to the wanted one.
+*
+*******************************************************************************/
+static void LCD_UsbSetRx(uint8_t ep, uint16_t status)
+{
+    uint16_t const epr = (uint16_t) (LCD_USB_EPR(ep) & USB_EPRX_DTOGMASK);
+
+    LCD_USB_EPR(ep) = (uint16_t) ((epr ^ status) | USB_EP_CTR_RX | USB_EP_CTR_TX);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbSetTx
+********************************************************************************
+*
+* Summary:
+*  Sets STAT_TX of an endpoint, as LCD_UsbSetRx().
+*
+*******************************************************************************/
+static void LCD_UsbSetTx(uint8_t ep, uint16_t status)
+{
+    uint16_t const epr = (uint16_t) (LCD_USB_EPR(ep) & USB_EPTX_DTOGMASK);
+
+    LCD_USB_EPR(ep) = (uint16_t) ((epr ^ status) | USB_EP_CTR_RX | USB_EP_CTR_TX);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbClearRx
+********************************************************************************
+*
+* Summary:
+*  Clears CTR_RX of an endpoint, leaving toggles, status and CTR_TX.
+*
+*******************************************************************************/
+static void LCD_UsbClearRx(uint8_t ep)
+{
+    LCD_USB_EPR(ep) = (uint16_t) ((LCD_USB_EPR(ep) & USB_EPREG_MASK & ~USB_EP_CTR_RX) | USB_EP_CTR_TX);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbClearTx
+********************************************************************************
+*
+* Summary:
+*  Clears CTR_TX of an endpoint, leaving toggles, status and CTR_RX.
+*
+*******************************************************************************/
+static void LCD_UsbClearTx(uint8_t ep)
+{
+    LCD_USB_EPR(ep) = (uint16_t) ((LCD_USB_EPR(ep) & USB_EPREG_MASK & ~USB_EP_CTR_TX) | USB_EP_CTR_RX);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbWrite
+********************************************************************************
+*
+* Summary:
+*  Copies bytes into a packet memory buffer, two per 16-bit word.
+*
+*******************************************************************************/
+static void LCD_UsbWrite(uint16_t buffer, uint8_t const data[], uint16_t length)
+{
+    __IO uint16_t *word = LCD_USB_PMA(buffer);
+    uint16_t index;
+    uint16_t pair;
+
+    for (index = 0u; index < length; index += 2u)
+    {
+        pair = data[index];
+        if ((index + 1u) < length)
+        {
+            pair |= (uint16_t) ((uint16_t) data[index + 1u] << 8u);
+        }
+        *word = pair;
+
+        /* The next word is 4 bytes on in the core's address space */
+        word += 2u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbRead
+********************************************************************************
+*
+* Summary:
+*  Copies bytes out of a packet memory buffer.
+*
+*******************************************************************************/
+static void LCD_UsbRead(uint16_t buffer, uint8_t data[], uint16_t length)
+{
+    __IO uint16_t const *word = LCD_USB_PMA(buffer);
+    uint16_t index;
+    uint16_t pair;
+
+    for (index = 0u; index < length; index += 2u)
+    {
+        pair = *word;
+        data[index] = (uint8_t) pair;
+        if ((index + 1u) < length)
+        {
+            data[index + 1u] = (uint8_t) (pair >> 8u);
+        }
+        word += 2u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_UsbPullUp
+********************************************************************************
+*
+* Summary:
+*  Connects or releases the D+ pull-up through LCD_USB_PULLUP_PIN; nothing
+*  to do with a fixed pull-up.
+*
+*******************************************************************************/
+static void LCD_UsbPullUp(uint8_t on)
+{
+    #if (LCD_USB_PULLUP_PIN != 0u)
+        LL_GPIO_SetPinMode(LCD_USB_PULLUP_PORT, LCD_USB_PULLUP_PIN, LL_GPIO_MODE_OUTPUT);
+        LL_GPIO_SetPinOutputType(LCD_USB_PULLUP_PORT, LCD_USB_PULLUP_PIN, LL_GPIO_OUTPUT_PUSHPULL);
+        if ((on != 0u) == (LCD_USB_PULLUP_ACTIVE_LOW != 0u))
+        {
+            LL_GPIO_ResetOutputPin(LCD_USB_PULLUP_PORT, LCD_USB_PULLUP_PIN);
+        }
+        else
+        {
+            LL_GPIO_SetOutputPin(LCD_USB_PULLUP_PORT, LCD_USB_PULLUP_PIN);
+        }
+    #else
+        (void) on;
+    #endif /* LCD_USB_PULLUP_PIN != 0u */
+}
+
+#endif /* LCD_USE_USB_CDC != 0u */
@@ -0,0 +1,393 @@
+/*
+ *  LCD_Utf8.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: UTF-8 text for the HD44780 LCD driver.
+ *
+ *  			LCD_PrintUtf8() decodes UTF-8 and maps every code point onto
+ *  			a character code of the module ROM selected by
+ *  			LCD_CHARACTER_ROM (A00 Japanese or A02 European). Code points
+ *  			the ROM lacks but that are common in instrument texts (umlauts
+ *  			on A00, arrows on A02, the euro sign) map onto built-in 5x8
+ *  			glyphs that the glyph manager keeps in CGRAM; anything else
+ *  			prints LCD_UTF8_UNKNOWN.
+ *
+ *  			The lookup is two table reads per code point: the high byte of
+ *  			the code point selects at most one block of its 256-code page,
+ *  			the low byte indexes the block. Tables are const (flash) and
+ *  			only the ones of the selected ROM are built.
+ *
+ *  Usage:      - LCD_PrintUtf8("25.0\xC2\xB0" "C") prints 25.0 degrees C
+ *  			- LCD_Utf8Code() maps one code point, e.g. for LCD_PutChar()
+ *  			- without LCD_USE_GLYPH_CACHE the fallback glyphs print
+ *  				LCD_UTF8_UNKNOWN
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Glyph.h"
+#include "LCD_Utf8.h"
+
+#if (LCD_USE_UTF8 != 0u)
+
+/* Table entry: 0 = not available, 1 - LCD_UTF8_GLYPHS = fallback glyph,
+ * from 0x10 on the ROM character code (0x00 - 0x0F are CGRAM)
+ */
+#define LCD_UTF8_NONE                (0x00u)
+#define LCD_UTF8_ROM_FIRST           (0x10u)
+
+/* Fallback glyphs */
+#define LCD_UTF8_G_BACKSLASH         (1u)
+#define LCD_UTF8_G_TILDE             (2u)
+#define LCD_UTF8_G_A_UMLAUT          (3u)      /* U+00C4 */
+#define LCD_UTF8_G_O_UMLAUT          (4u)      /* U+00D6 */
+#define LCD_UTF8_G_U_UMLAUT          (5u)      /* U+00DC */
+#define LCD_UTF8_G_E_ACUTE           (6u)      /* U+00E9 */
+#define LCD_UTF8_G_E_GRAVE           (7u)      /* U+00E8 */
+#define LCD_UTF8_G_A_GRAVE           (8u)      /* U+00E0 */
+#define LCD_UTF8_G_UP                (9u)      /* U+2191 */
+#define LCD_UTF8_G_DOWN              (10u)     /* U+2193 */
+#define LCD_UTF8_G_RIGHT             (11u)     /* U+2192 */
+#define LCD_UTF8_G_LEFT              (12u)     /* U+2190 */
+#define LCD_UTF8_G_EURO              (13u)     /* U+20AC */
+#define LCD_UTF8_GLYPHS              (13u)
+
+/* Code points per page, pages with a block */
+#define LCD_UTF8_PAGE_SIZE           (256u)
+#define LCD_UTF8_PAGES               (256u)
+
+/* Code points of a page covered by one table, or a linear range when codes is
+ * NULL (ROM code = base + offset)
+ */
+typedef struct
+{
+    uint8_t first;                  /* Low byte of the first code point */
+    uint8_t last;                   /* Low byte of the last code point */
+    uint8_t base;                   /* Linear ranges: ROM code of "first" */
+    uint8_t const *codes;           /* Table entries, last - first + 1 */
+} LCD_UTF8_BLOCK;
+
+static uint8_t const LCD_utf8Glyph[LCD_UTF8_GLYPHS][LCD_GLYPH_ROWS] =
+{
+    { 0x00u, 0x10u, 0x08u, 0x04u, 0x02u, 0x01u, 0x00u, 0x00u },  /* backslash */
+    { 0x00u, 0x00u, 0x08u, 0x15u, 0x02u, 0x00u, 0x00u, 0x00u },  /* tilde */
+    { 0x0Au, 0x00u, 0x0Eu, 0x11u, 0x1Fu, 0x11u, 0x11u, 0x00u },  /* A umlaut */
+    { 0x0Au, 0x00u, 0x0Eu, 0x11u, 0x11u, 0x11u, 0x0Eu, 0x00u },  /* O umlaut */
+    { 0x0Au, 0x00u, 0x11u, 0x11u, 0x11u, 0x11u, 0x0Eu, 0x00u },  /* U umlaut */
+    { 0x02u, 0x04u, 0x0Eu, 0x11u, 0x1Fu, 0x10u, 0x0Eu, 0x00u },  /* e acute */
+    { 0x08u, 0x04u, 0x0Eu, 0x11u, 0x1Fu, 0x10u, 0x0Eu, 0x00u },  /* e grave */
+    { 0x08u, 0x04u, 0x0Eu, 0x01u, 0x0Fu, 0x11u, 0x0Fu, 0x00u },  /* a grave */
+    { 0x04u, 0x0Eu, 0x15u, 0x04u, 0x04u, 0x04u, 0x04u, 0x00u },  /* up arrow */
+    { 0x04u, 0x04u, 0x04u, 0x04u, 0x15u, 0x0Eu, 0x04u, 0x00u },  /* down arrow */
+    { 0x00u, 0x04u, 0x02u, 0x1Fu, 0x02u, 0x04u, 0x00u, 0x00u },  /* right arrow */
+    { 0x00u, 0x04u, 0x08u, 0x1Fu, 0x08u, 0x04u, 0x00u, 0x00u },  /* left arrow */
+    { 0x06u, 0x09u, 0x1Cu, 0x08u, 0x1Cu, 0x09u, 0x06u, 0x00u }   /* euro */
+};
+
+#if (LCD_CHARACTER_ROM == LCD_ROM_A00)
+
+/* U+00A0 - U+00FF */
+static uint8_t const LCD_utf8Latin1[0x60u] =
+{
+    /* A0 */ 0x20u, 0x00u, 0xECu, 0xEDu, 0x00u, 0x5Cu, 0x00u, 0x00u,
+    /* A8 */ 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    /* B0 */ 0xDFu, 0x00u, 0x00u, 0x00u, 0x00u, 0xE4u, 0x00u, 0xA5u,
+    /* B8 */ 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    /* C0 */ 0x00u, 0x00u, 0x00u, 0x00u, LCD_UTF8_G_A_UMLAUT, 0x00u, 0x00u, 0x00u,
+    /* C8 */ 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    /* D0 */ 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, LCD_UTF8_G_O_UMLAUT, 0x78u,
+    /* D8 */ 0x00u, 0x00u, 0x00u, 0x00u, LCD_UTF8_G_U_UMLAUT, 0x00u, 0x00u, 0xE2u,
+    /* E0 */ LCD_UTF8_G_A_GRAVE, 0x00u, 0x00u, 0x00u, 0xE1u, 0x00u, 0x00u, 0x00u,
+    /* E8 */ LCD_UTF8_G_E_GRAVE, LCD_UTF8_G_E_ACUTE, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    /* F0 */ 0x00u, 0xEEu, 0x00u, 0x00u, 0x00u, 0x00u, 0xEFu, 0xFDu,
+    /* F8 */ 0x00u, 0x00u, 0x00u, 0x00u, 0xF5u, 0x00u, 0x00u, 0x00u
+};
+
+/* U+03A3 - U+03C3 (Greek capitals and small letters in the ROM) */
+static uint8_t const LCD_utf8Greek[0x21u] =
+{
+    /* A3 */ 0xF6u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0xF4u, 0x00u,
+    /* AB */ 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0xE0u, 0xE2u,
+    /* B3 */ 0x00u, 0x00u, 0xE3u, 0x00u, 0x00u, 0xF2u, 0x00u, 0x00u,
+    /* BB */ 0x00u, 0xE4u, 0x00u, 0x00u, 0x00u, 0xF7u, 0xE6u, 0x00u,
+    /* C3 */ 0xE5u
+};
+
+/* U+2190 - U+2193 */
+static uint8_t const LCD_utf8Arrows[4u] = { 0x7Fu, LCD_UTF8_G_UP, 0x7Eu, LCD_UTF8_G_DOWN };
+
+/* U+221A - U+221E */
+static uint8_t const LCD_utf8Math[5u] = { 0xE8u, 0x00u, 0x00u, 0x00u, 0xF3u };
+
+/* U+3001 - U+300D (ideographic comma, full stop, corner brackets) */
+static uint8_t const LCD_utf8CjkPunct[13u] =
+{
+    0xA4u, 0xA1u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0xA2u, 0xA3u
+};
+
+static uint8_t const LCD_utf8Euro[1u] = { LCD_UTF8_G_EURO };
+static uint8_t const LCD_utf8Block[1u] = { 0xFFu };
+static uint8_t const LCD_utf8Sen[1u] = { 0xFAu };       /* U+5343 */
+static uint8_t const LCD_utf8Man[1u] = { 0xFBu };       /* U+4E07 */
+static uint8_t const LCD_utf8En[1u] = { 0xFCu };        /* U+5186 */
+
+static LCD_UTF8_BLOCK const LCD_utf8Blocks[] =
+{
+    { 0x00u, 0x00u, 0x00u, NULL },                      /* page entry 0: no block */
+    { 0xA0u, 0xFFu, 0x00u, LCD_utf8Latin1 },
+    { 0xA3u, 0xC3u, 0x00u, LCD_utf8Greek },
+    { 0xACu, 0xACu, 0x00u, LCD_utf8Euro },
+    { 0x90u, 0x93u, 0x00u, LCD_utf8Arrows },
+    { 0x1Au, 0x1Eu, 0x00u, LCD_utf8Math },
+    { 0x88u, 0x88u, 0x00u, LCD_utf8Block },
+    { 0x01u, 0x0Du, 0x00u, LCD_utf8CjkPunct },
+    { 0x43u, 0x43u, 0x00u, LCD_utf8Sen },
+    { 0x07u, 0x07u, 0x00u, LCD_utf8Man },
+    { 0x86u, 0x86u, 0x00u, LCD_utf8En },
+    { 0x61u, 0x9Fu, 0xA1u, NULL }                       /* halfwidth katakana, JIS X 0201 order */
+};
+
+/* Block of each page (high byte of the code point) */
+static uint8_t const LCD_utf8Page[LCD_UTF8_PAGES] =
+{
+    [0x00u] = 1u, [0x03u] = 2u, [0x20u] = 3u, [0x21u] = 4u, [0x22u] = 5u, [0x25u] = 6u,
+    [0x30u] = 7u, [0x53u] = 8u, [0x4Eu] = 9u, [0x51u] = 10u, [0xFFu] = 11u
+};
+
+#else
+
+/* U+03BC (Greek mu, shown as the Latin-1 micro sign) */
+static uint8_t const LCD_utf8Mu[1u] = { 0xB5u };
+
+/* U+2190 - U+2193 */
+static uint8_t const LCD_utf8Arrows[4u] = { LCD_UTF8_G_LEFT, LCD_UTF8_G_UP, LCD_UTF8_G_RIGHT, LCD_UTF8_G_DOWN };
+
+static uint8_t const LCD_utf8Euro[1u] = { LCD_UTF8_G_EURO };
+
+static LCD_UTF8_BLOCK const LCD_utf8Blocks[] =
+{
+    { 0x00u, 0x00u, 0x00u, NULL },                      /* page entry 0: no block */
+    { 0xA0u, 0xFFu, 0xA0u, NULL },                      /* ISO 8859-1 upper half, same codes */
+    { 0xBCu, 0xBCu, 0x00u, LCD_utf8Mu },
+    { 0xACu, 0xACu, 0x00u, LCD_utf8Euro },
+    { 0x90u, 0x93u, 0x00u, LCD_utf8Arrows }
+};
+
+static uint8_t const LCD_utf8Page[LCD_UTF8_PAGES] =
+{
+    [0x00u] = 1u, [0x03u] = 2u, [0x20u] = 3u, [0x21u] = 4u
+};
+
+#endif /* LCD_CHARACTER_ROM == LCD_ROM_A00 */
+
+static uint32_t LCD_Utf8Decode(char const text[], size_t *index) ;
+static char LCD_Utf8Glyph(uint8_t glyph) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_PrintUtf8
+********************************************************************************
+*
+* Summary:
+*  Writes a zero terminated UTF-8 string at the cursor, every code point as
+*  one character cell.
+*
+* Parameters:
+*  text: UTF-8 string
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_PrintUtf8(char const text[])
+{
+    char run[LCD_UTF8_RUN];
+    size_t length = 0u;
+    size_t index = 0u;
+    char code;
+
+    while (text[index] != '\0')
+    {
+        code = LCD_Utf8Code(LCD_Utf8Decode(text, &index));
+
+        if ((uint8_t) code < LCD_GLYPH_SLOTS)
+        {
+            /* CGRAM code 0 would end a LCD_PrintStringN() run */
+            LCD_PrintStringN(run, length);
+            length = 0u;
+            LCD_PutChar(code);
+        }
+        else
+        {
+            run[length] = code;
+            length++;
+            if (length == LCD_UTF8_RUN)
+            {
+                LCD_PrintStringN(run, length);
+                length = 0u;
+            }
+        }
+    }
+
+    LCD_PrintStringN(run, length);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_Utf8Code
+********************************************************************************
+*
+* Summary:
+*  Returns the character code that shows a code point on the module: its ROM
+*  code, a CGRAM code for the fallback glyphs, or LCD_UTF8_UNKNOWN.
+*
+* Parameters:
+*  codePoint: Unicode code point
+*
+* Return:
+*  Character code.
+*
+* Note:
+*  A fallback glyph that is not resident is uploaded by the glyph manager.
+*
+*******************************************************************************/
+char LCD_Utf8Code(uint32_t codePoint)
+{
+    LCD_UTF8_BLOCK const *block;
+    uint8_t page;
+    uint8_t low;
+    uint8_t entry;
+
+    if ((codePoint >= 0x20u) && (codePoint < 0x7Fu))
+    {
+        #if (LCD_CHARACTER_ROM == LCD_ROM_A00)
+            /* The A00 ROM has the yen sign and the arrows there */
+            if (codePoint == 0x5Cu)
+            {
+                return LCD_Utf8Glyph(LCD_UTF8_G_BACKSLASH);
+            }
+            if (codePoint == 0x7Eu)
+            {
+                return LCD_Utf8Glyph(LCD_UTF8_G_TILDE);
+            }
+        #endif /* LCD_CHARACTER_ROM == LCD_ROM_A00 */
+
+        return (char) codePoint;
+    }
+
+    if (codePoint >= (LCD_UTF8_PAGES * LCD_UTF8_PAGE_SIZE))
+    {
+        return LCD_UTF8_UNKNOWN;
+    }
+
+    page = LCD_utf8Page[codePoint >> 8u];
+    block = &LCD_utf8Blocks[page];
+    low = (uint8_t) codePoint;
+
+    if ((page == 0u) || (low < block->first) || (low > block->last))
+    {
+        return LCD_UTF8_UNKNOWN;
+    }
+
+    if (block->codes == NULL)
+    {
+        return (char) (block->base + (low - block->first));
+    }
+
+    entry = block->codes[low - block->first];
+
+    if (entry >= LCD_UTF8_ROM_FIRST)
+    {
+        return (char) entry;
+    }
+
+    return (entry == LCD_UTF8_NONE) ? LCD_UTF8_UNKNOWN : LCD_Utf8Glyph(entry);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_Utf8Decode
+********************************************************************************
+*
+* Summary:
+*  Returns the code point at text[*index] and advances *index past it. A
+*  malformed or truncated sequence returns U+FFFD and skips one byte.
+*
+*******************************************************************************/
+static uint32_t LCD_Utf8Decode(char const text[], size_t *index)
+{
+    uint8_t const lead = (uint8_t) text[*index];
+    uint32_t codePoint;
+    uint8_t extra;
+    uint8_t count;
+    uint8_t next;
+
+    if (lead < 0x80u)
+    {
+        *index += 1u;
+        return lead;
+    }
+
+    if ((lead & 0xE0u) == 0xC0u)
+    {
+        codePoint = lead & 0x1Fu;
+        extra = 1u;
+    }
+    else if ((lead & 0xF0u) == 0xE0u)
+    {
+        codePoint = lead & 0x0Fu;
+        extra = 2u;
+    }
+    else if ((lead & 0xF8u) == 0xF0u)
+    {
+        codePoint = lead & 0x07u;
+        extra = 3u;
+    }
+    else
+    {
+        /* Continuation byte without a lead, or an invalid lead */
+        *index += 1u;
+        return 0xFFFDu;
+    }
+
+    for (count = 1u; count <= extra; count++)
+    {
+        /* Stops at the terminator too (0x00 is no continuation byte) */
+        next = (uint8_t) text[*index + count];
+        if ((next & 0xC0u) != 0x80u)
+        {
+            *index += 1u;
+            return 0xFFFDu;
+        }
+        codePoint = (codePoint << 6u) | (next & 0x3Fu);
+    }
+
+    *index += (size_t) extra + 1u;
+    return codePoint;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_Utf8Glyph
+********************************************************************************
+*
+* Summary:
+*  Returns the CGRAM code of a fallback glyph, LCD_UTF8_UNKNOWN if it cannot
+*  be made resident.
+*
+*******************************************************************************/
+static char LCD_Utf8Glyph(uint8_t glyph)
+{
+    #if (LCD_USE_GLYPH_CACHE != 0u)
+        uint8_t const code = LCD_GlyphAcquire(LCD_utf8Glyph[glyph - 1u]);
+
+        return (code == LCD_GLYPH_NO_SLOT) ? LCD_UTF8_UNKNOWN : (char) code;
+    #else
+        (void) glyph;
+        return LCD_UTF8_UNKNOWN;
+    #endif /* LCD_USE_GLYPH_CACHE != 0u */
+}
+
+#endif /* LCD_USE_UTF8 != 0u */
@@ -0,0 +1,178 @@
+/*
+ *  LCD_Warm.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Warm start of the HD44780 LCD driver.
+ *
+ *  			A watchdog reset or a firmware update restarts the MCU while
+ *  			the module stays powered, in 4-bit mode and showing the last
+ *  			screen; the full initialization would still spend about 70 ms
+ *  			on the power-on wait and the 8-bit/4-bit handshake, and blank
+ *  			the screen. Bits 7-5 of each CGRAM row are not shown and keep
+ *  			whatever is written to them, so every upload to CGRAM slot
+ *  			LCD_WARM_SLOT carries a 24-bit signature in them
+ *  			(LCD_WarmMark()), and the cold initialization leaves it there.
+ *
+ *  			LCD_WarmStart() runs from LCD_InitBegin(): the busy flag
+ *  			must clear within the longest command time (a module in its
+ *  			power-on reset stays busy for milliseconds) and the eight
+ *  			rows of the slot must read back with the signature, which a
+ *  			freshly powered module, one left in 8-bit mode or one out of
+ *  			nibble phase does not return. The function set, entry
+ *  			mode and display control are then written again so the
+ *  			mirrors are known, and the initialization completes at once.
+ *  			On a mismatch the full sequence follows as usual; its
+ *  			handshake puts the module in order from any state.
+ *
+ *  Usage:      - nothing to call, LCD_Init() / LCD_InitBegin() take the fast
+ *  				path by themselves
+ *  			- with LCD_USE_FRAME_SNAPSHOT the framebuffer is taken back
+ *  				as what the glass shows, so no cell is sent again;
+ *  				without it the old screen stays until the next flush
+ *  			- the display on E_Pin only (the one with the CGRAM shadow),
+ *  				and a wiring that can read (GPIO transport)
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Timing.h"
+#include "LCD_Glyph.h"
+#include "LCD_Handle.h"
+#include "LCD_Transport.h"
+#include "LCD_Warm.h"
+
+#if (LCD_USE_WARM_START != 0u)
+
+#if (LCD_TRANSPORT_HAS_GPIO == 0u)
+    #error "LCD_USE_WARM_START reads the module back (LCD_TRANSPORT_GPIO or _RUNTIME)"
+#endif /* LCD_TRANSPORT_HAS_GPIO == 0u */
+
+#if (LCD_WARM_SLOT >= LCD_GLYPH_SLOTS)
+    #error "LCD_WARM_SLOT must be a CGRAM slot (0-7)"
+#endif /* LCD_WARM_SLOT >= LCD_GLYPH_SLOTS */
+
+/* Signature in bits 7-5 of the rows of the slot, no two rows alike */
+static uint8_t const LCD_warmSignature[LCD_GLYPH_ROWS] =
+{
+    0xA0u, 0x40u, 0xE0u, 0x20u, 0xC0u, 0x60u, 0x80u, 0x00u
+};
+
+
+/*******************************************************************************
+* Function Name: LCD_WarmStart
+********************************************************************************
+*
+* Summary:
+*  Checks whether the selected display is still configured from before an
+*  MCU reset and, if so, writes the mode registers again.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  1 if the module is initialized and the handshake can be skipped, 0 if
+*  the full initialization is needed.
+*
+* Note:
+*  Called by LCD_InitBegin(), before the power-on wait starts.
+*
+*******************************************************************************/
+uint8_t LCD_WarmStart(void)
+{
+    uint8_t status = LCD_ReadStatus();
+    uint16_t waited = 0u;
+    uint16_t value;
+    uint8_t row;
+
+    /* A command from before the reset may still execute, a power-on reset lasts longer */
+    while ((status != LCD_STATUS_NONE) && ((status & LCD_STATUS_BUSY) != 0u) &&
+           (waited < LCD_EXEC_LONG_US))
+    {
+        LCD_DelayUs(LCD_WARM_POLL_US);
+        waited += LCD_WARM_POLL_US;
+        status = LCD_ReadStatus();
+    }
+
+    if ((LCD_IS_PRIMARY() == 0u) || (status == LCD_STATUS_NONE) ||
+        ((status & LCD_STATUS_BUSY) != 0u))
+    {
+        return 0u;
+    }
+
+    LCD_WriteControl(LCD_CGRAM_0 | LCD_WARM_ADDRESS);
+
+    for (row = 0u; row < LCD_GLYPH_ROWS; row++)
+    {
+        value = LCD_ReadData();
+        if ((value == LCD_READ_NONE) ||
+            (((uint8_t) value & LCD_WARM_SIGNATURE_MASK) != LCD_warmSignature[row]))
+        {
+            return 0u;
+        }
+    }
+
+    /* Known modes again; the screen and the other CGRAM slots are kept */
+    LCD_WriteControl(LCD_FUNCTION_SET);
+    LCD_WriteControl(LCD_CURSOR_AUTO_INCR_ON);
+    LCD_WriteControl(LCD_DISPLAY_ON_CURSOR_OFF);
+    LCD_WriteControl(LCD_DDRAM_0);
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WarmMark
+********************************************************************************
+*
+* Summary:
+*  Writes the rows of a glyph for the signature slot at the current CGRAM
+*  address, with the signature in the bits that are not shown.
+*
+* Parameters:
+*  pattern: LCD_GLYPH_ROWS rows, bits 4-0 used
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WarmMark(uint8_t const pattern[])
+{
+    uint8_t marked[LCD_GLYPH_ROWS];
+    uint8_t row;
+
+    for (row = 0u; row < LCD_GLYPH_ROWS; row++)
+    {
+        marked[row] = (uint8_t) ((pattern[row] & (uint8_t) ~LCD_WARM_SIGNATURE_MASK) |
+                                 LCD_warmSignature[row]);
+    }
+
+    LCD_WriteBuffer(marked, LCD_GLYPH_ROWS);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WarmBits
+********************************************************************************
+*
+* Summary:
+*  Returns the signature bits a CGRAM byte carries, for code that rewrites
+*  single CGRAM bytes.
+*
+* Parameters:
+*  address: CGRAM address, 0x00-0x3F
+*
+* Return:
+*  Bits 7-5 for a row of the signature slot, 0 for any other address.
+*
+*******************************************************************************/
+uint8_t LCD_WarmBits(uint8_t address)
+{
+    uint8_t const row = (uint8_t) (address - LCD_WARM_ADDRESS);
+
+    return (row < LCD_GLYPH_ROWS) ? LCD_warmSignature[row] : 0u;
+}
+
+#endif /* LCD_USE_WARM_START != 0u */
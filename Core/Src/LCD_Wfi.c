@@ -0,0 +1,258 @@
+/*
+ *  LCD_Wfi.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Low-power waits for the HD44780 LCD driver.
+ *
+ *  			Waits of at least LCD_WFI_MIN_US (clear/home execution time in
+ *  			timed mode, long LCD_DelayUs() on the DWT backend, the power-on
+ *  			and handshake steps of LCD_Init()) arm TIM4 compare channel 2
+ *  			and sleep in __WFI() until it fires, LCD_WFI_WAKE_US before the
+ *  			deadline. The rest is spun on the DWT cycle counter, so the
+ *  			wait is exactly as long as the spin it replaces. Short waits
+ *  			and the ns-scale E-strobe gaps are always spun.
+ *
+ *  Usage:      - call LCD_WfiIRQHandler() from TIM4_IRQHandler
+ *  			- TIM4 must be free running (MX_TIM4_Init and
+ *  				HAL_TIM_Base_Start in main.c), channel 1 stays free for
+ *  				LCD_Async.c
+ *  			- waits made from an interrupt, or with PRIMASK/BASEPRI
+ *  				set, are spun like before
+ *  			- with LCD_USE_RTOS the display service task blocks on a
+ *  				thread flag instead of __WFI(), the other tasks run
+ *
+ */
+#include "main.h"
+#include "stm32f1xx_ll_tim.h"
+#include "LCD.h"
+#include "LCD_Rtos.h"
+#include "LCD_Timing.h"
+#include "LCD_Wfi.h"
+
+#if (LCD_USE_WFI != 0u)
+
+/* Set by the compare interrupt, cleared when a sleep is armed */
+static volatile uint8_t LCD_wfiWoken = 0u;
+
+static uint8_t LCD_WfiAllowed(void) ;
+static void LCD_WfiSleepTicks(uint32_t ticks) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_WfiStart
+********************************************************************************
+*
+* Summary:
+*  Enables the TIM4 interrupt used to end the sleeps (keeps the priority
+*  LCD_AsyncStart() gave it, if it already ran).
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WfiStart(void)
+{
+    LL_TIM_DisableIT_CC2(TIM4);
+    LL_TIM_ClearFlag_CC2(TIM4);
+
+    if (NVIC_GetEnableIRQ(TIM4_IRQn) == 0u)
+    {
+        HAL_NVIC_SetPriority(TIM4_IRQn, LCD_WFI_IRQ_PRIORITY, 0u);
+        HAL_NVIC_EnableIRQ(TIM4_IRQn);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WfiWaitCycles
+********************************************************************************
+*
+* Summary:
+*  Waits for "cycles" core cycles, sleeping for the bulk of waits of at least
+*  LCD_WFI_MIN_US.
+*
+* Parameters:
+*  cycles: Wait in core cycles
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WfiWaitCycles(uint32_t cycles)
+{
+    uint32_t const start = LCD_CYCLES();
+    uint32_t const wake = LCD_WFI_WAKE_US * LCD_cyclesPerUs;
+
+    if ((cycles >= (LCD_WFI_MIN_US * LCD_cyclesPerUs)) && (LCD_WfiAllowed() != 0u))
+    {
+        uint32_t elapsed = 0u;
+
+        while ((cycles - elapsed) > wake)
+        {
+            uint32_t ticks = ((cycles - elapsed - wake) / LCD_cyclesPerUs) * LCD_WFI_TICKS_PER_US;
+
+            if (ticks == 0u)
+            {
+                break;
+            }
+            LCD_WfiSleepTicks((ticks > LCD_WFI_MAX_TICKS) ? LCD_WFI_MAX_TICKS : ticks);
+
+            elapsed = (uint32_t) (LCD_CYCLES() - start);
+            if (elapsed >= cycles)
+            {
+                break;
+            }
+        }
+    }
+
+    /* Remainder, and every short wait */
+    while ((uint32_t) (LCD_CYCLES() - start) < cycles)
+    {
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WfiWaitPoll
+********************************************************************************
+*
+* Summary:
+*  Wait between two LCD_InitPoll() calls of LCD_Init(): sleeps out the command
+*  still executing, or until the next interrupt (SysTick at the latest) for
+*  the millisecond steps.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WfiWaitPoll(void)
+{
+    uint32_t remaining = LCD_TimingRemaining();
+
+    if (remaining != 0u)
+    {
+        LCD_WfiWaitCycles(remaining);
+    }
+    else if (LCD_WfiAllowed() != 0u)
+    {
+        /* The steps are 1 ms tick deadlines, one tick of sleep is the resolution */
+        #if (LCD_USE_RTOS != 0u)
+            if (LCD_RtosIsService() != 0u)
+            {
+                LCD_RtosYield();
+                return;
+            }
+        #endif /* LCD_USE_RTOS != 0u */
+        __WFI();
+    }
+    else
+    {
+        /* Spin, the caller polls again */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WfiIRQHandler
+********************************************************************************
+*
+* Summary:
+*  TIM4 compare channel 2 interrupt: ends the current sleep.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WfiIRQHandler(void)
+{
+    if ((LL_TIM_IsEnabledIT_CC2(TIM4) == 0u) || (LL_TIM_IsActiveFlag_CC2(TIM4) == 0u))
+    {
+        return;
+    }
+
+    LL_TIM_DisableIT_CC2(TIM4);
+    LL_TIM_ClearFlag_CC2(TIM4);
+    LCD_wfiWoken = 1u;
+
+    #if (LCD_USE_RTOS != 0u)
+        LCD_RtosWake();
+    #endif /* LCD_USE_RTOS != 0u */
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WfiAllowed
+********************************************************************************
+*
+* Summary:
+*  Returns 1 if the compare interrupt can end a sleep: thread mode, interrupts
+*  not masked and TIM4 counting.
+*
+*******************************************************************************/
+static uint8_t LCD_WfiAllowed(void)
+{
+    return ((__get_IPSR() == 0u) && (__get_PRIMASK() == 0u) && (__get_BASEPRI() == 0u) &&
+            (LL_TIM_IsEnabledCounter(TIM4) != 0u)) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WfiSleepTicks
+********************************************************************************
+*
+* Summary:
+*  Sleeps until "ticks" TIM4 ticks from now. Interrupts are masked between
+*  the test of the wake flag and __WFI(), so a compare that fires in between
+*  still ends the sleep (a pending interrupt wakes __WFI() while masked). The
+*  RTOS service task waits for the thread flag instead, which is kept when
+*  set before the wait.
+*
+*******************************************************************************/
+static void LCD_WfiSleepTicks(uint32_t ticks)
+{
+    #if (LCD_USE_RTOS != 0u)
+        if (LCD_RtosIsService() != 0u)
+        {
+            /* The service task blocks, the scheduler gives the core to the other tasks */
+            LCD_wfiWoken = 0u;
+            LL_TIM_ClearFlag_CC2(TIM4);
+            LL_TIM_OC_SetCompareCH2(TIM4, (LL_TIM_GetCounter(TIM4) + ticks) & 0xFFFFu);
+            LL_TIM_EnableIT_CC2(TIM4);
+
+            while (LCD_wfiWoken == 0u)
+            {
+                LCD_RtosWaitWake();
+            }
+            return;
+        }
+    #endif /* LCD_USE_RTOS != 0u */
+
+    __disable_irq();
+    LCD_wfiWoken = 0u;
+    LL_TIM_ClearFlag_CC2(TIM4);
+    LL_TIM_OC_SetCompareCH2(TIM4, (LL_TIM_GetCounter(TIM4) + ticks) & 0xFFFFu);
+    LL_TIM_EnableIT_CC2(TIM4);
+
+    while (LCD_wfiWoken == 0u)
+    {
+        __WFI();
+
+        /* Let the pending interrupt (this compare or any other) run */
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+}
+
+#endif /* LCD_USE_WFI != 0u */
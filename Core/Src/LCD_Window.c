@@ -0,0 +1,403 @@
+/*
+ *  LCD_Window.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Virtual windows for the HD44780 LCD driver.
+ *
+ *  			Modules that share the screen (a status bar, process values,
+ *  			an alarm line) each open a window: a rectangle with its own
+ *  			cell buffer, cursor and z-order. They print into their window
+ *  			only, in window coordinates, and never position the display
+ *  			cursor. A character lands in the framebuffer at once when its
+ *  			window is the topmost visible one at that cell; under another
+ *  			window it only changes the window buffer. Opening, closing,
+ *  			hiding or restacking a window composites its rectangle again
+ *  			from the buffers, so the flush that follows sends just the
+ *  			cells whose composited value changed.
+ *
+ *  Usage:      - LCD_WindowOpen(&status, statusCells, 0, 0, 1, 16, 0) with
+ *  				statusCells[1 * 16], then LCD_WindowPosition() /
+ *  				LCD_WindowPrint() and the usual flush
+ *  			- a higher z is in front, windows with the same z stack in
+ *  				the order they were opened
+ *  			- cells no visible window covers are blank; the rest of the
+ *  				screen still works with LCD_Position()/LCD_PrintString()
+ *  			- needs LCD_USE_FRAMEBUFFER
+ *
+ */
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Frame.h"
+#include "LCD_Latency.h"
+#include "LCD_Window.h"
+
+#if (LCD_USE_WINDOWS != 0u)
+
+#if (LCD_USE_FRAMEBUFFER == 0u)
+    #error "LCD_USE_WINDOWS composites into the framebuffer (LCD_USE_FRAMEBUFFER)"
+#endif /* LCD_USE_FRAMEBUFFER == 0u */
+
+/* Open windows, NULL for a free entry */
+static LCD_WINDOW *LCD_windows[LCD_WINDOWS_MAX];
+
+static LCD_WINDOW const *LCD_WindowTop(uint8_t row, uint8_t column) ;
+static void LCD_WindowPaint(LCD_WINDOW const *window) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_WindowOpen
+********************************************************************************
+*
+* Summary:
+*  Opens a blank, visible window with its cursor at its top left cell.
+*
+* Parameters:
+*  window:  Window state, stays valid while open
+*  cells:   rows * columns bytes, the window contents
+*  row:     Screen row of the top left cell
+*  column:  Screen column of the top left cell
+*  rows:    Height
+*  columns: Width
+*  z:       Stacking order, higher is in front
+*
+* Return:
+*  1 if opened, 0 if LCD_WINDOWS_MAX windows are open or the size is 0.
+*
+*******************************************************************************/
+uint8_t LCD_WindowOpen(LCD_WINDOW *window, uint8_t cells[], uint8_t row, uint8_t column,
+                       uint8_t rows, uint8_t columns, uint8_t z)
+{
+    uint8_t index = 0u;
+    uint16_t cell;
+
+    if ((cells == NULL) || (rows == 0u) || (columns == 0u))
+    {
+        return 0u;
+    }
+
+    while ((index < LCD_WINDOWS_MAX) && (LCD_windows[index] != NULL))
+    {
+        index++;
+    }
+    if (index == LCD_WINDOWS_MAX)
+    {
+        return 0u;
+    }
+
+    window->cells = cells;
+    window->row = row;
+    window->column = column;
+    window->rows = rows;
+    window->columns = columns;
+    window->z = z;
+    window->visible = 1u;
+    window->cursorRow = 0u;
+    window->cursorColumn = 0u;
+
+    for (cell = 0u; cell < ((uint16_t) rows * columns); cell++)
+    {
+        cells[cell] = LCD_FRAME_BLANK;
+    }
+
+    LCD_windows[index] = window;
+    LCD_WindowPaint(window);
+
+    return 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WindowClose
+********************************************************************************
+*
+* Summary:
+*  Closes a window. The windows behind it show through, uncovered cells go
+*  blank.
+*
+* Parameters:
+*  window: Open window
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WindowClose(LCD_WINDOW *window)
+{
+    uint8_t index;
+
+    for (index = 0u; index < LCD_WINDOWS_MAX; index++)
+    {
+        if (LCD_windows[index] == window)
+        {
+            LCD_windows[index] = NULL;
+            LCD_WindowPaint(window);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WindowShow
+********************************************************************************
+*
+* Summary:
+*  Shows or hides a window. A hidden window keeps its contents and can
+*  still be printed into.
+*
+* Parameters:
+*  window:  Open window
+*  visible: 1 = show, 0 = hide
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WindowShow(LCD_WINDOW *window, uint8_t visible)
+{
+    window->visible = (visible != 0u) ? 1u : 0u;
+    LCD_WindowPaint(window);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WindowSetZ
+********************************************************************************
+*
+* Summary:
+*  Moves a window in the stacking order.
+*
+* Parameters:
+*  window: Open window
+*  z:      Stacking order, higher is in front
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WindowSetZ(LCD_WINDOW *window, uint8_t z)
+{
+    window->z = z;
+    LCD_WindowPaint(window);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WindowPosition
+********************************************************************************
+*
+* Summary:
+*  Moves the cursor of a window. No bus traffic is generated.
+*
+* Parameters:
+*  window: Open window
+*  row:    Row within the window
+*  column: Column within the window
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WindowPosition(LCD_WINDOW *window, uint8_t row, uint8_t column)
+{
+    if (row < window->rows)
+    {
+        window->cursorRow = row;
+        window->cursorColumn = column;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WindowPutChar
+********************************************************************************
+*
+* Summary:
+*  Stores a character at the cursor of a window and advances the cursor.
+*  It reaches the framebuffer when no visible window is in front of it.
+*
+* Parameters:
+*  window:    Open window
+*  character: Character code, '\n' moves to the start of the next row
+*
+* Return:
+*  None.
+*
+* Note:
+*  Text wraps and clips at the window edges the way LCD_FrameWriteChar()
+*  does at the screen edges.
+*
+*******************************************************************************/
+void LCD_WindowPutChar(LCD_WINDOW *window, char character)
+{
+    uint16_t row;
+    uint16_t column;
+
+    if (character == '\n')
+    {
+        /* Past the last row the rest of the text is clipped */
+        if (window->cursorRow < window->rows)
+        {
+            window->cursorRow++;
+        }
+        window->cursorColumn = 0u;
+        return;
+    }
+
+    if (window->cursorColumn >= window->columns)
+    {
+        if ((window->cursorRow + 1u) >= window->rows)
+        {
+            return;
+        }
+
+        window->cursorRow++;
+        window->cursorColumn = 0u;
+    }
+
+    if (window->cursorRow >= window->rows)
+    {
+        return;
+    }
+
+    window->cells[((uint16_t) window->cursorRow * window->columns) + window->cursorColumn] = (uint8_t) character;
+    row = (uint16_t) window->row + window->cursorRow;
+    column = (uint16_t) window->column + window->cursorColumn;
+    window->cursorColumn++;
+
+    if ((row < LCD_ROWS) && (column < LCD_COLUMNS) &&
+        (LCD_WindowTop((uint8_t) row, (uint8_t) column) == window) &&
+        (LCD_frame[row][column] != (uint8_t) character))
+    {
+        LCD_LATENCY_CHANGE(row, column, character);
+        LCD_frame[row][column] = (uint8_t) character;
+        LCD_frameDirty = 1u;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WindowPrint
+********************************************************************************
+*
+* Summary:
+*  LCD_WindowPutChar() for every character of a zero terminated string.
+*
+* Parameters:
+*  window: Open window
+*  string: Text
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WindowPrint(LCD_WINDOW *window, char const string[])
+{
+    size_t index = 0u;
+
+    while (string[index] != '\0')
+    {
+        LCD_WindowPutChar(window, string[index]);
+        index++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WindowClear
+********************************************************************************
+*
+* Summary:
+*  Blanks a window and homes its cursor.
+*
+* Parameters:
+*  window: Open window
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_WindowClear(LCD_WINDOW *window)
+{
+    uint16_t cell;
+
+    for (cell = 0u; cell < ((uint16_t) window->rows * window->columns); cell++)
+    {
+        window->cells[cell] = LCD_FRAME_BLANK;
+    }
+
+    window->cursorRow = 0u;
+    window->cursorColumn = 0u;
+    LCD_WindowPaint(window);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WindowTop
+********************************************************************************
+*
+* Summary:
+*  Returns the visible window in front at a screen cell, NULL if none covers
+*  it.
+*
+*******************************************************************************/
+static LCD_WINDOW const *LCD_WindowTop(uint8_t row, uint8_t column)
+{
+    LCD_WINDOW const *top = NULL;
+    LCD_WINDOW const *window;
+    uint8_t index;
+
+    for (index = 0u; index < LCD_WINDOWS_MAX; index++)
+    {
+        window = LCD_windows[index];
+        if ((window != NULL) && (window->visible != 0u) &&
+            (row >= window->row) && (row < ((uint16_t) window->row + window->rows)) &&
+            (column >= window->column) && (column < ((uint16_t) window->column + window->columns)) &&
+            ((top == NULL) || (window->z >= top->z)))
+        {
+            top = window;
+        }
+    }
+
+    return top;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_WindowPaint
+********************************************************************************
+*
+* Summary:
+*  Composites the screen cells of a window rectangle from the windows that
+*  cover them, after the window was opened, closed or restacked.
+*
+*******************************************************************************/
+static void LCD_WindowPaint(LCD_WINDOW const *window)
+{
+    LCD_WINDOW const *top;
+    uint16_t row;
+    uint16_t column;
+    uint8_t value;
+
+    for (row = window->row; (row < ((uint16_t) window->row + window->rows)) && (row < LCD_ROWS); row++)
+    {
+        for (column = window->column;
+             (column < ((uint16_t) window->column + window->columns)) && (column < LCD_COLUMNS);
+             column++)
+        {
+            top = LCD_WindowTop((uint8_t) row, (uint8_t) column);
+            value = (top == NULL) ? LCD_FRAME_BLANK :
+                    top->cells[((row - top->row) * top->columns) + (column - top->column)];
+
+            if (LCD_frame[row][column] != value)
+            {
+                LCD_LATENCY_CHANGE(row, column, value);
+                LCD_frame[row][column] = value;
+                LCD_frameDirty = 1u;
+            }
+        }
+    }
+}
+
+#endif /* LCD_USE_WINDOWS != 0u */
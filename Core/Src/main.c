@@ -22,6 +22,14 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "LCD.h"
+#include "LCD_Bench.h"
+#include "LCD_Backlight.h"
+#include "LCD_Refresh.h"
+#include "LCD_Poll.h"
+#include "LCD_Blob.h"
+#include "LCD_Field.h"
+#include "LCD_Keypad.h"
+#include "LCD_Boot.h"
 
 /* USER CODE END Includes */
 
@@ -44,6 +52,24 @@
 TIM_HandleTypeDef htim4;
 
 /* USER CODE BEGIN PV */
+#if (LCD_USE_BLOB != 0u)
+/* Splash screen, sent as is from flash */
+static LCD_BLOB_SEGMENT const splashSegments[] =
+{
+  LCD_BLOB_TEXT(0u, 0u, "HD44780 LCD"),
+  LCD_BLOB_TEXT(1u, 0u, "LL GPIO driver")
+};
+static LCD_BLOB const splash = LCD_BLOB_INIT(splashSegments);
+#endif /* LCD_USE_BLOB != 0u */
+
+#if (LCD_USE_FIELDS != 0u)
+/* Counter line, the right-justified value is diffed per digit */
+static LCD_FIELD counterFields[] =
+{
+  LCD_FIELD_LABEL_AT(1u, 0u, "Cnt "),
+  LCD_FIELD_INIT(1u, 4u, 11u, LCD_FIELD_U32, 0u, NULL)
+};
+#endif /* LCD_USE_FIELDS != 0u */
 
 /* USER CODE END PV */
 
@@ -53,6 +79,7 @@ static void MX_GPIO_Init(void);
 static void MX_TIM4_Init(void);
 /* USER CODE BEGIN PFP */
 void delay_us(uint16_t delay);
+void delay_clock_update(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -68,7 +95,7 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
-
+  LCD_BOOT_MARK(LCD_BOOT_MAIN);
   /* USER CODE END 1 */
 
   /* MCU Configuration--------------------------------------------------------*/
@@ -77,35 +104,66 @@ int main(void)
   HAL_Init();
 
   /* USER CODE BEGIN Init */
-
+  LCD_BOOT_MARK(LCD_BOOT_HAL_INIT);
   /* USER CODE END Init */
 
   /* Configure the system clock */
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
-
+  LCD_BOOT_MARK(LCD_BOOT_CLOCK);
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
   MX_TIM4_Init();
   /* USER CODE BEGIN 2 */
+  LCD_BOOT_MARK(LCD_BOOT_TIM4);
 
   HAL_TIM_Base_Start(&htim4);
 
+  /* LCD power-on wait and handshake run while the rest of bring-up continues */
+  LCD_InitBegin();
+  LCD_BOOT_MARK(LCD_BOOT_LCD_BEGIN);
+
+#if (LCD_USE_BACKLIGHT_PWM != 0u)
+  LCD_BacklightStart();
+  LCD_FadeBacklight(LCD_BACKLIGHT_MAX, 500u);
+#else
   LL_GPIO_SetOutputPin(Light_LCD_GPIO_Port, Light_LCD_Pin);
+#endif /* LCD_USE_BACKLIGHT_PWM != 0u */
 
   LCD_Start();
-  HAL_Delay(20);
+  LCD_BOOT_MARK(LCD_BOOT_LCD_START);
+#if (LCD_USE_KEYPAD != 0u)
+  LCD_KeypadStart();
+#endif /* LCD_USE_KEYPAD != 0u */
+#if (LCD_USE_BLOB != 0u)
+  LCD_PlayBlob(&splash);
+#else
   LCD_Position(0, 0);
   LCD_PrintString("HD44780 LCD");
   LCD_Position(1, 0);
   LCD_PrintString("LL GPIO driver");
+  LCD_FlushFrame();
+#endif /* LCD_USE_BLOB != 0u */
+
+#if (LCD_USE_BOOT_MARKERS != 0u)
+  /* Boot time breakdown on SWO (ITM port 0), the table stays in LCD_boot */
+  LCD_BootReport(LCD_BootItmPutChar);
+#endif /* LCD_USE_BOOT_MARKERS != 0u */
 
   HAL_Delay(5000);
 
+#ifdef LCD_BENCHMARK
+  /* Throughput suite, results on SWO (ITM port 0) */
+  LCD_BenchRun();
+#endif
+
   uint32_t count = 0;
+#if (LCD_USE_FIELDS != 0u)
+  LCD_FieldSetTable(counterFields, 2u);
+#endif /* LCD_USE_FIELDS != 0u */
 
   /* USER CODE END 2 */
 
@@ -114,14 +172,47 @@ int main(void)
   while (1)
   {
 	  LL_GPIO_TogglePin(LED1_GPIO_Port, LED1_Pin);
+#if (LCD_USE_KEYPAD != 0u)
+	  /* Last key pressed in the top right corner */
+	  for (uint8_t event; LCD_KeypadGetEvent(&event) != 0u; )
+	  {
+		  if ((event & LCD_KEYPAD_RELEASED) == 0u)
+		  {
+			  LCD_Position(0, 15);
+			  LCD_PutChar("123A456B789C*0#D"[LCD_KEYPAD_KEY(event)]);
+		  }
+	  }
+#endif /* LCD_USE_KEYPAD != 0u */
+#if (LCD_USE_FIELDS != 0u)
+	  /* Label once, then the digits that changed (usually the last one) */
+	  (void) LCD_FieldUpdate();
+	  (void) LCD_UpdateNumber(1u, count++);
+#else
 	  if(0 == count)
 	  {
 		  LCD_Position(1, 0);
-		  LCD_PrintString("Cnt            ");
+		  LCD_PrintString("Cnt ");
 	  }
+	  /* Right-justified field overwrites the rest of the splash line */
 	  LCD_Position(1, 4);
-	  LCD_PrintU32Number(count++);
+	  LCD_PrintU32Fixed(count++, 11u, ' ');
+#endif /* LCD_USE_FIELDS != 0u */
+#if (LCD_USE_REFRESH != 0u)
+	  /* Other producers may write meanwhile, flushes stay at LCD_REFRESH_HZ */
+	  for (uint32_t start = HAL_GetTick(); (HAL_GetTick() - start) < 500u; )
+	  {
+		  (void) LCD_RefreshTask();
+	  }
+#elif (LCD_USE_POLL != 0u)
+	  /* A few cells per iteration, each iteration stays within 50 us */
+	  for (uint32_t start = HAL_GetTick(); (HAL_GetTick() - start) < 500u; )
+	  {
+		  (void) LCD_Poll(50u);
+	  }
+#else
+	  LCD_FlushFrame();
 	  HAL_Delay(500);
+#endif /* LCD_USE_REFRESH != 0u */
 
     /* USER CODE END WHILE */
 
@@ -209,6 +300,8 @@ static void MX_TIM4_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN TIM4_Init 2 */
+  /* Prescaler for LCD_TIM4_TICK_HZ at the configured clock, not the 72 MHz one above */
+  delay_clock_update();
 
   /* USER CODE END TIM4_Init 2 */
 
@@ -267,20 +360,44 @@ static void MX_GPIO_Init(void)
   LL_GPIO_Init(Light_LCD_GPIO_Port, &GPIO_InitStruct);
 
 /* USER CODE BEGIN MX_GPIO_Init_2 */
+  LCD_BOOT_MARK(LCD_BOOT_GPIO);
 /* USER CODE END MX_GPIO_Init_2 */
 }
 
 /* USER CODE BEGIN 4 */
 void delay_us(uint16_t delay)
 {
+	uint16_t start = (uint16_t) __HAL_TIM_GetCounter(&htim4);
+	uint16_t ticks;
+	uint32_t const ticksPerUs = LCD_TIM4_TICK_HZ / 1000000u;
+
 	if(delay < 1)
-		delay = 0; /* yields minimum delay */
-	else if(delay > 0x10000 / 4) /* TIM4 is a 16-bit counter, argument will be multiplied by 4 later */
-		delay = 0x10000 - 1; /* maximum delay = 18/72 MHz * 16,384 = 4096 us */
+		ticks = 0; /* yields minimum delay */
+	else if(delay > 0x10000 / ticksPerUs) /* TIM4 is a 16-bit counter, argument will be multiplied later */
+		ticks = 0x10000 - 1; /* maximum delay = 65,535 ticks, 16,383 us at 4 MHz */
 	else
-		delay = (delay * 4) - 1; /* TIM4 configured for 4 MHz */
-	__HAL_TIM_SetCounter(&htim4, 0); /* reset counter to zero */
-	while(__HAL_TIM_GetCounter(&htim4) < delay); /* wait for delay */
+		ticks = (delay * ticksPerUs) - 1; /* TIM4 runs at LCD_TIM4_TICK_HZ (delay_clock_update) */
+
+	/* counter is free running (not reset) so TIM4 compare channels stay usable by LCD_Async.c */
+	while((uint16_t)(__HAL_TIM_GetCounter(&htim4) - start) < ticks); /* wait for delay */
+}
+
+/* Sets the TIM4 prescaler for LCD_TIM4_TICK_HZ from the current clock tree;
+ * call again (LCD_TimingClockUpdate) after SystemClock_Config changes it
+ */
+void delay_clock_update(void)
+{
+	uint32_t timerClock = HAL_RCC_GetPCLK1Freq();
+
+	/* APB1 timers run at twice PCLK1 whenever the APB1 prescaler is not 1 */
+	if(timerClock != HAL_RCC_GetHCLKFreq())
+		timerClock *= 2u;
+
+	/* rounded up: a clock that is not a multiple of the tick only lengthens the delays */
+	__HAL_TIM_SET_PRESCALER(&htim4, ((timerClock + LCD_TIM4_TICK_HZ - 1u) / LCD_TIM4_TICK_HZ) - 1u);
+
+	/* load the prescaler now instead of at the next overflow */
+	htim4.Instance->EGR = TIM_EGR_UG;
 }
 
 /* USER CODE END 4 */
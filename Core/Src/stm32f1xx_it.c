@@ -22,6 +22,18 @@
 #include "stm32f1xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "LCD.h"
+#include "LCD_Dma.h"
+#include "LCD_Async.h"
+#include "LCD_Wfi.h"
+#include "LCD_Backlight.h"
+#include "LCD_Keypad.h"
+#include "LCD_I2c.h"
+#include "LCD_Spi.h"
+#include "LCD_Remote.h"
+#include "LCD_Can.h"
+#include "LCD_Usb.h"
+#include "LCD_Profile.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -187,6 +199,12 @@ void SysTick_Handler(void)
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
   /* USER CODE BEGIN SysTick_IRQn 1 */
+#if (LCD_USE_BACKLIGHT_PWM != 0u)
+  LCD_BacklightTick();
+#endif /* LCD_USE_BACKLIGHT_PWM != 0u */
+#if (LCD_USE_KEYPAD != 0u)
+  LCD_KeypadTick();
+#endif /* LCD_USE_KEYPAD != 0u */
 
   /* USER CODE END SysTick_IRQn 1 */
 }
@@ -199,5 +217,105 @@ void SysTick_Handler(void)
 /******************************************************************************/
 
 /* USER CODE BEGIN 1 */
+#if (LCD_USE_DMA_TRANSPORT != 0u)
+/**
+  * @brief This function handles DMA1 channel2 global interrupt (LCD DMA transport).
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+  LCD_DmaIRQHandler();
+}
+#endif /* LCD_USE_DMA_TRANSPORT != 0u */
+
+#if (LCD_USE_SPI_TRANSPORT != 0u)
+/**
+  * @brief This function handles DMA1 channel5 global interrupt (LCD SPI transport).
+  */
+void DMA1_Channel5_IRQHandler(void)
+{
+  LCD_SpiIRQHandler();
+}
+#endif /* LCD_USE_SPI_TRANSPORT != 0u */
+
+#if (LCD_USE_I2C_TRANSPORT != 0u)
+/**
+  * @brief This function handles I2C1 event interrupt (LCD I2C transport).
+  */
+void I2C1_EV_IRQHandler(void)
+{
+  LCD_I2cEventIRQHandler();
+}
+
+/**
+  * @brief This function handles I2C1 error interrupt (LCD I2C transport).
+  */
+void I2C1_ER_IRQHandler(void)
+{
+  LCD_I2cErrorIRQHandler();
+}
+#endif /* LCD_USE_I2C_TRANSPORT != 0u */
+
+#if (LCD_USE_REMOTE != 0u) && (LCD_REMOTE_USART != 0u)
+/**
+  * @brief This function handles the USART interrupt of the remote display (idle line).
+  */
+#if (LCD_REMOTE_USART == 1u)
+void USART1_IRQHandler(void)
+#else
+void USART2_IRQHandler(void)
+#endif /* LCD_REMOTE_USART == 1u */
+{
+  LCD_RemoteIRQHandler();
+}
+#endif /* (LCD_USE_REMOTE != 0u) && (LCD_REMOTE_USART != 0u) */
+
+#if (LCD_USE_CAN != 0u) || (LCD_USE_USB_CDC != 0u)
+/**
+  * @brief This function handles USB low priority or CAN1 RX0 interrupts (CAN display
+  *        node fields, USB CDC remote display).
+  */
+void USB_LP_CAN1_RX0_IRQHandler(void)
+{
+#if (LCD_USE_CAN != 0u)
+  LCD_CanIRQHandler();
+#endif /* LCD_USE_CAN != 0u */
+#if (LCD_USE_USB_CDC != 0u)
+  LCD_UsbIRQHandler();
+#endif /* LCD_USE_USB_CDC != 0u */
+}
+#endif /* (LCD_USE_CAN != 0u) || (LCD_USE_USB_CDC != 0u) */
+
+#if (LCD_USE_ASYNC != 0u) || (LCD_USE_WFI != 0u)
+/**
+  * @brief This function handles TIM4 global interrupt (LCD write queue, low-power waits).
+  */
+void TIM4_IRQHandler(void)
+{
+#if (LCD_USE_ASYNC != 0u)
+  LCD_AsyncIRQHandler();
+#endif /* LCD_USE_ASYNC != 0u */
+#if (LCD_USE_WFI != 0u)
+  LCD_WfiIRQHandler();
+#endif /* LCD_USE_WFI != 0u */
+}
+#endif /* (LCD_USE_ASYNC != 0u) || (LCD_USE_WFI != 0u) */
+
+#if (LCD_USE_PROFILER != 0u)
+/**
+  * @brief This function handles TIM2 global interrupt (LCD profiler samples).
+  *        Naked, so the exception frame is passed on as the core stacked it.
+  */
+__attribute__((naked)) void TIM2_IRQHandler(void)
+{
+  __asm volatile
+  (
+    "tst   lr, #4                  \n"
+    "ite   eq                      \n"
+    "mrseq r0, msp                 \n"
+    "mrsne r0, psp                 \n"
+    "b     LCD_ProfileIRQHandler   \n"
+  );
+}
+#endif /* LCD_USE_PROFILER != 0u */
 
 /* USER CODE END 1 */
@@ -29,6 +29,8 @@
 #include <time.h>
 #include <sys/time.h>
 #include <sys/times.h>
+#include "main.h"
+#include "LCD_Stdout.h"
 
 
 /* Variables */
@@ -82,6 +84,14 @@ __attribute__((weak)) int _write(int file, char *ptr, int len)
   (void)file;
   int DataIdx;
 
+#if (LCD_USE_STDOUT != 0u)
+  /* stdout (1) and stderr (2) go to the LCD framebuffer, one flush per call */
+  if ((file == 1) || (file == 2))
+  {
+    return LCD_StdoutWrite(ptr, len);
+  }
+#endif /* LCD_USE_STDOUT != 0u */
+
   for (DataIdx = 0; DataIdx < len; DataIdx++)
   {
     __io_putchar(*ptr++);
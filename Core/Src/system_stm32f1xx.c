@@ -56,6 +56,7 @@
   */
 
 #include "stm32f1xx.h"
+#include "LCD_Boot.h"
 
 /**
   * @}
@@ -184,6 +185,11 @@ void SystemInit (void)
 #if defined(USER_VECT_TAB_ADDRESS)
   SCB->VTOR = VECT_TAB_BASE_ADDRESS | VECT_TAB_OFFSET; /* Vector Table Relocation in Internal SRAM. */
 #endif /* USER_VECT_TAB_ADDRESS */
+
+#if (LCD_USE_BOOT_MARKERS != 0u)
+  /* Boot markers count core cycles from here, before .data/.bss (LCD_Boot.c) */
+  LCD_BootReset();
+#endif /* LCD_USE_BOOT_MARKERS != 0u */
 }
 
 /**
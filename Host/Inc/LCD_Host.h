@@ -0,0 +1,121 @@
+/*
+ * LCD_Host.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Host-side HD44780 behavioral model and mock GPIO/timer layer.
+ *
+ *  Build:      from the repository root, with any C99 host compiler:
+ *
+ *  			gcc -std=c99 -O2 -Wall -IHost/Inc -ICore/Inc Host/Src/LCD_Host*.c \
+ *  			    Core/Src/LCD.c Core/Src/LCD_Timing.c Core/Src/LCD_Format.c \
+ *  			    Core/Src/LCD_Frame.c Core/Src/LCD_Glyph.c Core/Src/LCD_Bar.c \
+ *  			    Core/Src/LCD_Geometry.c \
+ *  			    -o lcd_host && ./lcd_host
+ *
+ *  			The exit status is non-zero when a timing violation or a
+ *  			display content mismatch was found, so the run can gate commits.
+ *
+ *  			With LCD_USE_TRACE set, add Core/Src/LCD_Trace.c; the run then
+ *  			also replays a recorded bus trace through the model.
+ */
+
+#ifndef HOST_LCD_HOST_H_
+#define HOST_LCD_HOST_H_
+
+#include "main.h"
+#include "LCD_Trace.h"
+#include "LCD_Timing.h"
+
+/***************************************
+*        Data Types
+***************************************/
+
+/* Bus activity since LCD_HostReset() */
+typedef struct
+{
+    uint64_t cycles;                /* Simulated core cycles */
+    uint32_t accesses;              /* GPIO register accesses (stores and input reads) */
+    uint32_t strobes;               /* E pulses */
+    uint32_t commands;              /* Instruction bytes latched */
+    uint32_t dataBytes;             /* Data bytes latched (DDRAM and CGRAM) */
+    uint32_t reads;                 /* Bytes read (busy flag/address or data) */
+    uint32_t busyReads;             /* Busy flag reads that returned busy */
+    uint32_t violations;            /* Timing or protocol violations */
+} LCD_HOST_COUNTS;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+/* Model */
+void LCD_HostReset(void) ;
+void LCD_HostGetCounts(LCD_HOST_COUNTS *counts) ;
+uint32_t LCD_HostViolationCount(uint8_t kind) ;
+char const *LCD_HostViolationName(uint8_t kind) ;
+uint8_t LCD_HostDdram(uint8_t address) ;
+uint8_t LCD_HostCgram(uint8_t address) ;
+void LCD_HostVisibleRow(uint8_t row, char text[], uint8_t columns) ;
+uint8_t LCD_HostIsFourBit(void) ;
+uint8_t LCD_HostLines(void) ;
+uint8_t LCD_HostDisplayOn(void) ;
+uint32_t LCD_HostReplay(LCD_TRACE_ENTRY const trace[], uint16_t count) ;
+
+/* Mock GPIO/timer layer (LCD_HostGpio.c) */
+void LCD_HostGpioReset(void) ;
+void LCD_HostAdvance(uint32_t cycles) ;
+uint64_t LCD_HostNow(void) ;
+uint32_t LCD_HostAccesses(void) ;
+
+/* Model hooks called by the mock ports */
+void LCD_HostPinsChanged(void) ;
+uint32_t LCD_HostDriveInput(GPIO_TypeDef const *port, uint32_t idr) ;
+
+/***************************************
+*           API Constants
+***************************************/
+
+/* Simulated core clock and cost of the modeled operations, in cycles: a
+ * GPIO access (store or input read through the bus matrix) and one cycle
+ * counter or SysTick read inside a wait loop. Code between accesses is free.
+ */
+#define LCD_HOST_CORE_HZ             (72000000u)
+#define LCD_HOST_ACCESS_CYCLES       (3u)
+#define LCD_HOST_POLL_CYCLES         (4u)
+
+/* Bus timing, ns: the controller of LCD_TIMING_PROFILE, holds and data setup
+ * of the HD44780 data sheet (VCC = 5 V)
+ */
+#define LCD_HOST_T_AS_NS             (LCD_T_AS_NS)  /* RS, R/W setup to E rise */
+#define LCD_HOST_T_AH_NS             (10u)          /* RS, R/W hold after E fall */
+#define LCD_HOST_T_PWEH_NS           (LCD_T_PWEH_NS) /* E high pulse width */
+#define LCD_HOST_T_CYCE_NS           (LCD_T_CYCE_NS) /* E cycle time */
+#define LCD_HOST_T_DSW_NS            (80u)          /* Data setup to E fall */
+#define LCD_HOST_T_H_NS              (10u)          /* Data hold after E fall */
+#define LCD_HOST_T_DDR_NS            (LCD_T_DDR_NS) /* E rise to read data valid */
+
+/* Execution times, ns */
+#define LCD_HOST_POWER_ON_NS         (15000000u)    /* Internal reset after VCC */
+#define LCD_HOST_EXEC_INIT1_NS       (4100000u)     /* First 8-bit function set */
+#define LCD_HOST_EXEC_INIT2_NS       (100000u)      /* Second 8-bit function set */
+#define LCD_HOST_EXEC_SHORT_NS       (37000u)
+#define LCD_HOST_EXEC_LONG_NS        (1520000u)     /* Clear display, return home */
+
+/* Violation kinds (LCD_HostViolationCount) */
+#define LCD_HOST_V_SETUP             (0u)           /* RS/RW changed less than tAS before E rise */
+#define LCD_HOST_V_HOLD              (1u)           /* RS/RW/data changed while E high or within the hold time */
+#define LCD_HOST_V_PULSE             (2u)           /* E high shorter than PWEH */
+#define LCD_HOST_V_CYCLE             (3u)           /* E rises closer than tcycE */
+#define LCD_HOST_V_DATA_SETUP        (4u)           /* Data changed less than tDSW before E fall */
+#define LCD_HOST_V_READ_EARLY        (5u)           /* Input read before tDDR */
+#define LCD_HOST_V_BUSY              (6u)           /* Write while the controller executes */
+#define LCD_HOST_V_POWER_ON          (7u)           /* Write during the internal reset */
+#define LCD_HOST_V_DIRECTION         (8u)           /* Data pins output during a read, or input during a write */
+#define LCD_HOST_V_NIBBLE            (9u)           /* R/W or RS changed between the nibbles of a byte */
+#define LCD_HOST_V_KINDS             (10u)
+
+/* Violations printed with their timestamp, the rest is only counted */
+#define LCD_HOST_REPORT_MAX          (16u)
+
+#endif /* HOST_LCD_HOST_H_ */
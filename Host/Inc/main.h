@@ -0,0 +1,162 @@
+/*
+ * main.h
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Host build replacement of Core/Inc/main.h.
+ *
+ *  			Host/Inc is searched before Core/Inc, so the driver sources
+ *  			compile unchanged against a mock of the few LL GPIO, DWT and
+ *  			HAL services they use (LCD_HostGpio.c). Register stores go
+ *  			through WRITE_REG() into the mock ports, every access advances
+ *  			simulated time and pin changes are fed to the HD44780 model
+ *  			(LCD_HostModel.c). Pin assignment as in Core/Inc/main.h.
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+/***************************************
+*        Mock Peripherals
+***************************************/
+
+typedef struct
+{
+    volatile uint32_t CRL;
+    volatile uint32_t CRH;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t BRR;
+    volatile uint32_t LCKR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define LCD_HOST_PORTS               (3u)
+
+extern GPIO_TypeDef LCD_hostPorts[LCD_HOST_PORTS];
+extern CoreDebug_Type LCD_hostCoreDebug;
+extern uint32_t SystemCoreClock;
+
+#define GPIOA                        (&LCD_hostPorts[0])
+#define GPIOB                        (&LCD_hostPorts[1])
+#define GPIOC                        (&LCD_hostPorts[2])
+
+/* Every DWT access is a cycle counter read that costs simulated time */
+#define DWT                          (LCD_HostDwt())
+#define CoreDebug                    (&LCD_hostCoreDebug)
+
+#define CoreDebug_DEMCR_TRCENA_Msk   (0x01000000u)
+#define DWT_CTRL_CYCCNTENA_Msk       (0x00000001u)
+
+/* Interrupt masking of the atomic bus phases, one thread on the host */
+#define __NVIC_PRIO_BITS             (4u)
+#define __get_BASEPRI()              (0u)
+#define __set_BASEPRI(value)         ((void) (value))
+#define __set_BASEPRI_MAX(value)     ((void) (value))
+#define __DMB()                      ((void) 0)
+
+/* Stores are routed to the port model instead of plain memory */
+#define WRITE_REG(REG, VAL)          LCD_HostWriteReg(&(REG), (uint32_t) (VAL))
+
+/* LL GPIO encoding (stm32f1xx_ll_gpio.h): BSRR bit << 8 | CRL/CRH selector */
+#define GPIO_PIN_MASK_POS            (8u)
+
+#define LL_GPIO_PIN_0                ((0x0001u << GPIO_PIN_MASK_POS) | 0x00000001u)
+#define LL_GPIO_PIN_1                ((0x0002u << GPIO_PIN_MASK_POS) | 0x00000002u)
+#define LL_GPIO_PIN_2                ((0x0004u << GPIO_PIN_MASK_POS) | 0x00000004u)
+#define LL_GPIO_PIN_3                ((0x0008u << GPIO_PIN_MASK_POS) | 0x00000008u)
+#define LL_GPIO_PIN_4                ((0x0010u << GPIO_PIN_MASK_POS) | 0x00000010u)
+#define LL_GPIO_PIN_5                ((0x0020u << GPIO_PIN_MASK_POS) | 0x00000020u)
+#define LL_GPIO_PIN_6                ((0x0040u << GPIO_PIN_MASK_POS) | 0x00000040u)
+#define LL_GPIO_PIN_7                ((0x0080u << GPIO_PIN_MASK_POS) | 0x00000080u)
+#define LL_GPIO_PIN_8                ((0x0100u << GPIO_PIN_MASK_POS) | 0x04000001u)
+#define LL_GPIO_PIN_9                ((0x0200u << GPIO_PIN_MASK_POS) | 0x04000002u)
+#define LL_GPIO_PIN_10               ((0x0400u << GPIO_PIN_MASK_POS) | 0x04000004u)
+#define LL_GPIO_PIN_11               ((0x0800u << GPIO_PIN_MASK_POS) | 0x04000008u)
+#define LL_GPIO_PIN_12               ((0x1000u << GPIO_PIN_MASK_POS) | 0x04000010u)
+#define LL_GPIO_PIN_13               ((0x2000u << GPIO_PIN_MASK_POS) | 0x04000020u)
+#define LL_GPIO_PIN_14               ((0x4000u << GPIO_PIN_MASK_POS) | 0x04000040u)
+#define LL_GPIO_PIN_15               ((0x8000u << GPIO_PIN_MASK_POS) | 0x04000080u)
+
+/* CNF/MODE nibble values of the port configuration registers */
+#define LL_GPIO_MODE_ANALOG          (0x0u)
+#define LL_GPIO_MODE_FLOATING        (0x4u)
+#define LL_GPIO_MODE_INPUT           (0x8u)
+#define LL_GPIO_MODE_OUTPUT          (0x1u)
+#define LL_GPIO_MODE_ALTERNATE       (0x9u)
+#define LL_GPIO_SPEED_FREQ_LOW       (0x2u)
+#define LL_GPIO_SPEED_FREQ_MEDIUM    (0x1u)
+#define LL_GPIO_SPEED_FREQ_HIGH      (0x3u)
+#define LL_GPIO_OUTPUT_PUSHPULL      (0x0u)
+#define LL_GPIO_OUTPUT_OPENDRAIN     (0x4u)
+
+/***************************************
+*        Function Prototypes
+***************************************/
+
+void LCD_HostWriteReg(volatile uint32_t *reg, uint32_t value) ;
+DWT_Type *LCD_HostDwt(void) ;
+
+void LL_GPIO_SetPinMode(GPIO_TypeDef *GPIOx, uint32_t Pin, uint32_t Mode) ;
+void LL_GPIO_SetPinSpeed(GPIO_TypeDef *GPIOx, uint32_t PinMask, uint32_t Speed) ;
+void LL_GPIO_SetPinOutputType(GPIO_TypeDef *GPIOx, uint32_t PinMask, uint32_t OutputType) ;
+void LL_GPIO_SetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask) ;
+void LL_GPIO_ResetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask) ;
+void LL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint32_t PinMask) ;
+uint32_t LL_GPIO_ReadInputPort(GPIO_TypeDef *GPIOx) ;
+uint32_t LL_GPIO_ReadOutputPort(GPIO_TypeDef *GPIOx) ;
+
+uint32_t HAL_GetTick(void) ;
+void HAL_Delay(uint32_t Delay) ;
+void Error_Handler(void) ;
+uint32_t ITM_SendChar(uint32_t ch) ;
+extern void delay_us(uint16_t delay);
+extern void delay_clock_update(void);
+
+/***************************************
+*        Pin Assignment
+***************************************/
+
+#define DB4_Pin LL_GPIO_PIN_0
+#define DB4_GPIO_Port GPIOC
+#define DB5_Pin LL_GPIO_PIN_1
+#define DB5_GPIO_Port GPIOC
+#define DB6_Pin LL_GPIO_PIN_2
+#define DB6_GPIO_Port GPIOC
+#define DB7_Pin LL_GPIO_PIN_3
+#define DB7_GPIO_Port GPIOC
+#define LED1_Pin LL_GPIO_PIN_4
+#define LED1_GPIO_Port GPIOA
+#define Light_LCD_Pin LL_GPIO_PIN_0
+#define Light_LCD_GPIO_Port GPIOB
+#define RS_Pin LL_GPIO_PIN_8
+#define RS_GPIO_Port GPIOC
+#define RnW_Pin LL_GPIO_PIN_9
+#define RnW_GPIO_Port GPIOC
+#define E_Pin LL_GPIO_PIN_12
+#define E_GPIO_Port GPIOC
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAIN_H */
@@ -0,0 +1,465 @@
+/*
+ *  LCD_HostGpio.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Mock LL GPIO, DWT cycle counter and HAL tick for the host build.
+ *
+ *  			Simulated time only advances when the driver touches hardware:
+ *  			each port access costs LCD_HOST_ACCESS_CYCLES and each cycle
+ *  			counter or tick read LCD_HOST_POLL_CYCLES, so the DWT and
+ *  			SysTick wait loops of the driver terminate and their length is
+ *  			the simulated wait. delay_us()/HAL_Delay() jump ahead directly.
+ *
+ */
+#include <stdio.h>
+#include "main.h"
+#include "LCD_Host.h"
+
+GPIO_TypeDef LCD_hostPorts[LCD_HOST_PORTS];
+CoreDebug_Type LCD_hostCoreDebug;
+uint32_t SystemCoreClock = LCD_HOST_CORE_HZ;
+
+static uint64_t LCD_hostCycles = 0u;
+static uint32_t LCD_hostAccesses = 0u;
+static DWT_Type LCD_hostDwt;
+
+static void LCD_HostAccess(void) ;
+static void LCD_HostSetOdr(GPIO_TypeDef *port, uint32_t odr) ;
+static void LCD_HostConfigure(GPIO_TypeDef *port, uint32_t pin, uint32_t mask, uint32_t bits) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_HostGpioReset
+********************************************************************************
+*
+* Summary:
+*  Resets the ports (all pins floating inputs, ODR 0) and simulated time.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HostGpioReset(void)
+{
+    uint8_t index;
+
+    for (index = 0u; index < LCD_HOST_PORTS; index++)
+    {
+        LCD_hostPorts[index].CRL = 0x44444444u;
+        LCD_hostPorts[index].CRH = 0x44444444u;
+        LCD_hostPorts[index].IDR = 0u;
+        LCD_hostPorts[index].ODR = 0u;
+    }
+
+    LCD_hostCycles = 0u;
+    LCD_hostAccesses = 0u;
+    LCD_hostDwt.CTRL = 0u;
+    LCD_hostDwt.CYCCNT = 0u;
+    LCD_hostCoreDebug.DEMCR = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostAdvance
+********************************************************************************
+*
+* Summary:
+*  Moves simulated time forward.
+*
+* Parameters:
+*  cycles: Core cycles
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HostAdvance(uint32_t cycles)
+{
+    LCD_hostCycles += cycles;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostNow
+********************************************************************************
+*
+* Summary:
+*  Returns the simulated time.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Core cycles since LCD_HostGpioReset().
+*
+*******************************************************************************/
+uint64_t LCD_HostNow(void)
+{
+    return LCD_hostCycles;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostAccesses
+********************************************************************************
+*
+* Summary:
+*  Returns the number of GPIO register accesses.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Stores and input reads since LCD_HostGpioReset().
+*
+*******************************************************************************/
+uint32_t LCD_HostAccesses(void)
+{
+    return LCD_hostAccesses;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostWriteReg
+********************************************************************************
+*
+* Summary:
+*  WRITE_REG() of the host build. BSRR/BRR/ODR stores change the pins and are
+*  passed to the model, other registers are plain memory.
+*
+* Parameters:
+*  reg:   Register address
+*  value: Stored value
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HostWriteReg(volatile uint32_t *reg, uint32_t value)
+{
+    uint8_t index;
+
+    for (index = 0u; index < LCD_HOST_PORTS; index++)
+    {
+        GPIO_TypeDef *port = &LCD_hostPorts[index];
+
+        if (reg == &port->BSRR)
+        {
+            /* Set wins over reset for the same pin */
+            LCD_HostSetOdr(port, (port->ODR & ~(value >> 16u)) | (value & 0xFFFFu));
+            return;
+        }
+        if (reg == &port->BRR)
+        {
+            LCD_HostSetOdr(port, port->ODR & ~(value & 0xFFFFu));
+            return;
+        }
+        if (reg == &port->ODR)
+        {
+            LCD_HostSetOdr(port, value & 0xFFFFu);
+            return;
+        }
+    }
+
+    LCD_HostAccess();
+    *reg = value;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostDwt
+********************************************************************************
+*
+* Summary:
+*  DWT of the host build, updates CYCCNT from simulated time on every access.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  Pointer to the mock DWT.
+*
+*******************************************************************************/
+DWT_Type *LCD_HostDwt(void)
+{
+    LCD_hostCycles += LCD_HOST_POLL_CYCLES;
+    LCD_hostDwt.CYCCNT = (uint32_t) LCD_hostCycles;
+
+    return &LCD_hostDwt;
+}
+
+
+/*******************************************************************************
+* Function Name: LL_GPIO_SetPinMode
+********************************************************************************
+*
+* Summary:
+*  Mock of the LL function, one read-modify-write of CRL or CRH.
+*
+*******************************************************************************/
+void LL_GPIO_SetPinMode(GPIO_TypeDef *GPIOx, uint32_t Pin, uint32_t Mode)
+{
+    LCD_HostConfigure(GPIOx, Pin, 0xFu, Mode);
+}
+
+
+/*******************************************************************************
+* Function Name: LL_GPIO_SetPinSpeed
+********************************************************************************
+*
+* Summary:
+*  Mock of the LL function, MODE bits of output pins.
+*
+*******************************************************************************/
+void LL_GPIO_SetPinSpeed(GPIO_TypeDef *GPIOx, uint32_t PinMask, uint32_t Speed)
+{
+    LCD_HostConfigure(GPIOx, PinMask, 0x3u, Speed);
+}
+
+
+/*******************************************************************************
+* Function Name: LL_GPIO_SetPinOutputType
+********************************************************************************
+*
+* Summary:
+*  Mock of the LL function, CNF0 bit of output pins.
+*
+*******************************************************************************/
+void LL_GPIO_SetPinOutputType(GPIO_TypeDef *GPIOx, uint32_t PinMask, uint32_t OutputType)
+{
+    LCD_HostConfigure(GPIOx, PinMask, 0x4u, OutputType);
+}
+
+
+/*******************************************************************************
+* Function Name: LL_GPIO_SetOutputPin
+********************************************************************************
+*
+* Summary:
+*  Mock of the LL function, BSRR store.
+*
+*******************************************************************************/
+void LL_GPIO_SetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    LCD_HostWriteReg(&GPIOx->BSRR, (PinMask >> GPIO_PIN_MASK_POS) & 0xFFFFu);
+}
+
+
+/*******************************************************************************
+* Function Name: LL_GPIO_ResetOutputPin
+********************************************************************************
+*
+* Summary:
+*  Mock of the LL function, BRR store.
+*
+*******************************************************************************/
+void LL_GPIO_ResetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    LCD_HostWriteReg(&GPIOx->BRR, (PinMask >> GPIO_PIN_MASK_POS) & 0xFFFFu);
+}
+
+
+/*******************************************************************************
+* Function Name: LL_GPIO_TogglePin
+********************************************************************************
+*
+* Summary:
+*  Mock of the LL function, ODR read-modify-write.
+*
+*******************************************************************************/
+void LL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    LCD_HostWriteReg(&GPIOx->ODR, GPIOx->ODR ^ ((PinMask >> GPIO_PIN_MASK_POS) & 0xFFFFu));
+}
+
+
+/*******************************************************************************
+* Function Name: LL_GPIO_ReadInputPort
+********************************************************************************
+*
+* Summary:
+*  Mock of the LL function. Output pins read back ODR, inputs read what the
+*  model drives (0 when nothing drives them).
+*
+*******************************************************************************/
+uint32_t LL_GPIO_ReadInputPort(GPIO_TypeDef *GPIOx)
+{
+    LCD_HostAccess();
+    GPIOx->IDR = LCD_HostDriveInput(GPIOx, GPIOx->ODR);
+
+    return GPIOx->IDR;
+}
+
+
+/*******************************************************************************
+* Function Name: LL_GPIO_ReadOutputPort
+********************************************************************************
+*
+* Summary:
+*  Mock of the LL function.
+*
+*******************************************************************************/
+uint32_t LL_GPIO_ReadOutputPort(GPIO_TypeDef *GPIOx)
+{
+    LCD_HostAccess();
+
+    return GPIOx->ODR;
+}
+
+
+/*******************************************************************************
+* Function Name: HAL_GetTick
+********************************************************************************
+*
+* Summary:
+*  Millisecond tick from simulated time.
+*
+*******************************************************************************/
+uint32_t HAL_GetTick(void)
+{
+    LCD_hostCycles += LCD_HOST_POLL_CYCLES;
+
+    return (uint32_t) (LCD_hostCycles / (SystemCoreClock / 1000u));
+}
+
+
+/*******************************************************************************
+* Function Name: HAL_Delay
+********************************************************************************
+*
+* Summary:
+*  Advances simulated time by "Delay" + 1 ms (HAL semantics).
+*
+*******************************************************************************/
+void HAL_Delay(uint32_t Delay)
+{
+    LCD_hostCycles += (uint64_t) (Delay + 1u) * (SystemCoreClock / 1000u);
+}
+
+
+/*******************************************************************************
+* Function Name: delay_us
+********************************************************************************
+*
+* Summary:
+*  TIM4 delay of main.c, advances simulated time.
+*
+*******************************************************************************/
+void delay_us(uint16_t delay)
+{
+    LCD_hostCycles += (uint64_t) delay * (SystemCoreClock / 1000000u);
+}
+
+
+/*******************************************************************************
+* Function Name: delay_clock_update
+********************************************************************************
+*
+* Summary:
+*  TIM4 prescaler update of main.c, nothing to reprogram on the host.
+*
+*******************************************************************************/
+void delay_clock_update(void)
+{
+}
+
+
+/*******************************************************************************
+* Function Name: Error_Handler
+********************************************************************************
+*
+* Summary:
+*  Not reached by the driver.
+*
+*******************************************************************************/
+void Error_Handler(void)
+{
+}
+
+
+/*******************************************************************************
+* Function Name: ITM_SendChar
+********************************************************************************
+*
+* Summary:
+*  SWO output of the target (ITM port 0), goes to stdout.
+*
+*******************************************************************************/
+uint32_t ITM_SendChar(uint32_t ch)
+{
+    (void) putchar((int) ch);
+
+    return ch;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostAccess
+********************************************************************************
+*
+* Summary:
+*  Accounts for one GPIO register access.
+*
+*******************************************************************************/
+static void LCD_HostAccess(void)
+{
+    LCD_hostCycles += LCD_HOST_ACCESS_CYCLES;
+    LCD_hostAccesses++;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostSetOdr
+********************************************************************************
+*
+* Summary:
+*  Stores the output data register and reports the pin change to the model.
+*
+*******************************************************************************/
+static void LCD_HostSetOdr(GPIO_TypeDef *port, uint32_t odr)
+{
+    LCD_HostAccess();
+
+    if (port->ODR != odr)
+    {
+        port->ODR = odr;
+        LCD_HostPinsChanged();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostConfigure
+********************************************************************************
+*
+* Summary:
+*  Replaces the "mask" bits of the CNF/MODE nibble of every pin in "pin"
+*  (LL_GPIO_PIN_x encoding or BSRR-style mask above bit 8).
+*
+*******************************************************************************/
+static void LCD_HostConfigure(GPIO_TypeDef *port, uint32_t pin, uint32_t mask, uint32_t bits)
+{
+    uint32_t pins = (pin >> GPIO_PIN_MASK_POS) & 0xFFFFu;
+    uint8_t number;
+
+    LCD_HostAccess();
+
+    for (number = 0u; number < 16u; number++)
+    {
+        if ((pins & (1u << number)) != 0u)
+        {
+            volatile uint32_t *config = (number < 8u) ? &port->CRL : &port->CRH;
+            uint32_t shift = (uint32_t) (number & 7u) * 4u;
+
+            *config = (*config & ~(mask << shift)) | ((bits & mask) << shift);
+        }
+    }
+
+    /* A direction change can start or end bus contention */
+    LCD_HostPinsChanged();
+}
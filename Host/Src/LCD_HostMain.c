@@ -0,0 +1,573 @@
+/*
+ *  LCD_HostMain.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Off-target throughput and transaction-count regression run of
+ *  			the HD44780 LCD driver against the host model.
+ *
+ *  			Initializes the modeled module with LCD_Start(), then runs the
+ *  			same suite as LCD_Bench.c (single char, full line, full frame
+ *  			flush, numeric counter, idle flush, clear, CGRAM upload) under
+ *  			busy polling, elapsed-skip and calibrated timed writes. Each
+ *  			case prints its simulated time and bus activity and checks
+ *  			what the model shows afterwards.
+ *
+ *  Usage:      build command in LCD_Host.h; exit status 0 = no timing
+ *  			violation and every check passed
+ *
+ */
+#include <stdio.h>
+#include <string.h>
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Timing.h"
+#include "LCD_Format.h"
+#include "LCD_Frame.h"
+#include "LCD_Geometry.h"
+#include "LCD_Dma.h"
+#include "LCD_Handle.h"
+#include "LCD_Trace.h"
+#include "LCD_Host.h"
+
+#define LCD_HOST_MODES               (3u)
+#define LCD_HOST_MODE_POLL           (0u)
+#define LCD_HOST_MODE_ELAPSED        (1u)
+#define LCD_HOST_MODE_CALIBRATED     (2u)
+
+#define LCD_HOST_CGRAM_BYTES         (8u * LCD_GLYPH_ROWS)
+#define LCD_HOST_COUNTER_DIGITS      (10u)
+#define LCD_HOST_COUNTER_VALUE       (1234560u)
+#define LCD_HOST_SETTLE_US           (2000u)
+
+typedef struct
+{
+    char const *name;
+    void (*setup)(uint8_t mode);
+    void (*run)(uint8_t mode);
+    uint8_t (*check)(uint8_t mode, LCD_HOST_COUNTS const *delta);
+} LCD_HOST_CASE;
+
+static char const *const LCD_hostModeNames[LCD_HOST_MODES] = { "poll", "elapsed", "calibrated" };
+
+static uint8_t LCD_hostText[LCD_HOST_CGRAM_BYTES > LCD_COLUMNS ? LCD_HOST_CGRAM_BYTES : LCD_COLUMNS];
+static uint32_t LCD_hostFailures = 0u;
+
+static void LCD_HostBoardInit(void) ;
+static void LCD_HostSetupPosition(uint8_t mode) ;
+static void LCD_HostSetupFrame(uint8_t mode) ;
+static void LCD_HostSetupCounter(uint8_t mode) ;
+static void LCD_HostRunChar(uint8_t mode) ;
+static void LCD_HostRunLine(uint8_t mode) ;
+static void LCD_HostRunFlush(uint8_t mode) ;
+static void LCD_HostRunClear(uint8_t mode) ;
+static void LCD_HostRunCgram(uint8_t mode) ;
+static uint8_t LCD_HostCheckChar(uint8_t mode, LCD_HOST_COUNTS const *delta) ;
+static uint8_t LCD_HostCheckLine(uint8_t mode, LCD_HOST_COUNTS const *delta) ;
+static uint8_t LCD_HostCheckFrame(uint8_t mode, LCD_HOST_COUNTS const *delta) ;
+static uint8_t LCD_HostCheckCounter(uint8_t mode, LCD_HOST_COUNTS const *delta) ;
+static uint8_t LCD_HostCheckIdle(uint8_t mode, LCD_HOST_COUNTS const *delta) ;
+static uint8_t LCD_HostCheckClear(uint8_t mode, LCD_HOST_COUNTS const *delta) ;
+static uint8_t LCD_HostCheckCgram(uint8_t mode, LCD_HOST_COUNTS const *delta) ;
+static uint8_t LCD_HostRowIs(uint8_t row, uint8_t const text[], uint8_t length) ;
+static void LCD_HostMeasure(char const name[], char const mode[], void (*run)(uint8_t), uint8_t arg,
+                            LCD_HOST_COUNTS *delta) ;
+static void LCD_HostExpect(uint8_t passed, char const what[]) ;
+#if (LCD_USE_TRACE != 0u)
+    static void LCD_HostReplayTrace(void) ;
+#endif /* LCD_USE_TRACE != 0u */
+#if (LCD_USE_FRAMEBUFFER != 0u)
+    static void LCD_HostCheckSplit(void) ;
+#endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+static LCD_HOST_CASE const LCD_hostCases[] =
+{
+    { "char",    LCD_HostSetupPosition, LCD_HostRunChar,  LCD_HostCheckChar },
+    { "line",    NULL,                  LCD_HostRunLine,  LCD_HostCheckLine },
+    { "frame",   LCD_HostSetupFrame,    LCD_HostRunFlush, LCD_HostCheckFrame },
+    { "counter", LCD_HostSetupCounter,  LCD_HostRunFlush, LCD_HostCheckCounter },
+    { "idle",    NULL,                  LCD_HostRunFlush, LCD_HostCheckIdle },
+    { "clear",   NULL,                  LCD_HostRunClear, LCD_HostCheckClear },
+    { "cgram",   NULL,                  LCD_HostRunCgram, LCD_HostCheckCgram }
+};
+
+#define LCD_HOST_CASES               (sizeof(LCD_hostCases) / sizeof(LCD_hostCases[0]))
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*  Runs the suite and prints one line per case and mode.
+*
+* Return:
+*  0 if every check passed and no violation was recorded, 1 otherwise.
+*
+*******************************************************************************/
+int main(void)
+{
+    LCD_HOST_COUNTS delta;
+    uint8_t mode;
+    uint8_t test;
+    uint8_t kind;
+    uint8_t index;
+
+    for (index = 0u; index < sizeof(LCD_hostText); index++)
+    {
+        LCD_hostText[index] = (uint8_t) ('A' + (index % 26u));
+    }
+
+    (void) printf("HD44780 host model, %u x %u, %s bus, %u MHz\n", LCD_ROWS, LCD_COLUMNS,
+                  (LCD_BUS_8BIT != 0u) ? "8-bit" : "4-bit", LCD_HOST_CORE_HZ / 1000000u);
+    (void) printf("%-8s %-10s %12s %7s %6s %5s %5s %6s %6s %5s\n", "case", "mode", "sim us",
+                  "gpio", "E", "cmd", "data", "reads", "busy", "viol");
+
+    LCD_HostReset();
+    LCD_HostBoardInit();
+    LCD_HostMeasure("start", "-", (void (*)(uint8_t)) NULL, 0u, &delta);
+    LCD_HostExpect(LCD_HostIsFourBit() == (uint8_t) (LCD_BUS_8BIT == 0u), "interface width after init");
+    LCD_HostExpect(LCD_HostLines() == ((LCD_ROWS > 1u) ? 2u : 1u), "line count after init");
+    LCD_HostExpect(LCD_HostDisplayOn(), "display on after init");
+
+    for (mode = 0u; mode < LCD_HOST_MODES; mode++)
+    {
+        LCD_TimingInit();
+        LCD_SetTimedMode(0u);
+        LCD_SetElapsedSkip((mode == LCD_HOST_MODE_POLL) ? 0u : 1u);
+        if (mode == LCD_HOST_MODE_CALIBRATED)
+        {
+            LCD_HostExpect(LCD_Calibrate(), "calibration");
+        }
+
+        for (test = 0u; test < LCD_HOST_CASES; test++)
+        {
+            LCD_HOST_CASE const *entry = &LCD_hostCases[test];
+
+            if (entry->setup != NULL)
+            {
+                entry->setup(mode);
+            }
+            LCD_HostMeasure(entry->name, LCD_hostModeNames[mode], entry->run, mode, &delta);
+            LCD_HostExpect(entry->check(mode, &delta), entry->name);
+        }
+    }
+
+    #if (LCD_USE_TRACE != 0u)
+        LCD_HostReplayTrace();
+    #endif /* LCD_USE_TRACE != 0u */
+
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        LCD_HostCheckSplit();
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+    LCD_HostGetCounts(&delta);
+    for (kind = 0u; kind < LCD_HOST_V_KINDS; kind++)
+    {
+        if (LCD_HostViolationCount(kind) != 0u)
+        {
+            (void) printf("violations: %-28s %u\n", LCD_HostViolationName(kind),
+                          (unsigned int) LCD_HostViolationCount(kind));
+        }
+    }
+
+    (void) printf("%s: %u violations, %u failed checks\n",
+                  ((delta.violations == 0u) && (LCD_hostFailures == 0u)) ? "PASS" : "FAIL",
+                  (unsigned int) delta.violations, (unsigned int) LCD_hostFailures);
+
+    return ((delta.violations == 0u) && (LCD_hostFailures == 0u)) ? 0 : 1;
+}
+
+
+#if (LCD_USE_TRACE != 0u)
+/*******************************************************************************
+* Function Name: LCD_HostReplayTrace
+********************************************************************************
+*
+* Summary:
+*  Records a cursor move and a character (busy polling, so busy flag reads
+*  are in it)
+*  and feeds the trace back into the model, as a trace dumped by the target
+*  would be: the replay must be as clean as the live run. The recording
+*  starts on an idle bus and must not wrap the ring, so the replay starts on
+*  a byte boundary.
+*
+*******************************************************************************/
+static void LCD_HostReplayTrace(void)
+{
+    static LCD_TRACE_ENTRY trace[LCD_TRACE_SIZE];
+    uint16_t count;
+    uint16_t index;
+    uint32_t violations;
+
+    LCD_TimingInit();
+    LCD_SetTimedMode(0u);
+    LCD_SetElapsedSkip(0u);
+    LCD_HostAdvance(LCD_HOST_SETTLE_US * (LCD_HOST_CORE_HZ / 1000000u));
+
+    LCD_TraceClear();
+    LCD_TraceStart();
+    LCD_HostSetupPosition(LCD_HOST_MODE_POLL);
+    LCD_HostRunChar(LCD_HOST_MODE_POLL);
+    LCD_TraceStop();
+
+    count = LCD_TraceCount();
+    for (index = 0u; index < count; index++)
+    {
+        trace[index] = *LCD_TraceEntry(index);
+    }
+
+    LCD_HostAdvance(LCD_HOST_SETTLE_US * (LCD_HOST_CORE_HZ / 1000000u));
+    violations = LCD_HostReplay(trace, count);
+    (void) printf("%-8s %-10s %12u entries, %u violations\n", "replay", "trace", (unsigned int) count,
+                  (unsigned int) violations);
+    LCD_HostExpect((count != 0u) && (count < LCD_TRACE_SIZE) && (violations == 0u), "trace replay");
+    LCD_TraceStart();
+}
+#endif /* LCD_USE_TRACE != 0u */
+
+
+#if (LCD_USE_FRAMEBUFFER != 0u)
+/*******************************************************************************
+* Function Name: LCD_HostCheckSplit
+********************************************************************************
+*
+* Summary:
+*  Flushes a 16x1 type 1 frame (two DDRAM runs in one row) in the patterns
+*  with the most runs: every cell changed, and every other cell changed from
+*  either end. The commands and data bytes of each flush are the items
+*  LCD_DmaFlushFrame() builds for it and must fit LCD_DMA_ROW_ITEMS().
+*
+*******************************************************************************/
+static void LCD_HostCheckSplit(void)
+{
+    LCD_GEOMETRY_STRUCT const *geometry = LCD_display0.geometry;
+    LCD_GEOMETRY_STRUCT const *split = &LCD_geometries[LCD_GEOMETRY_16X1];
+    LCD_HOST_COUNTS before;
+    LCD_HOST_COUNTS after;
+    uint32_t items;
+    uint32_t most = 0u;
+    uint8_t pattern;
+    uint8_t column;
+
+    LCD_HostExpect(LCD_SetGeometry(split), "split geometry");
+    LCD_FlushFrame();
+
+    for (pattern = 0u; pattern < 3u; pattern++)
+    {
+        for (column = 0u; column < split->columns; column++)
+        {
+            if ((pattern == 0u) || (((column + pattern) & 1u) != 0u))
+            {
+                LCD_Position(0u, column);
+                LCD_PutChar((char) ((LCD_frame[0][column] == (uint8_t) 'x') ? 'y' : 'x'));
+            }
+        }
+
+        LCD_HostGetCounts(&before);
+        LCD_FlushFrame();
+        LCD_HostGetCounts(&after);
+
+        items = (after.commands - before.commands) + (after.dataBytes - before.dataBytes);
+        most = (items > most) ? items : most;
+    }
+
+    (void) printf("%-8s %-10s %12u items, bound %u\n", "split", "16x1", (unsigned int) most,
+                  (unsigned int) LCD_DMA_ROW_ITEMS(split->columns));
+    LCD_HostExpect(most <= LCD_DMA_ROW_ITEMS(split->columns), "split row items");
+
+    (void) LCD_SetGeometry(geometry);
+    LCD_FlushFrame();
+}
+#endif /* LCD_USE_FRAMEBUFFER != 0u */
+
+
+/*******************************************************************************
+* Function Name: LCD_HostBoardInit
+********************************************************************************
+*
+* Summary:
+*  Pin configuration of MX_GPIO_Init() in main.c: LCD pins low, push-pull
+*  outputs.
+*
+*******************************************************************************/
+static void LCD_HostBoardInit(void)
+{
+    uint32_t const pins[] = { DB4_Pin, DB5_Pin, DB6_Pin, DB7_Pin, RS_Pin, RnW_Pin, E_Pin };
+    GPIO_TypeDef *const ports[] = { DB4_GPIO_Port, DB5_GPIO_Port, DB6_GPIO_Port, DB7_GPIO_Port,
+                                    RS_GPIO_Port, RnW_GPIO_Port, E_GPIO_Port };
+    uint8_t index;
+
+    for (index = 0u; index < (sizeof(pins) / sizeof(pins[0])); index++)
+    {
+        LL_GPIO_ResetOutputPin(ports[index], pins[index]);
+        LL_GPIO_SetPinMode(ports[index], pins[index], LL_GPIO_MODE_OUTPUT);
+        LL_GPIO_SetPinSpeed(ports[index], pins[index], LL_GPIO_SPEED_FREQ_LOW);
+        LL_GPIO_SetPinOutputType(ports[index], pins[index], LL_GPIO_OUTPUT_PUSHPULL);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostMeasure
+********************************************************************************
+*
+* Summary:
+*  Runs one case (LCD_Start() when "run" is NULL) on an idle module and prints
+*  the bus activity it caused.
+*
+*******************************************************************************/
+static void LCD_HostMeasure(char const name[], char const mode[], void (*run)(uint8_t), uint8_t arg,
+                            LCD_HOST_COUNTS *delta)
+{
+    LCD_HOST_COUNTS before;
+    LCD_HOST_COUNTS after;
+
+    /* Previous case finished executing, every case starts from an idle module */
+    LCD_HostAdvance(LCD_HOST_SETTLE_US * (LCD_HOST_CORE_HZ / 1000000u));
+
+    LCD_HostGetCounts(&before);
+    if (run == NULL)
+    {
+        LCD_Start();
+    }
+    else
+    {
+        run(arg);
+    }
+    LCD_HostGetCounts(&after);
+
+    delta->cycles = after.cycles - before.cycles;
+    delta->accesses = after.accesses - before.accesses;
+    delta->strobes = after.strobes - before.strobes;
+    delta->commands = after.commands - before.commands;
+    delta->dataBytes = after.dataBytes - before.dataBytes;
+    delta->reads = after.reads - before.reads;
+    delta->busyReads = after.busyReads - before.busyReads;
+    delta->violations = after.violations - before.violations;
+
+    (void) printf("%-8s %-10s %12.2f %7u %6u %5u %5u %6u %6u %5u\n", name, mode,
+                  (double) delta->cycles * 1000000.0 / (double) SystemCoreClock,
+                  (unsigned int) delta->accesses, (unsigned int) delta->strobes,
+                  (unsigned int) delta->commands, (unsigned int) delta->dataBytes,
+                  (unsigned int) delta->reads, (unsigned int) delta->busyReads,
+                  (unsigned int) delta->violations);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostExpect
+********************************************************************************
+*
+* Summary:
+*  Counts and prints a failed check.
+*
+*******************************************************************************/
+static void LCD_HostExpect(uint8_t passed, char const what[])
+{
+    if (passed == 0u)
+    {
+        LCD_hostFailures++;
+        (void) printf("  ! check failed: %s\n", what);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostRowIs
+********************************************************************************
+*
+* Summary:
+*  Returns 1 if the row shown by the model starts with "text".
+*
+*******************************************************************************/
+static uint8_t LCD_HostRowIs(uint8_t row, uint8_t const text[], uint8_t length)
+{
+    char visible[LCD_COLUMNS + 1u];
+
+    LCD_HostVisibleRow(row, visible, LCD_COLUMNS);
+
+    return (memcmp(visible, text, length) == 0) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostSetupPosition / LCD_HostSetupFrame / LCD_HostSetupCounter
+********************************************************************************
+*
+* Summary:
+*  Unmeasured preparation: cursor home; framebuffer filled with a pattern that
+*  differs per mode and marked unknown; counter field written and flushed
+*  once, then advanced so the measured flush only sends the changed digit.
+*
+*******************************************************************************/
+static void LCD_HostSetupPosition(uint8_t mode)
+{
+    (void) mode;
+    LCD_WritePosition(0u, 0u);
+}
+
+static void LCD_HostSetupFrame(uint8_t mode)
+{
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            LCD_Position(row, column);
+            LCD_PutChar((char) LCD_hostText[(column + row + mode) % LCD_COLUMNS]);
+        }
+    }
+
+    #if (LCD_USE_FRAMEBUFFER != 0u)
+        LCD_FrameInvalidate();
+    #endif /* LCD_USE_FRAMEBUFFER != 0u */
+}
+
+static void LCD_HostSetupCounter(uint8_t mode)
+{
+    LCD_Position(LCD_ROWS - 1u, 0u);
+    LCD_PrintU32Fixed(LCD_HOST_COUNTER_VALUE + mode, LCD_HOST_COUNTER_DIGITS, ' ');
+    LCD_FlushFrame();
+    LCD_Position(LCD_ROWS - 1u, 0u);
+    LCD_PrintU32Fixed(LCD_HOST_COUNTER_VALUE + mode + 1u, LCD_HOST_COUNTER_DIGITS, ' ');
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostRunChar / Line / Flush / Clear / Cgram
+********************************************************************************
+*
+* Summary:
+*  Measured operations.
+*
+*******************************************************************************/
+static void LCD_HostRunChar(uint8_t mode)
+{
+    LCD_WriteData((uint8_t) ('0' + mode));
+}
+
+static void LCD_HostRunLine(uint8_t mode)
+{
+    (void) mode;
+    LCD_WritePosition(0u, 0u);
+    LCD_WriteBuffer(LCD_hostText, LCD_COLUMNS);
+}
+
+static void LCD_HostRunFlush(uint8_t mode)
+{
+    (void) mode;
+    LCD_FlushFrame();
+}
+
+static void LCD_HostRunClear(uint8_t mode)
+{
+    (void) mode;
+    LCD_ClearDisplay();
+}
+
+static void LCD_HostRunCgram(uint8_t mode)
+{
+    (void) mode;
+    LCD_WriteControl(LCD_CGRAM_0);
+    LCD_WriteBuffer(LCD_hostText, LCD_HOST_CGRAM_BYTES);
+    LCD_WriteControl(LCD_DDRAM_0);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostCheckChar ... LCD_HostCheckCgram
+********************************************************************************
+*
+* Summary:
+*  Verify what the model shows after each case, and the bus activity where
+*  it is exact (one byte per character, nothing for an idle flush).
+*
+*******************************************************************************/
+static uint8_t LCD_HostCheckChar(uint8_t mode, LCD_HOST_COUNTS const *delta)
+{
+    return ((LCD_HostDdram(0u) == (uint8_t) ('0' + mode)) && (delta->dataBytes == 1u)) ? 1u : 0u;
+}
+
+static uint8_t LCD_HostCheckLine(uint8_t mode, LCD_HOST_COUNTS const *delta)
+{
+    (void) mode;
+    return ((LCD_HostRowIs(0u, LCD_hostText, LCD_COLUMNS) != 0u) &&
+            (delta->dataBytes == LCD_COLUMNS)) ? 1u : 0u;
+}
+
+static uint8_t LCD_HostCheckFrame(uint8_t mode, LCD_HOST_COUNTS const *delta)
+{
+    uint8_t expected[LCD_COLUMNS];
+    uint8_t passed = (delta->dataBytes == (LCD_ROWS * LCD_COLUMNS)) ? 1u : 0u;
+    uint8_t row;
+    uint8_t column;
+
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        for (column = 0u; column < LCD_COLUMNS; column++)
+        {
+            expected[column] = LCD_hostText[(column + row + mode) % LCD_COLUMNS];
+        }
+        passed &= LCD_HostRowIs(row, expected, LCD_COLUMNS);
+    }
+
+    return passed;
+}
+
+static uint8_t LCD_HostCheckCounter(uint8_t mode, LCD_HOST_COUNTS const *delta)
+{
+    char digits[LCD_U32_DIGITS];
+    uint8_t expected[LCD_HOST_COUNTER_DIGITS];
+    uint8_t count = LCD_FormatU32(digits, LCD_HOST_COUNTER_VALUE + mode + 1u);
+    uint8_t index;
+
+    (void) memset(expected, ' ', sizeof(expected));
+    (void) memcpy(&expected[LCD_HOST_COUNTER_DIGITS - count], &digits[LCD_U32_DIGITS - count], count);
+
+    /* Adjacent values differ in the last digit only */
+    index = LCD_HostRowIs(LCD_ROWS - 1u, expected, LCD_HOST_COUNTER_DIGITS);
+
+    return ((index != 0u) && (delta->dataBytes == 1u)) ? 1u : 0u;
+}
+
+static uint8_t LCD_HostCheckIdle(uint8_t mode, LCD_HOST_COUNTS const *delta)
+{
+    (void) mode;
+    return ((delta->strobes == 0u) && (delta->accesses == 0u)) ? 1u : 0u;
+}
+
+static uint8_t LCD_HostCheckClear(uint8_t mode, LCD_HOST_COUNTS const *delta)
+{
+    uint8_t blank[LCD_COLUMNS];
+    uint8_t passed = (delta->commands == 1u) ? 1u : 0u;
+    uint8_t row;
+
+    (void) mode;
+    (void) memset(blank, ' ', sizeof(blank));
+    for (row = 0u; row < LCD_ROWS; row++)
+    {
+        passed &= LCD_HostRowIs(row, blank, LCD_COLUMNS);
+    }
+
+    return passed;
+}
+
+static uint8_t LCD_HostCheckCgram(uint8_t mode, LCD_HOST_COUNTS const *delta)
+{
+    uint8_t index;
+
+    (void) mode;
+    for (index = 0u; index < LCD_HOST_CGRAM_BYTES; index++)
+    {
+        if (LCD_HostCgram(index) != LCD_hostText[index])
+        {
+            return 0u;
+        }
+    }
+
+    return (delta->dataBytes == LCD_HOST_CGRAM_BYTES) ? 1u : 0u;
+}
@@ -0,0 +1,991 @@
+/*
+ *  LCD_HostModel.c
+ *
+ *  Created on: Oct 14, 2026
+ *      Author: agent
+ *
+ * Description: Cycle-approximate HD44780 behavioral model for the host build.
+ *
+ *  			The model watches RS, R/W, E and DB0-DB7 of the mock ports
+ *  			(pin assignment of main.h and LCD.h) and behaves like the
+ *  			controller: instructions and data are latched on the falling
+ *  			edge of E, 4-bit transfers are reassembled from two nibbles,
+ *  			the busy flag and address counter (or DDRAM/CGRAM data) are
+ *  			driven onto the data pins while E is high in a read. DDRAM,
+ *  			CGRAM, entry mode, display shift and the 8-bit to 4-bit
+ *  			handshake are modeled; every instruction keeps the controller
+ *  			busy for its datasheet execution time.
+ *
+ *  			Each edge is checked against the bus timing of LCD_Host.h
+ *  			(setup, hold, pulse width, cycle time, data valid) and every
+ *  			write against the busy state; violations are counted by kind
+ *  			and the first LCD_HOST_REPORT_MAX are printed with their time.
+ *
+ */
+#include <stdio.h>
+#include <string.h>
+#include "main.h"
+#include "LCD.h"
+#include "LCD_Host.h"
+#include "LCD_Trace.h"
+
+/* Controller pins sampled from the mock ports */
+typedef struct
+{
+    uint8_t rs;
+    uint8_t rw;
+    uint8_t e;
+    uint8_t data;                   /* DB7-DB0 as driven by the MCU (DB0-DB3 0 on a 4-bit bus) */
+    uint8_t driven;                 /* 1 = every data pin is an output */
+    uint8_t released;               /* 1 = every data pin is an input */
+} LCD_HOST_PINS;
+
+typedef struct
+{
+    LCD_HOST_PINS pins;
+
+    /* Edge timestamps, core cycles */
+    uint64_t controlChanged;
+    uint64_t dataChanged;
+    uint64_t eRise;
+    uint64_t eFall;
+    uint8_t strobed;
+
+    /* Controller state */
+    uint64_t busyUntil;
+    uint8_t eightBit;
+    uint8_t lines;
+    uint8_t displayOn;
+    uint8_t increment;
+    uint8_t entryShift;
+    uint8_t cgramSelected;
+    uint8_t address;
+    uint8_t displayShift;
+    uint8_t initSets;
+    uint8_t ddram[0x80u];
+    uint8_t cgram[0x40u];
+
+    /* Transfer in progress: second nibble pending (4-bit), read value */
+    uint8_t phase;
+    uint8_t phaseRs;
+    uint8_t phaseRw;
+    uint8_t highNibble;
+    uint8_t readValue;
+
+    LCD_HOST_COUNTS counts;
+    uint32_t violations[LCD_HOST_V_KINDS];
+} LCD_HOST_MODEL;
+
+/* Positions of the controller pins on their ports */
+#define LCD_HOST_DB4_SHIFT           (LCD_STM32_NIBBLE_SHIFT)
+#define LCD_HOST_DB0_SHIFT           (LCD_STM32_LOW_NIBBLE_SHIFT)
+#define LCD_HOST_LINE_LENGTH(lines)  (((lines) == 2u) ? 0x28u : 0x50u)
+
+static LCD_HOST_MODEL LCD_host;
+
+static char const *const LCD_hostViolationNames[LCD_HOST_V_KINDS] =
+{
+    "RS/RW setup", "hold", "E pulse width", "E cycle time", "data setup",
+    "read before data valid", "write while busy", "write during power-on reset",
+    "data pin direction", "nibble pair mismatch"
+};
+
+static LCD_HOST_PINS LCD_HostSample(void) ;
+static uint8_t LCD_HostPinIsOutput(GPIO_TypeDef const *port, uint8_t number) ;
+static uint32_t LCD_HostOutputMask(GPIO_TypeDef const *port) ;
+static uint8_t LCD_HostBit(GPIO_TypeDef const *port, uint32_t pin) ;
+static void LCD_HostApplyTrace(uint16_t pins) ;
+static void LCD_HostRise(uint64_t now) ;
+static void LCD_HostFall(uint64_t now) ;
+static void LCD_HostExecute(uint8_t rs, uint8_t value, uint64_t now) ;
+static void LCD_HostInstruction(uint8_t value, uint64_t now) ;
+static uint8_t LCD_HostStep(uint8_t address, uint8_t up) ;
+static uint8_t LCD_HostReadByte(uint8_t rs, uint64_t now) ;
+static void LCD_HostViolation(uint8_t kind, uint64_t now) ;
+static uint64_t LCD_HostNsToCycles(uint32_t ns) ;
+static uint8_t LCD_HostWithin(uint64_t from, uint64_t now, uint32_t ns) ;
+
+
+/*******************************************************************************
+* Function Name: LCD_HostReset
+********************************************************************************
+*
+* Summary:
+*  Power-on reset of the model and the mock ports: simulated time 0, 8-bit
+*  interface, one line, display off, controller busy with the internal reset
+*  for LCD_HOST_POWER_ON_NS.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HostReset(void)
+{
+    LCD_HostGpioReset();
+
+    (void) memset(&LCD_host, 0, sizeof(LCD_host));
+    (void) memset(LCD_host.ddram, ' ', sizeof(LCD_host.ddram));
+
+    LCD_host.eightBit = 1u;
+    LCD_host.lines = 1u;
+    LCD_host.increment = 1u;
+    LCD_host.busyUntil = LCD_HostNsToCycles(LCD_HOST_POWER_ON_NS);
+    LCD_host.pins = LCD_HostSample();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostGetCounts
+********************************************************************************
+*
+* Summary:
+*  Copies the bus activity counters.
+*
+* Parameters:
+*  counts: Receives the counters
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HostGetCounts(LCD_HOST_COUNTS *counts)
+{
+    *counts = LCD_host.counts;
+    counts->cycles = LCD_HostNow();
+    counts->accesses = LCD_HostAccesses();
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostViolationCount
+********************************************************************************
+*
+* Summary:
+*  Returns the number of violations of one kind.
+*
+* Parameters:
+*  kind: LCD_HOST_V_ constant
+*
+* Return:
+*  Violations since LCD_HostReset().
+*
+*******************************************************************************/
+uint32_t LCD_HostViolationCount(uint8_t kind)
+{
+    return (kind < LCD_HOST_V_KINDS) ? LCD_host.violations[kind] : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostViolationName
+********************************************************************************
+*
+* Summary:
+*  Returns the description of a violation kind.
+*
+* Parameters:
+*  kind: LCD_HOST_V_ constant
+*
+* Return:
+*  Zero terminated string.
+*
+*******************************************************************************/
+char const *LCD_HostViolationName(uint8_t kind)
+{
+    return (kind < LCD_HOST_V_KINDS) ? LCD_hostViolationNames[kind] : "?";
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostDdram
+********************************************************************************
+*
+* Summary:
+*  Returns one DDRAM byte of the model.
+*
+* Parameters:
+*  address: DDRAM address (0x00 - 0x7F)
+*
+* Return:
+*  Character code.
+*
+*******************************************************************************/
+uint8_t LCD_HostDdram(uint8_t address)
+{
+    return LCD_host.ddram[address & 0x7Fu];
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostCgram
+********************************************************************************
+*
+* Summary:
+*  Returns one CGRAM byte of the model.
+*
+* Parameters:
+*  address: CGRAM address (0x00 - 0x3F)
+*
+* Return:
+*  Glyph row.
+*
+*******************************************************************************/
+uint8_t LCD_HostCgram(uint8_t address)
+{
+    return LCD_host.cgram[address & 0x3Fu];
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostVisibleRow
+********************************************************************************
+*
+* Summary:
+*  Returns the characters shown on one row, display shift applied.
+*
+* Parameters:
+*  row:     Display row
+*  text:    Receives "columns" character codes and a terminating zero
+*  columns: Visible columns of the module
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HostVisibleRow(uint8_t row, char text[], uint8_t columns)
+{
+    uint8_t length = LCD_HOST_LINE_LENGTH(LCD_host.lines);
+    uint8_t base = (LCD_host.lines == 2u) ? (uint8_t) ((row & 1u) * 0x40u) : 0u;
+    uint8_t column;
+
+    for (column = 0u; column < columns; column++)
+    {
+        uint8_t offset = (uint8_t) ((column + LCD_host.displayShift) % length);
+
+        text[column] = (char) LCD_host.ddram[base + offset];
+    }
+    text[columns] = '\0';
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostIsFourBit
+********************************************************************************
+*
+* Summary:
+*  Returns 1 once the controller was switched to the 4-bit interface.
+*
+*******************************************************************************/
+uint8_t LCD_HostIsFourBit(void)
+{
+    return (LCD_host.eightBit == 0u) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostLines
+********************************************************************************
+*
+* Summary:
+*  Returns the number of display lines selected by function set (1 or 2).
+*
+*******************************************************************************/
+uint8_t LCD_HostLines(void)
+{
+    return LCD_host.lines;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostDisplayOn
+********************************************************************************
+*
+* Summary:
+*  Returns 1 if display control has the display switched on.
+*
+*******************************************************************************/
+uint8_t LCD_HostDisplayOn(void)
+{
+    return LCD_host.displayOn;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostPinsChanged
+********************************************************************************
+*
+* Summary:
+*  Called by the mock ports after an output or direction change. Checks the
+*  change against the bus timing and processes E edges.
+*
+* Parameters:
+*  None.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+void LCD_HostPinsChanged(void)
+{
+    uint64_t now = LCD_HostNow();
+    LCD_HOST_PINS const previous = LCD_host.pins;
+    LCD_HOST_PINS const pins = LCD_HostSample();
+
+    if ((pins.rs != previous.rs) || (pins.rw != previous.rw))
+    {
+        if ((previous.e != 0u) ||
+            ((LCD_host.strobed != 0u) && (LCD_HostWithin(LCD_host.eFall, now, LCD_HOST_T_AH_NS) != 0u)))
+        {
+            LCD_HostViolation(LCD_HOST_V_HOLD, now);
+        }
+        LCD_host.controlChanged = now;
+    }
+
+    if ((pins.driven != 0u) && ((pins.data != previous.data) || (previous.driven == 0u)))
+    {
+        if ((previous.e != 0u) && (previous.rw == 0u))
+        {
+            LCD_HostViolation(LCD_HOST_V_HOLD, now);
+        }
+        else if ((pins.rw == 0u) && (LCD_host.strobed != 0u) &&
+                 (LCD_HostWithin(LCD_host.eFall, now, LCD_HOST_T_H_NS) != 0u))
+        {
+            LCD_HostViolation(LCD_HOST_V_HOLD, now);
+        }
+        else
+        {
+            /* Valid change */
+        }
+        LCD_host.dataChanged = now;
+    }
+
+    if ((previous.e != 0u) && (pins.e != 0u) && (pins.rw != 0u) && (pins.driven != 0u) && (previous.driven == 0u))
+    {
+        /* Data pins turned to outputs while the controller drives them */
+        LCD_HostViolation(LCD_HOST_V_DIRECTION, now);
+    }
+
+    LCD_host.pins = pins;
+
+    if ((pins.e != 0u) && (previous.e == 0u))
+    {
+        LCD_HostRise(now);
+    }
+    else if ((pins.e == 0u) && (previous.e != 0u))
+    {
+        LCD_HostFall(now);
+    }
+    else
+    {
+        /* No E edge */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostDriveInput
+********************************************************************************
+*
+* Summary:
+*  Input data register of a mock port: output pins read back ODR, data pins
+*  driven by the controller (R/W high, E high) read the nibble or byte being
+*  read, other inputs read 0.
+*
+* Parameters:
+*  port: Mock port
+*  idr:  Output data register of the port
+*
+* Return:
+*  Input data register value.
+*
+*******************************************************************************/
+uint32_t LCD_HostDriveInput(GPIO_TypeDef const *port, uint32_t idr)
+{
+    uint32_t value = idr & LCD_HostOutputMask(port);
+    uint64_t now = LCD_HostNow();
+
+    if ((port == DB4_GPIO_Port) && (LCD_host.pins.rw != 0u) && (LCD_host.pins.e != 0u))
+    {
+        uint32_t bus;
+
+        if (LCD_HostWithin(LCD_host.eRise, now, LCD_HOST_T_DDR_NS) != 0u)
+        {
+            LCD_HostViolation(LCD_HOST_V_READ_EARLY, now);
+        }
+
+        #if (LCD_BUS_8BIT != 0u)
+            bus = (((uint32_t) LCD_host.readValue >> 4u) << LCD_HOST_DB4_SHIFT) |
+                  (((uint32_t) LCD_host.readValue & 0x0Fu) << LCD_HOST_DB0_SHIFT);
+        #else
+            bus = (uint32_t) ((LCD_host.phase == 0u) ? (LCD_host.readValue >> 4u) :
+                                                      (LCD_host.readValue & 0x0Fu)) << LCD_HOST_DB4_SHIFT;
+        #endif /* LCD_BUS_8BIT != 0u */
+
+        value |= bus & LCD_STM32_BUS_MASK & ~LCD_HostOutputMask(port);
+    }
+
+    return value;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostReplay
+********************************************************************************
+*
+* Summary:
+*  Drives the mock ports from a bus trace recorded on the target (LCD_Trace.c)
+*  so the model checks it like a live run. The controller is taken as
+*  initialized, idle and at a byte boundary when the trace starts; recorded
+*  cycles are core cycles at SystemCoreClock.
+*
+* Parameters:
+*  trace: Entries, oldest first (LCD_TraceEntry order)
+*  count: Number of entries
+*
+* Return:
+*  Violations found in the trace.
+*
+*******************************************************************************/
+uint32_t LCD_HostReplay(LCD_TRACE_ENTRY const trace[], uint16_t count)
+{
+    uint32_t const before = LCD_host.counts.violations;
+    uint16_t index;
+
+    LCD_host.eightBit = (LCD_BUS_8BIT != 0u) ? 1u : 0u;
+    LCD_host.initSets = 3u;
+    LCD_host.phase = 0u;
+    LCD_host.busyUntil = LCD_HostNow();
+
+    for (index = 0u; index < count; index++)
+    {
+        if (index != 0u)
+        {
+            /* Modulo 2^32 like the dump, the trace may span counter wraps */
+            LCD_HostAdvance(trace[index].cycles - trace[index - 1u].cycles);
+        }
+
+        if ((trace[index].pins & LCD_TRACE_SAMPLE) != 0u)
+        {
+            /* Read of the data port: only the data valid check applies */
+            (void) LCD_HostDriveInput(DB4_GPIO_Port, DB4_GPIO_Port->ODR);
+        }
+        else
+        {
+            LCD_HostApplyTrace(trace[index].pins);
+            LCD_HostPinsChanged();
+        }
+    }
+
+    return LCD_host.counts.violations - before;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostSample
+********************************************************************************
+*
+* Summary:
+*  Reads the controller pins from the mock ports.
+*
+*******************************************************************************/
+static LCD_HOST_PINS LCD_HostSample(void)
+{
+    GPIO_TypeDef const *port = DB4_GPIO_Port;
+    LCD_HOST_PINS pins;
+    uint8_t outputs = 0u;
+    uint8_t count = 4u;
+    uint8_t index;
+
+    pins.rs = LCD_HostBit(RS_GPIO_Port, RS_Pin);
+    pins.rw = LCD_HostBit(RnW_GPIO_Port, RnW_Pin);
+    pins.e = LCD_HostBit(E_GPIO_Port, E_Pin);
+    pins.data = (uint8_t) (((port->ODR >> LCD_HOST_DB4_SHIFT) & 0x0Fu) << 4u);
+
+    for (index = 0u; index < 4u; index++)
+    {
+        outputs += LCD_HostPinIsOutput(port, (uint8_t) (LCD_HOST_DB4_SHIFT + index));
+    }
+
+    #if (LCD_BUS_8BIT != 0u)
+        pins.data |= (uint8_t) ((port->ODR >> LCD_HOST_DB0_SHIFT) & 0x0Fu);
+        for (index = 0u; index < 4u; index++)
+        {
+            outputs += LCD_HostPinIsOutput(port, (uint8_t) (LCD_HOST_DB0_SHIFT + index));
+        }
+        count = 8u;
+    #endif /* LCD_BUS_8BIT != 0u */
+
+    pins.driven = (outputs == count) ? 1u : 0u;
+    pins.released = (outputs == 0u) ? 1u : 0u;
+
+    return pins;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostPinIsOutput
+********************************************************************************
+*
+* Summary:
+*  Returns 1 if the MODE bits of the pin select an output.
+*
+*******************************************************************************/
+static uint8_t LCD_HostPinIsOutput(GPIO_TypeDef const *port, uint8_t number)
+{
+    uint32_t config = (number < 8u) ? port->CRL : port->CRH;
+
+    return (((config >> ((number & 7u) * 4u)) & 0x3u) != 0u) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostOutputMask
+********************************************************************************
+*
+* Summary:
+*  Returns the output pins of a port as a bit mask.
+*
+*******************************************************************************/
+static uint32_t LCD_HostOutputMask(GPIO_TypeDef const *port)
+{
+    uint32_t mask = 0u;
+    uint8_t number;
+
+    for (number = 0u; number < 16u; number++)
+    {
+        mask |= (uint32_t) LCD_HostPinIsOutput(port, number) << number;
+    }
+
+    return mask;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostBit
+********************************************************************************
+*
+* Summary:
+*  Returns the output level of one pin (LL_GPIO_PIN_x).
+*
+*******************************************************************************/
+static uint8_t LCD_HostBit(GPIO_TypeDef const *port, uint32_t pin)
+{
+    return ((port->ODR & LCD_PIN_BITS(pin)) != 0u) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostApplyTrace
+********************************************************************************
+*
+* Summary:
+*  Sets the output levels and data pin direction of one trace entry on the
+*  mock ports, without costing simulated time.
+*
+*******************************************************************************/
+static void LCD_HostApplyTrace(uint16_t pins)
+{
+    GPIO_TypeDef *port = DB4_GPIO_Port;
+    uint8_t const bus = LCD_TRACE_DB(pins);
+    uint32_t const mode = ((pins & LCD_TRACE_INPUT) != 0u) ? LL_GPIO_MODE_FLOATING : LL_GPIO_MODE_OUTPUT;
+    uint8_t number;
+
+    port->ODR = (port->ODR & ~LCD_STM32_BUS_MASK) | (((uint32_t) bus >> 4u) << LCD_HOST_DB4_SHIFT);
+    #if (LCD_BUS_8BIT != 0u)
+        port->ODR |= ((uint32_t) bus & 0x0Fu) << LCD_HOST_DB0_SHIFT;
+    #endif /* LCD_BUS_8BIT != 0u */
+
+    for (number = 0u; number < 16u; number++)
+    {
+        if ((LCD_STM32_BUS_MASK & (1u << number)) != 0u)
+        {
+            volatile uint32_t *config = (number < 8u) ? &port->CRL : &port->CRH;
+            uint32_t shift = (uint32_t) (number & 7u) * 4u;
+
+            *config = (*config & ~(0xFu << shift)) | (mode << shift);
+        }
+    }
+
+    RS_GPIO_Port->ODR = ((pins & LCD_TRACE_RS) != 0u) ? (RS_GPIO_Port->ODR | LCD_PIN_BITS(RS_Pin)) :
+                                                        (RS_GPIO_Port->ODR & ~LCD_PIN_BITS(RS_Pin));
+    RnW_GPIO_Port->ODR = ((pins & LCD_TRACE_RW) != 0u) ? (RnW_GPIO_Port->ODR | LCD_PIN_BITS(RnW_Pin)) :
+                                                         (RnW_GPIO_Port->ODR & ~LCD_PIN_BITS(RnW_Pin));
+    E_GPIO_Port->ODR = ((pins & LCD_TRACE_E) != 0u) ? (E_GPIO_Port->ODR | LCD_PIN_BITS(E_Pin)) :
+                                                      (E_GPIO_Port->ODR & ~LCD_PIN_BITS(E_Pin));
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostRise
+********************************************************************************
+*
+* Summary:
+*  Rising edge of E: setup and cycle time checks, a read puts the busy flag
+*  and address counter (RS low) or the addressed RAM byte (RS high) on the bus.
+*
+*******************************************************************************/
+static void LCD_HostRise(uint64_t now)
+{
+    LCD_HOST_PINS const *pins = &LCD_host.pins;
+
+    LCD_host.counts.strobes++;
+
+    if (LCD_HostWithin(LCD_host.controlChanged, now, LCD_HOST_T_AS_NS) != 0u)
+    {
+        LCD_HostViolation(LCD_HOST_V_SETUP, now);
+    }
+
+    if ((LCD_host.strobed != 0u) && (LCD_HostWithin(LCD_host.eRise, now, LCD_HOST_T_CYCE_NS) != 0u))
+    {
+        LCD_HostViolation(LCD_HOST_V_CYCLE, now);
+    }
+
+    if ((LCD_host.phase != 0u) && ((pins->rs != LCD_host.phaseRs) || (pins->rw != LCD_host.phaseRw)))
+    {
+        LCD_HostViolation(LCD_HOST_V_NIBBLE, now);
+    }
+
+    LCD_host.eRise = now;
+    LCD_host.strobed = 1u;
+
+    if (pins->rw != 0u)
+    {
+        if (pins->released == 0u)
+        {
+            LCD_HostViolation(LCD_HOST_V_DIRECTION, now);
+        }
+
+        if ((LCD_host.eightBit != 0u) || (LCD_host.phase == 0u))
+        {
+            LCD_host.readValue = LCD_HostReadByte(pins->rs, now);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostFall
+********************************************************************************
+*
+* Summary:
+*  Falling edge of E: pulse width and data setup checks, latches a write
+*  (byte, or nibble of a 4-bit transfer) or completes a read.
+*
+*******************************************************************************/
+static void LCD_HostFall(uint64_t now)
+{
+    LCD_HOST_PINS const *pins = &LCD_host.pins;
+    uint8_t value = pins->data;
+    uint8_t complete = 1u;
+
+    if (LCD_HostWithin(LCD_host.eRise, now, LCD_HOST_T_PWEH_NS) != 0u)
+    {
+        LCD_HostViolation(LCD_HOST_V_PULSE, now);
+    }
+    LCD_host.eFall = now;
+
+    if (pins->rw == 0u)
+    {
+        if (pins->driven == 0u)
+        {
+            LCD_HostViolation(LCD_HOST_V_DIRECTION, now);
+        }
+
+        if (LCD_HostWithin(LCD_host.dataChanged, now, LCD_HOST_T_DSW_NS) != 0u)
+        {
+            LCD_HostViolation(LCD_HOST_V_DATA_SETUP, now);
+        }
+
+        /* A write must wait for the previous instruction (checked once per byte) */
+        if ((LCD_host.phase == 0u) && (now < LCD_host.busyUntil))
+        {
+            LCD_HostViolation((LCD_host.initSets == 0u) ? LCD_HOST_V_POWER_ON : LCD_HOST_V_BUSY, now);
+        }
+    }
+
+    if (LCD_host.eightBit == 0u)
+    {
+        if (LCD_host.phase == 0u)
+        {
+            LCD_host.phase = 1u;
+            LCD_host.phaseRs = pins->rs;
+            LCD_host.phaseRw = pins->rw;
+            LCD_host.highNibble = (uint8_t) (value >> 4u);
+            complete = 0u;
+        }
+        else
+        {
+            LCD_host.phase = 0u;
+            value = (uint8_t) ((LCD_host.highNibble << 4u) | (value >> 4u));
+        }
+    }
+
+    if (complete == 0u)
+    {
+        return;
+    }
+
+    if (pins->rw == 0u)
+    {
+        LCD_HostExecute(pins->rs, value, now);
+    }
+    else
+    {
+        LCD_host.counts.reads++;
+        if (pins->rs != 0u)
+        {
+            /* Data read moves the address counter like a write */
+            LCD_host.address = LCD_HostStep(LCD_host.address, LCD_host.increment);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostExecute
+********************************************************************************
+*
+* Summary:
+*  Executes a latched instruction (RS low) or data byte (RS high).
+*
+*******************************************************************************/
+static void LCD_HostExecute(uint8_t rs, uint8_t value, uint64_t now)
+{
+    if (rs == 0u)
+    {
+        LCD_host.counts.commands++;
+        LCD_HostInstruction(value, now);
+        return;
+    }
+
+    LCD_host.counts.dataBytes++;
+
+    if (LCD_host.cgramSelected != 0u)
+    {
+        LCD_host.cgram[LCD_host.address & 0x3Fu] = value;
+    }
+    else
+    {
+        LCD_host.ddram[LCD_host.address & 0x7Fu] = value;
+
+        if (LCD_host.entryShift != 0u)
+        {
+            /* Display follows the cursor */
+            uint8_t length = LCD_HOST_LINE_LENGTH(LCD_host.lines);
+
+            LCD_host.displayShift = (uint8_t) ((LCD_host.displayShift +
+                                    ((LCD_host.increment != 0u) ? 1u : (length - 1u))) % length);
+        }
+    }
+
+    LCD_host.address = LCD_HostStep(LCD_host.address, LCD_host.increment);
+    LCD_host.busyUntil = now + LCD_HostNsToCycles(LCD_HOST_EXEC_SHORT_NS);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostInstruction
+********************************************************************************
+*
+* Summary:
+*  Decodes one instruction byte, highest set bit first.
+*
+*******************************************************************************/
+static void LCD_HostInstruction(uint8_t value, uint64_t now)
+{
+    uint32_t execution = LCD_HOST_EXEC_SHORT_NS;
+
+    if ((value & 0x80u) != 0u)
+    {
+        /* Set DDRAM address */
+        LCD_host.cgramSelected = 0u;
+        LCD_host.address = (uint8_t) (value & 0x7Fu);
+    }
+    else if ((value & 0x40u) != 0u)
+    {
+        /* Set CGRAM address */
+        LCD_host.cgramSelected = 1u;
+        LCD_host.address = (uint8_t) (value & 0x3Fu);
+    }
+    else if ((value & 0x20u) != 0u)
+    {
+        /* Function set; in 8-bit mode the first two set the handshake delays */
+        if (LCD_host.eightBit != 0u)
+        {
+            execution = (LCD_host.initSets == 0u) ? LCD_HOST_EXEC_INIT1_NS :
+                        ((LCD_host.initSets == 1u) ? LCD_HOST_EXEC_INIT2_NS : LCD_HOST_EXEC_SHORT_NS);
+            if (LCD_host.initSets < 0xFFu)
+            {
+                LCD_host.initSets++;
+            }
+        }
+        LCD_host.eightBit = ((value & 0x10u) != 0u) ? 1u : 0u;
+        LCD_host.lines = ((value & 0x08u) != 0u) ? 2u : 1u;
+        LCD_host.phase = 0u;
+    }
+    else if ((value & 0x10u) != 0u)
+    {
+        uint8_t right = ((value & 0x04u) != 0u) ? 1u : 0u;
+
+        if ((value & 0x08u) != 0u)
+        {
+            /* Display shift: right moves the text right, i.e. the window left */
+            uint8_t length = LCD_HOST_LINE_LENGTH(LCD_host.lines);
+
+            LCD_host.displayShift = (uint8_t) ((LCD_host.displayShift +
+                                    ((right != 0u) ? (length - 1u) : 1u)) % length);
+        }
+        else
+        {
+            LCD_host.address = LCD_HostStep(LCD_host.address, right);
+        }
+    }
+    else if ((value & 0x08u) != 0u)
+    {
+        /* Display control (cursor and blink are not modeled) */
+        LCD_host.displayOn = ((value & 0x04u) != 0u) ? 1u : 0u;
+    }
+    else if ((value & 0x04u) != 0u)
+    {
+        LCD_host.increment = ((value & 0x02u) != 0u) ? 1u : 0u;
+        LCD_host.entryShift = ((value & 0x01u) != 0u) ? 1u : 0u;
+    }
+    else if ((value & 0x02u) != 0u)
+    {
+        /* Return home */
+        LCD_host.cgramSelected = 0u;
+        LCD_host.address = 0u;
+        LCD_host.displayShift = 0u;
+        execution = LCD_HOST_EXEC_LONG_NS;
+    }
+    else if ((value & 0x01u) != 0u)
+    {
+        /* Clear display, also selects increment */
+        (void) memset(LCD_host.ddram, ' ', sizeof(LCD_host.ddram));
+        LCD_host.cgramSelected = 0u;
+        LCD_host.address = 0u;
+        LCD_host.displayShift = 0u;
+        LCD_host.increment = 1u;
+        execution = LCD_HOST_EXEC_LONG_NS;
+    }
+    else
+    {
+        /* 0x00: no operation */
+    }
+
+    LCD_host.busyUntil = now + LCD_HostNsToCycles(execution);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostStep
+********************************************************************************
+*
+* Summary:
+*  Moves an address by one: CGRAM wraps at 64, 2-line DDRAM runs 0x00-0x27
+*  then 0x40-0x67 and back to 0x00, 1-line DDRAM wraps at 0x50.
+*
+*******************************************************************************/
+static uint8_t LCD_HostStep(uint8_t address, uint8_t up)
+{
+    if (LCD_host.cgramSelected != 0u)
+    {
+        return (uint8_t) ((address + ((up != 0u) ? 1u : 0x3Fu)) & 0x3Fu);
+    }
+
+    if (LCD_host.lines == 1u)
+    {
+        return (uint8_t) ((address + ((up != 0u) ? 1u : 0x4Fu)) % 0x50u);
+    }
+
+    if (up != 0u)
+    {
+        if ((address & 0x3Fu) >= 0x27u)
+        {
+            return (uint8_t) ((address & 0x40u) ^ 0x40u);
+        }
+        return (uint8_t) (address + 1u);
+    }
+
+    if ((address & 0x3Fu) == 0u)
+    {
+        return (uint8_t) (((address & 0x40u) ^ 0x40u) + 0x27u);
+    }
+    return (uint8_t) (address - 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostReadByte
+********************************************************************************
+*
+* Summary:
+*  Value of a read: busy flag and address counter, or the addressed RAM byte.
+*
+*******************************************************************************/
+static uint8_t LCD_HostReadByte(uint8_t rs, uint64_t now)
+{
+    if (rs == 0u)
+    {
+        uint8_t busy = (now < LCD_host.busyUntil) ? 1u : 0u;
+
+        LCD_host.counts.busyReads += busy;
+
+        return (uint8_t) ((busy << 7u) | (LCD_host.address & 0x7Fu));
+    }
+
+    return (LCD_host.cgramSelected != 0u) ? LCD_host.cgram[LCD_host.address & 0x3Fu] :
+                                            LCD_host.ddram[LCD_host.address & 0x7Fu];
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostViolation
+********************************************************************************
+*
+* Summary:
+*  Counts a violation and prints the first LCD_HOST_REPORT_MAX.
+*
+*******************************************************************************/
+static void LCD_HostViolation(uint8_t kind, uint64_t now)
+{
+    LCD_host.violations[kind]++;
+    LCD_host.counts.violations++;
+
+    if (LCD_host.counts.violations <= LCD_HOST_REPORT_MAX)
+    {
+        (void) printf("  ! %12.3f us  %s\n",
+                      (double) now * 1000000.0 / (double) SystemCoreClock, LCD_hostViolationNames[kind]);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostNsToCycles
+********************************************************************************
+*
+* Summary:
+*  Converts nanoseconds to core cycles, rounded up.
+*
+*******************************************************************************/
+static uint64_t LCD_HostNsToCycles(uint32_t ns)
+{
+    return (((uint64_t) ns * SystemCoreClock) + 999999999u) / 1000000000u;
+}
+
+
+/*******************************************************************************
+* Function Name: LCD_HostWithin
+********************************************************************************
+*
+* Summary:
+*  Returns 1 if less than "ns" passed between "from" and "now".
+*
+*******************************************************************************/
+static uint8_t LCD_HostWithin(uint64_t from, uint64_t now, uint32_t ns)
+{
+    return (((now - from) * 1000000000u) < ((uint64_t) ns * SystemCoreClock)) ? 1u : 0u;
+}